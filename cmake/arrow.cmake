@@ -0,0 +1,11 @@
+#
+# Arrow support
+#
+find_package(Arrow QUIET REQUIRED)
+set_package_properties(Arrow PROPERTIES
+        TYPE OPTIONAL
+        URL "https://arrow.apache.org"
+        PURPOSE "Arrow columnar interchange support")
+
+mark_as_advanced(CLEAR ARROW_INCLUDE_DIR)
+mark_as_advanced(CLEAR ARROW_LIBRARIES)
@@ -7,6 +7,16 @@ option(WITH_COMPLETION
 add_feature_info("Bash completion" WITH_COMPLETION
     "completion for PDAL command line")
 
+option(WITH_TRACING
+    "Compile hot-path tracepoints into the library?" FALSE)
+add_feature_info("Tracing" WITH_TRACING
+    "tracepoints for external profilers, enabled at runtime via PDAL_TRACE")
+
+option(BUILD_PLUGIN_ARROW
+    "Choose if Arrow support should be built" FALSE)
+add_feature_info("Arrow plugin" BUILD_PLUGIN_ARROW
+    "Read and write data as Arrow record batches")
+
 option(BUILD_PLUGIN_CPD
     "Choose if the cpd filter should be built" FALSE)
 add_feature_info("CPD plugin" BUILD_PLUGIN_CPD
@@ -100,6 +110,11 @@ option(WITH_TESTS
     "Choose if PDAL unit tests should be built" TRUE)
 add_feature_info("Unit tests" WITH_TESTS "PDAL unit tests")
 
+option(WITH_BENCHMARKS
+    "Choose if PDAL microbenchmarks should be built (requires Google Benchmark)"
+    FALSE)
+add_feature_info("Benchmarks" WITH_BENCHMARKS "PDAL microbenchmarks")
+
 # Enable CTest and submissions to PDAL dashboard at CDash
 # http://my.cdash.org/index.php?project=PDAL
 option(ENABLE_CTEST
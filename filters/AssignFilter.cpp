@@ -166,11 +166,52 @@ bool AssignFilter::processOne(PointRef& point)
 
 void AssignFilter::filter(PointView& view)
 {
-    PointRef point(view, 0);
-    for (PointId id = 0; id < view.size(); ++id)
+    // Work a block at a time: fetch the condition and each assignment
+    // dimension with one call per block, rewrite values in place and
+    // store the block back with another.
+    const point_count_t BatchSize = 4096;
+    bool haveCondition = m_args->m_condition.m_id != Dimension::Id::Unknown;
+    std::vector<double> condVals(BatchSize);
+    std::vector<double> vals(BatchSize);
+    std::vector<char> assigned(BatchSize);
+
+    for (PointId start = 0; start < view.size(); start += BatchSize)
     {
-        point.setPointId(id);
-        processOne(point);
+        point_count_t n =
+            (std::min)((point_count_t)BatchSize, view.size() - start);
+
+        if (haveCondition)
+            view.getFieldBatch(m_args->m_condition.m_id, start, n,
+                condVals.data());
+
+        for (AssignRange& r : m_args->m_assignments)
+        {
+            view.getFieldBatch(r.m_id, start, n, vals.data());
+
+            point_count_t changed = 0;
+            for (point_count_t i = 0; i < n; ++i)
+            {
+                assigned[i] = 0;
+                if (haveCondition &&
+                    !m_args->m_condition.valuePasses(condVals[i]))
+                    continue;
+                if (r.valuePasses(vals[i]))
+                {
+                    vals[i] = r.m_value;
+                    assigned[i] = 1;
+                    changed++;
+                }
+            }
+            // Store the whole block back in one call when everything was
+            // assigned; otherwise only touch the points that changed so
+            // unmodified values never round-trip through double.
+            if (changed == n)
+                view.setFieldBatch(r.m_id, start, n, vals.data());
+            else if (changed)
+                for (point_count_t i = 0; i < n; ++i)
+                    if (assigned[i])
+                        view.setField(r.m_id, start + i, r.m_value);
+        }
     }
 }
 
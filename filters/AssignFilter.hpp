@@ -54,6 +54,8 @@ private:
     virtual void addArgs(ProgramArgs& args);
     virtual void prepared(PointTableRef table);
     virtual bool processOne(PointRef& point);
+    virtual bool fusable() const
+        { return true; }
     virtual void filter(PointView& view);
 
     AssignFilter& operator=(const AssignFilter&) = delete;
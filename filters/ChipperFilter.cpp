@@ -35,6 +35,7 @@
 
 #include <iostream>
 #include <limits>
+#include <thread>
 
 /**
 The objective is to split the region into non-overlapping blocks, each
@@ -63,6 +64,7 @@ blocks.
 **/
 
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -82,6 +84,8 @@ void ChipperFilter::addArgs(ProgramArgs& args)
 {
     args.add("capacity", "Maximum number of points per cell", m_threshold,
         (PointId) 5000u);
+    args.add("threads", "Number of threads used to partition (0 = choose "
+        "automatically)", m_threads);
 }
 
 
@@ -100,45 +104,66 @@ PointViewSet ChipperFilter::run(PointViewPtr view)
     m_xvec.reserve(view->size());
     m_yvec.reserve(view->size());
 
-    load(*view.get(), m_xvec, m_yvec, m_spare);
+    size_t threads = pdal::threadCount(m_threads, view->size());
+
+    load(*view.get(), m_xvec, m_yvec, m_spare, threads);
     partition(m_xvec.size());
-    decideSplit(m_xvec, m_yvec, m_spare, 0, m_partitions.size() - 1);
+    decideSplit(m_xvec, m_xpos, m_yvec, m_ypos, m_spare, 0,
+        m_partitions.size() - 1, threads);
     return m_outViews;
 }
 
 
 void ChipperFilter::load(PointView& view, ChipRefList& xvec, ChipRefList& yvec,
-    ChipRefList& spare)
+    ChipRefList& spare, size_t threads)
 {
+    // Read each coordinate once into a contiguous array indexed by point
+    // ID.  The ref lists carry only indices and sort against the arrays.
+    m_xpos.resize(view.size());
+    m_ypos.resize(view.size());
     for (PointId i = 0; i < view.size(); ++i)
     {
-        ChipPtRef xref;
+        m_xpos[i] = view.getFieldAs<double>(Dimension::Id::X, i);
+        m_ypos[i] = view.getFieldAs<double>(Dimension::Id::Y, i);
 
-        xref.m_pos = view.getFieldAs<double>(Dimension::Id::X, i);
-        xref.m_ptindex = i;
-        xvec.push_back(xref);
+        ChipPtRef ref;
+        ref.m_ptindex = i;
+        xvec.push_back(ref);
+        yvec.push_back(ref);
+    }
 
-        ChipPtRef yref;
+    auto sortOn = [](ChipRefList& vec, const std::vector<double>& pos)
+    {
+        std::stable_sort(vec.begin(), vec.end(),
+            [&pos](const ChipPtRef& r1, const ChipPtRef& r2)
+            { return pos[r1.m_ptindex] < pos[r2.m_ptindex]; });
+    };
 
-        yref.m_pos = view.getFieldAs<double>(Dimension::Id::Y, i);
-        yref.m_ptindex = i;
-        yvec.push_back(yref);
+    // The two directions sort independently.
+    if (threads > 1)
+    {
+        std::thread t([&]() { sortOn(xvec, m_xpos); });
+        sortOn(yvec, m_ypos);
+        t.join();
     }
-
-    // Sort xvec and assign other index in yvec to sorted indices in xvec.
-    std::stable_sort(xvec.begin(), xvec.end());
-    for (size_t i = 0; i < xvec.size(); ++i)
+    else
     {
-        point_count_t idx = xvec[i].m_ptindex;
-        yvec[idx].m_oindex = i;
+        sortOn(xvec, m_xpos);
+        sortOn(yvec, m_ypos);
     }
 
-    // Sort yvec.
-    std::stable_sort(yvec.begin(), yvec.end());
+    // Position of each point in the sorted xvec.
+    std::vector<size_t> xorder(view.size());
+    for (size_t i = 0; i < xvec.size(); ++i)
+        xorder[xvec[i].m_ptindex] = i;
 
-    // Iterate through the yvector, setting the xvector appropriately.
+    // Cross-link the lists - each ref knows where the same point sits
+    // in the other list.
     for (size_t i = 0; i < yvec.size(); ++i)
+    {
+        yvec[i].m_oindex = xorder[yvec[i].m_ptindex];
         xvec[yvec[i].m_oindex].m_oindex = i;
+    }
 }
 
 
@@ -181,8 +206,10 @@ void ChipperFilter::partition(point_count_t size)
 }
 
 
-void ChipperFilter::decideSplit(ChipRefList& v1, ChipRefList& v2,
-    ChipRefList& spare, PointId pleft, PointId pright)
+void ChipperFilter::decideSplit(ChipRefList& v1,
+    const std::vector<double>& v1pos, ChipRefList& v2,
+    const std::vector<double>& v2pos, ChipRefList& spare,
+    PointId pleft, PointId pright, size_t threads)
 {
     double v1range;
     double v2range;
@@ -191,16 +218,18 @@ void ChipperFilter::decideSplit(ChipRefList& v1, ChipRefList& v2,
 
     // Decide the wider direction of the block, and split in that direction
     // to maintain squareness.
-    v1range = v1[right].m_pos - v1[left].m_pos;
-    v2range = v2[right].m_pos - v2[left].m_pos;
+    v1range = v1pos[v1[right].m_ptindex] - v1pos[v1[left].m_ptindex];
+    v2range = v2pos[v2[right].m_ptindex] - v2pos[v2[left].m_ptindex];
     if (v1range > v2range)
-        split(v1, v2, spare, pleft, pright);
+        split(v1, v1pos, v2, v2pos, spare, pleft, pright, threads);
     else
-        split(v2, v1, spare, pleft, pright);
+        split(v2, v2pos, v1, v1pos, spare, pleft, pright, threads);
 }
 
-void ChipperFilter::split(ChipRefList& wide, ChipRefList& narrow,
-    ChipRefList& spare, PointId pleft, PointId pright)
+void ChipperFilter::split(ChipRefList& wide,
+    const std::vector<double>& widepos, ChipRefList& narrow,
+    const std::vector<double>& narrowpos, ChipRefList& spare,
+    PointId pleft, PointId pright, size_t threads)
 {
     PointId lstart;
     PointId rstart;
@@ -252,18 +281,42 @@ void ChipperFilter::split(ChipRefList& wide, ChipRefList& narrow,
             }
         }
 
-        decideSplit(wide, spare, narrow, pleft, pcenter);
-        decideSplit(wide, spare, narrow, pcenter, pright);
+        // The spare array takes over the narrow array's role (and its
+        // coordinate direction) for the recursion on the two halves.
+        // The halves cover disjoint ranges of all three arrays, so they
+        // can run as independent tasks while the thread budget lasts.
+        if (threads > 1)
+        {
+            size_t lthreads = threads / 2;
+            size_t rthreads = threads - lthreads;
+            std::thread t([&, pleft, pcenter, lthreads]()
+                { decideSplit(wide, widepos, spare, narrowpos, narrow,
+                    pleft, pcenter, lthreads); });
+            decideSplit(wide, widepos, spare, narrowpos, narrow,
+                pcenter, pright, rthreads);
+            t.join();
+        }
+        else
+        {
+            decideSplit(wide, widepos, spare, narrowpos, narrow,
+                pleft, pcenter, 1);
+            decideSplit(wide, widepos, spare, narrowpos, narrow,
+                pcenter, pright, 1);
+        }
     }
 }
 
 void ChipperFilter::emit(ChipRefList& wide, PointId widemin, PointId widemax)
 {
-    PointViewPtr view = m_inView->makeNew();
+    PointViewPtr view;
+    {
+        // View creation and the output set aren't thread-safe.
+        std::lock_guard<std::mutex> lock(m_outViewsMutex);
+        view = m_inView->makeNew();
+        m_outViews.insert(view);
+    }
     for (size_t idx = widemin; idx <= widemax; ++idx)
         view->appendPoint(*m_inView.get(), wide[idx].m_ptindex);
-
-    m_outViews.insert(view);
 }
 
 } // namespace pdal
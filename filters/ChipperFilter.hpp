@@ -43,6 +43,8 @@
 
 #include <pdal/Filter.hpp>
 #include <pdal/PointView.hpp>
+
+#include <mutex>
 #include <vector>
 
 namespace pdal
@@ -53,21 +55,16 @@ class Stage;
 
 class PDAL_DLL ChipperFilter;
 
+// A reference into the coordinate arrays held by the filter.  The
+// coordinates themselves are stored once, indexed by point ID.
 class PDAL_DLL ChipPtRef
 {
     friend class ChipRefList;
     friend class ChipperFilter;
 
 private:
-    double m_pos;
     point_count_t m_ptindex;
     size_t m_oindex;
-
-public:
-    bool operator < (const ChipPtRef& pt) const
-    {
-        return m_pos < pt.m_pos;
-    }
 };
 
 
@@ -120,18 +117,27 @@ private:
     virtual PointViewSet run(PointViewPtr view);
 
     void load(PointView& view, ChipRefList& xvec,
-        ChipRefList& yvec, ChipRefList& spare);
+        ChipRefList& yvec, ChipRefList& spare, size_t threads);
     void partition(point_count_t size);
-    void decideSplit(ChipRefList& v1, ChipRefList& v2,
-        ChipRefList& spare, PointId left, PointId right);
-    void split(ChipRefList& wide, ChipRefList& narrow,
-        ChipRefList& spare, PointId left, PointId right);
+    // The lists trade roles in the recursion, so each call is told which
+    // coordinate array orders each of its first two lists.
+    void decideSplit(ChipRefList& v1, const std::vector<double>& v1pos,
+        ChipRefList& v2, const std::vector<double>& v2pos,
+        ChipRefList& spare, PointId left, PointId right, size_t threads);
+    void split(ChipRefList& wide, const std::vector<double>& widepos,
+        ChipRefList& narrow, const std::vector<double>& narrowpos,
+        ChipRefList& spare, PointId left, PointId right, size_t threads);
     void emit(ChipRefList& wide, PointId widemin, PointId widemax);
 
     PointId m_threshold;
+    size_t m_threads;
     PointViewPtr m_inView;
     PointViewSet m_outViews;
+    std::mutex m_outViewsMutex;
     PointIdList m_partitions;
+    // Coordinates by point ID - stored once and shared by the ref lists.
+    std::vector<double> m_xpos;
+    std::vector<double> m_ypos;
     ChipRefList m_xvec;
     ChipRefList m_yvec;
     ChipRefList m_spare;
@@ -62,6 +62,8 @@ void ClusterFilter::addArgs(ProgramArgs& args)
     args.add("max_points", "Max points per cluster", m_maxPoints,
         (std::numeric_limits<uint64_t>::max)());
     args.add("tolerance", "Radius", m_tolerance, 1.0);
+    args.add("threads", "Number of threads used for the neighbor "
+        "queries (0 = choose automatically)", m_threads);
 }
 
 void ClusterFilter::addDimensions(PointLayoutPtr layout)
@@ -72,7 +74,7 @@ void ClusterFilter::addDimensions(PointLayoutPtr layout)
 void ClusterFilter::filter(PointView& view)
 {
     auto clusters = Segmentation::extractClusters(view, m_minPoints,
-        m_maxPoints, m_tolerance);
+        m_maxPoints, m_tolerance, m_threads);
 
     uint64_t id = 1;
     for (auto const& c : clusters)
@@ -161,6 +161,18 @@ void ColorinterpFilter::ready(PointTableRef table)
     m_raster->readBand(m_redBand, 1);
     m_raster->readBand(m_greenBand, 2);
     m_raster->readBand(m_blueBand, 3);
+
+    // Bake the bands into one interleaved lookup table, applying any
+    // inversion up front, so coloring a point is a single indexed fetch.
+    m_lut.resize(m_redBand.size() * 3);
+    for (size_t i = 0; i < m_redBand.size(); ++i)
+    {
+        size_t pos = m_invertRamp ? (m_redBand.size() - 1) - i : i;
+        uint8_t *color = &m_lut[3 * i];
+        color[0] = m_redBand[pos];
+        color[1] = m_greenBand[pos];
+        color[2] = m_blueBand[pos];
+    }
 }
 
 
@@ -248,11 +260,40 @@ void ColorinterpFilter::filter(PointView& view)
             m_max = summary.maximum();
     }
 
-    PointRef point(view, 0);
-    for (PointId idx = 0; idx < view.size(); ++idx)
+    // Color in batches: fetch the interpolation dimension and the
+    // current colors with one call per batch, index the baked LUT, and
+    // store the colors back.  Out-of-range points keep whatever color
+    // they had.  The index math matches processOne() so streamed and
+    // buffered runs color identically.
+    point_count_t np = view.size();
+    size_t img_width = m_lut.size() / 3;
+    const point_count_t BatchSize = 4096;
+    std::vector<double> values(BatchSize);
+    std::vector<uint8_t> red(BatchSize);
+    std::vector<uint8_t> green(BatchSize);
+    std::vector<uint8_t> blue(BatchSize);
+    for (PointId s = 0; s < np; s += BatchSize)
     {
-        point.setPointId(idx);
-        processOne(point);
+        point_count_t n = (std::min)(BatchSize, (point_count_t)(np - s));
+        view.getFieldBatch(m_interpDim, s, n, values.data());
+        view.getFieldBatch(Dimension::Id::Red, s, n, red.data());
+        view.getFieldBatch(Dimension::Id::Green, s, n, green.data());
+        view.getFieldBatch(Dimension::Id::Blue, s, n, blue.data());
+        for (point_count_t i = 0; i < n; ++i)
+        {
+            double v = values[i];
+            if (v < m_min || v >= m_max)
+                continue;
+            double factor = (v - m_min) / (m_max - m_min);
+            size_t position = size_t(std::floor(factor * img_width));
+            const uint8_t *color = &m_lut[3 * position];
+            red[i] = color[0];
+            green[i] = color[1];
+            blue[i] = color[2];
+        }
+        view.setFieldBatch(Dimension::Id::Red, s, n, red.data());
+        view.setFieldBatch(Dimension::Id::Green, s, n, green.data());
+        view.setFieldBatch(Dimension::Id::Blue, s, n, blue.data());
     }
 }
 
@@ -274,15 +315,13 @@ bool ColorinterpFilter::processOne(PointRef& point)
         return true;
 
     double factor = (v - m_min) / (m_max - m_min);
-    size_t img_width = m_redBand.size();
+    size_t img_width = m_lut.size() / 3;
     size_t position = size_t(std::floor(factor * img_width));
 
-    if (m_invertRamp)
-        position = (img_width - 1) - position;
-
-    point.setField(Dimension::Id::Red, m_redBand[position]);
-    point.setField(Dimension::Id::Blue, m_blueBand[position]);
-    point.setField(Dimension::Id::Green, m_greenBand[position]);
+    const uint8_t *color = &m_lut[3 * position];
+    point.setField(Dimension::Id::Red, color[0]);
+    point.setField(Dimension::Id::Green, color[1]);
+    point.setField(Dimension::Id::Blue, color[2]);
 
     return true;
 }
@@ -87,6 +87,8 @@ private:
     std::vector<uint8_t> m_redBand;
     std::vector<uint8_t> m_greenBand;
     std::vector<uint8_t> m_blueBand;
+    /// Ramp bands interleaved R, G, B per entry, inversion applied.
+    std::vector<uint8_t> m_lut;
     bool m_invertRamp;
     double m_stdDevThreshold;
     bool m_useMAD;
@@ -38,7 +38,9 @@
 #include <pdal/PointView.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
+#include <algorithm>
 #include <array>
+#include <vector>
 
 namespace pdal
 {
@@ -210,12 +212,11 @@ bool ColorizationFilter::processOne(PointRef& point)
 
     if (m_raster->read(x, y, data) == gdal::GDALError::None)
     {
-        int i(0);
         for (auto bi = m_bands.begin(); bi != m_bands.end(); ++bi)
         {
             BandInfo& b = *bi;
-            point.setField(b.m_dim, data[i] * b.m_scale);
-            ++i;
+            if (b.m_band <= data.size())
+                point.setField(b.m_dim, data[b.m_band - 1] * b.m_scale);
         }
         return true;
     }
@@ -225,11 +226,63 @@ bool ColorizationFilter::processOne(PointRef& point)
 
 void ColorizationFilter::filter(PointView& view)
 {
-    PointRef point = view.point(0);
+    using namespace Dimension;
+
+    // Locate each point in the raster up front, then fetch each band in
+    // row strips aligned to the native block size and sample the strips in
+    // memory.  Each underlying GDAL block is decoded once instead of once
+    // per point in it.
+    struct Target
+    {
+        int32_t line;
+        int32_t pixel;
+        PointId id;
+    };
+    std::vector<Target> targets;
+    targets.reserve(view.size());
+
     for (PointId idx = 0; idx < view.size(); ++idx)
     {
-        point.setPointId(idx);
-        processOne(point);
+        double x = view.getFieldAs<double>(Id::X, idx);
+        double y = view.getFieldAs<double>(Id::Y, idx);
+
+        // Points outside the raster are left uncolored, as before.
+        int32_t pixel(0);
+        int32_t line(0);
+        if (m_raster->coordToPixel(x, y, pixel, line))
+            targets.push_back({line, pixel, idx});
+    }
+
+    std::sort(targets.begin(), targets.end(),
+        [](const Target& a, const Target& b)
+        { return a.line < b.line; });
+
+    int xSize, ySize;
+    if (m_bands.empty() ||
+        m_raster->blockSize(m_bands[0].m_band, xSize, ySize) !=
+            gdal::GDALError::None || ySize <= 0)
+        ySize = 1;
+
+    std::vector<std::vector<double>> strips(m_bands.size());
+    auto it = targets.begin();
+    while (it != targets.end())
+    {
+        // Each strip covers one row of raster blocks.
+        int firstRow = (it->line / ySize) * ySize;
+        int rowCount = (std::min)(ySize, m_raster->height() - firstRow);
+        for (size_t i = 0; i < m_bands.size(); ++i)
+            if (m_raster->readBandRows(strips[i], m_bands[i].m_band,
+                    firstRow, rowCount) != gdal::GDALError::None)
+                throwError(m_raster->errorMsg());
+
+        for (; it != targets.end() && it->line < firstRow + rowCount; ++it)
+        {
+            size_t cell = (size_t)(it->line - firstRow) * m_raster->width() +
+                it->pixel;
+            for (size_t i = 0; i < m_bands.size(); ++i)
+                view.setField(m_bands[i].m_dim, it->id,
+                    strips[i][cell] * m_bands[i].m_scale);
+        }
     }
 }
 
@@ -44,6 +44,7 @@
 
 #include <Eigen/Dense>
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <cmath>
@@ -84,73 +85,116 @@ void CovarianceFeaturesFilter::addDimensions(PointLayoutPtr layout)
 
 void CovarianceFeaturesFilter::filter(PointView& view)
 {
+    using namespace Eigen;
 
     KD3Index& kdi = view.build3dIndex();
 
     point_count_t nloops = view.size();
+    if (!nloops)
+        return;
+
+    // Cache the output dimension ids; the per-point path previously hashed
+    // the dimension names for every field write.
+    Dimension::Id linDim = m_extraDims["Linearity"];
+    Dimension::Id planDim = m_extraDims["Planarity"];
+    Dimension::Id scatDim = m_extraDims["Scattering"];
+    Dimension::Id vertDim = m_extraDims["Verticality"];
+
+    // Neighbor count, clamped and widened for the stride exactly as the
+    // KD3Index::neighbors() convenience overload would.
+    point_count_t k = (std::min)((point_count_t)(m_knn + 1), nloops);
+    point_count_t k2 = (point_count_t)(k * m_stride);
+
+    // Features are accumulated per thread into disjoint slices of flat
+    // arrays and written back in batches once the threads are done.
+    std::vector<double> linearity(nloops);
+    std::vector<double> planarity(nloops);
+    std::vector<double> scattering(nloops);
+    std::vector<double> verticality(nloops);
+
+    // A degenerate neighborhood can't throw from a worker thread; note it
+    // and report after the join.
+    std::atomic<bool> degenerate(false);
+
     std::vector<std::thread> threadList(m_threads);
     for(int t = 0;t<m_threads;t++)
     {
         threadList[t] = std::thread(std::bind(
                 [&](const PointId start, const PointId end)
                 {
+                    // Query buffers are reused across the whole block
+                    // rather than allocated per point.
+                    PointIdList nbrs(k2);
+                    std::vector<double> sqr_dists(k2);
+                    PointIdList ids(k);
                     for(PointId i = start;i<end;i++)
-                        setDimensionality(view, i, kdi);
+                    {
+                        // find the k-nearest neighbors
+                        kdi.knnSearch(i, k2, &nbrs, &sqr_dists);
+                        for (point_count_t j = 0; j < k; ++j)
+                            ids[j] = nbrs[j * m_stride];
+
+                        // perform the eigen decomposition of the
+                        // neighborhood covariance with the closed-form
+                        // 3x3 kernel.
+                        auto solver = computeEigen(view, ids);
+
+                        // Extract eigenvalues and eigenvectors in
+                        // decreasing order (largest eigenvalue first)
+                        auto ev = solver.eigenvalues();
+                        std::vector<double> lambda = {(std::max(ev[2],0.0)),
+                                                      (std::max(ev[1],0.0)),
+                                                      (std::max(ev[0],0.0))};
+
+                        if (lambda[0] == 0)
+                        {
+                            degenerate = true;
+                            return;
+                        }
+
+                        auto eigenVectors = solver.eigenvectors();
+                        std::vector<double> v1(3), v2(3), v3(3);
+                        for (int j=0; j < 3; j++)
+                        {
+                            v1[j] = eigenVectors.col(2)(j);
+                            v2[j] = eigenVectors.col(1)(j);
+                            v3[j] = eigenVectors.col(0)(j);
+                        }
+
+                        linearity[i] = (sqrt(lambda[0]) - sqrt(lambda[1])) /
+                            sqrt(lambda[0]);
+                        planarity[i] = (sqrt(lambda[1]) - sqrt(lambda[2])) /
+                            sqrt(lambda[0]);
+                        scattering[i] = sqrt(lambda[2]) / sqrt(lambda[0]);
+
+                        std::vector<double> unary_vector(3);
+                        double norm = 0;
+                        for (int j=0; j <3 ; j++)
+                        {
+                            unary_vector[j] = lambda[0] * fabs(v1[j]) +
+                                lambda[1] * fabs(v2[j]) + lambda[2] * fabs(v3[j]);
+                            norm += unary_vector[j] * unary_vector[j];
+                        }
+                        norm = sqrt(norm);
+                        verticality[i] = unary_vector[2] / norm;
+                    }
                 },
                 t*nloops/m_threads,(t+1)==m_threads?nloops:(t+1)*nloops/m_threads));
     }
     for (auto &t: threadList)
         t.join();
-}
-
-void CovarianceFeaturesFilter::setDimensionality(PointView &view, const PointId &id, const KD3Index &kid)
-{
-    using namespace Eigen;
-
-    // find the k-nearest neighbors
-    auto ids = kid.neighbors(id, m_knn + 1, m_stride);
 
-    // compute covariance of the neighborhood
-    auto B = computeCovariance(view, ids);
-
-    // perform the eigen decomposition
-    SelfAdjointEigenSolver<Matrix3d> solver(B);
-    if (solver.info() != Success)
-        throwError("Cannot perform eigen decomposition.");
-
-    // Extract eigenvalues and eigenvectors in decreasing order (largest eigenvalue first)
-    auto ev = solver.eigenvalues();
-    std::vector<double> lambda = {(std::max(ev[2],0.0)),
-                                  (std::max(ev[1],0.0)),
-                                  (std::max(ev[0],0.0))};
-
-    if (lambda[0] == 0)
+    if (degenerate)
         throwError("Eigenvalues are all 0. Can't compute local features.");
 
-    auto eigenVectors = solver.eigenvectors();
-    std::vector<double> v1(3), v2(3), v3(3);
-    for (int i=0; i < 3; i++)
-    {
-        v1[i] = eigenVectors.col(2)(i);
-        v2[i] = eigenVectors.col(1)(i);
-        v3[i] = eigenVectors.col(0)(i);
-    }
-
-    double linearity  = (sqrt(lambda[0]) - sqrt(lambda[1])) / sqrt(lambda[0]);
-    double planarity  = (sqrt(lambda[1]) - sqrt(lambda[2])) / sqrt(lambda[0]);
-    double scattering =  sqrt(lambda[2]) / sqrt(lambda[0]);
-    view.setField(m_extraDims["Linearity"], id, linearity);
-    view.setField(m_extraDims["Planarity"], id, planarity);
-    view.setField(m_extraDims["Scattering"], id, scattering);
-
-    std::vector<double> unary_vector(3);
-    double norm = 0;
-    for (int i=0; i <3 ; i++)
+    const point_count_t BatchSize = 4096;
+    for (PointId start = 0; start < nloops; start += BatchSize)
     {
-        unary_vector[i] = lambda[0] * fabs(v1[i]) + lambda[1] * fabs(v2[i]) + lambda[2] * fabs(v3[i]);
-        norm += unary_vector[i] * unary_vector[i];
+        point_count_t n = (std::min)(BatchSize, nloops - start);
+        view.setFieldBatch(linDim, start, n, linearity.data() + start);
+        view.setFieldBatch(planDim, start, n, planarity.data() + start);
+        view.setFieldBatch(scatDim, start, n, scattering.data() + start);
+        view.setFieldBatch(vertDim, start, n, verticality.data() + start);
     }
-    norm = sqrt(norm);
-    view.setField(m_extraDims["Verticality"], id, unary_vector[2] / norm);
 }
 }
@@ -60,8 +60,6 @@ private:
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void addArgs(ProgramArgs &args);
     virtual void filter(PointView &view);
-
-    void setDimensionality(PointView &view, const PointId &id, const KD3Index &kid);
 };
 }
 
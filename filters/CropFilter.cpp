@@ -39,13 +39,14 @@
 #include <pdal/Polygon.hpp>
 #include <pdal/util/Bounds.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/GDALUtils.hpp>
 
 #include "private/Point.hpp"
-#include "private/pnp/GridPnp.hpp"
 
 #include <sstream>
 #include <cstdarg>
+#include <thread>
 
 namespace pdal
 {
@@ -67,13 +68,14 @@ struct CropArgs
     std::vector<filter::Point> m_centers;
     double m_distance;
     std::vector<Polygon> m_polys;
+    size_t m_threads;
 };
 
 CropFilter::ViewGeom::ViewGeom(const Polygon& poly) : m_poly(poly)
 {}
 
 CropFilter::ViewGeom::ViewGeom(ViewGeom&& vg) :
-    m_poly(std::move(vg.m_poly)), m_gridPnps(std::move(vg.m_gridPnps))
+    m_poly(std::move(vg.m_poly)), m_parts(std::move(vg.m_parts))
 {}
 
 std::string CropFilter::getName() const { return s_info.name; }
@@ -102,6 +104,75 @@ void CropFilter::addArgs(ProgramArgs& args)
     args.add("polygon", "Bounding polying for cropped points", m_args->m_polys).
         setErrorText("Invalid polygon specification.  "
             "Must be valid GeoJSON/WKT");
+    args.add("threads", "Number of threads used for polygon crops (0 = "
+        "choose automatically)", m_args->m_threads);
+}
+
+
+size_t CropFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_args->m_threads, np);
+}
+
+
+bool CropFilter::usedDims(StringList& used) const
+{
+    // Cropping only examines position.
+    used.insert(used.end(), { "X", "Y", "Z" });
+    return true;
+}
+
+
+bool CropFilter::cropBounds(std::vector<Bounds>& bounds) const
+{
+    // Called before options are parsed, so consult the raw options.
+    // Only the plain keep-inside case in the point coordinate system
+    // can be pushed down.
+    for (const std::string& s : m_options.getValues("outside"))
+        if (!Utils::iequals(s, "false"))
+            return false;
+    if (m_options.getValues("a_srs").size() ||
+        m_options.getValues("point").size())
+        return false;
+
+    StringList boxes = m_options.getValues("bounds");
+    StringList polys = m_options.getValues("polygon");
+    if (boxes.empty() && polys.empty())
+        return false;
+
+    // A point is kept when any region keeps it, so the union of the
+    // boxes and the polygons' bounding boxes covers everything kept.
+    for (const std::string& s : boxes)
+    {
+        try
+        {
+            Bounds b;
+            std::string::size_type pos(0);
+            b.parse(s, pos);
+            bounds.push_back(b);
+        }
+        catch (const Bounds::error&)
+        {
+            return false;
+        }
+    }
+    for (const std::string& s : polys)
+    {
+        try
+        {
+            Polygon p(s);
+            BOX3D box = p.bounds();
+            if (!box.valid())
+                return false;
+            // Polygon cropping is 2D.
+            bounds.push_back(Bounds(box.to2d()));
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 
@@ -140,15 +211,18 @@ void CropFilter::ready(PointTableRef table)
     }
     for (auto& geom : m_geoms)
         geom.m_poly.setSpatialReference(m_args->m_assignedSrs);
+
+    m_xDim.bind(*table.layout(), Dimension::Id::X);
+    m_yDim.bind(*table.layout(), Dimension::Id::Y);
+    m_zDim.bind(*table.layout(), Dimension::Id::Z);
 }
 
 
 bool CropFilter::processOne(PointRef& point)
 {
     for (auto& g : m_geoms)
-        for (auto& gridPnp : g.m_gridPnps)
-            if (crop(point, *gridPnp))
-                return true;
+        if (crop(point, g))
+            return true;
 
     for (auto& box : m_boxes)
         if (box.is3d())
@@ -189,14 +263,12 @@ void CropFilter::transform(const SpatialReference& srs)
         {
             throwError(err.what());
         }
-        geom.m_gridPnps.clear();
-        std::vector<Polygon> polys = geom.m_poly.polygons();
-        for (auto& p : polys)
-        {
-            std::unique_ptr<GridPnp> gridPnp(new GridPnp(
-                p.exteriorRing(), p.interiorRings()));
-            geom.m_gridPnps.push_back(std::move(gridPnp));
-        }
+        // Keep the parts prepared individually: a point is tested
+        // against each part, so with 'outside' set a point is kept when
+        // it's outside any one part.
+        geom.m_parts = geom.m_poly.polygons();
+        for (auto& p : geom.m_parts)
+            p.prepare();
     }
 
     // If we don't have any SRS, do nothing.
@@ -258,9 +330,9 @@ PointViewSet CropFilter::run(PointViewPtr view)
 
 bool CropFilter::crop(const PointRef& point, const BOX3D& box)
 {
-    double x = point.getFieldAs<double>(Dimension::Id::X);
-    double y = point.getFieldAs<double>(Dimension::Id::Y);
-    double z = point.getFieldAs<double>(Dimension::Id::Z);
+    double x = m_xDim.get(point);
+    double y = m_yDim.get(point);
+    double z = m_zDim.get(point);
 
     // Return true if we're keeping a point.
     return (m_args->m_cropOutside != box.contains(x, y, z));
@@ -268,8 +340,8 @@ bool CropFilter::crop(const PointRef& point, const BOX3D& box)
 
 bool CropFilter::crop(const PointRef& point, const BOX2D& box)
 {
-    double x = point.getFieldAs<double>(Dimension::Id::X);
-    double y = point.getFieldAs<double>(Dimension::Id::Y);
+    double x = m_xDim.get(point);
+    double y = m_yDim.get(point);
 
     // Return true if we're keeping a point.
     return (m_args->m_cropOutside != box.contains(x, y));
@@ -287,54 +359,112 @@ void CropFilter::crop(const Bounds& box, PointView& input, PointView& output)
 
 void CropFilter::crop(const BOX3D& box, PointView& input, PointView& output)
 {
-    PointRef point = input.point(0);
-    for (PointId idx = 0; idx < input.size(); ++idx)
+    // Test a chunk of coordinates per library call rather than a point
+    // per call - the batch contains() is branch free and vectorizes.
+    const point_count_t ChunkSize = 4096;
+    std::vector<double> x(ChunkSize);
+    std::vector<double> y(ChunkSize);
+    std::vector<double> z(ChunkSize);
+    std::unique_ptr<bool[]> in(new bool[ChunkSize]);
+
+    for (PointId start = 0; start < input.size(); start += ChunkSize)
     {
-        point.setPointId(idx);
-        if (crop(point, box))
-            output.appendPoint(input, idx);
+        point_count_t cnt = (std::min)(ChunkSize, input.size() - start);
+
+        input.getFieldBatch(Dimension::Id::X, start, cnt, x.data());
+        input.getFieldBatch(Dimension::Id::Y, start, cnt, y.data());
+        input.getFieldBatch(Dimension::Id::Z, start, cnt, z.data());
+        box.contains(x.data(), y.data(), z.data(), in.get(), cnt);
+        for (point_count_t i = 0; i < cnt; ++i)
+            if (m_args->m_cropOutside != in[i])
+                output.appendPoint(input, start + i);
     }
 }
 
 void CropFilter::crop(const BOX2D& box, PointView& input, PointView& output)
 {
-    PointRef point = input.point(0);
-    for (PointId idx = 0; idx < input.size(); ++idx)
+    const point_count_t ChunkSize = 4096;
+    std::vector<double> x(ChunkSize);
+    std::vector<double> y(ChunkSize);
+    std::unique_ptr<bool[]> in(new bool[ChunkSize]);
+
+    for (PointId start = 0; start < input.size(); start += ChunkSize)
     {
-        point.setPointId(idx);
-        if (crop(point, box))
-            output.appendPoint(input, idx);
+        point_count_t cnt = (std::min)(ChunkSize, input.size() - start);
+
+        input.getFieldBatch(Dimension::Id::X, start, cnt, x.data());
+        input.getFieldBatch(Dimension::Id::Y, start, cnt, y.data());
+        box.contains(x.data(), y.data(), in.get(), cnt);
+        for (point_count_t i = 0; i < cnt; ++i)
+            if (m_args->m_cropOutside != in[i])
+                output.appendPoint(input, start + i);
     }
 }
 
 
-bool CropFilter::crop(const PointRef& point, GridPnp& g)
+bool CropFilter::crop(const PointRef& point, const ViewGeom& g)
 {
-    double x = point.getFieldAs<double>(Dimension::Id::X);
-    double y = point.getFieldAs<double>(Dimension::Id::Y);
-    return (m_args->m_cropOutside != g.inside(x, y));
+    double x = m_xDim.get(point);
+    double y = m_yDim.get(point);
+
+    for (const Polygon& part : g.m_parts)
+        if (m_args->m_cropOutside != part.contains(x, y))
+            return true;
+    return false;
 }
 
 
 void CropFilter::crop(const ViewGeom& g, PointView& input, PointView& output)
 {
+    point_count_t np = input.size();
+    size_t threads = threadCount(np);
+
+    // Gather the coordinates once so each part is tested with one batch
+    // call per slice instead of a call per point.  The parts were
+    // prepared when the geometry was transformed, so the batches only
+    // read and can run on the worker threads.
+    std::vector<double> xs(np);
+    std::vector<double> ys(np);
     PointRef point = input.point(0);
-    for (auto& gridPnp : g.m_gridPnps)
+    for (PointId idx = 0; idx < np; ++idx)
     {
-        for (PointId idx = 0; idx < input.size(); ++idx)
-        {
-            point.setPointId(idx);
-            if (crop(point, const_cast<GridPnp&>(*gridPnp)))
-                output.appendPoint(input, idx);
-        }
+        point.setPointId(idx);
+        xs[idx] = m_xDim.get(point);
+        ys[idx] = m_yDim.get(point);
     }
+
+    // Decide slices of the view on separate threads, then append the kept
+    // points in order in a serial pass.
+    std::vector<char> keep(np);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&, t]()
+        {
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            std::unique_ptr<bool[]> in(new bool[end - start]);
+            for (const Polygon& part : g.m_parts)
+            {
+                part.contains(xs.data() + start, ys.data() + start,
+                    in.get(), end - start);
+                for (PointId idx = start; idx < end; ++idx)
+                    if (m_args->m_cropOutside != in[idx - start])
+                        keep[idx] = 1;
+            }
+        });
+    for (auto& t : pool)
+        t.join();
+
+    for (PointId idx = 0; idx < np; ++idx)
+        if (keep[idx])
+            output.appendPoint(input, idx);
 }
 
 
 bool CropFilter::crop(const PointRef& point, const filter::Point& center)
 {
-    double x = point.getFieldAs<double>(Dimension::Id::X);
-    double y = point.getFieldAs<double>(Dimension::Id::Y);
+    double x = m_xDim.get(point);
+    double y = m_yDim.get(point);
 
     x = std::abs(x - center.x());
     y = std::abs(y - center.y());
@@ -344,7 +474,7 @@ bool CropFilter::crop(const PointRef& point, const filter::Point& center)
     bool inside;
     if (center.is3d())
     {
-        double z = point.getFieldAs<double>(Dimension::Id::Z);
+        double z = m_zDim.get(point);
         z = std::abs(z - center.z());
         if (z > m_args->m_distance)
             return (m_args->m_cropOutside);
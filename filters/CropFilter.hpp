@@ -40,12 +40,12 @@
 #include <pdal/Filter.hpp>
 #include <pdal/Polygon.hpp>
 #include <pdal/Streamable.hpp>
+#include <pdal/TypedDimView.hpp>
 
 namespace pdal
 {
 
 class ProgramArgs;
-class GridPnp;
 struct CropArgs;
 namespace filter
 {
@@ -63,23 +63,30 @@ public:
     std::string getName() const;
 
 private:
-    // This is just a way to marry a (multi)polygon with a list of its
-    // GridPnp's that do the actual point-in-polygon operation.
+    // This is just a way to marry a (multi)polygon with its prepared
+    // parts that do the actual point-in-polygon operation.
     struct ViewGeom
     {
         ViewGeom(const Polygon& poly);
         ViewGeom(ViewGeom&& vg);
 
         Polygon m_poly;
-        std::vector<std::unique_ptr<GridPnp>> m_gridPnps;
+        std::vector<Polygon> m_parts;
     };
     std::unique_ptr<CropArgs> m_args;
     double m_distance2;
     std::vector<ViewGeom> m_geoms;
     std::vector<Bounds> m_boxes;
+    // Coordinate accessors bound once at ready() so the per-point crop
+    // tests don't re-resolve the dimension type.
+    TypedDimView<double> m_xDim;
+    TypedDimView<double> m_yDim;
+    TypedDimView<double> m_zDim;
 
     void addArgs(ProgramArgs& args);
     virtual void initialize();
+    virtual bool usedDims(StringList& used) const;
+    virtual bool cropBounds(std::vector<Bounds>& bounds) const;
 
     virtual void ready(PointTableRef table);
     virtual void spatialReferenceChanged(const SpatialReference& srs);
@@ -90,8 +97,9 @@ private:
     void crop(const BOX3D& box, PointView& input, PointView& output);
     void crop(const BOX2D& box, PointView& input, PointView& output);
     void crop(const Bounds& box, PointView& input, PointView& output);
-    bool crop(const PointRef& point, GridPnp& g);
+    bool crop(const PointRef& point, const ViewGeom& g);
     void crop(const ViewGeom& g, PointView& input, PointView& output);
+    size_t threadCount(point_count_t np) const;
     bool crop(const PointRef& point, const filter::Point& center);
     void crop(const filter::Point& center, PointView& input,
         PointView& output);
@@ -37,10 +37,14 @@
 
 #include "DBSCANFilter.hpp"
 
-#include <pdal/KDIndex.hpp>
-
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <string>
-#include <unordered_set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -67,6 +71,14 @@ void DBSCANFilter::addArgs(ProgramArgs& args)
     args.add("eps", "Epsilon", m_eps, 1.0);
     args.add("dimensions", "Dimensions to cluster", m_dimStringList,
              {"X", "Y", "Z"});
+    args.add("threads", "Number of threads used for the neighborhood "
+        "queries (0 = choose automatically)", m_threads);
+}
+
+
+size_t DBSCANFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
 }
 
 void DBSCANFilter::addDimensions(PointLayoutPtr layout)
@@ -93,81 +105,199 @@ void DBSCANFilter::prepared(PointTableRef table)
     }
 }
 
-void DBSCANFilter::filter(PointView& view)
+namespace
 {
-    // Construct KDFlexIndex for radius search.
-    KDFlexIndex kdfi(view, m_dimIdList);
-    kdfi.build();
-
-    // First pass through point cloud precomputes neighbor indices and
-    // initializes ClusterID to -2.
-    std::vector<PointIdList> neighbors(view.size());
-    for (PointId idx = 0; idx < view.size(); ++idx)
+
+// Mix the integer cell coordinates into a key for the grid map.  A
+// collision only merges two far-apart cells into one candidate bucket;
+// the distance test still rejects their points.
+uint64_t cellHash(const int64_t *cell, size_t ndims)
+{
+    uint64_t h(0xcbf29ce484222325ULL);
+    for (size_t j = 0; j < ndims; ++j)
     {
-        neighbors[idx] = kdfi.radius(idx, m_eps);
-        view.setField(m_cluster, idx, -2);
+        uint64_t x = (uint64_t)cell[j] * 0x9e3779b97f4a7c15ULL;
+        x ^= x >> 32;
+        h = (h ^ x) * 0x100000001b3ULL;
     }
+    return h;
+}
 
-    // Second pass through point cloud performs DBSCAN clustering.
-    int64_t cluster_label = 0;
-    for (PointId idx = 0; idx < view.size(); ++idx)
-    {
-        // Point has already been labeled, so move on to next.
-        if (view.getFieldAs<int64_t>(m_cluster, idx) != -2)
-            continue;
+} // unnamed namespace
 
-        // Density of the neighborhood does not meet minimum number of points
-        // constraint, label as noise.
-        if (neighbors[idx].size() < m_minPoints)
-        {
-            view.setField(m_cluster, idx, -1);
-            continue;
-        }
 
-        // Initialize some bookkeeping to track which neighbors have been
-        // considered for addition to the current cluster.
-        std::unordered_set<PointId> neighbors_next(neighbors[idx].begin(),
-                                                   neighbors[idx].end());
-        std::unordered_set<PointId> neighbors_visited;
-        neighbors_visited.insert(idx);
+void DBSCANFilter::filter(PointView& view)
+{
+    point_count_t np = view.size();
+    if (np == 0)
+        return;
 
-        // Unlabeled point encountered; assign cluster label.
-        view.setField(m_cluster, idx, cluster_label);
+    size_t ndims = m_dimIdList.size();
+    double eps2 = m_eps * m_eps;
 
-        // Consider all neighbors.
-        while (!neighbors_next.empty())
+    // Fetch the clustering dimensions into an interleaved array - one
+    // batch call per dimension per block instead of one virtual call per
+    // point per dimension.
+    std::vector<double> coords(np * ndims);
+    const point_count_t BatchSize = 4096;
+    std::vector<double> vals(BatchSize);
+    for (size_t j = 0; j < ndims; ++j)
+    {
+        for (PointId start = 0; start < np; start += BatchSize)
         {
-            // Select first neighbor and move it to the visited set.
-            PointId p = *neighbors_next.begin();
-            neighbors_next.erase(neighbors_next.begin());
-            neighbors_visited.insert(p);
+            point_count_t n = (std::min)(BatchSize, np - start);
+            view.getFieldBatch(m_dimIdList[j], start, n, vals.data());
+            for (point_count_t i = 0; i < n; ++i)
+                coords[(start + i) * ndims + j] = vals[i];
+        }
+    }
 
-            // Reassign cluster label to neighbor previously marked as noise.
-            if (view.getFieldAs<int64_t>(m_cluster, p) == -1)
-                view.setField(m_cluster, p, cluster_label);
+    // Bin the points on a grid with cell size eps so a radius query only
+    // has to look at the 3^ndims surrounding cells.
+    auto cellOf = [&](PointId i, int64_t *cell)
+    {
+        for (size_t j = 0; j < ndims; ++j)
+            cell[j] = (int64_t)std::floor(coords[i * ndims + j] / m_eps);
+    };
 
-            // Neighbor has already been labeled, so move on to next.
-            if (view.getFieldAs<int64_t>(m_cluster, p) != -2)
-                continue;
+    std::unordered_map<uint64_t, PointIdList> grid;
+    grid.reserve(np);
+    std::vector<int64_t> cell(ndims);
+    for (PointId i = 0; i < np; ++i)
+    {
+        cellOf(i, cell.data());
+        grid[cellHash(cell.data(), ndims)].push_back(i);
+    }
 
-            // Assign cluster label to neighbor.
-            view.setField(m_cluster, p, cluster_label);
+    size_t probes = 1;
+    for (size_t j = 0; j < ndims; ++j)
+        probes *= 3;
 
-            // If density of neighbor's neighborhood is sufficient, add it's
-            // neighbors to the set of neighbors to consider if they are not
-            // already.
-            if (neighbors[p].size() >= m_minPoints)
+    // Compute each point's eps-neighborhood from the grid.  The grid and
+    // coordinates are read-only here, so the points divide across threads.
+    std::vector<PointIdList> neighbors(np);
+    size_t threads = threadCount(np);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&, t]()
+        {
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            std::vector<int64_t> base(ndims);
+            std::vector<int64_t> probe(ndims);
+            std::vector<const PointIdList *> buckets;
+
+            for (PointId i = start; i < end; ++i)
             {
-                for (PointId q : neighbors[p])
+                cellOf(i, base.data());
+
+                // Gather the buckets of the surrounding cells, skipping
+                // duplicates from hash collisions.
+                buckets.clear();
+                for (size_t code = 0; code < probes; ++code)
+                {
+                    size_t c = code;
+                    for (size_t j = 0; j < ndims; ++j)
+                    {
+                        probe[j] = base[j] + (int64_t)(c % 3) - 1;
+                        c /= 3;
+                    }
+                    auto it = grid.find(cellHash(probe.data(), ndims));
+                    if (it == grid.end())
+                        continue;
+                    const PointIdList *bucket = &it->second;
+                    if (std::find(buckets.begin(), buckets.end(), bucket) ==
+                        buckets.end())
+                        buckets.push_back(bucket);
+                }
+
+                // The KD radius query this replaces used a strict bound,
+                // so keep dist < eps.
+                PointIdList& nbrs = neighbors[i];
+                for (const PointIdList *bucket : buckets)
                 {
-                    if (neighbors_visited.count(q) == 0)
-                        neighbors_next.insert(q);
+                    for (PointId q : *bucket)
+                    {
+                        double dist2 = 0;
+                        for (size_t j = 0; j < ndims; ++j)
+                        {
+                            double d = coords[i * ndims + j] -
+                                coords[q * ndims + j];
+                            dist2 += d * d;
+                        }
+                        if (dist2 < eps2)
+                            nbrs.push_back(q);
+                    }
                 }
             }
+        });
+    }
+    for (auto& t : pool)
+        t.join();
+
+    // Core points are those with dense neighborhoods.  Clusters are the
+    // connected components of the core points under the eps relation, so
+    // merge them with a union-find instead of expanding regions one
+    // point at a time.
+    std::vector<PointId> parent(np);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](PointId i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
         }
+        return i;
+    };
+
+    auto core = [this, &neighbors](PointId i)
+        { return neighbors[i].size() >= m_minPoints; };
+
+    for (PointId i = 0; i < np; ++i)
+    {
+        if (!core(i))
+            continue;
+        for (PointId q : neighbors[i])
+            if (core(q))
+                parent[find(q)] = find(i);
+    }
+
+    // Number the clusters by the first core point of each component, in
+    // point order, to match the labels the sequential expansion produced.
+    std::vector<int64_t> label(np, -1);
+    std::vector<int64_t> rootLabel(np, -1);
+    int64_t clusterLabel = 0;
+    for (PointId i = 0; i < np; ++i)
+    {
+        if (!core(i))
+            continue;
+        PointId r = find(i);
+        if (rootLabel[r] == -1)
+            rootLabel[r] = clusterLabel++;
+        label[i] = rootLabel[r];
+    }
 
-        cluster_label++;
+    // A border point joins the lowest-numbered cluster with a core point
+    // in range - the first one that would have reached it.  Everything
+    // else is noise.
+    for (PointId i = 0; i < np; ++i)
+    {
+        if (core(i))
+            continue;
+        for (PointId q : neighbors[i])
+        {
+            if (!core(q))
+                continue;
+            int64_t l = rootLabel[find(q)];
+            if (label[i] == -1 || l < label[i])
+                label[i] = l;
+        }
     }
+
+    for (PointId i = 0; i < np; ++i)
+        view.setField(m_cluster, i, label[i]);
 }
 
 } // namespace pdal
@@ -56,6 +56,7 @@ public:
 private:
     uint64_t m_minPoints;
     double m_eps;
+    size_t m_threads;
     Dimension::Id m_cluster;
     StringList m_dimStringList;
     Dimension::IdList m_dimIdList;
@@ -64,6 +65,7 @@ private:
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void prepared(PointTableRef table);
     virtual void filter(PointView& view);
+    size_t threadCount(point_count_t np) const;
 };
 
 } // namespace pdal
@@ -34,6 +34,7 @@
 
 #include "DEMFilter.hpp"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -138,13 +139,69 @@ PointViewSet DEMFilter::run(PointViewPtr inView)
 
     PointViewPtr outView = inView->makeNew();
 
+    // Locate each point in the raster up front, then fetch the band in row
+    // strips aligned to the native block size and test the points against
+    // the strips in memory.  Each underlying GDAL block is decoded once
+    // instead of once per point in it.
+    struct Target
+    {
+        int32_t line;
+        int32_t pixel;
+        PointId id;
+    };
+    std::vector<Target> targets;
+    targets.reserve(inView->size());
+
     for (PointId i = 0; i < inView->size(); ++i)
     {
-        PointRef point = inView->point(i);
-        if (processOne(point))
-            outView->appendPoint(*inView, i);
+        double x = inView->getFieldAs<double>(Dimension::Id::X, i);
+        double y = inView->getFieldAs<double>(Dimension::Id::Y, i);
+
+        // Points without a raster pixel fail the filter, as before.
+        int32_t pixel(0);
+        int32_t line(0);
+        if (m_raster->coordToPixel(x, y, pixel, line))
+            targets.push_back({line, pixel, i});
     }
 
+    std::sort(targets.begin(), targets.end(),
+        [](const Target& a, const Target& b)
+        { return a.line < b.line; });
+
+    int xSize, ySize;
+    if (m_raster->blockSize(m_args->m_band, xSize, ySize) !=
+            gdal::GDALError::None || ySize <= 0)
+        ySize = 1;
+
+    // Pass/fail is recorded per point so that the output view keeps the
+    // input point order.
+    std::vector<char> passes(inView->size(), false);
+    std::vector<double> strip;
+    auto it = targets.begin();
+    while (it != targets.end())
+    {
+        // Each strip covers one row of raster blocks.
+        int firstRow = (it->line / ySize) * ySize;
+        int rowCount = (std::min)(ySize, m_raster->height() - firstRow);
+        if (m_raster->readBandRows(strip, m_args->m_band, firstRow,
+                rowCount) != gdal::GDALError::None)
+            throwError(m_raster->errorMsg());
+
+        for (; it != targets.end() && it->line < firstRow + rowCount; ++it)
+        {
+            double v = strip[(size_t)(it->line - firstRow) *
+                m_raster->width() + it->pixel];
+            double z = inView->getFieldAs<double>(m_args->m_dim, it->id);
+            double lb = v - m_args->m_range.m_lower_bound;
+            double ub = v + m_args->m_range.m_upper_bound;
+            passes[it->id] = (z >= lb && z <= ub);
+        }
+    }
+
+    for (PointId i = 0; i < inView->size(); ++i)
+        if (passes[i])
+            outView->appendPoint(*inView, i);
+
     viewSet.insert(outView);
     return viewSet;
 }
@@ -37,6 +37,12 @@
 #include <pdal/PointView.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
+#include "private/Random.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
 namespace pdal
 {
 
@@ -58,13 +64,35 @@ void DecimationFilter::addArgs(ProgramArgs& args)
         m_offset);
     args.add("limit", "Index of last point to consider including in output",
         m_limit, (std::numeric_limits<point_count_t>::max)());
+    m_countArg = &args.add("count", "Number of points to select by "
+        "reservoir sampling instead of stepping", m_count);
+    m_seedArg = &args.add("seed", "Random number generator seed for "
+        "reservoir sampling", m_seed, 0u);
 }
 
 PointViewSet DecimationFilter::run(PointViewPtr inView)
 {
     PointViewSet viewSet;
-    PointViewPtr outView = inView->makeNew();
-    decimate(*inView.get(), *outView.get());
+    PointViewPtr outView;
+
+    PointId last_idx = (std::min)(m_limit, inView->size());
+    point_count_t avail = last_idx > m_offset ? last_idx - m_offset : 0;
+
+    if (m_countArg->set())
+    {
+        outView = inView->makeNew();
+        reservoir(*inView.get(), *outView.get(), avail);
+    }
+    else if (m_step == 1)
+        // Offset/limit selection with no stepping keeps a contiguous
+        // range, so splice the index instead of copying survivors one at
+        // a time.
+        outView = inView->slice(m_offset, avail);
+    else
+    {
+        outView = inView->makeNew();
+        decimate(*inView.get(), *outView.get());
+    }
     viewSet.insert(outView);
     return viewSet;
 }
@@ -72,6 +100,12 @@ PointViewSet DecimationFilter::run(PointViewPtr inView)
 
 bool DecimationFilter::processOne(PointRef& point)
 {
+    // Reservoir sampling needs to revoke points already passed
+    // downstream, which a streaming filter can't do.
+    if (m_countArg->set())
+        throwError("Option 'count' (reservoir sampling) can't be used "
+            "in streaming pipelines.");
+
     bool keep = true;
     if (m_index < m_offset || m_index >= m_limit)
         keep = false;
@@ -89,4 +123,35 @@ void DecimationFilter::decimate(PointView& input, PointView& output)
         output.appendPoint(input, idx);
 }
 
+
+// Algorithm R over the candidate range: every candidate ends up in the
+// sample with probability count / avail.  Survivors are emitted in input
+// order.
+void DecimationFilter::reservoir(PointView& input, PointView& output,
+    point_count_t avail)
+{
+    unsigned seed = m_seed;
+    if (!m_seedArg->set())
+    {
+        std::random_device rng;
+        seed = rng();
+    }
+
+    point_count_t n = (std::min)(m_count, avail);
+    PointIdList keep(n);
+    std::iota(keep.begin(), keep.end(), (PointId)m_offset);
+
+    uint64_t state = seed;
+    for (point_count_t i = n; i < avail; ++i)
+    {
+        uint64_t j = fastrand::bounded(state, i + 1);
+        if (j < n)
+            keep[j] = m_offset + i;
+    }
+
+    std::sort(keep.begin(), keep.end());
+    for (PointId idx : keep)
+        output.appendPoint(input, idx);
+}
+
 } // pdal
@@ -53,6 +53,10 @@ private:
     uint32_t m_step;
     uint32_t m_offset;
     point_count_t m_limit;
+    point_count_t m_count;
+    Arg *m_countArg;
+    unsigned m_seed;
+    Arg *m_seedArg;
     PointId m_index;
 
     virtual void addArgs(ProgramArgs& args);
@@ -61,6 +65,8 @@ private:
     bool processOne(PointRef& point);
     PointViewSet run(PointViewPtr view);
     void decimate(PointView& input, PointView& output);
+    void reservoir(PointView& input, PointView& output,
+        point_count_t avail);
 
     DecimationFilter& operator=(const DecimationFilter&); // not implemented
     DecimationFilter(const DecimationFilter&); // not implemented
@@ -32,9 +32,12 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <algorithm>
 #include <cstddef> // NULL
+#include <thread>
 #include "DelaunayFilter.hpp"
 #include "private/delaunator.hpp"
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -62,6 +65,19 @@ DelaunayFilter::~DelaunayFilter()
 {}
 
 
+void DelaunayFilter::addArgs(ProgramArgs& args)
+{
+    args.add("threads", "Number of threads used to sort points before "
+        "triangulation (0 = choose automatically)", m_threads);
+}
+
+
+size_t DelaunayFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
+}
+
+
 void DelaunayFilter::filter(PointView& pointView)
 {
     // Returns NULL if the mesh already exists
@@ -76,17 +92,27 @@ void DelaunayFilter::filter(PointView& pointView)
         return;
     }
 
-    std::vector<double> delaunayPoints;
-    for (PointId i = 0; i < pointView.size(); i++)
+    // Interleave the coordinates as x,y pairs, fetching them a block at a
+    // time rather than with a field access per point.
+    point_count_t np = pointView.size();
+    std::vector<double> delaunayPoints(2 * np);
+    const point_count_t BatchSize = 4096;
+    std::vector<double> xs(BatchSize);
+    std::vector<double> ys(BatchSize);
+    for (PointId start = 0; start < np; start += BatchSize)
     {
-        delaunayPoints.push_back(
-            pointView.getFieldAs<double>(Dimension::Id::X, i));
-        delaunayPoints.push_back(
-            pointView.getFieldAs<double>(Dimension::Id::Y, i));
+        point_count_t n = (std::min)(BatchSize, np - start);
+        pointView.getFieldBatch(Dimension::Id::X, start, n, xs.data());
+        pointView.getFieldBatch(Dimension::Id::Y, start, n, ys.data());
+        for (point_count_t i = 0; i < n; ++i)
+        {
+            delaunayPoints[2 * (start + i)] = xs[i];
+            delaunayPoints[2 * (start + i) + 1] = ys[i];
+        }
     }
 
     // Actually perform the triangulation
-    delaunator::Delaunator triangulation(delaunayPoints);
+    delaunator::Delaunator triangulation(delaunayPoints, threadCount(np));
 
     for (std::size_t i = 0; i < triangulation.triangles.size(); i += 3)
         mesh->add(triangulation.triangles[i+2], triangulation.triangles[i+1],
@@ -50,7 +50,11 @@ public:
     std::string getName() const;
 
 private:
+    size_t m_threads;
+
+    virtual void addArgs(ProgramArgs& args);
     virtual void filter(PointView& view);
+    size_t threadCount(point_count_t np) const;
 };
 
 } // namespace pdal
@@ -121,27 +121,24 @@ PointViewSet DividerFilter::run(PointViewPtr inView)
 	m_size = ((inView->size() - 1) / m_size) + 1;
 
 
-    std::vector<PointViewPtr> views;
-    for (point_count_t i = 0; i < m_size; ++i)
-    {
-        PointViewPtr v(inView->makeNew());
-        views.push_back(v);
-        result.insert(v);
-    }
-
     if (m_mode == Mode::Partition)
     {
+        // Each output is a sequential run of input points, so hand out
+        // copy-on-write slices instead of copying IDs point by point.
         point_count_t limit = ((inView->size() - 1) / m_size) + 1;
-        unsigned viewNum = 0;
-        for (PointId i = 0; i < inView->size();)
-        {
-            views[viewNum]->appendPoint(*inView, i++);
-            if (i % limit == 0)
-                viewNum++;
-        }
+        for (point_count_t i = 0; i < m_size; ++i)
+            result.insert(inView->slice(i * limit, limit));
     }
     else // RoundRobin
     {
+        std::vector<PointViewPtr> views;
+        for (point_count_t i = 0; i < m_size; ++i)
+        {
+            PointViewPtr v(inView->makeNew());
+            views.push_back(v);
+            result.insert(v);
+        }
+
         unsigned viewNum = 0;
         for (PointId i = 0; i < inView->size(); ++i)
         {
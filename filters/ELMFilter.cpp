@@ -41,8 +41,9 @@
 
 #include <pdal/EigenUtils.hpp>
 
-#include <map>
+#include <algorithm>
 #include <string>
+#include <vector>
 
 namespace pdal
 {
@@ -81,14 +82,22 @@ void ELMFilter::filter(PointView& view)
     BOX2D bounds;
     calculateBounds(view, bounds);
 
-    size_t cols =
-        static_cast<size_t>(((bounds.maxx - bounds.minx) / m_cell) + 1);
     size_t rows =
         static_cast<size_t>(((bounds.maxy - bounds.miny) / m_cell) + 1);
 
-    // Make an initial pass through the input PointView to index elevation
-    // values and PointIds by row and column.
-    std::map<uint32_t, std::multimap<double, PointId>> hash;
+    // Index each point by cell and sort by cell and elevation.  A flat
+    // sorted array replaces the earlier map of multimaps - one
+    // allocation of three values per point instead of a tree node per
+    // point, and classification becomes a sequential scan over cell
+    // runs.
+    struct GridPoint
+    {
+        size_t m_cell;
+        double m_z;
+        PointId m_id;
+    };
+
+    std::vector<GridPoint> gps(view.size());
     for (PointId id = 0; id < view.size(); ++id)
     {
         double x = view.getFieldAs<double>(Dimension::Id::X, id);
@@ -98,38 +107,42 @@ void ELMFilter::filter(PointView& view)
         size_t c = static_cast<size_t>(std::floor(x - bounds.minx) / m_cell);
         size_t r = static_cast<size_t>(std::floor(y - bounds.miny) / m_cell);
 
-        hash[c * rows + r].emplace(z, id);
+        gps[id] = { c * rows + r, z, id };
     }
+    std::sort(gps.begin(), gps.end(),
+        [](const GridPoint& g1, const GridPoint& g2)
+        {
+            if (g1.m_cell != g2.m_cell)
+                return g1.m_cell < g2.m_cell;
+            return g1.m_z < g2.m_z;
+        });
 
     // Count the number of points we classify as noise.
     point_count_t num(0);
 
-    // Make a second pass through the now rasterized PointView to compute the
-    // extended local minimum.
-    for (size_t c = 0; c < cols; ++c)
+    // Each run of the same cell holds that cell's points in ascending
+    // elevation.
+    for (size_t b = 0; b < gps.size();)
     {
-        for (size_t r = 0; r < rows; ++r)
+        size_t e = b + 1;
+        while (e < gps.size() && gps[e].m_cell == gps[b].m_cell)
+            ++e;
+
+        for (size_t i = b; i + 1 < e; ++i)
         {
-            std::multimap<double, PointId> ids(hash[c * rows + r]);
-
-            if (ids.size() <= 1)
-                continue;
-
-            for (auto it = ids.begin(); it != std::prev(ids.end()); ++it)
-            {
-                // Where the current value is sufficiently close to the next, we
-                // consider that this is not a low outlier and break the current
-                // loop.
-                if (std::fabs(it->first - std::next(it)->first) < m_threshold)
-                    break;
-
-                // Otherwise this point is classified as noise, and we proceed
-                // to the next lowest value.
-                view.setField(Dimension::Id::Classification, it->second,
-                              m_class);
-                ++num;
-            }
+            // Where the current value is sufficiently close to the next, we
+            // consider that this is not a low outlier and break the current
+            // loop.
+            if (std::fabs(gps[i].m_z - gps[i + 1].m_z) < m_threshold)
+                break;
+
+            // Otherwise this point is classified as noise, and we proceed
+            // to the next lowest value.
+            view.setField(Dimension::Id::Classification, gps[i].m_id,
+                          m_class);
+            ++num;
         }
+        b = e;
     }
 
     log()->get(LogLevel::Info)
@@ -86,13 +86,9 @@ void EigenvaluesFilter::filter(PointView& view)
         // find the k-nearest neighbors
         auto ids = kdi.neighbors(i, m_knn);
 
-        // compute covariance of the neighborhood
-        auto B = computeCovariance(view, ids);
-
-        // perform the eigen decomposition
-        SelfAdjointEigenSolver<Matrix3d> solver(B);
-        if (solver.info() != Success)
-            throwError("Cannot perform eigen decomposition.");
+        // decompose the neighborhood covariance with the closed-form
+        // 3x3 kernel
+        auto solver = computeEigen(view, ids);
         auto ev = solver.eigenvalues();
 
         if (m_normalize)
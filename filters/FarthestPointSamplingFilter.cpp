@@ -34,13 +34,14 @@
 
 #include "FarthestPointSamplingFilter.hpp"
 
-#include <pdal/KDIndex.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include <algorithm>
 #include <limits>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace pdal
@@ -64,6 +65,13 @@ void FarthestPointSamplingFilter::addArgs(ProgramArgs& args)
 {
     args.add("count", "Target number of points after sampling", m_count,
              point_count_t(1000));
+    args.add("threads", "Number of threads used to run this filter "
+             "(0 = choose automatically)", m_threads);
+}
+
+size_t FarthestPointSamplingFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
 }
 
 PointViewSet FarthestPointSamplingFilter::run(PointViewPtr inView)
@@ -76,48 +84,94 @@ PointViewSet FarthestPointSamplingFilter::run(PointViewPtr inView)
     // Otherwise, make a new output PointView.
     PointViewPtr outView = inView->makeNew();
 
-    // Construct a KD-tree of the input view.
-    KD3Index& kdi = inView->build3dIndex();
+    point_count_t np = inView->size();
+
+    // Gather coordinates once so the per-round sweep runs over contiguous
+    // arrays with no tree traversal.
+    std::vector<double> xs(np), ys(np), zs(np);
+    const point_count_t BatchSize = 4096;
+    for (PointId start = 0; start < np; start += BatchSize)
+    {
+        point_count_t n = (std::min)(BatchSize, np - start);
+        inView->getFieldBatch(Dimension::Id::X, start, n, xs.data() + start);
+        inView->getFieldBatch(Dimension::Id::Y, start, n, ys.data() + start);
+        inView->getFieldBatch(Dimension::Id::Z, start, n, zs.data() + start);
+    }
 
     // Seed the output view with the first point in the current sorting.
     PointId seedId(0);
     outView->appendPoint(*inView, seedId);
 
-    // Compute distances from seedId to all other points.
-    PointIdList indices(inView->size());
-    std::vector<double> sqr_dists(inView->size());
-    kdi.knnSearch(seedId, inView->size(), &indices, &sqr_dists);
+    // Track the squared distance from each point to its nearest selected
+    // point.  Each round folds the newest selection into the array and
+    // finds the next farthest point in the same sweep, making the whole
+    // sample O(count * n) instead of one full KD query per round.
+    std::vector<double> min_dists(np);
+    size_t threads = threadCount(np);
+    std::vector<double> maxes(threads);
+    PointIdList argmaxes(threads);
 
-    // Sort distances by PointId.
-    std::vector<double> min_dists(inView->size());
-    for (PointId i = 0; i < inView->size(); ++i)
-        min_dists[indices[i]] = sqr_dists[i];
+    auto sweepSlice = [&](size_t t, PointId idx, bool init)
+    {
+        PointId start = np * t / threads;
+        PointId end = np * (t + 1) / threads;
+        const double px = xs[idx];
+        const double py = ys[idx];
+        const double pz = zs[idx];
+        double best = -1.0;
+        PointId bestId = start;
+        for (PointId j = start; j < end; ++j)
+        {
+            double dx = xs[j] - px;
+            double dy = ys[j] - py;
+            double dz = zs[j] - pz;
+            double d = dx * dx + dy * dy + dz * dz;
+            if (init || d < min_dists[j])
+                min_dists[j] = d;
+            if (min_dists[j] > best)
+            {
+                best = min_dists[j];
+                bestId = j;
+            }
+        }
+        maxes[t] = best;
+        argmaxes[t] = bestId;
+    };
 
     // Proceed until we have m_count points in the output PointView.
+    PointId idx = seedId;
     for (PointId i = 1; i < m_count; ++i)
     {
-        // Find the max distance in min_dists, this is the farthest point from
-        // any point currently in the output PointView.
-        auto it = std::max_element(min_dists.begin(), min_dists.end());
+        if (threads == 1)
+            sweepSlice(0, idx, i == 1);
+        else
+        {
+            std::vector<std::thread> pool;
+            for (size_t t = 0; t < threads; ++t)
+                pool.emplace_back([&sweepSlice, t, idx, i]()
+                    { sweepSlice(t, idx, i == 1); });
+            for (auto& t : pool)
+                t.join();
+        }
+
+        // Reduce the slice maxima in order, keeping the first point with
+        // the largest distance as std::max_element would.
+        double best = maxes[0];
+        idx = argmaxes[0];
+        for (size_t t = 1; t < threads; ++t)
+            if (maxes[t] > best)
+            {
+                best = maxes[t];
+                idx = argmaxes[t];
+            }
 
         // Record the PointId of the farthest point and add it to the output
         // PointView.
-        PointId idx(it - min_dists.begin());
         outView->appendPoint(*inView, idx);
 
         log()->get(LogLevel::Debug)
             << "Adding PointId " << idx << " with distance "
             << std::sqrt(min_dists[idx]) << std::endl;
-
-        // Compute distances from idx to all other points.
-        kdi.knnSearch(idx, inView->size(), &indices, &sqr_dists);
-
-        // Update distances.
-        for (PointId j = 0; j < inView->size(); ++j)
-        {
-            if (sqr_dists[j] < min_dists[indices[j]])
-                min_dists[indices[j]] = sqr_dists[j];
-        }
     }
 
     viewSet.insert(outView);
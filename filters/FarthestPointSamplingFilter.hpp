@@ -52,8 +52,10 @@ public:
 
 private:
     point_count_t m_count;
+    size_t m_threads;
 
     virtual void addArgs(ProgramArgs& args);
+    size_t threadCount(point_count_t np) const;
     virtual PointViewSet run(PointViewPtr view);
 };
 
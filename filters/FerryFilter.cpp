@@ -37,6 +37,9 @@
 #include <pdal/util/Algorithm.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace pdal
 {
 
@@ -129,11 +132,23 @@ bool FerryFilter::processOne(PointRef& point)
 
 void FerryFilter::filter(PointView& view)
 {
-    PointRef point(view, 0);
-    for (PointId id = 0; id < view.size(); ++id)
+    // Copy each mapping in blocks through a conversion buffer instead of
+    // one field at a time.  Mappings are applied in option order, so a
+    // destination that feeds a later mapping behaves as it did with the
+    // per-point path.
+    point_count_t np = view.size();
+    const point_count_t BatchSize = 4096;
+    std::vector<double> buf(BatchSize);
+    for (const auto& info : m_dims)
     {
-        point.setPointId(id);
-        processOne(point);
+        if (info.m_fromId == Dimension::Id::Unknown)
+            continue;
+        for (PointId start = 0; start < np; start += BatchSize)
+        {
+            point_count_t n = (std::min)(BatchSize, np - start);
+            view.getFieldBatch(info.m_fromId, start, n, buf.data());
+            view.setFieldBatch(info.m_toId, start, n, buf.data());
+        }
     }
 }
 
@@ -70,6 +70,8 @@ private:
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void prepared(PointTableRef table);
     virtual bool processOne(PointRef& point);
+    virtual bool fusable() const
+        { return true; }
     virtual void filter(PointView& view);
 
     FerryFilter& operator=(const FerryFilter&) = delete;
@@ -96,25 +96,13 @@ void GreedyProjection::initialize()
 
 Eigen::Vector3d GreedyProjection::getCoord(PointId id)
 {
-    assert(view_);
-
-    return Eigen::Vector3d(
-        view_->getFieldAs<double>(Dimension::Id::X, id),
-        view_->getFieldAs<double>(Dimension::Id::Y, id),
-        view_->getFieldAs<double>(Dimension::Id::Z, id)
-    );
+    return coords_[id];
 }
 
 
 Eigen::Vector3d GreedyProjection::getNormalCoord(PointId id)
 {
-    assert(view_);
-
-    return Eigen::Vector3d(
-        view_->getFieldAs<double>(Dimension::Id::NormalX, id),
-        view_->getFieldAs<double>(Dimension::Id::NormalY, id),
-        view_->getFieldAs<double>(Dimension::Id::NormalZ, id)
-    );
+    return normals_[id];
 }
 
 
@@ -135,6 +123,32 @@ void GreedyProjection::filter(PointView& view)
     const double sqr_mu = mu_ * mu_;
     const double sqr_max_edge = search_radius_*search_radius_;
 
+    // Cache coordinates and normals in contiguous arrays up front; the
+    // advancing front revisits each point many times and the per-field
+    // view lookups dominated otherwise.
+    coords_.clear();
+    normals_.clear();
+    coords_.resize(view.size());
+    normals_.resize(view.size());
+    {
+        const point_count_t BatchSize = 4096;
+        std::vector<double> xs(BatchSize), ys(BatchSize), zs(BatchSize);
+        for (PointId start = 0; start < view.size(); start += BatchSize)
+        {
+            point_count_t n = (std::min)(BatchSize, view.size() - start);
+            view.getFieldBatch(Dimension::Id::X, start, n, xs.data());
+            view.getFieldBatch(Dimension::Id::Y, start, n, ys.data());
+            view.getFieldBatch(Dimension::Id::Z, start, n, zs.data());
+            for (point_count_t i = 0; i < n; ++i)
+                coords_[start + i] = Eigen::Vector3d(xs[i], ys[i], zs[i]);
+            view.getFieldBatch(Dimension::Id::NormalX, start, n, xs.data());
+            view.getFieldBatch(Dimension::Id::NormalY, start, n, ys.data());
+            view.getFieldBatch(Dimension::Id::NormalZ, start, n, zs.data());
+            for (point_count_t i = 0; i < n; ++i)
+                normals_[start + i] = Eigen::Vector3d(xs[i], ys[i], zs[i]);
+        }
+    }
+
     nnn_ = (int)(std::min)((point_count_t)nnn_, view.size());
 
     // Variables to hold the results of nearest neighbor searches
@@ -298,6 +298,12 @@ namespace pdal
       PointIdList part_;
       /** \brief Points on the outer edge from which the mesh is grown **/
       PointIdList fringe_queue_;
+      /** \brief Cached point coordinates **/
+      std::vector<Eigen::Vector3d,
+          Eigen::aligned_allocator<Eigen::Vector3d> > coords_;
+      /** \brief Cached point normals **/
+      std::vector<Eigen::Vector3d,
+          Eigen::aligned_allocator<Eigen::Vector3d> > normals_;
 
       /** \brief Flag to set if the current point is free **/
       bool is_current_free_;
@@ -47,7 +47,8 @@ static StaticPluginInfo const s_info
 };
 CREATE_STATIC_STAGE(GroupByFilter, s_info)
 
-GroupByFilter::GroupByFilter() : m_viewMap()
+GroupByFilter::GroupByFilter() : m_viewMap(), m_streamTable(nullptr),
+    m_lastValue(0), m_haveValue(false)
 {}
 
 std::string GroupByFilter::getName() const
@@ -69,6 +70,32 @@ void GroupByFilter::prepared(PointTableRef table)
     // also need to check that we have a dimension with discrete values
 }
 
+void GroupByFilter::ready(PointTableRef table)
+{
+    m_streamTable = dynamic_cast<StreamPointTable *>(&table);
+    m_haveValue = false;
+}
+
+// When streaming, we can't accumulate views, so we split where the group
+// value changes.  Each run of equal values gets flagged as a group on the
+// stream table, and a downstream writer with a template-based filename
+// (see FlexWriter) starts a new file at each flagged point.  Data where
+// the values arrive clustered - merged inputs split by PointSourceId,
+// sorted data - splits just as in standard mode without buffering
+// anything; interleaved values produce a file per run.
+bool GroupByFilter::processOne(PointRef& point)
+{
+    uint64_t val = point.getFieldAs<uint64_t>(m_dimId);
+    if (!m_haveValue || val != m_lastValue)
+    {
+        if (m_streamTable)
+            m_streamTable->setGroupStart(point.pointId());
+        m_lastValue = val;
+        m_haveValue = true;
+    }
+    return true;
+}
+
 PointViewSet GroupByFilter::run(PointViewPtr inView)
 {
     PointViewSet viewSet;
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <pdal/Filter.hpp>
+#include <pdal/Streamable.hpp>
 
 #include <map>
 #include <string>
@@ -45,7 +46,7 @@ namespace pdal
 class PointView;
 class ProgramArgs;
 
-class PDAL_DLL GroupByFilter : public Filter
+class PDAL_DLL GroupByFilter : public Filter, public Streamable
 {
 public:
     GroupByFilter();
@@ -56,10 +57,17 @@ private:
     std::map<uint64_t, PointViewPtr> m_viewMap;
     std::string m_dimName;
     Dimension::Id m_dimId;
+    // Streaming state: marks group breaks on the stream table so a
+    // downstream writer with a template filename can rotate output.
+    StreamPointTable *m_streamTable;
+    uint64_t m_lastValue;
+    bool m_haveValue;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void prepared(PointTableRef table);
+    virtual void ready(PointTableRef table);
     virtual PointViewSet run(PointViewPtr view);
+    virtual bool processOne(PointRef& point);
 
     GroupByFilter& operator=(const GroupByFilter&); // not implemented
     GroupByFilter(const GroupByFilter&); // not implemented
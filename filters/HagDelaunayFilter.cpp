@@ -32,12 +32,18 @@
 #include "HagDelaunayFilter.hpp"
 
 #include <pdal/KDIndex.hpp>
+#include <pdal/PipelineManager.hpp>
 
 #include "private/delaunator.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <list>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
-#include <cmath>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -93,42 +99,30 @@ double distance_along_z(double x1, double y1, double z1,
 
 // The non-ground point (x0, y0) is in exactly 0 or 1 of the triangles of
 // the ground triangulation, so when we find a triangle containing the point,
-// return the interpolated z.
+// return the interpolated z, or infinity if no triangle contains it.
 // (I suppose the point could be on a edge of two triangles, but the
 //  result is the same, so this is still good.)
-double delaunay_interp_ground(double x0, double y0, PointViewPtr gView,
-    const PointIdList& ids)
+double walk_triangles(double x0, double y0, const PointView& gView,
+    const PointIdList& ids, const std::vector<size_t>& triangles)
 {
     using namespace pdal::Dimension;
 
-    // Delaunay-based interpolation
-    std::vector<double> neighbors;
-
-    for (size_t j = 0; j < ids.size(); ++j)
-    {
-        neighbors.push_back(gView->getFieldAs<double>(Id::X, ids[j]));
-        neighbors.push_back(gView->getFieldAs<double>(Id::Y, ids[j]));
-    }
-
-    delaunator::Delaunator triangulation(neighbors);
-    const std::vector<size_t>& triangles(triangulation.triangles);
-
     for (size_t j = 0; j < triangles.size(); j += 3)
     {
         auto ai = triangles[j+0];
         auto bi = triangles[j+1];
         auto ci = triangles[j+2];
-        double ax = gView->getFieldAs<double>(Id::X, ids[ai]);
-        double ay = gView->getFieldAs<double>(Id::Y, ids[ai]);
-        double az = gView->getFieldAs<double>(Id::Z, ids[ai]);
+        double ax = gView.getFieldAs<double>(Id::X, ids[ai]);
+        double ay = gView.getFieldAs<double>(Id::Y, ids[ai]);
+        double az = gView.getFieldAs<double>(Id::Z, ids[ai]);
 
-        double bx = gView->getFieldAs<double>(Id::X, ids[bi]);
-        double by = gView->getFieldAs<double>(Id::Y, ids[bi]);
-        double bz = gView->getFieldAs<double>(Id::Z, ids[bi]);
+        double bx = gView.getFieldAs<double>(Id::X, ids[bi]);
+        double by = gView.getFieldAs<double>(Id::Y, ids[bi]);
+        double bz = gView.getFieldAs<double>(Id::Z, ids[bi]);
 
-        double cx = gView->getFieldAs<double>(Id::X, ids[ci]);
-        double cy = gView->getFieldAs<double>(Id::Y, ids[ci]);
-        double cz = gView->getFieldAs<double>(Id::Z, ids[ci]);
+        double cx = gView.getFieldAs<double>(Id::X, ids[ci]);
+        double cy = gView.getFieldAs<double>(Id::Y, ids[ci]);
+        double cz = gView.getFieldAs<double>(Id::Z, ids[ci]);
 
         // Returns infinity unless the point x0/y0 is in the triangle.
         double z1 = distance_along_z(ax, ay, az, bx, by, bz,
@@ -136,15 +130,130 @@ double delaunay_interp_ground(double x0, double y0, PointViewPtr gView,
         if (z1 != std::numeric_limits<double>::infinity())
             return z1;
     }
+    return std::numeric_limits<double>::infinity();
+}
+
+
+std::vector<size_t> triangulate(const PointView& gView, const PointIdList& ids)
+{
+    using namespace pdal::Dimension;
+
+    std::vector<double> coords;
+    for (size_t j = 0; j < ids.size(); ++j)
+    {
+        coords.push_back(gView.getFieldAs<double>(Id::X, ids[j]));
+        coords.push_back(gView.getFieldAs<double>(Id::Y, ids[j]));
+    }
+    return delaunator::Delaunator(coords).triangles;
+}
+
+
+double delaunay_interp_ground(double x0, double y0, PointViewPtr gView,
+    const PointIdList& ids)
+{
+    double z = walk_triangles(x0, y0, *gView, ids, triangulate(*gView, ids));
+
     // If the non ground point was outside the triangulation of ground
     // points, just use the Z coordinate of the closest
     // ground point.
-    return gView->getFieldAs<double>(Id::Z, ids[0]);
+    if (z == std::numeric_limits<double>::infinity())
+        z = gView->getFieldAs<double>(Dimension::Id::Z, ids[0]);
+    return z;
 }
 
 } // unnamed namespace
 
 
+// Ground model with bounded memory: the ground points and their 2D index
+// stay resident, but triangulations are built per grid cell on first use
+// and only the most recently used cells are kept.  Each cell is
+// triangulated with a halo of half a cell so interpolation near cell
+// edges sees triangles that span the boundary.
+struct HagDelaunayFilter::GroundSurface
+{
+    struct Cell
+    {
+        PointIdList m_ids;
+        std::vector<size_t> m_triangles;
+    };
+    using LruList = std::list<std::pair<uint64_t, Cell>>;
+
+    GroundSurface(PointViewPtr view, double cellSize, size_t cacheSize) :
+        m_view(view), m_index(view->build2dIndex()), m_cellSize(cellSize),
+        m_cacheSize(cacheSize)
+    { view->calculateBounds(m_bounds); }
+
+    Cell& cell(double x, double y)
+    {
+        int64_t col = (int64_t)std::floor((x - m_bounds.minx) / m_cellSize);
+        int64_t row = (int64_t)std::floor((y - m_bounds.miny) / m_cellSize);
+        uint64_t key = ((uint64_t)(uint32_t)(int32_t)col << 32) |
+            (uint64_t)(uint32_t)(int32_t)row;
+
+        auto it = m_cells.find(key);
+        if (it != m_cells.end())
+        {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return it->second->second;
+        }
+
+        // Gather the ground points in the cell plus its halo.  The query
+        // circle is centered on the cell and sized to cover the cell
+        // grown by half a cell on each side.
+        double cx = m_bounds.minx + (col + .5) * m_cellSize;
+        double cy = m_bounds.miny + (row + .5) * m_cellSize;
+        double radius = m_cellSize * std::sqrt(2.0);
+
+        Cell c;
+        c.m_ids = m_index.radius(cx, cy, radius);
+        if (c.m_ids.size() >= 3)
+            c.m_triangles = triangulate(*m_view, c.m_ids);
+
+        m_lru.emplace_front(key, std::move(c));
+        m_cells[key] = m_lru.begin();
+        if (m_lru.size() > m_cacheSize)
+        {
+            m_cells.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+        return m_lru.front().second;
+    }
+
+    // Interpolated ground height at x0/y0, with the same fallback rules
+    // as the per-point triangulation path.
+    double interpolate(double x0, double y0, double z0, bool extrapolate)
+    {
+        PointIdList ids(1);
+        std::vector<double> sqrDists(1);
+        m_index.knnSearch(x0, y0, 1, &ids, &sqrDists);
+
+        double x = m_view->getFieldAs<double>(Dimension::Id::X, ids[0]);
+        double y = m_view->getFieldAs<double>(Dimension::Id::Y, ids[0]);
+        double z = m_view->getFieldAs<double>(Dimension::Id::Z, ids[0]);
+
+        if (x0 == x && y0 == y)
+            return z;
+        if (!m_bounds.contains(x0, y0) && !extrapolate)
+            return z0;
+
+        Cell& c = cell(x0, y0);
+        double z1 = walk_triangles(x0, y0, *m_view, c.m_ids, c.m_triangles);
+        // Outside the local triangulation - use the nearest ground point.
+        if (z1 == std::numeric_limits<double>::infinity())
+            z1 = z;
+        return z1;
+    }
+
+    PointViewPtr m_view;
+    const KD2Index& m_index;
+    double m_cellSize;
+    size_t m_cacheSize;
+    BOX2D m_bounds;
+    LruList m_lru;
+    std::unordered_map<uint64_t, LruList::iterator> m_cells;
+};
+
+
 static StaticPluginInfo const s_info
 {
     "filters.hag_delaunay",
@@ -165,6 +274,10 @@ HagDelaunayFilter::HagDelaunayFilter()
 {}
 
 
+HagDelaunayFilter::~HagDelaunayFilter()
+{}
+
+
 void HagDelaunayFilter::addArgs(ProgramArgs& args)
 {
     args.add("count", "The number of points to fetch to determine the "
@@ -172,6 +285,22 @@ void HagDelaunayFilter::addArgs(ProgramArgs& args)
     args.add("allow_extrapolation", "Allow extrapolation for points "
         "outside of the local triangulations. [Default: true].",
         m_allowExtrapolation, true);
+    args.add("threads", "Number of threads used for the local "
+        "triangulations (0 = choose automatically)", m_threads);
+    args.add("ground", "File of ground returns used as the reference "
+        "surface instead of the ground-classified input points.  "
+        "Required for stream mode.", m_groundFile);
+    args.add("cell", "Edge length of the grid cells triangulated on "
+        "demand when 'ground' is given [Default: 100].", m_cell, 100.0);
+    args.add("cache_size", "Maximum number of cell triangulations kept "
+        "in memory when 'ground' is given [Default: 64].", m_cacheSize,
+        (size_t)64);
+}
+
+
+size_t HagDelaunayFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
 }
 
 
@@ -185,17 +314,102 @@ void HagDelaunayFilter::prepared(PointTableRef table)
 {
     if (m_count < 3)
         throwError("Option 'count' must be at least 3.");
-
+    if (m_cell <= 0.0)
+        throwError("Option 'cell' must be positive.");
+    if (m_cacheSize < 1)
+        throwError("Option 'cache_size' must be at least 1.");
+
+    // With an external ground file, input points don't need to be
+    // classified - any Classification present is only used to zero
+    // ground returns.
     const PointLayoutPtr layout(table.layout());
-    if (!layout->hasDim(Dimension::Id::Classification))
+    m_hasClassification = layout->hasDim(Dimension::Id::Classification);
+    if (!m_hasClassification && m_groundFile.empty())
         throwError("Missing Classification dimension in input PointView.");
 }
 
 
+void HagDelaunayFilter::ready(PointTableRef table)
+{
+    if (m_groundFile.empty())
+        return;
+
+    PipelineManager mgr;
+    Stage& reader = mgr.makeReader(m_groundFile, "");
+
+    PointTable gTable;
+    reader.prepare(gTable);
+    PointViewSet viewSet = reader.execute(gTable);
+    PointViewPtr fileView = *viewSet.begin();
+
+    // Keep only the ground returns if the file carries classifications;
+    // a bare surface model is used as-is.
+    PointViewPtr gView = fileView;
+    if (gTable.layout()->hasDim(Dimension::Id::Classification))
+    {
+        gView = fileView->makeNew();
+        for (PointId i = 0; i < fileView->size(); ++i)
+            if (fileView->getFieldAs<uint8_t>(Dimension::Id::Classification,
+                    i) == ClassLabel::Ground)
+                gView->appendPoint(*fileView, i);
+        if (gView->size() == fileView->size())
+            gView = fileView;
+    }
+    if (gView->size() == 0)
+        throwError("Ground file '" + m_groundFile + "' does not have any "
+            "points classified as ground.");
+
+    m_surface.reset(new GroundSurface(gView, m_cell, m_cacheSize));
+}
+
+
+void HagDelaunayFilter::done(PointTableRef table)
+{
+    m_surface.reset();
+}
+
+
+bool HagDelaunayFilter::processOne(PointRef& point)
+{
+    using namespace pdal::Dimension;
+
+    if (!m_surface)
+        throwError("Option 'ground' must be specified to run in "
+            "stream mode.");
+
+    if (m_hasClassification &&
+        point.getFieldAs<uint8_t>(Id::Classification) == ClassLabel::Ground)
+    {
+        point.setField(Id::HeightAboveGround, 0);
+        return true;
+    }
+    double x0 = point.getFieldAs<double>(Id::X);
+    double y0 = point.getFieldAs<double>(Id::Y);
+    double z0 = point.getFieldAs<double>(Id::Z);
+    point.setField(Id::HeightAboveGround,
+        z0 - m_surface->interpolate(x0, y0, z0, m_allowExtrapolation));
+    return true;
+}
+
+
 void HagDelaunayFilter::filter(PointView& view)
 {
     using namespace pdal::Dimension;
 
+    // With an external ground model, height comes from the cached cell
+    // triangulations.  Sequential on purpose - consecutive points tend to
+    // hit the same cell, and the cache isn't shared across threads.
+    if (m_surface)
+    {
+        PointRef point(view, 0);
+        for (PointId i = 0; i < view.size(); ++i)
+        {
+            point.setPointId(i);
+            processOne(point);
+        }
+        return;
+    }
+
     PointViewPtr gView = view.makeNew();
     PointViewPtr ngView = view.makeNew();
 
@@ -225,45 +439,59 @@ void HagDelaunayFilter::filter(PointView& view)
     // Find Z difference between non-ground points and the nearest
     // neighbor (2D) in the ground view or between non-ground points and the
     // locally-computed surface (Delaunay triangultion of the neighborhood).
-    for (PointId i = 0; i < ngView->size(); ++i)
-    {
-        PointRef point = ngView->point(i);
-
-        // Non-ground view point for which we're trying to calc HAG
-        double x0 = point.getFieldAs<double>(Id::X);
-        double y0 = point.getFieldAs<double>(Id::Y);
-        double z0 = point.getFieldAs<double>(Id::Z);
-
-        PointIdList ids(m_count);
-        std::vector<double> sqr_dists(m_count);
-        kdi.knnSearch(x0, y0, m_count, &ids, &sqr_dists);
-
-        // Closest ground point.
-        double x = gView->getFieldAs<double>(Id::X, ids[0]);
-        double y = gView->getFieldAs<double>(Id::Y, ids[0]);
-        double z = gView->getFieldAs<double>(Id::Z, ids[0]);
-
-        double z1;
-        // If the close ground point is at the same X/Y as the non-ground
-        // point, we're done.  Also, if there's only one ground point, we
-        // just use that.
-        if ((x0 == x && y0 == y) || ids.size() == 1)
-        {
-            z1 = z;
-        }
-        // If the non-ground point is outside the bounds of all the
-        // ground points and we're not doing extrapolation, just return
-        // its current Z, which will give a HAG of 0.
-        else if (!gBounds.contains(x0, y0) && !m_allowExtrapolation)
+    // Each point triangulates its own neighborhood and only reads the
+    // ground view, so slices of the non-ground view are processed on
+    // separate threads, each with its own query buffers.
+    point_count_t np = ngView->size();
+    size_t threads = threadCount(np);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&, t]()
         {
-            z1 = z0;
-        }
-        else
-        {
-            z1 = delaunay_interp_ground(x0, y0, gView, ids);
-        }
-        ngView->setField(Dimension::Id::HeightAboveGround, i, z0 - z1);
-    }
+            PointIdList ids(m_count);
+            std::vector<double> sqr_dists(m_count);
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            for (PointId i = start; i < end; ++i)
+            {
+                PointRef point = ngView->point(i);
+
+                // Non-ground view point for which we're trying to calc HAG
+                double x0 = point.getFieldAs<double>(Id::X);
+                double y0 = point.getFieldAs<double>(Id::Y);
+                double z0 = point.getFieldAs<double>(Id::Z);
+
+                kdi.knnSearch(x0, y0, m_count, &ids, &sqr_dists);
+
+                // Closest ground point.
+                double x = gView->getFieldAs<double>(Id::X, ids[0]);
+                double y = gView->getFieldAs<double>(Id::Y, ids[0]);
+                double z = gView->getFieldAs<double>(Id::Z, ids[0]);
+
+                double z1;
+                // If the close ground point is at the same X/Y as the
+                // non-ground point, we're done.  Also, if there's only one
+                // ground point, we just use that.
+                if ((x0 == x && y0 == y) || ids.size() == 1)
+                {
+                    z1 = z;
+                }
+                // If the non-ground point is outside the bounds of all the
+                // ground points and we're not doing extrapolation, just
+                // return its current Z, which will give a HAG of 0.
+                else if (!gBounds.contains(x0, y0) && !m_allowExtrapolation)
+                {
+                    z1 = z0;
+                }
+                else
+                {
+                    z1 = delaunay_interp_ground(x0, y0, gView, ids);
+                }
+                ngView->setField(Dimension::Id::HeightAboveGround, i, z0 - z1);
+            }
+        });
+    for (auto& t : pool)
+        t.join();
 }
 
 } // namespace pdal
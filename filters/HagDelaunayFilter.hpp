@@ -35,6 +35,7 @@
 #pragma once
 
 #include <pdal/Filter.hpp>
+#include <pdal/Streamable.hpp>
 
 #include <cstdint>
 #include <memory>
@@ -47,23 +48,38 @@ class Options;
 class PointLayout;
 class PointView;
 
-class PDAL_DLL HagDelaunayFilter : public Filter
+class PDAL_DLL HagDelaunayFilter : public Filter, public Streamable
 {
 public:
     HagDelaunayFilter();
+    ~HagDelaunayFilter();
     HagDelaunayFilter& operator=(const HagDelaunayFilter&) = delete;
     HagDelaunayFilter(const HagDelaunayFilter&) = delete;
 
     std::string getName() const;
 
 private:
+    // Ground model loaded from the 'ground' file: cell-by-cell local
+    // triangulations built on demand and cached LRU-style.
+    struct GroundSurface;
+
     virtual void addArgs(ProgramArgs& args);
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void prepared(PointTableRef table);
+    virtual void ready(PointTableRef table);
     virtual void filter(PointView& view);
+    virtual bool processOne(PointRef& point);
+    virtual void done(PointTableRef table);
+    size_t threadCount(point_count_t np) const;
 
     bool m_allowExtrapolation;
     point_count_t m_count;
+    size_t m_threads;
+    std::string m_groundFile;
+    double m_cell;
+    size_t m_cacheSize;
+    bool m_hasClassification;
+    std::unique_ptr<GroundSurface> m_surface;
 };
 
 } // namespace pdal
@@ -36,6 +36,9 @@
 
 #include <pdal/GDALUtils.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace pdal
 {
 
@@ -90,11 +93,69 @@ void HagDemFilter::prepared(PointTableRef table)
 
 void HagDemFilter::filter(PointView& view)
 {
-    PointRef point(view, 0);
+    using namespace pdal::Dimension;
+
+    // Locate each point in the raster up front, then fetch the band in row
+    // strips aligned to the native block size.  Each underlying GDAL block
+    // is decoded once instead of once per point in it.
+    struct Target
+    {
+        int32_t line;
+        int32_t pixel;
+        PointId id;
+    };
+    std::vector<Target> targets;
+    targets.reserve(view.size());
+
     for (PointId i = 0; i < view.size(); ++i)
     {
-        point.setPointId(i);
-        processOne(point);
+        // If "zero_ground" option is set, all ground points get HAG of 0
+        if (m_zeroGround &&
+            view.getFieldAs<uint8_t>(Id::Classification, i) ==
+                ClassLabel::Ground)
+        {
+            view.setField(Id::HeightAboveGround, i, 0);
+            continue;
+        }
+
+        double x = view.getFieldAs<double>(Id::X, i);
+        double y = view.getFieldAs<double>(Id::Y, i);
+
+        // If the raster has no pixel at the point's X, Y, the HAG value is
+        // not set.
+        int32_t pixel(0);
+        int32_t line(0);
+        if (m_raster->coordToPixel(x, y, pixel, line))
+            targets.push_back({line, pixel, i});
+    }
+
+    std::sort(targets.begin(), targets.end(),
+        [](const Target& a, const Target& b)
+        { return a.line < b.line; });
+
+    int xSize, ySize;
+    if (m_raster->blockSize(m_band, xSize, ySize) != gdal::GDALError::None ||
+            ySize <= 0)
+        ySize = 1;
+
+    std::vector<double> strip;
+    auto it = targets.begin();
+    while (it != targets.end())
+    {
+        // Each strip covers one row of raster blocks.
+        int firstRow = (it->line / ySize) * ySize;
+        int rowCount = (std::min)(ySize, m_raster->height() - firstRow);
+        if (m_raster->readBandRows(strip, m_band, firstRow, rowCount) !=
+                gdal::GDALError::None)
+            throwError(m_raster->errorMsg());
+
+        for (; it != targets.end() && it->line < firstRow + rowCount; ++it)
+        {
+            double z = view.getFieldAs<double>(Id::Z, it->id);
+            double ground = strip[(size_t)(it->line - firstRow) *
+                m_raster->width() + it->pixel];
+            view.setField(Id::HeightAboveGround, it->id, z - ground);
+        }
     }
 }
 
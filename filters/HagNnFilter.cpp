@@ -36,9 +36,12 @@
 
 #include <pdal/KDIndex.hpp>
 
+#include <algorithm>
 #include <string>
+#include <thread>
 #include <vector>
 #include <cmath>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -102,6 +105,14 @@ void HagNnFilter::addArgs(ProgramArgs& args)
         "[Default: None]", m_maxDistance);
     args.add("allow_extrapolation", "If true and count > 1, allow "
         "extrapolation [Default: true].", m_allowExtrapolation, true);
+    args.add("threads", "Number of threads used for the neighbor queries "
+        "(0 = choose automatically)", m_threads);
+}
+
+
+size_t HagNnFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
 }
 
 
@@ -155,47 +166,60 @@ void HagNnFilter::filter(PointView& view)
     double maxDistance2 = std::pow(m_maxDistance, 2.0);
     // Find Z difference between non-ground points and the nearest
     // neighbor (2D) in the ground view or between non-ground points and the
-    // locally-computed surface.
-    for (PointId i = 0; i < ngView->size(); ++i)
-    {
-        PointRef point = ngView->point(i);
-
-        // Non-ground view point for which we're trying to calc HAG
-        double x0 = point.getFieldAs<double>(Id::X);
-        double y0 = point.getFieldAs<double>(Id::Y);
-        double z0 = point.getFieldAs<double>(Id::Z);
-
-        PointIdList ids(m_count);
-        std::vector<double> sqr_dists(m_count);
-        kdi.knnSearch(x0, y0, m_count, &ids, &sqr_dists);
-
-        // Closest ground point.
-        double x = gView->getFieldAs<double>(Id::X, ids[0]);
-        double y = gView->getFieldAs<double>(Id::Y, ids[0]);
-        double z = gView->getFieldAs<double>(Id::Z, ids[0]);
-
-        double z1;
-        // If the close ground point is at the same X/Y as the non-ground
-        // point, we're done.  Also, if there's only one ground point, we
-        // just use that.
-        if ((x0 == x && y0 == y) || ids.size() == 1)
-        {
-            z1 = z;
-        }
-        // If the non-ground point is outside the bounds of all the
-        // ground points and we're not doing extrapolation, just return
-        // its current Z, which will give a HAG of 0.
-        else if (!gBounds.contains(x0, y0) && !m_allowExtrapolation)
-        {
-            z1 = z0;
-        }
-        else
+    // locally-computed surface.  Each point only reads the ground view and
+    // writes its own HAG, so slices of the non-ground view are processed on
+    // separate threads, each with its own query buffers.
+    point_count_t np = ngView->size();
+    size_t threads = threadCount(np);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&, t]()
         {
-            z1 = neighbor_interp_ground(gView, ids, sqr_dists,
-                maxDistance2, z0);
-        }
-        ngView->setField(Dimension::Id::HeightAboveGround, i, z0 - z1);
-    }
+            PointIdList ids(m_count);
+            std::vector<double> sqr_dists(m_count);
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            for (PointId i = start; i < end; ++i)
+            {
+                PointRef point = ngView->point(i);
+
+                // Non-ground view point for which we're trying to calc HAG
+                double x0 = point.getFieldAs<double>(Id::X);
+                double y0 = point.getFieldAs<double>(Id::Y);
+                double z0 = point.getFieldAs<double>(Id::Z);
+
+                kdi.knnSearch(x0, y0, m_count, &ids, &sqr_dists);
+
+                // Closest ground point.
+                double x = gView->getFieldAs<double>(Id::X, ids[0]);
+                double y = gView->getFieldAs<double>(Id::Y, ids[0]);
+                double z = gView->getFieldAs<double>(Id::Z, ids[0]);
+
+                double z1;
+                // If the close ground point is at the same X/Y as the
+                // non-ground point, we're done.  Also, if there's only one
+                // ground point, we just use that.
+                if ((x0 == x && y0 == y) || ids.size() == 1)
+                {
+                    z1 = z;
+                }
+                // If the non-ground point is outside the bounds of all the
+                // ground points and we're not doing extrapolation, just
+                // return its current Z, which will give a HAG of 0.
+                else if (!gBounds.contains(x0, y0) && !m_allowExtrapolation)
+                {
+                    z1 = z0;
+                }
+                else
+                {
+                    z1 = neighbor_interp_ground(gView, ids, sqr_dists,
+                        maxDistance2, z0);
+                }
+                ngView->setField(Dimension::Id::HeightAboveGround, i, z0 - z1);
+            }
+        });
+    for (auto& t : pool)
+        t.join();
 }
 
 } // namespace pdal
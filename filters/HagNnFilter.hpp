@@ -61,10 +61,12 @@ private:
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void prepared(PointTableRef table);
     virtual void filter(PointView& view);
+    size_t threadCount(point_count_t np) const;
 
     bool m_allowExtrapolation;
     double m_maxDistance;
     point_count_t m_count;
+    size_t m_threads;
 };
 
 } // namespace pdal
@@ -38,6 +38,12 @@
 #include "private/hexer/HexIter.hpp"
 #include <pdal/Polygon.hpp>
 
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <pdal/util/ThreadPool.hpp>
+
 using namespace hexer;
 
 namespace pdal
@@ -85,6 +91,14 @@ void HexBin::addArgs(ProgramArgs& args)
     args.add("smooth", "Smooth boundary output", m_doSmooth, true);
     args.add("preserve_topology", "Preserve topology when smoothing",
         m_preserve_topology, true);
+    args.add("threads", "Number of threads used to bin points into the "
+        "grid (0 = choose automatically)", m_threads);
+}
+
+
+size_t HexBin::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
 }
 
 
@@ -103,12 +117,65 @@ void HexBin::ready(PointTableRef table)
 
 void HexBin::filter(PointView& view)
 {
+    point_count_t np = view.size();
+    size_t threads = threadCount(np);
+
+    // Feed points one at a time until the sample phase has sized the grid
+    // and anchored its origin; with a single thread just stream them all.
     PointRef p(view, 0);
-    for (PointId idx = 0; idx < view.size(); ++idx)
+    PointId idx = 0;
+    for (; idx < np; ++idx)
     {
+        if (threads > 1 && idx > 0 && m_grid->width() > 0)
+            break;
         p.setPointId(idx);
         processOne(p);
     }
+    if (idx == np)
+        return;
+
+    // Bin the remaining points into per-thread count maps - hexCoord()
+    // doesn't touch the grid - then fold the counts into the grid in one
+    // pass per populated hexagon.  The density bookkeeping only depends
+    // on final counts, so the result matches the point-at-a-time path.
+    point_count_t remaining = np - idx;
+    threads = (std::min)(threads, (size_t)remaining);
+    using CountMap = std::unordered_map<uint64_t, int>;
+    std::vector<CountMap> counts(threads);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&, t, idx, remaining]()
+        {
+            PointId start = idx + remaining * t / threads;
+            PointId end = idx + remaining * (t + 1) / threads;
+            CountMap& local = counts[t];
+            const point_count_t BatchSize = 4096;
+            std::vector<double> xs(BatchSize);
+            std::vector<double> ys(BatchSize);
+            for (PointId s = start; s < end; s += BatchSize)
+            {
+                point_count_t n = (std::min)(BatchSize,
+                    (point_count_t)(end - s));
+                view.getFieldBatch(Dimension::Id::X, s, n, xs.data());
+                view.getFieldBatch(Dimension::Id::Y, s, n, ys.data());
+                for (point_count_t i = 0; i < n; ++i)
+                {
+                    hexer::Coord c =
+                        m_grid->hexCoord(hexer::Point(xs[i], ys[i]));
+                    local[hexer::Hexagon::key(c.m_x, c.m_y)]++;
+                }
+            }
+        });
+    }
+    for (auto& t : pool)
+        t.join();
+
+    for (CountMap& local : counts)
+        for (auto& kv : local)
+            m_grid->addPointCount((int32_t)(uint32_t)kv.first,
+                (int32_t)(uint32_t)(kv.first >> 32), kv.second);
+    m_count += remaining;
 }
 
 
@@ -128,7 +195,7 @@ void HexBin::done(PointTableRef table)
 
     try
     {
-        m_grid->findShapes();
+        m_grid->findShapes(threadCount(m_count));
         m_grid->findParentPaths();
     }
     catch (hexer::hexer_error& e)
@@ -72,8 +72,10 @@ private:
     bool m_doSmooth;
     point_count_t m_count;
     bool m_preserve_topology;
+    size_t m_threads;
 
     virtual void addArgs(ProgramArgs& args);
+    size_t threadCount(point_count_t np) const;
     virtual void ready(PointTableRef table);
     virtual void filter(PointView& view);
     virtual bool processOne(PointRef& point);
@@ -156,7 +156,7 @@ void InfoFilter::initialize(PointTableRef table)
 
 void InfoFilter::ready(PointTableRef)
 {
-    m_count = 0;
+    m_count = m_startIndex;
     m_idCur = m_idList.begin();
 }
 
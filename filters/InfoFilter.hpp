@@ -63,13 +63,26 @@ class PDAL_DLL InfoFilter : public Filter, public Streamable
 public:
     InfoFilter() :
         m_pointRoot("point"), m_queryCount(10),
-        m_queryZ(std::numeric_limits<double>::quiet_NaN())
+        m_queryZ(std::numeric_limits<double>::quiet_NaN()),
+        m_startIndex(0)
     {}
 
     std::string getName() const;
     BOX3D bounds() const
         { return m_bounds; }
 
+    /**
+      Tell the filter the index in the full input of the first point it
+      will see.  Keeps reported PointIds absolute when an upstream
+      reader skips ahead to the requested points instead of producing
+      the file from the beginning (see Reader::resumeAt()).  Must be
+      called before the filter is made ready.
+
+      \param start  Index of the first point the filter will process.
+    */
+    void startAt(PointId start)
+        { m_startIndex = start; }
+
 private:
     virtual void addArgs(ProgramArgs& args);
     virtual void initialize(PointTableRef table);
@@ -97,6 +110,7 @@ private:
     DimTypeList m_dims;
     size_t m_pointSize;
     PointId m_count;
+    PointId m_startIndex;
 
     BOX3D m_bounds;
 };
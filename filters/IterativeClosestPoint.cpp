@@ -36,11 +36,18 @@
 
 #include <pdal/EigenUtils.hpp>
 #include <pdal/KDIndex.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/util/Utils.hpp>
 
 #include <Eigen/Dense>
 
+#include <algorithm>
+#include <cmath>
 #include <numeric>
+#include <thread>
+#include <vector>
+
+#include "private/VoxelGrid.hpp"
 
 namespace pdal
 {
@@ -70,8 +77,45 @@ void IterativeClosestPoint::addArgs(ProgramArgs& args)
     args.add("max_similar",
              "Max number of similar transforms to consider converged",
              m_max_similar, 0);
+    args.add("coarse_cell",
+             "Cell size for voxel-decimated coarse alignment stages run "
+             "before the full-density refinement (0 = full density only)",
+             m_coarse_cell);
+    args.add("threads", "Number of threads used for the correspondence "
+             "searches (0 = choose automatically)", m_threads);
+}
+
+
+size_t IterativeClosestPoint::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
+}
+
+
+namespace
+{
+
+// Ids of one representative point (the first seen) per voxel at the
+// given cell size.
+PointIdList decimateIds(const PointView& view, double cell)
+{
+    VoxelSet voxels;
+    voxels.reserve(view.size());
+    PointIdList ids;
+    for (PointId i = 0; i < view.size(); ++i)
+    {
+        double x = view.getFieldAs<double>(Dimension::Id::X, i);
+        double y = view.getFieldAs<double>(Dimension::Id::Y, i);
+        double z = view.getFieldAs<double>(Dimension::Id::Z, i);
+        if (voxels.insert((int)std::floor(x / cell),
+            (int)std::floor(y / cell), (int)std::floor(z / cell)))
+            ids.push_back(i);
+    }
+    return ids;
 }
 
+} // unnamed namespace
+
 PointViewSet IterativeClosestPoint::run(PointViewPtr view)
 {
     using namespace Dimension;
@@ -123,111 +167,155 @@ PointViewPtr IterativeClosestPoint::icp(PointViewPtr fixed,
     // nearest neighbor searches in each iteration.
     KD3Index& kd_fixed = tempFixed->build3dIndex();
 
-    // Iterate to the max number of iterations or until converged.
-    bool converged(false);
-    double prev_mse(0.0);
-    int num_similar(0);
-    for (int iter = 0; iter < m_max_iters; ++iter)
+    // Build the schedule of moving-point subsets to align: optional
+    // voxel-decimated coarse stages, coarsest first, followed by the
+    // full-density refinement.  Each stage starts from the transformation
+    // the previous one converged to, so the expensive full-resolution
+    // iterations only run for the final touch-up.
+    point_count_t np = tempMoving->size();
+    std::vector<PointIdList> stages;
+    int levels = 0;
+    for (double cell = m_coarse_cell; cell > 0.0 && levels < 4;
+        cell /= 4, ++levels)
     {
-        // At the beginning of each iteration, transform our centered, moving
-        // PointView by the current final_transformation.
-        PointViewPtr tempMovingTransformed =
-            transform(*tempMoving, final_transformation.data());
-
-        // Create empty lists to hold point correspondences, and initialize MSE
-        // to zero.
-        PointIdList fixed_idx, moving_idx;
-        fixed_idx.reserve(tempMovingTransformed->size());
-        moving_idx.reserve(tempMovingTransformed->size());
-        double mse(0.0);
-
-        // For every point in the centered, moving PointView, find the nearest
-        // neighbor in the centered fixed PointView. Record the indices of each
-        // and update the MSE.
-        for (PointId i = 0; i < tempMovingTransformed->size(); ++i)
-        {
-            // Find the index of the nearest neighbor, and the square distance
-            // between each point.
-            PointRef p = tempMovingTransformed->point(i);
-            PointIdList indices(1);
-            std::vector<double> sqr_dists(1);
-            kd_fixed.knnSearch(p, 1, &indices, &sqr_dists);
-
-            // In the PCL code, there would've been a check that the square
-            // distance did not exceed a threshold value.
-
-            // Store the indices of the correspondence and update the MSE.
-            moving_idx.push_back(i);
-            fixed_idx.push_back(indices[0]);
-            mse += std::sqrt(sqr_dists[0]);
-        }
+        PointIdList ids = decimateIds(*tempMoving, cell);
+        // Once decimation retains most of the view there's nothing left
+        // to save; stop and go straight to full density.
+        if (ids.size() * 2 > np)
+            break;
+        if (ids.size() >= 100)
+            stages.push_back(std::move(ids));
+    }
+    PointIdList all(np);
+    std::iota(all.begin(), all.end(), 0);
+    stages.push_back(std::move(all));
 
-        // Finalize and log the MSE.
-        mse /= moving_idx.size();
-        log()->get(LogLevel::Debug2) << "MSE: " << mse << std::endl;
-
-        // Estimate rigid transformation using Umeyama method, logging the
-        // current translation in X and Y.
-        auto A = pointViewToEigen(*tempFixed, fixed_idx);
-        auto B = pointViewToEigen(*tempMovingTransformed, moving_idx);
-        auto T = Eigen::umeyama(B.transpose(), A.transpose(), false);
-        log()->get(LogLevel::Debug2) << "Current dx: " << T.coeff(0, 3) << ", "
-                                     << "dy: " << T.coeff(1, 3) << std::endl;
-
-        // Update the final_transformation and log the X and Y translations.
-        final_transformation = final_transformation * T;
-        log()->get(LogLevel::Debug2)
-            << "Cumulative dx: " << final_transformation.coeff(0, 3) << ", "
-            << "dy: " << final_transformation.coeff(1, 3) << std::endl;
-
-        bool is_similar = false;
-
-        // Compute and log the rotation and translation of the current
-        // transformation (not cumulative).
-        double cos_angle =
-            0.5 * (T.coeff(0, 0) + T.coeff(1, 1) + T.coeff(2, 2) - 1);
-        double translation_sqr = T.coeff(0, 3) * T.coeff(0, 3) +
-                                 T.coeff(1, 3) * T.coeff(1, 3) +
-                                 T.coeff(2, 3) * T.coeff(2, 3);
-        log()->get(LogLevel::Debug2) << "Rotation: " << cos_angle << std::endl;
-        log()->get(LogLevel::Debug2)
-            << "Translation: " << translation_sqr << std::endl;
-
-        // Check for change in MSE.
-        if (std::fabs(mse - prev_mse) < m_mse_abs)
+    size_t threads = threadCount(np);
+
+    // Iterate each stage to the max number of iterations or until converged.
+    bool converged(false);
+    for (size_t stage = 0; stage < stages.size(); ++stage)
+    {
+        const PointIdList& moving_idx = stages[stage];
+        if (stages.size() > 1)
+            log()->get(LogLevel::Debug2) << "ICP stage " << stage + 1 << " of "
+                << stages.size() << " using " << moving_idx.size()
+                << " moving points\n";
+
+        converged = false;
+        double prev_mse(0.0);
+        int num_similar(0);
+        for (int iter = 0; iter < m_max_iters; ++iter)
         {
-            if (num_similar >= m_max_similar)
+            // At the beginning of each iteration, transform our centered, moving
+            // PointView by the current final_transformation.
+            PointViewPtr tempMovingTransformed =
+                transform(*tempMoving, final_transformation.data());
+
+            // For every point of this stage's subset of the centered, moving
+            // PointView, find the nearest neighbor in the centered fixed
+            // PointView. Record the index of each and update the MSE.  The
+            // searches are read-only against the KD-tree, so the subset is
+            // split into slices queried concurrently.
+            point_count_t nc = moving_idx.size();
+            PointIdList fixed_idx(nc);
+            std::vector<double> sums(threads, 0.0);
+            std::vector<std::thread> pool;
+            for (size_t t = 0; t < threads; ++t)
             {
-                converged = true;
-                log()->get(LogLevel::Debug2) << "converged via absolute MSE\n";
-                break;
+                pool.emplace_back([&, t]()
+                {
+                    PointId start = nc * t / threads;
+                    PointId end = nc * (t + 1) / threads;
+                    PointIdList indices(1);
+                    std::vector<double> sqr_dists(1);
+                    double sum(0.0);
+                    for (PointId i = start; i < end; ++i)
+                    {
+                        // Find the index of the nearest neighbor, and the
+                        // square distance between each point.
+                        PointRef p = tempMovingTransformed->point(moving_idx[i]);
+                        kd_fixed.knnSearch(p, 1, &indices, &sqr_dists);
+
+                        // In the PCL code, there would've been a check that the
+                        // square distance did not exceed a threshold value.
+                        fixed_idx[i] = indices[0];
+                        sum += std::sqrt(sqr_dists[0]);
+                    }
+                    sums[t] = sum;
+                });
+            }
+            for (auto& t : pool)
+                t.join();
+
+            // Finalize and log the MSE.
+            double mse = std::accumulate(sums.begin(), sums.end(), 0.0) / nc;
+            log()->get(LogLevel::Debug2) << "MSE: " << mse << std::endl;
+
+            // Estimate rigid transformation using Umeyama method, logging the
+            // current translation in X and Y.
+            auto A = pointViewToEigen(*tempFixed, fixed_idx);
+            auto B = pointViewToEigen(*tempMovingTransformed, moving_idx);
+            auto T = Eigen::umeyama(B.transpose(), A.transpose(), false);
+            log()->get(LogLevel::Debug2) << "Current dx: " << T.coeff(0, 3) << ", "
+                                         << "dy: " << T.coeff(1, 3) << std::endl;
+
+            // Update the final_transformation and log the X and Y translations.
+            final_transformation = final_transformation * T;
+            log()->get(LogLevel::Debug2)
+                << "Cumulative dx: " << final_transformation.coeff(0, 3) << ", "
+                << "dy: " << final_transformation.coeff(1, 3) << std::endl;
+
+            bool is_similar = false;
+
+            // Compute and log the rotation and translation of the current
+            // transformation (not cumulative).
+            double cos_angle =
+                0.5 * (T.coeff(0, 0) + T.coeff(1, 1) + T.coeff(2, 2) - 1);
+            double translation_sqr = T.coeff(0, 3) * T.coeff(0, 3) +
+                                     T.coeff(1, 3) * T.coeff(1, 3) +
+                                     T.coeff(2, 3) * T.coeff(2, 3);
+            log()->get(LogLevel::Debug2) << "Rotation: " << cos_angle << std::endl;
+            log()->get(LogLevel::Debug2)
+                << "Translation: " << translation_sqr << std::endl;
+
+            // Check for change in MSE.
+            if (std::fabs(mse - prev_mse) < m_mse_abs)
+            {
+                if (num_similar >= m_max_similar)
+                {
+                    converged = true;
+                    log()->get(LogLevel::Debug2) << "converged via absolute MSE\n";
+                    break;
+                }
+                is_similar = true;
             }
-            is_similar = true;
-        }
 
-        // If the rotation and translation satisfy the specified thresholds,
-        // mark as converged, and exit the for loop.
-        if ((cos_angle >= m_rotation_threshold) &&
-            (translation_sqr <= m_translation_threshold))
-        {
-            if (num_similar >= m_max_similar)
+            // If the rotation and translation satisfy the specified thresholds,
+            // mark as converged, and exit the for loop.
+            if ((cos_angle >= m_rotation_threshold) &&
+                (translation_sqr <= m_translation_threshold))
             {
-                converged = true;
-                log()->get(LogLevel::Debug2)
-                    << "converged via rotation/translation thresholds\n";
-                break;
+                if (num_similar >= m_max_similar)
+                {
+                    converged = true;
+                    log()->get(LogLevel::Debug2)
+                        << "converged via rotation/translation thresholds\n";
+                    break;
+                }
+                is_similar = true;
             }
-            is_similar = true;
-        }
 
-        if (is_similar)
-            ++num_similar;
-        else
-            num_similar = 0;
+            if (is_similar)
+                ++num_similar;
+            else
+                num_similar = 0;
 
-        prev_mse = mse;
+            prev_mse = mse;
+        }
     }
 
+
     // Apply the final_transformation to the moving PointView.
     for (PointId i = 0; i < moving->size(); ++i)
     {
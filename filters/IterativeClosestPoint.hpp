@@ -53,11 +53,14 @@ private:
     double m_rotation_threshold;
     double m_translation_threshold;
     double m_mse_abs;
+    double m_coarse_cell;
+    size_t m_threads;
 
     virtual void addArgs(ProgramArgs& args);
     virtual PointViewSet run(PointViewPtr view);
     virtual void done(PointTableRef _);
     PointViewPtr icp(PointViewPtr fixed, PointViewPtr moving) const;
+    size_t threadCount(point_count_t np) const;
 
     PointViewPtr m_fixed;
     bool m_complete;
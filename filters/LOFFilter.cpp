@@ -36,8 +36,14 @@
 
 #include <pdal/KDIndex.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -59,6 +65,14 @@ std::string LOFFilter::getName() const
 void LOFFilter::addArgs(ProgramArgs& args)
 {
     args.add("minpts", "Minimum number of points", m_minpts, 10);
+    args.add("threads", "Number of threads used for the neighbor queries "
+        "and the LOF passes (0 = choose automatically)", m_threads);
+}
+
+
+size_t LOFFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
 }
 
 void LOFFilter::addDimensions(PointLayoutPtr layout)
@@ -73,22 +87,53 @@ void LOFFilter::filter(PointView& view)
 {
     using namespace Dimension;
 
+    point_count_t np = view.size();
+    if (np == 0)
+        return;
+
     KD3Index& index = view.build3dIndex();
 
     // Increment the minimum number of points, as knnSearch will be returning
     // the neighbors along with the query point.
-    m_minpts++;
+    point_count_t k = (std::min)((point_count_t)m_minpts + 1, np);
 
-    // First pass: Compute the k-distance for each point.
-    // The k-distance is the Euclidean distance to k-th nearest neighbor.
-    log()->get(LogLevel::Debug) << "Computing k-distances...\n";
-    for (PointId i = 0; i < view.size(); ++i)
+    size_t threads = threadCount(np);
+    auto parallel = [np, threads](std::function<void(PointId, PointId)> run)
     {
-        PointIdList indices(m_minpts);
-        std::vector<double> sqr_dists(m_minpts);
-        index.knnSearch(i, m_minpts, &indices, &sqr_dists);
-        view.setField(m_kdist, i, std::sqrt(sqr_dists[m_minpts-1]));
-    }
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            pool.emplace_back(run, start, end);
+        }
+        for (auto& t : pool)
+            t.join();
+    };
+
+    // Query each point's k nearest neighbors once through the batch
+    // interface - the queries run in Morton order for tree locality and
+    // across threads - and keep ids and distances in flat arrays with a
+    // fixed stride of k.  The later passes are then array sweeps instead
+    // of repeated KD queries.
+    log()->get(LogLevel::Debug) << "Computing neighbors and k-distances...\n";
+    PointIdList queries(np);
+    std::iota(queries.begin(), queries.end(), 0);
+    PointIdList nbrs;
+    std::vector<double> dists;
+    index.neighborsBatch(queries, k, nbrs, &dists, threads);
+    std::vector<double> kdist(np);
+    parallel([&](PointId start, PointId end)
+    {
+        for (PointId i = start; i < end; ++i)
+        {
+            for (point_count_t j = 0; j < k; ++j)
+                dists[i * k + j] = std::sqrt(dists[i * k + j]);
+            // The k-distance is the Euclidean distance to the k-th
+            // nearest neighbor.
+            kdist[i] = dists[i * k + (k - 1)];
+        }
+    });
 
     // Second pass: Compute the local reachability distance for each point.
     // For each neighbor point, the reachability distance is the maximum value
@@ -96,38 +141,48 @@ void LOFFilter::filter(PointView& view)
     // the current point. The lrd is the inverse of the mean of the reachability
     // distances.
     log()->get(LogLevel::Debug) << "Computing lrd...\n";
-    for (PointId i = 0; i < view.size(); ++i)
+    std::vector<double> lrd(np);
+    parallel([&](PointId start, PointId end)
     {
-        PointIdList indices(m_minpts);
-        std::vector<double> sqr_dists(m_minpts);
-        index.knnSearch(i, m_minpts, &indices, &sqr_dists);
-        double M1 = 0.0;
-        point_count_t n = 0;
-        for (PointId j = 0; j < indices.size(); ++j)
+        for (PointId i = start; i < end; ++i)
         {
-            double k = view.getFieldAs<double>(m_kdist, indices[j]);
-            double reachdist = (std::max)(k, std::sqrt(sqr_dists[j]));
-            M1 += (reachdist - M1) / ++n;
+            double M1 = 0.0;
+            point_count_t n = 0;
+            for (point_count_t j = 0; j < k; ++j)
+            {
+                double reachdist =
+                    (std::max)(kdist[nbrs[i * k + j]], dists[i * k + j]);
+                M1 += (reachdist - M1) / ++n;
+            }
+            lrd[i] = 1.0 / M1;
         }
-        view.setField(m_lrd, i, 1.0 / M1);
-    }
+    });
 
     // Third pass: Compute the local outlier factor for each point.
     // The LOF is the average of the lrd's for a neighborhood of points.
     log()->get(LogLevel::Debug) << "Computing LOF...\n";
-    for (PointId i = 0; i < view.size(); ++i)
+    std::vector<double> lof(np);
+    parallel([&](PointId start, PointId end)
     {
-        double lrdp = view.getFieldAs<double>(m_lrd, i);
-        PointIdList indices(m_minpts);
-        std::vector<double> sqr_dists(m_minpts);
-        index.knnSearch(i, m_minpts, &indices, &sqr_dists);
-        double M1 = 0.0;
-        point_count_t n = 0;
-        for (auto const& j : indices)
+        for (PointId i = start; i < end; ++i)
         {
-            M1 += (view.getFieldAs<double>(m_lrd, j) / lrdp - M1) / ++n;
+            double lrdp = lrd[i];
+            double M1 = 0.0;
+            point_count_t n = 0;
+            for (point_count_t j = 0; j < k; ++j)
+                M1 += (lrd[nbrs[i * k + j]] / lrdp - M1) / ++n;
+            lof[i] = M1;
         }
-        view.setField(m_lof, i, M1);
+    });
+
+    // Store the results.
+    const point_count_t BatchSize = 4096;
+    for (PointId start = 0; start < np; start += BatchSize)
+    {
+        point_count_t n = (std::min)(BatchSize, np - start);
+        view.setFieldBatch(m_kdist, start, n, kdist.data() + start);
+        view.setFieldBatch(m_lrd, start, n, lrd.data() + start);
+        view.setFieldBatch(m_lof, start, n, lof.data() + start);
     }
 }
 
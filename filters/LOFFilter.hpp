@@ -56,10 +56,12 @@ public:
 private:
     Dimension::Id m_kdist, m_lrd, m_lof;
     int m_minpts;
+    size_t m_threads;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void filter(PointView& view);
+    size_t threadCount(point_count_t np) const;
 
     LOFFilter& operator=(const LOFFilter&); // not implemented
     LOFFilter(const LOFFilter&); // not implemented
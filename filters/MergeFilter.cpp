@@ -34,6 +34,8 @@
 
 #include "MergeFilter.hpp"
 
+#include <pdal/util/ProgramArgs.hpp>
+
 namespace pdal
 {
 
@@ -48,6 +50,36 @@ CREATE_STATIC_STAGE(MergeFilter, s_info)
 
 std::string MergeFilter::getName() const { return s_info.name; }
 
+void MergeFilter::addArgs(ProgramArgs& args)
+{
+    args.add("key_dim", "Dimension by which each input is already "
+        "ordered.  When set, inputs are interleaved in key order rather "
+        "than concatenated.", m_keyDimName);
+}
+
+
+void MergeFilter::prepared(PointTableRef table)
+{
+    m_keyDim = Dimension::Id::Unknown;
+    if (m_keyDimName.size())
+    {
+        m_keyDim = table.layout()->findDim(m_keyDimName);
+        if (m_keyDim == Dimension::Id::Unknown)
+            throwError("Dimension '" + m_keyDimName + "' not found.");
+    }
+}
+
+
+bool MergeFilter::pipelineStreamable() const
+{
+    // In stream mode the inputs arrive one after another, so there is
+    // nothing to interleave - a keyed merge forces standard mode.
+    if (m_keyDimName.size())
+        return false;
+    return Streamable::pipelineStreamable();
+}
+
+
 void MergeFilter::ready(PointTableRef table)
 {
     SpatialReference srs = getSpatialReference();
@@ -55,6 +87,7 @@ void MergeFilter::ready(PointTableRef table)
     if (srs.empty())
         srs = table.anySpatialReference();
     m_view.reset(new PointView(table, srs));
+    m_runs.clear();
 }
 
 
@@ -68,10 +101,103 @@ PointViewSet MergeFilter::run(PointViewPtr in)
       (in->spatialReference() != m_view->spatialReference()))
         log()->get(LogLevel::Warning) << getName() << ": merging points "
             "with inconsistent spatial references." << std::endl;
+    m_runs.push_back(m_view->size());
     m_view->append(*in.get());
     viewSet.insert(m_view);
     return viewSet;
 }
 
+
+void MergeFilter::done(PointTableRef)
+{
+    if (m_keyDim == Dimension::Id::Unknown || m_runs.size() < 2)
+        return;
+
+    point_count_t n = m_view->size();
+    if (!n)
+        return;
+
+    // Extract each key once rather than at every comparison.
+    std::vector<double> keys(n);
+    for (PointId i = 0; i < n; ++i)
+        keys[i] = m_view->getFieldAs<double>(m_keyDim, i);
+
+    // Each appended input is a run already ordered by the key.
+    size_t k = m_runs.size();
+    std::vector<PointId> pos(m_runs);
+    std::vector<PointId> end(k);
+    for (size_t r = 0; r + 1 < k; ++r)
+        end[r] = m_runs[r + 1];
+    end[k - 1] = n;
+
+    // Interleave the runs with a loser tree: nodes 1 through k - 1 hold
+    // the losers of each sub-tournament, node 0 the overall winner, and
+    // run r plays as leaf k + r.  Popping the winner replays only its
+    // own path, so the merge costs n log k comparisons instead of the
+    // n log n of a concatenate-then-sort.
+    const size_t None = k;      // Exhausted run; loses to everything.
+    auto less = [&](size_t a, size_t b)
+    {
+        if (b == None)
+            return true;
+        if (a == None)
+            return false;
+        if (keys[pos[a]] != keys[pos[b]])
+            return keys[pos[a]] < keys[pos[b]];
+        // Ties interleave in input order.
+        return a < b;
+    };
+
+    std::vector<size_t> tree(k);
+    {
+        std::vector<size_t> win(2 * k);
+        for (size_t r = 0; r < k; ++r)
+            win[k + r] = (pos[r] == end[r]) ? None : r;
+        for (size_t t = k - 1; t >= 1; --t)
+        {
+            size_t a = win[2 * t];
+            size_t b = win[2 * t + 1];
+            win[t] = less(a, b) ? a : b;
+            tree[t] = less(a, b) ? b : a;
+        }
+        tree[0] = win[1];
+    }
+
+    std::vector<PointId> order(n);
+    for (PointId i = 0; i < n; ++i)
+    {
+        size_t r = tree[0];
+        order[i] = pos[r]++;
+
+        size_t cur = (pos[r] == end[r]) ? None : r;
+        for (size_t t = (k + r) / 2; t > 0; t /= 2)
+            if (less(tree[t], cur))
+                std::swap(tree[t], cur);
+        tree[0] = cur;
+    }
+
+    // order[i] is the position whose point belongs at position i.  Apply
+    // the permutation cycle by cycle with a single temporary.
+    std::vector<bool> placed(n, false);
+    for (PointId i = 0; i < n; ++i)
+    {
+        if (placed[i] || order[i] == i)
+            continue;
+        PointRef pi = m_view->point(i);
+        PointRef tmp(pi);   // Forces a temp copy of the point.
+        PointId dst = i;
+        PointId src = order[dst];
+        while (src != i)
+        {
+            m_view->point(dst) = m_view->point(src);
+            placed[dst] = true;
+            dst = src;
+            src = order[dst];
+        }
+        m_view->point(dst) = tmp;
+        placed[dst] = true;
+    }
+}
+
 } // namespace pdal
 
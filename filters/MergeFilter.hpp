@@ -34,6 +34,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include <pdal/Filter.hpp>
 #include <pdal/Streamable.hpp>
 
@@ -49,12 +52,20 @@ public:
     std::string getName() const;
 
 private:
+    std::string m_keyDimName;
+    Dimension::Id m_keyDim;
     PointViewPtr m_view;
+    // Start offset in m_view of each appended input, in arrival order.
+    std::vector<PointId> m_runs;
 
+    virtual void addArgs(ProgramArgs& args);
+    virtual void prepared(PointTableRef table);
+    virtual bool pipelineStreamable() const;
     virtual void ready(PointTableRef table);
     virtual bool processOne(PointRef& point)
         { return true; }
     virtual PointViewSet run(PointViewPtr in);
+    virtual void done(PointTableRef table);
 
     MergeFilter& operator=(const MergeFilter&); // not implemented
     MergeFilter(const MergeFilter&); // not implemented
@@ -41,10 +41,12 @@
 
 #include <pdal/KDIndex.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "private/miniball/Seb.h"
 
 #include <cmath>
+#include <numeric>
 #include <string>
 #include <thread>
 #include <vector>
@@ -71,8 +73,14 @@ std::string MiniballFilter::getName() const
 void MiniballFilter::addArgs(ProgramArgs& args)
 {
     args.add("knn", "k-Nearest neighbors", m_knn, 8);
-    args.add("threads", "Number of threads used to run this filter", m_threads,
-             1);
+    args.add("threads", "Number of threads used for the neighbor queries "
+        "and the miniball computations (0 = choose automatically)", m_threads);
+}
+
+
+size_t MiniballFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
 }
 
 void MiniballFilter::addDimensions(PointLayoutPtr layout)
@@ -83,49 +91,63 @@ void MiniballFilter::addDimensions(PointLayoutPtr layout)
 
 void MiniballFilter::filter(PointView& view)
 {
+    point_count_t np = view.size();
+    if (!np)
+        return;
+
     KD3Index& kdi = view.build3dIndex();
 
-    point_count_t nloops = view.size();
-    std::vector<std::thread> threadList(m_threads);
-    for (int t = 0; t < m_threads; t++)
+    size_t threads = threadCount(np);
+
+    // One batched pass answers every point's neighbor query in Morton
+    // order; the miniball computations then run over slices of the flat
+    // result on the shared pool.
+    PointIdList queries(np);
+    std::iota(queries.begin(), queries.end(), 0);
+    PointIdList nbrs;
+    point_count_t k = kdi.neighborsBatch(queries, (point_count_t)m_knn + 1,
+        nbrs, nullptr, threads);
+
+    ThreadPool pool(threads, threads);
+    for (size_t t = 0; t < threads; ++t)
     {
-        threadList[t] = std::thread(std::bind(
-            [&](const PointId start, const PointId end) {
-                for (PointId i = start; i < end; i++)
-                    setMiniball(view, i, kdi);
-            },
-            t * nloops / m_threads,
-            (t + 1) == m_threads ? nloops : (t + 1) * nloops / m_threads));
+        PointId start = np * t / threads;
+        PointId end = np * (t + 1) / threads;
+        pool.add([this, &view, &nbrs, k, start, end]()
+        {
+            // Scratch reused across the slice's points rather than
+            // allocated per point.
+            std::vector<Seb::Point<double>> S;
+            for (PointId i = start; i < end; ++i)
+                setMiniball(view, i, &nbrs[i * k], k, S);
+        });
     }
-    for (auto& t : threadList)
-        t.join();
+    pool.join();
+    if (pool.errors().size())
+        throwError(pool.errors().front());
 }
 
-void MiniballFilter::setMiniball(PointView& view, const PointId& i,
-                                 const KD3Index& kdi)
+void MiniballFilter::setMiniball(PointView& view, PointId i,
+    const PointId *ni, point_count_t k, std::vector<Seb::Point<double>>& S)
 {
     typedef double FT;
     typedef Seb::Point<FT> Point;
-    typedef std::vector<Point> PointVector;
     typedef Seb::Smallest_enclosing_ball<FT> Miniball;
 
     double X = view.getFieldAs<double>(Dimension::Id::X, i);
     double Y = view.getFieldAs<double>(Dimension::Id::Y, i);
     double Z = view.getFieldAs<double>(Dimension::Id::Z, i);
 
-    // Find k-nearest neighbors of i.
-    auto ni = kdi.neighbors(i, m_knn + 1);
-
-    PointVector S;
-    std::vector<double> coords(3);
-    for (auto const& j : ni)
+    S.clear();
+    double coords[3];
+    for (point_count_t j = 0; j < k; ++j)
     {
-        if (j == i)
+        if (ni[j] == i)
             continue;
-        coords[0] = view.getFieldAs<double>(Dimension::Id::X, j);
-        coords[1] = view.getFieldAs<double>(Dimension::Id::Y, j);
-        coords[2] = view.getFieldAs<double>(Dimension::Id::Z, j);
-        S.push_back(Point(3, coords.begin()));
+        coords[0] = view.getFieldAs<double>(Dimension::Id::X, ni[j]);
+        coords[1] = view.getFieldAs<double>(Dimension::Id::Y, ni[j]);
+        coords[2] = view.getFieldAs<double>(Dimension::Id::Z, ni[j]);
+        S.push_back(Point(3, coords));
     }
 
     // add neighbors to Miniball mb(3, S)
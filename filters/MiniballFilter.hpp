@@ -38,6 +38,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
+namespace Seb
+{
+template <typename Float> class Point;
+}
 
 namespace pdal
 {
@@ -54,14 +60,16 @@ public:
 
 private:
     int m_knn;
-    int m_threads;
+    size_t m_threads;
     Dimension::Id m_miniball;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void filter(PointView& view);
 
-    void setMiniball(PointView& view, const PointId& i, const KD3Index& kdi);
+    size_t threadCount(point_count_t np) const;
+    void setMiniball(PointView& view, PointId i, const PointId *ni,
+        point_count_t k, std::vector<Seb::Point<double>>& S);
 };
 
 } // namespace pdal
@@ -37,6 +37,7 @@
 #include "MongoExpressionFilter.hpp"
 
 #include "private/mongoexpression/Expression.hpp"
+#include "private/mongoexpression/Program.hpp"
 
 namespace pdal
 {
@@ -75,6 +76,11 @@ void MongoExpressionFilter::prepared(PointTableRef table)
 
     log()->get(LogLevel::Debug) << "Built expression: " << *m_expression <<
         std::endl;
+
+    // Flatten the expression for block evaluation in run().  The tree
+    // remains the streaming path's per-point evaluator.
+    m_program = makeUnique<Program>();
+    m_expression->flatten(*m_program);
 }
 
 PointViewSet MongoExpressionFilter::run(PointViewPtr inView)
@@ -82,13 +88,18 @@ PointViewSet MongoExpressionFilter::run(PointViewPtr inView)
     PointViewSet views;
     PointViewPtr view(inView->makeNew());
 
-    for (PointId i(0); i < inView->size(); ++i)
+    std::vector<uint8_t> mask(Program::BatchSize);
+    for (PointId start = 0; start < inView->size();
+        start += Program::BatchSize)
     {
-        PointRef pr(inView->point(i));
-        if (processOne(pr))
-        {
-            view->appendPoint(*inView, i);
-        }
+        point_count_t n = inView->size() - start;
+        if (n > Program::BatchSize)
+            n = Program::BatchSize;
+
+        m_program->run(*inView, start, n, mask.data());
+        for (point_count_t i = 0; i < n; ++i)
+            if (mask[i])
+                view->appendPoint(*inView, start + i);
     }
 
     views.insert(view);
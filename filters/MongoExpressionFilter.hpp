@@ -42,6 +42,7 @@ namespace pdal
 {
 
 class Expression;
+class Program;
 
 class PDAL_DLL MongoExpressionFilter : public Filter, public Streamable
 {
@@ -59,6 +60,7 @@ private:
 
     NL::json m_json;
     std::unique_ptr<Expression> m_expression;
+    std::unique_ptr<Program> m_program;
 };
 
 } // namespace pdal
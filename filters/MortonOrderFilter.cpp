@@ -35,11 +35,13 @@
 #include "MortonOrderFilter.hpp"
 
 #include <pdal/EigenUtils.hpp>
+#include <pdal/util/SpaceFillingCurve.hpp>
 
 #include <climits>
+#include <functional>
 #include <iostream>
 #include <limits>
-#include <map>
+#include <thread>
 
 namespace pdal
 {
@@ -61,79 +63,87 @@ void MortonOrderFilter::addArgs(ProgramArgs& args)
     args.add("reverse", "Reverse Morton", m_reverse, false);
 }
 
-//This used to be a lambda, but the VS compiler exploded, I guess.
-typedef std::pair<double, double> Coord;
 namespace
 {
-bool less_msb(const int& x, const int& y)
-{
-    return x < y && x < (x ^ y);
-}
 
-class CmpZOrder
+// A Morton code and the position of the point it was computed from.
+typedef std::pair<uint64_t, PointId> CodeIdx;
+
+// Stable LSD radix sort of (code, position) pairs, one byte per pass.
+// Blocks of the array are histogrammed and scattered on separate
+// threads; bucket-major prefix sums give each (bucket, thread) slice a
+// disjoint target range, which keeps the sort stable.  Passes where
+// every code shares the same byte are skipped.
+void radixSort(std::vector<CodeIdx>& codes)
 {
-public:
-    bool operator()(const Coord& c1, const Coord& c2) const
-    {
-        int a[2] = {(int)(c1.first * INT_MAX), (int)(c1.second * INT_MAX)};
-        int b[2] = {(int)(c2.first * INT_MAX), (int)(c2.second * INT_MAX)};
+    size_t n = codes.size();
+    if (n < 2)
+        return;
 
-        int j = 0;
-        int x = 0;
+    size_t threads = (std::max)((size_t)1,
+        (std::min)((size_t)std::thread::hardware_concurrency(), n / 65536));
 
-        for (int k = 0; k < 2; k++)
+    std::vector<size_t> bounds(threads + 1);
+    for (size_t t = 0; t <= threads; ++t)
+        bounds[t] = n * t / threads;
+
+    std::vector<CodeIdx> tmp(n);
+    CodeIdx *src = codes.data();
+    CodeIdx *dst = tmp.data();
+
+    std::vector<std::vector<size_t>> hist(threads,
+        std::vector<size_t>(256));
+    auto parallel = [threads](std::function<void(size_t)> f)
+    {
+        if (threads == 1)
         {
-            int y = a[k] ^ b[k];
-            if (less_msb(x, y))
-            {
-                j = k;
-                x = y;
-            }
+            f(0);
+            return;
         }
-        return (a[j] - b[j]) < 0;
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t)
+            pool.emplace_back(f, t);
+        for (auto& t : pool)
+            t.join();
     };
-};
-}
-
-class ReverseZOrder
-{
-public:
-    static uint32_t encode_morton(uint32_t x, uint32_t y)
-    {
-        return (part1_by1(y) << 1) + part1_by1(x);
-    }
 
-    static uint32_t reverse_morton(uint32_t index)
+    for (int shift = 0; shift < 64; shift += 8)
     {
-        index = ((index >> 1) & 0x55555555u) | ((index & 0x55555555u) << 1);
-        index = ((index >> 2) & 0x33333333u) | ((index & 0x33333333u) << 2);
-        index = ((index >> 4) & 0x0f0f0f0fu) | ((index & 0x0f0f0f0fu) << 4);
-        index = ((index >> 8) & 0x00ff00ffu) | ((index & 0x00ff00ffu) << 8);
-        index = ((index >> 16) & 0xffffu) | ((index & 0xffffu) << 16);
-        return index;
-    }
+        parallel([&](size_t t)
+        {
+            auto& h = hist[t];
+            std::fill(h.begin(), h.end(), 0);
+            for (size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+                h[(src[i].first >> shift) & 0xff]++;
+        });
+
+        size_t total = 0;
+        bool single = false;
+        for (size_t b = 0; b < 256; ++b)
+            for (size_t t = 0; t < threads; ++t)
+            {
+                size_t c = hist[t][b];
+                if (c == n)
+                    single = true;
+                hist[t][b] = total;
+                total += c;
+            }
+        if (single)
+            continue;
 
-private:
-    static uint32_t part1_by1(uint32_t x)
-    {
-        x &= 0x0000ffff;
-        x = (x ^ (x <<  8)) & 0x00ff00ff;
-        x = (x ^ (x <<  4)) & 0x0f0f0f0f;
-        x = (x ^ (x <<  2)) & 0x33333333;
-        x = (x ^ (x <<  1)) & 0x55555555;
-        return x;
+        parallel([&, shift](size_t t)
+        {
+            auto& h = hist[t];
+            for (size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+                dst[h[(src[i].first >> shift) & 0xff]++] = src[i];
+        });
+        std::swap(src, dst);
     }
+    if (src != codes.data())
+        std::copy(src, src + n, codes.data());
+}
 
-    static uint32_t part1_by2(uint32_t x)
-    {
-        x &= 0x000003ff;
-        x = (x ^ (x << 16)) & 0xff0000ff;
-        x = (x ^ (x <<  8)) & 0x0300f00f;
-        x = (x ^ (x <<  4)) & 0x030c30c3;
-        x = (x ^ (x <<  2)) & 0x09249249;
-        return x;
-    }
-};
+}
 
 PointViewSet MortonOrderFilter::reverseMorton(PointViewPtr inView)
 {
@@ -149,7 +159,7 @@ PointViewSet MortonOrderFilter::reverseMorton(PointViewPtr inView)
     const double cell_height = yrange / cell;
 
     // compute reverse morton code for each point
-    std::multimap<uint32_t, PointId> codes;
+    std::vector<CodeIdx> codes(inView->size());
     for (PointId idx = 0; idx < inView->size(); idx++)
     {
         const double x = inView->getFieldAs<double>(Dimension::Id::X, idx);
@@ -162,19 +172,16 @@ PointViewSet MortonOrderFilter::reverseMorton(PointViewPtr inView)
             static_cast<int32_t>(std::floor((y - buffer_bounds.miny) /
                 cell_height));
 
-        const uint32_t code = ReverseZOrder::encode_morton(xpos, ypos);
-        const uint32_t reverse = ReverseZOrder::reverse_morton( code );
-
-        codes.insert( std::pair<uint32_t, PointId>(reverse, idx) );
+        // Y above X, matching the historical ordering of this mode.
+        const uint32_t code = curve::mortonEncode16(ypos, xpos);
+        codes[idx] = CodeIdx(curve::bitReverse(code), idx);
     }
 
-    // a map is yet order by key so its naturally ordered by lod
-    std::multimap<uint32_t, PointId>::iterator it;
+    // Ordering by the reversed code orders by lod.
+    radixSort(codes);
     PointViewPtr outView = inView->makeNew();
-    for (it = codes.begin(); it != codes.end(); ++it)
-    {
-        outView->appendPoint(*inView, it->second);
-    }
+    for (const CodeIdx& c : codes)
+        outView->appendPoint(*inView, c.second);
 
     // build output view
     PointViewSet viewSet;
@@ -188,30 +195,32 @@ PointViewSet MortonOrderFilter::morton(PointViewPtr inView)
     PointViewSet viewSet;
     if (!inView->size())
         return viewSet;
-    CmpZOrder compare;
-    std::multimap<Coord, PointId, CmpZOrder> sorted(compare);
 
     BOX2D buffer_bounds;
     calculateBounds(*inView, buffer_bounds);
     double xrange = buffer_bounds.maxx - buffer_bounds.minx;
     double yrange = buffer_bounds.maxy - buffer_bounds.miny;
 
+    // Interleaving the bits of the scaled coordinates - X above Y, as
+    // the comparison sort resolved same-level differences in favor of
+    // X - yields a code whose numeric order is the z-order, so
+    // ordering the codes orders the points.
+    std::vector<CodeIdx> codes(inView->size());
     for (PointId idx = 0; idx < inView->size(); idx++)
     {
         double xpos = (inView->getFieldAs<double>(Dimension::Id::X, idx) -
             buffer_bounds.minx) / xrange;
         double ypos = (inView->getFieldAs<double>(Dimension::Id::Y, idx) -
             buffer_bounds.miny) / yrange;
-        Coord loc(xpos, ypos);
-        sorted.insert(std::make_pair(loc, idx));
+        uint32_t xbits = (uint32_t)(int32_t)(xpos * INT_MAX);
+        uint32_t ybits = (uint32_t)(int32_t)(ypos * INT_MAX);
+        codes[idx] = CodeIdx(curve::mortonEncode(xbits, ybits), idx);
     }
 
+    radixSort(codes);
     PointViewPtr outView = inView->makeNew();
-    std::multimap<Coord, PointId, CmpZOrder>::iterator pos;
-    for (pos = sorted.begin(); pos != sorted.end(); ++pos)
-    {
-        outView->appendPoint(*inView, pos->second);
-    }
+    for (const CodeIdx& c : codes)
+        outView->appendPoint(*inView, c.second);
     viewSet.insert(outView);
 
     return viewSet;
@@ -34,6 +34,7 @@
 
 #include "NNDistanceFilter.hpp"
 
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -115,24 +116,28 @@ void NNDistanceFilter::filter(PointView& view)
     size_t k = m_k + 1;
 
     // Compute the k-distance for each point. The k-distance is the Euclidean
-    // distance to k-th nearest neighbor.
+    // distance to k-th nearest neighbor.  The batch query Morton-orders the
+    // lookups for tree locality and runs them across threads.
     log()->get(LogLevel::Debug) << "Computing k-distances...\n";
+    PointIdList queries(view.size());
+    std::iota(queries.begin(), queries.end(), 0);
+    PointIdList indices;
+    std::vector<double> sqr_dists;
+    point_count_t kk = index.neighborsBatch(queries, k, indices, &sqr_dists);
     for (PointId idx = 0; idx < view.size(); ++idx)
     {
-        PointIdList indices(k);
-        std::vector<double> sqr_dists(k);
-        index.knnSearch(idx, k, &indices, &sqr_dists);
+        const double *dists = &sqr_dists[idx * kk];
         double val;
         if (m_mode == Mode::Kth)
-            val = std::sqrt(sqr_dists[k - 1]);
+            val = std::sqrt(dists[kk - 1]);
         else // m_mode == Mode::Average
         {
             val = 0;
 
             // We start at 1 since index 0 is the test point.
-            for (size_t i = 1; i < k; ++i)
-                val += std::sqrt(sqr_dists[i]);
-            val /= (k - 1);
+            for (point_count_t i = 1; i < kk; ++i)
+                val += std::sqrt(dists[i]);
+            val /= (kk - 1);
         }
         view.setField(Dimension::Id::NNDistance, idx, val);
     }
@@ -37,11 +37,15 @@
 #include <pdal/PipelineManager.hpp>
 #include <pdal/StageFactory.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "private/DimRange.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <thread>
 #include <utility>
+#include <vector>
 namespace pdal
 {
 
@@ -68,6 +72,14 @@ void NeighborClassifierFilter::addArgs(ProgramArgs& args)
     args.add("k", "Number of nearest neighbors to consult",
         m_k).setPositional();
     args.add("candidate", "candidate file name", m_candidateFile);
+    args.add("threads", "Number of threads used to run this filter "
+        "(0 = choose automatically)", m_threads);
+}
+
+
+size_t NeighborClassifierFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
 }
 
 void NeighborClassifierFilter::initialize()
@@ -166,12 +178,95 @@ PointViewPtr NeighborClassifierFilter::loadSet(const std::string& filename,
     return *viewSet.begin();
 }
 
+// Re-classify a block of points per thread, voting against a snapshot of
+// the neighbor classifications taken before any updates.  With a candidate
+// file this matches the sequential path exactly; without one it decouples
+// the votes from the update order so the result doesn't depend on the
+// thread count.
+void NeighborClassifierFilter::voteBlocks(PointView& view,
+    const PointView& nnView, const KD3Index& kdi, size_t threads)
+{
+    point_count_t np = view.size();
+    std::vector<int> classes(nnView.size());
+    for (PointId i = 0; i < nnView.size(); ++i)
+        classes[i] = nnView.getFieldAs<int>(m_dim, i);
+
+    point_count_t k = (std::min)((point_count_t)m_k, nnView.size());
+    double thresh = k / 2.0;
+
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&, t]()
+        {
+            PointId begin = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            PointRef point(view, 0);
+            PointIdList ids(k);
+            std::vector<double> sqr_dists(k);
+            for (PointId id = begin; id < end; ++id)
+            {
+                point.setPointId(id);
+                if (m_domain.size())
+                {   // process only points that satisfy a domain condition
+                    bool pass = false;
+                    for (DimRange& r : m_domain)
+                        if (r.valuePasses(point.getFieldAs<double>(r.m_id)))
+                        {
+                            pass = true;
+                            break;
+                        }
+                    if (!pass)
+                        continue;
+                }
+
+                kdi.knnSearch(point.getFieldAs<double>(Dimension::Id::X),
+                    point.getFieldAs<double>(Dimension::Id::Y),
+                    point.getFieldAs<double>(Dimension::Id::Z),
+                    k, &ids, &sqr_dists);
+
+                // vote NNs
+                using CountMap = std::map<int, unsigned int>;
+                CountMap counts;
+                for (point_count_t i = 0; i < k; ++i)
+                    counts[classes[ids[i]]]++;
+
+                // pick winner of the vote
+                auto pr = *std::max_element(counts.begin(), counts.end(),
+                    [](CountMap::const_reference p1,
+                       CountMap::const_reference p2)
+                    { return p1.second < p2.second; });
+
+                // update point
+                auto oldclass = point.getFieldAs<double>(m_dim);
+                auto newclass = pr.first;
+                if (pr.second > thresh && oldclass != newclass)
+                    point.setField(m_dim, newclass);
+            }
+        });
+    }
+    for (auto& t : pool)
+        t.join();
+}
+
+
 void NeighborClassifierFilter::filter(PointView& view)
 {
     PointRef point_src(view, 0);
     if (m_candidateFile.empty())
     {   // No candidate file so NN comes from src file
         KD3Index& kdiSrc = view.build3dIndex();
+
+        // The sequential path lets each reassignment feed into later
+        // votes, so auto-threading stays sequential here; an explicit
+        // thread count opts into order-independent voting.
+        size_t threads = (m_threads > 1) ? threadCount(view.size()) : 1;
+        if (threads > 1)
+        {
+            voteBlocks(view, view, kdiSrc, threads);
+            return;
+        }
+
         PointRef point_nn(view, 0);
         for (PointId id = 0; id < view.size(); ++id)
         {
@@ -184,6 +279,14 @@ void NeighborClassifierFilter::filter(PointView& view)
         PointTable candTable;
         PointViewPtr candView = loadSet(m_candidateFile, candTable);
         KD3Index& kdiCand = candView->build3dIndex();
+
+        size_t threads = threadCount(view.size());
+        if (threads > 1)
+        {
+            voteBlocks(view, *candView, kdiCand, threads);
+            return;
+        }
+
         PointRef point_nn(*candView, 0);
         for (PointId id = 0; id < view.size(); ++id)
         {
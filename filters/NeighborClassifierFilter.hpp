@@ -62,12 +62,16 @@ private:
     virtual void filter(PointView& view);
     virtual void initialize();
     void doOneNoDomain(PointRef &point, PointRef& temp, KD3Index &kdi);
+    size_t threadCount(point_count_t np) const;
+    void voteBlocks(PointView& view, const PointView& nnView,
+        const KD3Index& kdi, size_t threads);
     PointViewPtr loadSet(const std::string &candFileName, PointTable &table);
     NeighborClassifierFilter& operator=(const NeighborClassifierFilter&) = delete;
     NeighborClassifierFilter(const NeighborClassifierFilter&) = delete;
     StringList m_domainSpec;
     std::vector<DimRange> m_domain;
     int m_k;
+    size_t m_threads;
     Dimension::Id m_dim;
     std::string m_dimName;
     std::string m_candidateFile;
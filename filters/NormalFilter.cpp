@@ -49,7 +49,10 @@
 
 #include <Eigen/Dense>
 
+#include <mutex>
+#include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace pdal
@@ -67,6 +70,7 @@ CREATE_STATIC_STAGE(NormalFilter, s_info)
 struct NormalArgs
 {
     int m_knn;
+    int m_threads;
     filter::Point m_viewpoint;
     bool m_up;
     bool m_refine;
@@ -84,6 +88,8 @@ std::string NormalFilter::getName() const
 void NormalFilter::addArgs(ProgramArgs& args)
 {
     args.add("knn", "k-Nearest Neighbors", m_args->m_knn, 8);
+    args.add("threads", "Number of threads used to run this filter",
+             m_args->m_threads, 1);
     m_viewpointArg = &args.add("viewpoint", "Viewpoint as WKT or GeoJSON",
                                m_args->m_viewpoint);
     args.add("always_up", "Normals always oriented with positive Z?",
@@ -127,53 +133,103 @@ void NormalFilter::prepared(PointTableRef table)
 void NormalFilter::compute(PointView& view, KD3Index& kdi)
 {
     log()->get(LogLevel::Debug) << "Computing normal vectors\n";
-    for (auto&& p : view)
+
+    // Query every point's neighborhood up front through the batch
+    // interface, which runs the queries in Morton order for tree
+    // locality and across threads.
+    point_count_t nloops = view.size();
+    int threads = (std::max)(m_args->m_threads, 1);
+
+    PointIdList queries(nloops);
+    std::iota(queries.begin(), queries.end(), 0);
+    PointIdList nbrs;
+    point_count_t k = kdi.neighborsBatch(queries, m_args->m_knn, nbrs,
+        nullptr, (size_t)threads);
+
+    // Each point's normal depends only on its own neighborhood, so slices
+    // of the view are processed on separate threads, in the manner of
+    // CovarianceFeaturesFilter.
+    std::vector<std::thread> threadList(threads);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    for (int t = 0; t < threads; t++)
     {
-        // Perform eigen decomposition of covariance matrix computed from
-        // neighborhood composed of k-nearest neighbors.
-        PointIdList neighbors = kdi.neighbors(p.pointId(), m_args->m_knn);
-        auto B = computeCovariance(view, neighbors);
-        SelfAdjointEigenSolver<Matrix3d> solver(B);
-        if (solver.info() != Success)
-            throwError("Cannot perform eigen decomposition.");
-
-        // The curvature is computed as the ratio of the first (smallest)
-        // eigenvalue to the sum of all eigenvalues.
-        auto eval = solver.eigenvalues();
-        double sum = eval[0] + eval[1] + eval[2];
-        double curvature = sum ? std::fabs(eval[0] / sum) : 0;
-
-        // The normal is defined by the eigenvector corresponding to the
-        // smallest eigenvalue.
-        Vector3d normal = solver.eigenvectors().col(0);
-
-        if (m_viewpointArg->set())
-        {
-            // If a viewpoint has been specified, orient the normals to face the
-            // viewpoint by taking the dot product of the vector connecting the
-            // point with the viewpoint and the normal. Flip the normal, where
-            // the dot product is negative.
-            double dx = m_args->m_viewpoint.x() - p.getFieldAs<double>(Id::X);
-            double dy = m_args->m_viewpoint.y() - p.getFieldAs<double>(Id::Y);
-            double dz = m_args->m_viewpoint.z() - p.getFieldAs<double>(Id::Z);
-            Vector3d vp(dx, dy, dz);
-            if (vp.dot(normal) < 0)
-                normal *= -1.0;
-        }
-        else if (m_args->m_up)
-        {
-            // If normals are expected to be upward facing, invert them when the
-            // Z component is negative.
-            if (normal[2] < 0)
-                normal *= -1.0;
-        }
+        threadList[t] = std::thread(std::bind(
+            [&](const PointId start, const PointId end)
+            {
+                try
+                {
+                    for (PointId i = start; i < end; i++)
+                        computeSingle(view, i,
+                            PointIdList(nbrs.begin() + i * k,
+                                nbrs.begin() + (i + 1) * k));
+                }
+                catch (...)
+                {
+                    // Stash the error - throwing out of a thread
+                    // terminates.
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                        error = std::current_exception();
+                }
+            },
+            t * nloops / threads,
+            (t + 1) == threads ? nloops : (t + 1) * nloops / threads));
+    }
+    for (auto& t : threadList)
+        t.join();
+    if (error)
+        std::rethrow_exception(error);
+}
 
-        // Set the computed normal and curvature dimensions.
-        p.setField(Id::NormalX, normal[0]);
-        p.setField(Id::NormalY, normal[1]);
-        p.setField(Id::NormalZ, normal[2]);
-        p.setField(Id::Curvature, curvature);
+void NormalFilter::computeSingle(PointView& view, PointId i,
+    const PointIdList& neighbors)
+{
+    PointRef p = view.point(i);
+
+    // Perform eigen decomposition of covariance matrix computed from
+    // neighborhood composed of k-nearest neighbors.
+    auto B = computeCovariance(view, neighbors);
+    SelfAdjointEigenSolver<Matrix3d> solver(B);
+    if (solver.info() != Success)
+        throwError("Cannot perform eigen decomposition.");
+
+    // The curvature is computed as the ratio of the first (smallest)
+    // eigenvalue to the sum of all eigenvalues.
+    auto eval = solver.eigenvalues();
+    double sum = eval[0] + eval[1] + eval[2];
+    double curvature = sum ? std::fabs(eval[0] / sum) : 0;
+
+    // The normal is defined by the eigenvector corresponding to the
+    // smallest eigenvalue.
+    Vector3d normal = solver.eigenvectors().col(0);
+
+    if (m_viewpointArg->set())
+    {
+        // If a viewpoint has been specified, orient the normals to face the
+        // viewpoint by taking the dot product of the vector connecting the
+        // point with the viewpoint and the normal. Flip the normal, where
+        // the dot product is negative.
+        double dx = m_args->m_viewpoint.x() - p.getFieldAs<double>(Id::X);
+        double dy = m_args->m_viewpoint.y() - p.getFieldAs<double>(Id::Y);
+        double dz = m_args->m_viewpoint.z() - p.getFieldAs<double>(Id::Z);
+        Vector3d vp(dx, dy, dz);
+        if (vp.dot(normal) < 0)
+            normal *= -1.0;
     }
+    else if (m_args->m_up)
+    {
+        // If normals are expected to be upward facing, invert them when the
+        // Z component is negative.
+        if (normal[2] < 0)
+            normal *= -1.0;
+    }
+
+    // Set the computed normal and curvature dimensions.
+    p.setField(Id::NormalX, normal[0]);
+    p.setField(Id::NormalY, normal[1]);
+    p.setField(Id::NormalZ, normal[2]);
+    p.setField(Id::Curvature, curvature);
 }
 
 void NormalFilter::update(
@@ -89,6 +89,8 @@ private:
     Arg* m_viewpointArg;
 
     void compute(PointView& view, KD3Index& kdi);
+    void computeSingle(PointView& view, PointId i,
+        const PointIdList& neighbors);
     void refine(PointView& view, KD3Index& kdi);
     void
     update(PointView& view, KD3Index& kdi, std::vector<bool> inMST,
@@ -34,11 +34,14 @@
 
 #include "OutlierFilter.hpp"
 
+#include <pdal/GridIndex.hpp>
 #include <pdal/KDIndex.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/util/Utils.hpp>
 
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace pdal
@@ -67,6 +70,13 @@ void OutlierFilter::addArgs(ProgramArgs& args)
     args.add("mean_k", "Mean number of neighbors", m_meanK, 8);
     args.add("multiplier", "Standard deviation threshold", m_multiplier, 2.0);
     args.add("class", "Class to use for noise points", m_class, ClassLabel::LowPoint);
+    args.add("threads", "Number of threads used for neighbor queries (0 = "
+        "choose automatically)", m_threads);
+}
+
+size_t OutlierFilter::threadCount(point_count_t np) const
+{
+    return pdal::threadCount(m_threads, np);
 }
 
 void OutlierFilter::addDimensions(PointLayoutPtr layout)
@@ -76,17 +86,35 @@ void OutlierFilter::addDimensions(PointLayoutPtr layout)
 
 Indices OutlierFilter::processRadius(PointViewPtr inView)
 {
-    KD3Index index(*inView);
-    index.build();
+    // The query radius is fixed, so a grid hash beats a KD-tree here, and
+    // we only need a neighbor count - no ID list.  The built index is
+    // published on the table so later fixed-radius stages can reuse it.
+    Grid3Index& index = OccupancyArtifact::obtain(*inView, m_radius);
 
     point_count_t np = inView->size();
 
-    PointIdList inliers, outliers;
+    // The per-point neighbor counts are independent - process slices of
+    // the view on separate threads, then partition in a serial pass.
+    std::vector<char> inlier(np);
+    size_t threads = threadCount(np);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&, t]()
+        {
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            for (PointId i = start; i < end; ++i)
+                inlier[i] =
+                    (index.within(i, m_radius) > point_count_t(m_minK));
+        });
+    for (auto& t : pool)
+        t.join();
 
+    PointIdList inliers, outliers;
+    inliers.reserve(np);
     for (PointId i = 0; i < np; ++i)
     {
-        auto ids = index.radius(i, m_radius);
-        if (ids.size() > size_t(m_minK))
+        if (inlier[i])
             inliers.push_back(i);
         else
             outliers.push_back(i);
@@ -109,21 +137,32 @@ Indices OutlierFilter::processStatistical(PointViewPtr inView)
     // we increase the count by one because the query point itself will
     // be included with a distance of 0
     point_count_t count = m_meanK + 1;
-    PointIdList indices(count);
-    std::vector<double> sqr_dists(count);
-    for (PointId i = 0; i < np; ++i)
-    {
-
-        index.knnSearch(i, count, &indices, &sqr_dists);
 
-        for (size_t j = 1; j < count; ++j)
+    // The kNN queries dominate and are independent per point - process
+    // slices of the view on separate threads, each with its own result
+    // buffers.
+    size_t threads = threadCount(np);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&, t]()
         {
-            double delta = std::sqrt(sqr_dists[j]) - distances[i];
-            distances[i] += (delta / j);
-        }
-        indices.clear(); indices.resize(count);
-        sqr_dists.clear(); sqr_dists.resize(count);
-    }
+            PointIdList indices(count);
+            std::vector<double> sqr_dists(count);
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            for (PointId i = start; i < end; ++i)
+            {
+                index.knnSearch(i, count, &indices, &sqr_dists);
+
+                for (size_t j = 1; j < count; ++j)
+                {
+                    double delta = std::sqrt(sqr_dists[j]) - distances[i];
+                    distances[i] += (delta / j);
+                }
+            }
+        });
+    for (auto& t : pool)
+        t.join();
 
     size_t n(0);
     double M1(0.0);
@@ -143,6 +182,7 @@ Indices OutlierFilter::processStatistical(PointViewPtr inView)
 
     double threshold = mean + m_multiplier * stdev;
 
+    inliers.reserve(np);
     for (PointId i = 0; i < np; ++i)
     {
         if (distances[i] < threshold)
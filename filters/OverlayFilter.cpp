@@ -34,10 +34,16 @@
 
 #include "OverlayFilter.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <thread>
 #include <vector>
 
 #include <pdal/GDALUtils.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -125,6 +131,51 @@ void OverlayFilter::ready(PointTableRef table)
         feature = OGRFeaturePtr(OGR_L_GetNextFeature(m_lyr), featureDeleter);
     }
     while (feature);
+
+    buildIndex();
+}
+
+
+// Pack the polygons into roughly sqrt(n) vertical slices by bounding-box
+// center X, each slice ordered by box minimum Y - a static STR-style
+// index.  A lookup visits only the slices whose X extent covers the point
+// and stops scanning a slice once the remaining boxes start above it.
+void OverlayFilter::buildIndex()
+{
+    for (auto& poly : m_polygons)
+        poly.box = poly.geom.bounds().to2d();
+
+    std::vector<size_t> order(m_polygons.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b)
+    {
+        return m_polygons[a].box.minx + m_polygons[a].box.maxx <
+            m_polygons[b].box.minx + m_polygons[b].box.maxx;
+    });
+
+    size_t sliceCnt = (size_t)std::ceil(std::sqrt((double)order.size()));
+    size_t slicePolys = sliceCnt ?
+        (order.size() + sliceCnt - 1) / sliceCnt : 0;
+
+    m_slices.clear();
+    for (size_t pos = 0; pos < order.size(); pos += slicePolys)
+    {
+        Slice slice;
+        size_t end = (std::min)(pos + slicePolys, order.size());
+
+        slice.polys.assign(order.begin() + pos, order.begin() + end);
+        std::sort(slice.polys.begin(), slice.polys.end(),
+            [this](size_t a, size_t b)
+            { return m_polygons[a].box.miny < m_polygons[b].box.miny; });
+        slice.xmin = (std::numeric_limits<double>::max)();
+        slice.xmax = std::numeric_limits<double>::lowest();
+        for (size_t pi : slice.polys)
+        {
+            slice.xmin = (std::min)(slice.xmin, m_polygons[pi].box.minx);
+            slice.xmax = (std::max)(slice.xmax, m_polygons[pi].box.maxx);
+        }
+        m_slices.push_back(std::move(slice));
+    }
 }
 
 
@@ -143,30 +194,83 @@ void OverlayFilter::spatialReferenceChanged(const SpatialReference& srs)
             throwError(err.what());
         }
     }
+
+    // The transform moved the bounding boxes.
+    buildIndex();
+
+    // Build the point-in-polygon state now so the per-point lookups
+    // don't pay for it on first use.
+    for (auto& poly : m_polygons)
+        poly.geom.prepare();
 }
 
 
 bool OverlayFilter::processOne(PointRef& point)
 {
-    for (const auto& poly : m_polygons)
+    double x = point.getFieldAs<double>(Dimension::Id::X);
+    double y = point.getFieldAs<double>(Dimension::Id::Y);
+
+    // When overlapping polygons contain a point, the one latest in
+    // datasource order wins, matching the order-independent scan this
+    // replaces.
+    bool found = false;
+    size_t best = 0;
+    for (const Slice& slice : m_slices)
     {
-        double x = point.getFieldAs<double>(Dimension::Id::X);
-        double y = point.getFieldAs<double>(Dimension::Id::Y);
-        if (poly.geom.contains(x, y))
-            point.setField(m_dim, poly.val);
+        if (x < slice.xmin || x > slice.xmax)
+            continue;
+        for (size_t pi : slice.polys)
+        {
+            const PolyVal& poly = m_polygons[pi];
+            if (poly.box.miny > y)
+                break;
+            if (y <= poly.box.maxy && x >= poly.box.minx &&
+                x <= poly.box.maxx && poly.geom.contains(x, y))
+            {
+                if (!found || pi > best)
+                    best = pi;
+                found = true;
+            }
+        }
     }
+    if (found)
+        point.setField(m_dim, m_polygons[best].val);
     return true;
 }
 
 
 void OverlayFilter::filter(PointView& view)
 {
-    PointRef point(view, 0);
-    for (PointId id = 0; id < view.size(); ++id)
+    // Points are assigned independently against read-only polygon state,
+    // so large views are split across a thread pool.
+    const point_count_t chunkSize = 65536;
+
+    if (view.size() <= chunkSize)
     {
-        point.setPointId(id);
-        processOne(point);
+        PointRef point(view, 0);
+        for (PointId id = 0; id < view.size(); ++id)
+        {
+            point.setPointId(id);
+            processOne(point);
+        }
+        return;
+    }
+
+    ThreadPool pool(std::thread::hardware_concurrency());
+    for (PointId start = 0; start < view.size(); start += chunkSize)
+    {
+        PointId end = (std::min)(start + chunkSize, (PointId)view.size());
+        pool.add([this, &view, start, end]()
+        {
+            PointRef point(view, start);
+            for (PointId id = start; id < end; ++id)
+            {
+                point.setPointId(id);
+                processOne(point);
+            }
+        });
     }
+    pool.await();
 }
 
 } // namespace pdal
@@ -37,6 +37,7 @@
 #include <pdal/Filter.hpp>
 #include <pdal/Polygon.hpp>
 #include <pdal/Streamable.hpp>
+#include <pdal/util/Bounds.hpp>
 
 #include <map>
 #include <memory>
@@ -64,6 +65,16 @@ class PDAL_DLL OverlayFilter : public Filter, public Streamable
     {
         Polygon geom;
         int32_t val;
+        BOX2D box;  // Cached bounds of geom - a cheap containment prefilter.
+    };
+
+    // One vertical slice of an STR-style packed index over the polygon
+    // bounding boxes (see buildIndex()).
+    struct Slice
+    {
+        double xmin;
+        double xmax;
+        std::vector<size_t> polys;  // Indices, ordered by box minimum Y.
     };
 
 public:
@@ -80,6 +91,7 @@ private:
     virtual void prepared(PointTableRef table);
     virtual void ready(PointTableRef table);
     virtual void filter(PointView& view);
+    void buildIndex();
 
     OverlayFilter& operator=(const OverlayFilter&) = delete;
     OverlayFilter(const OverlayFilter&) = delete;
@@ -95,6 +107,7 @@ private:
     std::string m_layer;
     Dimension::Id m_dim;
     std::vector<PolyVal> m_polygons;
+    std::vector<Slice> m_slices;
 };
 
 } // namespace pdal
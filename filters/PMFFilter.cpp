@@ -336,8 +336,7 @@ void PMFFilter::processGround(PointViewPtr view)
             << ", window size = " << wsvec[j] << ")...\n";
 
         int iters = static_cast<int>(0.5 * (wsvec[j] - 1));
-        std::vector<double> me = erodeDiamond(ZImin, rows, cols, iters);
-        std::vector<double> mo = dilateDiamond(me, rows, cols, iters);
+        std::vector<double> mo = openDiamond(ZImin, rows, cols, iters);
 
         PointIdList groundNewIdx;
         for (auto p_idx : groundIdx)
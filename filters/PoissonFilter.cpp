@@ -36,6 +36,9 @@
 #include "NormalFilter.hpp"
 #include "TransformationFilter.hpp"
 
+#include <algorithm>
+#include <thread>
+
 #include <kazhdan/PoissonRecon.h>
 #include <kazhdan/point_source/PointSource.h>
 
@@ -52,62 +55,102 @@ namespace pdal
 class PointViewSource : public PointSource
 {
 public:
-    PointViewSource(PointView& view) : m_view(view), m_current(0)
-        {}
+    PointViewSource(PointView& view) : m_count(view.size()), m_current(0)
+    {
+        using namespace Dimension;
+
+        // Gather the coordinates and normals into flat buffers up front;
+        // the reconstruction kernel streams the source more than once and
+        // per-field view lookups added up.
+        m_x.resize(m_count);
+        m_y.resize(m_count);
+        m_z.resize(m_count);
+        m_nx.resize(m_count);
+        m_ny.resize(m_count);
+        m_nz.resize(m_count);
+        view.getFieldBatch(Id::X, 0, m_count, m_x.data());
+        view.getFieldBatch(Id::Y, 0, m_count, m_y.data());
+        view.getFieldBatch(Id::Z, 0, m_count, m_z.data());
+        view.getFieldBatch(Id::NormalX, 0, m_count, m_nx.data());
+        view.getFieldBatch(Id::NormalY, 0, m_count, m_ny.data());
+        view.getFieldBatch(Id::NormalZ, 0, m_count, m_nz.data());
+    }
 
     virtual void reset()
         { m_current = 0; }
     virtual bool nextPoint(Point& point)
     {
-        using namespace Dimension;
-
-        if (m_current >= m_view.size())
+        if (m_current >= m_count)
             return false;
-        point.p.coords[0] = m_view.getFieldAs<double>(Id::X, m_current);
-        point.p.coords[1] = m_view.getFieldAs<double>(Id::Y, m_current);
-        point.p.coords[2] = m_view.getFieldAs<double>(Id::Z, m_current);
-        point.n.coords[0] = m_view.getFieldAs<double>(Id::NormalX, m_current);
-        point.n.coords[1] = m_view.getFieldAs<double>(Id::NormalY, m_current);
-        point.n.coords[2] = m_view.getFieldAs<double>(Id::NormalZ, m_current);
+        point.p.coords[0] = m_x[m_current];
+        point.p.coords[1] = m_y[m_current];
+        point.p.coords[2] = m_z[m_current];
+        point.n.coords[0] = m_nx[m_current];
+        point.n.coords[1] = m_ny[m_current];
+        point.n.coords[2] = m_nz[m_current];
         m_current++;
         return true;
     }
 
 private:
-    PointView& m_view;
+    point_count_t m_count;
     PointId m_current;
+    std::vector<double> m_x, m_y, m_z;
+    std::vector<double> m_nx, m_ny, m_nz;
 };
 
 class ColorPointViewSource : public ColorPointSource
 {
 public:
-    ColorPointViewSource(PointView& view) : m_view(view), m_current(0)
-        {}
+    ColorPointViewSource(PointView& view) : m_count(view.size()), m_current(0)
+    {
+        using namespace Dimension;
+
+        m_x.resize(m_count);
+        m_y.resize(m_count);
+        m_z.resize(m_count);
+        m_nx.resize(m_count);
+        m_ny.resize(m_count);
+        m_nz.resize(m_count);
+        m_r.resize(m_count);
+        m_g.resize(m_count);
+        m_b.resize(m_count);
+        view.getFieldBatch(Id::X, 0, m_count, m_x.data());
+        view.getFieldBatch(Id::Y, 0, m_count, m_y.data());
+        view.getFieldBatch(Id::Z, 0, m_count, m_z.data());
+        view.getFieldBatch(Id::NormalX, 0, m_count, m_nx.data());
+        view.getFieldBatch(Id::NormalY, 0, m_count, m_ny.data());
+        view.getFieldBatch(Id::NormalZ, 0, m_count, m_nz.data());
+        view.getFieldBatch(Id::Red, 0, m_count, m_r.data());
+        view.getFieldBatch(Id::Green, 0, m_count, m_g.data());
+        view.getFieldBatch(Id::Blue, 0, m_count, m_b.data());
+    }
 
     virtual void reset()
         { m_current = 0; }
     virtual bool nextPoint(Point& point, Point3D<double>& color)
     {
-        using namespace Dimension;
-
-        if (m_current >= m_view.size())
+        if (m_current >= m_count)
             return false;
-        point.p.coords[0] = m_view.getFieldAs<double>(Id::X, m_current);
-        point.p.coords[1] = m_view.getFieldAs<double>(Id::Y, m_current);
-        point.p.coords[2] = m_view.getFieldAs<double>(Id::Z, m_current);
-        point.n.coords[0] = m_view.getFieldAs<double>(Id::NormalX, m_current);
-        point.n.coords[1] = m_view.getFieldAs<double>(Id::NormalY, m_current);
-        point.n.coords[2] = m_view.getFieldAs<double>(Id::NormalZ, m_current);
-        color.coords[0] = m_view.getFieldAs<double>(Id::Red, m_current);
-        color.coords[1] = m_view.getFieldAs<double>(Id::Green, m_current);
-        color.coords[2] = m_view.getFieldAs<double>(Id::Blue, m_current);
+        point.p.coords[0] = m_x[m_current];
+        point.p.coords[1] = m_y[m_current];
+        point.p.coords[2] = m_z[m_current];
+        point.n.coords[0] = m_nx[m_current];
+        point.n.coords[1] = m_ny[m_current];
+        point.n.coords[2] = m_nz[m_current];
+        color.coords[0] = m_r[m_current];
+        color.coords[1] = m_g[m_current];
+        color.coords[2] = m_b[m_current];
         m_current++;
         return true;
     }
 
 private:
-    PointView& m_view;
+    point_count_t m_count;
     PointId m_current;
+    std::vector<double> m_x, m_y, m_z;
+    std::vector<double> m_nx, m_ny, m_nz;
+    std::vector<double> m_r, m_g, m_b;
 };
 
 class PointViewMesh : public Kazhdan::Mesh
@@ -265,6 +308,8 @@ void PoissonFilter::addArgs(ProgramArgs& args)
     args.add("density", "Output density estimates", m_density);
     args.add("depth", "Maximum depth of the octree used for reconstruction",
         m_depth, 8);
+    args.add("threads", "Number of threads used by the reconstruction "
+        "solver (0 = choose automatically)", m_threads);
 }
 
 
@@ -289,6 +334,12 @@ PointViewSet PoissonFilter::run(PointViewPtr view)
     opts.m_density = m_density;
     opts.m_solveDepth = m_depth;
     opts.m_kernelDepth = m_depth - 2;
+    // The kernel's octree construction, solver and evaluator are all
+    // parallelized internally when built with OpenMP.
+    size_t threads = m_threads;
+    if (threads == 0)
+        threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+    opts.m_threads = (int)threads;
     if (m_doColor)
     {
         opts.m_color = 16;
@@ -34,7 +34,7 @@
 
 #include "RadialDensityFilter.hpp"
 
-#include <pdal/KDIndex.hpp>
+#include <pdal/GridIndex.hpp>
 
 #include <string>
 #include <vector>
@@ -71,8 +71,11 @@ void RadialDensityFilter::filter(PointView& view)
 {
     using namespace Dimension;
 
-    // Build the 3D KD-tree.
-    KD3Index& index = view.build3dIndex();
+    // The query radius is fixed, so a grid hash sized to it beats a
+    // KD-tree.  The index is shared through the table's ArtifactManager,
+    // so an earlier fixed-radius stage at the same radius already paid
+    // for the build.
+    Grid3Index& index = OccupancyArtifact::obtain(view, m_rad);
 
     // Search for neighboring points within the specified radius. The number of
     // neighbors (which includes the query point) is normalized by the volume
@@ -34,6 +34,8 @@
 
 #include "RandomizeFilter.hpp"
 
+#include "private/Random.hpp"
+
 namespace pdal
 {
 
@@ -53,4 +55,30 @@ void RandomizeFilter::addArgs(ProgramArgs& args)
     m_seedArg = &args.add("seed", "Random number generator seed", m_seed, 0u);
 }
 
+void RandomizeFilter::filter(PointView& view)
+{
+    if (!m_seedArg->set())
+    {
+        std::random_device rng;
+        m_seed = rng();
+    }
+
+    point_count_t np = view.size();
+    if (np < 2)
+        return;
+
+    // Fisher-Yates directly over the view's point-ID index.  This skips
+    // the iterator proxy machinery std::shuffle went through for every
+    // swap and replaces mt19937's per-draw division with a multiply.
+    uint64_t state = m_seed;
+    ChunkedPointIndex& index = view.m_index;
+    for (PointId i = np - 1; i > 0; --i)
+    {
+        PointId j = (PointId)fastrand::bounded(state, i + 1);
+        PointId t = index[i];
+        index.set(i, index[j]);
+        index.set(j, t);
+    }
+}
+
 } // namespace pdal
@@ -56,16 +56,7 @@ private:
     unsigned m_seed;
 
     virtual void addArgs(ProgramArgs& args);
-    virtual void filter(PointView& view)
-    {
-        if (!m_seedArg->set())
-        {
-            std::random_device rng;
-            m_seed = rng();
-        }
-        std::mt19937 mt(m_seed);
-        std::shuffle(view.begin(), view.end(), mt);
-    }
+    virtual void filter(PointView& view);
 
     RandomizeFilter& operator=(const RandomizeFilter&); // not implemented
     RandomizeFilter(const RandomizeFilter&);            // not implemented
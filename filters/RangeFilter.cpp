@@ -39,9 +39,11 @@
 
 #include "private/DimRange.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <limits>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -77,6 +79,92 @@ void RangeFilter::addArgs(ProgramArgs& args)
 }
 
 
+bool RangeFilter::selectionDims(StringList& dims) const
+{
+    // Called before options are parsed, so read the raw option.  A
+    // malformed limit isn't reported here - prepare() will do that.
+    StringList limits;
+    for (const std::string& s : m_options.getValues("limits"))
+    {
+        StringList l = Utils::split2(s, ',');
+        limits.insert(limits.end(), l.begin(), l.end());
+    }
+    if (limits.empty())
+        return false;
+    for (std::string& s : limits)
+    {
+        Utils::trim(s);
+        DimRange r;
+        try
+        {
+            r.parse(s);
+        }
+        catch (const DimRange::error&)
+        {
+            return false;
+        }
+        dims.push_back(r.m_name);
+    }
+    return true;
+}
+
+
+bool RangeFilter::rangeBounds(std::vector<DimInterval>& ranges) const
+{
+    // Called before options are parsed, so read the raw option.  A
+    // malformed limit isn't reported here - prepare() will do that.
+    StringList limits;
+    for (const std::string& s : m_options.getValues("limits"))
+    {
+        StringList l = Utils::split2(s, ',');
+        limits.insert(limits.end(), l.begin(), l.end());
+    }
+    if (limits.empty())
+        return false;
+
+    // Ranges of the same dimension are ORed, so report the enclosing
+    // interval of each dimension's ranges.  A negated range admits
+    // values on both sides of its bounds, leaving that dimension
+    // unconstrained.
+    std::map<std::string, DimInterval> intervals;
+    std::set<std::string> unconstrained;
+    for (std::string& s : limits)
+    {
+        Utils::trim(s);
+        DimRange r;
+        try
+        {
+            r.parse(s);
+        }
+        catch (const DimRange::error&)
+        {
+            return false;
+        }
+        std::string name = Utils::toupper(r.m_name);
+        if (r.m_negate)
+        {
+            unconstrained.insert(name);
+            continue;
+        }
+        auto it = intervals.find(name);
+        if (it == intervals.end())
+            intervals[name] = { r.m_name, r.m_lower_bound, r.m_upper_bound };
+        else
+        {
+            it->second.m_min = (std::min)(it->second.m_min, r.m_lower_bound);
+            it->second.m_max = (std::max)(it->second.m_max, r.m_upper_bound);
+        }
+    }
+    for (const std::string& name : unconstrained)
+        intervals.erase(name);
+    if (intervals.empty())
+        return false;
+    for (const auto& i : intervals)
+        ranges.push_back(i.second);
+    return true;
+}
+
+
 void RangeFilter::prepared(PointTableRef table)
 {
     const PointLayoutPtr layout(table.layout());
@@ -110,11 +198,41 @@ PointViewSet RangeFilter::run(PointViewPtr inView)
 
     PointViewPtr outView = inView->makeNew();
 
-    for (PointId i = 0; i < inView->size(); ++i)
+    // Evaluate the ranges a block at a time.  Each dimension is fetched
+    // for the whole block with one call; ranges of the same dimension are
+    // ORed together and dimensions ANDed, mirroring pointPasses().
+    const point_count_t BatchSize = 4096;
+    std::vector<double> vals(BatchSize);
+    std::vector<char> passes(BatchSize);
+
+    for (PointId start = 0; start < inView->size(); start += BatchSize)
     {
-        PointRef point = inView->point(i);
-        if (processOne(point))
-            outView->appendPoint(*inView, i);
+        point_count_t n =
+            (std::min)((point_count_t)BatchSize, inView->size() - start);
+        std::fill(passes.begin(), passes.begin() + n, 1);
+
+        for (auto ri = m_ranges.begin(); ri != m_ranges.end();)
+        {
+            auto re = ri;
+            while (re != m_ranges.end() && re->m_id == ri->m_id)
+                ++re;
+
+            inView->getFieldBatch(ri->m_id, start, n, vals.data());
+            for (point_count_t i = 0; i < n; ++i)
+            {
+                if (!passes[i])
+                    continue;
+                bool passed = false;
+                for (auto r = ri; !passed && r != re; ++r)
+                    passed = r->valuePasses(vals[i]);
+                passes[i] = passed;
+            }
+            ri = re;
+        }
+
+        for (point_count_t i = 0; i < n; ++i)
+            if (passes[i])
+                outView->appendPoint(*inView, start + i);
     }
 
     viewSet.insert(outView);
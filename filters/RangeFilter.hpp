@@ -58,8 +58,12 @@ private:
     std::vector<DimRange> m_ranges;
 
     virtual void addArgs(ProgramArgs& args);
+    virtual bool selectionDims(StringList& dims) const;
+    virtual bool rangeBounds(std::vector<DimInterval>& ranges) const;
     virtual void prepared(PointTableRef table);
     virtual bool processOne(PointRef& point);
+    virtual bool fusable() const
+        { return true; }
     virtual PointViewSet run(PointViewPtr view);
 
     RangeFilter& operator=(const RangeFilter&) = delete;
@@ -71,6 +71,22 @@ void ReprojectionFilter::addArgs(ProgramArgs& args)
 }
 
 
+bool ReprojectionFilter::usedDims(StringList& used) const
+{
+    // Reprojection only touches position.
+    used.insert(used.end(), { "X", "Y", "Z" });
+    return true;
+}
+
+
+bool ReprojectionFilter::mutatedDims(StringList& dims) const
+{
+    // Reprojection rewrites position, point by point, and nothing else.
+    dims.insert(dims.end(), { "X", "Y", "Z" });
+    return true;
+}
+
+
 void ReprojectionFilter::initialize()
 {
     m_inferInputSRS = m_inSRS.empty();
@@ -167,12 +183,32 @@ PointViewSet ReprojectionFilter::run(PointViewPtr view)
 
     createTransform(view->spatialReference());
 
-    PointRef point(*view, 0);
-    for (PointId id = 0; id < view->size(); ++id)
+    // Gather coordinates into arrays and reproject each chunk with a
+    // single call - the per-call overhead of transforming one point at
+    // a time dominates at scale.
+    const point_count_t ChunkSize = 10000;
+    std::vector<double> x(ChunkSize);
+    std::vector<double> y(ChunkSize);
+    std::vector<double> z(ChunkSize);
+    std::vector<int> ok(ChunkSize);
+    for (PointId start = 0; start < view->size(); start += ChunkSize)
     {
-        point.setPointId(id);
-        if (processOne(point))
-            outView->appendPoint(*view, id);
+        point_count_t cnt = (std::min)(ChunkSize, view->size() - start);
+
+        view->getFieldBatch(Dimension::Id::X, start, cnt, x.data());
+        view->getFieldBatch(Dimension::Id::Y, start, cnt, y.data());
+        view->getFieldBatch(Dimension::Id::Z, start, cnt, z.data());
+        m_transform->transform(cnt, x.data(), y.data(), z.data(), ok.data());
+        for (point_count_t i = 0; i < cnt; ++i)
+        {
+            if (!ok[i])
+                continue;
+            PointId id = outView->size();
+            outView->appendPoint(*view, start + i);
+            outView->setField(Dimension::Id::X, id, x[i]);
+            outView->setField(Dimension::Id::Y, id, y[i]);
+            outView->setField(Dimension::Id::Z, id, z[i]);
+        }
     }
 
     viewSet.insert(outView);
@@ -58,6 +58,8 @@ private:
 
     virtual void addArgs(ProgramArgs& args);
     virtual void initialize();
+    virtual bool usedDims(StringList& used) const;
+    virtual bool mutatedDims(StringList& dims) const;
     virtual PointViewSet run(PointViewPtr view);
     virtual bool processOne(PointRef& point);
     virtual void spatialReferenceChanged(const SpatialReference& srs);
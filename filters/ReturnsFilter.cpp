@@ -97,21 +97,62 @@ PointViewSet ReturnsFilter::run(PointViewPtr inView)
     PointViewPtr lastView = inView->makeNew();
     PointViewPtr onlyView = inView->makeNew();
 
-    for (PointId idx = 0; idx < inView->size(); idx++)
+    // Returns come in runs - ordered LAS interleaves first/last pairs
+    // and single-return stretches - so classify batched return arrays
+    // and append each run to its view with one index operation rather
+    // than one appendPoint() per point.
+    PointViewPtr groupViews[] =
+        { firstView, intermediateView, lastView, onlyView };
+    PointId runStart[4];
+    bool inRun[4] = { false, false, false, false };
+
+    point_count_t np = inView->size();
+    const point_count_t BatchSize = 4096;
+    std::vector<uint8_t> rns(BatchSize);
+    std::vector<uint8_t> nrs(BatchSize);
+    for (PointId s = 0; s < np; s += BatchSize)
     {
-        PointRef p = inView->point(idx);
-        uint8_t rn = p.getFieldAs<uint8_t>(Dimension::Id::ReturnNumber);
-        uint8_t nr = p.getFieldAs<uint8_t>(Dimension::Id::NumberOfReturns);
-        if ((m_outputTypes & returnFirst) && (rn == 1) && (nr > 1))
-            firstView->appendPoint(*inView.get(), idx);
-        if ((m_outputTypes & returnIntermediate) && (rn > 1) && (rn < nr) &&
-            (nr > 2))
-            intermediateView->appendPoint(*inView.get(), idx);
-        if ((m_outputTypes & returnLast) && (rn == nr) && (nr > 1))
-            lastView->appendPoint(*inView.get(), idx);
-        if ((m_outputTypes & returnOnly) && (nr == 1))
-            onlyView->appendPoint(*inView.get(), idx);
+        point_count_t n = (std::min)(BatchSize, (point_count_t)(np - s));
+        inView->getFieldBatch(Dimension::Id::ReturnNumber, s, n, rns.data());
+        inView->getFieldBatch(Dimension::Id::NumberOfReturns, s, n,
+            nrs.data());
+        for (point_count_t i = 0; i < n; ++i)
+        {
+            uint8_t rn = rns[i];
+            uint8_t nr = nrs[i];
+            int types = 0;
+            if ((rn == 1) && (nr > 1))
+                types |= returnFirst;
+            if ((rn > 1) && (rn < nr) && (nr > 2))
+                types |= returnIntermediate;
+            if ((rn == nr) && (nr > 1))
+                types |= returnLast;
+            if (nr == 1)
+                types |= returnOnly;
+            types &= m_outputTypes;
+
+            PointId idx = s + i;
+            for (int g = 0; g < 4; ++g)
+            {
+                bool want = types & (1 << g);
+                if (want && !inRun[g])
+                {
+                    runStart[g] = idx;
+                    inRun[g] = true;
+                }
+                else if (!want && inRun[g])
+                {
+                    groupViews[g]->appendRange(*inView, runStart[g],
+                        idx - runStart[g]);
+                    inRun[g] = false;
+                }
+            }
+        }
     }
+    for (int g = 0; g < 4; ++g)
+        if (inRun[g])
+            groupViews[g]->appendRange(*inView, runStart[g],
+                np - runStart[g]);
 
     if (m_outputTypes & returnFirst)
     {
@@ -43,6 +43,7 @@
 #include <pdal/KDIndex.hpp>
 #include <pdal/util/FileUtils.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "private/DimRange.hpp"
 #include "private/Segmentation.hpp"
@@ -55,6 +56,7 @@
 #include <limits>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace pdal
@@ -91,6 +93,7 @@ struct SMRArgs
     std::vector<DimRange> m_ignored;
     StringList m_returns;
     StringList m_classbits;
+    size_t m_threads;
 };
 
 SMRFilter::SMRFilter() : m_args(new SMRArgs) {}
@@ -116,6 +119,13 @@ void SMRFilter::addArgs(ProgramArgs& args)
              {"last", "only"});
     args.add("classbits", "Ignore synthetic|keypoint|withheld classification bits?",
              m_args->m_classbits, {""});
+    args.add("threads", "Number of threads used for the raster passes (0 = "
+        "choose automatically)", m_args->m_threads);
+}
+
+size_t SMRFilter::threadCount(size_t n) const
+{
+    return pdal::threadCount(m_args->m_threads, n);
 }
 
 void SMRFilter::addDimensions(PointLayoutPtr layout)
@@ -339,41 +349,56 @@ void SMRFilter::classifyGround(PointViewPtr view, std::vector<double>& ZIpro)
         }
     }
 
-    for (PointId i = 0; i < view->size(); ++i)
-    {
-        double x = view->getFieldAs<double>(Id::X, i);
-        double y = view->getFieldAs<double>(Id::Y, i);
-        double z = view->getFieldAs<double>(Id::Z, i);
-
-        size_t c =
-            static_cast<size_t>(std::floor(x - m_bounds.minx) / m_args->m_cell);
-        size_t r =
-            static_cast<size_t>(std::floor(y - m_bounds.miny) / m_args->m_cell);
-
-        // TODO(chambbj): We don't quite do this by the book and yet it seems to
-        // work reasonably well:
-        // "The calculation requires that both elevation and slope are
-        // interpolated from the provisional DEM. There are any number of
-        // interpolation techniques that might be used, and even nearest
-        // neighbor approaches work quite well, so long as the cell size of the
-        // DEM nearly corresponds to the resolution of the LIDAR data. Based on
-        // these results, we find that a splined cubic interpolation provides
-        // the best results."
-        if (std::isnan(ZIpro[c * m_rows + r]))
-            continue;
-
-        if (std::isnan(gsurfs(r, c)))
-            continue;
-
-        // "The final step of the algorithm is the identification of
-        // ground/object LIDAR points. This is accomplished by measuring the
-        // vertical distance between each LIDAR point and the provisional
-        // DEM, and applying a threshold calculation."
-        if (std::fabs(ZIpro[c * m_rows + r] - z) > thresh(r, c))
-            view->setField(Id::Classification, i, ClassLabel::Unclassified);
-        else
-            view->setField(Id::Classification, i, ClassLabel::Ground);
-    }
+    // Each point is tested independently against the provisional DEM, so
+    // slices of the view are processed on separate threads.
+    point_count_t np = view->size();
+    size_t threads = threadCount(np);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&, t]()
+        {
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            for (PointId i = start; i < end; ++i)
+            {
+                double x = view->getFieldAs<double>(Id::X, i);
+                double y = view->getFieldAs<double>(Id::Y, i);
+                double z = view->getFieldAs<double>(Id::Z, i);
+
+                size_t c = static_cast<size_t>(
+                    std::floor(x - m_bounds.minx) / m_args->m_cell);
+                size_t r = static_cast<size_t>(
+                    std::floor(y - m_bounds.miny) / m_args->m_cell);
+
+                // TODO(chambbj): We don't quite do this by the book and yet
+                // it seems to work reasonably well:
+                // "The calculation requires that both elevation and slope are
+                // interpolated from the provisional DEM. There are any number
+                // of interpolation techniques that might be used, and even
+                // nearest neighbor approaches work quite well, so long as the
+                // cell size of the DEM nearly corresponds to the resolution
+                // of the LIDAR data. Based on these results, we find that a
+                // splined cubic interpolation provides the best results."
+                if (std::isnan(ZIpro[c * m_rows + r]))
+                    continue;
+
+                if (std::isnan(gsurfs(r, c)))
+                    continue;
+
+                // "The final step of the algorithm is the identification of
+                // ground/object LIDAR points. This is accomplished by
+                // measuring the vertical distance between each LIDAR point
+                // and the provisional DEM, and applying a threshold
+                // calculation."
+                if (std::fabs(ZIpro[c * m_rows + r] - z) > thresh(r, c))
+                    view->setField(Id::Classification, i,
+                                   ClassLabel::Unclassified);
+                else
+                    view->setField(Id::Classification, i, ClassLabel::Ground);
+            }
+        });
+    for (auto& t : pool)
+        t.join();
 }
 
 std::vector<int> SMRFilter::createLowMask(std::vector<double> const& ZImin)
@@ -511,10 +536,8 @@ std::vector<double> SMRFilter::createZInet(std::vector<double> const& ZImin,
     if (m_args->m_cut > 0.0)
     {
         int v = ceil<int>(m_args->m_cut / m_args->m_cell);
-        std::vector<double> bigErode =
-            erodeDiamond(ZImin, m_rows, m_cols, 2 * v);
         std::vector<double> bigOpen =
-            dilateDiamond(bigErode, m_rows, m_cols, 2 * v);
+            openDiamond(ZImin, m_rows, m_cols, 2 * v);
         for (auto c = 0; c < m_cols; ++c)
         {
             for (auto r = 0; r < m_rows; ++r)
@@ -603,34 +626,45 @@ std::vector<double> SMRFilter::knnfill(PointViewPtr view,
 
     // Where the raster has voids (i.e., NaN), we search for that cell's eight
     // nearest neighbors, and fill the void with the average value of the
-    // neighbors.
+    // neighbors.  Each void is filled independently, so blocks of columns are
+    // processed on separate threads, each with its own query buffers.
     std::vector<double> out = cz;
-    for (int c = 0; c < m_cols; ++c)
-    {
-        for (int r = 0; r < m_rows; ++r)
+    size_t threads = threadCount(size_t(m_rows) * size_t(m_cols));
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&, t]()
         {
-            if (!std::isnan(out[c * m_rows + r]))
-                continue;
-
-            double x = m_bounds.minx + (c + 0.5) * m_args->m_cell;
-            double y = m_bounds.miny + (r + 0.5) * m_args->m_cell;
             int k = 8;
             PointIdList neighbors(k);
             std::vector<double> sqr_dists(k);
-            kdi.knnSearch(x, y, k, &neighbors, &sqr_dists);
-
-            double M1(0.0);
-            size_t j(0);
-            for (auto const& n : neighbors)
+            int c1 = static_cast<int>(m_cols * t / threads);
+            int c2 = static_cast<int>(m_cols * (t + 1) / threads);
+            for (int c = c1; c < c2; ++c)
             {
-                j++;
-                double delta = temp->getFieldAs<double>(Id::Z, n) - M1;
-                M1 += (delta / j);
+                for (int r = 0; r < m_rows; ++r)
+                {
+                    if (!std::isnan(out[c * m_rows + r]))
+                        continue;
+
+                    double x = m_bounds.minx + (c + 0.5) * m_args->m_cell;
+                    double y = m_bounds.miny + (r + 0.5) * m_args->m_cell;
+                    kdi.knnSearch(x, y, k, &neighbors, &sqr_dists);
+
+                    double M1(0.0);
+                    size_t j(0);
+                    for (auto const& n : neighbors)
+                    {
+                        j++;
+                        double delta = temp->getFieldAs<double>(Id::Z, n) - M1;
+                        M1 += (delta / j);
+                    }
+
+                    out[c * m_rows + r] = M1;
+                }
             }
-
-            out[c * m_rows + r] = M1;
-        }
-    }
+        });
+    for (auto& t : pool)
+        t.join();
 
     return out;
 }
@@ -657,11 +691,9 @@ std::vector<int> SMRFilter::progressiveFilter(std::vector<double> const& ZImin,
     {
         // "On the first iteration, the minimum surface (ZImin) is opened using
         // a disk-shaped structuring element with a radius of one pixel."
-        std::vector<double> curErosion =
-            erodeDiamond(prevErosion, m_rows, m_cols, 1);
+        prevErosion = erodeDiamond(std::move(prevErosion), m_rows, m_cols, 1);
         std::vector<double> curOpening =
-            dilateDiamond(curErosion, m_rows, m_cols, radius);
-        prevErosion = curErosion;
+            dilateDiamond(prevErosion, m_rows, m_cols, radius);
 
         // "An elevation threshold is then calculated, where the value is equal
         // to the supplied slope tolerance parameter multiplied by the product
@@ -671,29 +703,41 @@ std::vector<int> SMRFilter::progressiveFilter(std::vector<double> const& ZImin,
         // "This elevation threshold is applied to the difference of the minimum
         // and the opened surfaces."
 
-        // Need to provide means of diffing two vectors.
-        std::vector<double> diff;
-        std::transform(prevSurface.begin(), prevSurface.end(),
-                       curOpening.begin(), std::back_inserter(diff),
-                       [&](double l, double r) { return std::fabs(l - r); });
-
         // "Any grid cell with a difference value exceeding the calculated
         // elevation threshold for the iteration is then flagged as an OBJ
         // cell."
-        std::vector<int> foo;
-        std::transform(diff.begin(), diff.end(), std::back_inserter(foo),
-                       [threshold](double x) {
-                           return (x > threshold) ? int(1) : int(0);
-                       });
-        std::transform(Obj.begin(), Obj.end(), foo.begin(), Obj.begin(),
-                       [](int a, int b) { return (std::max)(a, b); });
+
+        // The differencing, thresholding and mask update are fused into a
+        // single streaming pass over the raster - no temporary vectors - and
+        // sliced across threads, each of which also tallies its flagged cells.
+        size_t n = Obj.size();
+        size_t threads = threadCount(n);
+        std::vector<size_t> flagged(threads, 0);
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t)
+            pool.emplace_back([&, t]()
+            {
+                size_t count = 0;
+                size_t i1 = n * t / threads;
+                size_t i2 = n * (t + 1) / threads;
+                for (size_t i = i1; i < i2; ++i)
+                {
+                    if (std::fabs(prevSurface[i] - curOpening[i]) > threshold)
+                        Obj[i] = 1;
+                    count += Obj[i];
+                }
+                flagged[t] = count;
+            });
+        for (auto& t : pool)
+            t.join();
 
         // "The algorithm then proceeds to the next window radius (up to the
         // maximum), and proceeds as above with the last opened surface acting
         // as the minimum surface for the next difference calculation."
-        prevSurface = curOpening;
+        prevSurface = std::move(curOpening);
 
-        size_t ng = std::count(Obj.begin(), Obj.end(), 1);
+        size_t ng =
+            std::accumulate(flagged.begin(), flagged.end(), size_t(0));
         size_t g(Obj.size() - ng);
         double p(100.0 * double(ng) / double(Obj.size()));
         log()->floatPrecision(2);
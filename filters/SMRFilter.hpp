@@ -65,6 +65,7 @@ private:
     virtual void ready(PointTableRef table);
     virtual PointViewSet run(PointViewPtr view);
 
+    size_t threadCount(size_t n) const;
     void classifyGround(PointViewPtr, std::vector<double>&);
     std::vector<int> createLowMask(std::vector<double> const&);
     std::vector<int> createNetMask();
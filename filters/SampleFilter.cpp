@@ -34,11 +34,15 @@
 
 #include "SampleFilter.hpp"
 
-#include <pdal/KDIndex.hpp>
+#include <pdal/GridIndex.hpp>
+#include <pdal/util/FileUtils.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 #include <pdal/util/Utils.hpp>
 
+#include <cmath>
+#include <fstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace pdal
@@ -62,6 +66,9 @@ std::string SampleFilter::getName() const
 void SampleFilter::addArgs(ProgramArgs& args)
 {
     args.add("radius", "Radius", m_radius, 1.0);
+    args.add("cache_size", "Maximum number of kept points held in memory "
+        "in stream mode before cold regions spill to disk (0 = no limit)",
+        m_cacheSize, (point_count_t)0);
 }
 
 
@@ -71,6 +78,255 @@ void SampleFilter::addDimensions(PointLayoutPtr layout)
 }
 
 
+namespace
+{
+
+// Mix the integer cell coordinates into a key for the grid map.  A
+// collision only merges two far-apart cells into one bucket; the
+// distance test still decides what gets masked.
+uint64_t cellHash(int64_t cx, int64_t cy, int64_t cz)
+{
+    uint64_t h(0xcbf29ce484222325ULL);
+    for (int64_t c : { cx, cy, cz })
+    {
+        uint64_t x = (uint64_t)c * 0x9e3779b97f4a7c15ULL;
+        x ^= x >> 32;
+        h = (h ^ x) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+} // unnamed namespace
+
+
+// Occupancy of the points kept so far, for stream mode.  Cells are
+// radius-sized so a candidate only tests the 27 cells around its own,
+// and cells are grouped into tiles so that, when the kept set outgrows
+// the cache budget, the least recently touched tiles can spill to a
+// scratch file and reload if a later point wanders back.  For the
+// spatially sorted or tiled input that makes one-pass thinning
+// sensible, reloads are rare and memory stays bounded by the budget;
+// arrival in any other order is still correct, just slower.
+struct SampleFilter::Occupancy
+{
+    // Cells per tile axis; a power of two so the arithmetic shift
+    // gives the floor for negative cell coordinates.
+    static const int TileShift = 4;
+
+    struct Coord
+    {
+        double m_x;
+        double m_y;
+        double m_z;
+    };
+
+    // Kept points of one tile, bucketed by the mixed cell hash.  As in
+    // the batch path, a hash collision only merges two far-apart cells
+    // into one bucket; the distance test still decides what is masked.
+    struct Tile
+    {
+        std::unordered_map<uint64_t, std::vector<Coord>> m_cells;
+        // Kept points in the tile, resident or not.
+        size_t m_count = 0;
+        uint64_t m_lastUse = 0;
+        bool m_resident = true;
+        // Position of the spilled image in the scratch file.
+        std::streamoff m_spillPos = -1;
+        uint64_t m_spillCells = 0;
+    };
+
+    Occupancy(double radius, point_count_t cacheSize) :
+        m_radius(radius), m_r2(radius * radius), m_cacheSize(cacheSize),
+        m_resident(0), m_clock(0), m_spills(0), m_reloads(0)
+    {}
+
+    ~Occupancy()
+    {
+        if (m_file.is_open())
+        {
+            m_file.close();
+            FileUtils::deleteFile(m_path);
+        }
+    }
+
+    // True if no kept point lies within the radius of (x, y, z); the
+    // point then joins the occupancy.
+    bool examine(double x, double y, double z)
+    {
+        int64_t cx = (int64_t)std::floor(x / m_radius);
+        int64_t cy = (int64_t)std::floor(y / m_radius);
+        int64_t cz = (int64_t)std::floor(z / m_radius);
+
+        for (int64_t dx = -1; dx <= 1; ++dx)
+        for (int64_t dy = -1; dy <= 1; ++dy)
+        for (int64_t dz = -1; dz <= 1; ++dz)
+        {
+            Tile& tile = fetch(cx + dx, cy + dy, cz + dz);
+            auto it = tile.m_cells.find(
+                cellHash(cx + dx, cy + dy, cz + dz));
+            if (it == tile.m_cells.end())
+                continue;
+            for (const Coord& c : it->second)
+            {
+                double ddx = c.m_x - x;
+                double ddy = c.m_y - y;
+                double ddz = c.m_z - z;
+                if (ddx * ddx + ddy * ddy + ddz * ddz < m_r2)
+                    return false;
+            }
+        }
+
+        Tile& home = fetch(cx, cy, cz);
+        home.m_cells[cellHash(cx, cy, cz)].push_back(Coord { x, y, z });
+        home.m_count++;
+        m_resident++;
+        if (m_cacheSize && m_resident > m_cacheSize)
+            evict();
+        return true;
+    }
+
+private:
+    // The tile holding the given cell, loaded back in if it spilled.
+    Tile& fetch(int64_t cx, int64_t cy, int64_t cz)
+    {
+        Tile& tile = m_tiles[cellHash(cx >> TileShift, cy >> TileShift,
+            cz >> TileShift)];
+        tile.m_lastUse = ++m_clock;
+        if (!tile.m_resident)
+            load(tile);
+        return tile;
+    }
+
+    // Spill least recently touched tiles until well under the budget,
+    // so evictions batch up instead of triggering on every point.
+    void evict()
+    {
+        size_t target = m_cacheSize - m_cacheSize / 8;
+        while (m_resident > target)
+        {
+            Tile *victim = nullptr;
+            for (auto& t : m_tiles)
+                if (t.second.m_resident && t.second.m_count &&
+                    (!victim || t.second.m_lastUse < victim->m_lastUse))
+                    victim = &t.second;
+            // Never spill the tile just touched - with a single
+            // populated tile the budget can't be met.
+            if (!victim || victim->m_lastUse == m_clock)
+                break;
+            spill(*victim);
+        }
+    }
+
+    // The scratch file is written and read back within one run, so
+    // records are raw native structs.  A respilled tile appends a new
+    // image and leaks its old one - acceptable for a temporary file
+    // that is deleted when the filter is done.
+    void spill(Tile& tile)
+    {
+        if (!m_file.is_open())
+        {
+            m_path = FileUtils::temporaryFilename("pdal_sample");
+            m_file.open(m_path, std::ios::in | std::ios::out |
+                std::ios::binary | std::ios::trunc);
+            if (!m_file)
+                throw pdal_error("filters.sample: can't create occupancy "
+                    "scratch file '" + m_path + "'.");
+        }
+        m_file.seekp(0, std::ios::end);
+        tile.m_spillPos = m_file.tellp();
+        tile.m_spillCells = tile.m_cells.size();
+        for (const auto& cell : tile.m_cells)
+        {
+            uint64_t key = cell.first;
+            uint64_t count = cell.second.size();
+            m_file.write((const char *)&key, sizeof(key));
+            m_file.write((const char *)&count, sizeof(count));
+            m_file.write((const char *)cell.second.data(),
+                count * sizeof(Coord));
+        }
+        if (!m_file)
+            throw pdal_error("filters.sample: failure writing occupancy "
+                "scratch file '" + m_path + "'.");
+        tile.m_cells.clear();
+        tile.m_resident = false;
+        m_resident -= tile.m_count;
+        m_spills++;
+    }
+
+    void load(Tile& tile)
+    {
+        m_file.seekg(tile.m_spillPos);
+        tile.m_cells.reserve(tile.m_spillCells);
+        for (uint64_t i = 0; i < tile.m_spillCells; ++i)
+        {
+            uint64_t key;
+            uint64_t count;
+            m_file.read((char *)&key, sizeof(key));
+            m_file.read((char *)&count, sizeof(count));
+            std::vector<Coord>& bucket = tile.m_cells[key];
+            bucket.resize(count);
+            m_file.read((char *)bucket.data(), count * sizeof(Coord));
+        }
+        if (!m_file)
+            throw pdal_error("filters.sample: failure reading occupancy "
+                "scratch file '" + m_path + "'.");
+        tile.m_resident = true;
+        m_resident += tile.m_count;
+        m_reloads++;
+        if (m_cacheSize && m_resident > m_cacheSize)
+            evict();
+    }
+
+    double m_radius;
+    double m_r2;
+    point_count_t m_cacheSize;
+    // Kept points currently held in memory.
+    size_t m_resident;
+    uint64_t m_clock;
+    // Tiles keyed by the mixed hash of their tile coordinates.
+    std::unordered_map<uint64_t, Tile> m_tiles;
+    std::string m_path;
+    std::fstream m_file;
+
+public:
+    uint64_t m_spills;
+    uint64_t m_reloads;
+};
+
+
+SampleFilter::SampleFilter() : Filter()
+{}
+
+
+SampleFilter::~SampleFilter()
+{}
+
+
+void SampleFilter::ready(PointTableRef)
+{
+    m_occupancy.reset(new Occupancy(m_radius, m_cacheSize));
+}
+
+
+bool SampleFilter::processOne(PointRef& point)
+{
+    double x = point.getFieldAs<double>(Dimension::Id::X);
+    double y = point.getFieldAs<double>(Dimension::Id::Y);
+    double z = point.getFieldAs<double>(Dimension::Id::Z);
+    return m_occupancy->examine(x, y, z);
+}
+
+
+void SampleFilter::done(PointTableRef)
+{
+    if (m_occupancy->m_spills)
+        log()->get(LogLevel::Debug2)
+            << "Occupancy spilled " << m_occupancy->m_spills
+            << " tiles, reloaded " << m_occupancy->m_reloads << "\n";
+    m_occupancy.reset();
+}
+
+
 PointViewSet SampleFilter::run(PointViewPtr inView)
 {
     point_count_t np = inView->size();
@@ -82,12 +338,17 @@ PointViewSet SampleFilter::run(PointViewPtr inView)
         return viewSet;
     PointViewPtr outView = inView->makeNew();
 
-    // Build the 3D KD-tree.
-    KD3Index& index = inView->build3dIndex();
+    // Bin the points on a grid with cell size equal to the radius, so
+    // masking a kept point's neighborhood only has to scan the cells
+    // covering the radius.  The index is shared through the table's
+    // ArtifactManager, so when an earlier fixed-radius stage already
+    // built occupancy at this radius the binning pass is skipped.
+    Grid3Index& index = OccupancyArtifact::obtain(*inView, m_radius);
 
     // All points are marked as kept (1) by default. As they are masked by
     // neighbors within the user-specified radius, their value is changed to 0.
     std::vector<int> keep(np, 1);
+    double r2 = m_radius * m_radius;
 
     // We are able to subsample in a single pass over the shuffled indices.
     for (PointId i = 0; i < np; ++i)
@@ -100,10 +361,16 @@ PointViewSet SampleFilter::run(PointViewPtr inView)
         outView->appendPoint(*inView, i);
 
         // We now proceed to mask all neighbors within m_radius of the kept
-        // point.
-        auto ids = index.radius(i, m_radius);
-        for (auto const& id : ids)
-            keep[id] = 0;
+        // point.  The KD radius query this replaces used a strict bound.
+        double x = inView->getFieldAs<double>(Dimension::Id::X, i);
+        double y = inView->getFieldAs<double>(Dimension::Id::Y, i);
+        double z = inView->getFieldAs<double>(Dimension::Id::Z, i);
+        index.candidates(x, y, z, m_radius,
+            [&keep, r2](double d2, PointId q)
+            {
+                if (d2 < r2)
+                    keep[q] = 0;
+            });
     }
 
     // Simply calculate the percentage of retained points.
@@ -35,7 +35,9 @@
 #pragma once
 
 #include <pdal/Filter.hpp>
+#include <pdal/Streamable.hpp>
 
+#include <memory>
 #include <string>
 
 namespace pdal
@@ -43,22 +45,31 @@ namespace pdal
 
 class Options;
 
-class PDAL_DLL SampleFilter : public pdal::Filter
+class PDAL_DLL SampleFilter : public Filter, public Streamable
 {
 public:
-    SampleFilter() : Filter()
-    {}
+    SampleFilter();
+    ~SampleFilter();
     SampleFilter& operator=(const SampleFilter&) = delete;
     SampleFilter(const SampleFilter&) = delete;
 
     std::string getName() const;
 
 private:
+    // Sparse occupancy of the points kept so far, used in stream mode
+    // and spillable to disk tile by tile (see the .cpp).
+    struct Occupancy;
+
     double m_radius;
+    point_count_t m_cacheSize;
+    std::unique_ptr<Occupancy> m_occupancy;
 
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void addArgs(ProgramArgs& args);
+    virtual void ready(PointTableRef table);
     virtual PointViewSet run(PointViewPtr view);
+    virtual bool processOne(PointRef& point);
+    virtual void done(PointTableRef table);
 };
 
 } // namespace pdal
@@ -73,20 +73,36 @@ PointViewSet SeparateScanLineFilter::run(PointViewPtr inView)
     PointViewPtr v(inView->makeNew());
     result.insert(v);
     
+    // Scan lines are runs of consecutive points ended by a point with
+    // EdgeOfFlightLine set, so scan batched edge flags for group
+    // boundaries and append whole runs instead of single points.
     uint64_t lineNum = 1;
-    for (PointId i = 0; i < inView->size();++i)
+    point_count_t np = inView->size();
+    PointId runStart = 0;
+    const point_count_t BatchSize = 4096;
+    std::vector<uint8_t> edges(BatchSize);
+    for (PointId s = 0; s < np; s += BatchSize)
     {
-        v->appendPoint(*inView, i);
-        if (inView->getFieldAs<uint8_t>(Dimension::Id::EdgeOfFlightLine, i))
+        point_count_t n = (std::min)(BatchSize, (point_count_t)(np - s));
+        inView->getFieldBatch(Dimension::Id::EdgeOfFlightLine, s, n,
+            edges.data());
+        for (point_count_t i = 0; i < n; ++i)
         {
+            if (!edges[i])
+                continue;
             if (++lineNum > m_groupBy)
             {
+                // The run through this edge point completes the group.
+                v->appendRange(*inView, runStart, s + i + 1 - runStart);
+                runStart = s + i + 1;
                 v = inView->makeNew();
                 result.insert(v);
                 lineNum = 1;
             }
         }
     }
+    if (runStart < np)
+        v->appendRange(*inView, runStart, np - runStart);
     //if last point was an edge of flight line
     if (v->empty())
         result.erase(v);
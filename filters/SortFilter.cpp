@@ -34,6 +34,9 @@
 
 #include "SortFilter.hpp"
 
+#include <thread>
+#include <pdal/util/ThreadPool.hpp>
+
 namespace pdal
 {
 
@@ -54,6 +57,18 @@ void SortFilter::addArgs(ProgramArgs& args)
         setPositional();
     args.add("order", "Sort order ASC(ending) or DESC(ending)", m_order,
         SortOrder::ASC);
+    args.add("threads", "Number of threads used to sort (0 = choose "
+        "automatically)", m_threads);
+}
+
+bool SortFilter::usedDims(StringList& used) const
+{
+    // Called before options are parsed, so read the raw option.
+    StringList dims = m_options.getValues("dimension");
+    if (dims.empty())
+        return false;
+    used.insert(used.end(), dims.begin(), dims.end());
+    return true;
 }
 
 void SortFilter::prepared(PointTableRef table)
@@ -65,13 +80,112 @@ void SortFilter::prepared(PointTableRef table)
 
 void SortFilter::filter(PointView& view)
 {
-    auto cmp = [this](const PointRef& p1, const PointRef& p2)
+    point_count_t n = view.size();
+    if (n < 2)
+        return;
+
+    // 64-bit integer keys can't be held exactly in a double - sort
+    // those through the view iterators as before.
+    Dimension::Type type = view.layout()->dimType(m_dim);
+    if (Dimension::size(type) == sizeof(double) &&
+        Dimension::base(type) != Dimension::BaseType::Floating)
     {
-        bool result = p1.compare(m_dim, p2);
-        return (m_order == SortOrder::ASC) ? result : !result;
+        auto cmp = [this](const PointRef& p1, const PointRef& p2)
+        {
+            bool result = p1.compare(m_dim, p2);
+            return (m_order == SortOrder::ASC) ? result : !result;
+        };
+        std::stable_sort(view.begin(), view.end(), cmp);
+        return;
+    }
+
+    // Fetching the key dimension at every comparison dominates the
+    // sort.  Extract each key once, sort a (key, position) decoration -
+    // in parallel when the view is large - and apply the resulting
+    // permutation to the view.
+    using KeyIdx = std::pair<double, PointId>;
+    std::vector<KeyIdx> keys(n);
+    for (PointId i = 0; i < n; ++i)
+        keys[i] = { view.getFieldAs<double>(m_dim, i), i };
+
+    auto cmp = [this](const KeyIdx& k1, const KeyIdx& k2)
+    {
+        if (k1.first < k2.first)
+            return m_order == SortOrder::ASC;
+        if (k2.first < k1.first)
+            return m_order != SortOrder::ASC;
+        // Ties keep their original order.
+        return k1.second < k2.second;
     };
 
-    std::stable_sort(view.begin(), view.end(), cmp);
+    size_t threads = pdal::threadCount(m_threads, n);
+    threads = (std::min)(threads, (size_t)(n / 2));
+
+    if (threads < 2)
+        std::sort(keys.begin(), keys.end(), cmp);
+    else
+    {
+        // Sort a chunk per thread, then merge pairs of adjacent runs,
+        // halving the run count each round.
+        std::vector<size_t> offsets;
+        size_t chunk = keys.size() / threads;
+        for (size_t t = 0; t < threads; ++t)
+            offsets.push_back(t * chunk);
+        offsets.push_back(keys.size());
+
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t)
+            pool.emplace_back([&keys, &offsets, t, cmp]()
+            {
+                std::sort(keys.begin() + offsets[t],
+                    keys.begin() + offsets[t + 1], cmp);
+            });
+        for (auto& t : pool)
+            t.join();
+
+        while (offsets.size() > 2)
+        {
+            pool.clear();
+            for (size_t i = 0; i + 2 < offsets.size(); i += 2)
+                pool.emplace_back([&keys, &offsets, i, cmp]()
+                {
+                    std::inplace_merge(keys.begin() + offsets[i],
+                        keys.begin() + offsets[i + 1],
+                        keys.begin() + offsets[i + 2], cmp);
+                });
+            for (auto& t : pool)
+                t.join();
+
+            std::vector<size_t> next;
+            for (size_t i = 0; i < offsets.size(); i += 2)
+                next.push_back(offsets[i]);
+            if (next.back() != offsets.back())
+                next.push_back(offsets.back());
+            offsets = next;
+        }
+    }
+
+    // keys[k].second is the position whose point belongs at position k.
+    // Apply the permutation cycle by cycle with a single temporary.
+    std::vector<bool> placed(n, false);
+    for (PointId i = 0; i < n; ++i)
+    {
+        if (placed[i] || keys[i].second == i)
+            continue;
+        PointRef pi = view.point(i);
+        PointRef tmp(pi);   // Forces a temp copy of the point.
+        PointId dst = i;
+        PointId src = keys[dst].second;
+        while (src != i)
+        {
+            view.point(dst) = view.point(src);
+            placed[dst] = true;
+            dst = src;
+            src = keys[dst].second;
+        }
+        view.point(dst) = tmp;
+        placed[dst] = true;
+    }
 }
 
 std::istream& operator >> (std::istream& in, SortOrder& order)
@@ -67,9 +67,16 @@ private:
     // Sort order.
     SortOrder m_order;
 
+    // Number of sort threads (0 = choose automatically).
+    size_t m_threads;
+
     virtual void addArgs(ProgramArgs& args);
+    virtual bool usedDims(StringList& used) const;
     virtual void prepared(PointTableRef table);
     virtual void filter(PointView& view);
+    // Sorting rearranges only the view it was handed.
+    virtual bool concurrentViewSafe() const
+        { return true; }
 
     SortFilter& operator=(const SortFilter&) = delete;
     SortFilter(const SortFilter&) = delete;
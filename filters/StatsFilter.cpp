@@ -34,7 +34,9 @@
 
 #include "StatsFilter.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <unordered_map>
 
 #include <pdal/Options.hpp>
@@ -59,6 +61,320 @@ std::string StatsFilter::getName() const { return s_info.name; }
 namespace stats
 {
 
+void QuantileSketch::insert(const double *values, point_count_t cnt)
+{
+    m_buffer.insert(m_buffer.end(), values, values + cnt);
+    m_total += cnt;
+    if (m_buffer.size() >= m_bufferSize)
+        compress();
+}
+
+
+// Fold the buffered values into the centroid list.  Neighboring values
+// are merged when the k-scale function allows, which concentrates the
+// centroid budget near the tails of the distribution.
+void QuantileSketch::compress()
+{
+    if (m_buffer.empty())
+        return;
+
+    std::sort(m_buffer.begin(), m_buffer.end());
+
+    // Merge the sorted buffer and the existing centroids by mean.
+    std::vector<Centroid> in;
+    in.reserve(m_buffer.size() + m_centroids.size());
+    auto bi = m_buffer.begin();
+    auto ci = m_centroids.begin();
+    while (bi != m_buffer.end() || ci != m_centroids.end())
+    {
+        if (ci == m_centroids.end() ||
+            (bi != m_buffer.end() && *bi < ci->mean))
+            in.push_back({*bi++, 1.0});
+        else
+            in.push_back(*ci++);
+    }
+    m_buffer.clear();
+
+    const double pi(4 * std::atan(1.0));
+    auto k = [this, pi](double q)
+    {
+        return m_compression * std::asin(2 * q - 1) / (2 * pi);
+    };
+
+    std::vector<Centroid> out;
+    double wSoFar = 0;
+    double kLimit = k(0) + 1;
+    for (Centroid& c : in)
+    {
+        if (!out.empty() && k((wSoFar + out.back().weight + c.weight) /
+            m_total) <= kLimit)
+        {
+            Centroid& last = out.back();
+            last.mean += (c.mean - last.mean) * c.weight /
+                (last.weight + c.weight);
+            last.weight += c.weight;
+        }
+        else
+        {
+            if (!out.empty())
+                wSoFar += out.back().weight;
+            kLimit = k(wSoFar / m_total) + 1;
+            out.push_back(c);
+        }
+    }
+    m_centroids = std::move(out);
+}
+
+
+// Find the value at q of the total weight.  While every centroid is
+// still a single point this is an exact selection.  Once values have
+// been merged, interpolate between the means of neighboring centroids.
+double QuantileSketch::weightedQuantile(std::vector<Centroid>& centroids,
+    double q) const
+{
+    if (centroids.empty())
+        return 0.0;
+
+    double target = q * m_total;
+    if (centroids.size() == (size_t)m_total)
+    {
+        // All single values - select like nth_element would.
+        double cum = 0;
+        for (Centroid& c : centroids)
+        {
+            cum += c.weight;
+            if (cum > target)
+                return c.mean;
+        }
+        return centroids.back().mean;
+    }
+
+    // Treat each centroid's mass as centered on its mean and
+    // interpolate between adjacent centers.
+    double cum = 0;
+    for (size_t i = 0; i < centroids.size(); ++i)
+    {
+        double center = cum + centroids[i].weight / 2;
+        if (target <= center)
+        {
+            if (i == 0)
+                return centroids[i].mean;
+            double prev = cum - centroids[i - 1].weight / 2;
+            double t = (target - prev) / (center - prev);
+            return centroids[i - 1].mean +
+                t * (centroids[i].mean - centroids[i - 1].mean);
+        }
+        cum += centroids[i].weight;
+    }
+    return centroids.back().mean;
+}
+
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+    // Both centroid lists are kept sorted by mean, so a straight merge
+    // preserves the invariant compress() relies on.
+    std::vector<Centroid> merged;
+    merged.reserve(m_centroids.size() + other.m_centroids.size());
+    std::merge(m_centroids.begin(), m_centroids.end(),
+        other.m_centroids.begin(), other.m_centroids.end(),
+        std::back_inserter(merged),
+        [](const Centroid& a, const Centroid& b)
+        { return a.mean < b.mean; });
+    m_centroids = std::move(merged);
+
+    m_buffer.insert(m_buffer.end(), other.m_buffer.begin(),
+        other.m_buffer.end());
+    m_total += other.m_total;
+    if (m_buffer.size() >= m_bufferSize)
+        compress();
+}
+
+
+double QuantileSketch::quantile(double q)
+{
+    compress();
+    return weightedQuantile(m_centroids, q);
+}
+
+
+double QuantileSketch::quantileAbout(double center, double q)
+{
+    compress();
+
+    std::vector<Centroid> deviations(m_centroids);
+    for (Centroid& c : deviations)
+        c.mean = std::fabs(c.mean - center);
+    std::sort(deviations.begin(), deviations.end(),
+        [](const Centroid& a, const Centroid& b)
+        { return a.mean < b.mean; });
+    return weightedQuantile(deviations, q);
+}
+
+
+namespace
+{
+
+struct Moments
+{
+    point_count_t n = 0;
+    double m1 = 0.0;
+    double m2 = 0.0;
+    double m3 = 0.0;
+    double m4 = 0.0;
+};
+
+// Merge two sets of central moments (Pebay's pairwise update).  When
+// 'advanced' is false the third and fourth moments are left alone, just
+// as the scalar insert() leaves them at zero.
+void combine(Moments& a, const Moments& b, bool advanced)
+{
+    if (b.n == 0)
+        return;
+    if (a.n == 0)
+    {
+        a = b;
+        return;
+    }
+
+    double na(double(a.n));
+    double nb(double(b.n));
+    double n = na + nb;
+    double delta = b.m1 - a.m1;
+    double delta2 = delta * delta;
+
+    if (advanced)
+    {
+        a.m4 = a.m4 + b.m4 +
+            delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) /
+                (n * n * n) +
+            6 * delta2 * (na * na * b.m2 + nb * nb * a.m2) / (n * n) +
+            4 * delta * (na * b.m3 - nb * a.m3) / n;
+        a.m3 = a.m3 + b.m3 +
+            delta * delta2 * na * nb * (na - nb) / (n * n) +
+            3 * delta * (na * b.m2 - nb * a.m2) / n;
+    }
+    a.m2 = a.m2 + b.m2 + delta2 * na * nb / n;
+    a.m1 = a.m1 + delta * nb / n;
+    a.n = a.n + b.n;
+}
+
+// Run the Welford update in 'Lanes' independent accumulators striding
+// through the block, so the compiler can keep the lanes in SIMD
+// registers.
+template <bool Advanced>
+void accumulate(const double *values, point_count_t cnt, Moments *lanes)
+{
+    const int Lanes = 4;
+
+    point_count_t limit = cnt - (cnt % Lanes);
+    for (point_count_t i = 0; i < limit; i += Lanes)
+    {
+        for (int j = 0; j < Lanes; ++j)
+        {
+            Moments& l = lanes[j];
+            double value = values[i + j];
+
+            point_count_t n = ++l.n;
+            double delta = value - l.m1;
+            double delta_n = delta / n;
+            double term1 = delta * delta_n * (n - 1);
+
+            l.m1 += delta_n;
+            if (Advanced)
+            {
+                double delta_n2 = delta_n * delta_n;
+                l.m4 += term1 * delta_n2 * (n*n - 3*n + 3) +
+                    (6 * delta_n2 * l.m2) - (4 * delta_n * l.m3);
+                l.m3 += term1 * delta_n * (n - 2) - 3 * delta_n * l.m2;
+            }
+            l.m2 += term1;
+        }
+    }
+    for (point_count_t i = limit; i < cnt; ++i)
+    {
+        Moments& l = lanes[i - limit];
+        double value = values[i];
+
+        point_count_t n = ++l.n;
+        double delta = value - l.m1;
+        double delta_n = delta / n;
+        double term1 = delta * delta_n * (n - 1);
+
+        l.m1 += delta_n;
+        if (Advanced)
+        {
+            double delta_n2 = delta_n * delta_n;
+            l.m4 += term1 * delta_n2 * (n*n - 3*n + 3) +
+                (6 * delta_n2 * l.m2) - (4 * delta_n * l.m3);
+            l.m3 += term1 * delta_n * (n - 2) - 3 * delta_n * l.m2;
+        }
+        l.m2 += term1;
+    }
+}
+
+} // unnamed namespace
+
+
+void Summary::insert(const double *values, point_count_t cnt)
+{
+    if (cnt == 0)
+        return;
+
+    double lo = m_min;
+    double hi = m_max;
+    for (point_count_t i = 0; i < cnt; ++i)
+    {
+        lo = (std::min)(lo, values[i]);
+        hi = (std::max)(hi, values[i]);
+    }
+    m_min = lo;
+    m_max = hi;
+
+    if (m_enumerate != NoEnum)
+        for (point_count_t i = 0; i < cnt; ++i)
+            m_values[values[i]]++;
+    if (m_enumerate == Global)
+        m_quantiles.insert(values, cnt);
+
+    Moments lanes[4];
+    if (m_advanced)
+        accumulate<true>(values, cnt, lanes);
+    else
+        accumulate<false>(values, cnt, lanes);
+
+    Moments total { m_cnt, M1, M2, M3, M4 };
+    for (Moments& l : lanes)
+        combine(total, l, m_advanced);
+    m_cnt = total.n;
+    M1 = total.m1;
+    M2 = total.m2;
+    M3 = total.m3;
+    M4 = total.m4;
+}
+
+
+void Summary::merge(const Summary& other)
+{
+    m_min = (std::min)(m_min, other.m_min);
+    m_max = (std::max)(m_max, other.m_max);
+
+    if (m_enumerate != NoEnum)
+        for (auto& v : other.m_values)
+            m_values[v.first] += v.second;
+    if (m_enumerate == Global)
+        m_quantiles.merge(other.m_quantiles);
+
+    Moments total { m_cnt, M1, M2, M3, M4 };
+    Moments rhs { other.m_cnt, other.M1, other.M2, other.M3, other.M4 };
+    combine(total, rhs, m_advanced);
+    m_cnt = total.n;
+    M1 = total.m1;
+    M2 = total.m2;
+    M3 = total.m3;
+    M4 = total.m4;
+}
+
 
 void Summary::extractMetadata(MetadataNode &m)
 {
@@ -112,20 +428,9 @@ void Summary::extractMetadata(MetadataNode &m)
 
 void Summary::computeGlobalStats()
 {
-    auto compute_median = [](std::vector<double> vals)
-    {
-        std::nth_element(vals.begin(), vals.begin()+vals.size()/2, vals.end());
-
-        return *(vals.begin()+vals.size()/2);
-    };
-
     // TODO add quantiles
-    m_median = compute_median(m_data);
-    std::transform(m_data.begin(), m_data.end(), m_data.begin(),
-       [this](double v) { return std::fabs(v - this->m_median); });
-    m_mad = compute_median(m_data);
-
-
+    m_median = m_quantiles.quantile(.5);
+    m_mad = m_quantiles.quantileAbout(m_median, .5);
 }
 
 
@@ -147,11 +452,29 @@ bool StatsFilter::processOne(PointRef& point)
 
 void StatsFilter::filter(PointView& view)
 {
-    PointRef point(view, 0);
-    for (PointId idx = 0; idx < view.size(); ++idx)
+    // Fetch each dimension in batches - one virtual call per block
+    // rather than one per point per dimension.
+    const point_count_t BatchSize = 4096;
+    std::vector<double> vals(BatchSize);
+
+    for (auto p = m_stats.begin(); p != m_stats.end(); ++p)
     {
-        point.setPointId(idx);
-        processOne(point);
+        Dimension::Id d = p->first;
+        Summary& c = p->second;
+
+        // Accumulate into a partial private to this view run and fold
+        // it into the shared summary under the lock once per dimension,
+        // so concurrent view runs don't serialize on the accumulators.
+        Summary partial(c.name(), c.enumType(), m_advanced);
+        for (PointId start = 0; start < view.size(); start += BatchSize)
+        {
+            point_count_t n =
+                (std::min)((point_count_t)BatchSize, view.size() - start);
+            view.getFieldBatch(d, start, n, vals.data());
+            partial.insert(vals.data(), n);
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        c.merge(partial);
     }
 }
 
@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <pdal/Filter.hpp>
 #include <pdal/Streamable.hpp>
 
@@ -42,6 +44,61 @@ namespace pdal
 namespace stats
 {
 
+// Streaming quantile estimator in the style of a t-digest.  Values are
+// buffered and periodically folded into a bounded list of weighted
+// centroids, so memory use stays fixed no matter how many points are
+// inserted.  Until the first fold actually merges values the centroids
+// are all single points and quantiles are exact; beyond that they're
+// approximate, with the best resolution near the tails.
+class PDAL_DLL QuantileSketch
+{
+public:
+    QuantileSketch(size_t compression = 200) : m_compression(compression)
+    { reset(); }
+
+    void insert(double value)
+    {
+        m_buffer.push_back(value);
+        m_total++;
+        if (m_buffer.size() >= m_bufferSize)
+            compress();
+    }
+    void insert(const double *values, point_count_t cnt);
+
+    // Fold another sketch into this one.
+    void merge(const QuantileSketch& other);
+
+    // Return the approximate q-th quantile (q in [0, 1]).
+    double quantile(double q);
+    // Return the approximate q-th quantile of the absolute deviations
+    // from 'center'.  Used for the MAD.
+    double quantileAbout(double center, double q);
+
+    void reset()
+    {
+        m_total = 0;
+        m_bufferSize = 32 * m_compression;
+        m_buffer.clear();
+        m_centroids.clear();
+    }
+
+private:
+    struct Centroid
+    {
+        double mean;
+        double weight;
+    };
+
+    void compress();
+    double weightedQuantile(std::vector<Centroid>& centroids, double q) const;
+
+    size_t m_compression;
+    size_t m_bufferSize;
+    double m_total;
+    std::vector<double> m_buffer;
+    std::vector<Centroid> m_centroids;
+};
+
 class PDAL_DLL Summary
 {
 public:
@@ -54,7 +111,6 @@ public:
     };
 
 typedef std::map<double, point_count_t> EnumMap;
-typedef std::vector<double> DataVector;
 
 public:
     Summary(std::string name, EnumType enumerate, bool advanced = true) :
@@ -134,6 +190,8 @@ public:
         { return m_cnt; }
     std::string name() const
         { return m_name; }
+    EnumType enumType() const
+        { return m_enumerate; }
     const EnumMap& values() const
         { return m_values; }
 
@@ -148,6 +206,7 @@ public:
         m_median = 0.0;
         m_mad = 0.0;
         M1 = M2 = M3 = M4 = 0.0;
+        m_quantiles.reset();
     }
 
     void insert(double value)
@@ -159,11 +218,7 @@ public:
         if (m_enumerate != NoEnum)
             m_values[value]++;
         if (m_enumerate == Global)
-        {
-            if (m_data.capacity() - m_data.size() < 10000)
-                m_data.reserve(m_data.capacity() + m_cnt);
-            m_data.push_back(value);
-        }
+            m_quantiles.insert(value);
 
         // stolen from http://www.johndcook.com/blog/skewness_kurtosis/
 
@@ -192,6 +247,16 @@ public:
         M2 += term1;
     }
 
+    // Batch version of the above - accumulates the moments in several
+    // independent lanes so the loop vectorizes, then merges the lanes
+    // into the running state.
+    void insert(const double *values, point_count_t cnt);
+
+    // Fold an independently accumulated summary into this one.  Lets
+    // concurrent runs keep private partials and combine them afterwards
+    // instead of sharing one accumulator set.
+    void merge(const Summary& other);
+
 private:
     std::string m_name;
     EnumType m_enumerate;
@@ -201,7 +266,7 @@ private:
     double m_mad;
     double m_median;
     EnumMap m_values;
-    DataVector m_data;
+    QuantileSketch m_quantiles;
     point_count_t m_cnt;
     double M1, M2, M3, M4;
 };
@@ -229,6 +294,10 @@ private:
     virtual void prepared(PointTableRef table);
     virtual void done(PointTableRef table);
     virtual void filter(PointView& view);
+    // Each view run accumulates a private partial and folds it into
+    // m_stats under m_mutex, so runs may proceed concurrently.
+    virtual bool concurrentViewSafe() const
+        { return true; }
     void extractMetadata(PointTableRef table);
 
     StringList m_dimNames;
@@ -237,6 +306,8 @@ private:
     StringList m_global;
     bool m_advanced;
     std::map<Dimension::Id, stats::Summary> m_stats;
+    // Guards m_stats when concurrent view runs fold in their partials.
+    std::mutex m_mutex;
 };
 
 } // namespace pdal
@@ -33,10 +33,13 @@
 ****************************************************************************/
 
 #include "TransformationFilter.hpp"
+#include <pdal/BatchTransformBackend.hpp>
 #include <pdal/util/FileUtils.hpp>
 
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 namespace pdal
 {
@@ -186,11 +189,32 @@ void TransformationFilter::filter(PointView& view)
         log()->get(LogLevel::Warning) << getName() <<
             ": overriding input spatial reference." << std::endl;
 
-    PointRef point(view, 0);
-    for (PointId idx = 0; idx < view.size(); ++idx)
+    // Apply the matrix to blocks of points - the batch calls convert
+    // between storage type and double once per block instead of once per
+    // field, and the apply loop runs on the execution backend (the CPU
+    // vectorized loop by default, or an installed device backend).
+    double matrix[Transform::Size];
+    for (size_t i = 0; i < Transform::Size; ++i)
+        matrix[i] = (*m_matrix)[i];
+
+    BatchTransformBackend& backend = BatchTransformBackend::get();
+    const point_count_t batchSize = backend.batchSize();
+    std::vector<double> x(batchSize);
+    std::vector<double> y(batchSize);
+    std::vector<double> z(batchSize);
+
+    for (PointId start = 0; start < view.size(); start += batchSize)
     {
-        point.setPointId(idx);
-        processOne(point);
+        point_count_t n = (std::min)(batchSize, view.size() - start);
+        view.getFieldBatch(Dimension::Id::X, start, n, x.data());
+        view.getFieldBatch(Dimension::Id::Y, start, n, y.data());
+        view.getFieldBatch(Dimension::Id::Z, start, n, z.data());
+
+        backend.transform(matrix, x.data(), y.data(), z.data(), n);
+
+        view.setFieldBatch(Dimension::Id::X, start, n, x.data());
+        view.setFieldBatch(Dimension::Id::Y, start, n, y.data());
+        view.setFieldBatch(Dimension::Id::Z, start, n, z.data());
     }
     view.invalidateProducts();
 }
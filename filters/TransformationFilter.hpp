@@ -61,6 +61,8 @@ private:
     virtual void addArgs(ProgramArgs& args) override;
     virtual void initialize() override;
     virtual bool processOne(PointRef& point) override;
+    virtual bool fusable() const override
+        { return true; }
     virtual void filter(PointView& view) override;
     virtual void spatialReferenceChanged(const SpatialReference& srs) override;
 
@@ -36,11 +36,14 @@
 
 #include <pdal/KDIndex.hpp>
 
-#include <set>
+#include <algorithm>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "private/VoxelGrid.hpp"
+
 namespace pdal
 {
 
@@ -70,43 +73,47 @@ PointViewSet VoxelCenterNearestNeighborFilter::run(PointViewPtr view)
 
     // Find distance from voxel center to point.  If the distance is less
     // than previous (or is the first one for the voxel), store the
-    // point ID and distance.
-    std::map<std::tuple<size_t, size_t, size_t>,
-        std::tuple<PointId, double>> populated_voxels;
+    // point ID and distance.  The table is keyed (row, column, depth).
+    VoxelMap<std::tuple<PointId, double>> populated_voxels;
+    populated_voxels.reserve(view->size());
     for (PointId id = 0; id < view->size(); ++id)
     {
         double x = view->getFieldAs<double>(Dimension::Id::X, id);
         double y = view->getFieldAs<double>(Dimension::Id::Y, id);
         double z = view->getFieldAs<double>(Dimension::Id::Z, id);
-        size_t c = static_cast<size_t>((x - bounds.minx) / m_cell);
-        size_t r = static_cast<size_t>((y - bounds.miny) / m_cell);
-        size_t d = static_cast<size_t>((z - bounds.minz) / m_cell);
+        int c = static_cast<int>((x - bounds.minx) / m_cell);
+        int r = static_cast<int>((y - bounds.miny) / m_cell);
+        int d = static_cast<int>((z - bounds.minz) / m_cell);
         double xv = bounds.minx + (c + 0.5) * m_cell;
         double yv = bounds.miny + (r + 0.5) * m_cell;
         double zv = bounds.minz + (d + 0.5) * m_cell;
         double dist = pow(xv - x, 2) + pow(yv - y, 2) + pow(zv - z, 2);
 
-        auto t = std::make_tuple(r, c, d);
-        auto pi = populated_voxels.find(t);
-        if (pi == populated_voxels.end())
-            populated_voxels.insert(
-                std::make_pair(t, std::make_tuple(id, dist)));
+        bool inserted;
+        auto& t2 = populated_voxels.put(r, c, d, inserted);
+        if (inserted)
+            t2 = std::make_tuple(id, dist);
         else
         {
-            auto& t2 = pi->second;  // Get point/distance tuple.
             double curDist = std::get<1>(t2);
             if (dist < curDist)
                 t2 = std::make_tuple(id, dist);
         }
     }
 
-    // Append the ID of the point nearest the voxel center to the output view.
+    // Append the ID of the point nearest the voxel center to the output
+    // view, sorting the keys first to emit in the row/column/depth order
+    // the ordered map this table replaced provided.
+    std::vector<std::pair<voxel::Key, PointId>> kept;
+    kept.reserve(populated_voxels.size());
+    populated_voxels.visit([&kept](const voxel::Key& k,
+        const std::tuple<PointId, double>& t2)
+        { kept.push_back(std::make_pair(k, std::get<0>(t2))); });
+    std::sort(kept.begin(), kept.end());
+
     PointViewPtr output = view->makeNew();
-    for (auto const& t : populated_voxels)
-    {
-        auto& t2 = t.second; // Get point/distance tuple.
-        output->appendPoint(*view, std::get<0>(t2));
-    }
+    for (auto const& kv : kept)
+        output->appendPoint(*view, kv.second);
 
     PointViewSet viewSet;
     viewSet.insert(output);
@@ -36,13 +36,16 @@
 
 #include <pdal/EigenUtils.hpp>
 
-#include <map>
+#include <algorithm>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Dense>
 
+#include "private/VoxelGrid.hpp"
+
 namespace pdal
 {
 
@@ -73,56 +76,67 @@ PointViewSet VoxelCentroidNearestNeighborFilter::run(PointViewPtr view)
 
     // Make an initial pass through the input PointView to index PointIds by
     // row, column, and depth.
-    std::map<std::tuple<size_t, size_t, size_t>, PointIdList>
-        populated_voxel_ids;
+    VoxelMap<PointIdList> populated_voxel_ids;
+    populated_voxel_ids.reserve(view->size());
     for (PointId id = 0; id < view->size(); ++id)
     {
         double y = view->getFieldAs<double>(Dimension::Id::Y, id);
         double x = view->getFieldAs<double>(Dimension::Id::X, id);
         double z = view->getFieldAs<double>(Dimension::Id::Z, id);
-        size_t r = static_cast<size_t>((y - y0) / m_cell);
-        size_t c = static_cast<size_t>((x - x0) / m_cell);
-        size_t d = static_cast<size_t>((z - z0) / m_cell);
-        populated_voxel_ids[std::make_tuple(r, c, d)].push_back(id);
+        int r = static_cast<int>((y - y0) / m_cell);
+        int c = static_cast<int>((x - x0) / m_cell);
+        int d = static_cast<int>((z - z0) / m_cell);
+        bool inserted;
+        populated_voxel_ids.put(r, c, d, inserted).push_back(id);
     }
 
+    // Sort the keys so the output keeps the row/column/depth order the
+    // ordered map this table replaced provided.
+    std::vector<std::pair<voxel::Key, const PointIdList *>> voxels;
+    voxels.reserve(populated_voxel_ids.size());
+    populated_voxel_ids.visit([&voxels](const voxel::Key& k,
+        const PointIdList& ids)
+        { voxels.push_back(std::make_pair(k, &ids)); });
+    std::sort(voxels.begin(), voxels.end());
+
     // Make a second pass through the populated voxels to compute the voxel
     // centroid and to find its nearest neighbor.
     PointViewPtr output = view->makeNew();
-    for (auto const& t : populated_voxel_ids)
+    for (auto const& t : voxels)
     {
-        if (t.second.size() == 1)
+        const PointIdList& ids = *t.second;
+        if (ids.size() == 1)
         {
             // If there is only one point in the voxel, simply append it.
-            output->appendPoint(*view, t.second[0]);
+            output->appendPoint(*view, ids[0]);
         }
-        else if (t.second.size() == 2)
+        else if (ids.size() == 2)
         {
             // Else if there are only two, they are equidistant to the
             // centroid, so append the one closest to voxel center.
 
             // Compute voxel center.
-            double y_center = y0 + (std::get<0>(t.first) + 0.5) * m_cell;
-            double x_center = x0 + (std::get<1>(t.first) + 0.5) * m_cell;
-            double z_center = z0 + (std::get<2>(t.first) + 0.5) * m_cell;
+            double y_center = y0 + (t.first.coord[0] + 0.5) * m_cell;
+            double x_center = x0 + (t.first.coord[1] + 0.5) * m_cell;
+            double z_center = z0 + (t.first.coord[2] + 0.5) * m_cell;
 
             // Compute distance from first point to voxel center.
-            double x1 = view->getFieldAs<double>(Dimension::Id::X, t.second[0]);
-            double y1 = view->getFieldAs<double>(Dimension::Id::Y, t.second[0]);
-            double z1 = view->getFieldAs<double>(Dimension::Id::Z, t.second[0]);
+            double x1 = view->getFieldAs<double>(Dimension::Id::X, ids[0]);
+            double y1 = view->getFieldAs<double>(Dimension::Id::Y, ids[0]);
+            double z1 = view->getFieldAs<double>(Dimension::Id::Z, ids[0]);
             double d1 = pow(x_center - x1, 2) + pow(y_center - y1, 2) + pow(z_center - z1, 2);
 
             // Compute distance from second point to voxel center.
-            double x2 = view->getFieldAs<double>(Dimension::Id::X, t.second[1]);
-            double y2 = view->getFieldAs<double>(Dimension::Id::Y, t.second[1]);
-            double z2 = view->getFieldAs<double>(Dimension::Id::Z, t.second[1]);
+            double x2 = view->getFieldAs<double>(Dimension::Id::X, ids[1]);
+            double y2 = view->getFieldAs<double>(Dimension::Id::Y, ids[1]);
+            double z2 = view->getFieldAs<double>(Dimension::Id::Z, ids[1]);
             double d2 = pow(x_center - x2, 2) + pow(y_center - y2, 2) + pow(z_center - z2, 2);
 
             // Append the closer of the two.
             if (d1 < d2)
-                output->appendPoint(*view, t.second[0]);
+                output->appendPoint(*view, ids[0]);
             else
-                output->appendPoint(*view, t.second[1]);
+                output->appendPoint(*view, ids[1]);
         }
         else
         {
@@ -130,13 +144,13 @@ PointViewSet VoxelCentroidNearestNeighborFilter::run(PointViewPtr view)
             // closest to the centroid.
 
             // Compute the centroid.
-            Eigen::Vector3d centroid = computeCentroid(*view, t.second);
+            Eigen::Vector3d centroid = computeCentroid(*view, ids);
 
             // Compute distance from each point in the voxel to the centroid,
             // retaining only the closest.
             PointId pmin;
             double dmin((std::numeric_limits<double>::max)());
-            for (auto const& p : t.second)
+            for (auto const& p : ids)
             {
                 double x = view->getFieldAs<double>(Dimension::Id::X, p);
                 double y = view->getFieldAs<double>(Dimension::Id::Y, p);
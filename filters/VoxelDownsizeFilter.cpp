@@ -104,6 +104,9 @@ void VoxelDownsizeFilter::ready(PointTableRef)
 
 PointViewSet VoxelDownsizeFilter::run(PointViewPtr view)
 {
+    // At most one voxel per point.
+    m_populatedVoxels.reserve(view->size());
+
     PointViewPtr output = view->makeNew();
     PointRef point(*view);
     for (PointId id = 0; id < view->size(); ++id)
@@ -140,18 +143,16 @@ bool VoxelDownsizeFilter::voxelize(PointRef& point)
     y -= m_originY;
     z -= m_originZ;
 
-    Voxel v = std::make_tuple((int)(std::floor(x / m_cell)),
-        (int)(std::floor(y / m_cell)), (int)(std::floor(z / m_cell)));
+    int xi = (int)(std::floor(x / m_cell));
+    int yi = (int)(std::floor(y / m_cell));
+    int zi = (int)(std::floor(z / m_cell));
 
-    auto inserted = m_populatedVoxels.insert(v).second;
+    bool inserted = m_populatedVoxels.insert(xi, yi, zi);
     if ((m_mode == Mode::Center) && inserted)
     {
-        point.setField(Dimension::Id::X,
-            (std::get<0>(v) + 0.5) * m_cell + m_originX);
-        point.setField(Dimension::Id::Y,
-            (std::get<1>(v) + 0.5) * m_cell + m_originY);
-        point.setField(Dimension::Id::Z,
-            (std::get<2>(v) + 0.5) * m_cell + m_originZ);
+        point.setField(Dimension::Id::X, (xi + 0.5) * m_cell + m_originX);
+        point.setField(Dimension::Id::Y, (yi + 0.5) * m_cell + m_originY);
+        point.setField(Dimension::Id::Z, (zi + 0.5) * m_cell + m_originZ);
     }
     return inserted;
 }
@@ -39,6 +39,8 @@
 #include <pdal/Filter.hpp>
 #include <pdal/Streamable.hpp>
 
+#include "private/VoxelGrid.hpp"
+
 namespace pdal
 {
 
@@ -47,7 +49,6 @@ class PointView;
 
 class PDAL_DLL VoxelDownsizeFilter : public Filter, public Streamable
 {
-    using Voxel = std::tuple<int, int, int>;
     enum class Mode
     {
         First,
@@ -72,7 +73,7 @@ private:
     double m_originX;
     double m_originY;
     double m_originZ;
-    std::set<Voxel> m_populatedVoxels;
+    VoxelSet m_populatedVoxels;
     Mode m_mode;
 
     friend std::istream& operator>>(std::istream& in,
@@ -34,6 +34,9 @@
 
 #include "DimRange.hpp"
 
+#include <cmath>
+#include <limits>
+
 #include <pdal/util/Utils.hpp>
 
 namespace pdal
@@ -109,21 +112,20 @@ std::string::size_type DimRange::subParse(const std::string& r)
 
     count = Utils::extractSpaces(r, pos);
     pos += count;
+
+    compile();
     return pos;
 }
 
 
-bool DimRange::valuePasses(double v) const
+// Fold the inclusivity flags into a pair of always-inclusive bounds so
+// that valuePasses() needs no per-value branching.
+void DimRange::compile()
 {
-    // Determine if a point passes a range.
-    bool fail = std::isnan(v) ||
-        ((m_inclusive_lower_bound && v < m_lower_bound) ||
-        (!m_inclusive_lower_bound && v <= m_lower_bound) ||
-        (m_inclusive_upper_bound && v > m_upper_bound) ||
-        (!m_inclusive_upper_bound && v >= m_upper_bound));
-    if (m_negate)
-        fail = !fail;
-    return !fail;
+    m_lo = m_inclusive_lower_bound ? m_lower_bound :
+        std::nextafter(m_lower_bound, (std::numeric_limits<double>::max)());
+    m_hi = m_inclusive_upper_bound ? m_upper_bound :
+        std::nextafter(m_upper_bound, std::numeric_limits<double>::lowest());
 }
 
 // Important - range list must be sorted.
@@ -62,15 +62,22 @@ struct DimRange
     m_inclusive_lower_bound(inclusive_lower_bound),
     m_inclusive_upper_bound(inclusive_upper_bound),
     m_negate(negate)
-    {}
+    { compile(); }
 
     DimRange() : m_id(Dimension::Id::Unknown), m_lower_bound(0),
         m_upper_bound(0), m_inclusive_lower_bound(true),
         m_inclusive_upper_bound(true), m_negate(false)
-    {}
+    { compile(); }
 
     void parse(const std::string& s);
-    bool valuePasses(double d) const;
+
+    // Determine if a value passes the range.  The inclusivity flags are
+    // folded into the compiled bounds, so this is branch-free and
+    // vectorizes when applied over a block of values.  NaN fails the
+    // range (and so passes a negated one).
+    bool valuePasses(double v) const
+        { return ((v >= m_lo) & (v <= m_hi)) != m_negate; }
+
     static bool pointPasses(const std::vector<DimRange>& ranges,
         PointRef& point);
 
@@ -84,6 +91,13 @@ struct DimRange
 
 protected:
     std::string::size_type subParse(const std::string& r);
+    void compile();
+
+private:
+    // Bounds with the inclusivity flags applied - an exclusive bound is
+    // nudged one representable value inward so the test is always >=/<=.
+    double m_lo;
+    double m_hi;
 };
 
 bool operator < (const DimRange& r1, const DimRange& r2);
@@ -38,10 +38,15 @@
 #include <pdal/PointView.hpp>
 #include <pdal/Stage.hpp>
 #include <pdal/pdal_types.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "DimRange.hpp"
 #include "Segmentation.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <thread>
 #include <vector>
 
 namespace pdal
@@ -50,95 +55,197 @@ namespace pdal
 namespace Segmentation
 {
 
+namespace
+{
+
+// Points per batched dimension read.
+const point_count_t BatchSize = 4096;
+
+// Run fn(start, count) over [0, np) with the range split across threads.
+// The callers' scans only read the table, so ranges divide freely.
+// Threading only pays off on large views (see extractClusters()).
+void parallelRanges(point_count_t np,
+    const std::function<void(PointId, point_count_t)>& fn)
+{
+    size_t threads = pdal::threadCount(0, np);
+    if (threads <= 1)
+    {
+        fn(0, np);
+        return;
+    }
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        PointId start = np * t / threads;
+        PointId end = np * (t + 1) / threads;
+        pool.emplace_back(fn, start, (point_count_t)(end - start));
+    }
+    for (auto& t : pool)
+        t.join();
+}
+
+// Split input between the two output views according to the mask,
+// appending maximal runs of same-fate points rather than one point at a
+// time.  Both outputs keep input order.
+void appendRuns(PointView& input, const std::vector<char>& mask,
+    PointView& pass, PointView& fail)
+{
+    point_count_t np = input.size();
+    PointId start = 0;
+    for (PointId i = 1; i <= np; ++i)
+    {
+        if (i == np || mask[i] != mask[start])
+        {
+            (mask[start] ? pass : fail).appendRange(input, start, i - start);
+            start = i;
+        }
+    }
+}
+
+} // unnamed namespace
+
 std::vector<PointIdList> extractClusters(PointView& view, uint64_t min_points,
-                                         uint64_t max_points, double tolerance)
+                                         uint64_t max_points, double tolerance,
+                                         size_t threads)
 {
+    std::vector<PointIdList> clusters;
+
+    point_count_t np = view.size();
+    if (np == 0)
+        return clusters;
+
     // Index the incoming PointView for subsequent radius searches.
     KD3Index kdi(view);
     kdi.build();
 
-    // Create variables to track PointIds that have already been added to
-    // clusters and to build the list of cluster indices.
-    PointIdList processed(view.size(), 0);
-    std::vector<PointIdList> clusters;
+    threads = pdal::threadCount(threads, np);
 
-    for (PointId i = 0; i < view.size(); ++i)
+    // Find each point's neighbors within the tolerance.  The queries only
+    // read the index, so the points divide across threads.
+    std::vector<PointIdList> neighbors(np);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
     {
-        // Points can only belong to a single cluster.
-        if (processed[i])
-            continue;
-
-        // Initialize list of indices belonging to current cluster, marking the
-        // seed point as processed.
-        PointIdList seed_queue;
-        size_t sq_idx = 0;
-        seed_queue.push_back(i);
-        processed[i] = 1;
-
-        // Check each point in the cluster for additional neighbors within the
-        // given tolerance, remembering that the list can grow if we add points
-        // to the cluster.
-        while (sq_idx < seed_queue.size())
+        pool.emplace_back([&, t]()
         {
-            // Find neighbors of the next cluster point.
-            PointId j = seed_queue[sq_idx];
-            PointIdList ids = kdi.radius(j, tolerance);
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            for (PointId i = start; i < end; ++i)
+                neighbors[i] = kdi.radius(i, tolerance);
+        });
+    }
+    for (auto& t : pool)
+        t.join();
 
-            // The case where the only neighbor is the query point.
-            if (ids.size() == 1)
-            {
-                sq_idx++;
-                continue;
-            }
+    // Merge the connected components with a union-find.
+    std::vector<PointId> parent(np);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](PointId i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
 
-            // Skip neighbors that already belong to a cluster and add the rest
-            // to this cluster.
-            for (auto const& k : ids)
-            {
-                if (processed[k])
-                    continue;
-                seed_queue.push_back(k);
-                processed[k] = 1;
-            }
+    for (PointId i = 0; i < np; ++i)
+        for (PointId q : neighbors[i])
+            parent[find(q)] = find(i);
 
-            sq_idx++;
+    // Collect the components in order of their lowest PointId, matching
+    // the order the sequential expansion discovered them, then keep those
+    // within the min/max point counts.
+    std::vector<PointIdList> components;
+    std::vector<PointId> componentOf(np, np);
+    for (PointId i = 0; i < np; ++i)
+    {
+        PointId r = find(i);
+        if (componentOf[r] == np)
+        {
+            componentOf[r] = components.size();
+            components.emplace_back();
         }
-
-        // Keep clusters that are within the min/max number of points.
-        if (seed_queue.size() >= min_points && seed_queue.size() <= max_points)
-            clusters.push_back(seed_queue);
+        components[componentOf[r]].push_back(i);
     }
 
+    for (PointIdList& c : components)
+        if (c.size() >= min_points && c.size() <= max_points)
+            clusters.push_back(std::move(c));
+
     return clusters;
 }
 
 void ignoreDimRange(DimRange dr, PointViewPtr input, PointViewPtr keep,
                     PointViewPtr ignore)
 {
-    PointRef point(*input, 0);
-    for (PointId i = 0; i < input->size(); ++i)
-    {
-        point.setPointId(i);
-        if (dr.valuePasses(point.getFieldAs<double>(dr.m_id)))
-            ignore->appendPoint(*input, i);
-        else
-            keep->appendPoint(*input, i);
-    }
+    point_count_t np = input->size();
+    std::vector<char> mask(np);
+    parallelRanges(np, [&](PointId start, point_count_t count)
+    {
+        std::vector<double> vals((std::min)(BatchSize, count));
+        for (point_count_t s = 0; s < count; s += BatchSize)
+        {
+            point_count_t n = (std::min)(BatchSize, count - s);
+            input->getFieldBatch(dr.m_id, start + s, n, vals.data());
+            for (point_count_t i = 0; i < n; ++i)
+                mask[start + s + i] = dr.valuePasses(vals[i]);
+        }
+    });
+    appendRuns(*input, mask, *ignore, *keep);
 }
 
 void ignoreDimRanges(std::vector<DimRange>& ranges, PointViewPtr input,
     PointViewPtr keep, PointViewPtr ignore)
 {
+    if (ranges.empty())
+    {
+        keep->append(*input);
+        return;
+    }
     std::sort(ranges.begin(), ranges.end());
-    PointRef point(*input, 0);
-    for (PointId i = 0; i < input->size(); ++i)
-    {
-        point.setPointId(i);
-        if (DimRange::pointPasses(ranges, point))
-            ignore->appendPoint(*input, i);
-        else
-            keep->appendPoint(*input, i);
+
+    // Group the sorted ranges by dimension - OR within a dimension's
+    // group, AND across groups, matching DimRange::pointPasses().
+    std::vector<std::pair<size_t, size_t>> groups;
+    for (size_t b = 0; b < ranges.size();)
+    {
+        size_t e = b + 1;
+        while (e < ranges.size() && ranges[e].m_id == ranges[b].m_id)
+            e++;
+        groups.emplace_back(b, e);
+        b = e;
     }
+
+    point_count_t np = input->size();
+    std::vector<char> mask(np);
+    parallelRanges(np, [&](PointId start, point_count_t count)
+    {
+        std::vector<std::vector<double>> vals(groups.size());
+        for (auto& v : vals)
+            v.resize((std::min)(BatchSize, count));
+        for (point_count_t s = 0; s < count; s += BatchSize)
+        {
+            point_count_t n = (std::min)(BatchSize, count - s);
+            for (size_t g = 0; g < groups.size(); ++g)
+                input->getFieldBatch(ranges[groups[g].first].m_id,
+                    start + s, n, vals[g].data());
+            for (point_count_t i = 0; i < n; ++i)
+            {
+                bool passes = true;
+                for (size_t g = 0; g < groups.size(); ++g)
+                {
+                    bool any = false;
+                    for (size_t r = groups[g].first; r < groups[g].second; ++r)
+                        any |= ranges[r].valuePasses(vals[g][i]);
+                    passes &= any;
+                }
+                mask[start + s + i] = passes;
+            }
+        }
+    });
+    appendRuns(*input, mask, *ignore, *keep);
 }
 
 void ignoreClassBits(PointViewPtr input, PointViewPtr keep,
@@ -146,42 +253,40 @@ void ignoreClassBits(PointViewPtr input, PointViewPtr keep,
 {
     using namespace Dimension;
 
-    bool ignoreSynthetic = false;
-    bool ignoreKeypoint = false;
-    bool ignoreWithheld = false;
+    uint8_t ignoreBits = 0;
 
     if (!classbits.size())
     {
         keep->append(*input);
+        return;
     }
-    else
+
+    for (auto& b : classbits)
     {
-        for (auto& b : classbits)
-        {
-            Utils::trim(b);
-            if (b == "synthetic")
-                ignoreSynthetic = true;
-            else if (b == "keypoint")
-                ignoreKeypoint = true;
-            else if (b == "withheld")
-                ignoreWithheld = true;
-        }
+        Utils::trim(b);
+        if (b == "synthetic")
+            ignoreBits |= ClassLabel::Synthetic;
+        else if (b == "keypoint")
+            ignoreBits |= ClassLabel::Keypoint;
+        else if (b == "withheld")
+            ignoreBits |= ClassLabel::Withheld;
+    }
 
-        for (PointId i = 0; i < input->size(); ++i)
+    point_count_t np = input->size();
+    std::vector<char> mask(np);
+    parallelRanges(np, [&](PointId start, point_count_t count)
+    {
+        std::vector<uint8_t> cls((std::min)(BatchSize, count));
+        for (point_count_t s = 0; s < count; s += BatchSize)
         {
-            uint8_t c = input->getFieldAs<uint8_t>(Id::Classification, i);
-	    if (((c & ClassLabel::Synthetic) && ignoreSynthetic) ||
-                ((c & ClassLabel::Keypoint) && ignoreKeypoint) ||
-		((c & ClassLabel::Withheld) && ignoreWithheld))
-            {
-                ignore->appendPoint(*input, i);
-            }
-	    else
-            {
-                keep->appendPoint(*input, i);
-            }
+            point_count_t n = (std::min)(BatchSize, count - s);
+            input->getFieldBatch(Id::Classification, start + s, n,
+                cls.data());
+            for (point_count_t i = 0; i < n; ++i)
+                mask[start + s + i] = (cls[i] & ignoreBits) != 0;
         }
-    }
+    });
+    appendRuns(*input, mask, *ignore, *keep);
 }
 
 void segmentLastReturns(PointViewPtr input, PointViewPtr last,
@@ -189,15 +294,22 @@ void segmentLastReturns(PointViewPtr input, PointViewPtr last,
 {
     using namespace Dimension;
 
-    for (PointId i = 0; i < input->size(); ++i)
+    point_count_t np = input->size();
+    std::vector<char> mask(np);
+    parallelRanges(np, [&](PointId start, point_count_t count)
     {
-        uint8_t rn = input->getFieldAs<uint8_t>(Id::ReturnNumber, i);
-        uint8_t nr = input->getFieldAs<uint8_t>(Id::NumberOfReturns, i);
-        if ((rn == nr) && (nr > 1))
-            last->appendPoint(*input, i);
-        else
-            other->appendPoint(*input, i);
-    }
+        std::vector<uint8_t> rn((std::min)(BatchSize, count));
+        std::vector<uint8_t> nr((std::min)(BatchSize, count));
+        for (point_count_t s = 0; s < count; s += BatchSize)
+        {
+            point_count_t n = (std::min)(BatchSize, count - s);
+            input->getFieldBatch(Id::ReturnNumber, start + s, n, rn.data());
+            input->getFieldBatch(Id::NumberOfReturns, start + s, n, nr.data());
+            for (point_count_t i = 0; i < n; ++i)
+                mask[start + s + i] = (rn[i] == nr[i]) && (nr[i] > 1);
+        }
+    });
+    appendRuns(*input, mask, *last, *other);
 }
 
 void segmentReturns(PointViewPtr input, PointViewPtr first,
@@ -213,40 +325,47 @@ void segmentReturns(PointViewPtr input, PointViewPtr first,
     if (!returns.size())
     {
         first->append(*input);
+        return;
     }
-    else
+
+    for (auto& r : returns)
     {
-        for (auto& r : returns)
-        {
-            Utils::trim(r);
-            if (r == "first")
-                returnFirst = true;
-            else if (r == "intermediate")
-                returnIntermediate = true;
-            else if (r == "last")
-                returnLast = true;
-            else if (r == "only")
-                returnOnly = true;
-        }
+        Utils::trim(r);
+        if (r == "first")
+            returnFirst = true;
+        else if (r == "intermediate")
+            returnIntermediate = true;
+        else if (r == "last")
+            returnLast = true;
+        else if (r == "only")
+            returnOnly = true;
+    }
 
-        for (PointId i = 0; i < input->size(); ++i)
+    point_count_t np = input->size();
+    std::vector<char> mask(np);
+    parallelRanges(np, [&](PointId start, point_count_t count)
+    {
+        std::vector<uint8_t> rns((std::min)(BatchSize, count));
+        std::vector<uint8_t> nrs((std::min)(BatchSize, count));
+        for (point_count_t s = 0; s < count; s += BatchSize)
         {
-            uint8_t rn = input->getFieldAs<uint8_t>(Id::ReturnNumber, i);
-            uint8_t nr = input->getFieldAs<uint8_t>(Id::NumberOfReturns, i);
-
-            if ((((rn == 1) && (nr > 1)) && returnFirst) ||
-                (((rn > 1) && (rn < nr)) && returnIntermediate) ||
-                (((rn == nr) && (nr > 1)) && returnLast) ||
-                ((nr == 1) && returnOnly))
-            {
-                first->appendPoint(*input.get(), i);
-            }
-            else
+            point_count_t n = (std::min)(BatchSize, count - s);
+            input->getFieldBatch(Id::ReturnNumber, start + s, n, rns.data());
+            input->getFieldBatch(Id::NumberOfReturns, start + s, n,
+                nrs.data());
+            for (point_count_t i = 0; i < n; ++i)
             {
-                second->appendPoint(*input.get(), i);
+                uint8_t rn = rns[i];
+                uint8_t nr = nrs[i];
+                mask[start + s + i] =
+                    (((rn == 1) && (nr > 1)) && returnFirst) ||
+                    (((rn > 1) && (rn < nr)) && returnIntermediate) ||
+                    (((rn == nr) && (nr > 1)) && returnLast) ||
+                    ((nr == 1) && returnOnly);
             }
         }
-    }
+    });
+    appendRuns(*input, mask, *first, *second);
 }
 
 } // namespace Segmentation
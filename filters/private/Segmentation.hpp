@@ -52,21 +52,25 @@ namespace Segmentation
 /**
   Extract clusters of points from input PointView.
 
-  For each point, find neighbors within a given tolerance (Euclidean distance).
-  If a neighbor already belongs to another cluster, skip it. Otherwise, add it
-  to the current cluster. Recursively visit newly added cluster points, looking
-  for neighbors to add to the cluster.
+  Clusters are the connected components of the points under the "within
+  tolerance (Euclidean distance)" relation.  Each point's neighbors are
+  found with a radius query - a read-only pass that runs across threads -
+  and the components are then merged with a union-find.  Clusters are
+  ordered by their lowest PointId.
 
   \param[in] view the input PointView.
   \param[in] min_points the minimum number of points in a cluster.
   \param[in] max_points the maximum number of points in a cluster.
   \param[in] tolerance the tolerance for adding points to a cluster.
+  \param[in] threads the number of threads for the neighbor queries
+             (0 = choose automatically).
   \returns a vector of clusters (themselves vectors of PointIds).
 */
 PDAL_DLL std::vector<PointIdList> extractClusters(PointView& view,
                                                   uint64_t min_points,
                                                   uint64_t max_points,
-                                                  double tolerance);
+                                                  double tolerance,
+                                                  size_t threads = 0);
 
 PDAL_DLL void ignoreDimRange(DimRange dr, PointViewPtr input, PointViewPtr keep,
                              PointViewPtr ignore);
@@ -0,0 +1,255 @@
+/******************************************************************************
+ * Copyright (c) 2020, Hobu Inc. (info@hobu.co)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace pdal
+{
+
+// Flat, open-addressed containers keyed by integral voxel coordinates.
+// The coordinates are mixed into a 64-bit hash and probed linearly in a
+// power-of-two table, so a lookup is a couple of contiguous memory reads
+// instead of a red-black tree descent with one node allocation per voxel.
+// Collisions are resolved by comparing the stored coordinates, so distinct
+// voxels never alias.  Neither container keeps voxels in any particular
+// order - callers that emitted in std::map order must sort the keys.
+namespace voxel
+{
+
+struct Key
+{
+    int coord[3];
+
+    bool operator==(const Key& other) const
+    {
+        return coord[0] == other.coord[0] && coord[1] == other.coord[1] &&
+            coord[2] == other.coord[2];
+    }
+
+    bool operator<(const Key& other) const
+    {
+        if (coord[0] != other.coord[0])
+            return coord[0] < other.coord[0];
+        if (coord[1] != other.coord[1])
+            return coord[1] < other.coord[1];
+        return coord[2] < other.coord[2];
+    }
+};
+
+// The smallest representable first coordinate marks an unused slot.  A
+// point would have to sit billions of cells from the grid anchor to
+// produce it, at which point the double-to-int conversion upstream has
+// already overflowed.
+const int EmptyCoord = (std::numeric_limits<int>::min)();
+
+inline Key emptyKey()
+{
+    return Key { { EmptyCoord, 0, 0 } };
+}
+
+inline bool emptySlot(const Key& k)
+{
+    return k.coord[0] == EmptyCoord;
+}
+
+inline uint64_t hash(const Key& k)
+{
+    uint64_t h(0xcbf29ce484222325ULL);
+    for (int c : k.coord)
+    {
+        uint64_t x = (uint64_t)(int64_t)c * 0x9e3779b97f4a7c15ULL;
+        x ^= x >> 32;
+        h = (h ^ x) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+// Find the slot holding the key, or the empty slot where it belongs.
+// The table size must be a power of two and can't be full.
+inline size_t probe(const std::vector<Key>& keys, const Key& k)
+{
+    size_t mask = keys.size() - 1;
+    size_t pos = hash(k) & mask;
+    while (!emptySlot(keys[pos]) && !(keys[pos] == k))
+        pos = (pos + 1) & mask;
+    return pos;
+}
+
+// Smallest power-of-two table that holds the count under 3/4 load.
+inline size_t tableSize(size_t count)
+{
+    size_t want = count + count / 2;
+    size_t size = 16;
+    while (size < want)
+        size *= 2;
+    return size;
+}
+
+} // namespace voxel
+
+
+class VoxelSet
+{
+public:
+    VoxelSet()
+        { clear(); }
+
+    // Size the table up front for an expected number of voxels.
+    void reserve(size_t count)
+    {
+        size_t size = voxel::tableSize(count);
+        if (size > m_keys.size())
+            rehash(size);
+    }
+
+    bool empty() const
+        { return m_size == 0; }
+
+    size_t size() const
+        { return m_size; }
+
+    void clear()
+    {
+        m_size = 0;
+        m_keys.assign(voxel::tableSize(0), voxel::emptyKey());
+    }
+
+    // Insert the voxel, returning true if it wasn't already present.
+    bool insert(int a, int b, int c)
+    {
+        if ((m_size + 1) * 4 > m_keys.size() * 3)
+            rehash(m_keys.size() * 2);
+        voxel::Key k { { a, b, c } };
+        size_t pos = voxel::probe(m_keys, k);
+        if (!voxel::emptySlot(m_keys[pos]))
+            return false;
+        m_keys[pos] = k;
+        m_size++;
+        return true;
+    }
+
+private:
+    void rehash(size_t size)
+    {
+        std::vector<voxel::Key> keys(size, voxel::emptyKey());
+        for (const voxel::Key& k : m_keys)
+            if (!voxel::emptySlot(k))
+                keys[voxel::probe(keys, k)] = k;
+        m_keys.swap(keys);
+    }
+
+    std::vector<voxel::Key> m_keys;
+    size_t m_size;
+};
+
+
+template <typename Value>
+class VoxelMap
+{
+public:
+    VoxelMap()
+        { clear(); }
+
+    // Size the table up front for an expected number of voxels.
+    void reserve(size_t count)
+    {
+        size_t size = voxel::tableSize(count);
+        if (size > m_keys.size())
+            rehash(size);
+    }
+
+    size_t size() const
+        { return m_size; }
+
+    void clear()
+    {
+        m_size = 0;
+        m_keys.assign(voxel::tableSize(0), voxel::emptyKey());
+        m_values.assign(m_keys.size(), Value());
+    }
+
+    // Fetch the value slot for the voxel, default-constructing it on
+    // first reference.  \c inserted reports whether the voxel was new.
+    Value& put(int a, int b, int c, bool& inserted)
+    {
+        if ((m_size + 1) * 4 > m_keys.size() * 3)
+            rehash(m_keys.size() * 2);
+        voxel::Key k { { a, b, c } };
+        size_t pos = voxel::probe(m_keys, k);
+        inserted = voxel::emptySlot(m_keys[pos]);
+        if (inserted)
+        {
+            m_keys[pos] = k;
+            m_size++;
+        }
+        return m_values[pos];
+    }
+
+    // Visit each populated voxel, in no particular order.
+    template <typename F>
+    void visit(F f) const
+    {
+        for (size_t pos = 0; pos < m_keys.size(); ++pos)
+            if (!voxel::emptySlot(m_keys[pos]))
+                f(m_keys[pos], m_values[pos]);
+    }
+
+private:
+    void rehash(size_t size)
+    {
+        std::vector<voxel::Key> keys(size, voxel::emptyKey());
+        std::vector<Value> values(size);
+        for (size_t pos = 0; pos < m_keys.size(); ++pos)
+        {
+            if (voxel::emptySlot(m_keys[pos]))
+                continue;
+            size_t to = voxel::probe(keys, m_keys[pos]);
+            keys[to] = m_keys[pos];
+            values[to] = std::move(m_values[pos]);
+        }
+        m_keys.swap(keys);
+        m_values.swap(values);
+    }
+
+    std::vector<voxel::Key> m_keys;
+    std::vector<Value> m_values;
+    size_t m_size;
+};
+
+} // namespace pdal
@@ -5,7 +5,9 @@
 #include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <thread>
 #include <tuple>
+#include <utility>
 
 namespace delaunator {
 
@@ -97,31 +99,22 @@ inline Point circumcenter(
 }
 
 
+// Points are sorted as (distance, id) pairs so the hot comparisons read
+// contiguous memory, and so the comparator is cheap to copy - introsort
+// copies its comparator at every recursion level, which dragged the old
+// comparator's distance table along with it.
+using DistId = std::pair<double, std::size_t>;
+
 struct compare {
 
     std::vector<double> const& coords;
-    std::vector<double> dists;
-
-    compare(std::vector<double> const& coords, const Point& center) :
-        coords(coords)
-    {
-        size_t n = coords.size() / 2;
-        dists.reserve(n);
-        double const *xcoord = coords.data();
-        double const *ycoord = coords.data() + 1;
-        while (n--)
-        {
-            dists.push_back(dist(*xcoord, *ycoord, center.x(), center.y()));
-            xcoord += 2;
-            ycoord += 2;
-        }
-    }
 
-    bool operator()(std::size_t i, std::size_t j)
+    bool operator()(const DistId& a, const DistId& b) const
     {
-        const double diff1 = dists[i] - dists[j];
-        const double diff2 = coords[2 * i] - coords[2 * j];
-        const double diff3 = coords[2 * i + 1] - coords[2 * j + 1];
+        const double diff1 = a.first - b.first;
+        const double diff2 = coords[2 * a.second] - coords[2 * b.second];
+        const double diff3 =
+            coords[2 * a.second + 1] - coords[2 * b.second + 1];
 
         //ABELL - Not sure why we're not just checking != 0 here.
         if (diff1 > 0.0 || diff1 < 0.0) {
@@ -134,6 +127,46 @@ struct compare {
     }
 };
 
+// Sort slices of the pair array concurrently and merge them pairwise.
+// Every merge level works on disjoint ranges, so the only coordination
+// needed is the join at the end of each level.
+inline void sort_dist_ids(std::vector<DistId>& dist_ids,
+    std::vector<double> const& coords, std::size_t n_threads) {
+    compare cmp{ coords };
+    std::size_t n = dist_ids.size();
+    if (n_threads <= 1 || n < n_threads * 2) {
+        std::sort(dist_ids.begin(), dist_ids.end(), cmp);
+        return;
+    }
+
+    std::vector<std::size_t> bounds;
+    for (std::size_t t = 0; t <= n_threads; t++)
+        bounds.push_back(n * t / n_threads);
+
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0; t < n_threads; t++)
+        pool.emplace_back([&dist_ids, &bounds, cmp, t]() {
+            std::sort(dist_ids.begin() + bounds[t],
+                dist_ids.begin() + bounds[t + 1], cmp);
+        });
+    for (auto& thread : pool)
+        thread.join();
+
+    for (std::size_t width = 1; width < n_threads; width *= 2) {
+        std::vector<std::thread> mergers;
+        for (std::size_t lo = 0; lo + width < n_threads; lo += 2 * width) {
+            std::size_t hi = (std::min)(lo + 2 * width, n_threads);
+            mergers.emplace_back([&dist_ids, &bounds, cmp, lo, width, hi]() {
+                std::inplace_merge(dist_ids.begin() + bounds[lo],
+                    dist_ids.begin() + bounds[lo + width],
+                    dist_ids.begin() + bounds[hi], cmp);
+            });
+        }
+        for (auto& thread : mergers)
+            thread.join();
+    }
+}
+
 
 inline bool in_circle(
     const double ax,
@@ -183,7 +216,8 @@ struct DelaunatorPoint {
     bool removed;
 };
 
-Delaunator::Delaunator(std::vector<double> const& in_coords)
+Delaunator::Delaunator(std::vector<double> const& in_coords,
+                       std::size_t n_threads)
     : coords(in_coords),
       triangles(),
       halfedges(),
@@ -280,7 +314,15 @@ Delaunator::Delaunator(std::vector<double> const& in_coords)
     m_center = circumcenter(i0x, i0y, i1x, i1y, i2x, i2y);
 
     // sort the points by distance from the seed triangle circumcenter
-    std::sort(ids.begin(), ids.end(), compare{ coords, m_center });
+    std::vector<DistId> dist_ids;
+    dist_ids.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+        dist_ids.emplace_back(
+            dist(coords[2 * i], coords[2 * i + 1], m_center.x(), m_center.y()),
+            i);
+    sort_dist_ids(dist_ids, coords, n_threads);
+    for (std::size_t i = 0; i < n; i++)
+        ids[i] = dist_ids[i].second;
 
     // initialize a hash table for storing edges of the advancing convex hull
     m_hash_size = static_cast<std::size_t>(std::llround(std::ceil(std::sqrt(n))));
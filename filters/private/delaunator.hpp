@@ -49,7 +49,10 @@ public:
     std::vector<std::size_t> hull_tri;
     std::size_t hull_start;
 
-    INLINE Delaunator(std::vector<double> const& in_coords);
+    // n_threads bounds the concurrency of the initial distance sort; the
+    // incremental insertion sweep itself is sequential.
+    INLINE Delaunator(std::vector<double> const& in_coords,
+        std::size_t n_threads = 1);
     INLINE double get_hull_area();
 
 private:
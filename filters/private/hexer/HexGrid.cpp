@@ -35,6 +35,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <thread>
 
 #include "HexGrid.hpp"
 #include "HexIter.hpp"
@@ -86,16 +87,28 @@ void HexGrid::addPoint(Point p)
     if (!h->dense())
     {
         if (dense(h))
-        {
-            h->setDense();
-            m_miny = std::min(m_miny, h->y() - 1);
-            if (h->possibleRoot())
-                m_pos_roots.insert(h);
-            markNeighborBelow(h);
-        }
+            markDense(h);
     }
 }
 
+void HexGrid::addPointCount(int x, int y, int count)
+{
+    Hexagon *h = getHexagon(x, y);
+    h->setCount(h->count() + count);
+    if (!h->dense() && dense(h))
+        markDense(h);
+}
+
+// Bookkeeping performed when a hexagon crosses the density threshold.
+void HexGrid::markDense(Hexagon *h)
+{
+    h->setDense();
+    m_miny = std::min(m_miny, h->y() - 1);
+    if (h->possibleRoot())
+        m_pos_roots.insert(h);
+    markNeighborBelow(h);
+}
+
 void HexGrid::processSample()
 {
     if (m_width > 0 || m_sample.empty())
@@ -116,11 +129,7 @@ void HexGrid::addDenseHexagon(int x, int y)
     if (!h->dense())
     {
         h->setCount(m_dense_limit);
-        h->setDense();
-        m_miny = std::min(m_miny, h->y() - 1);
-        if (h->possibleRoot())
-            m_pos_roots.insert(h);
-        markNeighborBelow(h);
+        markDense(h);
     }
 }
 
@@ -180,8 +189,6 @@ void HexGrid::markNeighborBelow(Hexagon *h)
 //
 Hexagon *HexGrid::findHexagon(Point p)
 {
-    int x, y;
-
     if (m_hexes.empty())
     {
         m_origin = p;
@@ -192,6 +199,14 @@ Hexagon *HexGrid::findHexagon(Point p)
         return &it->second;
     }
 
+    Coord c = hexCoord(p);
+    return getHexagon(c.m_x, c.m_y);
+}
+
+Coord HexGrid::hexCoord(Point p) const
+{
+    int x, y;
+
     // Offset by the origin.
     p -= m_origin;
 
@@ -250,7 +265,7 @@ Hexagon *HexGrid::findHexagon(Point p)
             }
         }
     }
-    return getHexagon(x, y);
+    return Coord(x, y);
 }
 
 // Get the hexagon at position x, y.  If it doesn't exist, create it.
@@ -279,7 +294,7 @@ Hexagon *HexGrid::getHexagon(int x, int y)
 //  2 \____/ 4
 //      3
 **/
-void HexGrid::findShapes()
+void HexGrid::findShapes(size_t threads)
 {
     if (m_pos_roots.empty())
     {
@@ -287,11 +302,118 @@ void HexGrid::findShapes()
             "Decrease density or area size.");
     }
 
-    while (m_pos_roots.size())
+    if (threads <= 1)
     {
-        Hexagon *h = *m_pos_roots.begin();
-        findShape(h);
+        while (m_pos_roots.size())
+        {
+            Hexagon *h = *m_pos_roots.begin();
+            findShape(h);
+        }
+        return;
+    }
+
+    // Parallel boundary tracing.  The grid built during the density pass
+    // is traversed read-only: each thread takes a slice of the dense
+    // hexagons and computes, for every side facing a non-dense neighbor,
+    // the segment that follows it in a clockwise walk - the same
+    // left-turn-else-right-turn rule findShape() applies.  The
+    // precomputed links are then stitched into closed paths serially,
+    // which costs one hash lookup per boundary segment instead of the
+    // neighbor probes of the full walk.
+    std::vector<Hexagon *> dense;
+    dense.reserve(m_hexes.size());
+    for (HexMap::iterator it = m_hexes.begin(); it != m_hexes.end(); ++it)
+        if (it->second.dense())
+            dense.push_back(&it->second);
+
+    struct Links
+    {
+        Links() : boundary(0), visited(0)
+        {}
+
+        /// Bit per side facing a non-dense neighbor.
+        uint8_t boundary;
+        uint8_t visited;
+        Segment next[6];
+    };
+    typedef std::unordered_map<Hexagon *, Links> LinkMap;
+
+    threads = std::min(threads, dense.size());
+    std::vector<LinkMap> partials(threads);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([this, &dense, &partials, t, threads]()
+        {
+            // From segment (hex, side) a clockwise walk turns left onto
+            // the hexagon in direction leftHex[side] when it's dense and
+            // otherwise turns right, staying on the same hexagon.
+            static const int leftHex[] = { 5, 0, 1, 2, 3, 4 };
+            static const int leftSide[] = { 1, 2, 3, 4, 5, 0 };
+            static const int rightSide[] = { 5, 0, 1, 2, 3, 4 };
+
+            LinkMap& local = partials[t];
+            size_t start = dense.size() * t / threads;
+            size_t end = dense.size() * (t + 1) / threads;
+            for (size_t i = start; i < end; ++i)
+            {
+                Hexagon *h = dense[i];
+                Links links;
+                for (int side = 0; side < 6; ++side)
+                {
+                    Hexagon *adj = peekHexagon(h->neighborCoord(side));
+                    if (adj && adj->dense())
+                        continue;
+                    links.boundary |= (1 << side);
+                    Hexagon *left =
+                        peekHexagon(h->neighborCoord(leftHex[side]));
+                    if (left && left->dense())
+                        links.next[side] = Segment(left, leftSide[side]);
+                    else
+                        links.next[side] = Segment(h, rightSide[side]);
+                }
+                if (links.boundary)
+                    local.insert(LinkMap::value_type(h, links));
+            }
+        });
+    }
+    for (auto& t : pool)
+        t.join();
+
+    LinkMap links(std::move(partials[0]));
+    for (size_t t = 1; t < partials.size(); ++t)
+        links.insert(partials[t].begin(), partials[t].end());
+
+    // Stitch the links into closed paths.  Each path runs along the top
+    // of some dense hexagon with a sparse hexagon above - a possible
+    // root - so seeding from the roots in set order finds every cycle
+    // and produces the paths the serial walk would.
+    for (Hexagon *root : m_pos_roots)
+    {
+        LinkMap::iterator it = links.find(root);
+        if (it->second.visited & 1)  // Top side already on some path.
+            continue;
+        Path *p = new Path(this, CLOCKWISE);
+        Segment first(root, 0);
+        Segment cur(first);
+        do {
+            Links& l = links[cur.hex()];
+            l.visited |= (1 << cur.side());
+            // Horizontal segments index their path for hole assignment,
+            // as cleanPossibleRoot() does on the serial walk.
+            Segment s(cur);
+            if (s.horizontal())
+            {
+                s.normalize(this);
+                HexPathMap::value_type hexpath(s.hex(), p);
+                m_hex_paths.insert(hexpath);
+            }
+            p->push_back(cur);
+            cur = l.next[cur.side()];
+        } while (cur != first);
+        m_paths.push_back(p);
     }
+    m_pos_roots.clear();
 }
 
 void HexGrid::findParentPaths()
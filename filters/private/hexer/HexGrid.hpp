@@ -67,7 +67,7 @@ public:
     }
 
     // Exported for testing.
-    PDAL_DLL void findShapes();
+    PDAL_DLL void findShapes(size_t threads = 1);
     PDAL_DLL void findParentPaths();
     PDAL_DLL void toWKT(std::ostream&) const;
     PDAL_DLL void addDenseHexagon(int x, int y);
@@ -76,6 +76,13 @@ public:
     void addPoint(double x, double y)
         { addPoint(Point(x, y)); }
     void addPoint(Point p);
+    /// Apply a pre-binned count of points to the hexagon at x, y with the
+    /// same density bookkeeping addPoint performs one point at a time.
+    void addPointCount(int x, int y, int count);
+    /// Grid coordinates of the hexagon containing the point.  Doesn't
+    /// touch the grid, so it's safe to call concurrently once the grid
+    /// has an origin and a hexagon size.
+    Coord hexCoord(Point p) const;
     void processSample();
 
     void extractShapes();
@@ -84,6 +91,16 @@ public:
     Hexagon *getHexagon(int x, int y);
     Hexagon *getHexagon(const Coord& c)
         { return getHexagon(c.m_x, c.m_y); }
+    /// Hexagon at x, y, or NULL when none exists.  Unlike getHexagon()
+    /// nothing is created, so calls are safe from multiple threads as
+    /// long as no thread is modifying the grid.
+    Hexagon *peekHexagon(int x, int y)
+    {
+        HexMap::iterator it = m_hexes.find(Hexagon::key(x, y));
+        return (it == m_hexes.end()) ? NULL : &it->second;
+    }
+    Hexagon *peekHexagon(const Coord& c)
+        { return peekHexagon(c.m_x, c.m_y); }
     HexIter hexBegin();
     HexIter hexEnd();
     double width() const
@@ -107,6 +124,7 @@ public:
 private:
     void initialize(double height);
     Hexagon *findHexagon(Point p);
+    void markDense(Hexagon *h);
     void findShape(Hexagon *hex);
     void findHole(Hexagon *hex);
     void cleanPossibleRoot(Segment s, Path *p);
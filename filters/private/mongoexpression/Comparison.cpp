@@ -33,10 +33,23 @@
  ****************************************************************************/
 
 #include "Comparison.hpp"
+#include "Program.hpp"
 
 namespace pdal
 {
 
+void ComparisonSingle::flatten(Program& prog) const
+{
+    prog.addSingle(type(), m_dimId, m_operand);
+}
+
+
+void ComparisonMulti::flatten(Program& prog) const
+{
+    prog.addMulti(type(), m_dimId, m_operands);
+}
+
+
 std::unique_ptr<Comparison> Comparison::create(const PointLayout& layout,
         const std::string dimName, const NL::json& json)
 {
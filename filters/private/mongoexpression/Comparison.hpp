@@ -142,6 +142,13 @@ public:
             return Dimension::name(m_id);
     }
 
+    bool isConstant() const
+        { return m_id == Dimension::Id::Unknown; }
+    Dimension::Id dim() const
+        { return m_id; }
+    double value() const
+        { return m_value; }
+
 private:
     double m_value = 0;
     Dimension::Id m_id = Dimension::Id::Unknown;
@@ -185,6 +192,8 @@ public:
         return ss.str();
     }
 
+    virtual void flatten(Program& prog) const override;
+
 protected:
     virtual bool compare(double a, double b) const = 0;
 
@@ -282,6 +291,8 @@ public:
         return ss.str();
     }
 
+    virtual void flatten(Program& prog) const override;
+
 protected:
     const Operands m_operands;
 };
@@ -54,6 +54,13 @@ public:
         return m_root(pr);
     }
 
+    /// Compile the expression into a flattened program for block
+    /// evaluation.
+    void flatten(Program& prog) const
+    {
+        m_root.flatten(prog);
+    }
+
     std::string toString() const
     {
         return m_root.toString("");
@@ -33,10 +33,20 @@
  ****************************************************************************/
 
 #include "LogicGate.hpp"
+#include "Program.hpp"
 
 namespace pdal
 {
 
+void LogicGate::flatten(Program& prog) const
+{
+    prog.beginGate(type());
+    for (const auto& f : m_filters)
+        f->flatten(prog);
+    prog.endGate();
+}
+
+
 std::unique_ptr<LogicGate> LogicGate::create(const LogicalOperator type)
 {
     if (type == LogicalOperator::lAnd) return makeUnique<LogicalAnd>();
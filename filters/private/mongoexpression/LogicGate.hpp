@@ -100,6 +100,8 @@ public:
 
     virtual LogicalOperator type() const = 0;
 
+    virtual void flatten(Program& prog) const override;
+
 protected:
     std::vector<std::unique_ptr<Filterable>> m_filters;
 };
@@ -0,0 +1,332 @@
+/******************************************************************************
+ * Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include <cassert>
+
+#include "Program.hpp"
+
+namespace pdal
+{
+
+namespace
+{
+
+bool anySet(const uint8_t *mask, point_count_t count)
+{
+    for (point_count_t i = 0; i < count; ++i)
+        if (mask[i])
+            return true;
+    return false;
+}
+
+bool allSet(const uint8_t *mask, point_count_t count)
+{
+    for (point_count_t i = 0; i < count; ++i)
+        if (!mask[i])
+            return false;
+    return true;
+}
+
+void invert(uint8_t *mask, point_count_t count)
+{
+    for (point_count_t i = 0; i < count; ++i)
+        mask[i] = !mask[i];
+}
+
+} // unnamed namespace
+
+const point_count_t Program::BatchSize;
+
+
+size_t Program::addNode(const Node& node)
+{
+    size_t idx = m_nodes.size();
+
+    m_nodes.push_back(node);
+    if (!m_pending.empty())
+        m_pending.back().push_back(idx);
+    return idx;
+}
+
+
+void Program::beginGate(LogicalOperator op)
+{
+    Node n {};
+
+    n.m_isGate = true;
+    n.m_gateOp = op;
+    m_open.push_back(addNode(n));
+    m_pending.push_back(std::vector<size_t>());
+}
+
+
+void Program::endGate()
+{
+    Node& n = m_nodes[m_open.back()];
+    std::vector<size_t>& kids = m_pending.back();
+
+    n.m_kidPos = m_kids.size();
+    n.m_kidCount = kids.size();
+    m_kids.insert(m_kids.end(), kids.begin(), kids.end());
+    m_pending.pop_back();
+    m_open.pop_back();
+}
+
+
+void Program::addSingle(ComparisonType type, Dimension::Id dim,
+    const Operand& operand)
+{
+    Node n {};
+
+    n.m_cmpType = type;
+    n.m_col = column(dim);
+    if (operand.isConstant())
+    {
+        n.m_rhsCol = -1;
+        n.m_value = operand.value();
+    }
+    else
+        n.m_rhsCol = column(operand.dim());
+    addNode(n);
+}
+
+
+void Program::addMulti(ComparisonType type, Dimension::Id dim,
+    const Operands& operands)
+{
+    Node n {};
+
+    n.m_cmpType = type;
+    n.m_col = column(dim);
+    n.m_rhsCol = -1;
+    n.m_opPos = m_operands.size();
+    n.m_opCount = operands.size();
+    for (const Operand& op : operands)
+    {
+        OperandSlot slot;
+
+        if (op.isConstant())
+        {
+            slot.m_col = -1;
+            slot.m_value = op.value();
+        }
+        else
+        {
+            slot.m_col = column(op.dim());
+            slot.m_value = 0;
+        }
+        m_operands.push_back(slot);
+    }
+    addNode(n);
+}
+
+
+/// Find or create the column slot for a dimension.
+int Program::column(Dimension::Id dim)
+{
+    for (size_t i = 0; i < m_dims.size(); ++i)
+        if (m_dims[i] == dim)
+            return (int)i;
+    m_dims.push_back(dim);
+    m_columns.push_back(std::vector<double>(BatchSize));
+    m_fetched.push_back(false);
+    return (int)(m_dims.size() - 1);
+}
+
+
+const double *Program::fetch(const PointView& view, int col, PointId start,
+    point_count_t count)
+{
+    if (!m_fetched[col])
+    {
+        view.getFieldBatch(m_dims[col], start, count, m_columns[col].data());
+        m_fetched[col] = true;
+    }
+    return m_columns[col].data();
+}
+
+
+void Program::run(const PointView& view, PointId start, point_count_t count,
+    uint8_t *mask)
+{
+    assert(count <= BatchSize);
+
+    m_fetched.assign(m_fetched.size(), false);
+    eval(view, 0, start, count, mask);
+}
+
+
+void Program::eval(const PointView& view, size_t node, PointId start,
+    point_count_t count, uint8_t *mask)
+{
+    const Node& n = m_nodes[node];
+
+    if (n.m_isGate)
+    {
+        std::vector<uint8_t> tmp(count);
+
+        switch (n.m_gateOp)
+        {
+        case LogicalOperator::lAnd:
+            std::fill(mask, mask + count, 1);
+            for (size_t k = 0; k < n.m_kidCount; ++k)
+            {
+                // Once every point in the block has failed, further
+                // children can't change the outcome.
+                if (!anySet(mask, count))
+                    break;
+                eval(view, m_kids[n.m_kidPos + k], start, count, tmp.data());
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] &= tmp[i];
+            }
+            break;
+        case LogicalOperator::lOr:
+        case LogicalOperator::lNor:
+            std::fill(mask, mask + count, 0);
+            for (size_t k = 0; k < n.m_kidCount; ++k)
+            {
+                if (allSet(mask, count))
+                    break;
+                eval(view, m_kids[n.m_kidPos + k], start, count, tmp.data());
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] |= tmp[i];
+            }
+            if (n.m_gateOp == LogicalOperator::lNor)
+                invert(mask, count);
+            break;
+        case LogicalOperator::lNot:
+            eval(view, m_kids[n.m_kidPos], start, count, mask);
+            invert(mask, count);
+            break;
+        }
+        return;
+    }
+
+    const double *a = fetch(view, n.m_col, start, count);
+
+    if (isSingle(n.m_cmpType))
+    {
+        if (n.m_rhsCol >= 0)
+        {
+            const double *b = fetch(view, n.m_rhsCol, start, count);
+
+            switch (n.m_cmpType)
+            {
+            case ComparisonType::eq:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] == b[i]);
+                break;
+            case ComparisonType::gt:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] > b[i]);
+                break;
+            case ComparisonType::gte:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] >= b[i]);
+                break;
+            case ComparisonType::lt:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] < b[i]);
+                break;
+            case ComparisonType::lte:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] <= b[i]);
+                break;
+            case ComparisonType::ne:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] != b[i]);
+                break;
+            default:
+                break;
+            }
+        }
+        else
+        {
+            double b = n.m_value;
+
+            switch (n.m_cmpType)
+            {
+            case ComparisonType::eq:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] == b);
+                break;
+            case ComparisonType::gt:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] > b);
+                break;
+            case ComparisonType::gte:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] >= b);
+                break;
+            case ComparisonType::lt:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] < b);
+                break;
+            case ComparisonType::lte:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] <= b);
+                break;
+            case ComparisonType::ne:
+                for (point_count_t i = 0; i < count; ++i)
+                    mask[i] = (a[i] != b);
+                break;
+            default:
+                break;
+            }
+        }
+        return;
+    }
+
+    // $in/$nin - a match against any of the operands.
+    std::fill(mask, mask + count, 0);
+    for (size_t o = 0; o < n.m_opCount; ++o)
+    {
+        const OperandSlot& slot = m_operands[n.m_opPos + o];
+
+        if (slot.m_col >= 0)
+        {
+            const double *b = fetch(view, slot.m_col, start, count);
+
+            for (point_count_t i = 0; i < count; ++i)
+                mask[i] |= (a[i] == b[i]);
+        }
+        else
+            for (point_count_t i = 0; i < count; ++i)
+                mask[i] |= (a[i] == slot.m_value);
+    }
+    if (n.m_cmpType == ComparisonType::nin)
+        invert(mask, count);
+}
+
+} // namespace pdal
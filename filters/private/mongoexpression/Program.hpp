@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <pdal/PointView.hpp>
+
+#include "Comparison.hpp"
+#include "LogicGate.hpp"
+
+namespace pdal
+{
+
+/// A mongo expression flattened into typed nodes, so that blocks of
+/// points can be checked without per-point virtual dispatch.
+/// Comparisons evaluate over dimension columns fetched through the
+/// batched field API; gates combine the resulting masks and skip
+/// remaining children once a block's outcome is settled.  Columns are
+/// fetched lazily, so a short-circuited child never touches its
+/// dimensions.
+class Program
+{
+public:
+    /// Maximum number of points evaluated per call to run().
+    static const point_count_t BatchSize = 4096;
+
+    /// Compilation interface, driven by Filterable::flatten().
+    void beginGate(LogicalOperator op);
+    void endGate();
+    void addSingle(ComparisonType type, Dimension::Id dim,
+        const Operand& operand);
+    void addMulti(ComparisonType type, Dimension::Id dim,
+        const Operands& operands);
+
+    /// Evaluate the program for points [start, start + count) of a view,
+    /// setting each mask entry to 0 or 1.  count must not exceed
+    /// BatchSize.
+    void run(const PointView& view, PointId start, point_count_t count,
+        uint8_t *mask);
+
+private:
+    struct Node
+    {
+        bool m_isGate;
+        LogicalOperator m_gateOp;
+        size_t m_kidPos;        ///< Children, as a run in m_kids.
+        size_t m_kidCount;
+
+        ComparisonType m_cmpType;
+        int m_col;              ///< Column of the LHS dimension.
+        int m_rhsCol;           ///< Column of a dimension RHS, or -1.
+        double m_value;         ///< Constant RHS when m_rhsCol is -1.
+        size_t m_opPos;         ///< Operand slots for $in/$nin.
+        size_t m_opCount;
+    };
+
+    /// One RHS alternative of an $in/$nin comparison.
+    struct OperandSlot
+    {
+        int m_col;              ///< Column of a dimension RHS, or -1.
+        double m_value;         ///< Constant when m_col is -1.
+    };
+
+    size_t addNode(const Node& node);
+    int column(Dimension::Id dim);
+    const double *fetch(const PointView& view, int col, PointId start,
+        point_count_t count);
+    void eval(const PointView& view, size_t node, PointId start,
+        point_count_t count, uint8_t *mask);
+
+    std::vector<Node> m_nodes;
+    std::vector<size_t> m_kids;
+    std::vector<OperandSlot> m_operands;
+    std::vector<Dimension::Id> m_dims;      ///< Dimension per column.
+
+    // Compilation state - the open gates and their pending child lists.
+    std::vector<size_t> m_open;
+    std::vector<std::vector<size_t>> m_pending;
+
+    // Per-block evaluation state.
+    std::vector<std::vector<double>> m_columns;
+    std::vector<bool> m_fetched;
+};
+
+} // namespace pdal
@@ -50,10 +50,15 @@ public:
     virtual std::string toString(std::string prefix) const = 0;
 };
 
+class Program;
+
 class Filterable : public Loggable
 {
 public:
     virtual bool operator()(const PointRef& pr) const = 0;
+
+    /// Append this node to a flattened evaluation program.
+    virtual void flatten(Program& prog) const = 0;
 };
 
 class Comparable : public Loggable
@@ -64,6 +64,16 @@ public:
     */
     Point origin() const
         { return { m_xOrigin, m_yOrigin }; }
+    /**
+      Return the width of the grid in cells.
+    */
+    size_t width() const
+        { return m_width; }
+    /**
+      Return the height of the grid in cells.
+    */
+    size_t height() const
+        { return m_height; }
     /**
       Return the cell width.
     */
@@ -56,6 +56,32 @@ public:
     bool inside(const Point& p) const
     { return inside(p.first, p.second); }
 
+    // Bounding box of the polygon's outer ring.  Useful as a cheap
+    // prefilter before running inside().
+    double xMin() const
+        { return m_xMin; }
+    double xMax() const
+        { return m_xMax; }
+    double yMin() const
+        { return m_yMin; }
+    double yMax() const
+        { return m_yMax; }
+
+    // Compute the reference point and status of every grid cell up front.
+    // inside() fills in cell state lazily, so an unprepared GridPnp can't
+    // be shared between threads; after preparation, inside() only reads.
+    void prepare()
+    {
+        for (size_t x = 0; x < m_grid->width(); ++x)
+            for (size_t y = 0; y < m_grid->height(); ++y)
+            {
+                XYIndex idx(x, y);
+                Cell& cell = m_grid->cell(idx);
+                if (!cell.computed())
+                    computeCell(cell, idx);
+            }
+    }
+
     // Determine if a point is inside the polygon attached to this class.
     bool inside(double x, double y) const
     {
@@ -78,6 +104,17 @@ public:
         return testCell(cell, x, y);
     }
 
+    // Batch counterpart of inside(): test 'count' points and write one
+    // flag per point.  Callers holding coordinate arrays avoid the
+    // per-point call overhead, and with the cells prepared (see
+    // prepare()) batches may run concurrently on multiple threads.
+    void inside(const double *x, const double *y, bool *result,
+        size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+            result[i] = inside(x[i], y[i]);
+    }
+
 private:
     using XYIndex = std::pair<size_t, size_t>;
     using Edge = std::pair<Point, Point>;
@@ -101,6 +138,18 @@ private:
 
         void addEdge(size_t edge)
             { m_edges.push_back(edge); }
+        // Pack an edge's endpoints (x1, y1, x2, y2) contiguously so the
+        // crossing loop in testCell() streams sequential memory instead
+        // of chasing indices into the ring list.
+        void addPackedEdge(const Point& p1, const Point& p2)
+        {
+            m_packed.push_back(p1.first);
+            m_packed.push_back(p1.second);
+            m_packed.push_back(p2.first);
+            m_packed.push_back(p2.second);
+        }
+        const std::vector<double>& packedEdges() const
+            { return m_packed; }
         bool empty() const
             { return m_edges.empty(); }
         void setPoint(double x, double y)
@@ -118,6 +167,7 @@ private:
 
     private:
         std::vector<size_t> m_edges;
+        std::vector<double> m_packed;
         bool m_inside;
         GridPnp::Point m_point;
     };
@@ -350,6 +400,8 @@ private:
     {
         generateRefPoint(cell, pos);
         determinePointStatus(cell, pos);
+        for (auto edgeId : cell.edges())
+            cell.addPackedEdge(point1(edgeId), point2(edgeId));
     }
 
 
@@ -448,20 +500,42 @@ private:
 
     // Determine if a point in a cell is inside the polygon or outside.
     // We're always calling a point that lies on an edge as 'inside'
-    // the polygon.
+    // the polygon.  This is the same segment-intersection math as
+    // intersects(), inlined over the cell's packed endpoints so the
+    // cross products run down contiguous arrays the compiler can
+    // vectorize; the tester segment goes from the query point to the
+    // cell's reference point.
     bool testCell(Cell& cell, double x, double y) const
     {
-        Edge tester({x, y}, cell.point());
+        const Point& ref = cell.point();
+        const double rx = xval(ref) - x;
+        const double ry = yval(ref) - y;
 
         bool inside = cell.inside();
-        for (auto edgeIdx: cell.edges())
+        const std::vector<double>& e = cell.packedEdges();
+        for (size_t i = 0; i < e.size(); i += 4)
         {
-            Edge other{ point1(edgeIdx), point2(edgeIdx) };
-            IntersectType intersection = intersects(tester, other);
-            if (intersection == IntersectType::On)
-                return true;
-            if (intersection == IntersectType::Cross)
+            double sx = e[i + 2] - e[i];
+            double sy = e[i + 3] - e[i + 1];
+            double pqx = e[i] - x;
+            double pqy = e[i + 1] - y;
+
+            double rCrossS = rx * sy - ry * sx;
+            double t = (pqx * sy - pqy * sx) / rCrossS;
+            bool tCloseEnough = Comparison::closeEnough(t, 0) ||
+                Comparison::closeEnough(t, 1);
+            if (!tCloseEnough && (t <= 0 || t >= 1))
+                continue;
+
+            double u = (pqx * ry - pqy * rx) / rCrossS;
+            bool uCloseEnough = Comparison::closeEnough(u, 0) ||
+                Comparison::closeEnough(u, 1);
+            if (uCloseEnough || (u > 0 && u < 1))
+            {
+                if (uCloseEnough || tCloseEnough)
+                    return true;
                 inside = !inside;
+            }
         }
         return inside;
     }
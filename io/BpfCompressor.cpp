@@ -128,6 +128,33 @@ void BpfCompressor::finish()
     blockEnd.rewind();
 }
 
+void BpfCompressor::compressBlock(const char *in, size_t size,
+    std::vector<unsigned char>& out)
+{
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    if (deflateInit(&strm, Z_DEFAULT_COMPRESSION) != Z_OK)
+        throw error("Could not initialize BPF compressor.");
+
+    // deflateBound() gives the worst case for a single-shot deflate, so
+    // one call consumes the whole block.
+    out.resize(deflateBound(&strm, (uLong)size));
+    strm.avail_in = (uInt)size;
+    strm.next_in = (unsigned char *)in;
+    strm.avail_out = (uInt)out.size();
+    strm.next_out = out.data();
+    int ret = ::deflate(&strm, Z_FINISH);
+    if (ret != Z_STREAM_END)
+    {
+        deflateEnd(&strm);
+        throw error("Couldn't close BPF compression stream.");
+    }
+    out.resize(out.size() - strm.avail_out);
+    deflateEnd(&strm);
+}
+
 #else
 
 void BpfCompressor::startBlock()
@@ -136,6 +163,9 @@ void BpfCompressor::compress()
 {}
 void BpfCompressor::finish()
 {}
+void BpfCompressor::compressBlock(const char *, size_t,
+    std::vector<unsigned char>&)
+{}
 
 #endif // PDAL_HAVE_ZLIB
 
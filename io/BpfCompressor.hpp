@@ -36,6 +36,7 @@
 
 #include <stdexcept>
 #include <ostream>
+#include <vector>
 
 #include <pdal/pdal_features.hpp>
 #include <pdal/util/Charbuf.hpp>
@@ -71,6 +72,12 @@ public:
     void finish();
     void compress();
 
+    // Deflate a complete block held in memory.  Lets the dimension-major
+    // writer compress per-dimension blocks on worker threads and write
+    // the finished blocks in order afterwards.
+    static void compressBlock(const char *in, size_t size,
+        std::vector<unsigned char>& out);
+
 private:
     static const int CHUNKSIZE = 1000000;
 
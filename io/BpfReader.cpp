@@ -35,9 +35,13 @@
 #include "BpfReader.hpp"
 
 #include <climits>
+#include <thread>
 
 #include <pdal/Options.hpp>
+#include <pdal/PDALUtils.hpp>
 #include <pdal/pdal_features.hpp>
+#include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #ifdef PDAL_HAVE_ZLIB
 #include <zlib.h>
@@ -92,6 +96,13 @@ QuickInfo BpfReader::inspect()
 }
 
 
+void BpfReader::addArgs(ProgramArgs& args)
+{
+    args.add("mmap", "Memory-map the file and serve reads directly from "
+        "the mapping", m_mmap);
+}
+
+
 // When the stage is intialized, the schema needs to be populated with the
 // dimensions in order to allow subsequent stages to be aware of or append to
 // the dimensions in the PointView.
@@ -201,6 +212,14 @@ void BpfReader::addDimensions(PointLayoutPtr layout)
     for (size_t i = 0; i < m_dims.size(); ++i)
     {
         BpfDimension& dim = m_dims[i];
+        // Dimensions pruned by pushdown (see Reader::keepDim()) keep an
+        // unknown ID - the read loops still consume their data but the
+        // assignment to point memory is a no-op.
+        if (!keepDim(dim.m_label))
+        {
+            dim.m_id = Dimension::Id::Unknown;
+            continue;
+        }
         dim.m_id = layout->registerOrAssignDim(dim.m_label,
             Dimension::Type::Float);
     }
@@ -268,8 +287,18 @@ bool BpfReader::readPolarData()
 
 void BpfReader::ready(PointTableRef)
 {
-    m_istreamPtr = Utils::openFile(m_filename);
-    m_stream = ILeStream(m_istreamPtr);
+    if (m_mmap && !Utils::isRemote(m_filename))
+    {
+        m_istreamPtr = NULL;
+        m_stream = ILeStream(m_filename, true);
+        if (!m_stream.good())
+            throwError("Can't open file '" + m_filename + "'.");
+    }
+    else
+    {
+        m_istreamPtr = Utils::openFile(m_filename);
+        m_stream = ILeStream(m_istreamPtr);
+    }
     m_stream.seek(m_header.m_len);
     m_index = 0;
     m_start = m_stream.position();
@@ -277,13 +306,69 @@ void BpfReader::ready(PointTableRef)
     if (m_header.m_compression)
     {
         m_deflateBuf.resize(numPoints() * m_dims.size() * sizeof(float));
+
+        // Blocks are independent zlib streams and each block's output
+        // offset is known once its header is read, so the compressed
+        // payloads are gathered serially and inflated concurrently.
+        struct Block
+        {
+            std::vector<char> in;
+            size_t outIndex;
+            uint32_t finalBytes;
+        };
+        std::vector<Block> blocks;
+
         size_t index = 0;
-        size_t bytesRead = 0;
-        do
+        while (index < m_deflateBuf.size())
+        {
+            uint32_t finalBytes;
+            uint32_t compressBytes;
+
+            m_stream >> finalBytes;
+            m_stream >> compressBytes;
+            if (!m_stream || finalBytes == 0 ||
+                index + finalBytes > m_deflateBuf.size())
+                break;
+
+            Block b;
+            b.in.resize(compressBytes);
+            m_stream.get(b.in);
+            b.outIndex = index;
+            b.finalBytes = finalBytes;
+            blocks.push_back(std::move(b));
+            index += finalBytes;
+        }
+
+        auto inflateBlock = [this](Block& b)
+        {
+            if (inflate(b.in.data(), (uint32_t)b.in.size(),
+                    m_deflateBuf.data() + b.outIndex, b.finalBytes))
+                throw pdal_error("Couldn't inflate BPF block.");
+        };
+
+        size_t threads = std::thread::hardware_concurrency();
+        if (blocks.size() > 1 && threads > 1)
+        {
+            ThreadPool pool((std::min)(threads, blocks.size()));
+            for (Block& b : blocks)
+                pool.add([&inflateBlock, &b]()
+                    { inflateBlock(b); });
+            pool.join();
+            if (pool.errors().size())
+                throwError(pool.errors().front());
+        }
+        else
         {
-            bytesRead = readBlock(m_deflateBuf, index);
-            index += bytesRead;
-        } while (bytesRead > 0 && index < m_deflateBuf.size());
+            try
+            {
+                for (Block& b : blocks)
+                    inflateBlock(b);
+            }
+            catch (const pdal_error& err)
+            {
+                throwError(err.what());
+            }
+        }
         m_charbuf.initialize(m_deflateBuf.data(), m_deflateBuf.size(), m_start);
         m_stream.pushStream(new std::istream(&m_charbuf));
     }
@@ -351,6 +436,12 @@ void BpfReader::readPointMajor(PointRef& point)
     {
         float f;
 
+        // Pruned by pushdown - just advance past the value.
+        if (m_dims[dim].m_id == Dimension::Id::Unknown)
+        {
+            m_stream.skip(sizeof(float));
+            continue;
+        }
         m_stream >> f;
         double d = f + m_dims[dim].m_offset;
         if (m_dims[dim].m_id == Dimension::Id::X)
@@ -383,6 +474,12 @@ point_count_t BpfReader::readPointMajor(PointViewPtr view, point_count_t count)
         {
             float f;
 
+            // Pruned by pushdown - just advance past the value.
+            if (m_dims[d].m_id == Dimension::Id::Unknown)
+            {
+                m_stream.skip(sizeof(float));
+                continue;
+            }
             m_stream >> f;
             view->setField(m_dims[d].m_id, nextId, f + m_dims[d].m_offset);
         }
@@ -453,6 +550,9 @@ void BpfReader::readDimMajor(PointRef& point)
 
     for (size_t dim = 0; dim < m_dims.size(); ++dim)
     {
+        // Pruned by pushdown - this dimension's stream is never consumed.
+        if (m_dims[dim].m_id == Dimension::Id::Unknown)
+            continue;
         *m_streams[dim] >> f;
         d = f + m_dims[dim].m_offset;
         if (m_dims[dim].m_id == Dimension::Id::X)
@@ -484,6 +584,14 @@ point_count_t BpfReader::readDimMajor(PointViewPtr data, point_count_t count)
         idx = m_index;
         PointId nextId = startId;
         numRead = 0;
+        // Pruned by pushdown - account for the points we would have read
+        // but don't touch this dimension's data at all.
+        if (m_dims[d].m_id == Dimension::Id::Unknown)
+        {
+            numRead = (std::min)(count, numPoints() - idx);
+            idx += numRead;
+            continue;
+        }
         seekDimMajor(d, idx);
         for (; numRead < count && idx < numPoints(); idx++, numRead++, nextId++)
         {
@@ -527,6 +635,10 @@ void BpfReader::readByteMajor(PointRef& point)
 
     for (size_t dim = 0; dim < m_dims.size(); ++dim)
     {
+        // Pruned by pushdown - every byte is located by seeking, so the
+        // dimension can be skipped entirely.
+        if (m_dims[dim].m_id == Dimension::Id::Unknown)
+            continue;
         u.u32 = 0;
         for (size_t b = 0; b < sizeof(float); ++b)
         {
@@ -571,6 +683,14 @@ point_count_t BpfReader::readByteMajor(PointViewPtr data, point_count_t count)
 
     for (size_t d = 0; d < m_dims.size(); ++d)
     {
+        // Pruned by pushdown - account for the points we would have read
+        // but don't touch this dimension's data at all.
+        if (m_dims[d].m_id == Dimension::Id::Unknown)
+        {
+            numRead = (std::min)(count, numPoints() - m_index);
+            idx = m_index + numRead;
+            continue;
+        }
         for (size_t b = 0; b < sizeof(float); ++b)
         {
             idx = m_index;
@@ -643,24 +763,6 @@ void BpfReader::seekByteMajor(size_t dimIdx, size_t byteIdx, PointId ptIdx)
 
 
 #ifdef PDAL_HAVE_ZLIB
-size_t BpfReader::readBlock(std::vector<char>& outBuf, size_t index)
-{
-    uint32_t finalBytes;
-    uint32_t compressBytes;
-
-    m_stream >> finalBytes;
-    m_stream >> compressBytes;
-
-    std::vector<char> in(compressBytes);
-
-    // Fill the input bytes from the stream.
-    m_stream.get(in);
-    int ret = inflate(in.data(), compressBytes,
-        outBuf.data() + index, finalBytes);
-    return (ret ? 0 : finalBytes);
-}
-
-
 int BpfReader::inflate(char *buf, uint32_t insize,
     char *outbuf, uint32_t outsize)
 {
@@ -64,6 +64,7 @@ public:
 private:
     std::istream* m_istreamPtr;
     ILeStream m_stream;
+    bool m_mmap;
     BpfHeader m_header;
     BpfDimensionList m_dims;
     Dimension::IdList m_schemaDims;
@@ -85,6 +86,7 @@ private:
     std::vector<std::unique_ptr<Charbuf>> m_charbufs;
 
     virtual QuickInfo inspect();
+    virtual void addArgs(ProgramArgs& args);
     virtual void initialize();
     virtual void addDimensions(PointLayoutPtr Layout);
     virtual void ready(PointTableRef table);
@@ -102,7 +104,6 @@ private:
     point_count_t readDimMajor(PointViewPtr data, point_count_t count);
     void readByteMajor(PointRef& point);
     point_count_t readByteMajor(PointViewPtr data, point_count_t count);
-    size_t readBlock(std::vector<char>& outBuf, size_t index);
     bool eof();
     int inflate(char *inbuf, uint32_t insize, char *outbuf, uint32_t outsize);
 
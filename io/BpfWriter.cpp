@@ -35,10 +35,13 @@
 #include "BpfWriter.hpp"
 
 #include <climits>
+#include <cstring>
+#include <thread>
 
 #include <pdal/Options.hpp>
 #include <pdal/util/FileUtils.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "BpfCompressor.hpp"
 #include <pdal/util/Utils.hpp>
@@ -85,6 +88,11 @@ void BpfWriter::addArgs(ProgramArgs& args)
 {
     args.add("filename", "Output filename", m_filename).setPositional();
     args.add("compression", "Output compression", m_compression);
+    args.add("threads", "Number of threads used to compress dimension "
+        "blocks when writing dim-major output (0 = choose automatically)",
+        m_threads);
+    args.add("write_behind", "Buffer output and write it to the file from "
+        "a background thread", m_writeBehind);
     args.add("header_data", "Base64-encoded header data", m_extraDataSpec);
     args.add("format", "Output format", m_header.m_pointFormat,
         BpfFormat::DimMajor);
@@ -96,6 +104,23 @@ void BpfWriter::addArgs(ProgramArgs& args)
 }
 
 
+bool BpfWriter::usedDims(StringList& used) const
+{
+    // Without an explicit dimension list every layout dimension is
+    // written.  Called before options are parsed, so read the raw option.
+    StringList dims = m_options.getValues("output_dims");
+    if (dims.empty())
+        return false;
+    for (const std::string& d : dims)
+        for (std::string name : Utils::split2(d, ','))
+        {
+            Utils::trim(name);
+            used.push_back(name);
+        }
+    return true;
+}
+
+
 void BpfWriter::initialize()
 {
     m_header.m_coordId = m_coordId.m_val;
@@ -150,7 +175,7 @@ void BpfWriter::readyFile(const std::string& filename,
     const SpatialReference& srs)
 {
     m_curFilename = filename;
-    m_stream.open(filename);
+    m_stream.open(filename, m_writeBehind);
     m_header.m_version = 3;
     m_header.m_numDim = m_dims.size();
     m_header.m_numPts = 0;
@@ -305,22 +330,82 @@ void BpfWriter::writePointMajor(const PointView* data)
 void BpfWriter::writeDimMajor(const PointView* data)
 {
     // We're going to pretend for now that we only ever have one point buffer.
-    BpfCompressor compressor(m_stream, data->size() * sizeof(float));
+    if (m_header.m_compression)
+    {
+        writeDimMajorCompressed(data);
+        return;
+    }
 
+    // Gather each dimension's column a block at a time - one virtual call
+    // per block instead of one per value.
+    const point_count_t BlockPoints = 10000;
+    std::vector<double> vals((std::min)(BlockPoints, data->size()));
     for (auto & bpfDim : m_dims)
     {
-        if (m_header.m_compression)
-            compressor.startBlock();
-        for (PointId idx = 0; idx < data->size(); ++idx)
+        for (PointId start = 0; start < data->size(); start += BlockPoints)
         {
-            double d = getAdjustedValue(data, bpfDim, idx);
-            m_stream << (float)d;
+            point_count_t n = (std::min)(BlockPoints, data->size() - start);
+            data->getFieldBatch(bpfDim.m_id, start, n, vals.data());
+            adjustValues(bpfDim, vals.data(), n);
+            for (point_count_t i = 0; i < n; ++i)
+                m_stream << (float)vals[i];
         }
-        if (m_header.m_compression)
+    }
+}
+
+
+size_t BpfWriter::threadCount(point_count_t np) const
+{
+    // Work splits by dimension; the point count just gates whether
+    // threading pays off at all.
+    return (std::min)(pdal::threadCount(m_threads, np), m_dims.size());
+}
+
+
+void BpfWriter::writeDimMajorCompressed(const PointView* data)
+{
+    // Each dimension's column is a single compressed block, so the blocks
+    // can be gathered and deflated concurrently.  Only the ordered write
+    // of the finished blocks below touches the output stream.
+    point_count_t numPts = data->size();
+    std::vector<std::vector<unsigned char>> blocks(m_dims.size());
+
+    size_t threads = threadCount(numPts);
+    ThreadPool pool(threads, threads);
+    for (size_t d = 0; d < m_dims.size(); ++d)
+    {
+        pool.add([this, data, numPts, d, &blocks]()
         {
-            compressor.compress();
-            compressor.finish();
-        }
+            // Each task owns its dimension, including the min/max
+            // tracked on the BpfDimension.
+            BpfDimension& bpfDim = m_dims[d];
+            std::vector<double> vals(numPts);
+            data->getFieldBatch(bpfDim.m_id, 0, numPts, vals.data());
+            adjustValues(bpfDim, vals.data(), numPts);
+
+            // The block holds little-endian floats - match what the
+            // stream operator would have written.
+            std::vector<uint32_t> col(numPts);
+            for (point_count_t i = 0; i < numPts; ++i)
+            {
+                float f = (float)vals[i];
+                uint32_t tmp;
+                std::memcpy(&tmp, &f, sizeof(f));
+                col[i] = htole32(tmp);
+            }
+            BpfCompressor::compressBlock((const char *)col.data(),
+                numPts * sizeof(float), blocks[d]);
+        });
+    }
+    pool.join();
+    if (pool.errors().size())
+        throw BpfCompressor::error(pool.errors().front());
+
+    for (size_t d = 0; d < m_dims.size(); ++d)
+    {
+        m_stream << (uint32_t)(numPts * sizeof(float)) <<
+            (uint32_t)blocks[d].size();
+        m_stream.put(blocks[d].data(), blocks[d].size());
     }
 }
 
@@ -376,6 +461,28 @@ double BpfWriter::getAdjustedValue(const PointView* data,
 }
 
 
+// Batch form of getAdjustedValue() - adjusts a gathered column in place.
+void BpfWriter::adjustValues(BpfDimension& bpfDim, double *vals,
+    point_count_t count)
+{
+    double scale = 1.0;
+    if (bpfDim.m_id == Dimension::Id::X)
+        scale = m_scaling.m_xXform.m_scale.m_val;
+    else if (bpfDim.m_id == Dimension::Id::Y)
+        scale = m_scaling.m_yXform.m_scale.m_val;
+    else if (bpfDim.m_id == Dimension::Id::Z)
+        scale = m_scaling.m_zXform.m_scale.m_val;
+
+    for (point_count_t i = 0; i < count; ++i)
+    {
+        double d = vals[i];
+        bpfDim.m_min = (std::min)(bpfDim.m_min, d);
+        bpfDim.m_max = (std::max)(bpfDim.m_max, d);
+        vals[i] = (d / scale) - bpfDim.m_offset;
+    }
+}
+
+
 void BpfWriter::doneFile()
 {
     // Rewrite the header to update the the correct number of points and
@@ -70,12 +70,15 @@ private:
     std::vector<uint8_t> m_extraData;
     std::vector<BpfUlemFile> m_bundledFiles;
     bool m_compression;
+    bool m_writeBehind;
+    size_t m_threads;
     CoordId m_coordId;
     std::string m_extraDataSpec;
     StringList m_bundledFilesSpec;
     std::string m_curFilename;
 
     virtual void addArgs(ProgramArgs& args);
+    virtual bool usedDims(StringList& used) const;
     virtual void initialize();
     virtual void prepared(PointTableRef table);
     virtual void readyFile(const std::string& filename,
@@ -86,9 +89,13 @@ private:
 
     double getAdjustedValue(const PointView* data, BpfDimension& bpfDim,
         PointId idx);
+    void adjustValues(BpfDimension& bpfDim, double *vals,
+        point_count_t count);
+    size_t threadCount(point_count_t np) const;
     void loadBpfDimensions(PointLayoutPtr layout);
     void writePointMajor(const PointView* data);
     void writeDimMajor(const PointView* data);
+    void writeDimMajorCompressed(const PointView* data);
     void writeByteMajor(const PointView* data);
     void writeCompressedBlock(char *buf, size_t size);
 };
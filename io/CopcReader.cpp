@@ -0,0 +1,480 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "CopcReader.hpp"
+
+#include <limits>
+
+#include <pdal/PDALUtils.hpp>
+#include <pdal/PointView.hpp>
+#include <pdal/QuickInfo.hpp>
+#include <pdal/compression/LazPerfVlrCompression.hpp>
+#include <pdal/util/Charbuf.hpp>
+#include <pdal/util/Extractor.hpp>
+#include <pdal/util/IStream.hpp>
+#include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+#include <arbiter/arbiter.hpp>
+
+namespace pdal
+{
+
+namespace
+{
+
+const char COPC_USER_ID[] = "copc";
+const uint16_t COPC_INFO_RECORD_ID = 1;
+
+const size_t LasHeaderSize = 375;
+const size_t CopcInfoSize = 160;
+const size_t HierarchyEntrySize = 32;
+
+} // unnamed namespace
+
+static StaticPluginInfo const s_info {
+    "readers.copc",
+    "Cloud-optimized LAZ (COPC) read support.  Fetches and decodes \n" \
+        "only the octree nodes overlapping the requested bounds and \n" \
+        "resolution.",
+    "http://pdal.io/stages/readers.copc.html",
+    { "copc" }
+};
+
+CREATE_STATIC_STAGE(CopcReader, s_info)
+
+std::string CopcReader::getName() const { return s_info.name; }
+
+
+CopcReader::CopcReader() : m_isRemote(false), m_decompressor(nullptr),
+    m_haveQueryBounds(false), m_depthEnd(0)
+{}
+
+
+CopcReader::~CopcReader()
+{
+#ifdef PDAL_HAVE_LAZPERF
+    delete m_decompressor;
+#endif
+}
+
+
+void CopcReader::addArgs(ProgramArgs& args)
+{
+    args.add("bounds", "Bounds to fetch", m_bounds);
+    args.add("resolution", "Lowest point spacing at which nodes are "
+        "fetched - halves with each octree level", m_resolution, 0.0);
+    args.add("threads", "Number of worker threads", m_threads, (size_t)4);
+}
+
+
+void CopcReader::initialize()
+{
+#ifndef PDAL_HAVE_LAZPERF
+    throwError("Can't read COPC file.  PDAL not built with LAZperf.");
+#endif
+
+    m_isRemote = Utils::isRemote(m_filename);
+    if (!m_isRemote)
+    {
+        if (m_stream.is_open())
+            m_stream.close();
+        m_stream.open(m_filename, std::ios::binary);
+        if (!m_stream)
+            throwError("Couldn't open file '" + m_filename + "'.");
+    }
+
+    parseHeader(fetch(0, LasHeaderSize));
+    parseVlrs();
+
+    m_haveQueryBounds = false;
+    if (m_bounds.is3d())
+        m_queryBounds = m_bounds.to3d();
+    else
+    {
+        BOX2D b = m_bounds.to2d();
+        if (b.valid())
+            m_queryBounds = BOX3D(b.minx, b.miny,
+                (std::numeric_limits<double>::lowest)(), b.maxx, b.maxy,
+                (std::numeric_limits<double>::max)());
+    }
+    m_haveQueryBounds = m_queryBounds.valid();
+
+    // Node spacing halves at each level, so the first level at or below
+    // the requested resolution bounds the tree depth.
+    m_depthEnd = 0;
+    if (m_resolution > 0)
+    {
+        m_depthEnd = 1;
+        for (double spacing = m_spacing; spacing > m_resolution; spacing /= 2)
+            m_depthEnd++;
+    }
+}
+
+
+std::vector<char> CopcReader::fetch(uint64_t offset, uint64_t size)
+{
+    if (m_isRemote)
+    {
+        arbiter::http::Headers headers;
+        headers["Range"] = "bytes=" + std::to_string(offset) + "-" +
+            std::to_string(offset + size - 1);
+        return Utils::globalArbiter().getBinary(m_filename, headers);
+    }
+
+    std::vector<char> buf(size);
+    std::lock_guard<std::mutex> lock(m_streamMutex);
+    m_stream.clear();
+    m_stream.seekg(offset);
+    m_stream.read(buf.data(), buf.size());
+    if (!m_stream.good())
+        throwError("Couldn't read " + std::to_string(size) + " bytes at "
+            "offset " + std::to_string(offset) + " from '" + m_filename +
+            "'.");
+    return buf;
+}
+
+
+// Parse what we need of the fixed header by hand - LasHeader's extraction
+// operator seeks off to read VLRs and EVLRs, which doesn't work over the
+// prefix we've fetched.
+void CopcReader::parseHeader(const std::vector<char>& buf)
+{
+    LeExtractor in(buf.data(), buf.size());
+
+    std::string magic;
+    in.get(magic, 4);
+    if (magic != "LASF")
+        throwError("Invalid LAS file signature in '" + m_filename + "'.");
+    in.skip(20);  // Source ID, global encoding, GUID.
+
+    uint8_t versionMajor, versionMinor;
+    in >> versionMajor >> versionMinor;
+    if (versionMajor != 1 || versionMinor != 4)
+        throwError("COPC files must be LAS version 1.4.");
+    in.skip(68);  // System/software ID, creation day/year.
+
+    in >> m_headerSize >> m_pointOffset >> m_vlrCount;
+    in >> m_pointFormat >> m_pointLen;
+    if (!(m_pointFormat & 0x80))
+        throwError("COPC files must be LAZ-compressed.");
+    m_pointFormat &= 0x7F;
+    if (m_pointFormat < 6 || m_pointFormat > 8)
+        throwError("COPC files must use point formats 6 through 8.");
+    in.skip(24);  // Legacy point counts.
+
+    in >> m_scale[0] >> m_scale[1] >> m_scale[2];
+    in >> m_offset[0] >> m_offset[1] >> m_offset[2];
+    double maxX, minX, maxY, minY, maxZ, minZ;
+    in >> maxX >> minX >> maxY >> minY >> maxZ >> minZ;
+    m_headerBounds = BOX3D(minX, minY, minZ, maxX, maxY, maxZ);
+    in.skip(20);  // Waveform offset, EVLR offset/count.
+
+    in >> m_pointCount;
+}
+
+
+void CopcReader::parseVlrs()
+{
+    std::vector<char> buf = fetch(m_headerSize, m_pointOffset - m_headerSize);
+    Charbuf charbuf(buf);
+    std::istream stream(&charbuf);
+    ILeStream in(&stream);
+
+    bool foundInfo = false;
+    for (uint32_t i = 0; i < m_vlrCount; ++i)
+    {
+        LasVLR vlr;
+        in >> vlr;
+        if (!stream.good())
+            throwError("Couldn't read VLRs from '" + m_filename + "'.");
+        if (vlr.matches(COPC_USER_ID, COPC_INFO_RECORD_ID))
+        {
+            parseCopcInfo(vlr);
+            foundInfo = true;
+        }
+        else if (vlr.matches(LASZIP_USER_ID, LASZIP_RECORD_ID))
+            m_lazVlrData.assign(vlr.data(), vlr.data() + vlr.dataLen());
+        else if (vlr.matches(TRANSFORM_USER_ID, WKT_RECORD_ID))
+        {
+            std::string wkt(vlr.data(), (size_t)vlr.dataLen());
+            while (wkt.size() && wkt.back() == '\0')
+                wkt.pop_back();
+            setSpatialReference(SpatialReference(wkt));
+        }
+    }
+    if (!foundInfo)
+        throwError("'" + m_filename + "' is not a COPC file - no COPC "
+            "info VLR found.");
+    if (m_lazVlrData.empty())
+        throwError("'" + m_filename + "' has no laszip VLR.");
+}
+
+
+void CopcReader::parseCopcInfo(const LasVLR& vlr)
+{
+    if (vlr.dataLen() < CopcInfoSize)
+        throwError("Invalid COPC info VLR in '" + m_filename + "'.");
+
+    LeExtractor in(vlr.data(), (size_t)vlr.dataLen());
+    in >> m_center[0] >> m_center[1] >> m_center[2];
+    in >> m_halfsize >> m_spacing;
+    in >> m_rootHierOffset >> m_rootHierSize;
+}
+
+
+BOX3D CopcReader::keyBounds(const VoxelKey& key) const
+{
+    double size = (2 * m_halfsize) / (double)((uint64_t)1 << key.m_level);
+    double minx = m_center[0] - m_halfsize + key.m_x * size;
+    double miny = m_center[1] - m_halfsize + key.m_y * size;
+    double minz = m_center[2] - m_halfsize + key.m_z * size;
+    return BOX3D(minx, miny, minz, minx + size, miny + size, minz + size);
+}
+
+
+bool CopcReader::overlaps(const VoxelKey& key) const
+{
+    if (m_depthEnd && (uint64_t)key.m_level >= m_depthEnd)
+        return false;
+    if (m_haveQueryBounds && !m_queryBounds.overlaps(keyBounds(key)))
+        return false;
+    return true;
+}
+
+
+void CopcReader::loadHierarchyPage(uint64_t offset, uint64_t size)
+{
+    std::vector<char> buf = fetch(offset, size);
+    LeExtractor in(buf.data(), buf.size());
+
+    size_t numEntries = buf.size() / HierarchyEntrySize;
+    for (size_t i = 0; i < numEntries; ++i)
+    {
+        Node n;
+        in >> n.m_key.m_level >> n.m_key.m_x >> n.m_key.m_y >> n.m_key.m_z;
+        in >> n.m_offset >> n.m_byteSize >> n.m_pointCount;
+
+        if (!overlaps(n.m_key))
+            continue;
+        // A point count of -1 marks a child page holding the voxel's
+        // subtree.
+        if (n.m_pointCount == -1 && n.m_byteSize > 0)
+            loadHierarchyPage(n.m_offset, n.m_byteSize);
+        else if (n.m_pointCount > 0)
+            m_nodes.push_back(n);
+    }
+}
+
+
+QuickInfo CopcReader::inspect()
+{
+    QuickInfo qi;
+    std::unique_ptr<PointLayout> layout(new PointLayout());
+
+    PointTable table;
+    initialize();
+    addDimensions(layout.get());
+
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
+    if (!Utils::numericCast(m_pointCount, qi.m_pointCount))
+        qi.m_pointCount = (std::numeric_limits<point_count_t>::max)();
+    qi.m_bounds = m_headerBounds;
+    qi.m_srs = getSpatialReference();
+    qi.m_valid = true;
+
+    done(table);
+
+    return qi;
+}
+
+
+void CopcReader::addDimensions(PointLayoutPtr layout)
+{
+    using namespace Dimension;
+
+    layout->registerDims( { Id::X, Id::Y, Id::Z, Id::Intensity,
+        Id::ReturnNumber, Id::NumberOfReturns, Id::ClassFlags,
+        Id::ScanChannel, Id::ScanDirectionFlag, Id::EdgeOfFlightLine,
+        Id::Classification, Id::ScanAngleRank, Id::UserData,
+        Id::PointSourceId, Id::GpsTime } );
+    if (m_pointFormat == 7 || m_pointFormat == 8)
+        layout->registerDims( { Id::Red, Id::Green, Id::Blue } );
+    if (m_pointFormat == 8)
+        layout->registerDim(Id::Infrared);
+}
+
+
+void CopcReader::ready(PointTableRef table)
+{
+#ifdef PDAL_HAVE_LAZPERF
+    delete m_decompressor;
+    m_decompressor =
+        new LazPerfChunkDecompressor((const char *)m_lazVlrData.data());
+#endif
+    m_pool.reset(new ThreadPool(m_threads));
+
+    m_nodes.clear();
+    loadHierarchyPage(m_rootHierOffset, m_rootHierSize);
+    log()->get(LogLevel::Debug) << getName() << ": " << m_nodes.size() <<
+        " overlapping nodes.\n";
+}
+
+
+point_count_t CopcReader::read(PointViewPtr view, point_count_t count)
+{
+    PointId start = view->size();
+
+    for (const Node& node : m_nodes)
+        m_pool->add([this, view, count, &node]()
+            { readNode(view, count, node); });
+    m_pool->await();
+    if (m_pool->errors().size())
+        throwError(m_pool->errors().front());
+
+    return view->size() - start;
+}
+
+
+// Fetch and decode a node's chunk.  Only the view fill needs the lock -
+// chunks are independently coded, so fetch and decompression run
+// concurrently across nodes.
+void CopcReader::readNode(PointViewPtr view, point_count_t count,
+    const Node& node)
+{
+#ifdef PDAL_HAVE_LAZPERF
+    std::vector<char> inbuf = fetch(node.m_offset, node.m_byteSize);
+
+    std::vector<char> outbuf((size_t)m_pointLen * node.m_pointCount);
+    m_decompressor->decompress(inbuf, node.m_pointCount, outbuf.data());
+
+    std::lock_guard<std::mutex> lock(m_viewMutex);
+    const char *pos = outbuf.data();
+    for (int32_t i = 0; i < node.m_pointCount && view->size() < count; ++i)
+    {
+        loadPoint(*view, pos);
+        pos += m_pointLen;
+    }
+#else
+    (void)view;
+    (void)count;
+    (void)node;
+#endif
+}
+
+
+void CopcReader::loadPoint(PointView& view, const char *buf)
+{
+    LeExtractor istream(buf, m_pointLen);
+
+    int32_t xi, yi, zi;
+    istream >> xi >> yi >> zi;
+
+    double x = xi * m_scale[0] + m_offset[0];
+    double y = yi * m_scale[1] + m_offset[1];
+    double z = zi * m_scale[2] + m_offset[2];
+
+    // Nodes extend past the query bounds; clip their points here.
+    if (m_haveQueryBounds && !m_queryBounds.contains(x, y, z))
+        return;
+
+    uint16_t intensity;
+    uint8_t returnInfo;
+    uint8_t flags;
+    uint8_t classification;
+    uint8_t user;
+    int16_t scanAngle;
+    uint16_t pointSourceId;
+    double gpsTime;
+
+    istream >> intensity >> returnInfo >> flags >> classification >> user >>
+        scanAngle >> pointSourceId >> gpsTime;
+
+    uint8_t returnNum = returnInfo & 0x0F;
+    uint8_t numReturns = (returnInfo >> 4) & 0x0F;
+    uint8_t classFlags = flags & 0x0F;
+    uint8_t scanChannel = (flags >> 4) & 0x03;
+    uint8_t scanDirFlag = (flags >> 6) & 0x01;
+    uint8_t flight = (flags >> 7) & 0x01;
+
+    PointId id = view.size();
+    view.setField(Dimension::Id::X, id, x);
+    view.setField(Dimension::Id::Y, id, y);
+    view.setField(Dimension::Id::Z, id, z);
+    view.setField(Dimension::Id::Intensity, id, intensity);
+    view.setField(Dimension::Id::ReturnNumber, id, returnNum);
+    view.setField(Dimension::Id::NumberOfReturns, id, numReturns);
+    view.setField(Dimension::Id::ClassFlags, id, classFlags);
+    view.setField(Dimension::Id::ScanChannel, id, scanChannel);
+    view.setField(Dimension::Id::ScanDirectionFlag, id, scanDirFlag);
+    view.setField(Dimension::Id::EdgeOfFlightLine, id, flight);
+    view.setField(Dimension::Id::Classification, id, classification);
+    view.setField(Dimension::Id::ScanAngleRank, id, scanAngle * .006);
+    view.setField(Dimension::Id::UserData, id, user);
+    view.setField(Dimension::Id::PointSourceId, id, pointSourceId);
+    view.setField(Dimension::Id::GpsTime, id, gpsTime);
+
+    if (m_pointFormat == 7 || m_pointFormat == 8)
+    {
+        uint16_t red, green, blue;
+        istream >> red >> green >> blue;
+        view.setField(Dimension::Id::Red, id, red);
+        view.setField(Dimension::Id::Green, id, green);
+        view.setField(Dimension::Id::Blue, id, blue);
+    }
+
+    if (m_pointFormat == 8)
+    {
+        uint16_t nearInfraRed;
+        istream >> nearInfraRed;
+        view.setField(Dimension::Id::Infrared, id, nearInfraRed);
+    }
+}
+
+
+void CopcReader::done(PointTableRef table)
+{
+#ifdef PDAL_HAVE_LAZPERF
+    delete m_decompressor;
+    m_decompressor = nullptr;
+#endif
+    m_pool.reset();
+    m_nodes.clear();
+    if (m_stream.is_open())
+        m_stream.close();
+}
+
+} // namespace pdal
@@ -0,0 +1,150 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <pdal/pdal_features.hpp>
+#include <pdal/Reader.hpp>
+#include <pdal/util/Bounds.hpp>
+
+#include "LasVLR.hpp"
+
+namespace pdal
+{
+
+class LazPerfChunkDecompressor;
+class ThreadPool;
+
+// Reads cloud-optimized LAZ (COPC) files - LAS 1.4 files whose chunks form
+// an octree described by embedded hierarchy pages.  Only the nodes that
+// intersect the requested bounds and resolution are fetched and decoded,
+// so reading a subset of a large remote file transfers a small fraction
+// of it.  Nodes are fetched (HTTP range requests for remote files) and
+// decompressed in parallel; chunks are independently coded, so no shared
+// decoder state is needed.
+class PDAL_DLL CopcReader : public Reader
+{
+public:
+    CopcReader();
+    virtual ~CopcReader();
+    std::string getName() const override;
+
+private:
+    // Key of an octree voxel in the embedded hierarchy.
+    struct VoxelKey
+    {
+        int32_t m_level;
+        int32_t m_x;
+        int32_t m_y;
+        int32_t m_z;
+    };
+
+    // Hierarchy entry for a voxel with point data.
+    struct Node
+    {
+        VoxelKey m_key;
+        uint64_t m_offset;
+        int32_t m_byteSize;
+        int32_t m_pointCount;
+    };
+
+    virtual void addArgs(ProgramArgs& args) override;
+    virtual void initialize() override;
+    virtual QuickInfo inspect() override;
+    virtual void addDimensions(PointLayoutPtr layout) override;
+    virtual void ready(PointTableRef table) override;
+    virtual point_count_t read(PointViewPtr view, point_count_t count)
+        override;
+    virtual void done(PointTableRef table) override;
+
+    /// Fetch \c size bytes at \c offset - a range request for remote
+    /// files, a locked seek/read of the local stream otherwise.
+    std::vector<char> fetch(uint64_t offset, uint64_t size);
+    void parseHeader(const std::vector<char>& buf);
+    void parseVlrs();
+    void parseCopcInfo(const LasVLR& vlr);
+    /// Load a hierarchy page, collecting overlapping data nodes and
+    /// recursing into overlapping child pages.
+    void loadHierarchyPage(uint64_t offset, uint64_t size);
+    BOX3D keyBounds(const VoxelKey& key) const;
+    bool overlaps(const VoxelKey& key) const;
+    void readNode(PointViewPtr view, point_count_t count, const Node& node);
+    void loadPoint(PointView& view, const char *buf);
+
+    Bounds m_bounds;
+    double m_resolution;
+    size_t m_threads;
+
+    bool m_isRemote;
+    std::ifstream m_stream;
+    std::mutex m_streamMutex;
+    std::mutex m_viewMutex;
+    std::unique_ptr<ThreadPool> m_pool;
+    LazPerfChunkDecompressor *m_decompressor;
+
+    // Fixed-header fields, parsed by hand since only a prefix of the
+    // file is fetched.
+    uint16_t m_headerSize;
+    uint32_t m_pointOffset;
+    uint32_t m_vlrCount;
+    uint8_t m_pointFormat;
+    uint16_t m_pointLen;
+    uint64_t m_pointCount;
+    double m_scale[3];
+    double m_offset[3];
+    BOX3D m_headerBounds;
+
+    // COPC info VLR fields.
+    double m_center[3];
+    double m_halfsize;
+    double m_spacing;
+    uint64_t m_rootHierOffset;
+    uint64_t m_rootHierSize;
+
+    std::vector<uint8_t> m_lazVlrData;
+    bool m_haveQueryBounds;
+    BOX3D m_queryBounds;
+    uint64_t m_depthEnd;    // Zero selects all depths.
+    std::vector<Node> m_nodes;
+
+    CopcReader& operator=(const CopcReader&); // not implemented
+    CopcReader(const CopcReader&); // not implemented
+};
+
+} // namespace pdal
@@ -96,7 +96,7 @@ void EptAddonWriter::prepared(PointTableRef table)
         log()->get(LogLevel::Warning) << "Using a large thread count: " <<
             threads << " threads" << std::endl;
     }
-    m_pool.reset(new Pool(threads));
+    m_pool.reset(new ThreadPool(threads));
 
     const PointLayout& layout(*table.layout());
     for (auto it : m_args->m_addons.items())
@@ -144,50 +144,82 @@ void EptAddonWriter::ready(PointTableRef table)
 
 void EptAddonWriter::write(const PointViewPtr view)
 {
-    for (const auto& addon : m_addons)
+    if (m_addons.empty())
+        return;
+
+    // Create a buffer for each node we're going to write, for each addon.
+    AddonBuffers buffers(m_addons.size());
+    for (std::size_t a(0); a < m_addons.size(); ++a)
+    {
+        const Addon& addon(*m_addons[a]);
+        buffers[a].reserve(m_hierarchy.size());
+        for (const auto& p : m_hierarchy)
+            buffers[a].emplace_back(p.second * addon.size(), 0);
+    }
+
+    // Assemble the buffers for all the addons in one pass over the view.
+    fillBuffers(view, buffers);
+
+    for (std::size_t a(0); a < m_addons.size(); ++a)
     {
+        const Addon& addon(*m_addons[a]);
+
         log()->get(LogLevel::Debug) << "Writing addon dimension " <<
-            addon->name() << " to " << addon->ep().prefixedRoot() << std::endl;
+            addon.name() << " to " << addon.ep().prefixedRoot() << std::endl;
 
-        writeOne(view, *addon);
+        writeOne(addon, buffers[a]);
 
         log()->get(LogLevel::Debug) << "\tWritten" << std::endl;
     }
 }
 
-void EptAddonWriter::writeOne(const PointViewPtr view, const Addon& addon) const
+void EptAddonWriter::fillBuffers(const PointViewPtr view,
+        AddonBuffers& buffers) const
 {
-    std::vector<std::vector<char>> buffers;
-    buffers.reserve(m_hierarchy.size());
-
-    // Create an addon buffer for each node we're going to write.
-    for (const auto& p : m_hierarchy)
-    {
-        buffers.emplace_back(p.second * addon.size(), 0);
-    }
+    // Each view point maps to a distinct node/point slot, so ranges of the
+    // view can be mapped concurrently without locking the buffers.
+    const PointId numPoints(view->size());
+    const PointId chunk(
+            (numPoints + m_pool->numThreads() - 1) / m_pool->numThreads());
 
-    // Fill in our buffers with the data from the view.
-    PointRef pr(*view);
-    uint64_t nodeId(0);
-    uint64_t pointId(0);
-    for (uint64_t i(0); i < view->size(); ++i)
+    for (PointId start(0); start < numPoints; start += chunk)
     {
-        pr.setPointId(i);
-        nodeId = pr.getFieldAs<uint64_t>(m_nodeIdDim);
-
-        // Node IDs are 1-based to distinguish points that do not come from the
-        // EPT reader.
-        if (!nodeId) continue;
-
-        nodeId -= 1;
-        pointId = pr.getFieldAs<uint64_t>(m_pointIdDim);
+        const PointId end((std::min)(start + chunk, numPoints));
 
-        auto& buffer(buffers.at(nodeId));
-        assert(pointId * addon.size() + addon.size() <= buffer.size());
-        char* dst = buffer.data() + pointId * addon.size();
-        pr.getField(dst, addon.id(), addon.type());
+        m_pool->add([this, view, &buffers, start, end]()
+        {
+            PointRef pr(*view);
+            for (PointId i(start); i < end; ++i)
+            {
+                pr.setPointId(i);
+                uint64_t nodeId(pr.getFieldAs<uint64_t>(m_nodeIdDim));
+
+                // Node IDs are 1-based to distinguish points that do not come
+                // from the EPT reader.
+                if (!nodeId) continue;
+
+                nodeId -= 1;
+                const uint64_t pointId(pr.getFieldAs<uint64_t>(m_pointIdDim));
+
+                for (std::size_t a(0); a < m_addons.size(); ++a)
+                {
+                    const Addon& addon(*m_addons[a]);
+                    auto& buffer(buffers[a].at(nodeId));
+                    assert(pointId * addon.size() + addon.size() <=
+                        buffer.size());
+                    char* dst = buffer.data() + pointId * addon.size();
+                    pr.getField(dst, addon.id(), addon.type());
+                }
+            }
+        });
     }
 
+    m_pool->await();
+}
+
+void EptAddonWriter::writeOne(const Addon& addon,
+        const std::vector<std::vector<char>>& buffers) const
+{
     const arbiter::Endpoint& ep(addon.ep());
     const arbiter::Endpoint dataEp(ep.getSubEndpoint("ept-data"));
     const arbiter::Endpoint hierEp(ep.getSubEndpoint("ept-hierarchy"));
@@ -199,7 +231,7 @@ void EptAddonWriter::writeOne(const PointViewPtr view, const Addon& addon) const
     }
 
     // Write the binary dimension data for the addon.
-    nodeId = 0;
+    uint64_t nodeId(0);
     for (const auto& p : m_hierarchy)
     {
         const Key key(p.first);
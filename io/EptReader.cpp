@@ -44,6 +44,7 @@
 #include <nlohmann/json.hpp>
 
 #include <pdal/GDALUtils.hpp>
+#include <pdal/PDALUtils.hpp>
 #include <pdal/SrsBounds.hpp>
 #include <pdal/compression/ZstdCompression.hpp>
 #include <pdal/util/Algorithm.hpp>
@@ -136,6 +137,8 @@ public:
     EptBounds m_bounds;
     std::string m_origin;
     std::size_t m_threads = 0;
+    std::size_t m_lookahead = 0;
+    uint64_t m_cacheSize = 256 * 1024 * 1024;
     double m_resolution = 0;
     std::vector<Polygon> m_polys;
     NL::json m_addons;
@@ -158,6 +161,11 @@ void EptReader::addArgs(ProgramArgs& args)
     args.add("bounds", "Bounds to fetch", m_args->m_bounds);
     args.add("origin", "Origin of source file to fetch", m_args->m_origin);
     args.add("threads", "Number of worker threads", m_args->m_threads);
+    args.add("lookahead", "Maximum number of decoded nodes held ahead of "
+        "the consumer in stream mode", m_args->m_lookahead);
+    args.add("cache_size", "Size in bytes of the process-wide cache of "
+        "remote hierarchy and node data (0 disables)", m_args->m_cacheSize,
+        m_args->m_cacheSize);
     args.add("resolution", "Resolution limit", m_args->m_resolution);
     args.add("addons", "Mapping of addon dimensions to their output directory",
         m_args->m_addons);
@@ -177,8 +185,12 @@ std::string EptReader::get(const std::string path) const
 {
     if (m_ep->isLocal())
         return m_ep->get(path);
-    else
-        return m_ep->get(path, m_headers, m_query);
+
+    EptCache::Data data = EptCache::global().fetch(
+        m_ep->prefixedRoot() + path,
+        [this, &path]()
+        { return m_ep->getBinary(path, m_headers, m_query); });
+    return std::string(data->data(), data->size());
 }
 
 
@@ -186,8 +198,12 @@ std::vector<char> EptReader::getBinary(const std::string path) const
 {
     if (m_ep->isLocal())
         return m_ep->getBinary(path);
-    else
-        return m_ep->getBinary(path, m_headers, m_query);
+
+    EptCache::Data data = EptCache::global().fetch(
+        m_ep->prefixedRoot() + path,
+        [this, &path]()
+        { return m_ep->getBinary(path, m_headers, m_query); });
+    return *data;
 }
 
 
@@ -222,8 +238,10 @@ void EptReader::initialize()
     if (m_root.empty())
         throwError("Missing input filename");
 
-    m_arbiter.reset(new arbiter::Arbiter());
-    m_ep.reset(new arbiter::Endpoint(m_arbiter->getEndpoint(m_root)));
+    // Use the process-wide arbiter so HTTP connections are reused across
+    // readers and pipelines.
+    m_ep.reset(new arbiter::Endpoint(
+        Utils::globalArbiter().getEndpoint(m_root)));
 
     const std::size_t threads((std::max)(m_args->m_threads, size_t(4)));
     if (threads > 100)
@@ -231,7 +249,13 @@ void EptReader::initialize()
         log()->get(LogLevel::Warning) << "Using a large thread count: " <<
             threads << " threads" << std::endl;
     }
-    m_pool.reset(new Pool(threads));
+    m_pool.reset(new ThreadPool(threads));
+
+    // In stream mode the lookahead caps how many decoded nodes can pile up
+    // ahead of the consumer, independent of how many download threads run.
+    m_lookahead = m_args->m_lookahead ? m_args->m_lookahead : threads;
+
+    EptCache::global().setMaxSize(m_args->m_cacheSize);
 
     debug << "Endpoint: " << m_ep->prefixedRoot() << std::endl;
     try
@@ -254,6 +278,27 @@ void EptReader::initialize()
         plist.insert(plist.end(), ogrPolys.begin(), ogrPolys.end());
     }
 
+    // Downstream crop pushdown - restrict the query to the cropped
+    // region when the user gave no bounds of their own.  The crop still
+    // filters exactly, so the enclosing box is fine.
+    if (m_options.getValues("bounds").empty())
+    {
+        BOX3D box;
+        for (const Bounds& b : pushdownBounds())
+        {
+            if (b.is3d())
+                box.grow(b.to3d());
+            else
+            {
+                BOX2D b2 = b.to2d();
+                box.grow(b2.minx, b2.miny, EptBounds::LOWEST);
+                box.grow(b2.maxx, b2.maxy, EptBounds::HIGHEST);
+            }
+        }
+        if (box.valid())
+            m_args->m_bounds = EptBounds(SrsBounds(box));
+    }
+
     // Transform query bounds to match point source SRS.
     const SpatialReference& boundsSrs = m_args->m_bounds.spatialReference();
     if (!m_info->srs().valid() && boundsSrs.valid())
@@ -264,6 +309,30 @@ void EptReader::initialize()
         gdal::reprojectBounds(m_queryBounds,
             boundsSrs.getWKT(), getSpatialReference().getWKT());
 
+    // Downstream range pushdown - X, Y and Z intervals tighten the
+    // query box so the hierarchy traversal prunes nodes that can't
+    // hold a qualifying point.  Other dimensions are checked against
+    // the schema statistics in overlaps().
+    for (const DimInterval& di : pushdownRanges())
+    {
+        BOX3D& q = m_queryBounds;
+        if (Utils::iequals(di.m_name, "X"))
+        {
+            q.minx = (std::max)(q.minx, di.m_min);
+            q.maxx = (std::min)(q.maxx, di.m_max);
+        }
+        else if (Utils::iequals(di.m_name, "Y"))
+        {
+            q.miny = (std::max)(q.miny, di.m_min);
+            q.maxy = (std::min)(q.maxy, di.m_max);
+        }
+        else if (Utils::iequals(di.m_name, "Z"))
+        {
+            q.minz = (std::max)(q.minz, di.m_min);
+            q.maxz = (std::min)(q.maxz, di.m_max);
+        }
+    }
+
     // Transform polygons and bounds to point source SRS.
     std::vector <Polygon> exploded;
     for (Polygon& poly : m_args->m_polys)
@@ -523,7 +592,7 @@ void EptReader::addDimensions(PointLayoutPtr layout)
             }
             root = arbiter::expandTilde(root);
 
-            const arbiter::Endpoint ep(m_arbiter->getEndpoint(root));
+            const arbiter::Endpoint ep(Utils::globalArbiter().getEndpoint(root));
             try
             {
                 const NL::json addonInfo(
@@ -556,6 +625,12 @@ void EptReader::ready(PointTableRef table)
 {
     m_userLayout = table.layout();
 
+    // Reset streaming state in case this stage is executed more than once.
+    m_nodeId = 1;
+    m_pointId = 0;
+    m_currentNodeBuffer.reset();
+    m_upcomingNodeBuffers.clear();
+
     // These may not exist, in general they are only needed to track point
     // origins and ordering for an EPT writer.
     m_nodeIdDim = table.layout()->findDim("EptNodeId");
@@ -607,6 +682,33 @@ void EptReader::ready(PointTableRef table)
 
 void EptReader::overlaps()
 {
+    // Dataset-level schema statistics can prove that a pushed-down
+    // range matches nothing - a Classification query against data
+    // whose stated maximum is below the requested class, for example -
+    // in which case there is nothing to fetch at all.  EPT keeps no
+    // per-node statistics, so nodes can't be pruned individually this
+    // way.
+    for (const DimInterval& di : pushdownRanges())
+    {
+        if (Utils::iequals(di.m_name, "X") ||
+            Utils::iequals(di.m_name, "Y") ||
+            Utils::iequals(di.m_name, "Z"))
+            continue;
+        const NL::json dim = m_info->dim(di.m_name);
+        if (!dim.contains("minimum") || !dim["minimum"].is_number() ||
+            !dim.contains("maximum") || !dim["maximum"].is_number())
+            continue;
+        if (dim["maximum"].get<double>() < di.m_min ||
+            dim["minimum"].get<double>() > di.m_max)
+        {
+            log()->get(LogLevel::Debug) << "Range pushdown on '" <<
+                di.m_name << "' excludes every point; skipping query" <<
+                std::endl;
+            m_overlapIt = m_overlaps.begin();
+            return;
+        }
+    }
+
     auto parseEndpoint = [this](const arbiter::Endpoint& ep,
         const std::string file)
     {
@@ -823,7 +925,7 @@ PointId EptReader::readBinary(PointView& dst, const Key& key,
 uint64_t EptReader::readZstandard(PointView& dst, const Key& key,
         const uint64_t nodeId) const
 {
-    auto compressed(m_ep->getBinary("ept-data/" + key.toString() + ".zst"));
+    auto compressed(getBinary("ept-data/" + key.toString() + ".zst"));
     std::vector<char> data;
     pdal::ZstdDecompressor dec([&data](char* pos, std::size_t size)
     {
@@ -958,7 +1060,7 @@ void EptReader::load()
     // Asynchronously trigger the fetching and point-view execution of
     // a lookahead buffer of nodes.
     while (
-        m_upcomingNodeBuffers.size() < m_pool->size() &&
+        m_upcomingNodeBuffers.size() < m_lookahead &&
         m_overlapIt != m_overlaps.end())
     {
         const auto nodeId(m_nodeId++);
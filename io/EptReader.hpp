@@ -63,7 +63,7 @@ class Addon;
 class EptInfo;
 class FixedPointLayout;
 class Key;
-class Pool;
+class ThreadPool;
 class VectorPointTable;
 
 class PDAL_DLL EptReader : public Reader, public Streamable
@@ -133,7 +133,6 @@ private:
 
     std::string m_root;
 
-    std::unique_ptr<arbiter::Arbiter> m_arbiter;
     std::unique_ptr<arbiter::Endpoint> m_ep;
     std::unique_ptr<EptInfo> m_info;
 
@@ -143,7 +142,8 @@ private:
 
     BOX3D m_queryBounds;
     int64_t m_queryOriginId = -1;
-    std::unique_ptr<Pool> m_pool;
+    std::unique_ptr<ThreadPool> m_pool;
+    std::size_t m_lookahead = 0;
     std::vector<std::unique_ptr<Addon>> m_addons;
 
     using StringMap = std::map<std::string, std::string>;
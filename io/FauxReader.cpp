@@ -38,7 +38,9 @@
 #include <pdal/PointView.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
+#include <algorithm>
 #include <ctime>
+#include <vector>
 
 namespace pdal
 {
@@ -128,6 +130,25 @@ void FauxReader::initialize()
 }
 
 
+QuickInfo FauxReader::inspect()
+{
+    QuickInfo qi;
+    std::unique_ptr<PointLayout> layout(new PointLayout());
+
+    initialize();
+    addDimensions(layout.get());
+
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
+    qi.m_pointCount = m_count;
+    qi.m_bounds = m_bounds;
+    qi.m_valid = true;
+
+    return qi;
+}
+
+
 void FauxReader::addDimensions(PointLayoutPtr layout)
 {
     Dimension::IdList ids = { Dimension::Id::X, Dimension::Id::Y,
@@ -231,17 +252,144 @@ bool FauxReader::processOne(PointRef& point)
 #pragma warning (pop)
 
 
+// Standard-mode generation runs a chunk at a time: coordinates are
+// computed into flat buffers with the mode branch hoisted out of the
+// per-point loop, then stored with batch stores.  The fill loops are
+// simple enough for the compiler to vectorize, and the uniform/normal
+// modes draw from counter-based streams, so generation stays well ahead
+// of whatever stage is being driven.  Stream mode goes point-at-a-time
+// through processOne() as always.
 point_count_t FauxReader::read(PointViewPtr view, point_count_t count)
 {
-    for (PointId idx = 0; idx < count; ++idx)
+    static const point_count_t ChunkSize = 4096;
+
+    count = (std::min)(count, (point_count_t)(m_count - m_index));
+
+    std::vector<double> x(ChunkSize);
+    std::vector<double> y(ChunkSize);
+    std::vector<double> z(ChunkSize);
+    std::vector<uint8_t> returnNums;
+    if (m_numReturns > 0)
+        returnNums.resize(ChunkSize);
+
+    point_count_t numRead = 0;
+    while (numRead < count)
     {
-        PointRef point = view->point(idx);
-        if (!processOne(point))
+        point_count_t n = (std::min)(ChunkSize, count - numRead);
+        point_count_t base = m_index;
+
+        switch (m_mode)
+        {
+        case Mode::Random:
+            for (point_count_t i = 0; i < n; ++i)
+            {
+                x[i] = Utils::random(m_bounds.minx, m_bounds.maxx);
+                y[i] = Utils::random(m_bounds.miny, m_bounds.maxy);
+                z[i] = Utils::random(m_bounds.minz, m_bounds.maxz);
+            }
             break;
+        case Mode::Constant:
+            std::fill(x.begin(), x.begin() + n, m_bounds.minx);
+            std::fill(y.begin(), y.begin() + n, m_bounds.miny);
+            std::fill(z.begin(), z.begin() + n, m_bounds.minz);
+            break;
+        case Mode::Ramp:
+            for (point_count_t i = 0; i < n; ++i)
+                x[i] = m_bounds.minx + m_delX * (base + i);
+            for (point_count_t i = 0; i < n; ++i)
+                y[i] = m_bounds.miny + m_delY * (base + i);
+            for (point_count_t i = 0; i < n; ++i)
+                z[i] = m_bounds.minz + m_delZ * (base + i);
+            break;
+        case Mode::Uniform:
+            // Each value draws from an independent counter, matching the
+            // seed-per-value advance of processOne().
+            for (point_count_t i = 0; i < n; ++i)
+                x[i] = Utils::uniform(m_bounds.minx, m_bounds.maxx,
+                    m_seed + (uint32_t)(3 * i));
+            for (point_count_t i = 0; i < n; ++i)
+                y[i] = Utils::uniform(m_bounds.miny, m_bounds.maxy,
+                    m_seed + (uint32_t)(3 * i + 1));
+            for (point_count_t i = 0; i < n; ++i)
+                z[i] = Utils::uniform(m_bounds.minz, m_bounds.maxz,
+                    m_seed + (uint32_t)(3 * i + 2));
+            m_seed += (uint32_t)(3 * n);
+            break;
+        case Mode::Normal:
+            for (point_count_t i = 0; i < n; ++i)
+                x[i] = Utils::normal(m_mean_x, m_stdev_x,
+                    m_seed + (uint32_t)(3 * i));
+            for (point_count_t i = 0; i < n; ++i)
+                y[i] = Utils::normal(m_mean_y, m_stdev_y,
+                    m_seed + (uint32_t)(3 * i + 1));
+            for (point_count_t i = 0; i < n; ++i)
+                z[i] = Utils::normal(m_mean_z, m_stdev_z,
+                    m_seed + (uint32_t)(3 * i + 2));
+            m_seed += (uint32_t)(3 * n);
+            break;
+        case Mode::Grid:
+            for (point_count_t i = 0; i < n; ++i)
+            {
+                point_count_t idx = base + i;
+
+                x[i] = 0;
+                y[i] = 0;
+                z[i] = 0;
+                if (m_delX)
+                    x[i] = idx % (point_count_t)m_delX;
+                if (m_delY)
+                {
+                    if (m_delX)
+                        y[i] = (idx / (point_count_t)m_delX) %
+                            (point_count_t)m_delY;
+                    else
+                        y[i] = idx % (point_count_t)m_delY;
+                }
+                if (m_delZ)
+                {
+                    if (m_delX && m_delY)
+                        z[i] = idx / (point_count_t)(m_delX * m_delY);
+                    else if (m_delX)
+                        z[i] = idx / (point_count_t)m_delX;
+                    else if (m_delY)
+                        z[i] = idx / (point_count_t)m_delY;
+                }
+            }
+            break;
+        }
+
+        // The store at index == size() is what appends each point, so
+        // the time values go in point-at-a-time and the rest follow as
+        // batches.
+        PointId startId = view->size();
+        for (point_count_t i = 0; i < n; ++i)
+            view->setField(Dimension::Id::OffsetTime, startId + i, m_time++);
+
+        view->setFieldBatch(Dimension::Id::X, startId, n, x.data());
+        view->setFieldBatch(Dimension::Id::Y, startId, n, y.data());
+        view->setFieldBatch(Dimension::Id::Z, startId, n, z.data());
+        if (m_numReturns > 0)
+        {
+            for (point_count_t i = 0; i < n; ++i)
+            {
+                returnNums[i] = (uint8_t)m_returnNum;
+                m_returnNum = (m_returnNum % m_numReturns) + 1;
+            }
+            view->setFieldBatch(Dimension::Id::ReturnNumber, startId, n,
+                returnNums.data());
+            std::fill(returnNums.begin(), returnNums.begin() + n,
+                (uint8_t)m_numReturns);
+            view->setFieldBatch(Dimension::Id::NumberOfReturns, startId, n,
+                returnNums.data());
+        }
         if (m_cb)
-            m_cb(*view, idx);
+            for (point_count_t i = 0; i < n; ++i)
+                m_cb(*view, startId + i);
+
+        m_index += n;
+        numRead += n;
     }
-    return count;
+    return numRead;
 }
 
 } // namespace pdal
@@ -149,6 +149,7 @@ private:
 
     virtual void addArgs(ProgramArgs& args);
     virtual void initialize();
+    virtual QuickInfo inspect();
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void ready(PointTableRef table);
     virtual bool processOne(PointRef& point);
@@ -38,10 +38,19 @@
 
 #include <pdal/GDALUtils.hpp>
 #include <pdal/PointView.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
 
+namespace
+{
+
+// Target per-band buffer size when reading strips of rows.
+const size_t StripBytes = 4 * 1024 * 1024;
+
+}
+
 static StaticPluginInfo const s_info
 {
     "readers.gdal",
@@ -174,6 +183,41 @@ void GDALReader::ready(PointTableRef table)
     m_index = 0;
     m_row = 0;
     m_col = 0;
+
+    // Strips are aligned to the band's native block height so each block
+    // is decoded only once, and sized to keep memory bounded regardless
+    // of raster size.
+    int xBlock, yBlock;
+    if (m_raster->blockSize(1, xBlock, yBlock) != gdal::GDALError::None)
+        yBlock = 1;
+    int targetRows = (std::max)(1,
+        (int)(StripBytes / sizeof(double) / (std::max)(m_width, 1)));
+    m_stripHeight = ((targetRows + yBlock - 1) / yBlock) * yBlock;
+    m_stripHeight = (std::min)(m_stripHeight, m_height);
+    m_stripTop = 0;
+    m_stripRows = 0;
+    m_stripData.resize(m_raster->bandCount());
+
+    // Each decode worker needs its own dataset handle - GDAL datasets
+    // aren't safe for concurrent access - so bands are read in parallel
+    // only when we can open the file once per band.
+    m_bandRasters.clear();
+    m_pool.reset();
+    if (m_raster->bandCount() > 1 && !m_useMemoryCopy)
+    {
+        for (int b = 0; b < m_raster->bandCount(); ++b)
+        {
+            std::unique_ptr<gdal::Raster> r(new gdal::Raster(m_filename));
+            if (r->open() != gdal::GDALError::None)
+            {
+                m_bandRasters.clear();
+                break;
+            }
+            m_bandRasters.push_back(std::move(r));
+        }
+        if (m_bandRasters.size())
+            m_pool.reset(new ThreadPool(m_bandRasters.size()));
+    }
 }
 
 
@@ -194,28 +238,55 @@ point_count_t GDALReader::read(PointViewPtr view, point_count_t numPts)
 }
 
 
+void GDALReader::fillStrip()
+{
+    m_stripTop += m_stripRows;
+    m_stripRows = (std::min)(m_stripHeight, m_height - m_stripTop);
+
+    if (m_pool)
+    {
+        for (size_t b = 0; b < m_bandRasters.size(); ++b)
+        {
+            gdal::Raster *raster = m_bandRasters[b].get();
+            std::vector<double>& data = m_stripData[b];
+            m_pool->add([this, raster, &data, b]()
+            {
+                if (raster->readBandRows(data, (int)b + 1, m_stripTop,
+                        m_stripRows) != gdal::GDALError::None)
+                    throw pdal_error(raster->errorMsg());
+            });
+        }
+        m_pool->await();
+        if (m_pool->errors().size())
+            throwError(m_pool->errors().front());
+    }
+    else
+    {
+        for (int b = 0; b < m_raster->bandCount(); ++b)
+            if (m_raster->readBandRows(m_stripData[b], b + 1, m_stripTop,
+                    m_stripRows) != gdal::GDALError::None)
+                throwError(m_raster->errorMsg());
+    }
+}
+
+
 bool GDALReader::processOne(PointRef& point)
 {
     std::array<double, 2> coords;
     if (m_row == m_height)
         return false; // done
 
-    m_raster->pixelToCoord(m_col, m_row, coords);
-    double x = coords[0];
-    double y = coords[1];
-    point.setField(Dimension::Id::X, x);
-    point.setField(Dimension::Id::Y, y);
+    if (m_row >= m_stripTop + m_stripRows)
+        fillStrip();
 
-    std::vector<double> data;
-    if (m_raster->read(x, y, data) != gdal::GDALError::None)
-        return false;
+    m_raster->pixelToCoord(m_col, m_row, coords);
+    point.setField(Dimension::Id::X, coords[0]);
+    point.setField(Dimension::Id::Y, coords[1]);
 
+    size_t pos = ((size_t)(m_row - m_stripTop) * m_width) + m_col;
     for (int b = 0; b < m_raster->bandCount(); ++b)
-    {
-        Dimension::Id id = m_bandIds[b];
-        double v = data[b];
-        point.setField(id, v);
-    }
+        point.setField(m_bandIds[b], m_stripData[b][pos]);
+
     m_col++;
     if (m_col == m_width)
     {
@@ -229,6 +300,10 @@ bool GDALReader::processOne(PointRef& point)
 
 void GDALReader::done(PointTableRef table)
 {
+    m_pool.reset();
+    for (auto& raster : m_bandRasters)
+        raster->close();
+    m_bandRasters.clear();
     m_raster->close();
 }
 
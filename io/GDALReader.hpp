@@ -47,6 +47,8 @@ namespace pdal
 
 namespace gdal { class Raster; }
 
+class ThreadPool;
+
 typedef std::map<std::string, Dimension::Id> DimensionMap;
 
 class PDAL_DLL GDALReader : public Reader , public Streamable
@@ -67,6 +69,9 @@ private:
     virtual QuickInfo inspect();
     virtual void addArgs(ProgramArgs& args);
 
+    // Buffer the next strip of rows for each band.
+    void fillStrip();
+
     std::unique_ptr<gdal::Raster> m_raster;
     std::vector<Dimension::Type> m_bandTypes;
     std::vector<Dimension::Id> m_bandIds;
@@ -78,6 +83,16 @@ private:
     int m_row;
     int m_col;
 
+    // Points are emitted from per-band strip buffers rather than with a
+    // GDAL read per cell.  Bands decode in parallel, each through its own
+    // dataset handle, since GDAL datasets aren't safe for concurrent use.
+    std::vector<std::unique_ptr<gdal::Raster>> m_bandRasters;
+    std::unique_ptr<ThreadPool> m_pool;
+    std::vector<std::vector<double>> m_stripData;
+    int m_stripTop;
+    int m_stripRows;
+    int m_stripHeight;
+
     BOX3D m_bounds;
     StringList m_dimNames;
 };
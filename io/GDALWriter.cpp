@@ -38,6 +38,7 @@
 #include <pdal/EigenUtils.hpp>
 #include <pdal/GDALUtils.hpp>
 #include <pdal/PointView.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "private/GDALGrid.hpp"
 
@@ -89,6 +90,9 @@ void GDALWriter::addArgs(ProgramArgs& args)
         m_width);
     m_heightArg = &args.add("height", "Number of cells in the Y direction.",
         m_height);
+    args.add("threads", "Number of threads used to accumulate points into "
+        "the raster and to finalize it.  Each extra accumulation thread "
+        "holds its own copy of the grid.", m_threads, (size_t)1);
 }
 
 
@@ -263,6 +267,12 @@ void GDALWriter::writeView(const PointViewPtr view)
             expandGrid(bounds);
     }
 
+    if (m_threads > 1 && view->size() >= m_threads)
+    {
+        parallelAddPoints(view);
+        return;
+    }
+
     PointRef point(*view, 0);
     for (PointId idx = 0; idx < view->size(); ++idx)
     {
@@ -272,6 +282,57 @@ void GDALWriter::writeView(const PointViewPtr view)
 }
 
 
+// Accumulate the points of a view into the grid using multiple threads.
+// Cells are written over a radius around each point, so the workers can't
+// share the output grid.  Instead each worker accumulates a disjoint range
+// of points into its own grid and the partial grids are merged when all
+// the points have been added.  Note that this costs a grid-sized allocation
+// per thread.  The grid must already be large enough for all the points --
+// in standard mode writeView() sizes it from the view bounds up front.
+void GDALWriter::parallelAddPoints(const PointViewPtr view)
+{
+    constexpr point_count_t BatchSize = 4096;
+
+    std::vector<std::unique_ptr<GDALGrid>> grids;
+    for (size_t t = 0; t < m_threads; ++t)
+        grids.emplace_back(new GDALGrid(m_grid->width(), m_grid->height(),
+            m_edgeLength, m_radius, m_outputTypes, m_windowSize, m_power));
+
+    point_count_t span = (view->size() + m_threads - 1) / m_threads;
+    ThreadPool pool(m_threads);
+    for (size_t t = 0; t < m_threads; ++t)
+    {
+        GDALGrid *grid = grids[t].get();
+        PointId start = t * span;
+        point_count_t count =
+            (std::min)((point_count_t)(view->size() - start), span);
+        pool.add([this, view, grid, start, count, BatchSize]()
+        {
+            std::vector<double> x(BatchSize);
+            std::vector<double> y(BatchSize);
+            std::vector<double> z(BatchSize);
+
+            for (PointId pos = start; pos < start + count; pos += BatchSize)
+            {
+                point_count_t cnt =
+                    (std::min)((point_count_t)(start + count - pos), BatchSize);
+                view->getFieldBatch(Dimension::Id::X, pos, cnt, x.data());
+                view->getFieldBatch(Dimension::Id::Y, pos, cnt, y.data());
+                view->getFieldBatch(m_interpDim, pos, cnt, z.data());
+                for (point_count_t i = 0; i < cnt; ++i)
+                    grid->addPoint(x[i] - m_origin.x, y[i] - m_origin.y, z[i]);
+            }
+        });
+    }
+    pool.join();
+    if (pool.errors().size())
+        throwError(pool.errors().front());
+
+    for (size_t t = 0; t < m_threads; ++t)
+        m_grid->merge(*grids[t]);
+}
+
+
 bool GDALWriter::processOne(PointRef& point)
 {
     double x = point.getFieldAs<double>(Dimension::Id::X);
@@ -311,7 +372,14 @@ void GDALWriter::doneFile()
     pixelToPos[5] = -m_edgeLength;
     gdal::Raster raster(m_outputFilename, m_drivername, m_srs, pixelToPos);
 
-    m_grid->finalize();
+    try
+    {
+        m_grid->finalize(m_threads);
+    }
+    catch (const GDALGrid::error& err)
+    {
+        throwError(err.what());
+    }
 
     gdal::GDALError err = raster.open(m_grid->width(), m_grid->height(),
         m_grid->numBands(), m_dataType, m_noData, m_options);
@@ -71,6 +71,7 @@ private:
     virtual void readyFile(const std::string& filename,
         const SpatialReference& srs);
     virtual void writeView(const PointViewPtr view);
+    void parallelAddPoints(const PointViewPtr view);
     virtual bool processOne(PointRef& point);
     virtual void doneFile();
     void createGrid(BOX2D bounds);
@@ -105,6 +106,7 @@ private:
     Dimension::Id m_interpDim;
     std::string m_interpDimString;
     Dimension::Type m_dataType;
+    size_t m_threads;
     bool m_expandByPoint;
     bool m_fixedGrid;
 };
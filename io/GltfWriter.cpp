@@ -34,6 +34,7 @@
 
 #include "GltfWriter.hpp"
 
+#include <cstring>
 #include <iostream>
 #include <nlohmann/json.hpp>
 
@@ -127,9 +128,21 @@ void GltfWriter::write(const PointViewPtr v)
     if (m_totalSize > (std::numeric_limits<uint32_t>::max)())
         throwError("Data too large for file.");
 
+    // Pack each section into a contiguous little-endian buffer and issue
+    // a single large write rather than streaming a word at a time.
+    m_packBuf.clear();
+    m_packBuf.reserve(vd.m_indexCount);
     for (const Triangle& t : *mesh)
-        out << (uint32_t)t.m_a << (uint32_t)t.m_b << (uint32_t)t.m_c;
+    {
+        m_packBuf.push_back(htole32((uint32_t)t.m_a));
+        m_packBuf.push_back(htole32((uint32_t)t.m_b));
+        m_packBuf.push_back(htole32((uint32_t)t.m_c));
+    }
+    out.put(reinterpret_cast<const unsigned char *>(m_packBuf.data()),
+        m_packBuf.size() * sizeof(uint32_t));
 
+    m_packBuf.clear();
+    m_packBuf.reserve(vd.m_vertexCount * 3);
     for (PointId i = 0; i < v->size(); ++i)
     {
         float x = v->getFieldAs<float>(Dimension::Id::X, i);
@@ -137,8 +150,17 @@ void GltfWriter::write(const PointViewPtr v)
         float z = v->getFieldAs<float>(Dimension::Id::Z, i);
 
         vd.m_bounds.grow(x, y, z);
-        out << x << y << z;
+
+        uint32_t tmp;
+        std::memcpy(&tmp, &x, sizeof(x));
+        m_packBuf.push_back(htole32(tmp));
+        std::memcpy(&tmp, &y, sizeof(y));
+        m_packBuf.push_back(htole32(tmp));
+        std::memcpy(&tmp, &z, sizeof(z));
+        m_packBuf.push_back(htole32(tmp));
     }
+    out.put(reinterpret_cast<const unsigned char *>(m_packBuf.data()),
+        m_packBuf.size() * sizeof(uint32_t));
 
     m_viewData.push_back(vd);
 }
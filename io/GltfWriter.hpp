@@ -69,6 +69,9 @@ private:
     std::string m_filename;
     std::unique_ptr<OLeStream> m_stream;
     std::vector<ViewData> m_viewData;
+    // Scratch buffer for assembling a view's index or vertex section
+    // (floats bit-cast to words) before writing it in one shot.
+    std::vector<uint32_t> m_packBuf;
     size_t m_totalSize;
     size_t m_binSize;
 
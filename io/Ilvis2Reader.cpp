@@ -36,13 +36,60 @@
 #include "Ilvis2MetadataReader.hpp"
 #include <pdal/util/FileUtils.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include <algorithm>
 #include <cmath>
+#include <thread>
 
 namespace pdal
 {
 
+namespace
+{
+
+// Column layout of an ILVIS2 text record:
+// LVIS_LFID SHOTNUMBER TIME LONGITUDE_CENTROID LATITUDE_CENTROID
+// ELEVATION_CENTROID LONGITUDE_LOW LATITUDE_LOW ELEVATION_LOW
+// LONGITUDE_HIGH LATITUDE_HIGH ELEVATION_HIGH
+struct FieldSpec
+{
+    Dimension::Id m_dim;
+    const char *m_name;
+    bool m_longitude;  // Normalize into (-180, 180].
+};
+
+const FieldSpec fieldSpecs[] =
+{
+    { Dimension::Id::LvisLfid, "LVIS_LFID", false },
+    { Dimension::Id::ShotNumber, "SHOTNUMBER", false },
+    { Dimension::Id::GpsTime, "GPSTIME", false },
+    { Dimension::Id::LongitudeCentroid, "LONGITUDE_CENTROID", true },
+    { Dimension::Id::LatitudeCentroid, "LATITUDE_CENTROID", false },
+    { Dimension::Id::ElevationCentroid, "ELEVATION_CENTROID", false },
+    { Dimension::Id::LongitudeLow, "LONGITUDE_LOW", true },
+    { Dimension::Id::LatitudeLow, "LATITUDE_LOW", false },
+    { Dimension::Id::ElevationLow, "ELEVATION_LOW", false },
+    { Dimension::Id::LongitudeHigh, "LONGITUDE_HIGH", true },
+    { Dimension::Id::LatitudeHigh, "LATITUDE_HIGH", false },
+    { Dimension::Id::ElevationHigh, "ELEVATION_HIGH", false }
+};
+
+const size_t NumFields = 12;
+
+// X/Y/Z source columns for the low and high returns.
+const size_t LonLow = 6;
+const size_t LatLow = 7;
+const size_t ElevLow = 8;
+const size_t LonHigh = 9;
+const size_t LatHigh = 10;
+const size_t ElevHigh = 11;
+
+// Number of lines gathered per parsing batch in read().
+const size_t BatchLines = 50000;
+
+} // unnamed namespace
+
 static StaticPluginInfo const s_info
 {
     "readers.ilvis2",
@@ -102,6 +149,16 @@ void Ilvis2Reader::addArgs(ProgramArgs& args)
 {
     args.add("mapping", "Mapping for values", m_mapping, IlvisMapping::ALL);
     args.add("metadata", "Metadata file", m_metadataFile);
+    args.add("threads", "Number of threads used to parse records (0 = "
+        "choose automatically)", m_threads);
+}
+
+
+size_t Ilvis2Reader::threadCount(size_t lines) const
+{
+    // Parsing a line costs more than a point scan, so threading pays
+    // off on smaller batches than the usual threshold.
+    return pdal::threadCount(m_threads, lines, 10000);
 }
 
 
@@ -137,60 +194,111 @@ void Ilvis2Reader::initialize(PointTableRef)
 }
 
 
-template <typename T>
-T convert(const StringList& s, const std::string& name, size_t fieldno)
+// Split a record on spaces and convert its fields per the schema in
+// fieldSpecs, normalizing longitudes as they're parsed.  Touches no reader
+// state, so records can be converted on several threads at once.
+void Ilvis2Reader::parseLine(const std::string& line, size_t lineNum,
+    double *vals) const
 {
-    T output;
-    if (!Utils::fromString(s[fieldno], output))
-        throw Ilvis2Reader::error("Unable to convert " + name +
-            ", " + s[fieldno] + ", to double");
+    std::pair<const char *, const char *> fields[NumFields];
+
+    const char *p = line.data();
+    const char *end = p + line.size();
 
-    return output;
+    size_t cnt = 0;
+    while (true)
+    {
+        while (p != end && *p == ' ')
+            ++p;
+        if (p == end)
+            break;
+        const char *fs = p;
+        while (p != end && *p != ' ')
+            ++p;
+        if (cnt < NumFields)
+            fields[cnt] = std::make_pair(fs, p);
+        cnt++;
+    }
+    if (cnt != NumFields)
+        throw error("Invalid format for line " + Utils::toString(lineNum) +
+            ".  Expected 12 fields, got " + Utils::toString(cnt) + ".");
+
+    for (size_t i = 0; i < NumFields; ++i)
+    {
+        double d;
+        if (!Utils::parseDouble(fields[i].first, fields[i].second, d))
+            throw error("Unable to convert " +
+                std::string(fieldSpecs[i].m_name) + ", " +
+                std::string(fields[i].first, fields[i].second) +
+                ", to double");
+        vals[i] = fieldSpecs[i].m_longitude ?
+            Utils::normalizeLongitude(d) : d;
+    }
 }
 
 
-void Ilvis2Reader::readPoint(PointRef& point, StringList s,
-    std::string pointMap)
+void Ilvis2Reader::parseLines(const std::vector<std::string>& lines,
+    size_t firstLine, double *vals)
 {
-    point.setField(pdal::Dimension::Id::LvisLfid,
-        convert<unsigned>(s, "LVIS_LFID", 0));
-    point.setField(pdal::Dimension::Id::ShotNumber,
-        convert<unsigned>(s, "SHOTNUMBER", 1));
-    point.setField(pdal::Dimension::Id::GpsTime,
-        convert<double>(s, "GPSTIME", 2));
-    point.setField(pdal::Dimension::Id::LongitudeCentroid,
-        Utils::normalizeLongitude(convert<double>(s, "LONGITUDE_CENTROID", 3)));
-    point.setField(pdal::Dimension::Id::LatitudeCentroid,
-        convert<double>(s, "LATITUDE_CENTROID", 4));
-    point.setField(pdal::Dimension::Id::ElevationCentroid,
-        convert<double>(s, "ELEVATION_CENTROID", 5));
-    point.setField(pdal::Dimension::Id::LongitudeLow,
-        Utils::normalizeLongitude(convert<double>(s, "LONGITUDE_LOW", 6)));
-    point.setField(pdal::Dimension::Id::LatitudeLow,
-        convert<double>(s, "LATITUDE_LOW", 7));
-    point.setField(pdal::Dimension::Id::ElevationLow,
-        convert<double>(s, "ELEVATION_LOW", 8));
-    point.setField(pdal::Dimension::Id::LongitudeHigh,
-        Utils::normalizeLongitude(convert<double>(s, "LONGITUDE_HIGH", 9)));
-    point.setField(pdal::Dimension::Id::LatitudeHigh,
-        convert<double>(s, "LATITUDE_HIGH", 10));
-    point.setField(pdal::Dimension::Id::ElevationHigh,
-        convert<double>(s, "ELEVATION_HIGH", 11));
-
-    double x, y, z;
-    pdal::Dimension::Id xd, yd, zd;
-
-    xd = m_layout->findDim("LONGITUDE_" + pointMap);
-    yd = m_layout->findDim("LATITUDE_" + pointMap);
-    zd = m_layout->findDim("ELEVATION_" + pointMap);
-
-    x = point.getFieldAs<double>(xd);
-    y = point.getFieldAs<double>(yd);
-    z = point.getFieldAs<double>(zd);
-
-    point.setField(pdal::Dimension::Id::X, x);
-    point.setField(pdal::Dimension::Id::Y, y);
-    point.setField(pdal::Dimension::Id::Z, z);
+    size_t threads = threadCount(lines.size());
+    if (threads < 2)
+    {
+        try
+        {
+            for (size_t i = 0; i < lines.size(); ++i)
+                parseLine(lines[i], firstLine + i, vals + i * NumFields);
+        }
+        catch (const error& err)
+        {
+            throwError(err.what());
+        }
+        return;
+    }
+
+    // Parse slices of the batch on separate threads, each recording its
+    // first failure, and report the earliest one after the join.
+    std::vector<std::string> errors(threads);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&, t]()
+        {
+            size_t start = lines.size() * t / threads;
+            size_t end = lines.size() * (t + 1) / threads;
+            try
+            {
+                for (size_t i = start; i < end; ++i)
+                    parseLine(lines[i], firstLine + i, vals + i * NumFields);
+            }
+            catch (const error& err)
+            {
+                errors[t] = err.what();
+            }
+        });
+    for (auto& t : pool)
+        t.join();
+    for (const std::string& e : errors)
+        if (e.size())
+            throwError(e);
+}
+
+
+void Ilvis2Reader::fillPoint(PointRef& point, const double *vals, bool high)
+{
+    for (size_t i = 0; i < NumFields; ++i)
+        point.setField(fieldSpecs[i].m_dim, vals[i]);
+
+    if (high)
+    {
+        point.setField(Dimension::Id::X, vals[LonHigh]);
+        point.setField(Dimension::Id::Y, vals[LatHigh]);
+        point.setField(Dimension::Id::Z, vals[ElevHigh]);
+    }
+    else
+    {
+        point.setField(Dimension::Id::X, vals[LonLow]);
+        point.setField(Dimension::Id::Y, vals[LatLow]);
+        point.setField(Dimension::Id::Z, vals[ElevLow]);
+    }
 }
 
 
@@ -213,8 +321,9 @@ void Ilvis2Reader::ready(PointTableRef table)
 
     m_lineNum = 0;
     m_stream.reset(new std::ifstream(m_filename));
-    m_layout = table.layout();
     m_resample = false;
+    m_batch.clear();
+    m_batchPos = 0;
     for (size_t i = 0; i < HeaderSize; ++i)
     {
         std::getline(*m_stream, line);
@@ -227,48 +336,41 @@ bool Ilvis2Reader::processOne(PointRef& point)
 {
     std::string line;
 
-// Format:
-// LVIS_LFID SHOTNUMBER TIME LONGITUDE_CENTROID LATITUDE_CENTROID ELEVATION_CENTROID LONGITUDE_LOW LATITUDE_LOW ELEVATION_LOW LONGITUDE_HIGH LATITUDE_HIGH ELEVATION_HIGH
+    // This handles the second time through for this data line when we have
+    // an "ALL" mapping and the high and low elevations are different.
+    if (m_resample)
+    {
+        fillPoint(point, m_values.data(), true);
+        m_resample = false;
+        return true;
+    }
 
+    if (!std::getline(*m_stream, line))
+        return false;
+    m_lineNum++;
     try
     {
-        // This handles the second time through for this data line when we have
-        // an "ALL" mapping and the high and low elevations are different.
-        if (m_resample)
-        {
-            readPoint(point, m_fields, "HIGH");
-            m_resample = false;
-            return true;
-        }
-
-        if (!std::getline(*m_stream, line))
-            return false;
-        m_fields = Utils::split2(line, ' ');
-        if (m_fields.size() != 12)
-            throwError("Invalid format for line " +
-                Utils::toString(m_lineNum) + ".  Expected 12 fields, got " +
-                Utils::toString(m_fields.size()) + ".");
-
-        double low_elev = convert<double>(m_fields, "ELEVATION_LOW", 8);
-        double high_elev = convert<double>(m_fields, "ELEVATION_HIGH", 11);
-
-        // write LOW point if specified, or for ALL
-        if (m_mapping == IlvisMapping::LOW || m_mapping == IlvisMapping::ALL)
-        {
-            readPoint(point, m_fields, "LOW");
-            // If we have ALL mapping and the high elevation is different
-            // from that of the low elevation, we'll a second point with the
-            // high elevation.
-            if (m_mapping == IlvisMapping::ALL && (low_elev != high_elev))
-                m_resample = true;
-        }
-        else if (m_mapping == IlvisMapping::HIGH)
-            readPoint(point, m_fields, "HIGH");
+        parseLine(line, m_lineNum, m_values.data());
     }
     catch (const error& err)
     {
         throwError(err.what());
     }
+
+    // write LOW point if specified, or for ALL
+    if (m_mapping == IlvisMapping::LOW || m_mapping == IlvisMapping::ALL)
+    {
+        fillPoint(point, m_values.data(), false);
+        // If we have ALL mapping and the high elevation is different
+        // from that of the low elevation, we'll write a second point with
+        // the high elevation.
+        if (m_mapping == IlvisMapping::ALL &&
+            m_values[ElevLow] != m_values[ElevHigh])
+            m_resample = true;
+    }
+    else if (m_mapping == IlvisMapping::HIGH)
+        fillPoint(point, m_values.data(), true);
+
     return true;
 }
 
@@ -279,14 +381,80 @@ point_count_t Ilvis2Reader::read(PointViewPtr view, point_count_t count)
     point_count_t numRead = 0;
 
     PointRef point = PointRef(*view, 0);
-    while (numRead < count)
+
+    auto emit = [&](const double *vals, bool high)
     {
         point.setPointId(idx++);
-        if (!processOne(point))
-            break;
+        fillPoint(point, vals, high);
         if (m_cb)
             m_cb(*view, idx);
         numRead++;
+    };
+
+    // Emit the high point of a record whose low point went out at the end
+    // of a previous call.
+    if (m_resample && numRead < count)
+    {
+        m_resample = false;
+        emit(m_values.data(), true);
+    }
+
+    std::vector<std::string> lines;
+    while (numRead < count)
+    {
+        if (m_batchPos * NumFields == m_batch.size())
+        {
+            // Gather a batch of lines and parse them across threads
+            // before filling the view serially.
+            lines.clear();
+            size_t firstLine = m_lineNum + 1;
+            std::string line;
+            while (lines.size() < BatchLines && std::getline(*m_stream, line))
+            {
+                m_lineNum++;
+                lines.push_back(std::move(line));
+            }
+            if (lines.empty())
+                break;
+            m_batch.resize(lines.size() * NumFields);
+            m_batchPos = 0;
+            parseLines(lines, firstLine, m_batch.data());
+        }
+
+        const double *v = m_batch.data() + m_batchPos * NumFields;
+        m_batchPos++;
+        switch (m_mapping)
+        {
+        case IlvisMapping::LOW:
+            emit(v, false);
+            break;
+        case IlvisMapping::HIGH:
+            emit(v, true);
+            break;
+        case IlvisMapping::ALL:
+            emit(v, false);
+            if (v[ElevLow] != v[ElevHigh])
+            {
+                if (numRead < count)
+                    emit(v, true);
+                else
+                {
+                    // No room for the high point - hold it for the next
+                    // call.
+                    std::copy(v, v + NumFields, m_values.begin());
+                    m_resample = true;
+                }
+            }
+            break;
+        case IlvisMapping::INVALID:
+            // Matches the stream path: the point is counted but no fields
+            // are written.
+            point.setPointId(idx++);
+            if (m_cb)
+                m_cb(*view, idx);
+            numRead++;
+            break;
+        }
     }
 
     return numRead;
@@ -37,6 +37,7 @@
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
 #include <pdal/util/IStream.hpp>
+#include <array>
 #include <map>
 
 #ifndef PDAL_HAVE_LIBXML2
@@ -79,10 +80,15 @@ public:
 private:
     std::unique_ptr<std::ifstream> m_stream;
     IlvisMapping m_mapping;
-    StringList m_fields;
     size_t m_lineNum;
     bool m_resample;
-    PointLayoutPtr m_layout;
+    // Values of the current record in stream mode, or of the record whose
+    // high point is pending when m_resample is set.
+    std::array<double, 12> m_values;
+    // Parsed records buffered by read() - 12 values per record.
+    std::vector<double> m_batch;
+    size_t m_batchPos;
+    size_t m_threads;
     std::string m_metadataFile;
     Ilvis2MetadataReader m_mdReader;
 
@@ -94,7 +100,12 @@ private:
     virtual point_count_t read(PointViewPtr view, point_count_t count);
     virtual void done(PointTableRef table);
 
-    virtual void readPoint(PointRef& point, StringList s, std::string pointMap);
+    size_t threadCount(size_t lines) const;
+    void parseLine(const std::string& line, size_t lineNum,
+        double *vals) const;
+    void parseLines(const std::vector<std::string>& lines, size_t firstLine,
+        double *vals);
+    void fillPoint(PointRef& point, const double *vals, bool high);
 };
 
 std::ostream& operator<<(std::ostream& out,
@@ -67,7 +67,8 @@ LasHeader::LasHeader() : m_fileSig(FILE_SIGNATURE), m_sourceId(0),
     m_globalEncoding(0), m_versionMinor(2), m_systemId(getSystemIdentifier()),
     m_createDOY(0), m_createYear(0), m_vlrOffset(0), m_pointOffset(0),
     m_vlrCount(0), m_pointFormat(0), m_pointLen(0), m_pointCount(0),
-    m_isCompressed(false), m_eVlrOffset(0), m_eVlrCount(0)
+    m_isCompressed(false), m_eVlrOffset(0), m_eVlrCount(0),
+    m_vlrStream(nullptr)
 {
     std::time_t now;
     std::time(&now);
@@ -262,7 +263,16 @@ const LasVLR *LasHeader::findVlr(const std::string& userId,
     {
         const LasVLR& vlr = *vi;
         if (vlr.matches(userId, recordId))
+        {
+            if (vlr.deferred())
+            {
+                if (!m_vlrStream)
+                    throw error("Can't load deferred VLR data - "
+                        "no input stream.");
+                vlr.load(*m_vlrStream);
+            }
             return &vlr;
+        }
     }
     return NULL;
 }
@@ -381,6 +391,9 @@ ILeStream& operator>>(ILeStream& in, LasHeader& h)
             in >> h.m_pointCountByReturn[i];
     }
 
+    // Bodies of large VLRs are deferred; remember where to load them from.
+    h.m_vlrStream = in.stream();
+
     // Read regular VLRs.
     in.seek(h.m_vlrOffset);
     for (size_t i = 0; i < h.m_vlrCount; ++i)
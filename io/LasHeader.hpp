@@ -421,6 +421,9 @@ private:
     SpatialReference m_srs;
     VlrList m_vlrs;
     VlrList m_eVlrs;
+    // Source of deferred VLR bodies; set when the header is extracted
+    // from a stream.
+    std::istream *m_vlrStream;
 
     void setSrs();
     void setSrsFromWkt();
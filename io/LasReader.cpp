@@ -38,6 +38,7 @@
 
 #include <sstream>
 #include <string.h>
+#include <thread>
 
 #include <pdal/pdal_features.hpp>
 #include <pdal/Metadata.hpp>
@@ -46,6 +47,7 @@
 #include <pdal/util/Extractor.hpp>
 #include <pdal/util/IStream.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "GeotiffSupport.hpp"
 #include "LasHeader.hpp"
@@ -65,7 +67,9 @@ struct invalid_stream : public std::runtime_error
 
 } // unnamed namespace
 
-LasReader::LasReader() : m_decompressor(nullptr), m_index(0)
+LasReader::LasReader() : m_decompressor(nullptr), m_index(0),
+    m_mapData(nullptr), m_mapPoints(0), m_prefetchTried(false),
+    m_chunkBoundsPoints(0)
 {}
 
 
@@ -85,6 +89,8 @@ void LasReader::addArgs(ProgramArgs& args)
     args.add("use_eb_vlr", "Use extra bytes VLR for 1.0 - 1.3 files",
         m_useEbVlr);
     args.add("ignore_vlr", "VLR userid/recordid to ignore", m_ignoreVLROption);
+    args.add("mmap", "Memory-map the file and parse point records directly "
+        "from the mapping (uncompressed files only)", m_mmap);
 }
 
 
@@ -215,6 +221,7 @@ void LasReader::initializeLocal(PointTableRef table, MetadataNode& m)
 
     if (m_header.versionAtLeast(1, 4) || m_useEbVlr)
         readExtraBytesVlr();
+    readChunkBoundsVlr();
     setSrs(m);
     MetadataNode forward = table.privateMetadata("lasforward");
     extractHeaderMetadata(forward, m);
@@ -243,6 +250,7 @@ void LasReader::ready(PointTableRef table)
     std::istream *stream(m_streamIf->m_istream);
 
     m_index = 0;
+    buildBulkPlan(table.layout());
     if (m_header.compressed())
     {
 #ifdef PDAL_HAVE_LASZIP
@@ -278,7 +286,91 @@ void LasReader::ready(PointTableRef table)
 #endif
     }
     else
+    {
+        if (m_mmap)
+        {
+            // Map the whole file and parse point records directly from
+            // the mapping, skipping the copy into the stream buffer.
+            m_mapCtx = FileUtils::mapFile(m_filename);
+            if (m_mapCtx.addr())
+            {
+                std::streamoff start = m_streamIf->m_fileOffset +
+                    m_header.pointOffset();
+                m_mapData = reinterpret_cast<const char *>(
+                    m_mapCtx.addr()) + start;
+                m_mapPoints = 0;
+                if ((uintmax_t)start < m_mapCtx.m_size)
+                    m_mapPoints = (m_mapCtx.m_size - start) /
+                        m_header.pointLen();
+            }
+            else
+                log()->get(LogLevel::Warning) << getName() <<
+                    ": Couldn't memory-map '" << m_filename << "': " <<
+                    m_mapCtx.what() << "  Reading through a stream." <<
+                    std::endl;
+        }
         stream->seekg(m_header.pointOffset());
+    }
+
+    // With a chunk bounds table and pushed-down crop bounds, mark the
+    // chunks that can't contain a surviving point.  Skipping is a hint -
+    // the downstream crop filters exactly.
+    m_chunkSkip.clear();
+    if (m_chunkBoundsTable.size() && pushdownBounds().size())
+    {
+        m_chunkSkip.resize(m_chunkBoundsTable.size());
+        for (size_t i = 0; i < m_chunkBoundsTable.size(); ++i)
+            m_chunkSkip[i] = !pushdownOverlaps(m_chunkBoundsTable[i]);
+    }
+
+    // If downstream cropping was pushed down and the file's extent is
+    // disjoint from it, nothing in the file survives - don't read any
+    // points.
+    if (!pushdownOverlaps(m_header.getBounds()))
+    {
+        log()->get(LogLevel::Debug) << getName() << ": extent of '" <<
+            m_filename << "' doesn't overlap the pushed-down crop "
+            "bounds - skipping all points.\n";
+        m_index = getNumPoints();
+    }
+
+    // A checkpointed run picks up where the interrupted one stopped
+    // (see Reader::resumeAt()).  Past the last point there's nothing
+    // to position - processOne()/read() report EOF from m_index alone.
+    if (resumePoint() && m_index == 0)
+    {
+        m_index = (std::min)(resumePoint(), getNumPoints());
+        if (m_index == getNumPoints())
+            return;
+        if (m_header.compressed())
+        {
+#ifdef PDAL_HAVE_LASZIP
+            if (m_compression == "LASZIP")
+                handleLaszip(laszip_seek_point(m_laszip, m_index));
+#endif
+#ifdef PDAL_HAVE_LAZPERF
+            if (m_compression == "LAZPERF")
+                m_decompressor->seek(m_index);
+#endif
+        }
+        else
+            stream->seekg(m_header.pointOffset() +
+                m_index * m_header.pointLen());
+    }
+}
+
+
+bool LasReader::resumable() const
+{
+    // Uncompressed records are seekable directly; compressed data can be
+    // repositioned only when a decompressor that can seek is available.
+    if (!m_header.compressed())
+        return true;
+#if defined(PDAL_HAVE_LASZIP) || defined(PDAL_HAVE_LAZPERF)
+    return true;
+#else
+    return false;
+#endif
 }
 
 
@@ -486,6 +578,43 @@ void LasReader::readExtraBytesVlr()
 }
 
 
+// Load the chunk bounds table written by the LAS writer's spatial_order
+// mode (see LasWriter::addChunkBoundsEVlr()).  Each row is the extent of
+// one fixed-size run of points in file order; when those runs line up
+// with the compressor's chunks, out-of-bounds chunks can be skipped
+// without decompressing them.
+void LasReader::readChunkBoundsVlr()
+{
+    const LasVLR *vlr = m_header.findVlr(PDAL_USER_ID,
+        PDAL_CHUNK_BOUNDS_RECORD_ID);
+    if (!vlr)
+        return;
+    size_t size = vlr->dataLen();
+    if (size < 2 * sizeof(uint32_t))
+    {
+        log()->get(LogLevel::Warning) << "Bad size for chunk bounds VLR.  "
+            "Ignoring.";
+        return;
+    }
+
+    LeExtractor extractor(vlr->data(), size);
+    uint32_t pointsPerChunk;
+    uint32_t chunkCount;
+    extractor >> pointsPerChunk >> chunkCount;
+    if (pointsPerChunk == 0 || size < 2 * sizeof(uint32_t) +
+        (size_t)chunkCount * 6 * sizeof(double))
+    {
+        log()->get(LogLevel::Warning) << "Bad size for chunk bounds VLR.  "
+            "Ignoring.";
+        return;
+    }
+    m_chunkBoundsPoints = pointsPerChunk;
+    m_chunkBoundsTable.resize(chunkCount);
+    for (BOX3D& b : m_chunkBoundsTable)
+        extractor >> b.minx >> b.miny >> b.minz >> b.maxx >> b.maxy >> b.maxz;
+}
+
+
 void LasReader::setSrs(MetadataNode& m)
 {
     setSpatialReference(m, m_header.srs());
@@ -532,33 +661,42 @@ void LasReader::addDimensions(PointLayoutPtr layout)
 {
     using namespace Dimension;
 
+    // Fields pruned by dimension pushdown (see Reader::keepDim()) are
+    // never registered.  Assigning to an unregistered dimension is a
+    // no-op, so the load paths below need no knowledge of the pruning.
+    auto reg = [this, layout](Id id, Type type)
+    {
+        if (keepDim(id))
+            layout->registerDim(id, type);
+    };
+
     layout->registerDim(Id::X, Type::Double);
     layout->registerDim(Id::Y, Type::Double);
     layout->registerDim(Id::Z, Type::Double);
-    layout->registerDim(Id::Intensity, Type::Unsigned16);
-    layout->registerDim(Id::ReturnNumber, Type::Unsigned8);
-    layout->registerDim(Id::NumberOfReturns, Type::Unsigned8);
-    layout->registerDim(Id::ScanDirectionFlag, Type::Unsigned8);
-    layout->registerDim(Id::EdgeOfFlightLine, Type::Unsigned8);
-    layout->registerDim(Id::Classification, Type::Unsigned8);
-    layout->registerDim(Id::ScanAngleRank, Type::Float);
-    layout->registerDim(Id::UserData, Type::Unsigned8);
-    layout->registerDim(Id::PointSourceId, Type::Unsigned16);
+    reg(Id::Intensity, Type::Unsigned16);
+    reg(Id::ReturnNumber, Type::Unsigned8);
+    reg(Id::NumberOfReturns, Type::Unsigned8);
+    reg(Id::ScanDirectionFlag, Type::Unsigned8);
+    reg(Id::EdgeOfFlightLine, Type::Unsigned8);
+    reg(Id::Classification, Type::Unsigned8);
+    reg(Id::ScanAngleRank, Type::Float);
+    reg(Id::UserData, Type::Unsigned8);
+    reg(Id::PointSourceId, Type::Unsigned16);
 
     if (m_header.hasTime())
-        layout->registerDim(Id::GpsTime, Type::Double);
+        reg(Id::GpsTime, Type::Double);
     if (m_header.hasColor())
     {
-        layout->registerDim(Id::Red, Type::Unsigned16);
-        layout->registerDim(Id::Green, Type::Unsigned16);
-        layout->registerDim(Id::Blue, Type::Unsigned16);
+        reg(Id::Red, Type::Unsigned16);
+        reg(Id::Green, Type::Unsigned16);
+        reg(Id::Blue, Type::Unsigned16);
     }
     if (m_header.hasInfrared())
-        layout->registerDim(Id::Infrared);
+        reg(Id::Infrared, Type::Unsigned16);
     if (m_header.versionAtLeast(1, 4))
     {
-        layout->registerDim(Id::ScanChannel);
-        layout->registerDim(Id::ClassFlags);
+        reg(Id::ScanChannel, Type::Unsigned8);
+        reg(Id::ClassFlags, Type::Unsigned8);
     }
 
     for (auto& dim : m_extraDims)
@@ -566,6 +704,8 @@ void LasReader::addDimensions(PointLayoutPtr layout)
         Dimension::Type type = dim.m_dimType.m_type;
         if (type == Dimension::Type::None)
             continue;
+        if (!keepDim(dim.m_name))
+            continue;
         if (dim.m_dimType.m_xform.nonstandard())
             type = Dimension::Type::Double;
         dim.m_dimType.m_id = layout->registerOrAssignDim(dim.m_name, type);
@@ -602,6 +742,13 @@ bool LasReader::processOne(PointRef& point)
             "LAZperf decompression library.");
 #endif
     } // compression
+    else if (m_mapData)
+    {
+        if (m_index >= m_mapPoints)
+            return false;
+        loadPoint(point,
+            const_cast<char *>(m_mapData + m_index * pointLen), pointLen);
+    }
     else
     {
         std::vector<char> buf(m_header.pointLen());
@@ -618,11 +765,19 @@ point_count_t LasReader::read(PointViewPtr view, point_count_t count)
 {
     size_t pointLen = m_header.pointLen();
     count = (std::min)(count, getNumPoints() - m_index);
+    if (!count)
+        return 0;
 
     PointId i = 0;
     if (m_header.compressed())
     {
 #if defined(PDAL_HAVE_LAZPERF) || defined(PDAL_HAVE_LASZIP)
+#ifdef PDAL_HAVE_LAZPERF
+        // Chunked LAZ can be decompressed chunk-parallel.
+        if (m_compression == "LAZPERF" && m_decompressor->chunked() &&
+            std::thread::hardware_concurrency() > 1)
+            return readChunksParallel(view, count);
+#endif
         if (m_compression == "LASZIP" || m_compression == "LAZPERF")
         {
             for (i = 0; i < count; i++)
@@ -639,6 +794,28 @@ point_count_t LasReader::read(PointViewPtr view, point_count_t count)
             "LAZperf decompression library.");
 #endif
     }
+    else if (m_mapData)
+    {
+        // Parse point records straight from the file mapping.
+        count = (std::min)(count,
+            m_mapPoints - (std::min)(m_mapPoints, m_index));
+        const char *pos = m_mapData + m_index * pointLen;
+        if (bulkLoadable(*view))
+        {
+            loadPoints(*view, pos, count);
+            i = count;
+        }
+        else while (i < count)
+        {
+            PointId id = view->size();
+            PointRef point = view->point(id);
+            loadPoint(point, const_cast<char *>(pos), pointLen);
+            if (m_cb)
+                m_cb(*view, id);
+            pos += pointLen;
+            i++;
+        }
+    }
     else
     {
         point_count_t remaining = count;
@@ -646,6 +823,91 @@ point_count_t LasReader::read(PointViewPtr view, point_count_t count)
         // Make a buffer at most a meg.
         size_t bufsize = (std::min)((point_count_t)1000000, count * pointLen);
         std::vector<char> buf(bufsize);
+
+        if (!m_prefetch && !m_prefetchTried)
+        {
+            // Open an async prefetcher on separate handles so upcoming
+            // blocks can be in flight while the current one is parsed.
+            // If the source isn't a plain openable file, reads just
+            // stay synchronous.
+            m_prefetchTried = true;
+            m_prefetch.reset(new AsyncReader(m_filename));
+            if (!m_prefetch->good())
+                m_prefetch.reset();
+        }
+
+        std::streamoff streamPos = m_streamIf->m_istream->tellg();
+        if (m_prefetch && streamPos >= 0)
+        {
+            // Parse blocks while the next one is in flight on the
+            // prefetcher.  Each block is striped across the prefetch
+            // workers, so the storage sees several queued reads
+            // instead of one synchronous one.
+            std::vector<char> next(bufsize);
+            uint64_t offset = (uint64_t)streamPos;
+            uint64_t left = (uint64_t)count * pointLen;
+
+            size_t want = (size_t)(std::min)((uint64_t)bufsize, left);
+            AsyncReader::RequestId pending =
+                m_prefetch->submit(offset, next.data(), want);
+            bool inFlight = true;
+            try
+            {
+                while (left)
+                {
+                    int64_t got = m_prefetch->complete(pending);
+                    inFlight = false;
+                    if (got <= 0)
+                        break;
+                    offset += (uint64_t)got;
+                    left -= (std::min)((uint64_t)got, left);
+                    if ((size_t)got < want)  // Truncated file.
+                        left = 0;
+                    buf.swap(next);
+                    if (left)
+                    {
+                        want = (size_t)(std::min)((uint64_t)bufsize, left);
+                        pending = m_prefetch->submit(offset, next.data(),
+                            want);
+                        inFlight = true;
+                    }
+
+                    point_count_t blockPoints =
+                        (point_count_t)(got / pointLen);
+                    char *pos = buf.data();
+                    if (bulkLoadable(*view))
+                    {
+                        loadPoints(*view, pos, blockPoints);
+                        i += blockPoints;
+                        continue;
+                    }
+                    while (blockPoints--)
+                    {
+                        PointId id = view->size();
+                        PointRef point = view->point(id);
+                        loadPoint(point, pos, pointLen);
+                        if (m_cb)
+                            m_cb(*view, id);
+                        pos += pointLen;
+                        i++;
+                    }
+                }
+            }
+            catch (...)
+            {
+                // Nothing may stay in flight into 'next' once it goes
+                // out of scope.
+                if (inFlight)
+                    m_prefetch->complete(pending);
+                throw;
+            }
+            // Keep the stream positioned as if it had done the reads.
+            m_streamIf->m_istream->clear();
+            m_streamIf->m_istream->seekg(streamPos +
+                (std::streamoff)(i * pointLen));
+            m_index += i;
+            return (point_count_t)i;
+        }
         try
         {
             do
@@ -653,6 +915,12 @@ point_count_t LasReader::read(PointViewPtr view, point_count_t count)
                 point_count_t blockPoints = readFileBlock(buf, remaining);
                 remaining -= blockPoints;
                 char *pos = buf.data();
+                if (bulkLoadable(*view))
+                {
+                    loadPoints(*view, pos, blockPoints);
+                    i += blockPoints;
+                    continue;
+                }
                 while (blockPoints--)
                 {
                     PointId id = view->size();
@@ -675,6 +943,96 @@ point_count_t LasReader::read(PointViewPtr view, point_count_t count)
 }
 
 
+#ifdef PDAL_HAVE_LAZPERF
+// Decompress batches of LAZ chunks on a thread pool and load the resulting
+// point records sequentially.  Batches are bounded so the decompressed
+// buffer stays modest no matter how many points are requested.
+point_count_t LasReader::readChunksParallel(PointViewPtr view,
+    point_count_t count)
+{
+    size_t pointLen = m_header.pointLen();
+    uint32_t chunkPts = m_decompressor->chunkSize();
+    size_t chunkCnt = m_decompressor->chunkCount();
+    point_count_t filePoints = getNumPoints();
+
+    ThreadPool pool(std::thread::hardware_concurrency());
+    size_t batchChunks = 4 * pool.numThreads();
+
+    // The chunk bounds table can rule out whole chunks, but only when
+    // its rows line up with the compressor's chunks.
+    bool haveSkip = (m_chunkSkip.size() == chunkCnt &&
+        m_chunkBoundsPoints == chunkPts);
+
+    point_count_t numRead = 0;
+    while (count && m_index < filePoints)
+    {
+        size_t firstChunk = m_index / chunkPts;
+        if (haveSkip && m_chunkSkip[firstChunk])
+        {
+            // Nothing in this chunk survives the pushed-down bounds.
+            point_count_t chunkEnd = (std::min)(
+                (point_count_t)(firstChunk + 1) * chunkPts, filePoints);
+            count -= (std::min)(count, chunkEnd - m_index);
+            m_index = chunkEnd;
+            continue;
+        }
+        size_t endChunk = (std::min)(firstChunk + batchChunks, chunkCnt);
+        // Offset of the first wanted point within the first chunk.
+        point_count_t skip = m_index % chunkPts;
+
+        // Chunks are always decoded from their start, so the first chunk
+        // may yield leading points we discard below.
+        point_count_t batchPts = 0;
+        std::vector<point_count_t> chunkCounts;
+        for (size_t chunk = firstChunk; chunk < endChunk; ++chunk)
+        {
+            // Stop the batch at a skipped chunk; the outer loop jumps it.
+            if (haveSkip && m_chunkSkip[chunk])
+                break;
+            point_count_t ptsInChunk = (std::min)((point_count_t)chunkPts,
+                filePoints - (point_count_t)chunk * chunkPts);
+            chunkCounts.push_back(ptsInChunk);
+            batchPts += ptsInChunk;
+            if (batchPts - skip >= count)
+                break;
+        }
+
+        std::vector<char> buf(batchPts * pointLen);
+        size_t offset = 0;
+        for (size_t i = 0; i < chunkCounts.size(); ++i)
+        {
+            size_t chunk = firstChunk + i;
+            point_count_t pts = chunkCounts[i];
+            char *dst = buf.data() + offset;
+            pool.add([this, chunk, pts, dst]()
+                { m_decompressor->decompressChunk(chunk, pts, dst); });
+            offset += pts * pointLen;
+        }
+        pool.await();
+        if (pool.errors().size())
+            throwError("Error decompressing LAZ chunk: " +
+                pool.errors().front());
+
+        point_count_t usable = (std::min)(count, batchPts - skip);
+        char *pos = buf.data() + skip * pointLen;
+        for (point_count_t i = 0; i < usable; ++i)
+        {
+            PointId id = view->size();
+            PointRef point = view->point(id);
+            loadPoint(point, pos, pointLen);
+            if (m_cb)
+                m_cb(*view, id);
+            pos += pointLen;
+        }
+        m_index += usable;
+        count -= usable;
+        numRead += usable;
+    }
+    return numRead;
+}
+#endif  // PDAL_HAVE_LAZPERF
+
+
 point_count_t LasReader::readFileBlock(std::vector<char>& buf,
     point_count_t maxpoints)
 {
@@ -940,12 +1298,259 @@ void LasReader::loadPointV14(PointRef& point, char *buf, size_t bufsize)
 }
 
 
+// Determine whether point records can be loaded without going through
+// field-by-field conversion.  Fields whose registered storage type matches
+// the type in the record are copied verbatim; X/Y/Z and the bit-packed
+// flags always need a conversion pass.  If any standard field was
+// registered with a non-native type the plan is marked invalid and the
+// general path is used.
+void LasReader::buildBulkPlan(const PointLayout *layout)
+{
+    using namespace Dimension;
+
+    BulkPlan& p = m_bulk;
+    p = BulkPlan();
+
+    // Extra dimensions can carry scale/offset transforms; stick with the
+    // general path when any are present.
+    if (m_extraDims.size())
+        return;
+
+    bool ok = true;
+    auto offset = [layout, &ok](Id id, Type want) -> size_t
+    {
+        // Pruned by dimension pushdown - nothing to store.
+        if (!layout->hasDim(id))
+            return BulkPlan::None;
+        const Dimension::Detail *d = layout->dimDetail(id);
+        if (!d || d->type() != want)
+        {
+            ok = false;
+            return 0;
+        }
+        return d->offset();
+    };
+    auto copy = [this, &offset](Id id, size_t src, Type want)
+    {
+        size_t dst = offset(id, want);
+        if (dst == BulkPlan::None)
+            return;
+        m_bulk.m_copy.push_back({src, dst, Dimension::size(want)});
+    };
+
+    const LasHeader& h = m_header;
+
+    p.m_x = offset(Id::X, Type::Double);
+    p.m_y = offset(Id::Y, Type::Double);
+    p.m_z = offset(Id::Z, Type::Double);
+    p.m_returnNum = offset(Id::ReturnNumber, Type::Unsigned8);
+    p.m_numReturns = offset(Id::NumberOfReturns, Type::Unsigned8);
+    p.m_scanDir = offset(Id::ScanDirectionFlag, Type::Unsigned8);
+    p.m_eofl = offset(Id::EdgeOfFlightLine, Type::Unsigned8);
+    p.m_scanAngle = offset(Id::ScanAngleRank, Type::Float);
+
+    copy(Id::Intensity, 12, Type::Unsigned16);
+    copy(Id::UserData, 17, Type::Unsigned8);
+    if (h.has14Format())
+    {
+        p.m_classFlags = offset(Id::ClassFlags, Type::Unsigned8);
+        p.m_scanChannel = offset(Id::ScanChannel, Type::Unsigned8);
+        copy(Id::Classification, 16, Type::Unsigned8);
+        copy(Id::PointSourceId, 20, Type::Unsigned16);
+        copy(Id::GpsTime, 22, Type::Double);
+        if (h.hasColor())
+        {
+            copy(Id::Red, 30, Type::Unsigned16);
+            copy(Id::Green, 32, Type::Unsigned16);
+            copy(Id::Blue, 34, Type::Unsigned16);
+        }
+        if (h.hasInfrared())
+            copy(Id::Infrared, 36, Type::Unsigned16);
+    }
+    else
+    {
+        copy(Id::Classification, 15, Type::Unsigned8);
+        copy(Id::PointSourceId, 18, Type::Unsigned16);
+        size_t pos = 20;
+        if (h.hasTime())
+        {
+            copy(Id::GpsTime, pos, Type::Double);
+            pos += sizeof(double);
+        }
+        if (h.hasColor())
+        {
+            copy(Id::Red, pos, Type::Unsigned16);
+            copy(Id::Green, pos + 2, Type::Unsigned16);
+            copy(Id::Blue, pos + 4, Type::Unsigned16);
+        }
+    }
+    p.m_ok = ok;
+}
+
+
+bool LasReader::bulkLoadable(const PointView& view) const
+{
+    return m_bulk.m_ok && view.table().packedPointAccess();
+}
+
+
+// Load a block of contiguous point records directly into point memory,
+// bypassing per-field extraction.  Matching fields blit straight from the
+// record; only X/Y/Z scaling and the bit-packed flags need per-point work.
+// Like the rest of the record parsing, this assumes a little-endian host.
+void LasReader::loadPoints(PointView& view, const char *buf,
+    point_count_t numPts)
+{
+    const LasHeader& h = m_header;
+    const BulkPlan& p = m_bulk;
+    size_t pointLen = h.pointLen();
+    bool has14 = h.has14Format();
+
+    const XForm xXform(h.scaleX(), h.offsetX());
+    const XForm yXform(h.scaleY(), h.offsetY());
+    const XForm zXform(h.scaleZ(), h.offsetZ());
+
+    // Gather coordinates a block at a time so the scale/offset arithmetic
+    // runs over contiguous arrays and can vectorize.
+    static const point_count_t GatherPts = 256;
+    int32_t xi[GatherPts], yi[GatherPts], zi[GatherPts];
+    double xd[GatherPts], yd[GatherPts], zd[GatherPts];
+    char *pts[GatherPts];
+    PointId ids[GatherPts];
+
+    while (numPts)
+    {
+        point_count_t n = (std::min)(numPts, GatherPts);
+        numPts -= n;
+
+        const char *src = buf;
+        for (point_count_t j = 0; j < n; ++j, src += pointLen)
+        {
+            memcpy(&xi[j], src + 0, sizeof(int32_t));
+            memcpy(&yi[j], src + 4, sizeof(int32_t));
+            memcpy(&zi[j], src + 8, sizeof(int32_t));
+        }
+        xXform.fromScaled(xi, xd, n);
+        yXform.fromScaled(yi, yd, n);
+        zXform.fromScaled(zi, zd, n);
+
+        // Add all the block's points before taking any pointer - adding
+        // a point can reallocate the table's storage, which would leave
+        // pointers taken earlier dangling.
+        for (point_count_t j = 0; j < n; ++j)
+        {
+            ids[j] = view.size();
+            view.getOrAddPoint(ids[j]);
+        }
+        for (point_count_t j = 0; j < n; ++j)
+            pts[j] = view.getOrAddPoint(ids[j]);
+
+        for (point_count_t j = 0; j < n; ++j)
+        {
+            memcpy(pts[j] + p.m_x, &xd[j], sizeof(double));
+            memcpy(pts[j] + p.m_y, &yd[j], sizeof(double));
+            memcpy(pts[j] + p.m_z, &zd[j], sizeof(double));
+        }
+
+        // Transpose the matching fields a field at a time rather than a
+        // point at a time - each loop is then a fixed-size copy at constant
+        // offsets that the compiler can unroll and vectorize instead of a
+        // variable-length memcpy per field per point.
+        for (const CopyField& f : p.m_copy)
+        {
+            const size_t dst = f.m_dstOffset;
+            src = buf + f.m_srcOffset;
+            switch (f.m_size)
+            {
+            case 1:
+                for (point_count_t j = 0; j < n; ++j, src += pointLen)
+                    pts[j][dst] = *src;
+                break;
+            case 2:
+                for (point_count_t j = 0; j < n; ++j, src += pointLen)
+                    memcpy(pts[j] + dst, src, 2);
+                break;
+            case 4:
+                for (point_count_t j = 0; j < n; ++j, src += pointLen)
+                    memcpy(pts[j] + dst, src, 4);
+                break;
+            default:
+                for (point_count_t j = 0; j < n; ++j, src += pointLen)
+                    memcpy(pts[j] + dst, src, 8);
+                break;
+            }
+        }
+
+        src = buf;
+        for (point_count_t j = 0; j < n; ++j, src += pointLen)
+        {
+            char *pt = pts[j];
+
+            if (has14)
+            {
+                uint8_t returnInfo = (uint8_t)src[14];
+                uint8_t flags = (uint8_t)src[15];
+
+                if (p.m_returnNum != BulkPlan::None)
+                    pt[p.m_returnNum] = returnInfo & 0x0F;
+                if (p.m_numReturns != BulkPlan::None)
+                    pt[p.m_numReturns] = (returnInfo >> 4) & 0x0F;
+                if (p.m_classFlags != BulkPlan::None)
+                    pt[p.m_classFlags] = flags & 0x0F;
+                if (p.m_scanChannel != BulkPlan::None)
+                    pt[p.m_scanChannel] = (flags >> 4) & 0x03;
+                if (p.m_scanDir != BulkPlan::None)
+                    pt[p.m_scanDir] = (flags >> 6) & 0x01;
+                if (p.m_eofl != BulkPlan::None)
+                    pt[p.m_eofl] = (flags >> 7) & 0x01;
+
+                if (p.m_scanAngle != BulkPlan::None)
+                {
+                    int16_t scanAngle;
+                    memcpy(&scanAngle, src + 18, sizeof(scanAngle));
+                    float angle = (float)(scanAngle * .006);
+                    memcpy(pt + p.m_scanAngle, &angle, sizeof(angle));
+                }
+            }
+            else
+            {
+                uint8_t flags = (uint8_t)src[14];
+
+                if (p.m_returnNum != BulkPlan::None)
+                    pt[p.m_returnNum] = flags & 0x07;
+                if (p.m_numReturns != BulkPlan::None)
+                    pt[p.m_numReturns] = (flags >> 3) & 0x07;
+                if (p.m_scanDir != BulkPlan::None)
+                    pt[p.m_scanDir] = (flags >> 6) & 0x01;
+                if (p.m_eofl != BulkPlan::None)
+                    pt[p.m_eofl] = (flags >> 7) & 0x01;
+
+                if (p.m_scanAngle != BulkPlan::None)
+                {
+                    float angle = (float)(int8_t)src[16];
+                    memcpy(pt + p.m_scanAngle, &angle, sizeof(angle));
+                }
+            }
+        }
+
+        if (m_cb)
+            for (point_count_t j = 0; j < n; ++j)
+                m_cb(view, ids[j]);
+
+        buf += n * pointLen;
+    }
+}
+
+
 void LasReader::loadExtraDims(LeExtractor& istream, PointRef& point)
 {
     for (auto& dim : m_extraDims)
     {
-        // Dimension type of None is undefined and unprocessed
-        if (dim.m_dimType.m_type == Dimension::Type::None)
+        // Dimension type of None is undefined and unprocessed.  An
+        // unknown ID means the dimension was pruned by pushdown and
+        // never registered.
+        if (dim.m_dimType.m_type == Dimension::Type::None ||
+            dim.m_dimType.m_id == Dimension::Id::Unknown)
         {
             istream.skip(dim.m_size);
             continue;
@@ -974,6 +1579,11 @@ void LasReader::done(PointTableRef)
         handleLaszip(laszip_destroy(m_laszip));
     }
 #endif
+    if (m_mapCtx.addr())
+        m_mapCtx = FileUtils::unmapFile(m_mapCtx);
+    m_mapData = nullptr;
+    m_mapPoints = 0;
+    m_prefetch.reset();
     m_streamIf.reset();
 }
 
@@ -39,6 +39,8 @@
 #include <pdal/PDALUtils.hpp>
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
+#include <pdal/util/AsyncReader.hpp>
+#include <pdal/util/FileUtils.hpp>
 
 #ifdef PDAL_HAVE_LASZIP
 #include <laszip/laszip_api.h>
@@ -74,6 +76,10 @@ protected:
         LasStreamIf(const std::string& filename)
             { m_istream = Utils::openFile(filename); }
 
+        // Offset of the LAS data from the start of the underlying file.
+        // Nonzero when the LAS data is embedded in a container format.
+        std::streamoff m_fileOffset = 0;
+
         virtual ~LasStreamIf()
         {
             if (m_istream)
@@ -128,6 +134,51 @@ private:
     std::string m_compression;
     StringList m_ignoreVLROption;
     bool m_useEbVlr;
+    bool m_mmap;
+    FileUtils::MapContext m_mapCtx;
+    const char *m_mapData;
+    point_count_t m_mapPoints;
+    /// Async prefetcher for the streamed uncompressed path, created on
+    /// first block read.
+    std::unique_ptr<AsyncReader> m_prefetch;
+    bool m_prefetchTried;
+    // Chunk extent table written by the LAS writer's spatial_order mode.
+    // With bounds pushdown in effect, chunks whose extents miss the
+    // bounds are skipped (m_chunkSkip, built in ready()).
+    uint32_t m_chunkBoundsPoints;
+    std::vector<BOX3D> m_chunkBoundsTable;
+    std::vector<char> m_chunkSkip;
+
+    // A field copied verbatim from a LAS point record into point memory.
+    struct CopyField
+    {
+        size_t m_srcOffset;
+        size_t m_dstOffset;
+        size_t m_size;
+    };
+
+    // Precomputed field mapping for the bulk record loader.  Valid (m_ok)
+    // only when every standard field is registered with its native LAS
+    // storage type.  Fields pruned by dimension pushdown carry the None
+    // offset and are skipped.
+    struct BulkPlan
+    {
+        static constexpr size_t None = (size_t)-1;
+
+        bool m_ok = false;
+        std::vector<CopyField> m_copy;
+        size_t m_x = 0;
+        size_t m_y = 0;
+        size_t m_z = 0;
+        size_t m_returnNum = 0;
+        size_t m_numReturns = 0;
+        size_t m_scanDir = 0;
+        size_t m_eofl = 0;
+        size_t m_scanAngle = 0;
+        size_t m_classFlags = 0;
+        size_t m_scanChannel = 0;
+    };
+    BulkPlan m_bulk;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void initialize(PointTableRef table)
@@ -141,10 +192,12 @@ private:
     virtual void done(PointTableRef table);
     virtual bool eof()
         { return m_index >= getNumPoints(); }
+    virtual bool resumable() const;
 
     void handleCompressionOption();
     void setSrs(MetadataNode& m);
     void readExtraBytesVlr();
+    void readChunkBoundsVlr();
     void extractHeaderMetadata(MetadataNode& forward, MetadataNode& m);
     void extractVlrMetadata(MetadataNode& forward, MetadataNode& m);
     void loadPoint(PointRef& point, laszip_point& p);
@@ -154,8 +207,14 @@ private:
     void loadPointV10(PointRef& point, char *buf, size_t bufsize);
     void loadPointV14(PointRef& point, char *buf, size_t bufsize);
     void loadExtraDims(LeExtractor& istream, PointRef& data);
+    void buildBulkPlan(const PointLayout *layout);
+    bool bulkLoadable(const PointView& view) const;
+    void loadPoints(PointView& view, const char *buf, point_count_t numPts);
     point_count_t readFileBlock(std::vector<char>& buf,
         point_count_t maxPoints);
+#ifdef PDAL_HAVE_LAZPERF
+    point_count_t readChunksParallel(PointViewPtr view, point_count_t count);
+#endif
     void handleLaszip(int result);
 
     LasReader& operator=(const LasReader&); // not implemented
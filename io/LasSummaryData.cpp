@@ -67,6 +67,20 @@ void LasSummaryData::addPoint(double x, double y, double z, int returnNumber)
 }
 
 
+void LasSummaryData::merge(const LasSummaryData& other)
+{
+    m_totalNumPoints += other.m_totalNumPoints;
+    m_minX = (std::min)(m_minX, other.m_minX);
+    m_minY = (std::min)(m_minY, other.m_minY);
+    m_minZ = (std::min)(m_minZ, other.m_minZ);
+    m_maxX = (std::max)(m_maxX, other.m_maxX);
+    m_maxY = (std::max)(m_maxY, other.m_maxY);
+    m_maxZ = (std::max)(m_maxZ, other.m_maxZ);
+    for (size_t i = 0; i < m_returnCounts.size(); ++i)
+        m_returnCounts[i] += other.m_returnCounts[i];
+}
+
+
 BOX3D LasSummaryData::getBounds() const
 {
     BOX3D output(m_minX, m_minY, m_minZ, m_maxX, m_maxY, m_maxZ);
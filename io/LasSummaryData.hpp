@@ -56,6 +56,10 @@ public:
     LasSummaryData();
 
     void addPoint(double x, double y, double z, int returnNumber);
+    /// Fold another summary into this one.  Partial summaries can be
+    /// accumulated per block of points and merged, so accumulation can
+    /// ride along with block-parallel processing.
+    void merge(const LasSummaryData& other);
     point_count_t getTotalNumPoints() const
         { return m_totalNumPoints; }
     BOX3D getBounds() const;
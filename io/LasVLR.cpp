@@ -43,6 +43,9 @@ namespace pdal
 {
 
 const uint16_t LasVLR::MAX_DATA_SIZE = 65535;
+// Matches the limit above which extractVlrMetadata() won't copy a body
+// into metadata.
+const uint64_t LasVLR::DEFER_DATA_SIZE = 1000000;
 
 ILeStream& operator>>(ILeStream& in, LasVLR& v)
 {
@@ -53,15 +56,46 @@ ILeStream& operator>>(ILeStream& in, LasVLR& v)
     in.get(v.m_userId, 16);
     in >> v.m_recordId >> dataLen;
     in.get(v.m_description, 32);
-    v.m_data.resize(dataLen);
-    if (v.m_data.size() > 0) {
-        in.get(v.m_data);
+    // Skip large bodies - they're loaded on first access.  Small ones
+    // aren't worth a second seek.
+    if (dataLen > LasVLR::DEFER_DATA_SIZE)
+    {
+        v.m_dataOffset = in.position();
+        v.m_deferredLen = dataLen;
+        v.m_data.clear();
+        in.skip(dataLen);
+    }
+    else
+    {
+        v.m_dataOffset = -1;
+        v.m_data.resize(dataLen);
+        if (v.m_data.size() > 0) {
+            in.get(v.m_data);
+        }
     }
 
     return in;
 }
 
 
+void LasVLR::load(std::istream& in) const
+{
+    if (!deferred())
+        return;
+
+    std::streampos restore = in.tellg();
+    in.clear();
+    in.seekg(m_dataOffset);
+    m_data.resize((size_t)m_deferredLen);
+    in.read((char *)m_data.data(), m_data.size());
+    if (!in.good())
+        throw pdal_error("Couldn't load deferred VLR data.");
+    in.clear();
+    in.seekg(restore);
+    m_dataOffset = -1;
+}
+
+
 std::istream& operator>>(std::istream& in, LasVLR& v)
 {
     NL::json j;
@@ -191,9 +225,20 @@ ILeStream& operator>>(ILeStream& in, ExtLasVLR& v)
     in.get(v.m_userId, 16);
     in >> v.m_recordId >> dataLen;
     in.get(v.m_description, 32);
-    v.m_data.resize(dataLen);
-    if (v.m_data.size() > 0) {
-        in.get(v.m_data);
+    if (dataLen > LasVLR::DEFER_DATA_SIZE)
+    {
+        v.m_dataOffset = in.position();
+        v.m_deferredLen = dataLen;
+        v.m_data.clear();
+        in.skip(dataLen);
+    }
+    else
+    {
+        v.m_dataOffset = -1;
+        v.m_data.resize(dataLen);
+        if (v.m_data.size() > 0) {
+            in.get(v.m_data);
+        }
     }
 
     return in;
@@ -53,6 +53,7 @@ static const uint16_t LASZIP_RECORD_ID = 22204;
 static const uint16_t EXTRA_BYTES_RECORD_ID = 4;
 static const uint16_t PDAL_METADATA_RECORD_ID = 12;
 static const uint16_t PDAL_PIPELINE_RECORD_ID = 13;
+static const uint16_t PDAL_CHUNK_BOUNDS_RECORD_ID = 14;
 
 static const char TRANSFORM_USER_ID[] = "LASF_Projection";
 static const char SPEC_USER_ID[] = "LASF_Spec";
@@ -67,13 +68,19 @@ class PDAL_DLL LasVLR
 {
 public:
     static const uint16_t MAX_DATA_SIZE;
+    // Bodies larger than this aren't read when the VLR is extracted from a
+    // stream - only the record header is.  LasHeader::findVlr() loads a
+    // deferred body on first access.
+    static const uint64_t DEFER_DATA_SIZE;
 
     LasVLR(const std::string& userId, uint16_t recordId,
             const std::string& description, std::vector<uint8_t>& data) :
         m_userId(userId), m_recordId(recordId), m_description(description),
-        m_data(std::move(data)), m_recordSig(0)
+        m_data(std::move(data)), m_recordSig(0), m_dataOffset(-1),
+        m_deferredLen(0)
     {}
-    LasVLR() : m_recordId(0), m_recordSig(0)
+    LasVLR() : m_recordId(0), m_recordSig(0), m_dataOffset(-1),
+        m_deferredLen(0)
     {}
 
     std::string userId() const
@@ -93,11 +100,19 @@ public:
     char* data()
         { return (char *)m_data.data(); }
     bool isEmpty() const
-        { return m_data.size() == 0; }
+        { return dataLen() == 0; }
     uint64_t dataLen() const
-        { return m_data.size(); }
+        { return deferred() ? m_deferredLen : m_data.size(); }
     void setDataLen(uint64_t size)
-        { m_data.resize((size_t)size); }
+    {
+        m_dataOffset = -1;
+        m_data.resize((size_t)size);
+    }
+    /// Whether the body hasn't been read from the source stream yet.
+    bool deferred() const
+        { return m_dataOffset != -1; }
+    /// Read a deferred body from \c in, preserving the stream position.
+    void load(std::istream& in) const;
     void write(OLeStream& out, uint16_t recordSig);
 
     friend ILeStream& operator>>(ILeStream& in, LasVLR& v);
@@ -109,8 +124,12 @@ protected:
     std::string m_userId;
     uint16_t m_recordId;
     std::string m_description;
-    std::vector<uint8_t> m_data;
+    // Mutable so that a deferred body can be filled in on first access
+    // through a const header.
+    mutable std::vector<uint8_t> m_data;
     uint16_t m_recordSig;
+    mutable std::streamoff m_dataOffset;
+    uint64_t m_deferredLen;
 };
 
 class ExtLasVLR : public LasVLR
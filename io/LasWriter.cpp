@@ -54,6 +54,8 @@
 
 #include <climits>
 #include <iostream>
+#include <limits>
+#include <thread>
 #include <vector>
 
 #include <pdal/pdal_features.hpp>
@@ -63,7 +65,9 @@
 #include <pdal/util/Algorithm.hpp>
 #include <pdal/util/FileUtils.hpp>
 #include <pdal/util/Inserter.hpp>
+#include <pdal/util/IStream.hpp>
 #include <pdal/util/OStream.hpp>
+#include <pdal/util/SpaceFillingCurve.hpp>
 #include <pdal/util/Utils.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
@@ -84,10 +88,20 @@ static StaticPluginInfo const s_info
 
 CREATE_STATIC_STAGE(LasWriter, s_info)
 
+namespace
+{
+
+// Points per spatially ordered chunk.  Matches the default LAZ chunk size
+// so that a chunk's extent lines up with a compressor chunk.
+const point_count_t SpatialChunkPoints = 50000;
+
+} // unnamed namespace
+
 std::string LasWriter::getName() const { return s_info.name; }
 
 LasWriter::LasWriter() : m_compressor(nullptr), m_ostream(NULL),
-    m_compression(LasCompression::None), m_srsCnt(0)
+    m_compression(LasCompression::None), m_srsCnt(0), m_chunkFill(0),
+    m_appending(false)
 {}
 
 
@@ -113,6 +127,8 @@ void LasWriter::addArgs(ProgramArgs& args)
         "'LAZPERF')", m_compression, LasCompression::None);
     args.add("discard_high_return_numbers", "Discard points with out-of-spec "
         "return numbers.", m_discardHighReturnNumbers);
+    args.add("write_behind", "Buffer output and write it to the file from "
+        "a background thread", m_writeBehind);
     args.add("extra_dims", "Dimensions to write above those in point format",
         m_extraDimSpec);
     args.add("forward", "Dimensions to forward from LAS reader", m_forwardSpec);
@@ -146,8 +162,39 @@ void LasWriter::addArgs(ProgramArgs& args)
     args.add("offset_y", "Y offset", m_offsetY);
     args.add("offset_z", "Z offset", m_offsetZ);
     args.add("vlrs", "List of VLRs to set", m_userVLRs);
+    args.add("spatial_order", "Buffer points, sort them along a Hilbert "
+        "curve and write spatially coherent chunks, recording chunk "
+        "extents in an EVLR (standard mode only)", m_spatialOrder);
+    args.add("append", "Add points to an existing file instead of "
+        "overwriting it.  The file's point format, scale and offset are "
+        "adopted and its VLRs/EVLRs are kept.  Not supported with LASzip "
+        "compression, 'write_behind', 'spatial_order' or remote output",
+        m_append);
+}
+
+bool LasWriter::usedDims(StringList& used) const
+{
+    // LAS output is fixed-format: only the standard fields and any named
+    // extra dimensions end up in the file.  Called before options are
+    // parsed, so read the raw extra_dims option.
+    for (const std::string& e : m_options.getValues("extra_dims"))
+        for (std::string spec : Utils::split2(e, ','))
+        {
+            std::string name = spec.substr(0, spec.find('='));
+            Utils::trim(name);
+            if (Utils::iequals(name, "all"))
+                return false;
+            used.push_back(name);
+        }
+    used.insert(used.end(), { "X", "Y", "Z", "Intensity", "ReturnNumber",
+        "NumberOfReturns", "ScanDirectionFlag", "EdgeOfFlightLine",
+        "Classification", "ScanAngleRank", "UserData", "PointSourceId",
+        "GpsTime", "Red", "Green", "Blue", "Infrared", "ScanChannel",
+        "ClassFlags" });
+    return true;
 }
 
+
 void LasWriter::initialize()
 {
     std::string ext = FileUtils::extension(m_filename);
@@ -158,9 +205,28 @@ void LasWriter::initialize()
         m_compression = LasCompression::LasZip;
 #elif defined(PDAL_HAVE_LAZPERF)
         m_compression = LasCompression::LazPerf;
+#endif
+        // Appending works on the chunk table, which the LASzip API
+        // doesn't expose, so prefer LAZperf when it's available.
+#if defined(PDAL_HAVE_LAZPERF)
+        if (m_append)
+            m_compression = LasCompression::LazPerf;
 #endif
     }
 
+    if (m_append)
+    {
+        if (m_compression == LasCompression::LasZip)
+            throwError("Can't use 'append' with LASZIP compression.  "
+                "Use LAZPERF.");
+        if (m_writeBehind)
+            throwError("Can't use 'append' with 'write_behind'.");
+        if (m_spatialOrder)
+            throwError("Can't use 'append' with 'spatial_order'.");
+        if (Utils::isRemote(m_filename))
+            throwError("Can't use 'append' with remote output.");
+    }
+
     if (!m_aSrs.empty())
         setSpatialReference(m_aSrs);
     if (m_compression != LasCompression::None)
@@ -307,7 +373,38 @@ void LasWriter::readyTable(PointTableRef table)
 void LasWriter::readyFile(const std::string& filename,
     const SpatialReference& srs)
 {
-    std::ostream *out = Utils::createFile(filename, true);
+    // Appending only applies when there's a file to append to - a
+    // missing target (say, the first increment of a rolling tile) is
+    // written out normally.
+    m_appending = m_append && FileUtils::fileExists(filename);
+    if (m_appending)
+    {
+        std::fstream *io = new std::fstream(filename,
+            std::ios::in | std::ios::out | std::ios::binary);
+        if (!*io)
+        {
+            delete io;
+            throwError("Couldn't open file '" + filename + "' for append.");
+        }
+        m_curFilename = filename;
+        Utils::writeProgress(m_progressFd, "READYFILE", filename);
+        prepAppend(io, srs);
+        return;
+    }
+
+    std::ostream *out;
+    if (m_writeBehind && !Utils::isRemote(filename))
+    {
+        m_wbBuf.reset(new WriteBehindBuf());
+        if (!m_wbBuf->open(filename))
+        {
+            m_wbBuf.reset();
+            throwError("Couldn't open file '" + filename + "' for output.");
+        }
+        out = new std::ostream(m_wbBuf.get());
+    }
+    else
+        out = Utils::createFile(filename, true);
     if (!out)
         throwError("Couldn't open file '" + filename + "' for output.");
     m_curFilename = filename;
@@ -331,6 +428,9 @@ void LasWriter::prepOutput(std::ostream *outStream, const SpatialReference& srs)
     addSpatialRefVlrs();
 
     m_summaryData.reset(new LasSummaryData());
+    m_chunkBounds.clear();
+    m_curChunkBounds.clear();
+    m_chunkFill = 0;
     m_ostream = outStream;
     if (m_lasHeader.compressed())
         readyCompression();
@@ -364,6 +464,163 @@ void LasWriter::prepOutput(std::ostream *outStream, const SpatialReference& srs)
 }
 
 
+// Open an existing file for appending: adopt its header, scale/offset and
+// EVLRs and position output at the end of the point data.  The header/VLR
+// region and the existing points are left untouched - counts, bounds and
+// the EVLRs are patched in finishOutput().
+void LasWriter::prepAppend(std::fstream *io, const SpatialReference& srs)
+{
+    // The file's spatial reference VLRs are kept as they are.
+    (void)srs;
+
+    m_ostream = io;
+
+    m_lasHeader = LasHeader();
+    ILeStream in(io);
+    try
+    {
+        in >> m_lasHeader;
+    }
+    catch (const LasHeader::error& err)
+    {
+        throwError("Can't append to '" + m_curFilename + "': " +
+            err.what());
+    }
+
+    if (m_lasHeader.compressed() != (m_compression == LasCompression::LazPerf))
+        throwError("Can't append to '" + m_curFilename + "': compression "
+            "state of the file doesn't match the requested output.");
+
+    // The point record layout is fixed by the file.  A length mismatch
+    // means the extra dimensions being written don't line up with the
+    // file's extra bytes.
+    if (m_lasHeader.basePointLen() + m_extraByteLen != m_lasHeader.pointLen())
+        throwError("Can't append to '" + m_curFilename + "': point length "
+            "doesn't match the dimensions being written.  Check the "
+            "'extra_dims' option against the file's extra bytes.");
+
+    // Appended points must land on the file's grid.
+    m_scaling.m_xXform = XForm(m_lasHeader.scaleX(), m_lasHeader.offsetX());
+    m_scaling.m_yXform = XForm(m_lasHeader.scaleY(), m_lasHeader.offsetY());
+    m_scaling.m_zXform = XForm(m_lasHeader.scaleZ(), m_lasHeader.offsetZ());
+
+    readAppendEVlrs(io);
+
+    m_summaryData.reset(new LasSummaryData());
+    m_chunkBounds.clear();
+    m_curChunkBounds.clear();
+    m_chunkFill = 0;
+
+    if (m_lasHeader.compressed())
+        resumeLazPerfCompression(io);
+    else
+        io->seekp((std::streamoff)m_lasHeader.pointOffset() +
+            (std::streamoff)(m_lasHeader.pointCount() *
+                m_lasHeader.pointLen()));
+
+    m_pointBuf.resize(m_lasHeader.pointLen());
+}
+
+
+// Pull the file's EVLRs into the writer's list so they can be rewritten
+// behind the appended points.  Deferred bodies are loaded now - the
+// region they sit in is about to be overwritten.  A chunk bounds table
+// describes the old point order, so it's dropped.
+void LasWriter::readAppendEVlrs(std::fstream *io)
+{
+    m_eVlrs.clear();
+    if (!m_lasHeader.versionAtLeast(1, 4) || !m_lasHeader.eVlrCount())
+        return;
+
+    ILeStream in(io);
+    in.seek((std::streamoff)m_lasHeader.eVlrOffset());
+    for (uint32_t i = 0; i < m_lasHeader.eVlrCount(); ++i)
+    {
+        ExtLasVLR v;
+        in >> v;
+        v.load(*io);
+        if (v.matches(PDAL_USER_ID, PDAL_CHUNK_BOUNDS_RECORD_ID))
+        {
+            log()->get(LogLevel::Warning) << getName() << ": Discarding "
+                "the chunk bounds table of '" << m_curFilename << "' - "
+                "it doesn't describe the appended points." << std::endl;
+            continue;
+        }
+        m_eVlrs.push_back(std::move(v));
+    }
+}
+
+
+// Continue LAZperf compression where the file left off.  Full chunks
+// already in the file are kept as-is and never decoded - only a trailing
+// partial chunk is re-encoded so new points can extend it.
+void LasWriter::resumeLazPerfCompression(std::fstream *io)
+{
+#ifdef PDAL_HAVE_LAZPERF
+    const LasVLR *vlr = m_lasHeader.findVlr(LASZIP_USER_ID, LASZIP_RECORD_ID);
+    if (!vlr)
+        throwError("Can't append to '" + m_curFilename + "': compressed "
+            "file has no laszip VLR.");
+
+    laszip::io::laz_vlr zipvlr(vlr->data());
+    if (zipvlr.chunk_size == 0 ||
+        zipvlr.chunk_size == (std::numeric_limits<uint32_t>::max)())
+        throwError("Can't append to '" + m_curFilename + "': point data "
+            "isn't chunked.");
+    laszip::factory::record_schema schema =
+        laszip::io::laz_vlr::to_schema(zipvlr);
+
+    delete m_compressor;
+    m_compressor = nullptr;
+
+    // An empty file has no chunk table to extend - compress from the
+    // start of the point data.
+    if (m_lasHeader.pointCount() == 0)
+    {
+        io->seekp(m_lasHeader.pointOffset());
+        m_compressor = new LazPerfVlrCompressor(*io, schema,
+            zipvlr.chunk_size);
+        return;
+    }
+
+    std::vector<uint32_t> chunkTable;
+    std::vector<char> partialBuf;
+    point_count_t partial = 0;
+    std::streamoff resumePos = 0;
+    {
+        LazPerfVlrDecompressor d(*io, vlr->data(),
+            (std::streamoff)m_lasHeader.pointOffset());
+        if (!d.chunked())
+            throwError("Can't append to '" + m_curFilename + "': couldn't "
+                "read the chunk table.");
+
+        // All chunks but possibly the last are full and keep their chunk
+        // table entries; a partial last chunk is decoded so it can be
+        // re-encoded along with the new points.
+        partial = (point_count_t)(m_lasHeader.pointCount() % d.chunkSize());
+        size_t keep = d.chunkCount() - (partial ? 1 : 0);
+        for (size_t i = 0; i < keep; ++i)
+            chunkTable.push_back(
+                (uint32_t)(d.chunkOffset(i + 1) - d.chunkOffset(i)));
+        if (partial)
+        {
+            partialBuf.resize(partial * d.pointSize());
+            d.decompressChunk(keep, partial, partialBuf.data());
+        }
+        resumePos = d.chunkOffset(keep);
+    }
+
+    io->clear();
+    io->seekp(resumePos);
+    m_compressor = new LazPerfVlrCompressor(*io, schema, zipvlr.chunk_size);
+    m_compressor->resume((std::streampos)(std::streamoff)
+        m_lasHeader.pointOffset(), std::move(chunkTable));
+    if (partial)
+        m_compressor->compress(partialBuf.data(), partial);
+#endif
+}
+
+
 /// Search for metadata associated with the provided recordId and userId.
 /// \param  node - Top-level node to use for metadata search.
 /// \param  recordId - Record ID to match.
@@ -744,6 +1001,10 @@ void LasWriter::openCompression()
 // This is only called in stream mode.
 bool LasWriter::processOne(PointRef& point)
 {
+    // With a template-based filename, close the current file and open the
+    // next at group breaks marked by an upstream splitting filter.
+    rotateStream(point);
+
     if (m_firstPoint)
     {
         auto doScale = [this](const XForm::XFormComponent& scale,
@@ -795,14 +1056,14 @@ bool LasWriter::processPoint(PointRef& point)
     else if (m_compression == LasCompression::LazPerf)
     {
         LeInserter ostream(m_pointBuf.data(), m_pointBuf.size());
-        if (!fillPointBuf(point, ostream))
+        if (!fillPointBuf(point, ostream, *m_summaryData))
             return false;
         writeLazPerfBuf(m_pointBuf.data(), m_lasHeader.pointLen(), 1);
     }
     else
     {
         LeInserter ostream(m_pointBuf.data(), m_pointBuf.size());
-        if (!fillPointBuf(point, ostream))
+        if (!fillPointBuf(point, ostream, *m_summaryData))
             return false;
         m_ostream->write(m_pointBuf.data(), m_lasHeader.pointLen());
     }
@@ -821,6 +1082,14 @@ void LasWriter::writeView(const PointViewPtr view)
     Utils::writeProgress(m_progressFd, "READYVIEW",
         std::to_string(view->size()));
 
+    if (m_spatialOrder)
+    {
+        writeSpatialView(view);
+        Utils::writeProgress(m_progressFd, "DONEVIEW",
+            std::to_string(view->size()));
+        return;
+    }
+
     point_count_t pointLen = m_lasHeader.pointLen();
 
     // Since we use the LASzip API, we can't benefit from building
@@ -837,8 +1106,17 @@ void LasWriter::writeView(const PointViewPtr view)
     else
     {
         // Make a buffer of at most a meg.
-        m_pointBuf.resize((std::min)((point_count_t)1000000,
-                    pointLen * view->size()));
+        point_count_t bufsize = (std::min)((point_count_t)1000000,
+            pointLen * view->size());
+#ifdef PDAL_HAVE_LAZPERF
+        // For LAZperf, buffer whole chunks so that the compressor can
+        // encode several of them in parallel.
+        if (m_compression == LasCompression::LazPerf)
+            bufsize = (std::min)(pointLen * view->size(),
+                pointLen * m_compressor->chunkSize() *
+                    (std::max)(std::thread::hardware_concurrency(), 1u));
+#endif
+        m_pointBuf.resize(bufsize);
 
         const PointView& viewRef(*view.get());
 
@@ -861,6 +1139,60 @@ void LasWriter::writeView(const PointViewPtr view)
 }
 
 
+// Write a view's points ordered along a Hilbert curve, tracking the
+// extent of each run of SpatialChunkPoints points.  Nearby points land
+// in the same chunk, so a reader armed with the chunk bounds table can
+// skip chunks that don't intersect a query window.
+void LasWriter::writeSpatialView(const PointViewPtr view)
+{
+    using namespace Dimension;
+
+    // Find the view's X/Y extent so cell coordinates can be normalized.
+    BOX2D bounds;
+    for (PointId idx = 0; idx < view->size(); ++idx)
+        bounds.grow(view->getFieldAs<double>(Id::X, idx),
+            view->getFieldAs<double>(Id::Y, idx));
+
+    double xrange = bounds.maxx - bounds.minx;
+    double yrange = bounds.maxy - bounds.miny;
+    double xscale = xrange > 0 ? 65535 / xrange : 0;
+    double yscale = yrange > 0 ? 65535 / yrange : 0;
+
+    std::vector<std::pair<uint64_t, PointId>> codes(view->size());
+    for (PointId idx = 0; idx < view->size(); ++idx)
+    {
+        uint32_t cellx = (uint32_t)
+            ((view->getFieldAs<double>(Id::X, idx) - bounds.minx) * xscale);
+        uint32_t celly = (uint32_t)
+            ((view->getFieldAs<double>(Id::Y, idx) - bounds.miny) * yscale);
+        codes[idx] = { curve::hilbertEncode(cellx, celly), idx };
+    }
+    std::sort(codes.begin(), codes.end());
+
+    // The chunk fill carries over from any previous view - the
+    // compressor's chunks don't restart at view boundaries, so the
+    // recorded extents can't either.  The final partial chunk is
+    // flushed when the table is written.
+    PointRef point(*view, 0);
+    for (const auto& c : codes)
+    {
+        point.setPointId(c.second);
+        double x = point.getFieldAs<double>(Id::X);
+        double y = point.getFieldAs<double>(Id::Y);
+        double z = point.getFieldAs<double>(Id::Z);
+        if (!processPoint(point))
+            continue;
+        m_curChunkBounds.grow(x, y, z);
+        if (++m_chunkFill == SpatialChunkPoints)
+        {
+            m_chunkBounds.push_back(m_curChunkBounds);
+            m_curChunkBounds.clear();
+            m_chunkFill = 0;
+        }
+    }
+}
+
+
 bool LasWriter::writeLasZipBuf(PointRef& point)
 {
 #ifdef PDAL_HAVE_LASZIP
@@ -999,16 +1331,14 @@ void LasWriter::writeLazPerfBuf(char *pos, size_t pointLen,
     point_count_t numPts)
 {
 #ifdef PDAL_HAVE_LAZPERF
-    for (point_count_t i = 0; i < numPts; i++)
-    {
-        m_compressor->compress(pos);
-        pos += pointLen;
-    }
+    (void)pointLen;
+    m_compressor->compress(pos, numPts);
 #endif
 }
 
 
-bool LasWriter::fillPointBuf(PointRef& point, LeInserter& ostream)
+bool LasWriter::fillPointBuf(PointRef& point, LeInserter& ostream,
+    LasSummaryData& summary)
 {
     bool has14Format = m_lasHeader.has14Format();
     static const size_t maxReturnCount = m_lasHeader.maxReturnCount();
@@ -1122,7 +1452,7 @@ bool LasWriter::fillPointBuf(PointRef& point, LeInserter& ostream)
         Utils::insertDim(ostream, dim.m_dimType.m_type, e);
     }
 
-    m_summaryData->addPoint(xOrig, yOrig, zOrig, returnNumber);
+    summary.addPoint(xOrig, yOrig, zOrig, returnNumber);
     return true;
 }
 
@@ -1134,13 +1464,18 @@ point_count_t LasWriter::fillWriteBuf(const PointView& view,
     blocksize = (std::min)(blocksize, view.size() - startId);
     PointId lastId = startId + blocksize;
 
+    // Accumulate a partial summary for the block and fold it in once -
+    // the hot loop then touches only locals, and block fills can run
+    // independently of each other.
+    LasSummaryData summary;
     LeInserter ostream(buf.data(), buf.size());
     PointRef point = (const_cast<PointView&>(view)).point(0);
     for (PointId idx = startId; idx < lastId; idx++)
     {
         point.setPointId(idx);
-        fillPointBuf(point, ostream);
+        fillPointBuf(point, ostream, summary);
     }
+    m_summaryData->merge(summary);
     return blocksize;
 }
 
@@ -1152,6 +1487,43 @@ void LasWriter::doneFile()
     getMetadata().addList("filename", m_curFilename);
     delete m_ostream;
     m_ostream = NULL;
+    m_wbBuf.reset();
+}
+
+
+// Record the extents of spatially ordered chunks so readers can skip
+// chunks by bounds.  Layout (little-endian): points per chunk (uint32),
+// chunk count (uint32), then minx/miny/minz/maxx/maxy/maxz (doubles)
+// for each chunk in file order.
+void LasWriter::addChunkBoundsEVlr()
+{
+    // Flush the trailing partial chunk.
+    if (m_chunkFill)
+    {
+        m_chunkBounds.push_back(m_curChunkBounds);
+        m_curChunkBounds.clear();
+        m_chunkFill = 0;
+    }
+    if (m_chunkBounds.empty())
+        return;
+    if (!m_lasHeader.versionAtLeast(1, 4))
+    {
+        log()->get(LogLevel::Warning) << getName() << ": The chunk bounds "
+            "table requires a LAS 1.4 EVLR.  Points are spatially ordered "
+            "but no table was written." << std::endl;
+        return;
+    }
+
+    std::vector<uint8_t> data(2 * sizeof(uint32_t) +
+        m_chunkBounds.size() * 6 * sizeof(double));
+    LeInserter inserter((char *)data.data(), data.size());
+    inserter << (uint32_t)SpatialChunkPoints << (uint32_t)m_chunkBounds.size();
+    for (const BOX3D& b : m_chunkBounds)
+        inserter << b.minx << b.miny << b.minz << b.maxx << b.maxy << b.maxz;
+
+    m_eVlrs.push_back(ExtLasVLR(PDAL_USER_ID, PDAL_CHUNK_BOUNDS_RECORD_ID,
+        "PDAL chunk bounds", data));
+    m_lasHeader.setEVlrCount((uint32_t)m_eVlrs.size());
 }
 
 
@@ -1162,6 +1534,8 @@ void LasWriter::finishOutput()
     else if (m_compression == LasCompression::LazPerf)
         finishLazPerfOutput();
 
+    addChunkBoundsEVlr();
+
     log()->get(LogLevel::Debug) << "Wrote " <<
         m_summaryData->getTotalNumPoints() <<
         " points to the LAS file" << std::endl;
@@ -1176,24 +1550,50 @@ void LasWriter::finishOutput()
         out << evlr;
     }
 
-    // Reset the offset/scale since it may have been auto-computed
-    try
+    if (m_appending)
     {
-        m_lasHeader.setScaling(m_scaling);
+        // A chunk bounds table may have been dropped; only 1.4 carries
+        // the count.
+        m_lasHeader.setEVlrCount((uint32_t)m_eVlrs.size());
+
+        // Fold the appended points into the existing header stats.  The
+        // summary only saw the new points; the old ones are already
+        // accounted for in the adopted header.
+        if (m_summaryData->getTotalNumPoints())
+        {
+            BOX3D b = m_lasHeader.pointCount() ?
+                m_lasHeader.getBounds() : BOX3D();
+            b.grow(m_summaryData->getBounds());
+            m_lasHeader.setBounds(b);
+        }
+        for (size_t i = 0; i < LasHeader::RETURN_COUNT; ++i)
+            m_lasHeader.setPointCountByReturn(i,
+                m_lasHeader.pointCountByReturn(i) +
+                m_summaryData->getReturnCount((int)i));
+        m_lasHeader.setPointCount(m_lasHeader.pointCount() +
+            m_summaryData->getTotalNumPoints());
     }
-    catch (const LasHeader::error& err)
+    else
     {
-        throwError(err.what());
-    }
+        // Reset the offset/scale since it may have been auto-computed
+        try
+        {
+            m_lasHeader.setScaling(m_scaling);
+        }
+        catch (const LasHeader::error& err)
+        {
+            throwError(err.what());
+        }
 
-    // The summary is calculated as points are written.
-    try
-    {
-        m_lasHeader.setSummary(*m_summaryData);
-    }
-    catch (const LasHeader::error& err)
-    {
-        throwError(err.what());
+        // The summary is calculated as points are written.
+        try
+        {
+            m_lasHeader.setSummary(*m_summaryData);
+        }
+        catch (const LasHeader::error& err)
+        {
+            throwError(err.what());
+        }
     }
 
     out.seek(0);
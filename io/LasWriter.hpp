@@ -34,9 +34,13 @@
 
 #pragma once
 
+#include <fstream>
+
 #include <pdal/pdal_features.hpp>
 #include <pdal/FlexWriter.hpp>
 #include <pdal/Streamable.hpp>
+#include <pdal/util/Bounds.hpp>
+#include <pdal/util/WriteBehind.hpp>
 
 #include "HeaderVal.hpp"
 #include "LasError.hpp"
@@ -90,6 +94,9 @@ private:
     std::map<std::string, std::string> m_headerVals;
     std::vector<VlrOptionInfo> m_optionInfos;
     std::ostream *m_ostream;
+    /// Backing buffer when write-behind output was requested.
+    std::unique_ptr<WriteBehindBuf> m_wbBuf;
+    bool m_writeBehind;
     std::vector<LasVLR> m_vlrs;
     std::vector<ExtLasVLR> m_eVlrs;
     StringList m_extraDimSpec;
@@ -129,8 +136,22 @@ private:
     bool m_writePDALMetadata;
     std::vector<ExtLasVLR> m_userVLRs;
     bool m_firstPoint;
+    // Spatially ordered output: points are Hilbert-sorted and written in
+    // fixed-size chunks whose extents are recorded in an EVLR.
+    bool m_spatialOrder;
+    std::vector<BOX3D> m_chunkBounds;
+    // Extent and fill of the chunk currently being accumulated.  Lives
+    // across views because compressor chunks don't restart at view
+    // boundaries.
+    BOX3D m_curChunkBounds;
+    point_count_t m_chunkFill;
+    // Append mode: add points to an existing file, patching the header,
+    // EVLRs and (for LAZ) the chunk table in place.
+    bool m_append;
+    bool m_appending;
 
     virtual void addArgs(ProgramArgs& args);
+    virtual bool usedDims(StringList& used) const;
     virtual void initialize();
     virtual void prepared(PointTableRef table);
     virtual void readyTable(PointTableRef table);
@@ -138,8 +159,12 @@ private:
         const SpatialReference& srs);
     virtual bool srsOverridden() const
         { return m_aSrs.valid(); }
+    virtual bool supportsStreamRotation() const
+        { return true; }
     void prerunFile(const PointViewSet& pvSet);
     virtual void writeView(const PointViewPtr view);
+    void writeSpatialView(const PointViewPtr view);
+    void addChunkBoundsEVlr();
     virtual bool processOne(PointRef& point);
     void spatialReferenceChanged(const SpatialReference& srs);
     virtual void doneFile();
@@ -152,7 +177,8 @@ private:
         const MetadataNode& base);
     void handleHeaderForwards(MetadataNode& forward);
     void fillHeader();
-    bool fillPointBuf(PointRef& point, LeInserter& ostream);
+    bool fillPointBuf(PointRef& point, LeInserter& ostream,
+        LasSummaryData& summary);
     point_count_t fillWriteBuf(const PointView& view, PointId startId,
         std::vector<char>& buf);
     bool writeLasZipBuf(PointRef& point);
@@ -167,6 +193,9 @@ private:
     void readyCompression();
     void readyLasZipCompression();
     void readyLazPerfCompression();
+    void prepAppend(std::fstream *io, const SpatialReference& srs);
+    void readAppendEVlrs(std::fstream *io);
+    void resumeLazPerfCompression(std::fstream *io);
     void openCompression();
     void addVlr(const std::string& userId, uint16_t recordId,
         const std::string& description, std::vector<uint8_t>& data);
@@ -48,6 +48,13 @@
 namespace pdal
 {
 
+namespace
+{
+    // Features created per driver transaction.  Transactional drivers
+    // (GeoPackage, PostGIS) otherwise pay a commit round trip per feature.
+    const size_t TransactionBatchSize = 65536;
+}
+
 static StaticPluginInfo const s_info
 {
     "writers.ogr",
@@ -59,7 +66,7 @@ static StaticPluginInfo const s_info
 CREATE_STATIC_STAGE(OGRWriter, s_info)
 
 OGRWriter::OGRWriter() : m_driver(nullptr), m_ds(nullptr), m_layer(nullptr),
-    m_feature(nullptr)
+    m_feature(nullptr), m_inTransaction(false), m_batchCount(0)
 {}
 
 
@@ -134,6 +141,11 @@ void OGRWriter::readyFile(const std::string& filename,
         m_ds->SetProjection(srs.getWKT().data());
     }
     m_feature = OGRFeature::CreateFeature(m_layer->GetLayerDefn());
+
+    // Drivers without native transactions report failure here and we
+    // just create features directly.
+    m_inTransaction = (m_ds->StartTransaction() == OGRERR_NONE);
+    m_batchCount = 0;
 }
 
 void OGRWriter::writeView(const PointViewPtr view)
@@ -173,6 +185,13 @@ bool OGRWriter::processOne(PointRef& point)
             m_feature->SetGeometry(&pt);
         if (m_layer->CreateFeature(m_feature))
             throwError("Couldn't create feature.");
+        if (m_inTransaction && ++m_batchCount >= TransactionBatchSize)
+        {
+            if (m_ds->CommitTransaction() != OGRERR_NONE)
+                throwError("Couldn't commit feature batch.");
+            m_inTransaction = (m_ds->StartTransaction() == OGRERR_NONE);
+            m_batchCount = 0;
+        }
         m_curCount = 0;
     }
     return true;
@@ -184,6 +203,12 @@ void OGRWriter::doneFile()
     if (m_curCount)
         if (m_layer->CreateFeature(m_feature))
             throwError("Couldn't create feature.");
+    if (m_inTransaction)
+    {
+        if (m_ds->CommitTransaction() != OGRERR_NONE)
+            throwError("Couldn't commit feature batch.");
+        m_inTransaction = false;
+    }
     OGRFeature::DestroyFeature(m_feature);
     GDALClose(m_ds);
     m_layer = nullptr;
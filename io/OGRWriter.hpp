@@ -72,6 +72,10 @@ private:
     std::string m_driverName;
     size_t m_multiCount;
     size_t m_curCount;
+    // Features are created inside driver transactions, committed every
+    // TransactionBatchSize features.
+    bool m_inTransaction;
+    size_t m_batchCount;
     std::string m_measureDimName;
     Dimension::Id m_measureDim;
 };
@@ -83,6 +83,13 @@ OptechReader::OptechReader()
 const CsdHeader& OptechReader::getHeader() const { return m_header; }
 
 
+void OptechReader::addArgs(ProgramArgs& args)
+{
+    args.add("mmap", "Memory-map the file and serve reads directly from "
+        "the mapping", m_mmap);
+}
+
+
 void OptechReader::initialize()
 {
     std::istream* rawStream = Utils::openFile(m_filename);
@@ -130,6 +137,28 @@ void OptechReader::initialize()
 }
 
 
+QuickInfo OptechReader::inspect()
+{
+    QuickInfo qi;
+    std::unique_ptr<PointLayout> layout(new PointLayout());
+
+    initialize();
+    addDimensions(layout.get());
+
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
+    // The header counts pulses; each pulse can carry several returns,
+    // so this is a lower-bound estimate.
+    qi.m_pointCount = m_header.numRecords;
+    qi.m_srs = getSpatialReference();
+    qi.m_exact = false;
+    qi.m_valid = true;
+
+    return qi;
+}
+
+
 void OptechReader::addDimensions(PointLayoutPtr layout)
 {
     using namespace Dimension;
@@ -142,7 +171,7 @@ void OptechReader::addDimensions(PointLayoutPtr layout)
 
 void OptechReader::ready(PointTableRef)
 {
-    m_istream.reset(new IStream(m_filename));
+    m_istream.reset(new IStream(m_filename, m_mmap));
     if (!*m_istream)
         throwError("Unable to open " + m_filename + " for reading.");
 
@@ -172,13 +201,12 @@ point_count_t OptechReader::read(PointViewPtr data,
                 m_recordIndex += fillBuffer();
             }
 
-            m_extractor >> m_pulse.gpsTime >> m_pulse.returnCount >>
-                m_pulse.range[0] >> m_pulse.range[1] >> m_pulse.range[2] >>
-                m_pulse.range[3] >> m_pulse.intensity[0] >>
-                m_pulse.intensity[1] >> m_pulse.intensity[2] >>
-                m_pulse.intensity[3] >> m_pulse.scanAngle >> m_pulse.roll >>
-                m_pulse.pitch >> m_pulse.heading >> m_pulse.latitude >>
-                m_pulse.longitude >> m_pulse.elevation;
+            extractRecord(m_extractor, m_pulse.gpsTime, m_pulse.returnCount,
+                m_pulse.range[0], m_pulse.range[1], m_pulse.range[2],
+                m_pulse.range[3], m_pulse.intensity[0], m_pulse.intensity[1],
+                m_pulse.intensity[2], m_pulse.intensity[3], m_pulse.scanAngle,
+                m_pulse.roll, m_pulse.pitch, m_pulse.heading,
+                m_pulse.latitude, m_pulse.longitude, m_pulse.elevation);
 
             if (m_pulse.returnCount == 0)
             {
@@ -66,7 +66,9 @@ private:
     typedef std::vector<char> buffer_t;
     typedef buffer_t::size_type buffer_size_t;
 
+    virtual void addArgs(ProgramArgs& args);
     virtual void initialize();
+    virtual QuickInfo inspect();
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void ready(PointTableRef table);
     virtual point_count_t read(PointViewPtr view, point_count_t num);
@@ -75,6 +77,7 @@ private:
 
     CsdHeader m_header;
     georeference::RotationMatrix m_boresightMatrix;
+    bool m_mmap;
     std::unique_ptr<IStream> m_istream;
     buffer_t m_buffer;
     LeExtractor m_extractor;
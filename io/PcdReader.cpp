@@ -38,9 +38,66 @@
 #include "PcdHeader.hpp"
 #include "PcdReader.hpp"
 
+#include <algorithm>
+
 namespace pdal
 {
 
+namespace
+{
+
+// Decompress an LZF block -- the scheme PCL uses for binary_compressed
+// PCD bodies.  Returns the number of bytes written to 'out', or 0 on
+// corrupt input or if the output doesn't fit.
+size_t lzfDecompress(const char *in, size_t inLen, char *out, size_t outLen)
+{
+    const uint8_t *ip = (const uint8_t *)in;
+    const uint8_t *const iend = ip + inLen;
+    uint8_t *op = (uint8_t *)out;
+    uint8_t *const oend = op + outLen;
+
+    while (ip < iend)
+    {
+        uint32_t ctrl = *ip++;
+        if (ctrl < 32)
+        {
+            // Literal run of ctrl + 1 bytes.
+            uint32_t len = ctrl + 1;
+            if (op + len > oend || ip + len > iend)
+                return 0;
+            std::copy(ip, ip + len, op);
+            ip += len;
+            op += len;
+        }
+        else
+        {
+            // Back reference of (ctrl >> 5) + 2 bytes, with a length
+            // extension byte when the length field is saturated.
+            uint32_t len = ctrl >> 5;
+            if (ip >= iend)
+                return 0;
+            if (len == 7)
+            {
+                len += *ip++;
+                if (ip >= iend)
+                    return 0;
+            }
+            const uint8_t *ref = op - ((ctrl & 0x1f) << 8) - 1;
+            ref -= *ip++;
+            len += 2;
+            if (ref < (const uint8_t *)out || op + len > oend)
+                return 0;
+            // The reference may overlap the output cursor, so copy
+            // forward a byte at a time.
+            while (len--)
+                *op++ = *ref++;
+        }
+    }
+    return op - (uint8_t *)out;
+}
+
+} // unnamed namespace
+
 static StaticPluginInfo const s_info
 {
     "readers.pcd",
@@ -82,14 +139,30 @@ void PcdReader::ready(PointTableRef table)
         m_istreamPtr->seekg(m_header.m_dataOffset);
         break;
     case PcdDataStorage::BINARY:
+    {
         m_istreamPtr = Utils::openFile(m_filename, true);
         if (!m_istreamPtr)
             throwError("Unable to open binary PCD file '" + m_filename + "'.");
         m_stream = ILeStream(m_istreamPtr);
         m_stream.seek(m_header.m_dataOffset);
+        setupBinaryRecord();
+
+        const size_t SlabSize = 1024 * 1024;
+        m_slabCap = (std::max)((size_t)1, SlabSize / m_recordSize);
+        m_slab.resize(m_slabCap * m_recordSize);
+        m_slabRecs = 0;
+        m_slabPos = 0;
         break;
+    }
     case PcdDataStorage::COMPRESSED:
-        throwError("Binary compressed PCD is not supported at this time.");
+        m_istreamPtr = Utils::openFile(m_filename, true);
+        if (!m_istreamPtr)
+            throwError("Unable to open compressed PCD file '" + m_filename +
+                "'.");
+        m_stream = ILeStream(m_istreamPtr);
+        m_stream.seek(m_header.m_dataOffset);
+        setupBinaryRecord();
+        loadCompressed();
         break;
     case PcdDataStorage::unknown:
     default:
@@ -123,6 +196,96 @@ void PcdReader::addDimensions(PointLayoutPtr layout)
     }
 }
 
+void PcdReader::setupBinaryRecord()
+{
+    m_binFields.clear();
+    m_recordSize = 0;
+    for (size_t i = 0; i < m_header.m_fields.size(); ++i)
+    {
+        const PcdField& f = m_header.m_fields[i];
+
+        Dimension::BaseType base = Dimension::BaseType::None;
+        if (f.m_type == PcdFieldType::U)
+            base = Dimension::BaseType::Unsigned;
+        else if (f.m_type == PcdFieldType::I)
+            base = Dimension::BaseType::Signed;
+        else if (f.m_type == PcdFieldType::F)
+            base = Dimension::BaseType::Floating;
+        else
+            throwError("Unsupported type for field '" + f.m_label + "'.");
+        if (f.m_size != 1 && f.m_size != 2 && f.m_size != 4 && f.m_size != 8)
+            throwError("Unsupported size for field '" + f.m_label + "'.");
+        if (base == Dimension::BaseType::Floating &&
+            f.m_size != 4 && f.m_size != 8)
+            throwError("Unsupported size for field '" + f.m_label + "'.");
+        Dimension::Type t =
+            static_cast<Dimension::Type>(unsigned(base) | f.m_size);
+
+        // Only the first element of a multi-count field maps to a
+        // dimension, but the extra elements still occupy record space.
+        m_binFields.push_back({m_dims[i], t, m_recordSize, m_recordSize});
+        m_recordSize += (size_t)f.m_size * f.m_count;
+    }
+    if (m_recordSize == 0)
+        throwError("PCD file contains no fields.");
+}
+
+
+bool PcdReader::fillSlab()
+{
+    m_stream.get(m_slab);
+
+    // A short read is fine - emit the whole records that arrived, which
+    // matches the old behavior of reading until the stream fails.
+    size_t bytes = m_stream.good() ? m_slab.size() :
+        (size_t)m_istreamPtr->gcount();
+    m_slabRecs = bytes / m_recordSize;
+    m_slabPos = 0;
+    return m_slabRecs > 0;
+}
+
+
+void PcdReader::loadCompressed()
+{
+    uint32_t compressedSize;
+    uint32_t uncompressedSize;
+
+    m_stream >> compressedSize;
+    m_stream >> uncompressedSize;
+    if (!m_stream.good())
+        throwError("Can't read compressed data header from '" + m_filename +
+            "'.");
+
+    std::vector<char> in(compressedSize);
+    m_stream.get(in);
+    if (!m_stream.good())
+        throwError("Compressed PCD file '" + m_filename + "' is truncated.");
+
+    m_decompBuf.resize(uncompressedSize);
+    if (lzfDecompress(in.data(), in.size(), m_decompBuf.data(),
+            m_decompBuf.size()) != uncompressedSize)
+        throwError("Couldn't decompress data in '" + m_filename + "'.");
+
+    if (m_decompBuf.size() <
+        m_recordSize * (size_t)m_header.m_pointCount)
+        throwError("Compressed PCD file '" + m_filename + "' contains less "
+            "data than its declared point count.");
+
+    // Compressed bodies are column-major: all values of the first field,
+    // then all values of the second...  Point the fields at their columns.
+    size_t offset = 0;
+    for (size_t i = 0; i < m_binFields.size(); ++i)
+    {
+        const PcdField& f = m_header.m_fields[i];
+        size_t elt = (size_t)f.m_size * f.m_count;
+
+        m_binFields[i].m_offset = offset;
+        m_binFields[i].m_stride = elt;
+        offset += elt * (size_t)m_header.m_pointCount;
+    }
+}
+
+
 bool PcdReader::fillFields()
 {
     while (true)
@@ -176,42 +339,33 @@ bool PcdReader::processOne(PointRef& point)
         }
         return true;
     case PcdDataStorage::BINARY:
-        if (!m_stream.good())
+    {
+        if ((m_index >= m_count) ||
+            (m_index >= (point_count_t)m_header.m_pointCount))
+            return false;
+
+        if (m_slabPos >= m_slabRecs && !fillSlab())
             return false;
 
+        const char *rec = m_slab.data() + (m_slabPos * m_recordSize);
+        for (const BinaryField& f : m_binFields)
+            point.setField(f.m_id, f.m_type, rec + f.m_offset);
+        m_slabPos++;
+        m_index++;
+        return true;
+    }
+    case PcdDataStorage::COMPRESSED:
+    {
         if ((m_index >= m_count) ||
             (m_index >= (point_count_t)m_header.m_pointCount))
             return false;
 
-        for (auto const& i : m_header.m_fields)
-        {
-            switch (i.m_type)
-            {
-            case PcdFieldType::I:
-                int32_t ival;
-                m_stream >> ival;
-                point.setField(i.m_id, ival);
-                break;
-            case PcdFieldType::F:
-                float fval;
-                m_stream >> fval;
-                point.setField(i.m_id, fval);
-                break;
-            case PcdFieldType::U:
-                uint32_t uval;
-                m_stream >> uval;
-                point.setField(i.m_id, uval);
-                break;
-            case PcdFieldType::unknown:
-            default:
-                throwError("Unsupported field type.");
-            }
-        }
+        for (const BinaryField& f : m_binFields)
+            point.setField(f.m_id, f.m_type,
+                m_decompBuf.data() + f.m_offset + (m_index * f.m_stride));
         m_index++;
         return true;
-    case PcdDataStorage::COMPRESSED:
-        throwError("Binary compressed PCD is not supported at this time.");
-        return false;
+    }
     case PcdDataStorage::unknown:
     default:
         throwError("Unrecognized data storage.");
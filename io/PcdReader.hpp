@@ -60,6 +60,9 @@ private:
     virtual void done(PointTableRef table);
     virtual bool processOne(PointRef& point);
     bool fillFields();
+    void setupBinaryRecord();
+    bool fillSlab();
+    void loadCompressed();
 
     PcdHeader m_header;
     std::istream* m_istreamPtr;
@@ -68,6 +71,27 @@ private:
     StringList m_fields;
     point_count_t m_index;
     size_t m_line;
+
+    // Layout of a field in binary storage.  Plain binary records have a
+    // fixed stride and are read in slabs, unpacked with per-field offsets.
+    // Compressed bodies store one column per field and are inflated up
+    // front; the offset is then the column start and values are m_stride
+    // apart.
+    struct BinaryField
+    {
+        Dimension::Id m_id;
+        Dimension::Type m_type;
+        size_t m_offset;
+        size_t m_stride;
+    };
+    std::vector<BinaryField> m_binFields;
+    size_t m_recordSize;
+    std::vector<char> m_slab;
+    size_t m_slabCap;     // Capacity of the slab in records.
+    size_t m_slabRecs;    // Records in the slab.
+    size_t m_slabPos;     // Next unconsumed record in the slab.
+    /// Decompressed column-major data for compressed storage.
+    std::vector<char> m_decompBuf;
 };
 
 } // namespace pdal
@@ -34,6 +34,7 @@
 
 #include "PlyReader.hpp"
 
+#include <algorithm>
 #include <sstream>
 
 #include <pdal/PDALUtils.hpp>
@@ -310,6 +311,26 @@ void PlyReader::initialize()
 }
 
 
+QuickInfo PlyReader::inspect()
+{
+    QuickInfo qi;
+    std::unique_ptr<PointLayout> layout(new PointLayout());
+
+    initialize();
+    addDimensions(layout.get());
+
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
+    // The header states the vertex count.  It provides no bounds, so
+    // those stay empty.
+    qi.m_pointCount = m_vertexElt->m_count;
+    qi.m_valid = true;
+
+    return qi;
+}
+
+
 void PlyReader::addDimensions(PointLayoutPtr layout)
 {
     // Override XYZ to doubles.
@@ -324,7 +345,11 @@ void PlyReader::addDimensions(PointLayoutPtr layout)
             for (auto& prop : elt.m_properties)
             {
                 auto vprop = static_cast<SimpleProperty *>(prop.get());
-                layout->registerOrAssignDim(vprop->m_name, vprop->m_type);
+                // Properties pruned by pushdown (see Reader::keepDim())
+                // keep an unknown dimension, making their assignments
+                // no-ops.
+                if (!keepDim(vprop->m_name))
+                    continue;
                 vprop->setDim(
                     layout->registerOrAssignDim(vprop->m_name, vprop->m_type));
             }
@@ -432,18 +457,83 @@ void PlyReader::ready(PointTableRef table)
             readElement(elt, point);
     }
     m_index = 0;
+
+    // In binary formats the vertex element is a fixed-stride record, so
+    // set up to read slabs of roughly a megabyte and unpack fields from
+    // them in place.
+    m_recordSize = 0;
+    m_slabProps.clear();
+    m_slabRecs = 0;
+    m_slabPos = 0;
+    if (m_format != Format::Ascii)
+    {
+        for (auto& prop : m_vertexElt->m_properties)
+        {
+            SimpleProperty *sp = static_cast<SimpleProperty *>(prop.get());
+            // Pruned properties still occupy record space but don't
+            // need unpacking.
+            if (sp->m_dim != Dimension::Id::Unknown)
+                m_slabProps.push_back(std::make_pair(sp, m_recordSize));
+            m_recordSize += Dimension::size(sp->m_type);
+        }
+        if (m_recordSize)
+        {
+            const size_t SlabSize = 1024 * 1024;
+            m_slabCap = (std::max)((size_t)1, SlabSize / m_recordSize);
+            m_slab.resize(m_slabCap * m_recordSize);
+        }
+    }
+}
+
+
+bool PlyReader::fillSlab()
+{
+    size_t recs =
+        (std::min)((size_t)(m_vertexElt->m_count - m_index), m_slabCap);
+    m_stream->read(m_slab.data(), recs * m_recordSize);
+    if ((size_t)m_stream->gcount() != recs * m_recordSize)
+        return false;
+
+    // The extractor-based path assumed a little-endian host, as does
+    // this: only big-endian files need their values swapped.
+    if (m_format == Format::BinaryBe)
+        for (auto& sp : m_slabProps)
+        {
+            size_t size = Dimension::size(sp.first->m_type);
+            if (size == 1)
+                continue;
+            char *p = m_slab.data() + sp.second;
+            for (size_t i = 0; i < recs; ++i, p += m_recordSize)
+                std::reverse(p, p + size);
+        }
+    m_slabRecs = recs;
+    m_slabPos = 0;
+    return true;
 }
 
 
 bool PlyReader::processOne(PointRef& point)
 {
-    if (m_index < m_vertexElt->m_count)
+    if (m_index >= m_vertexElt->m_count)
+        return false;
+
+    if (m_format == Format::Ascii || !m_recordSize)
     {
         readElement(*m_vertexElt, point);
         m_index++;
         return true;
     }
-    return false;
+
+    if (m_slabPos == m_slabRecs && !fillSlab())
+        throwError("Error reading data for point/element " +
+            std::to_string(point.pointId()) + ".");
+
+    const char *rec = m_slab.data() + (m_slabPos * m_recordSize);
+    for (auto& sp : m_slabProps)
+        point.setField(sp.first->m_dim, sp.first->m_type, rec + sp.second);
+    m_slabPos++;
+    m_index++;
+    return true;
 }
 
 
@@ -127,7 +127,18 @@ private:
     PointId m_index;
     Element *m_vertexElt;
 
+    // Binary vertex records have a fixed stride - list properties aren't
+    // allowed on the vertex element - so they're read in slabs and unpacked
+    // per property rather than value by value through the extractor.
+    std::vector<char> m_slab;
+    std::vector<std::pair<SimpleProperty *, size_t>> m_slabProps;
+    size_t m_recordSize;
+    size_t m_slabCap;     // Capacity of the slab in records.
+    size_t m_slabRecs;    // Records in the slab.
+    size_t m_slabPos;     // Next unconsumed record in the slab.
+
     virtual void initialize();
+    virtual QuickInfo inspect();
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void ready(PointTableRef table);
     virtual point_count_t read(PointViewPtr view, point_count_t num);
@@ -147,6 +158,7 @@ private:
     void extractHeader();
     void readElement(Element& elt, PointRef& point);
     bool readProperty(Property *prop, PointRef& point);
+    bool fillSlab();
 };
 
 } // namespace pdal
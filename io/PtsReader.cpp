@@ -74,6 +74,7 @@ void PtsReader::initialize(PointTableRef table)
     //      X Y Z Intensity R G B
     std::getline(*m_istream, buf);
     StringList fields = Utils::split2(buf, m_separator);
+    m_dims.clear();
     switch(fields.size())
     {
         case 3:
@@ -104,6 +105,26 @@ void PtsReader::initialize(PointTableRef table)
 }
 
 
+QuickInfo PtsReader::inspect()
+{
+    QuickInfo qi;
+    std::unique_ptr<PointLayout> layout(new PointLayout());
+
+    PointTable table;
+    initialize(table);
+    addDimensions(layout.get());
+
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
+    // The first line of the file holds the point count.
+    qi.m_pointCount = m_PointCount;
+    qi.m_valid = true;
+
+    return qi;
+}
+
+
 void PtsReader::addDimensions(PointLayoutPtr layout)
 {
     layout->registerDims(m_dims);
@@ -154,7 +175,8 @@ point_count_t PtsReader::read(PointViewPtr view, point_count_t numPts)
         double d;
         for (size_t i = 0; i < fields.size(); ++i)
         {
-            if (!Utils::fromString(fields[i], d))
+            const std::string& f = fields[i];
+            if (!Utils::parseDouble(f.data(), f.data() + f.size(), d))
             {
                 log()->get(LogLevel::Error) << "Can't convert "
                     "field '" << fields[i] << "' to numeric value on line " <<
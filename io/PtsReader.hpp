@@ -57,6 +57,7 @@ private:
       \param table  Point table being initialized.
     */
     virtual void initialize(PointTableRef table);
+    virtual QuickInfo inspect();
 
     /**
       Add dimensions fixed dimensions for PTS format
@@ -271,6 +271,28 @@ void QfitReader::addArgs(ProgramArgs& args)
         m_flip_x);
     args.add("scale_z", "Z scale. Use 0.001 to go from mm to m",
         m_scale_z, 0.001);
+    args.add("mmap", "Memory-map the file and serve reads directly from "
+        "the mapping", m_mmap);
+}
+
+
+QuickInfo QfitReader::inspect()
+{
+    QuickInfo qi;
+    std::unique_ptr<PointLayout> layout(new PointLayout());
+
+    initialize();
+    addDimensions(layout.get());
+
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
+    // The count comes from the file size and record length determined
+    // when reading the header.  There's no extent to report.
+    qi.m_pointCount = m_numPoints;
+    qi.m_valid = true;
+
+    return qi;
 }
 
 
@@ -315,7 +337,7 @@ void QfitReader::ready(PointTableRef)
         throwError("Error calculating file point count.  File size is "
             "inconsistent with point size.");
     m_index = 0;
-    m_istream.reset(new IStream(m_filename));
+    m_istream.reset(new IStream(m_filename, m_mmap));
     m_istream->seek(m_offset);
 }
 
@@ -328,71 +350,83 @@ point_count_t QfitReader::read(PointViewPtr data, point_count_t count)
         throwError("End of file detected.");
 
     count = (std::min)(m_numPoints - m_index, count);
-    std::vector<char> buf(m_size);
+
+    // Read whole slabs of records with one stream call and run one
+    // extractor over the slab rather than one per record.
+    const point_count_t MaxSlab = 4096;
+    std::vector<char> buf;
     PointId nextId = data->size();
     point_count_t numRead = 0;
-    while (count--)
+    while (numRead < count)
     {
+        point_count_t slab = (std::min)(MaxSlab, count - numRead);
+        buf.resize(m_size * slab);
         m_istream->get(buf);
-        SwitchableExtractor extractor(buf.data(), m_size, m_littleEndian);
-
-        // always read the base fields
-        {
-            int32_t time, y, xi, z, start_pulse, reflected_pulse, scan_angle,
-                pitch, roll;
-            extractor >> time >> y >> xi >> z >> start_pulse >>
-                reflected_pulse >> scan_angle >> pitch >> roll;
-            double x = xi / 1000000.0;
-            if (m_flip_x && x > 180)
-                x -= 360;
-
-            data->setField(Dimension::Id::OffsetTime, nextId, time);
-            data->setField(Dimension::Id::Y, nextId, y / 1000000.0);
-            data->setField(Dimension::Id::X, nextId, x);
-            data->setField(Dimension::Id::Z, nextId, z * m_scale_z);
-            data->setField(Dimension::Id::StartPulse, nextId, start_pulse);
-            data->setField(Dimension::Id::ReflectedPulse, nextId,
-                reflected_pulse);
-            data->setField(Dimension::Id::Azimuth, nextId,
-                scan_angle / 1000.0);
-            data->setField(Dimension::Id::Pitch, nextId, pitch / 1000.0);
-            data->setField(Dimension::Id::Roll, nextId, roll / 1000.0);
-        }
-
-        if (m_format == QFIT_Format_12)
-        {
-            int32_t pdop, pulse_width;
-            extractor >> pdop >> pulse_width;
-            data->setField(Dimension::Id::Pdop, nextId, pdop / 10.0);
-            data->setField(Dimension::Id::PulseWidth, nextId, pulse_width);
-        }
-        else if (m_format == QFIT_Format_14)
+        SwitchableExtractor extractor(buf.data(), buf.size(), m_littleEndian);
+        for (point_count_t r = 0; r < slab; ++r)
         {
-            int32_t passive_signal, passive_y, passive_x, passive_z;
-            extractor >> passive_signal >> passive_y >> passive_x >> passive_z;
-            double x = passive_x / 1000000.0;
-            if (m_flip_x && x > 180)
-                x -= 360;
-            data->setField(Dimension::Id::PassiveSignal, nextId, passive_signal);
-            data->setField(Dimension::Id::PassiveY, nextId,
-                passive_y / 1000000.0);
-            data->setField(Dimension::Id::PassiveX, nextId, x);
-            data->setField(Dimension::Id::PassiveZ, nextId,
-                passive_z * m_scale_z);
+            extractor.seek(r * m_size);
+
+            // always read the base fields
+            {
+                int32_t time, y, xi, z, start_pulse, reflected_pulse,
+                    scan_angle, pitch, roll;
+                extractRecord(extractor, time, y, xi, z, start_pulse,
+                    reflected_pulse, scan_angle, pitch, roll);
+                double x = xi / 1000000.0;
+                if (m_flip_x && x > 180)
+                    x -= 360;
+
+                data->setField(Dimension::Id::OffsetTime, nextId, time);
+                data->setField(Dimension::Id::Y, nextId, y / 1000000.0);
+                data->setField(Dimension::Id::X, nextId, x);
+                data->setField(Dimension::Id::Z, nextId, z * m_scale_z);
+                data->setField(Dimension::Id::StartPulse, nextId,
+                    start_pulse);
+                data->setField(Dimension::Id::ReflectedPulse, nextId,
+                    reflected_pulse);
+                data->setField(Dimension::Id::Azimuth, nextId,
+                    scan_angle / 1000.0);
+                data->setField(Dimension::Id::Pitch, nextId, pitch / 1000.0);
+                data->setField(Dimension::Id::Roll, nextId, roll / 1000.0);
+            }
+
+            if (m_format == QFIT_Format_12)
+            {
+                int32_t pdop, pulse_width;
+                extractRecord(extractor, pdop, pulse_width);
+                data->setField(Dimension::Id::Pdop, nextId, pdop / 10.0);
+                data->setField(Dimension::Id::PulseWidth, nextId,
+                    pulse_width);
+            }
+            else if (m_format == QFIT_Format_14)
+            {
+                int32_t passive_signal, passive_y, passive_x, passive_z;
+                extractRecord(extractor, passive_signal, passive_y,
+                    passive_x, passive_z);
+                double x = passive_x / 1000000.0;
+                if (m_flip_x && x > 180)
+                    x -= 360;
+                data->setField(Dimension::Id::PassiveSignal, nextId,
+                    passive_signal);
+                data->setField(Dimension::Id::PassiveY, nextId,
+                    passive_y / 1000000.0);
+                data->setField(Dimension::Id::PassiveX, nextId, x);
+                data->setField(Dimension::Id::PassiveZ, nextId,
+                    passive_z * m_scale_z);
+            }
+            // GPS time is really a GPS offset from the start of the GPS day
+            // encoded in this odd way: 153320100 = 15 hours 33 minutes
+            // 20 seconds 100 milliseconds.
+            // Not sure why we have that AND the other offset time.  For now
+            // we'll just skip over this time.
+
+            if (m_cb)
+                m_cb(*data, nextId);
+
+            numRead++;
+            nextId++;
         }
-        // GPS time is really a GPS offset from the start of the GPS day
-        // encoded in this odd way: 153320100 = 15 hours 33 minutes
-        // 20 seconds 100 milliseconds.
-        // Not sure why we have that AND the other offset time.  For now
-        // we'll just extract this time and drop it.
-        int32_t gpstime;
-        extractor >> gpstime;
-
-        if (m_cb)
-            m_cb(*data, nextId);
-
-        numRead++;
-        nextId++;
     }
     m_index += numRead;
 
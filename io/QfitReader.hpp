@@ -66,6 +66,7 @@ private:
     uint32_t m_size;
     bool m_flip_x;
     double m_scale_z;
+    bool m_mmap;
     bool m_littleEndian;
     point_count_t m_numPoints;
     std::unique_ptr<IStream> m_istream;
@@ -73,6 +74,7 @@ private:
 
     virtual void addArgs(ProgramArgs& args);
     virtual void initialize();
+    virtual QuickInfo inspect();
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void ready(PointTableRef table);
     virtual point_count_t read(PointViewPtr buf, point_count_t count);
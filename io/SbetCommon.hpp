@@ -34,7 +34,11 @@
 
 #pragma once
 
+#include <string>
+#include <utility>
+
 #include <pdal/Dimension.hpp>
+#include <pdal/util/FileUtils.hpp>
 
 namespace pdal
 {
@@ -76,5 +80,115 @@ static inline bool isAngularDimension(Dimension::Id dimension) {
     }
 };
 
+/// View of an SBET file as a strided array of trajectory records.
+///
+/// The file is memory-mapped rather than read, so the fixed records of
+/// RecordDims doubles are addressable in place.  Records are stored in
+/// GpsTime order, which makes the mapping itself a time index - range
+/// lookups are binary searches over the mapped data.  Georeferencing
+/// code can open a trajectory directly and query attitude records by
+/// time without running a pipeline.  Values are returned as stored, so
+/// angles are in radians; callers convert as needed.
+class Trajectory
+{
+public:
+    /// Number of doubles in each record, in fileDimensions() order.
+    static const size_t RecordDims = 17;
+
+    Trajectory() : m_count(0)
+    {}
+    ~Trajectory()
+        { close(); }
+    Trajectory(const Trajectory&) = delete;
+    Trajectory& operator=(const Trajectory&) = delete;
+
+    /// Map \a filename.  On failure, \a error is set and false is
+    /// returned.
+    bool open(const std::string& filename, std::string& error)
+    {
+        close();
+        uintmax_t fileSize = FileUtils::fileSize(filename);
+        if (fileSize % recordSize() != 0)
+        {
+            error = "Invalid file size.";
+            return false;
+        }
+        // Nothing to map in an empty file.
+        if (fileSize == 0)
+            return true;
+        m_ctx = FileUtils::mapFile(filename);
+        if (!m_ctx.addr())
+        {
+            error = m_ctx.what();
+            return false;
+        }
+        m_count = (point_count_t)(fileSize / recordSize());
+        return true;
+    }
+
+    void close()
+    {
+        if (m_ctx.addr())
+            m_ctx = FileUtils::unmapFile(m_ctx);
+        m_count = 0;
+    }
+
+    /// \return  Number of records in the file.
+    point_count_t size() const
+        { return m_count; }
+
+    /// \return  Size of a record in bytes.
+    static size_t recordSize()
+        { return RecordDims * sizeof(double); }
+
+    /// Record \a idx as a pointer to RecordDims doubles.  Consecutive
+    /// records are RecordDims doubles apart.  SBET doubles are
+    /// little-endian, matching the platforms PDAL targets, so the
+    /// mapped bytes are read in place.
+    const double *record(PointId idx) const
+    {
+        return reinterpret_cast<const double *>(m_ctx.addr()) +
+            idx * RecordDims;
+    }
+
+    /// GpsTime of record \a idx.
+    double time(PointId idx) const
+        { return record(idx)[0]; }
+
+    /// Index of the first record with time not less than \a t, or
+    /// size() if there is none.
+    PointId lowerBound(double t) const
+    {
+        PointId lo = 0;
+        point_count_t n = m_count;
+        while (n)
+        {
+            point_count_t half = n / 2;
+            if (time(lo + half) < t)
+            {
+                lo += half + 1;
+                n -= half + 1;
+            }
+            else
+                n = half;
+        }
+        return lo;
+    }
+
+    /// Record range [first, second) whose times fall in [\a t1, \a t2].
+    std::pair<PointId, PointId> timeRange(double t1, double t2) const
+    {
+        PointId lo = lowerBound(t1);
+        PointId hi = lo;
+        while (hi < m_count && time(hi) <= t2)
+            hi++;
+        return std::make_pair(lo, hi);
+    }
+
+private:
+    FileUtils::MapContext m_ctx;
+    point_count_t m_count;
+};
+
 } // namespace sbet
 } // namespace pdal
@@ -61,6 +61,25 @@ void SbetReader::addArgs(ProgramArgs& args)
     args.add("angles_as_degrees", "Convert all angles to degrees", m_anglesAsDegrees, true);
 }
 
+QuickInfo SbetReader::inspect()
+{
+    QuickInfo qi;
+    std::unique_ptr<PointLayout> layout(new PointLayout());
+
+    addDimensions(layout.get());
+
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
+    // Fixed-size records - the file size gives the count.
+    size_t pointSize = sbet::fileDimensions().size() * sizeof(double);
+    qi.m_pointCount = FileUtils::fileSize(m_filename) / pointSize;
+    qi.m_valid = true;
+
+    return qi;
+}
+
+
 void SbetReader::addDimensions(PointLayoutPtr layout)
 {
     layout->registerDims(sbet::fileDimensions());
@@ -69,68 +88,77 @@ void SbetReader::addDimensions(PointLayoutPtr layout)
 
 void SbetReader::ready(PointTableRef)
 {
-    size_t fileSize = FileUtils::fileSize(m_filename);
-    size_t pointSize = sbet::fileDimensions().size() * sizeof(double);
-    if (fileSize % pointSize != 0)
-        throwError("Invalid file size.");
-    m_numPts = fileSize / pointSize;
+    std::string error;
+    if (!m_traj.open(m_filename, error))
+        throwError(error);
+    m_numPts = m_traj.size();
     m_index = 0;
-    m_stream.reset(new ILeStream(m_filename));
     m_dims = sbet::fileDimensions();
-    seek(m_index);
 }
 
 
 bool SbetReader::processOne(PointRef& point)
 {
-    auto radiansToDegrees = [](double radians) {
-        return radians * 180.0 / M_PI;
-    };
-    for (auto di = m_dims.begin(); di != m_dims.end(); ++di)
+    if (m_index >= m_numPts)
+        return false;
+
+    const double *rec = m_traj.record(m_index);
+    for (size_t d = 0; d < m_dims.size(); ++d)
     {
-        double d;
-        *m_stream >> d;
-        Dimension::Id dim = *di;
-        if (m_anglesAsDegrees && sbet::isAngularDimension(dim)) {
-            d = radiansToDegrees(d);
-        }
-        point.setField(dim, d);
+        double v = rec[d];
+        if (m_anglesAsDegrees && sbet::isAngularDimension(m_dims[d]))
+            v = v * 180.0 / M_PI;
+        point.setField(m_dims[d], v);
     }
-    return (m_stream->good());
+    m_index++;
+    return true;
 }
 
 
 point_count_t SbetReader::read(PointViewPtr view, point_count_t count)
 {
     PointId nextId = view->size();
-    PointId idx = m_index;
-    point_count_t numRead = 0;
-    seek(idx);
-    while (numRead < count && idx < m_numPts)
+    point_count_t numRead =
+        (std::min)(count, (point_count_t)(m_numPts - m_index));
+    if (!numRead)
+        return 0;
+    for (point_count_t i = 0; i < numRead; ++i)
+        view->getOrAddPoint(nextId + i);
+
+    // Move the mapped records a column at a time so each angular
+    // dimension is converted in one pass over its column rather than
+    // per point.
+    const double *base = m_traj.record(m_index);
+    std::vector<double> col(numRead);
+    for (size_t d = 0; d < m_dims.size(); ++d)
     {
-        PointRef point = view->point(nextId);
-        processOne(point);
-        if (m_cb)
-            m_cb(*view, nextId);
-
-        idx++;
-        nextId++;
-        numRead++;
+        const double *src = base + d;
+        if (m_anglesAsDegrees && sbet::isAngularDimension(m_dims[d]))
+            for (point_count_t i = 0; i < numRead; ++i)
+                col[i] = src[i * sbet::Trajectory::RecordDims] * 180.0 / M_PI;
+        else
+            for (point_count_t i = 0; i < numRead; ++i)
+                col[i] = src[i * sbet::Trajectory::RecordDims];
+        view->setFieldBatch(m_dims[d], nextId, numRead, col.data());
     }
-    m_index = idx;
+    if (m_cb)
+        for (point_count_t i = 0; i < numRead; ++i)
+            m_cb(*view, nextId + i);
+
+    m_index += numRead;
     return numRead;
 }
 
 
-bool SbetReader::eof()
+void SbetReader::done(PointTableRef)
 {
-    return m_index >= m_numPts;
+    m_traj.close();
 }
 
 
-void SbetReader::seek(PointId idx)
+bool SbetReader::eof()
 {
-    m_stream->seek(idx * sizeof(double) * sbet::fileDimensions().size());
+    return m_index >= m_numPts;
 }
 
 } // namespace pdal
@@ -37,9 +37,10 @@
 #include <pdal/PointView.hpp>
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
-#include <pdal/util/IStream.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
+#include "SbetCommon.hpp"
+
 namespace pdal
 {
 
@@ -52,7 +53,8 @@ public:
     std::string getName() const;
 
 private:
-    std::unique_ptr<ILeStream> m_stream;
+    // Memory-mapped view of the trajectory records.
+    sbet::Trajectory m_traj;
     // Number of points in the file.
     point_count_t m_numPts;
     point_count_t m_index;
@@ -61,12 +63,12 @@ private:
 
     virtual bool processOne(PointRef& point);
     virtual void addArgs(ProgramArgs& args);
+    virtual QuickInfo inspect();
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void ready(PointTableRef table);
     virtual point_count_t read(PointViewPtr view, point_count_t count);
+    virtual void done(PointTableRef table);
     virtual bool eof();
-
-    void seek(PointId idx);
 };
 
 } // namespace pdal
@@ -0,0 +1,180 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "ShmReader.hpp"
+
+#include <pdal/PointView.hpp>
+#include <pdal/util/IStream.hpp>
+
+#include "ShmCommon.hpp"
+
+namespace pdal
+{
+
+static StaticPluginInfo const s_info
+{
+    "readers.shm",
+    "Shared-memory point table reader",
+    "http://pdal.io/stages/readers.shm.html",
+    { "shm" }
+};
+
+CREATE_STATIC_STAGE(ShmReader, s_info)
+
+std::string ShmReader::getName() const { return s_info.name; }
+
+ShmReader::ShmReader() : m_pointSize(0), m_numPoints(0), m_dataOffset(0),
+    m_data(nullptr), m_index(0)
+{}
+
+
+void ShmReader::initialize()
+{
+    ILeStream in(m_filename);
+    if (!in)
+        throwError("Couldn't open '" + m_filename + "'.");
+
+    std::string magic;
+    in.get(magic, sizeof(shm::Magic) - 1);
+    if (magic != shm::Magic)
+        throwError("File '" + m_filename +
+            "' isn't a PDAL shared-memory point table.");
+
+    uint32_t pointSize;
+    uint32_t numDims;
+    in >> m_numPoints >> pointSize >> numDims;
+
+    m_dims.clear();
+    size_t offset = 0;
+    for (uint32_t i = 0; i < numDims; ++i)
+    {
+        uint16_t type;
+        uint16_t nameLen;
+        std::string name;
+
+        in >> type >> nameLen;
+        in.get(name, nameLen);
+
+        Dimension::Type dimType = (Dimension::Type)type;
+        if (Dimension::size(dimType) == 0)
+            throwError("Invalid type for dimension '" + name + "'.");
+        m_dims.emplace_back(name, dimType, offset);
+        offset += Dimension::size(dimType);
+    }
+    m_pointSize = pointSize;
+    if (offset != m_pointSize)
+        throwError("Dimension sizes don't match the point record size.");
+
+    uint32_t srsLen;
+    std::string srs;
+    in >> srsLen;
+    in.get(srs, srsLen);
+    if (srs.size())
+        setSpatialReference(SpatialReference(srs));
+
+    m_dataOffset = (uintmax_t)in.position();
+    if (!in.good())
+        throwError("File '" + m_filename + "' is truncated.");
+}
+
+
+QuickInfo ShmReader::inspect()
+{
+    QuickInfo qi;
+
+    initialize();
+    for (const ShmDim& dim : m_dims)
+        qi.m_dimNames.push_back(dim.m_name);
+    qi.m_pointCount = m_numPoints;
+    qi.m_srs = getSpatialReference();
+    qi.m_valid = true;
+    return qi;
+}
+
+
+void ShmReader::addDimensions(PointLayoutPtr layout)
+{
+    for (ShmDim& dim : m_dims)
+        dim.m_id = layout->registerOrAssignDim(dim.m_name, dim.m_type);
+}
+
+
+void ShmReader::ready(PointTableRef table)
+{
+    m_mapCtx = FileUtils::mapFile(m_filename);
+    if (!m_mapCtx.addr())
+        throwError("Couldn't map file '" + m_filename + "': " +
+            m_mapCtx.what());
+    m_data = (const char *)m_mapCtx.addr() + m_dataOffset;
+    m_index = 0;
+}
+
+
+point_count_t ShmReader::read(PointViewPtr view, point_count_t count)
+{
+    count = (std::min)(count, (point_count_t)(m_numPoints - m_index));
+
+    for (point_count_t i = 0; i < count; ++i)
+    {
+        PointId nextId = view->size();
+        const char *p = m_data + m_index * m_pointSize;
+        for (const ShmDim& dim : m_dims)
+            view->setField(dim.m_id, dim.m_type, nextId, p + dim.m_offset);
+        m_index++;
+    }
+    return count;
+}
+
+
+bool ShmReader::processOne(PointRef& point)
+{
+    if (m_index >= m_numPoints)
+        return false;
+
+    const char *p = m_data + m_index * m_pointSize;
+    for (const ShmDim& dim : m_dims)
+        point.setField(dim.m_id, dim.m_type, p + dim.m_offset);
+    m_index++;
+    return true;
+}
+
+
+void ShmReader::done(PointTableRef table)
+{
+    if (m_mapCtx.addr())
+        m_mapCtx = FileUtils::unmapFile(m_mapCtx);
+    m_data = nullptr;
+}
+
+} // namespace pdal
@@ -0,0 +1,90 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <pdal/Reader.hpp>
+#include <pdal/Streamable.hpp>
+#include <pdal/util/FileUtils.hpp>
+
+namespace pdal
+{
+
+// Attaches to a point table region written by ShmWriter by mapping it
+// and filling points straight from the mapped records - no parsing or
+// intermediate buffering.  With the region on a memory filesystem
+// (e.g. /dev/shm), chained pdal invocations hand points from process to
+// process without touching storage.
+class PDAL_DLL ShmReader : public Reader, public Streamable
+{
+public:
+    ShmReader();
+    std::string getName() const;
+
+private:
+    struct ShmDim
+    {
+        std::string m_name;
+        Dimension::Id m_id;
+        Dimension::Type m_type;
+        size_t m_offset;
+
+        ShmDim(const std::string& name, Dimension::Type type,
+            size_t offset) : m_name(name), m_id(Dimension::Id::Unknown),
+            m_type(type), m_offset(offset)
+        {}
+    };
+
+    virtual QuickInfo inspect();
+    virtual void initialize();
+    virtual void addDimensions(PointLayoutPtr layout);
+    virtual void ready(PointTableRef table);
+    virtual point_count_t read(PointViewPtr view, point_count_t count);
+    virtual bool processOne(PointRef& point);
+    virtual void done(PointTableRef table);
+
+    std::vector<ShmDim> m_dims;
+    size_t m_pointSize;
+    uint64_t m_numPoints;
+    // Offset of the first point record in the file.
+    uintmax_t m_dataOffset;
+    FileUtils::MapContext m_mapCtx;
+    const char *m_data;
+    PointId m_index;
+
+    ShmReader& operator=(const ShmReader&); // not implemented
+    ShmReader(const ShmReader&); // not implemented
+};
+
+} // namespace pdal
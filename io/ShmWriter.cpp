@@ -0,0 +1,128 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "ShmWriter.hpp"
+
+#include <pdal/util/ProgramArgs.hpp>
+
+#include "ShmCommon.hpp"
+
+namespace pdal
+{
+
+static StaticPluginInfo const s_info
+{
+    "writers.shm",
+    "Shared-memory point table writer",
+    "http://pdal.io/stages/writers.shm.html",
+    { "shm" }
+};
+
+CREATE_STATIC_STAGE(ShmWriter, s_info)
+
+std::string ShmWriter::getName() const { return s_info.name; }
+
+ShmWriter::ShmWriter() : m_pointSize(0), m_numPoints(0)
+{}
+
+
+void ShmWriter::addArgs(ProgramArgs& args)
+{
+    args.add("filename", "Output filename", m_filename).setPositional();
+}
+
+
+void ShmWriter::ready(PointTableRef table)
+{
+    if (m_out.open(m_filename))
+        throwError("Couldn't open '" + m_filename + "' for output.");
+
+    PointLayoutPtr layout = table.layout();
+    m_dims = layout->dimTypes();
+
+    m_pointSize = 0;
+    for (const DimType& dim : m_dims)
+        m_pointSize += Dimension::size(dim.m_type);
+    m_pointBuf.resize(m_pointSize);
+    m_numPoints = 0;
+
+    // The point count isn't known until all points are written, so a
+    // placeholder goes out now and gets patched in done().
+    m_out.put(shm::Magic, sizeof(shm::Magic) - 1);
+    m_countPos = m_out.position();
+    m_out << (uint64_t)0;
+    m_out << (uint32_t)m_pointSize;
+    m_out << (uint32_t)m_dims.size();
+    for (const DimType& dim : m_dims)
+    {
+        std::string name = layout->dimName(dim.m_id);
+        m_out << (uint16_t)dim.m_type;
+        m_out << (uint16_t)name.size();
+        m_out.put(name);
+    }
+    std::string srs = table.spatialReference().getWKT();
+    m_out << (uint32_t)srs.size();
+    m_out.put(srs);
+}
+
+
+bool ShmWriter::processOne(PointRef& point)
+{
+    point.getPackedData(m_dims, m_pointBuf.data());
+    m_out.put(m_pointBuf.data(), m_pointSize);
+    m_numPoints++;
+    return true;
+}
+
+
+void ShmWriter::write(const PointViewPtr view)
+{
+    PointRef point(*view, 0);
+    for (PointId idx = 0; idx < view->size(); ++idx)
+    {
+        point.setPointId(idx);
+        processOne(point);
+    }
+}
+
+
+void ShmWriter::done(PointTableRef table)
+{
+    m_out.seek(m_countPos);
+    m_out << m_numPoints;
+    m_out.close();
+    getMetadata().addList("filename", m_filename);
+}
+
+} // namespace pdal
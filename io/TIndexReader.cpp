@@ -33,8 +33,12 @@
 ****************************************************************************/
 
 #include "TIndexReader.hpp"
+
+#include <thread>
+
 #include <pdal/GDALUtils.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -140,6 +144,17 @@ void TIndexReader::initialize()
 {
     if (!m_bounds.empty())
         m_wkt = m_bounds.toWKT();
+    else if (m_wkt.empty())
+    {
+        // Downstream crop pushdown - prune tiles that can't intersect
+        // the cropped region.  The crop still filters exactly, so the
+        // enclosing box is fine.
+        BOX2D box;
+        for (const Bounds& b : pushdownBounds())
+            box.grow(b.to2d());
+        if (box.valid())
+            m_wkt = box.toWKT();
+    }
     m_out_ref.reset(new gdal::SpatialRef());
 
     log()->get(LogLevel::Debug) << "Opening file " << m_filename <<
@@ -214,7 +229,7 @@ void TIndexReader::initialize()
     for (auto f : getFiles())
     {
         log()->get(LogLevel::Debug) << "Adding file " << f.m_filename <<
-            " to merge filter" << std::endl;
+            " to tile list" << std::endl;
 
         std::string driver = m_factory.inferReaderDriver(f.m_filename);
         Stage *reader = m_factory.createStage(driver);
@@ -253,7 +268,7 @@ void TIndexReader::initialize()
             premerge = crop;
         }
 
-        m_merge.setInput(*premerge);
+        m_tileStages.push_back(premerge);
     }
 
     if (m_sql.size())
@@ -272,18 +287,67 @@ void TIndexReader::initialize()
 
 void TIndexReader::prepared(PointTableRef table)
 {
-    m_merge.prepare(table);
+    for (Stage *s : m_tileStages)
+        s->prepare(table);
+}
+
+
+// Execute the linear chain of stages ending at 's' in the calling thread.
+PointViewSet TIndexReader::runChain(Stage *s, PointTableRef table)
+{
+    PointViewSet views;
+
+    if (s->getInputs().empty())
+        views.insert(PointViewPtr(new PointView(table)));
+    else
+        views = runChain(s->getInputs()[0], table);
+    return s->execute(table, views);
 }
 
+
 void TIndexReader::ready(PointTableRef table)
 {
-    m_pvSet = m_merge.execute(table);
+    m_tileViews.clear();
+    m_tileViews.resize(m_tileStages.size());
+
+    // Each matched file runs through its own pipeline into its own
+    // views, so the tiles can be read concurrently when the table
+    // supports concurrent point addition.  Results are kept in
+    // tile-index order regardless of completion order.
+    size_t threads = 1;
+    if (table.concurrentAddSafe())
+        threads = (std::min)((size_t)std::thread::hardware_concurrency(),
+            m_tileStages.size());
+
+    if (threads > 1)
+    {
+        log()->get(LogLevel::Debug) << "Reading " << m_tileStages.size() <<
+            " tiles on " << threads << " threads." << std::endl;
+
+        ThreadPool pool(threads);
+        for (size_t i = 0; i < m_tileStages.size(); ++i)
+            pool.add([this, &table, i]()
+                { m_tileViews[i] = runChain(m_tileStages[i], table); });
+        pool.join();
+        if (pool.errors().size())
+            throwError(pool.errors().front());
+    }
+    else
+        for (size_t i = 0; i < m_tileStages.size(); ++i)
+            m_tileViews[i] = runChain(m_tileStages[i], table);
 }
 
 
-PointViewSet TIndexReader::run(PointViewPtr)
+PointViewSet TIndexReader::run(PointViewPtr view)
 {
-    return m_pvSet;
+    PointViewSet out;
+
+    for (auto& tileViews : m_tileViews)
+        for (const PointViewPtr& v : tileViews)
+            view->append(*v);
+    m_tileViews.clear();
+    out.insert(view);
+    return out;
 }
 
 } // namespace pdal
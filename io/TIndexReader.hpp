@@ -37,7 +37,6 @@
 #include <pdal/PointView.hpp>
 #include <pdal/Reader.hpp>
 #include <pdal/StageFactory.hpp>
-#include <filters/MergeFilter.hpp>
 
 namespace pdal
 {
@@ -94,11 +93,15 @@ private:
     void *m_layer;
 
     StageFactory m_factory;
-    MergeFilter m_merge;
-    PointViewSet m_pvSet;
+    // Top stage of each matched file's pipeline (reader, possibly behind
+    // reprojection and crop stages), in tile-index order.
+    std::vector<Stage *> m_tileStages;
+    // Views produced by each tile pipeline, in tile-index order.
+    std::vector<PointViewSet> m_tileViews;
 
     std::vector<FileInfo> getFiles();
     FieldIndexes getFields();
+    PointViewSet runChain(Stage *s, PointTableRef table);
 };
 
 
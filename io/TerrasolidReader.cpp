@@ -93,6 +93,25 @@ void TerrasolidReader::initialize()
 }
 
 
+QuickInfo TerrasolidReader::inspect()
+{
+    QuickInfo qi;
+    std::unique_ptr<PointLayout> layout(new PointLayout());
+
+    initialize();
+    addDimensions(layout.get());
+
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
+    // The header reports the point count but no extent.
+    qi.m_pointCount = m_header->PntCnt;
+    qi.m_valid = true;
+
+    return qi;
+}
+
+
 void TerrasolidReader::addDimensions(PointLayoutPtr layout)
 {
     m_size = 0;
@@ -109,6 +109,7 @@ private:
     point_count_t m_index;
 
     virtual void initialize();
+    virtual QuickInfo inspect();
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void ready(PointTableRef table);
     virtual point_count_t read(PointViewPtr view, point_count_t count);
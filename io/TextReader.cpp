@@ -34,13 +34,24 @@
 
 #include <pdal/PDALUtils.hpp>
 #include <pdal/util/Algorithm.hpp>
+#include <pdal/util/FileUtils.hpp>
 
 #include "TextReader.hpp"
-#include "../filters/StatsFilter.hpp"
+
+#include <algorithm>
+#include <cstring>
 
 namespace pdal
 {
 
+namespace
+{
+
+// Size of the chunks in which input is read.
+const size_t ReadChunkSize = 1024 * 1024;
+
+} // unnamed namespace
+
 static StaticPluginInfo const s_info
 {
     "readers.text",
@@ -53,37 +64,95 @@ CREATE_STATIC_STAGE(TextReader, s_info)
 
 std::string TextReader::getName() const { return s_info.name; }
 
-// NOTE: - Forces reading of the entire file.
+// Sample the leading portion of the file rather than scanning all of
+// it.  If the file ends within the sample the results are exact;
+// otherwise the count is extrapolated from the sampled line density
+// and the bounds cover only the sampled points.
 QuickInfo TextReader::inspect()
 {
     QuickInfo qi;
-    FixedPointTable t(100);
+    std::unique_ptr<PointLayout> layout(new PointLayout());
 
-    StatsFilter f;
-    f.setInput(*this);
+    PointTable table;
+    initialize(table);
+    addDimensions(layout.get());
 
-    f.prepare(t);
-    PointLayoutPtr layout = t.layout();
-    for (Dimension::Id id : layout->dims())
-        qi.m_dimNames.push_back(layout->dimName(id));
-    f.execute(t);
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
 
-    try
+    // Positions of the X/Y/Z fields on each line.
+    size_t xPos = m_dims.size();
+    size_t yPos = m_dims.size();
+    size_t zPos = m_dims.size();
+    for (size_t i = 0; i < m_dims.size(); ++i)
+    {
+        if (m_dims[i] == Dimension::Id::X)
+            xPos = i;
+        else if (m_dims[i] == Dimension::Id::Y)
+            yPos = i;
+        else if (m_dims[i] == Dimension::Id::Z)
+            zPos = i;
+    }
+
+    m_istream = Utils::openFile(m_filename, false);
+    if (!m_istream)
+        throwError("Unable to open text file '" + m_filename + "'.");
+
+    std::string line;
+    for (size_t i = 0; i < m_line; ++i)
+        std::getline(*m_istream, line);
+    std::streamoff dataStart = m_istream->tellg();
+
+    point_count_t sampled = 0;
+    uint64_t bytes = 0;
+    while (bytes < ReadChunkSize && std::getline(*m_istream, line))
+    {
+        bytes += line.size() + 1;
+        if (line.empty())
+            continue;
+
+        StringList fields;
+        if (m_separator != ' ')
+        {
+            line.erase(std::remove(line.begin(), line.end(), ' '),
+                line.end());
+            fields = Utils::split(line, m_separator);
+        }
+        else
+            fields = Utils::split2(line, m_separator);
+        if (fields.size() != m_dims.size())
+            continue;
+        sampled++;
+
+        auto field = [&fields](size_t pos, double& d)
+        {
+            const std::string& f = fields[pos];
+            return Utils::parseDouble(f.data(), f.data() + f.size(), d);
+        };
+        double x, y, z;
+        if (xPos < fields.size() && field(xPos, x) &&
+            yPos < fields.size() && field(yPos, y) &&
+            zPos < fields.size() && field(zPos, z))
+            qi.m_bounds.grow(x, y, z);
+    }
+    bool complete = !m_istream->good();
+    Utils::closeFile(m_istream);
+    m_istream = nullptr;
+
+    if (complete || bytes == 0)
+        qi.m_pointCount = sampled;
+    else
     {
-        stats::Summary xSummary = f.getStats(Dimension::Id::X);
-        qi.m_pointCount = xSummary.count();
-        qi.m_bounds.minx = xSummary.minimum();
-        qi.m_bounds.maxx = xSummary.maximum();
-        stats::Summary ySummary = f.getStats(Dimension::Id::Y);
-        qi.m_bounds.miny = ySummary.minimum();
-        qi.m_bounds.maxy = ySummary.maximum();
-        stats::Summary zSummary = f.getStats(Dimension::Id::Z);
-        qi.m_bounds.minz = zSummary.minimum();
-        qi.m_bounds.maxz = zSummary.maximum();
-        qi.m_valid = true;
+        // Extrapolate the sampled line density across the rest of
+        // the file.
+        uint64_t dataBytes = FileUtils::fileSize(m_filename) -
+            (uint64_t)(std::max)(dataStart, (std::streamoff)0);
+        qi.m_pointCount =
+            (point_count_t)(sampled * ((double)dataBytes / bytes));
+        qi.m_exact = false;
     }
-    catch (pdal_error&)
-    {}
+    qi.m_valid = true;
     return qi;
 }
 
@@ -245,6 +314,11 @@ void TextReader::ready(PointTableRef table)
     std::string dummy;
     for (size_t i = 0; i < m_line; ++i)
 	std::getline(*m_istream, dummy);
+
+    m_buffer.resize(ReadChunkSize);
+    m_bufPos = 0;
+    m_bufAvail = 0;
+    m_carry.clear();
 }
 
 
@@ -273,12 +347,13 @@ bool TextReader::processOne(PointRef& point)
     double d;
     for (size_t i = 0; i < m_fields.size(); ++i)
     {
-        if (!Utils::fromString(m_fields[i], d))
+        const Field& f = m_fields[i];
+        if (!Utils::parseDouble(f.start, f.start + f.size, d))
         {
             log()->get(LogLevel::Error) << "Can't convert "
-                "field '" << m_fields[i] << "' to numeric value on line " <<
-                m_line << " in '" << m_filename << "'.  Setting to 0." <<
-                std::endl;
+                "field '" << std::string(f.start, f.size) <<
+                "' to numeric value on line " << m_line << " in '" <<
+                m_filename << "'.  Setting to 0." << std::endl;
             d = 0;
         }
         point.setField(m_dims[i], d);
@@ -287,26 +362,101 @@ bool TextReader::processOne(PointRef& point)
 }
 
 
-bool TextReader::fillFields()
+bool TextReader::nextLine(char*& start, char*& end)
 {
+    m_carry.clear();
     while (true)
     {
-        if (!m_istream->good())
-            return false;
+        if (m_bufPos == m_bufAvail)
+        {
+            m_istream->read(m_buffer.data(), m_buffer.size());
+            m_bufAvail = (size_t)m_istream->gcount();
+            m_bufPos = 0;
+            if (m_bufAvail == 0)
+            {
+                if (m_carry.empty())
+                    return false;
+                break;  // Final line with no trailing newline.
+            }
+        }
 
-        std::string buf;
+        char *base = m_buffer.data() + m_bufPos;
+        char *nl = (char *)memchr(base, '\n', m_bufAvail - m_bufPos);
+        if (nl)
+        {
+            m_bufPos = (nl - m_buffer.data()) + 1;
+            if (m_carry.empty())
+            {
+                start = base;
+                end = nl;
+                return true;
+            }
+            m_carry.append(base, nl);
+            break;
+        }
 
-        std::getline(*m_istream, buf);
+        // No newline in the remaining buffer - stash the partial line and
+        // refill.
+        m_carry.append(base, m_buffer.data() + m_bufAvail);
+        m_bufPos = m_bufAvail;
+    }
+    start = &m_carry[0];
+    end = start + m_carry.size();
+    return true;
+}
+
+
+bool TextReader::fillFields()
+{
+    while (true)
+    {
+        char *start, *end;
+
+        if (!nextLine(start, end))
+            return false;
         m_line++;
-        if (buf.empty())
+        if (start == end)
             continue;
+        m_fields.clear();
         if (m_separator != ' ')
         {
-            Utils::remove(buf, ' ');
-            m_fields = Utils::split(buf, m_separator);
+            // The old path stripped spaces before splitting on the
+            // separator; compact the line in place instead.  Empty fields
+            // are kept, matching Utils::split().
+            end = std::remove(start, end, ' ');
+            if (start != end)
+            {
+                char *fieldStart = start;
+                for (char *p = start; ; ++p)
+                {
+                    if (p == end || *p == m_separator)
+                    {
+                        m_fields.push_back(
+                            {fieldStart, (size_t)(p - fieldStart)});
+                        if (p == end)
+                            break;
+                        fieldStart = p + 1;
+                    }
+                }
+            }
         }
         else
-            m_fields = Utils::split2(buf, m_separator);
+        {
+            // Split on spaces, discarding empty fields, matching
+            // Utils::split2().
+            char *p = start;
+            while (p != end)
+            {
+                while (p != end && *p == ' ')
+                    ++p;
+                if (p == end)
+                    break;
+                char *fieldStart = p;
+                while (p != end && *p != ' ')
+                    ++p;
+                m_fields.push_back({fieldStart, (size_t)(p - fieldStart)});
+            }
+        }
         if (m_fields.size() != m_dims.size())
         {
             log()->get(LogLevel::Error) << "Line " << m_line <<
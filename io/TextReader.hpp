@@ -113,6 +113,17 @@ private:
 
     bool fillFields();
 
+    /**
+      Scan the next newline-terminated line from the read buffer, refilling
+      the buffer from the input as needed.
+
+      \param[out] start  First character of the line.
+      \param[out] end  One past the last character of the line.  The
+        characters stay valid until the next call.
+      \return  False if no more lines are available.
+    */
+    bool nextLine(char*& start, char*& end);
+
     /**
       Parse a header line into a list of dimension names.
 
@@ -143,15 +154,28 @@ private:
     void checkHeader(const std::string& header);
 
 private:
+    struct Field
+    {
+        const char *start;
+        size_t size;
+    };
+
     char m_separator;
     Arg *m_separatorArg;
     std::istream *m_istream;
     StringList m_dimNames;
     Dimension::IdList m_dims;
-    StringList m_fields;
+    std::vector<Field> m_fields;
     size_t m_line;
     std::string m_header;
     size_t m_skip;
+
+    // Bulk input buffer.  Lines are scanned out of chunk-sized reads and
+    // fields reference the buffer in place rather than being copied out.
+    std::vector<char> m_buffer;
+    size_t m_bufPos;
+    size_t m_bufAvail;
+    std::string m_carry;
 };
 
 } // namespace pdal
@@ -39,12 +39,23 @@
 #include <pdal/PointView.hpp>
 #include <pdal/util/Algorithm.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/WriteBehind.hpp>
 
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 
 namespace pdal
 {
 
+namespace
+{
+
+// Flush the output buffer once it grows past this size.
+const size_t FlushSize = 1024 * 1024;
+
+}
+
 static StaticPluginInfo const s_info
 {
     "writers.text",
@@ -110,11 +121,49 @@ void TextWriter::addArgs(ProgramArgs& args)
     args.add("quote_header", "Whether a header should be quoted",
         m_quoteHeader, true);
     args.add("precision", "Output precision", m_precision, 3);
+    args.add("write_behind", "Buffer output and write it to the file from "
+        "a background thread", m_writeBehind);
+}
+
+
+bool TextWriter::usedDims(StringList& used) const
+{
+    // The output is only limited when an order was given and unspecified
+    // dimensions aren't kept.  Called before options are parsed, so read
+    // the raw options.
+    StringList keep = m_options.getValues("keep_unspecified");
+    if (keep.empty() || !Utils::iequals(keep.front(), "false"))
+        return false;
+    StringList order = m_options.getValues("order");
+    if (order.empty())
+        return false;
+    for (const std::string& o : order)
+        for (std::string d : Utils::split2(o, ','))
+        {
+            // Entries may carry a precision suffix (Name:precision).
+            d = d.substr(0, d.find(':'));
+            Utils::trim(d);
+            used.push_back(d);
+        }
+    return true;
 }
 
 
 void TextWriter::initialize(PointTableRef table)
 {
+    if (m_writeBehind && !Utils::isRemote(m_filename))
+    {
+        auto buf = std::make_shared<WriteBehindBuf>();
+        if (!buf->open(m_filename))
+            throwError("Couldn't open '" + m_filename + "' for output.");
+        m_stream = FileStreamPtr(new std::ostream(buf.get()),
+            [buf](std::ostream *strm)
+            {
+                strm->flush();
+                delete strm;
+            });
+        return;
+    }
     m_stream = FileStreamPtr(Utils::createFile(m_filename, true),
         FileStreamDeleter());
     if (!m_stream)
@@ -169,6 +218,8 @@ bool TextWriter::findDim(Dimension::Id id, DimSpec& ds)
 void TextWriter::ready(PointTableRef table)
 {
     *m_stream << std::fixed;
+    m_outBuf.clear();
+    m_outBuf.reserve(FlushSize + 1024);
 
     m_xDim = { Dimension::Id::X, static_cast<size_t>(m_precision),
         table.layout()->dimName(Dimension::Id::X) };
@@ -226,6 +277,7 @@ void TextWriter::writeHeader(PointTableRef table)
 
 void TextWriter::writeFooter()
 {
+    flushBuffer();
     if (m_outputType == OutputType::GEOJSON)
     {
         *m_stream << "]}";
@@ -262,16 +314,71 @@ void TextWriter::writeCSVHeader(PointTableRef table)
 }
 
 
+void TextWriter::appendFixed(double d, size_t precision)
+{
+    // Integral values - the common case for most non-coordinate
+    // dimensions - are formatted with pure integer arithmetic.  Everything
+    // else goes through snprintf, which produces the same correctly
+    // rounded digits the stream did, without the facet overhead.
+    if (d == (double)(int64_t)d && std::fabs(d) < 1e15 &&
+        !(d == 0 && std::signbit(d)))
+    {
+        char tmp[24];
+        char *end = tmp + sizeof(tmp);
+        char *p = end;
+
+        int64_t v = (int64_t)d;
+        uint64_t u = (uint64_t)(v < 0 ? -v : v);
+        do
+        {
+            *--p = '0' + (char)(u % 10);
+            u /= 10;
+        } while (u);
+        if (v < 0)
+            *--p = '-';
+        m_outBuf.append(p, end);
+        if (precision)
+        {
+            m_outBuf += '.';
+            m_outBuf.append(precision, '0');
+        }
+    }
+    else
+    {
+        // Large enough for the widest double in fixed notation plus a
+        // reasonable precision; oversized precisions take the resize path.
+        char tmp[384];
+        int n = snprintf(tmp, sizeof(tmp), "%.*f", (int)precision, d);
+        if (n >= (int)sizeof(tmp))
+        {
+            std::vector<char> big(n + 1);
+            n = snprintf(big.data(), big.size(), "%.*f", (int)precision, d);
+            m_outBuf.append(big.data(), n);
+        }
+        else
+            m_outBuf.append(tmp, n);
+    }
+}
+
+
+void TextWriter::flushBuffer()
+{
+    m_stream->write(m_outBuf.data(), m_outBuf.size());
+    m_outBuf.clear();
+}
+
+
 void TextWriter::processOneCSV(PointRef& point)
 {
     for (auto di = m_dims.begin(); di != m_dims.end(); ++di)
     {
         if (di != m_dims.begin())
-            *m_stream << m_delimiter;
-        m_stream->precision(di->precision);
-        *m_stream << point.getFieldAs<double>(di->id);
+            m_outBuf += m_delimiter;
+        appendFixed(point.getFieldAs<double>(di->id), di->precision);
     }
-    *m_stream << m_newline;
+    m_outBuf += m_newline;
+    if (m_outBuf.size() >= FlushSize)
+        flushBuffer();
 }
 
 void TextWriter::processOneGeoJSON(PointRef& point)
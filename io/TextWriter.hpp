@@ -69,6 +69,7 @@ public:
 
 private:
     virtual void addArgs(ProgramArgs& args);
+    virtual bool usedDims(StringList& used) const;
     virtual void initialize(PointTableRef table);
     virtual void ready(PointTableRef table);
     virtual void write(const PointViewPtr view);
@@ -82,6 +83,20 @@ private:
     void processOneCSV(PointRef& point);
     void processOneGeoJSON(PointRef& point);
 
+    /**
+      Append \c d in fixed notation with the given precision to the output
+      buffer, matching the formatting of a stream set to std::fixed.
+
+      \param d  Value to format.
+      \param precision  Number of digits after the decimal point.
+    */
+    void appendFixed(double d, size_t precision);
+
+    /**
+      Write the contents of the output buffer to the stream and clear it.
+    */
+    void flushBuffer();
+
     DimSpec extractDim(std::string dim, PointTableRef table);
     bool findDim(Dimension::Id id, DimSpec& ds);
 
@@ -95,10 +110,13 @@ private:
     std::string m_delimiter;
     bool m_quoteHeader;
     bool m_packRgb;
+    bool m_writeBehind;
     int m_precision;
     PointId m_idx;
 
     FileStreamPtr m_stream;
+    // Formatted CSV output is collected here and flushed in large writes.
+    std::string m_outBuf;
     std::vector<DimSpec> m_dims;
     DimSpec m_xDim;
     DimSpec m_yDim;
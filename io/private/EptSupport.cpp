@@ -113,61 +113,6 @@ EptInfo::EptInfo(const NL::json& info) : m_info(info)
 }
 
 
-void Pool::work()
-{
-    while (true)
-    {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_consumeCv.wait(lock, [this]()
-        {
-            return m_tasks.size() || !m_running;
-        });
-
-        if (m_tasks.size())
-        {
-            ++m_outstanding;
-            auto task(std::move(m_tasks.front()));
-            m_tasks.pop();
-
-            lock.unlock();
-
-            // Notify add(), which may be waiting for a spot in the queue.
-            m_produceCv.notify_all();
-
-            std::string err;
-            try
-            {
-                task();
-            }
-            catch (std::exception& e)
-            {
-                err = e.what();
-            }
-            catch (...)
-            {
-                err = "Unknown error";
-            }
-
-            lock.lock();
-            --m_outstanding;
-            if (err.size())
-            {
-                if (m_verbose)
-                    std::cout << "Exception in pool task: " << err << std::endl;
-                m_errors.push_back(err);
-            }
-            lock.unlock();
-
-            // Notify await(), which may be waiting for a running task.
-            m_produceCv.notify_all();
-        }
-        else if (!m_running)
-        {
-            return;
-        }
-    }
-}
-
 void FixedPointLayout::registerFixedDim(const Dimension::Id id,
     const Dimension::Type type)
 {
@@ -188,5 +133,76 @@ Dimension::Id FixedPointLayout::registerOrAssignFixedDim(const std::string name,
     return assignDim(name, type);
 }
 
+
+EptCache& EptCache::global()
+{
+    static EptCache cache;
+    return cache;
+}
+
+
+EptCache::Data EptCache::fetch(const std::string& key,
+    const std::function<std::vector<char>()>& fetchData)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return m_lru.front().data;
+        }
+    }
+
+    // Fetch without holding the lock so a slow download doesn't stall
+    // other readers.
+    Data data(new std::vector<char>(fetchData()));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (data->size() > m_maxSize)
+        return data;    // Too big to cache - hand it back uncached.
+
+    // Another thread may have fetched the same key in the meantime.
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return m_lru.front().data;
+    }
+
+    m_lru.push_front(Entry{key, data});
+    m_index[key] = m_lru.begin();
+    m_size += data->size();
+    while (m_size > m_maxSize)
+    {
+        Entry& victim = m_lru.back();
+        m_size -= victim.data->size();
+        m_index.erase(victim.key);
+        m_lru.pop_back();
+    }
+    return data;
+}
+
+
+void EptCache::setMaxSize(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxSize = bytes;
+    while (m_size > m_maxSize)
+    {
+        Entry& victim = m_lru.back();
+        m_size -= victim.data->size();
+        m_index.erase(victim.key);
+        m_lru.pop_back();
+    }
+}
+
+
+uint64_t EptCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
 } // namespace pdal
 
@@ -39,6 +39,7 @@
 #include <limits>
 #include <iostream>
 #include <pdal/pdal_types.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -368,6 +369,69 @@ void GDALGrid::updateFourthQuadrant(double x, double y, double z)
 }
 
 
+void GDALGrid::merge(const GDALGrid& other)
+{
+    // This is the parallel form of the per-point accumulation done in
+    // update() -- see the links there.  Cells are independent, so grids
+    // built from disjoint subsets of the points can be combined cell by
+    // cell after the fact.
+
+    if (other.m_width != m_width || other.m_height != m_height ||
+        other.m_outputTypes != m_outputTypes)
+        throw error("Can't merge grids with different dimensions or "
+            "output types.");
+
+    for (size_t i = 0; i < m_count->size(); ++i)
+    {
+        double n2 = (*other.m_count)[i];
+        if (n2 <= 0)
+            continue;
+        double n1 = (*m_count)[i];
+        double n = n1 + n2;
+
+        if (m_min)
+            (*m_min)[i] = (std::min)((*m_min)[i], (*other.m_min)[i]);
+
+        if (m_max)
+            (*m_max)[i] = (std::max)((*m_max)[i], (*other.m_max)[i]);
+
+        if (m_mean)
+        {
+            double delta = (*other.m_mean)[i] - (*m_mean)[i];
+
+            (*m_mean)[i] += delta * n2 / n;
+            if (m_stdDev)
+                (*m_stdDev)[i] +=
+                    (*other.m_stdDev)[i] + delta * delta * n1 * n2 / n;
+        }
+
+        if (m_idw)
+        {
+            double& idw = (*m_idw)[i];
+            double& idwDist = (*m_idwDist)[i];
+
+            // A NaN distance sum means some point hit the cell center
+            // exactly and its value stands as is (see update()).
+            if (!std::isnan(idwDist))
+            {
+                if (std::isnan((*other.m_idwDist)[i]))
+                {
+                    idw = (*other.m_idw)[i];
+                    idwDist = std::numeric_limits<double>::quiet_NaN();
+                }
+                else
+                {
+                    idw += (*other.m_idw)[i];
+                    idwDist += (*other.m_idwDist)[i];
+                }
+            }
+        }
+
+        (*m_count)[i] = n;
+    }
+}
+
+
 void GDALGrid::update(size_t i, size_t j, double val, double dist)
 {
     // Once we determine that a point is close enough to a cell to count it,
@@ -433,31 +497,81 @@ void GDALGrid::update(size_t i, size_t j, double val, double dist)
     }
 }
 
-void GDALGrid::finalize()
+void GDALGrid::finalize(size_t threads)
+{
+    // Cells are independent within each phase, so the grid can be
+    // finalized in horizontal bands.  The value phase must complete
+    // before the fill phase starts, since window filling reads finalized
+    // values from neighboring (possibly out-of-band) cells; within the
+    // fill phase only empty cells are written and only occupied cells
+    // are read, so bands don't conflict.
+    if (threads < 2 || m_height < 2)
+    {
+        finalizeRows(0, m_height);
+        fillRows(0, m_height);
+        return;
+    }
+
+    threads = (std::min)(threads, m_height);
+    size_t span = (m_height + threads - 1) / threads;
+
+    ThreadPool pool(threads);
+    for (size_t t = 0; t < threads; ++t)
+    {
+        size_t jstart = t * span;
+        size_t jend = (std::min)(jstart + span, m_height);
+        pool.add([this, jstart, jend]()
+            { finalizeRows(jstart, jend); });
+    }
+    pool.await();
+    for (size_t t = 0; t < threads; ++t)
+    {
+        size_t jstart = t * span;
+        size_t jend = (std::min)(jstart + span, m_height);
+        pool.add([this, jstart, jend]()
+            { fillRows(jstart, jend); });
+    }
+    pool.join();
+    if (pool.errors().size())
+        throw error(pool.errors().front());
+}
+
+
+void GDALGrid::finalizeRows(size_t jstart, size_t jend)
 {
     // See
     // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
     // https://en.wikipedia.org/wiki/Inverse_distance_weighting
+    size_t start = index(0, jstart);
+    size_t end = index(0, jend);
+
     if (m_stdDev)
-        for (size_t i = 0; i < m_count->size(); ++i)
+        for (size_t i = start; i < end; ++i)
             if (!empty(i))
                 (*m_stdDev)[i] = sqrt((*m_stdDev)[i] / (*m_count)[i]);
 
     if (m_idw)
-        for (size_t i = 0; i < m_count->size(); ++i)
+        for (size_t i = start; i < end; ++i)
             if (!empty(i))
             {
                 double& distSum = (*m_idwDist)[i];
                 if (!std::isnan(distSum))
                     (*m_idw)[i] /= distSum;
             }
+}
 
-    if (m_windowSize > 0)
-        windowFill();
-    else
-        for (size_t i = 0; i < m_count->size(); ++i)
-            if (empty(i))
-                fillNodata(i);
+
+void GDALGrid::fillRows(size_t jstart, size_t jend)
+{
+    for (size_t j = jstart; j < jend; ++j)
+        for (size_t i = 0; i < width(); ++i)
+            if (empty(i, j))
+            {
+                if (m_windowSize > 0)
+                    windowFill(i, j);
+                else
+                    fillNodata(index(i, j));
+            }
 }
 
 
@@ -75,8 +75,14 @@ public:
     // Add a point to the raster grid.
     void addPoint(double x, double y, double z);
 
-    // Compute final values after all points have been added.
-    void finalize();
+    // Fold the accumulated values of another grid with the same layout
+    // into this one.  Both grids must still be accumulating -- merge
+    // before finalize().  Exported for testing.
+    PDAL_DLL void merge(const GDALGrid& other);
+
+    // Compute final values after all points have been added.  Rows are
+    // processed in parallel when more than one thread is requested.
+    void finalize(size_t threads = 1);
 
     size_t width() const
         { return m_width; }
@@ -155,15 +161,12 @@ private:
     // Fill cell at index \c i with the nondata value.
     void fillNodata(size_t i);
 
-    // Fill an empty cell with a value inverse-distance averaged from
-    // surrounding cells.
-    void windowFill()
-    {
-        for (size_t i = 0; i < width(); ++i)
-            for (size_t j = 0; j < height(); ++j)
-                if (empty(i, j))
-                    windowFill(i, j);
-    }
+    // Finalize stdev/idw values for cells in rows [jstart, jend).
+    void finalizeRows(size_t jstart, size_t jend);
+
+    // Fill empty cells in rows [jstart, jend), either window-filling from
+    // neighboring cells or writing the nodata value.
+    void fillRows(size_t jstart, size_t jend);
 
     // Fill empty cell at dstI, dstJ with inverse-distance weighted values
     // from neighboring cells.
@@ -0,0 +1,275 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "BenchKernel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include <pdal/Options.hpp>
+#include <pdal/PDALUtils.hpp>
+#include <pdal/PipelineManager.hpp>
+#include <pdal/Stage.hpp>
+#include <pdal/pdal_config.hpp>
+#include <pdal/util/Bounds.hpp>
+#include <pdal/util/FileUtils.hpp>
+
+namespace pdal
+{
+
+static StaticPluginInfo const s_info
+{
+    "kernels.bench",
+    "Bench Kernel",
+    "http://pdal.io/apps/bench.html"
+};
+
+CREATE_STATIC_KERNEL(BenchKernel, s_info)
+
+std::string BenchKernel::getName() const
+{
+    return s_info.name;
+}
+
+
+namespace
+{
+
+// Bump whenever fixture generation changes so that reports from
+// different fixture contents are never compared against each other.
+const int FixtureVersion = 1;
+
+// A UTM-sized extent so the reprojection benchmark does meaningful work
+// and LAS scaling matches real data.
+const BOX3D FixtureBounds(555000, 4180000, 0, 556000, 4181000, 120);
+const std::string FixtureSrs("EPSG:32610");
+
+const StringList Benchmarks { "translate", "reprojection", "ground", "tile" };
+
+} // unnamed namespace
+
+
+void BenchKernel::addSwitches(ProgramArgs& args)
+{
+    args.add("benchmark", "Benchmark to run - repeat for several; one of "
+        "'translate', 'reprojection', 'ground', 'tile' [default: all]",
+        m_benchmarks);
+    args.add("points", "Number of points in the synthetic fixture",
+        m_points, (point_count_t)1000000);
+    args.add("directory", "Directory holding fixtures and benchmark output",
+        m_directory, "pdal_bench");
+    args.add("output,o", "Report output filename [default: stdout]",
+        m_outputFile);
+    args.add("runs", "Number of times each benchmark is run", m_runs,
+        (size_t)1);
+    args.add("keep", "Keep benchmark output files", m_keep);
+}
+
+
+void BenchKernel::validateSwitches(ProgramArgs& args)
+{
+    if (m_benchmarks.empty())
+        m_benchmarks = Benchmarks;
+    for (std::string& b : m_benchmarks)
+    {
+        b = Utils::tolower(b);
+        if (std::find(Benchmarks.begin(), Benchmarks.end(), b) ==
+                Benchmarks.end())
+            throw pdal_error("Unknown benchmark '" + b + "'.");
+    }
+    if (!m_points)
+        throw pdal_error("--points must be positive.");
+    if (!m_runs)
+        throw pdal_error("--runs must be positive.");
+}
+
+
+std::string BenchKernel::fixturePath() const
+{
+    std::string ext = Config::hasFeature(Config::Feature::LAZPERF) ?
+        ".laz" : ".las";
+    return m_directory + "/fixture_v" + std::to_string(FixtureVersion) +
+        "_" + std::to_string(m_points) + ext;
+}
+
+
+// Generate the synthetic fixture the benchmarks read.  The fixture is
+// versioned by generation scheme and point count and is left in place, so
+// repeated qualification runs measure against identical input.
+void BenchKernel::makeFixture()
+{
+    if (FileUtils::fileExists(fixturePath()))
+    {
+        m_log->get(LogLevel::Info) << "Using existing fixture '" <<
+            fixturePath() << "'.\n";
+        return;
+    }
+
+    Options readerOptions;
+    readerOptions.add("mode", "uniform");
+    readerOptions.add("bounds", FixtureBounds);
+    readerOptions.add("count", m_points);
+
+    Options writerOptions;
+    writerOptions.add("a_srs", FixtureSrs);
+    if (Config::hasFeature(Config::Feature::LAZPERF))
+        writerOptions.add("compression", "lazperf");
+
+    PipelineManager mgr;
+    Stage& reader = mgr.makeReader("", "readers.faux", readerOptions);
+    mgr.makeWriter(fixturePath(), "writers.las", reader, writerOptions);
+    if (mgr.execute(ExecMode::PreferStream).m_mode == ExecMode::None)
+        throw pdal_error("Couldn't generate fixture '" + fixturePath() +
+            "'.");
+}
+
+
+void BenchKernel::buildBenchmark(PipelineManager& mgr,
+    const std::string& name)
+{
+    Stage& reader = mgr.makeReader(fixturePath(), "readers.las");
+
+    if (name == "translate")
+    {
+        Options writerOptions;
+        std::string ext = ".las";
+        if (Config::hasFeature(Config::Feature::LAZPERF))
+        {
+            writerOptions.add("compression", "lazperf");
+            ext = ".laz";
+        }
+        mgr.makeWriter(m_directory + "/bench_translate" + ext,
+            "writers.las", reader, writerOptions);
+    }
+    else if (name == "reprojection")
+    {
+        Options filterOptions;
+        filterOptions.add("out_srs", "EPSG:4326");
+        Stage& reproj = mgr.makeFilter("filters.reprojection", reader,
+            filterOptions);
+        mgr.makeWriter("", "writers.null", reproj);
+    }
+    else if (name == "ground")
+    {
+        Stage& ground = mgr.makeFilter("filters.smrf", reader);
+        Stage& hag = mgr.makeFilter("filters.hag_nn", ground);
+        mgr.makeWriter("", "writers.null", hag);
+    }
+    else if (name == "tile")
+    {
+        Options filterOptions;
+        filterOptions.add("length", 100);
+        Stage& splitter = mgr.makeFilter("filters.splitter", reader,
+            filterOptions);
+        mgr.makeWriter(m_directory + "/bench_tile_#.las", "writers.las",
+            splitter);
+    }
+}
+
+
+MetadataNode BenchKernel::runBenchmark(const std::string& name, size_t run)
+{
+    PipelineManager mgr;
+    buildBenchmark(mgr, name);
+
+    auto start = std::chrono::steady_clock::now();
+    PipelineManager::ExecResult result = mgr.execute(ExecMode::PreferStream);
+    double secs = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    if (result.m_mode == ExecMode::None)
+        throw pdal_error("Couldn't run benchmark '" + name + "'.");
+
+    uint64_t peakRss = 0;
+    for (Stage *s : mgr.stages())
+        peakRss = (std::max)(peakRss, s->metrics().m_peakRss);
+
+    MetadataNode node("run");
+    node.add("benchmark", name);
+    node.add("run", run);
+    node.add("mode", result.m_mode == ExecMode::Stream ?
+        "stream" : "standard");
+    node.add("points", result.m_count);
+    node.add("wall_seconds", secs);
+    node.add("points_per_second", secs > 0.0 ? result.m_count / secs : 0.0);
+    node.add("peak_rss", peakRss);
+    node.add(mgr.getMetrics());
+
+    if (!m_keep)
+        deleteOutputs();
+    return node;
+}
+
+
+void BenchKernel::deleteOutputs()
+{
+    for (const std::string& file : FileUtils::glob(m_directory + "/bench_*"))
+        FileUtils::deleteFile(file);
+}
+
+
+int BenchKernel::execute()
+{
+    if (!FileUtils::directoryExists(m_directory))
+        if (!FileUtils::createDirectory(m_directory))
+            throw pdal_error("Can't create directory '" + m_directory +
+                "'.");
+
+    makeFixture();
+
+    MetadataNode root("bench");
+    root.add("pdal_version", Config::fullVersionString());
+    root.add("fixture_version", FixtureVersion);
+    root.add("fixture", fixturePath());
+    root.add("points", m_points);
+
+    for (const std::string& name : m_benchmarks)
+        for (size_t run = 1; run <= m_runs; ++run)
+            root.addList(runBenchmark(name, run));
+
+    if (m_outputFile.size())
+    {
+        std::ostream *out = Utils::createFile(m_outputFile, false);
+        if (!out)
+            throw pdal_error("Can't open file '" + m_outputFile +
+                "' for report output.");
+        Utils::toJSON(root, *out);
+        Utils::closeFile(out);
+    }
+    else
+        Utils::toJSON(root, std::cout);
+    return 0;
+}
+
+} // namespace pdal
@@ -65,6 +65,30 @@ void DeltaKernel::addSwitches(ProgramArgs& args)
     args.add("detail", "Output deltas per-point", m_detail);
     args.add("alldims", "Compute diffs for all dimensions (not just X,Y,Z)",
         m_allDims);
+    args.add("threads", "Number of threads used for neighbor searches "
+        "(0 = automatic)", m_threads);
+}
+
+
+// Nearest candidate for each source point.  The batch query reorders
+// the source points along a Morton curve for tree locality and runs
+// across threads; the result is identical at any thread count.
+PointIdList DeltaKernel::nearestNeighbors(PointViewPtr& srcView,
+    KD3Index& index)
+{
+    point_count_t np = srcView->size();
+    std::vector<double> pts(np * 3);
+    for (PointId id = 0; id < np; ++id)
+    {
+        pts[3 * id] = srcView->getFieldAs<double>(Dimension::Id::X, id);
+        pts[3 * id + 1] = srcView->getFieldAs<double>(Dimension::Id::Y, id);
+        pts[3 * id + 2] = srcView->getFieldAs<double>(Dimension::Id::Z, id);
+    }
+
+    PointIdList candIds;
+    if (index.neighborsBatch(pts, 1, candIds, nullptr, m_threads) == 0)
+        candIds.assign(np, 0);
+    return candIds;
 }
 
 
@@ -145,10 +169,10 @@ MetadataNode DeltaKernel::dump(PointViewPtr& srcView, PointViewPtr& candView,
 {
     MetadataNode root;
 
+    PointIdList candIds = nearestNeighbors(srcView, index);
     for (PointId id = 0; id < srcView->size(); ++id)
     {
-        PointRef point = srcView->point(id);
-        PointId candId = index.neighbor(point);
+        PointId candId = candIds[id];
 
         // It may be faster to put in a special case to avoid having to
         // fetch X, Y and Z, more than once but this is simpler and
@@ -191,10 +215,10 @@ MetadataNode DeltaKernel::dumpDetail(PointViewPtr& srcView,
 {
     MetadataNode root;
 
+    PointIdList candIds = nearestNeighbors(srcView, index);
     for (PointId id = 0; id < srcView->size(); ++id)
     {
-        PointRef point = srcView->point(id);
-        PointId candId = index.neighbor(point);
+        PointId candId = candIds[id];
 
         MetadataNode delta = root.add("delta");
         delta.add("i", id);
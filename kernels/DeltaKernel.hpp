@@ -72,6 +72,7 @@ public:
 private:
     void addSwitches(ProgramArgs& args);
     PointViewPtr loadSet(const std::string& filename, PointTable& table);
+    PointIdList nearestNeighbors(PointViewPtr& srcView, KD3Index& index);
     MetadataNode dump(PointViewPtr& srcView, PointViewPtr& candView,
         KD3Index& index, DimIndexMap& dims);
     MetadataNode dumpDetail(PointViewPtr& srcView, PointViewPtr& candView,
@@ -80,6 +81,7 @@ private:
 
     std::string m_sourceFile;
     std::string m_candidateFile;
+    size_t m_threads;
 
     /**
     std::ostream* m_outputStream;
@@ -0,0 +1,325 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "DistributeKernel.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include <pdal/QuickInfo.hpp>
+#include <pdal/Stage.hpp>
+#include <pdal/util/FileUtils.hpp>
+#include <pdal/util/ThreadPool.hpp>
+#include <pdal/util/Utils.hpp>
+
+namespace pdal
+{
+
+static StaticPluginInfo const s_info
+{
+    "kernels.distribute",
+    "Distribute Kernel",
+    "http://pdal.io/apps/distribute.html"
+};
+
+CREATE_STATIC_KERNEL(DistributeKernel, s_info)
+
+std::string DistributeKernel::getName() const
+{
+    return s_info.name;
+}
+
+
+void DistributeKernel::addSwitches(ProgramArgs& args)
+{
+    args.add("pipeline", "Pipeline JSON executed for each partition",
+        m_pipelineFile).setPositional();
+    args.add("input,i", "Input filename - repeat for one partition per "
+        "file, or give one file with --length for spatial partitioning",
+        m_inputFiles);
+    args.add("output,o", "Output filename; the partition number is "
+        "inserted before the extension", m_outputFile);
+    args.add("length", "Edge length for spatial partition cells", m_length,
+        0.0);
+    args.add("buffer", "Halo distance added around each spatial partition "
+        "so neighborhood filters see points beyond the cell edge", m_buffer,
+        0.0);
+    args.add("workers", "Number of partitions run concurrently "
+        "[default: hardware]", m_workers, (size_t)0);
+    args.add("launcher", "Command prefixed to each worker invocation "
+        "(e.g. a cluster submit command) [default: run locally]",
+        m_launcher);
+    args.add("pdal", "Path to the pdal executable used for workers",
+        m_pdalPath, "pdal");
+    args.add("metadata", "Merged metadata output filename", m_metadataFile);
+}
+
+
+void DistributeKernel::validateSwitches(ProgramArgs& args)
+{
+    if (m_inputFiles.empty())
+        throw pdal_error("No input specified.");
+    if (m_outputFile.empty())
+        throw pdal_error("No output specified.");
+    if (m_inputFiles.size() > 1 && m_length)
+        throw pdal_error("Can't use spatial partitioning (--length) with "
+            "multiple input files.");
+    if (m_inputFiles.size() == 1 && !m_length)
+        throw pdal_error("A single input needs --length for spatial "
+            "partitioning.");
+    if (m_buffer && !m_length)
+        throw pdal_error("--buffer requires spatial partitioning "
+            "(--length).");
+    if (!m_workers)
+        m_workers = (std::max)(std::thread::hardware_concurrency(), 1u);
+}
+
+
+namespace
+{
+
+std::string makeFilename(const std::string& s, int i)
+{
+    std::string out = s;
+    auto pos = out.find_last_of('.');
+    if (pos == out.npos)
+        pos = out.length();
+    out.insert(pos, std::string("_") + std::to_string(i));
+    return out;
+}
+
+std::string quote(const std::string& s)
+{
+    return "\"" + s + "\"";
+}
+
+std::string boundsString(double minx, double miny, double maxx, double maxy)
+{
+    std::ostringstream oss;
+    oss << std::setprecision(15) << "([" << minx << "," << maxx << "],[" <<
+        miny << "," << maxy << "])";
+    return oss.str();
+}
+
+} // unnamed namespace
+
+
+std::string DistributeKernel::partitionOutput(int id) const
+{
+    return makeFilename(m_outputFile, id);
+}
+
+
+std::string DistributeKernel::partitionMetadata(int id) const
+{
+    return makeFilename(m_metadataFile, id);
+}
+
+
+std::vector<DistributeKernel::Partition>
+DistributeKernel::makeFilePartitions()
+{
+    std::vector<Partition> partitions;
+
+    int id = 1;
+    for (const std::string& file : m_inputFiles)
+    {
+        Partition p { id++, {} };
+        p.m_substitutions.push_back("--stage.reader.filename=" +
+            quote(file));
+        partitions.push_back(p);
+    }
+    return partitions;
+}
+
+
+std::vector<DistributeKernel::Partition>
+DistributeKernel::makeSpatialPartitions()
+{
+    Stage& reader = makeReader(m_inputFiles[0], m_driverOverride);
+    QuickInfo qi = reader.preview();
+    if (!qi.valid() || !qi.m_bounds.valid())
+        throw pdal_error("Can't determine bounds of '" + m_inputFiles[0] +
+            "' for spatial partitioning.");
+    BOX3D bounds = qi.m_bounds;
+
+    int cols = (int)std::ceil((bounds.maxx - bounds.minx) / m_length);
+    int rows = (int)std::ceil((bounds.maxy - bounds.miny) / m_length);
+    cols = (std::max)(cols, 1);
+    rows = (std::max)(rows, 1);
+    if ((int64_t)cols * rows > 100000)
+        throw pdal_error("Partition length yields more than 100000 "
+            "partitions.");
+
+    std::vector<Partition> partitions;
+    int id = 1;
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c)
+        {
+            double minx = bounds.minx + c * m_length;
+            double miny = bounds.miny + r * m_length;
+            double maxx = (std::min)(minx + m_length, bounds.maxx);
+            double maxy = (std::min)(miny + m_length, bounds.maxy);
+
+            Partition p { id++, {} };
+            p.m_substitutions.push_back("--stage.reader.filename=" +
+                quote(m_inputFiles[0]));
+            // The reader sees the cell grown by the halo; a crop stage
+            // tagged 'clip' - when the pipeline has one - gets the exact
+            // cell, so halo points feed neighborhood filters but don't
+            // land in the output.
+            p.m_substitutions.push_back("--stage.reader.bounds=" +
+                quote(boundsString(minx - m_buffer, miny - m_buffer,
+                    maxx + m_buffer, maxy + m_buffer)));
+            if (m_buffer)
+                p.m_substitutions.push_back("--stage.clip.bounds=" +
+                    quote(boundsString(minx, miny, maxx, maxy)));
+            partitions.push_back(p);
+        }
+    return partitions;
+}
+
+
+std::vector<DistributeKernel::Partition> DistributeKernel::makePartitions()
+{
+    std::vector<Partition> partitions = m_length ?
+        makeSpatialPartitions() : makeFilePartitions();
+
+    for (Partition& p : partitions)
+    {
+        p.m_substitutions.push_back("--stage.writer.filename=" +
+            quote(partitionOutput(p.m_id)));
+        if (m_metadataFile.size())
+        {
+            p.m_substitutions.push_back("--metadata");
+            p.m_substitutions.push_back(quote(partitionMetadata(p.m_id)));
+        }
+    }
+    return partitions;
+}
+
+
+std::string DistributeKernel::partitionCommand(const Partition& p) const
+{
+    std::string cmd;
+    if (m_launcher.size())
+        cmd += m_launcher + " ";
+    cmd += quote(m_pdalPath) + " pipeline " + quote(m_pipelineFile);
+    for (const std::string& s : p.m_substitutions)
+        cmd += " " + s;
+    return cmd;
+}
+
+
+void DistributeKernel::mergeMetadata(
+    const std::vector<Partition>& partitions) const
+{
+    NL::json root = NL::json::array();
+    for (const Partition& p : partitions)
+    {
+        std::string file = partitionMetadata(p.m_id);
+        std::ifstream in(file);
+        NL::json meta = NL::json::parse(in, nullptr, false);
+
+        NL::json entry;
+        entry["partition"] = p.m_id;
+        entry["output"] = partitionOutput(p.m_id);
+        if (!meta.is_discarded())
+            entry["metadata"] = meta;
+        root.push_back(entry);
+        in.close();
+        FileUtils::deleteFile(file);
+    }
+
+    std::ostream *out = FileUtils::createFile(m_metadataFile, false);
+    if (!out)
+        throw pdal_error("Can't open file '" + m_metadataFile +
+            "' for metadata output.");
+    *out << root.dump(4) << "\n";
+    FileUtils::closeFile(out);
+}
+
+
+int DistributeKernel::execute()
+{
+    std::vector<Partition> partitions = makePartitions();
+
+    // Run the partitions as worker processes, a bounded number at a time.
+    // Each failure is reported with the worker's output; the remaining
+    // partitions still run so a single bad tile doesn't waste the batch.
+    std::mutex mutex;
+    StringList failures;
+    ThreadPool pool(m_workers);
+    for (const Partition& p : partitions)
+    {
+        std::string cmd = partitionCommand(p);
+        int id = p.m_id;
+        pool.add([this, cmd, id, &mutex, &failures]()
+        {
+            std::string output;
+            int status = Utils::run_shell_command(cmd, output);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            m_log->get(LogLevel::Debug) << "Partition " << id << ": " <<
+                cmd << "\n";
+            if (status)
+                failures.push_back("Partition " + std::to_string(id) +
+                    " failed (status " + std::to_string(status) + "): " +
+                    output);
+        });
+    }
+    pool.join();
+
+    if (m_metadataFile.size())
+        mergeMetadata(partitions);
+
+    if (failures.size())
+    {
+        std::string all;
+        for (const std::string& f : failures)
+            all += f + "\n";
+        throw pdal_error(std::to_string(failures.size()) + " of " +
+            std::to_string(partitions.size()) + " partitions failed:\n" +
+            all);
+    }
+    return 0;
+}
+
+} // namespace pdal
@@ -0,0 +1,79 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <pdal/Kernel.hpp>
+#include <pdal/util/Bounds.hpp>
+
+namespace pdal
+{
+
+class PDAL_DLL DistributeKernel : public Kernel
+{
+    // One worker invocation: partition number plus the option
+    // substitutions that specialize the shared pipeline for it.
+    struct Partition
+    {
+        int m_id;
+        StringList m_substitutions;
+    };
+
+public:
+    std::string getName() const;
+    int execute();
+
+private:
+    void addSwitches(ProgramArgs& args);
+    void validateSwitches(ProgramArgs& args);
+    std::vector<Partition> makePartitions();
+    std::vector<Partition> makeFilePartitions();
+    std::vector<Partition> makeSpatialPartitions();
+    std::string partitionCommand(const Partition& p) const;
+    std::string partitionOutput(int id) const;
+    std::string partitionMetadata(int id) const;
+    void mergeMetadata(const std::vector<Partition>& partitions) const;
+
+    std::string m_pipelineFile;
+    StringList m_inputFiles;
+    std::string m_outputFile;
+    double m_length;
+    double m_buffer;
+    size_t m_workers;
+    std::string m_launcher;
+    std::string m_pdalPath;
+    std::string m_metadataFile;
+};
+
+} // namespace pdal
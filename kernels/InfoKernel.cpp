@@ -43,6 +43,7 @@
 #include <pdal/KDIndex.hpp>
 #include <pdal/PipelineWriter.hpp>
 #include <pdal/PDALUtils.hpp>
+#include <pdal/Reader.hpp>
 #include <pdal/StageFactory.hpp>
 
 namespace pdal
@@ -185,10 +186,35 @@ MetadataNode InfoKernel::dumpSummary(const QuickInfo& qi)
     return summary;
 }
 
+// Build the summary node from a streamed read, shaped like
+// dumpSummary() so consumers see the same keys either way.
+MetadataNode InfoKernel::dumpStreamedSummary()
+{
+    MetadataNode summary;
+    MetadataNode info = m_infoStage->getMetadata();
+
+    MetadataNode n = info.findChild("num_points");
+    if (n)
+        summary.add(n);
+    n = info.findChild("srs");
+    if (n)
+        summary.add(n);
+    n = info.findChild("bbox");
+    if (n)
+        summary.add(n.clone("bounds"));
+    n = info.findChild("dimensions");
+    if (n)
+        summary.add(n);
+    return summary;
+}
+
+
 void InfoKernel::makeReader(const std::string& filename)
 {
     Options rOps;
-    if (!m_needPoints)
+    // A summary prefers the header-only preview() and reads points only
+    // when it has to fall back, so don't clamp its count.
+    if (!m_needPoints && !m_showSummary)
         rOps.add("count", 0);
     m_reader = &(m_manager.makeReader(filename, m_driverOverride, rOps));
 }
@@ -221,6 +247,56 @@ void InfoKernel::makePipeline()
 }
 
 
+// When dumping specific points is the only reason we're reading, a
+// reader that can seek (see Reader::resumable()) need only produce the
+// span between the lowest and highest requested ids rather than the
+// whole file.  Must run after the pipeline is prepared - a reader
+// typically can't report resumable() until it has seen its header - and
+// before it's made ready.
+void InfoKernel::pushPointWindow()
+{
+    if (m_pointIndexes.empty() || m_queryPoint.size() || m_showStats ||
+            m_boundary || m_showMetadata)
+        return;
+
+    Reader *reader = dynamic_cast<Reader *>(m_reader);
+    if (!reader)
+        return;
+
+    // Find the extremes of the requested ids.  Parsing is best-effort -
+    // a malformed spec is left for filters.info to diagnose.
+    PointId low = (std::numeric_limits<PointId>::max)();
+    PointId high = 0;
+    for (std::string& range : Utils::split2(m_pointIndexes, ','))
+        for (std::string& tok : Utils::split(range, '-'))
+        {
+            Utils::trim(tok);
+            uint32_t id;
+            if (!Utils::fromString(tok, id))
+                return;
+            low = (std::min)(low, (PointId)id);
+            high = (std::max)(high, (PointId)id);
+        }
+    if (low > high)
+        return;
+
+    if (reader->resumable())
+        reader->resumeAt(low);
+    else
+        low = 0;
+
+    // Stop the read after the last requested point.  The option is
+    // picked up when the pipeline is prepared for execution.
+    Options countOps;
+    countOps.add("count", high - low + 1);
+    reader->addOptions(countOps);
+
+    // The filter sees points starting at 'low'; keep its reported
+    // PointIds absolute.
+    dynamic_cast<InfoFilter *>(m_infoStage)->startAt(low);
+}
+
+
 MetadataNode InfoKernel::run(const std::string& filename)
 {
     MetadataNode root;
@@ -229,16 +305,31 @@ MetadataNode InfoKernel::run(const std::string& filename)
     if (m_showSummary)
     {
         QuickInfo qi = m_manager.getStage()->preview();
-        if (!qi.valid())
-            throw pdal_error("No summary data available for '" +
-                filename + "'.");
-        root.add(dumpSummary(qi).clone("summary"));
+        if (qi.valid())
+            root.add(dumpSummary(qi).clone("summary"));
+        else
+        {
+            // The reader can't answer from its header alone, so stream
+            // the points through filters.info instead of giving up.
+            makePipeline();
+            m_manager.execute(ExecMode::PreferStream);
+            root.add(dumpStreamedSummary().clone("summary"));
+        }
     }
     else
     {
         makePipeline();
         if (m_needPoints || m_showMetadata)
+        {
+            if (m_pointIndexes.size())
+            {
+                // Let the reader see its header so it can report
+                // whether it can seek to the requested points.
+                m_manager.prepare();
+                pushPointWindow();
+            }
             m_manager.execute(ExecMode::PreferStream);
+        }
         else
             m_manager.prepare();
         dump(root);
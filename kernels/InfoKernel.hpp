@@ -67,8 +67,10 @@ private:
     void validateSwitches(ProgramArgs& args);
     void makeReader(const std::string& filename);
     void makePipeline();
+    void pushPointWindow();
     void dump(MetadataNode& root);
     MetadataNode dumpSummary(const QuickInfo& qi);
+    MetadataNode dumpStreamedSummary();
 
     std::string m_inputFile;
     bool m_showStats;
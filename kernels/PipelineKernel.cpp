@@ -106,6 +106,9 @@ void PipelineKernel::addSwitches(ProgramArgs& args)
         m_stream);
     args.add("nostream", "Run in standard mode.", m_noStream);
     args.add("metadata", "Metadata filename", m_metadataFile);
+    args.add("metrics", "Per-stage execution metrics (wall time, "
+        "points/sec, peak RSS, point-table growth) output filename",
+        m_metricsFile);
 }
 
 
@@ -156,6 +159,15 @@ int PipelineKernel::execute()
         Utils::toJSON(m_manager.getMetadata(), *out);
         Utils::closeFile(out);
     }
+    if (m_metricsFile.size())
+    {
+        std::ostream *out = Utils::createFile(m_metricsFile, false);
+        if (!out)
+            throw pdal_error("Can't open file '" + m_metricsFile +
+                "' for metrics output.");
+        Utils::toJSON(m_manager.getMetrics(), *out);
+        Utils::closeFile(out);
+    }
     if (m_pipelineFile.size())
         PipelineWriter::writePipeline(m_manager.getStage(), m_pipelineFile);
 
@@ -57,6 +57,7 @@ private:
     std::string m_inputFile;
     std::string m_pipelineFile;
     std::string m_metadataFile;
+    std::string m_metricsFile;
     bool m_validate;
     std::string m_PointCloudSchemaOutput;
     std::string m_progressFile;
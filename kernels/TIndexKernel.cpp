@@ -34,7 +34,9 @@
 
 #include "TIndexKernel.hpp"
 
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include <pdal/GDALUtils.hpp>
@@ -114,6 +116,8 @@ void TIndexKernel::addSubSwitches(ProgramArgs& args,
             "Write absolute rather than relative file paths", m_absPath);
         args.add("stdin,s", "Read filespec pattern from standard input",
             m_usestdin);
+        args.add("threads", "Number of threads used to read file "
+            "boundary/SRS info", m_threads, (size_t)1);
     }
     else if (subcommand == "merge")
     {
@@ -269,25 +273,64 @@ void TIndexKernel::createFile()
 
     FieldIndexes indexes = getFields();
 
-    size_t filecount(0);
-    StageFactory factory(false);
+    StringList paths;
+    paths.reserve(m_files.size());
     for (auto f : m_files)
-    {
         //ABELL - Not sure why we need to get absolute path here.
-        f = FileUtils::toAbsolutePath(f);
-        FileInfo info;
-        if (getFileInfo(factory, f, info))
+        paths.push_back(FileUtils::toAbsolutePath(f));
+
+    // Boundary/SRS extraction is independent per file, so fan it out.
+    // Feature writes stay on this thread - OGR layers aren't safe for
+    // concurrent writes - and run in input order, so the index comes
+    // out the same regardless of thread count.
+    std::vector<FileInfo> infos(paths.size());
+    std::vector<char> infoOk(paths.size(), false);
+    std::atomic<size_t> nextFile(0);
+
+    auto worker = [this, &paths, &infos, &infoOk, &nextFile]()
+    {
+        StageFactory factory(false);
+        while (true)
         {
-            filecount++;
-            if (!isFileIndexed(indexes, info))
-            {
-                if (createFeature(indexes, info))
-                    m_log->get(LogLevel::Info) << "Indexed file " << f <<
-                    std::endl;
-                else
-                    m_log->get(LogLevel::Error) << "Failed to create feature "
-                        "for file '" << f << "'" << std::endl;
-            }
+            size_t i = nextFile++;
+            if (i >= paths.size())
+                break;
+            infoOk[i] = getFileInfo(factory, paths[i], infos[i]);
+        }
+    };
+
+    size_t threads = (std::min)((std::max)(m_threads, (size_t)1),
+        paths.size());
+    if (threads == 1)
+        worker();
+    else
+    {
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t)
+            pool.emplace_back(worker);
+        for (auto& t : pool)
+            t.join();
+    }
+
+    size_t filecount(0);
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        const std::string& f = paths[i];
+        if (!infoOk[i])
+        {
+            m_log->get(LogLevel::Error) << "Skipping file '" << f <<
+                "': can't compute boundary." << std::endl;
+            continue;
+        }
+        filecount++;
+        if (!isFileIndexed(indexes, infos[i]))
+        {
+            if (createFeature(indexes, infos[i]))
+                m_log->get(LogLevel::Info) << "Indexed file " << f <<
+                std::endl;
+            else
+                m_log->get(LogLevel::Error) << "Failed to create feature "
+                    "for file '" << f << "'" << std::endl;
         }
     }
     if (!filecount)
@@ -554,12 +597,10 @@ bool TIndexKernel::getFileInfo(StageFactory& factory,
     {
         fast = true;
     }
+    // May run off the main thread; the failure is logged by the caller
+    // during the serial commit pass.
     if (fast && !fastBoundary(reader, fileInfo))
-    {
-        m_log->get(LogLevel::Error) << "Skipping file '" << filename <<
-            "': can't compute boundary." << std::endl;
         return false;
-    }
     FileUtils::fileTimes(filename, &fileInfo.m_ctime, &fileInfo.m_mtime);
     fileInfo.m_filename = filename;
 
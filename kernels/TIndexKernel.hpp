@@ -116,6 +116,7 @@ private:
     bool m_fastBoundary;
     bool m_usestdin;
     bool m_overrideASrs;
+    size_t m_threads;
 };
 
 } // namespace pdal
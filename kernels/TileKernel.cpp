@@ -34,6 +34,10 @@
 
 #include "TileKernel.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include <pdal/StageFactory.hpp>
 #include <pdal/StageWrapper.hpp>
 #include <pdal/Writer.hpp>
@@ -75,6 +79,8 @@ void TileKernel::addSwitches(ProgramArgs& args)
         m_buffer);
     args.add("out_srs", "Output SRS to which points will be reprojected",
         m_outSrs);
+    args.add("threads", "Number of threads used to write tiles", m_threads,
+        (size_t)1);
 }
 
 
@@ -209,8 +215,7 @@ void TileKernel::process(const Readers& readers)
     {
         Streamable& r = *(rp.second);
         std::vector<bool> skips(m_table.capacity());
-        PointId idx(0);
-        PointRef point(m_table, idx);
+        PointRef point(m_table, 0);
 
         StreamableWrapper::ready(r, m_table);
         if (m_repro)
@@ -218,8 +223,7 @@ void TileKernel::process(const Readers& readers)
                 r.getSpatialReference());
 
         // Read first point.
-        bool finished(false);
-        finished = !StreamableWrapper::processOne(r, point);
+        bool finished = !StreamableWrapper::processOne(r, point);
         if (!haveOrigin && !finished)
         {
             if (std::isnan(m_xOrigin))
@@ -230,19 +234,18 @@ void TileKernel::process(const Readers& readers)
             haveOrigin = true;
         }
 
-        idx++;
-        while (!finished)
+        PointId count = finished ? 0 : 1;
+        while (!finished || count)
         {
-            // Read subsequent points.
-            while (true)
+            // Fill the table with subsequent points.
+            while (!finished && count < m_table.capacity())
             {
-                point.setPointId(idx);
-                finished = !StreamableWrapper::processOne(r, point);
-                idx++;
-                if (idx == m_table.capacity() || finished)
-                    break;
+                point.setPointId(count);
+                if (!StreamableWrapper::processOne(r, point))
+                    finished = true;
+                else
+                    count++;
             }
-            PointId last = idx - 1;
 
             SpatialReference srs = r.getSpatialReference();
             if (!srs.empty())
@@ -250,30 +253,30 @@ void TileKernel::process(const Readers& readers)
             // Reproject if necessary.
             if (m_repro)
             {
-                for (idx = 0; idx < last; ++idx)
+                for (PointId idx = 0; idx < count; ++idx)
                 {
                     point.setPointId(idx);
                     if (!StreamableWrapper::processOne(*m_repro, point))
                         skips[idx] = true;
                 }
-                SpatialReference srs = r.getSpatialReference();
-                if (!srs.empty())
-                    m_table.setSpatialReference(srs);
+                if (!m_outSrs.empty())
+                    m_table.setSpatialReference(m_outSrs);
             }
 
-            // Split and write.
-            for (idx = 0; idx < last; ++idx)
+            // Assign each point to its tile buffer(s), then hand each
+            // tile's buffered run of points to its writer.
+            for (PointId idx = 0; idx < count; ++idx)
             {
                 if (skips[idx])
                     continue;
 
                 point.setPointId(idx);
                 m_splitter.processPoint(point, adder);
-
             }
-            for (size_t i = 0; i < skips.size(); ++i)
-                skips[i] = false;
-            idx = 0;
+            flushTiles(point);
+
+            std::fill(skips.begin(), skips.end(), false);
+            count = 0;
         }
         StreamableWrapper::done(r, m_table);
         if (m_repro)
@@ -284,36 +287,94 @@ void TileKernel::process(const Readers& readers)
 
 void TileKernel::adder(PointRef& point, int xpos, int ypos)
 {
-    Coord loc(xpos, ypos);
+    m_tileBuffers[Coord(xpos, ypos)].push_back(point.pointId());
+}
 
-    Stage *w;
-    Streamable *sw;
 
-    auto wi = m_writers.find(loc);
-    if (wi == m_writers.end())
+// Hand each tile's buffered points to its writer as a single run rather
+// than switching writers point by point.  The buffers hold only IDs of
+// points in the chunk being processed, so memory stays bounded by the
+// table capacity regardless of the number of active tiles.
+void TileKernel::flushTiles(PointRef& point)
+{
+    // Writer creation touches the pipeline manager, so resolve all the
+    // writers before any parallel work starts.
+    std::vector<std::pair<Streamable *, std::vector<PointId> *>> work;
+    for (auto& tb : m_tileBuffers)
+        if (tb.second.size())
+            work.emplace_back(writer(tb.first), &tb.second);
+
+    size_t threads = (std::min)((std::max)(m_threads, (size_t)1),
+        work.size());
+    if (threads <= 1)
     {
-        std::string filename(m_outputFile);
-        std::string xname(std::to_string(xpos));
-        std::string yname(std::to_string(ypos));
-        filename.replace(m_hashPos, 1, (xname + "_" + yname));
-
-        w = &m_manager.makeWriter(filename, "");
-        if (!w)
-            throw pdal_error("Couldn't create writer for output file '" +
-                m_outputFile + "'.");
-        sw = dynamic_cast<Streamable *>(w);
-        if (!sw)
-            throw pdal_error("Driver '" + w->getName() + "' for input file '" +
-                m_outputFile + "' is not streamable.");  
-        m_writers[loc] = sw;
-
-        sw->prepare(m_table);
-        StreamableWrapper::spatialReferenceChanged(*sw, m_outSrs);
-        StreamableWrapper::ready(*sw, m_table);
+        for (auto& w : work)
+        {
+            for (PointId id : *w.second)
+            {
+                point.setPointId(id);
+                StreamableWrapper::processOne(*w.first, point);
+            }
+            w.second->clear();
+        }
+        return;
     }
-    else
-        sw = wi->second;
-    StreamableWrapper::processOne(*sw, point);
+
+    // Each worker drains whole tiles with its own PointRef.  The
+    // writers are distinct stages appending to distinct files and the
+    // table is only read here, so tiles can be written concurrently.
+    // In-flight data stays bounded by the table capacity.
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([this, &work, &next]()
+        {
+            PointRef p(m_table, 0);
+            while (true)
+            {
+                size_t i = next++;
+                if (i >= work.size())
+                    break;
+                for (PointId id : *work[i].second)
+                {
+                    p.setPointId(id);
+                    StreamableWrapper::processOne(*work[i].first, p);
+                }
+                work[i].second->clear();
+            }
+        });
+    for (auto& t : pool)
+        t.join();
+}
+
+
+// Fetch the writer for a tile, creating and readying it the first time
+// the tile receives a point.
+Streamable *TileKernel::writer(const Coord& loc)
+{
+    auto wi = m_writers.find(loc);
+    if (wi != m_writers.end())
+        return wi->second;
+
+    std::string filename(m_outputFile);
+    std::string xname(std::to_string(loc.first));
+    std::string yname(std::to_string(loc.second));
+    filename.replace(m_hashPos, 1, (xname + "_" + yname));
+
+    Stage *w = &m_manager.makeWriter(filename, "");
+    if (!w)
+        throw pdal_error("Couldn't create writer for output file '" +
+            m_outputFile + "'.");
+    Streamable *sw = dynamic_cast<Streamable *>(w);
+    if (!sw)
+        throw pdal_error("Driver '" + w->getName() + "' for output file '" +
+            m_outputFile + "' is not streamable.");
+    m_writers[loc] = sw;
+
+    sw->prepare(m_table);
+    StreamableWrapper::spatialReferenceChanged(*sw, m_outSrs);
+    StreamableWrapper::ready(*sw, m_table);
+    return sw;
 }
 
 } // namespace pdal
@@ -59,6 +59,8 @@ private:
     void process(const Readers& readers);
     void checkReaders(const Readers& readers);
     void adder(PointRef& point, int xpos, int ypos);
+    void flushTiles(PointRef& point);
+    Streamable *writer(const Coord& loc);
 
     std::string m_inputFile;
     std::string m_outputFile;
@@ -67,11 +69,14 @@ private:
     double m_yOrigin;
     double m_buffer;
     std::map<Coord, Streamable *> m_writers;
+    // Per-tile buffers of point IDs for the chunk in the table.
+    std::map<Coord, std::vector<PointId>> m_tileBuffers;
     FixedPointTable m_table;
     SplitterFilter m_splitter;
     Streamable *m_repro;
     SpatialReference m_outSrs;
     std::string::size_type m_hashPos;
+    size_t m_threads;
 };
 
 } // namespace pdal
@@ -43,6 +43,9 @@
 #include <pdal/PipelineReaderJSON.hpp>
 #include <pdal/Writer.hpp>
 #include <pdal/util/FileUtils.hpp>
+#include <pdal/util/IStream.hpp>
+
+#include <io/LasHeader.hpp>
 
 #include <memory>
 #include <string>
@@ -106,6 +109,86 @@ void TranslateKernel::validateSwitches(ProgramArgs&)
 }
 
 
+/*
+  Determine whether the translation is a pure las-to-las copy - no
+  filters, no stage options, and the same point encoding on both ends -
+  and if so copy the file verbatim instead of running the pipeline.
+  Decoding and re-encoding is the bulk of the cost of archive jobs that
+  don't modify points, and LAZ chunks are expensive to rebuild.  The
+  copy preserves the source header, VLRs and (when compressed) chunk
+  table, so the chunk table offset embedded in the point data stays
+  valid.
+
+  Returns false when the fast path doesn't apply; the caller should run
+  the normal pipeline, which also produces proper diagnostics for
+  unreadable input.
+*/
+bool TranslateKernel::rawCopy()
+{
+    std::string reader(m_readerType);
+    if (reader.size() && !Utils::startsWith(reader, "readers."))
+        reader.insert(0, "readers.");
+    if (reader.empty())
+        reader = StageFactory::inferReaderDriver(m_inputFile);
+    if (reader != "readers.las")
+        return false;
+
+    std::string writer(m_writerType);
+    if (writer.size() && !Utils::startsWith(writer, "writers."))
+        writer.insert(0, "writers.");
+    if (writer.empty())
+        writer = StageFactory::inferWriterDriver(m_outputFile);
+    if (writer != "writers.las")
+        return false;
+
+    if (!FileUtils::fileExists(m_inputFile))
+        return false;
+    if (FileUtils::toAbsolutePath(m_inputFile) ==
+        FileUtils::toAbsolutePath(m_outputFile))
+        return false;
+
+    // The output is compressed exactly when writers.las would compress
+    // it with default options - the extension is ".laz" (see
+    // LasWriter::initialize()).
+    std::string ext = Utils::tolower(FileUtils::extension(m_outputFile));
+    bool wantCompressed = (ext == ".laz");
+
+    LasHeader h;
+    try
+    {
+        ILeStream in(m_inputFile);
+        if (!in.good())
+            return false;
+        in >> h;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    if (h.compressed() != wantCompressed)
+        return false;
+
+    std::istream *src = FileUtils::openFile(m_inputFile);
+    std::ostream *dst = FileUtils::createFile(m_outputFile);
+    if (!src || !dst)
+    {
+        FileUtils::closeFile(src);
+        FileUtils::closeFile(dst);
+        return false;
+    }
+    m_log->get(LogLevel::Debug) << "Input and output are identically "
+        "encoded LAS/LAZ; copying point records verbatim." << std::endl;
+    *dst << src->rdbuf();
+    bool ok = dst->good();
+    FileUtils::closeFile(src);
+    FileUtils::closeFile(dst);
+    if (!ok)
+        throw pdal_error("Couldn't write output file '" + m_outputFile +
+            "'.");
+    return true;
+}
+
+
 /*
   Build a pipeline from a JSON filter specification.
 */
@@ -196,6 +279,14 @@ int TranslateKernel::execute()
     if (m_filterJSON.size() && m_filterType.size())
         throw pdal_error("Cannot set both --filter options and --json options");
 
+    // With no filters and no stage options nothing can modify a point,
+    // so a las-to-las translation with matching compression is a
+    // verbatim copy.
+    if (m_filterJSON.empty() && m_filterType.empty() &&
+        m_metadataFile.empty() && m_pipelineOutputFile.empty() &&
+        m_manager.stageOptions().empty() && rawCopy())
+        return 0;
+
     if (m_metadataFile.size())
     {
         if (m_pipelineOutputFile.size())
@@ -57,6 +57,7 @@ private:
     virtual void validateSwitches(ProgramArgs& args);
     void makeJSONPipeline();
     void makeArgPipeline();
+    bool rawCopy();
 
     std::string m_inputFile;
     std::string m_outputFile;
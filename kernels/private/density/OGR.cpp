@@ -217,6 +217,16 @@ void OGR::writeBoundary(hexer::HexGrid *grid)
 
 void OGR::writeDensity(hexer::HexGrid *grid)
 {
+    // Write the whole batch inside one transaction - drivers like
+    // GeoPackage otherwise wrap every feature in its own implicit
+    // transaction, which dominates the write time for large grids.
+    // The layer definition and field indexes are loop invariants.
+    OGR_L_StartTransaction(m_layer);
+
+    OGRFeatureDefnH hDefn = OGR_L_GetLayerDefn(m_layer);
+    int idIdx = OGR_FD_GetFieldIndex(hDefn, "ID");
+    int countIdx = OGR_FD_GetFieldIndex(hDefn, "COUNT");
+
     int counter(0);
     for (hexer::HexIter iter = grid->hexBegin(); iter != grid->hexEnd(); ++iter)
     {
@@ -225,14 +235,12 @@ void OGR::writeDensity(hexer::HexGrid *grid)
         OGRGeometryH polygon = collectHexagon(hi, grid);
         OGRFeatureH hFeature;
 
-        hFeature = OGR_F_Create(OGR_L_GetLayerDefn(m_layer));
-        OGR_F_SetFieldInteger( hFeature, OGR_F_GetFieldIndex(hFeature, "ID"),
-            counter);
-        OGR_F_SetFieldInteger( hFeature, OGR_F_GetFieldIndex(hFeature, "COUNT"),
-            hi.m_density);
+        hFeature = OGR_F_Create(hDefn);
+        OGR_F_SetFieldInteger( hFeature, idIdx, counter);
+        OGR_F_SetFieldInteger( hFeature, countIdx, hi.m_density);
 
-        OGR_F_SetGeometry(hFeature, polygon);
-        OGR_G_DestroyGeometry(polygon);
+        // Hand the geometry to the feature rather than copying it.
+        OGR_F_SetGeometryDirectly(hFeature, polygon);
 
         if( OGR_L_CreateFeature( m_layer, hFeature ) != OGRERR_NONE )
         {
@@ -244,6 +252,8 @@ void OGR::writeDensity(hexer::HexGrid *grid)
         OGR_F_Destroy( hFeature );
         counter++;
     }
+
+    OGR_L_CommitTransaction(m_layer);
 }
 
 } // namespace pdal
@@ -0,0 +1,107 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/BatchTransformBackend.hpp>
+
+namespace pdal
+{
+
+namespace
+{
+
+// Built-in backend: plain loops over the coordinate arrays, written so
+// the compiler's vectorizer handles them.
+class CpuBackend : public BatchTransformBackend
+{
+public:
+    virtual std::string name() const
+        { return "cpu"; }
+
+    virtual point_count_t batchSize() const
+        { return 4096; }
+
+    virtual void transform(const double *matrix, double *x, double *y,
+        double *z, point_count_t count)
+    {
+        for (point_count_t i = 0; i < count; ++i)
+        {
+            double px = x[i];
+            double py = y[i];
+            double pz = z[i];
+
+            x[i] = px * matrix[0] + py * matrix[1] + pz * matrix[2] +
+                matrix[3];
+            y[i] = px * matrix[4] + py * matrix[5] + pz * matrix[6] +
+                matrix[7];
+            z[i] = px * matrix[8] + py * matrix[9] + pz * matrix[10] +
+                matrix[11];
+        }
+    }
+};
+
+CpuBackend& cpuBackend()
+{
+    static CpuBackend backend;
+
+    return backend;
+}
+
+std::unique_ptr<BatchTransformBackend>& installedBackend()
+{
+    static std::unique_ptr<BatchTransformBackend> backend;
+
+    return backend;
+}
+
+} // unnamed namespace
+
+
+BatchTransformBackend::~BatchTransformBackend()
+{}
+
+
+BatchTransformBackend& BatchTransformBackend::get()
+{
+    BatchTransformBackend *backend = installedBackend().get();
+
+    return backend ? *backend : cpuBackend();
+}
+
+
+void BatchTransformBackend::set(std::unique_ptr<BatchTransformBackend> backend)
+{
+    installedBackend() = std::move(backend);
+}
+
+} // namespace pdal
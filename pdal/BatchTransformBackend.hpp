@@ -0,0 +1,107 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <pdal/pdal_types.hpp>
+#include <pdal/pdal_export.hpp>
+
+namespace pdal
+{
+
+/**
+  Execution backend for per-point coordinate math that stages hand over
+  as batched coordinate arrays.  The built-in backend runs the loops on
+  the CPU; an alternative implementation (CUDA, HIP, ...) can be
+  installed with set() - typically from a dynamically loaded plugin's
+  initialization - and every stage that dispatches through the backend
+  picks it up.  Installing a backend that probes for a device and finds
+  none should be avoided; probe first and leave the default in place so
+  the CPU path keeps running without indirection surprises.
+
+  Backends operate on plain arrays of doubles, so implementations can
+  move the arrays to a device, run a kernel and copy the results back
+  without knowing anything about point tables.  Further per-point
+  operations should be added here as stages grow batched paths for them.
+*/
+class PDAL_DLL BatchTransformBackend
+{
+public:
+    virtual ~BatchTransformBackend();
+
+    /**
+      Backend name, reported in logs ("cpu", "cuda", ...).
+    */
+    virtual std::string name() const = 0;
+
+    /**
+      Number of points a caller should hand over per call.  The CPU
+      backend asks for blocks that fit in cache; device backends
+      typically want much larger transfers to amortize the copy.
+    */
+    virtual point_count_t batchSize() const = 0;
+
+    /**
+      Apply a row-major 4x4 affine matrix to count coordinate triples in
+      place.  Only the first three rows are used; the fourth is assumed
+      to be [0 0 0 1].
+
+      \param matrix  16 matrix entries, row-major.
+      \param x  X values, replaced with transformed values.
+      \param y  Y values, replaced with transformed values.
+      \param z  Z values, replaced with transformed values.
+      \param count  Number of values in each array.
+    */
+    virtual void transform(const double *matrix, double *x, double *y,
+        double *z, point_count_t count) = 0;
+
+    /**
+      Get the installed backend, or the built-in CPU backend if none has
+      been installed.
+    */
+    static BatchTransformBackend& get();
+
+    /**
+      Install a backend, replacing the current one.  Pass a null pointer
+      to restore the built-in CPU backend.  Install before pipeline
+      execution starts - the swap isn't synchronized against running
+      stages.
+    */
+    static void set(std::unique_ptr<BatchTransformBackend> backend);
+};
+
+} // namespace pdal
@@ -134,4 +134,65 @@ void DbReader::writePoint(PointView& view, PointId idx, const char *buf)
     }
 }
 
+
+/// Write a run of packed point records into a view.
+/// Equivalent to calling writePoint() for each record, but the data
+/// moves a column at a time - one batched store per dimension instead
+/// of one per field, with X, Y and Z scaled in a single pass over a
+/// double column.
+/// \param[in] view     PointView to write to.
+/// \param[in] startId  Index of the first point to write.
+/// \param[in] buf      Pointer to packed DB point data.
+/// \param[in] count    Number of points to write.
+void DbReader::writeBlock(PointView& view, PointId startId, const char *buf,
+    point_count_t count)
+{
+    using namespace Dimension;
+
+    // The batched stores require their target range to exist - append
+    // any points beyond the view's current size.
+    for (point_count_t i = 0; i < count; ++i)
+        view.getOrAddPoint(startId + i);
+
+    std::vector<double> xyz(count);
+    // Staging column sized for the widest dimension type.
+    std::vector<uint64_t> store(count);
+    char *col = reinterpret_cast<char *>(store.data());
+
+    size_t offset = 0;
+    for (auto di = m_dims.begin(); di != m_dims.end(); ++di)
+    {
+        const DimType& dim = di->m_dimType;
+        size_t size = Dimension::size(dim.m_type);
+        const char *pos = buf + offset;
+
+        if (dim.m_id == Id::X || dim.m_id == Id::Y || dim.m_id == Id::Z)
+        {
+            double scale = dim.m_xform.m_scale.m_val;
+            double shift = dim.m_xform.m_offset.m_val;
+            for (point_count_t i = 0; i < count; ++i)
+            {
+                Everything e;
+
+                memcpy(&e, pos, size);
+                xyz[i] = (Utils::toDouble(e, dim.m_type) * scale) + shift;
+                pos += m_packedPointSize;
+            }
+            view.setFieldBatch(dim.m_id, startId, count, xyz.data());
+        }
+        else
+        {
+            char *dst = col;
+            for (point_count_t i = 0; i < count; ++i)
+            {
+                memcpy(dst, pos, size);
+                dst += size;
+                pos += m_packedPointSize;
+            }
+            view.setFieldBatch(dim.m_id, dim.m_type, startId, count, col);
+        }
+        offset += size;
+    }
+}
+
 } // namespace pdal
@@ -52,6 +52,8 @@ protected:
     void writeField(PointView& view, const char *pos, const DimType& dim,
         PointId idx);
     void writePoint(PointView& view, PointId idx, const char *buf);
+    void writeBlock(PointView& view, PointId startId, const char *buf,
+        point_count_t count);
     size_t packedPointSize() const
         { return m_packedPointSize; }
     size_t dimOffset(Dimension::Id id) const;
@@ -271,4 +271,80 @@ size_t DbWriter::readPoint(const PointView& view, PointId idx, char *outbuf)
     return m_dbPointSize;
 }
 
+
+/// Read a run of points packed into a buffer.
+/// Equivalent to calling readPoint() for each point of the range, but
+/// the view data moves a column at a time through getPackedData(); when
+/// no location scaling applies the records land in the output buffer
+/// directly.
+/// \param[in] view     PointView to read from.
+/// \param[in] startId  Index of the first point to read.
+/// \param[in] count    Number of points to read.
+/// \param[in] outbuf   Buffer to write to.  Must hold count records of
+///                     packedPointSize() bytes.
+/// \return  Number of bytes written to buffer.
+size_t DbWriter::readBlock(const PointView& view, PointId startId,
+    point_count_t count, char *outbuf)
+{
+    using namespace Dimension;
+
+    if (!m_locationScaling)
+    {
+        view.getPackedData(m_dimTypes, startId, count, outbuf);
+        return count * m_dbPointSize;
+    }
+
+    // With location scaling X, Y and Z shrink from double to int32 and
+    // sit at the end of the record, so extract full-width records to a
+    // scratch buffer, then emit each record's unchanged prefix followed
+    // by the converted coordinates.
+    std::vector<char> packed(m_packedPointSize * count);
+    view.getPackedData(m_dimTypes, startId, count, packed.data());
+
+    auto iconvert = [](const XForm& xform, Id dim,
+        const char *inpos, char *outpos)
+    {
+        double d;
+        int32_t i;
+
+        memcpy(&d, inpos, sizeof(double));
+        d = xform.toScaled(d);
+        if (!Utils::numericCast(d, i))
+        {
+            std::ostringstream oss;
+            oss << "Unable to convert double to int32 for packed DB output: ";
+            oss << Dimension::name(dim) << ": (" << d << ").";
+            throw pdal_error(oss.str());
+        }
+        memcpy(outpos, &i, sizeof(int32_t));
+    };
+
+    size_t prefixSize = m_dbPointSize;
+    if (m_xOffsets.second >= 0)
+        prefixSize = (std::min)(prefixSize, (size_t)m_xOffsets.second);
+    if (m_yOffsets.second >= 0)
+        prefixSize = (std::min)(prefixSize, (size_t)m_yOffsets.second);
+    if (m_zOffsets.second >= 0)
+        prefixSize = (std::min)(prefixSize, (size_t)m_zOffsets.second);
+
+    const char *in = packed.data();
+    char *out = outbuf;
+    for (point_count_t i = 0; i < count; ++i)
+    {
+        std::copy(in, in + prefixSize, out);
+        if (m_xOffsets.first >= 0)
+            iconvert(m_scaling.m_xXform, Id::X, in + (size_t)m_xOffsets.first,
+                out + (size_t)m_xOffsets.second);
+        if (m_yOffsets.first >= 0)
+            iconvert(m_scaling.m_yXform, Id::Y, in + (size_t)m_yOffsets.first,
+                out + (size_t)m_yOffsets.second);
+        if (m_zOffsets.first >= 0)
+            iconvert(m_scaling.m_zXform, Id::Z, in + (size_t)m_zOffsets.first,
+                out + (size_t)m_zOffsets.second);
+        in += m_packedPointSize;
+        out += m_dbPointSize;
+    }
+    return count * m_dbPointSize;
+}
+
 } // namespace pdal
@@ -58,6 +58,8 @@ protected:
     size_t readField(const PointView& view, char *pos, Dimension::Id id,
         PointId idx);
     size_t readPoint(const PointView& view, PointId idx, char *outbuf);
+    size_t readBlock(const PointView& view, PointId startId,
+        point_count_t count, char *outbuf);
     size_t packedPointSize() const
         { return m_packedPointSize; }
 
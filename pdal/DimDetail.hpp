@@ -41,23 +41,25 @@ namespace pdal
 namespace Dimension
 {
 
+// A plain 16-byte record - the layout's descriptor array is indexed by
+// dimension ordinal on every field access, and four descriptors per
+// cache line keep those lookups hot.  The size is cached when the type
+// is set so the copy loops load it rather than re-deriving it from the
+// type each time.
 class Detail
 {
 public:
-    Detail() : m_id(Id::Unknown), m_offset(-1), m_type(Type::None)
-    {}
-    //NOTE - This is strange, but for some reason things run faster with
-    // this NOOP virtual dtor.  Perhaps it has something to do with
-    // an inlining optimization or perhaps alignment (though a void * doesn't
-    // cause the same performance improvement) It may help on no machine
-    // except mine, but it doesn't hurt anything, either.
-    virtual ~Detail()
+    Detail() : m_id(Id::Unknown), m_offset(-1), m_type(Type::None),
+        m_size(0)
     {}
 
     void setOffset(int offset)
         { m_offset = offset; }
     void setType(Type type)
-        { m_type = type; }
+    {
+        m_type = type;
+        m_size = (uint32_t)Dimension::size(type);
+    }
     void setId(Id id)
         { m_id = id; }
     Id id() const
@@ -67,7 +69,7 @@ public:
     Type type() const
         { return m_type; }
     size_t size() const
-        { return Dimension::size(m_type); }
+        { return m_size; }
     BaseType base() const
         { return Dimension::base(m_type); }
 
@@ -75,6 +77,7 @@ private:
     Id m_id;
     int m_offset;
     Type m_type;
+    uint32_t m_size;
 };
 typedef std::vector<Detail> DetailList;
 
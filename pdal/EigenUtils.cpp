@@ -37,6 +37,7 @@
 #include <pdal/PointView.hpp>
 #include <pdal/SpatialReference.hpp>
 #include <pdal/util/Bounds.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/util/Utils.hpp>
 
 #include <cfloat>
@@ -49,30 +50,73 @@ namespace pdal
 #pragma warning (push)
 #pragma warning (disable: 4244)
 
+namespace
+{
+
+const point_count_t BoundsChunkSize = 4096;
+
+} // unnamed namespace
+
 void calculateBounds(const PointView& view, BOX2D& output)
 {
-    for (PointId idx = 0; idx < view.size(); idx++)
+    std::vector<double> xbuf(BoundsChunkSize);
+    std::vector<double> ybuf(BoundsChunkSize);
+    for (PointId start = 0; start < view.size(); start += BoundsChunkSize)
     {
-        double x = view.getFieldAs<double>(Dimension::Id::X, idx);
-        double y = view.getFieldAs<double>(Dimension::Id::Y, idx);
+        point_count_t cnt =
+            (std::min)(BoundsChunkSize, view.size() - start);
 
-        output.grow(x, y);
+        view.getFieldBatch(Dimension::Id::X, start, cnt, xbuf.data());
+        view.getFieldBatch(Dimension::Id::Y, start, cnt, ybuf.data());
+        output.grow(xbuf.data(), ybuf.data(), cnt);
     }
 }
 
 
 void calculateBounds(const PointView& view, BOX3D& output)
 {
-    for (PointId idx = 0; idx < view.size(); idx++)
+    std::vector<double> xbuf(BoundsChunkSize);
+    std::vector<double> ybuf(BoundsChunkSize);
+    std::vector<double> zbuf(BoundsChunkSize);
+    for (PointId start = 0; start < view.size(); start += BoundsChunkSize)
     {
-        double x = view.getFieldAs<double>(Dimension::Id::X, idx);
-        double y = view.getFieldAs<double>(Dimension::Id::Y, idx);
-        double z = view.getFieldAs<double>(Dimension::Id::Z, idx);
+        point_count_t cnt =
+            (std::min)(BoundsChunkSize, view.size() - start);
 
-        output.grow(x, y, z);
+        view.getFieldBatch(Dimension::Id::X, start, cnt, xbuf.data());
+        view.getFieldBatch(Dimension::Id::Y, start, cnt, ybuf.data());
+        view.getFieldBatch(Dimension::Id::Z, start, cnt, zbuf.data());
+        output.grow(xbuf.data(), ybuf.data(), zbuf.data(), cnt);
     }
 }
 
+
+void calculateBounds(const std::vector<PointViewPtr>& views, BOX3D& output,
+    unsigned threads)
+{
+    if (views.empty())
+        return;
+    threads = (std::min)(threads, (unsigned)views.size());
+    if (threads <= 1)
+    {
+        for (const PointViewPtr& v : views)
+            calculateBounds(*v, output);
+        return;
+    }
+
+    std::vector<BOX3D> boxes(views.size());
+    ThreadPool pool(threads, threads);
+    for (std::size_t i = 0; i < views.size(); ++i)
+        pool.add([&views, &boxes, i]()
+            { calculateBounds(*views[i], boxes[i]); });
+    pool.join();
+    if (pool.errors().size())
+        throw pdal_error("calculateBounds: " + pool.errors().front());
+
+    for (const BOX3D& b : boxes)
+        output.grow(b);
+}
+
 PointViewPtr demeanPointView(const PointView& view)
 {
     using namespace Eigen;
@@ -182,33 +226,103 @@ Eigen::Vector3d computeCentroid(const PointView& view,
     return centroid;
 }
 
-Eigen::Matrix3d computeCovariance(const PointView& view,
-    const PointIdList& ids)
+Eigen::Vector3d computeCentroid(const double* xs, const double* ys,
+    const double* zs, point_count_t n)
 {
     using namespace Eigen;
 
-    auto n = ids.size();
+    // Same incremental update as the PointView overload so that both
+    // paths compute identical centroids.
+    double mx, my, mz;
+    mx = my = mz = 0.0;
+    for (point_count_t i = 0; i < n; ++i)
+    {
+        point_count_t k = i + 1;
+        mx += (xs[i] - mx) / k;
+        my += (ys[i] - my) / k;
+        mz += (zs[i] - mz) / k;
+    }
 
-    Vector3d centroid = computeCentroid(view, ids);
+    Vector3d centroid;
+    centroid << mx, my, mz;
+
+    return centroid;
+}
 
-    // demean the neighborhood
-    MatrixXd A(3, n);
+Eigen::Matrix3d computeCovariance(const PointView& view,
+    const PointIdList& ids)
+{
+    auto n = ids.size();
+
+    // Gather the neighborhood into contiguous spans and defer to the
+    // span kernel.
+    std::vector<double> xs(n), ys(n), zs(n);
     size_t k = 0;
     for (auto const& j : ids)
     {
-        A(0, k) =
-            static_cast<float>(view.getFieldAs<double>(Dimension::Id::X, j) -
-                centroid[0]);
-        A(1, k) =
-            static_cast<float>(view.getFieldAs<double>(Dimension::Id::Y, j) -
-                centroid[1]);
-        A(2, k) =
-            static_cast<float>(view.getFieldAs<double>(Dimension::Id::Z, j) -
-                centroid[2]);
+        xs[k] = view.getFieldAs<double>(Dimension::Id::X, j);
+        ys[k] = view.getFieldAs<double>(Dimension::Id::Y, j);
+        zs[k] = view.getFieldAs<double>(Dimension::Id::Z, j);
         k++;
     }
+    return computeCovariance(xs.data(), ys.data(), zs.data(), n);
+}
+
+Eigen::Matrix3d computeCovariance(const double* xs, const double* ys,
+    const double* zs, point_count_t n)
+{
+    using namespace Eigen;
+
+    Vector3d centroid = computeCentroid(xs, ys, zs, n);
+
+    // Accumulate the six unique second-moment sums in straight-line loops
+    // the compiler can vectorize.  The demeaned values are truncated to
+    // single precision to match the historical behavior of the PointView
+    // overload.
+    double xx(0.0), xy(0.0), xz(0.0), yy(0.0), yz(0.0), zz(0.0);
+    for (point_count_t i = 0; i < n; ++i)
+    {
+        double dx = static_cast<float>(xs[i] - centroid[0]);
+        double dy = static_cast<float>(ys[i] - centroid[1]);
+        double dz = static_cast<float>(zs[i] - centroid[2]);
+        xx += dx * dx;
+        xy += dx * dy;
+        xz += dx * dz;
+        yy += dy * dy;
+        yz += dy * dz;
+        zz += dz * dz;
+    }
 
-    return A * A.transpose() / (ids.size()-1);
+    Matrix3d B;
+    B << xx, xy, xz,
+         xy, yy, yz,
+         xz, yz, zz;
+
+    return B / (n - 1);
+}
+
+Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> computeEigen(
+    const PointView& view, const PointIdList& ids)
+{
+    using namespace Eigen;
+
+    Matrix3d B = computeCovariance(view, ids);
+
+    SelfAdjointEigenSolver<Matrix3d> solver;
+    solver.computeDirect(B);
+    return solver;
+}
+
+Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> computeEigen(
+    const double* xs, const double* ys, const double* zs, point_count_t n)
+{
+    using namespace Eigen;
+
+    Matrix3d B = computeCovariance(xs, ys, zs, n);
+
+    SelfAdjointEigenSolver<Matrix3d> solver;
+    solver.computeDirect(B);
+    return solver;
 }
 
 uint8_t computeRank(const PointView& view, const PointIdList& ids,
@@ -275,80 +389,199 @@ Eigen::MatrixXd extendedLocalMinimum(const PointView& view, int rows, int cols,
     return ZImin;
 }
 
-std::vector<double> dilateDiamond(std::vector<double> data, size_t rows, size_t cols, int iterations)
+namespace
 {
-    std::vector<double> out(data.size(), std::numeric_limits<double>::lowest());
-    std::vector<size_t> idx(5);
 
-    for (int iter = 0; iter < iterations; ++iter)
+// One pass of diamond-element morphology over columns [c1, c2) of a
+// column-major raster.  Op keeps the more extreme of the accumulator
+// and a cell (min for erosion, max for dilation) and never picks a
+// NaN; identity is the value a cell takes when its whole neighborhood
+// is NaN.  Working through row-contiguous pointers keeps the inner
+// loop branch-light enough for the compiler to vectorize.
+template <typename Op>
+void diamondPass(const std::vector<double>& data, std::vector<double>& out,
+    size_t rows, size_t cols, size_t c1, size_t c2, double identity, Op op)
+{
+    for (size_t col = c1; col < c2; ++col)
     {
-        for (size_t col = 0; col < cols; ++col)
+        const double *center = data.data() + col * rows;
+        const double *left = (col > 0) ? center - rows : center;
+        const double *right = (col < cols - 1) ? center + rows : center;
+        double *o = out.data() + col * rows;
+
+        for (size_t row = 0; row < rows; ++row)
         {
-            size_t index = col*rows;
-            for (size_t row = 0; row < rows; ++row)
-            {
-                // Find the index into the vector of the current cell.  Then
-                // find the index of the cells to the right/left/above/below
-                // if they exist.
-                size_t j = 0;
-                idx[j++] = index+row;
-                if (row > 0)
-                    idx[j++] = idx[0]-1;
-                if (row < rows-1)
-                    idx[j++] = idx[0]+1;
-                if (col > 0)
-                    idx[j++] = idx[0]-rows;
-                if (col < cols-1)
-                    idx[j++] = idx[0]+rows;
-                // If the data at the test cell pos is greater than that
-                // from the last iteration, set the value to the maximum of
-                // the value of those cells.
-                for (size_t i = 0; i < j; ++i)
-                {
-                    if (data[idx[i]] > out[index+row])
-                        out[index+row] = data[idx[i]];
-                }
-            }
+            double v = identity;
+            v = op(v, center[row]);
+            v = op(v, left[row]);
+            v = op(v, right[row]);
+            if (row > 0)
+                v = op(v, center[row - 1]);
+            if (row < rows - 1)
+                v = op(v, center[row + 1]);
+            o[row] = v;
         }
+    }
+}
+
+// Iterated diamond morphology.  Each pass runs over column blocks on
+// separate threads; waiting for the pool between passes is the halo
+// exchange - the next pass sees every neighbor from the previous one.
+template <typename Op>
+std::vector<double> diamondMorphology(std::vector<double> data, size_t rows,
+    size_t cols, int iterations, double identity, Op op)
+{
+    if (data.empty() || !rows || !cols)
+        return data;
+
+    size_t threads = (std::max)((size_t)1,
+        (std::min)({(size_t)std::thread::hardware_concurrency(),
+            data.size() / 65536, cols}));
+
+    std::vector<double> out(data.size());
+    if (threads == 1)
+    {
+        for (int iter = 0; iter < iterations; ++iter)
+        {
+            diamondPass(data, out, rows, cols, 0, cols, identity, op);
+            data.swap(out);
+        }
+        return data;
+    }
+
+    ThreadPool pool(threads, threads);
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        for (size_t t = 0; t < threads; ++t)
+            pool.add([&, t]()
+            {
+                diamondPass(data, out, rows, cols, cols * t / threads,
+                    cols * (t + 1) / threads, identity, op);
+            });
+        pool.await();
         data.swap(out);
     }
     return data;
 }
 
-std::vector<double> erodeDiamond(std::vector<double> data, size_t rows, size_t cols, int iterations)
+// Scratch bytes a tile's two morphology buffers may occupy together.
+// Tiles are sized to stay resident in a typical L3 share while every
+// pass runs over them.
+const size_t MorphTileBytes = 4 * 1024 * 1024;
+
+// Cache-blocked erode-then-dilate sequence (either count may be zero).
+// Rather than streaming the whole raster through memory once per pass,
+// each tile of columns is copied into a scratch buffer with a halo of
+// one column per pass on each side and run through every pass while it
+// is cache-resident.  A halo column goes stale one pass after its
+// neighbor nearer the scratch edge, so with the halo as wide as the
+// pass count the tile's own columns stay exact throughout.  Tiles are
+// independent, which also drops the between-pass barrier of the
+// pass-at-a-time path.
+std::vector<double> diamondSequenceBlocked(const std::vector<double>& data,
+    size_t rows, size_t cols, int erodeIters, int dilateIters,
+    size_t tileCols, size_t threads)
 {
-    std::vector<double> out(data.size(), (std::numeric_limits<double>::max)());
-    std::vector<size_t> idx(5);
+    auto minOp = [](double acc, double x) { return x < acc ? x : acc; };
+    auto maxOp = [](double acc, double x) { return x > acc ? x : acc; };
 
-    for (int iter = 0; iter < iterations; ++iter)
+    size_t halo = (size_t)(erodeIters + dilateIters);
+    size_t tiles = (cols + tileCols - 1) / tileCols;
+    std::vector<double> out(data.size());
+
+    auto runTile = [&](size_t t)
     {
-        for (size_t col = 0; col < cols; ++col)
+        size_t c1 = t * tileCols;
+        size_t c2 = (std::min)(c1 + tileCols, cols);
+        size_t s1 = (c1 > halo) ? c1 - halo : 0;
+        size_t s2 = (std::min)(c2 + halo, cols);
+        size_t scols = s2 - s1;
+
+        std::vector<double> a(data.begin() + s1 * rows,
+            data.begin() + s2 * rows);
+        std::vector<double> b(scols * rows);
+        for (int i = 0; i < erodeIters; ++i)
         {
-            size_t index = col*rows;
-            for (size_t row = 0; row < rows; ++row)
-            {
-                size_t j = 0;
-                idx[j++] = index+row;
-                if (row > 0)
-                    idx[j++] = idx[0]-1;
-                if (row < rows-1)
-                    idx[j++] = idx[0]+1;
-                if (col > 0)
-                    idx[j++] = idx[0]-rows;
-                if (col < cols-1)
-                    idx[j++] = idx[0]+rows;
-                for (size_t i = 0; i < j; ++i)
-                {
-                    if (data[idx[i]] < out[index+row])
-                        out[index+row] = data[idx[i]];
-                }
-            }
+            diamondPass(a, b, rows, scols, 0, scols,
+                (std::numeric_limits<double>::max)(), minOp);
+            a.swap(b);
         }
-        data.swap(out);
+        for (int i = 0; i < dilateIters; ++i)
+        {
+            diamondPass(a, b, rows, scols, 0, scols,
+                std::numeric_limits<double>::lowest(), maxOp);
+            a.swap(b);
+        }
+        std::copy(a.begin() + (c1 - s1) * rows, a.begin() + (c2 - s1) * rows,
+            out.begin() + c1 * rows);
+    };
+
+    threads = (std::max)((size_t)1, (std::min)(threads, tiles));
+    if (threads == 1)
+        for (size_t t = 0; t < tiles; ++t)
+            runTile(t);
+    else
+    {
+        ThreadPool pool(threads, threads);
+        for (size_t t = 0; t < tiles; ++t)
+            pool.add([&runTile, t]() { runTile(t); });
+        pool.await();
     }
+    return out;
+}
+
+// Erode, then dilate.  Rasters that spill the tile budget and run more
+// than one pass go cache-blocked; small rasters or single passes keep
+// the pass-at-a-time path, whose sweep is already resident or cheap.
+std::vector<double> diamondSequence(std::vector<double> data, size_t rows,
+    size_t cols, int erodeIters, int dilateIters)
+{
+    int total = erodeIters + dilateIters;
+    if (data.empty() || !rows || !cols || total < 1)
+        return data;
+
+    size_t threads = (std::max)((size_t)1,
+        (std::min)({(size_t)std::thread::hardware_concurrency(),
+            data.size() / 65536, cols}));
+
+    // Columns per tile such that the two scratch buffers fit the
+    // budget.  Blocking pays off only when the halo (a column per pass,
+    // each side) stays a small fraction of a tile.
+    size_t tileCols = MorphTileBytes / (2 * rows * sizeof(double));
+    if (total > 1 && 2 * data.size() * sizeof(double) > MorphTileBytes &&
+        tileCols >= 8 * (size_t)total)
+        return diamondSequenceBlocked(data, rows, cols, erodeIters,
+            dilateIters, tileCols, threads);
+
+    if (erodeIters)
+        data = diamondMorphology(std::move(data), rows, cols, erodeIters,
+            (std::numeric_limits<double>::max)(),
+            [](double acc, double x) { return x < acc ? x : acc; });
+    if (dilateIters)
+        data = diamondMorphology(std::move(data), rows, cols, dilateIters,
+            std::numeric_limits<double>::lowest(),
+            [](double acc, double x) { return x > acc ? x : acc; });
     return data;
 }
 
+} // unnamed namespace
+
+std::vector<double> dilateDiamond(std::vector<double> data, size_t rows, size_t cols, int iterations)
+{
+    return diamondSequence(std::move(data), rows, cols, 0, iterations);
+}
+
+std::vector<double> erodeDiamond(std::vector<double> data, size_t rows, size_t cols, int iterations)
+{
+    return diamondSequence(std::move(data), rows, cols, iterations, 0);
+}
+
+std::vector<double> openDiamond(std::vector<double> data, size_t rows, size_t cols, int iterations)
+{
+    return diamondSequence(std::move(data), rows, cols, iterations,
+        iterations);
+}
+
 Eigen::MatrixXd pointViewToEigen(const PointView& view)
 {
     Eigen::MatrixXd matrix(view.size(), 3);
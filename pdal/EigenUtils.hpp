@@ -72,6 +72,12 @@ typedef std::shared_ptr<PointView> PointViewPtr;
 PDAL_DLL void calculateBounds(const PointView& view, BOX2D& box);
 PDAL_DLL void calculateBounds(const PointView& view, BOX3D& box);
 
+/*! Cumulate the bounds of several views into one box, computing the
+    per-view bounds in parallel on up to \threads threads.
+*/
+PDAL_DLL void calculateBounds(const std::vector<PointViewPtr>& views,
+    BOX3D& box, unsigned threads);
+
 PDAL_DLL PointViewPtr demeanPointView(const PointView& view);
 PDAL_DLL PointViewPtr demeanPointView(const PointView& ,double* centroid);
 PDAL_DLL PointViewPtr transform(const PointView&, double* matrix);
@@ -102,6 +108,23 @@ PDAL_DLL void transformInPlace(PointView&, double* matrix);
 PDAL_DLL Eigen::Vector3d computeCentroid(const PointView& view,
     const PointIdList& ids);
 
+/**
+  Compute the centroid of contiguous coordinate spans.
+
+  Overload operating on contiguous X, Y and Z arrays of length \c n, as
+  produced by PointView::getFieldBatch or gathered from a neighbor list.
+  The accumulation matches the PointView overload, so either path yields
+  the same centroid.
+
+  \param xs pointer to n X values.
+  \param ys pointer to n Y values.
+  \param zs pointer to n Z values.
+  \param n the number of points in each span.
+  \return the 3D centroid of the XYZ dimensions.
+*/
+PDAL_DLL Eigen::Vector3d computeCentroid(const double* xs, const double* ys,
+    const double* zs, point_count_t n);
+
 /**
   Compute the covariance matrix of a collection of points.
 
@@ -127,6 +150,58 @@ PDAL_DLL Eigen::Vector3d computeCentroid(const PointView& view,
 PDAL_DLL Eigen::Matrix3d computeCovariance(const PointView& view,
     const PointIdList& ids);
 
+/**
+  Compute the covariance matrix of contiguous coordinate spans.
+
+  Overload operating on contiguous X, Y and Z arrays of length \c n.  The
+  six unique second-moment sums are accumulated in straight-line loops
+  over the spans, which the compiler can vectorize; the PointView overload
+  gathers its neighborhood into spans and defers to this kernel, so all
+  covariance-based filters share it.
+
+  \param xs pointer to n X values.
+  \param ys pointer to n Y values.
+  \param zs pointer to n Z values.
+  \param n the number of points in each span.
+  \return the covariance matrix of the XYZ dimensions.
+*/
+PDAL_DLL Eigen::Matrix3d computeCovariance(const double* xs,
+    const double* ys, const double* zs, point_count_t n);
+
+/**
+  Compute the eigen decomposition of the covariance of a collection of
+  points.
+
+  Computes the covariance of the neighborhood (specified by PointId) and
+  decomposes it with Eigen's closed-form algorithm for symmetric 3x3
+  matrices (SelfAdjointEigenSolver::computeDirect), which is considerably
+  cheaper than the default iterative reduction when invoked once per
+  point.  Eigenvalues are returned in increasing order.
+
+  \param view the source PointView.
+  \param ids a vector of PointIds specifying a subset of points.
+  \return the solver holding the eigenvalues and eigenvectors.
+*/
+PDAL_DLL Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> computeEigen(
+    const PointView& view, const PointIdList& ids);
+
+/**
+  Compute the eigen decomposition of the covariance of contiguous
+  coordinate spans.
+
+  Overload operating on contiguous X, Y and Z arrays of length \c n; see
+  the span overload of computeCovariance.  Eigenvalues are returned in
+  increasing order.
+
+  \param xs pointer to n X values.
+  \param ys pointer to n Y values.
+  \param zs pointer to n Z values.
+  \param n the number of points in each span.
+  \return the solver holding the eigenvalues and eigenvectors.
+*/
+PDAL_DLL Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> computeEigen(
+    const double* xs, const double* ys, const double* zs, point_count_t n);
+
 /**
   Compute the rank of a collection of points.
 
@@ -218,6 +293,27 @@ PDAL_DLL std::vector<double> erodeDiamond(std::vector<double> data,
                                           size_t rows, size_t cols,
                                           int iterations);
 
+/**
+  Perform a morphological opening of the input raster.
+
+  Performs a morphological erosion followed by a dilation of the input raster,
+  each using a diamond structuring element applied for the given number of
+  iterations. Equivalent to erodeDiamond() followed by dilateDiamond(), but
+  the fused sequence runs all passes over each cache-resident tile of the
+  raster in turn rather than streaming the whole raster once per pass. The
+  input and output rasters are stored in column major order.
+
+  \param data the input raster.
+  \param rows the number of rows.
+  \param cols the number of cols.
+  \param iterations the number of iterations used to approximate a larger
+         structuring element.
+  \return the morphological opening of the input raster.
+*/
+PDAL_DLL std::vector<double> openDiamond(std::vector<double> data,
+                                         size_t rows, size_t cols,
+                                         int iterations);
+
 /**
   Converts a PointView into an Eigen::MatrixXd.
 
@@ -43,7 +43,7 @@ namespace pdal
 class PDAL_DLL FlexWriter : public Writer
 {
 protected:
-    FlexWriter() : m_filenum(1)
+    FlexWriter() : m_streamTable(nullptr), m_fileOpen(false), m_filenum(1)
     {}
 
     std::string m_filename;
@@ -51,7 +51,7 @@ protected:
 
     void validateFilename(PointTableRef table)
     {
-        if (!table.supportsView() &&
+        if (!table.supportsView() && !supportsStreamRotation() &&
             (m_filename.find('#') != std::string::npos))
         {
             std::ostringstream oss;
@@ -61,7 +61,36 @@ protected:
         }
     }
 
+    // Writers that can close and reopen their output mid-stream override
+    // this to allow template-based filenames with a streaming point table.
+    // Such writers call rotateStream() before processing each point.
+    virtual bool supportsStreamRotation() const
+    { return false; }
+
+    // When writing with a template-based filename in stream mode, start a
+    // new output file at each point that an upstream splitting filter
+    // (e.g. filters.groupby) marked as a group start.  The first point
+    // readies the initial file.
+    void rotateStream(const PointRef& point)
+    {
+        if (m_hashPos == std::string::npos || !m_streamTable)
+            return;
+        if (m_fileOpen && m_streamTable->groupStart(point.pointId()))
+        {
+            doneFile();
+            m_fileOpen = false;
+        }
+        if (!m_fileOpen)
+        {
+            readyFile(generateFilename(),
+                m_streamTable->spatialReference());
+            m_fileOpen = true;
+        }
+    }
+
 private:
+    StreamPointTable *m_streamTable;
+    bool m_fileOpen;
     std::string::size_type m_hashPos;
 
     virtual void writerInitialize(PointTableRef table)
@@ -95,6 +124,8 @@ private:
 
     virtual void ready(PointTableRef table) final
     {
+        m_streamTable = dynamic_cast<StreamPointTable *>(&table);
+        m_fileOpen = false;
         readyTable(table);
 
         // Ready the file if we're writing a single file.
@@ -105,6 +136,7 @@ private:
                     ": Attempting to write '" << m_filename <<
                     "' with multiple point spatial references." << std::endl;
             readyFile(generateFilename(), table.spatialReference());
+            m_fileOpen = true;
         }
     }
 
@@ -138,8 +170,12 @@ private:
 
     virtual void done(PointTableRef table) final
     {
-        if (m_hashPos == std::string::npos)
+        // The single file or the last stream-rotated file is still open.
+        if (m_fileOpen)
+        {
             doneFile();
+            m_fileOpen = false;
+        }
         doneTable(table);
     }
 
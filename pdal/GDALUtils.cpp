@@ -789,6 +789,51 @@ GDALError Raster::read(double x, double y, std::vector<double>& data)
 }
 
 
+GDALError Raster::readBandRows(std::vector<double>& data, int nBand,
+    int firstRow, int rowCount)
+{
+    if (!m_ds)
+    {
+        m_errorMsg = "Raster not open.";
+        return GDALError::NotOpen;
+    }
+    if (nBand < 1 || nBand > m_numBands)
+    {
+        m_errorMsg = "Unable to get band " + std::to_string(nBand) +
+            " from raster '" + m_filename + "'.";
+        return GDALError::InvalidBand;
+    }
+    if (firstRow < 0 || rowCount <= 0 || firstRow + rowCount > m_height)
+    {
+        m_errorMsg = "Requested rows are not in the raster.";
+        return GDALError::NoData;
+    }
+
+    data.resize((size_t)m_width * rowCount);
+    GDALRasterBandH b = GDALGetRasterBand(m_ds, nBand);
+    if (GDALRasterIO(b, GF_Read, 0, firstRow, m_width, rowCount,
+        data.data(), m_width, rowCount, GDT_Float64, 0, 0) != CE_None)
+    {
+        m_errorMsg = "Unable to read rows from raster '" + m_filename + "'.";
+        return GDALError::CantReadBlock;
+    }
+    return GDALError::None;
+}
+
+
+GDALError Raster::blockSize(int nBand, int& xSize, int& ySize) const
+{
+    if (!m_ds)
+        return GDALError::NotOpen;
+
+    GDALRasterBandH b = GDALGetRasterBand(m_ds, nBand);
+    if (!b)
+        return GDALError::InvalidBand;
+    GDALGetBlockSize(b, &xSize, &ySize);
+    return GDALError::None;
+}
+
+
 /**
   Get the spatial reference associated with a raster.
   \return  Associated spatial reference.
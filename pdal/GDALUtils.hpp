@@ -748,6 +748,28 @@ public:
     */
     GDALError read(double x, double y, std::vector<double>& data);
 
+    /**
+      Read a horizontal strip of rows from a band, converted to double.
+
+      \param data  Vector in which to store the data.  The vector is resized
+        to width() * rowCount.
+      \param nBand  Band number to read.  Band numbers start at 1.
+      \param firstRow  First raster row of the strip.
+      \param rowCount  Number of rows in the strip.
+    */
+    GDALError readBandRows(std::vector<double>& data, int nBand, int firstRow,
+        int rowCount);
+
+    /**
+      Get the native block size of a band.  Reads aligned to this size
+      decode each underlying block only once.
+
+      \param nBand  Band number.  Band numbers start at 1.
+      \param[out] xSize  Block width in pixels.
+      \param[out] ySize  Block height in pixels.
+    */
+    GDALError blockSize(int nBand, int& xSize, int& ySize) const;
+
     /**
       Get a vector of dimensions that map to the bands of a raster.
     */
@@ -764,6 +786,19 @@ public:
     */
     void pixelToCoord(int column, int row, std::array<double, 2>& output) const;
 
+    /**
+      Determine the pixel/line position of a geo-located coordinate using
+      the raster's inverse transformation matrix.
+
+      \param x  X position of the coordinate.
+      \param y  Y position of the coordinate.
+      \param[out] pixel  Raster column of the coordinate.
+      \param[out] line  Raster row of the coordinate.
+      \return  false if the coordinate is outside the raster.
+    */
+    bool coordToPixel(double x, double y, int32_t& pixel, int32_t& line)
+        { return getPixelAndLinePosition(x, y, pixel, line); }
+
     /**
       Get the spatial reference associated with the raster.
 
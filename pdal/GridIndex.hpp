@@ -0,0 +1,376 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <pdal/ArtifactManager.hpp>
+#include <pdal/PointView.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+namespace pdal
+{
+
+/// A uniform-grid spatial hash over a view's points, for filters that only
+/// ever issue fixed-radius neighborhood queries.  The grid cell size is the
+/// expected query radius, so a query visits at most 27 cells.  Coordinates
+/// and point IDs are copied into cell-sorted arrays at build time, making
+/// each candidate cell one contiguous, cache-coherent scan - no tree
+/// traversal and no per-point virtual dispatch.
+///
+/// Queries with a radius larger than the one given at construction still
+/// return correct results but visit proportionally more cells; when query
+/// radii vary widely, KD3Index is the better fit.  Cell-key hash collisions
+/// merge buckets, which only adds scanned candidates - the distance test
+/// rejects them.
+class PDAL_DLL Grid3Index
+{
+public:
+    Grid3Index(const PointView& buf, double radius) :
+        m_buf(buf), m_cellSize(radius)
+    {
+        if (!(radius > 0))
+            throw pdal_error("Grid3Index: radius must be positive.");
+        if (!buf.hasDim(Dimension::Id::X))
+            throw pdal_error("Grid3Index: point view missing 'X' dimension.");
+        if (!buf.hasDim(Dimension::Id::Y))
+            throw pdal_error("Grid3Index: point view missing 'Y' dimension.");
+        if (!buf.hasDim(Dimension::Id::Z))
+            throw pdal_error("Grid3Index: point view missing 'Z' dimension.");
+    }
+
+    /// Build the index.  The coordinate-fetch passes divide across
+    /// threads (0 = choose automatically); the result is identical at any
+    /// thread count.
+    void build(size_t threads = 0)
+    {
+        point_count_t size = m_buf.size();
+        threads = buildThreads(threads, size);
+
+        m_x.resize(size);
+        m_y.resize(size);
+        m_z.resize(size);
+        m_ids.resize(size);
+
+        // Pair each point with its cell key and sort so that each cell's
+        // points land in one contiguous run.
+        std::vector<std::pair<uint64_t, PointId>> cells(size);
+        buildRun(size, threads, [this, &cells](point_count_t begin,
+            point_count_t end)
+        {
+            for (PointId i = begin; i < end; ++i)
+            {
+                double x = m_buf.getFieldAs<double>(Dimension::Id::X, i);
+                double y = m_buf.getFieldAs<double>(Dimension::Id::Y, i);
+                double z = m_buf.getFieldAs<double>(Dimension::Id::Z, i);
+                cells[i] = std::make_pair(key(cell(x), cell(y), cell(z)), i);
+            }
+        });
+        std::sort(cells.begin(), cells.end());
+
+        buildRun(size, threads, [this, &cells](point_count_t begin,
+            point_count_t end)
+        {
+            for (point_count_t pos = begin; pos < end; ++pos)
+            {
+                PointId id = cells[pos].second;
+                m_ids[pos] = id;
+                m_x[pos] = m_buf.getFieldAs<double>(Dimension::Id::X, id);
+                m_y[pos] = m_buf.getFieldAs<double>(Dimension::Id::Y, id);
+                m_z[pos] = m_buf.getFieldAs<double>(Dimension::Id::Z, id);
+            }
+        });
+
+        m_cells.clear();
+        m_cells.reserve(size / 4);
+        for (point_count_t pos = 0; pos < size; ++pos)
+        {
+            uint64_t k = cells[pos].first;
+            if (pos == 0 || k != cells[pos - 1].first)
+                m_cells[k] = std::make_pair(pos, point_count_t(1));
+            else
+                m_cells[k].second++;
+        }
+    }
+
+    /// Return the IDs of all points within r of the given position, sorted
+    /// by distance, matching KD3Index::radius().
+    PointIdList radius(double x, double y, double z, double r) const
+    {
+        std::vector<std::pair<double, PointId>> matches;
+        scan(x, y, z, r,
+            [&matches](double d2, PointId id)
+            { matches.push_back(std::make_pair(d2, id)); });
+        std::sort(matches.begin(), matches.end());
+
+        PointIdList output;
+        output.reserve(matches.size());
+        for (auto& m : matches)
+            output.push_back(m.second);
+        return output;
+    }
+
+    PointIdList radius(PointId idx, double r) const
+    {
+        double x = m_buf.getFieldAs<double>(Dimension::Id::X, idx);
+        double y = m_buf.getFieldAs<double>(Dimension::Id::Y, idx);
+        double z = m_buf.getFieldAs<double>(Dimension::Id::Z, idx);
+
+        return radius(x, y, z, r);
+    }
+
+    PointIdList radius(PointRef& point, double r) const
+    {
+        double x = point.getFieldAs<double>(Dimension::Id::X);
+        double y = point.getFieldAs<double>(Dimension::Id::Y);
+        double z = point.getFieldAs<double>(Dimension::Id::Z);
+
+        return radius(x, y, z, r);
+    }
+
+    /// Count the points within r of the given position without
+    /// materializing or sorting an ID list.
+    point_count_t within(double x, double y, double z, double r) const
+    {
+        point_count_t cnt = 0;
+        scan(x, y, z, r,
+            [&cnt](double, PointId)
+            { cnt++; });
+        return cnt;
+    }
+
+    point_count_t within(PointId idx, double r) const
+    {
+        double x = m_buf.getFieldAs<double>(Dimension::Id::X, idx);
+        double y = m_buf.getFieldAs<double>(Dimension::Id::Y, idx);
+        double z = m_buf.getFieldAs<double>(Dimension::Id::Z, idx);
+
+        return within(x, y, z, r);
+    }
+
+    /// Invoke f(squared distance, point ID) for every point in the cells
+    /// covering the query ball.  Candidates beyond r are passed when they
+    /// share a cell with the ball - callers apply their own distance
+    /// predicate.
+    template <typename F>
+    void candidates(double x, double y, double z, double r, F f) const
+    {
+        int64_t x0 = cell(x - r);
+        int64_t x1 = cell(x + r);
+        int64_t y0 = cell(y - r);
+        int64_t y1 = cell(y + r);
+        int64_t z0 = cell(z - r);
+        int64_t z1 = cell(z + r);
+
+        // Two cells in the window can hash to the same bucket, so dedupe
+        // the keys before scanning or those points would be seen twice.
+        std::vector<uint64_t> keys;
+        keys.reserve((x1 - x0 + 1) * (y1 - y0 + 1) * (z1 - z0 + 1));
+        for (int64_t ix = x0; ix <= x1; ++ix)
+            for (int64_t iy = y0; iy <= y1; ++iy)
+                for (int64_t iz = z0; iz <= z1; ++iz)
+                    keys.push_back(key(ix, iy, iz));
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        for (uint64_t k : keys)
+        {
+            auto ci = m_cells.find(k);
+            if (ci == m_cells.end())
+                continue;
+            point_count_t pos = ci->second.first;
+            point_count_t end = pos + ci->second.second;
+            for (; pos < end; ++pos)
+            {
+                double dx = m_x[pos] - x;
+                double dy = m_y[pos] - y;
+                double dz = m_z[pos] - z;
+                f(dx * dx + dy * dy + dz * dz, m_ids[pos]);
+            }
+        }
+    }
+
+private:
+    int64_t cell(double v) const
+        { return (int64_t)std::floor(v / m_cellSize); }
+
+    static uint64_t key(int64_t ix, int64_t iy, int64_t iz)
+    {
+        return (uint64_t)ix * 73856093ULL ^ (uint64_t)iy * 19349663ULL ^
+            (uint64_t)iz * 83492791ULL;
+    }
+
+    /// Invoke f(squared distance, point ID) for every point within r of
+    /// the given position.
+    template <typename F>
+    void scan(double x, double y, double z, double r, F f) const
+    {
+        double r2 = r * r;
+        candidates(x, y, z, r, [r2, &f](double d2, PointId id)
+        {
+            if (d2 <= r2)
+                f(d2, id);
+        });
+    }
+
+    // Choose the thread count for a build: one thread for small views,
+    // otherwise the hardware concurrency.
+    static size_t buildThreads(size_t threads, point_count_t np)
+    {
+        return pdal::threadCount(threads, np);
+    }
+
+    // Execute fn(begin, end) over [0, np) split across threads.
+    template <typename F>
+    static void buildRun(point_count_t np, size_t threads, F fn)
+    {
+        if (threads <= 1)
+        {
+            fn(0, np);
+            return;
+        }
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t)
+            pool.emplace_back(fn, (point_count_t)(np * t / threads),
+                (point_count_t)(np * (t + 1) / threads));
+        for (auto& t : pool)
+            t.join();
+    }
+
+    const PointView& m_buf;
+    double m_cellSize;
+    // Coordinates and IDs in cell order; each cell is one contiguous run.
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    PointIdList m_ids;
+    // Cell key -> (offset, count) into the sorted arrays.
+    std::unordered_map<uint64_t, std::pair<point_count_t, point_count_t>>
+        m_cells;
+
+    Grid3Index(const Grid3Index&);
+    Grid3Index& operator=(Grid3Index&);
+};
+
+
+/// A built Grid3Index published through the owning table's ArtifactManager
+/// so that the fixed-radius stages of one pipeline - outlier marking,
+/// density, sampling - share one occupancy structure instead of each
+/// building its own.  The artifact matches one (view, radius) pair:
+/// obtain() returns the published index while the pair still matches and
+/// builds and republishes it otherwise.  A stage that culls points emits a
+/// new view with a fresh ID, so stages downstream of it never reuse a
+/// stale structure; stages that mutate coordinates in place (reprojection,
+/// transformation) keep the view's ID and size, so the identity also
+/// carries a sparse digest of the coordinates that rejects a stale grid
+/// after such a stage.  The artifact doesn't keep the view alive; view IDs
+/// are never reused, so the identity check can only match while the view
+/// the index was built from still exists.
+class OccupancyArtifact : public Artifact
+{
+public:
+    OccupancyArtifact(const PointView& view, double radius) :
+        m_viewId(view.id()), m_size(view.size()), m_radius(radius),
+        m_digest(digest(view)), m_index(view, radius)
+    {
+        m_index.build();
+    }
+
+    Grid3Index& index()
+        { return m_index; }
+
+    /// The published index for the view and radius, built and published
+    /// on first request.
+    static Grid3Index& obtain(const PointView& view, double radius)
+    {
+        ArtifactManager& mgr = view.table().artifactManager();
+        std::shared_ptr<OccupancyArtifact> art =
+            mgr.get<OccupancyArtifact>(name());
+        if (!art || art->m_viewId != view.id() ||
+            art->m_size != view.size() || art->m_radius != radius ||
+            art->m_digest != digest(view))
+        {
+            art.reset(new OccupancyArtifact(view, radius));
+            mgr.replaceOrPut(name(), art);
+        }
+        return art->index();
+    }
+
+    static std::string name()
+        { return "grid_occupancy"; }
+
+private:
+    /// Cheap content digest over a sample of the view's coordinates so
+    /// the published index is rejected when a stage rewrote them in
+    /// place.  Same scheme as KDIndex's sidecar-cache digest.
+    static uint64_t digest(const PointView& view)
+    {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        auto mix = [&h](uint64_t v)
+        {
+            h ^= v;
+            h *= 0x100000001b3ULL;
+        };
+
+        point_count_t size = view.size();
+        mix(size);
+        point_count_t stride =
+            (std::max)((point_count_t)1, size / (point_count_t)1024);
+        for (PointId i = 0; i < size; i += stride)
+            for (Dimension::Id dim : { Dimension::Id::X, Dimension::Id::Y,
+                Dimension::Id::Z })
+            {
+                double val = view.getFieldAs<double>(dim, i);
+                uint64_t bits;
+                std::memcpy(&bits, &val, sizeof(bits));
+                mix(bits);
+            }
+        return h;
+    }
+
+    int m_viewId;
+    point_count_t m_size;
+    double m_radius;
+    uint64_t m_digest;
+    Grid3Index m_index;
+};
+
+} // namespace pdal
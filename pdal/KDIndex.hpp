@@ -34,12 +34,21 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <thread>
 
 #include <nanoflann/nanoflann.hpp>
 
 #include <pdal/EigenUtils.hpp>
 #include <pdal/PointView.hpp>
+#include <pdal/Trace.hpp>
+#include <pdal/util/FileUtils.hpp>
+#include <pdal/util/SpaceFillingCurve.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace nanoflann
 {
@@ -73,18 +82,282 @@ public:
     template <class BBOX> bool kdtree_get_bbox(BBOX& bb) const;
     void build()
     {
-        m_index.reset(new my_kd_tree_t(DIM, *this,
-            nanoflann::KDTreeSingleIndexAdaptorParams(100)));
-        m_index->buildIndex();
+        build(1);
+    }
+
+    /// Build the index with the given number of threads and nanoflann
+    /// leaf size.  With more than one thread the points are split into
+    /// equal ranges and a subtree is built for each concurrently; queries
+    /// search every subtree and merge the results by distance, so queries
+    /// against a segmented index cost somewhat more than against a single
+    /// tree.  Small views are always built as a single tree.
+    void build(unsigned threads, int leafSize = 100)
+    {
+        PDAL_TRACE_SCOPE("kdindex:build");
+        m_index.reset();
+        m_segments.clear();
+        m_segTrees.clear();
+
+        // Subtrees smaller than this just add query overhead.
+        const point_count_t MinSegmentSize = 100000;
+        threads = (std::max)(threads, 1u);
+        if (threads > 1)
+            threads = (unsigned)(std::min)((point_count_t)threads,
+                (std::max)((point_count_t)1,
+                    m_buf.size() / MinSegmentSize));
+
+        if (threads == 1)
+        {
+            m_index.reset(new my_kd_tree_t(DIM, *this,
+                nanoflann::KDTreeSingleIndexAdaptorParams(leafSize)));
+            m_index->buildIndex();
+            return;
+        }
+
+        PointId start = 0;
+        point_count_t remaining = m_buf.size();
+        for (unsigned i = 0; i < threads; ++i)
+        {
+            point_count_t cnt = remaining / (threads - i);
+            m_segments.emplace_back(new Segment(*this, start, cnt));
+            m_segTrees.emplace_back(new seg_kd_tree_t(DIM, *m_segments.back(),
+                nanoflann::KDTreeSingleIndexAdaptorParams(leafSize)));
+            start += cnt;
+            remaining -= cnt;
+        }
+
+        ThreadPool pool(threads, threads);
+        for (auto& tree : m_segTrees)
+            pool.add([&tree]()
+                { tree->buildIndex(); });
+        pool.join();
+        if (pool.errors().size())
+            throw pdal_error("KDIndex: " + pool.errors().front());
+    }
+
+    /// Save the built index to a sidecar cache file so later runs over the
+    /// same data can skip construction.  The cache records a caller-provided
+    /// key (typically the source path), the point count and a sparse content
+    /// digest ahead of nanoflann's flattened tree.  Only single-tree indexes
+    /// can be cached; returns false when nothing was written.
+    bool save(const std::string& filename, const std::string& key) const
+    {
+        if (!m_index)
+            return false;
+
+        FILE *f = std::fopen(filename.c_str(), "wb");
+        if (!f)
+            return false;
+
+        const char magic[8] = { 'P', 'D', 'A', 'L', 'K', 'D', '0', '1' };
+        uint32_t dim = DIM;
+        uint64_t keyLen = key.size();
+        uint64_t count = m_buf.size();
+        uint64_t dig = digest();
+
+        bool ok =
+            std::fwrite(magic, sizeof(magic), 1, f) == 1 &&
+            std::fwrite(&dim, sizeof(dim), 1, f) == 1 &&
+            std::fwrite(&keyLen, sizeof(keyLen), 1, f) == 1 &&
+            (keyLen == 0 || std::fwrite(key.data(), keyLen, 1, f) == 1) &&
+            std::fwrite(&count, sizeof(count), 1, f) == 1 &&
+            std::fwrite(&dig, sizeof(dig), 1, f) == 1;
+        if (ok)
+        {
+            m_index->saveIndex(f);
+            ok = !std::ferror(f);
+        }
+        std::fclose(f);
+        if (!ok)
+            FileUtils::deleteFile(filename);
+        return ok;
+    }
+
+    /// Warm-start the index from a cache file written by save().  Returns
+    /// false - leaving the index unbuilt - if the file is missing, was
+    /// written for a different key or dimensionality, or the data changed
+    /// since the cache was written.
+    bool load(const std::string& filename, const std::string& key)
+    {
+        FILE *f = std::fopen(filename.c_str(), "rb");
+        if (!f)
+            return false;
+
+        const char magic[8] = { 'P', 'D', 'A', 'L', 'K', 'D', '0', '1' };
+        char fileMagic[8];
+        uint32_t dim = 0;
+        uint64_t keyLen = 0;
+        uint64_t count = 0;
+        uint64_t dig = 0;
+        std::string fileKey;
+
+        bool ok =
+            std::fread(fileMagic, sizeof(fileMagic), 1, f) == 1 &&
+            std::memcmp(fileMagic, magic, sizeof(magic)) == 0 &&
+            std::fread(&dim, sizeof(dim), 1, f) == 1 &&
+            dim == (uint32_t)DIM &&
+            std::fread(&keyLen, sizeof(keyLen), 1, f) == 1 &&
+            keyLen == key.size();
+        if (ok && keyLen)
+        {
+            fileKey.resize(keyLen);
+            ok = std::fread(&fileKey[0], keyLen, 1, f) == 1 &&
+                fileKey == key;
+        }
+        ok = ok &&
+            std::fread(&count, sizeof(count), 1, f) == 1 &&
+            count == (uint64_t)m_buf.size() &&
+            std::fread(&dig, sizeof(dig), 1, f) == 1 &&
+            dig == digest();
+        if (ok)
+        {
+            m_segments.clear();
+            m_segTrees.clear();
+            m_index.reset(new my_kd_tree_t(DIM, *this,
+                nanoflann::KDTreeSingleIndexAdaptorParams(100)));
+            m_index->loadIndex(f);
+            ok = !std::ferror(f);
+            if (!ok)
+                m_index.reset();
+        }
+        std::fclose(f);
+        return ok;
     }
 
 protected:
+    /// A contiguous range of the view's points, presented to nanoflann as
+    /// its own dataset with segment-local indices.
+    struct Segment
+    {
+        Segment(const KDIndex& owner, PointId start, std::size_t count) :
+            m_owner(owner), m_start(start), m_count(count)
+        {}
+
+        std::size_t kdtree_get_point_count() const
+            { return m_count; }
+        double kdtree_get_pt(const PointId idx, int dim) const
+            { return m_owner.kdtree_get_pt(m_start + idx, dim); }
+        double kdtree_distance(const double *p1, const PointId idx,
+            size_t numDims) const
+            { return m_owner.kdtree_distance(p1, m_start + idx, numDims); }
+        // Let nanoflann compute the bounds of the subrange itself.
+        template <class BBOX> bool kdtree_get_bbox(BBOX&) const
+            { return false; }
+
+        const KDIndex& m_owner;
+        PointId m_start;
+        std::size_t m_count;
+    };
+
     const PointView& m_buf;
 
     typedef nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<
         double, KDIndex, double>, KDIndex, -1, std::size_t> my_kd_tree_t;
+    typedef nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<
+        double, Segment, double>, Segment, -1, std::size_t> seg_kd_tree_t;
 
     std::unique_ptr<my_kd_tree_t> m_index;
+    std::vector<std::unique_ptr<Segment>> m_segments;
+    std::vector<std::unique_ptr<seg_kd_tree_t>> m_segTrees;
+
+    /// Cheap content digest over a sample of the indexed coordinates so a
+    /// cache is rejected when the underlying data changed.
+    uint64_t digest() const
+    {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        auto mix = [&h](uint64_t v)
+        {
+            h ^= v;
+            h *= 0x100000001b3ULL;
+        };
+
+        point_count_t size = m_buf.size();
+        mix(size);
+        point_count_t stride =
+            (std::max)((point_count_t)1, size / (point_count_t)1024);
+        for (PointId i = 0; i < size; i += stride)
+            for (int d = 0; d < DIM; ++d)
+            {
+                double val = kdtree_get_pt(i, d);
+                uint64_t bits;
+                std::memcpy(&bits, &val, sizeof(bits));
+                mix(bits);
+            }
+        return h;
+    }
+
+    /// Find the k nearest neighbors of pt, searching all subtrees and
+    /// merging by distance when the index is segmented.  ids and dists
+    /// must hold k entries.
+    void knnQuery(const double *pt, point_count_t k, PointId *ids,
+        double *dists) const
+    {
+        PDAL_TRACE_SCOPE("kdindex:knn");
+        if (m_index)
+        {
+            nanoflann::KNNResultSet<double, PointId, point_count_t>
+                resultSet(k);
+            resultSet.init(ids, dists);
+            m_index->findNeighbors(resultSet, pt,
+                nanoflann::SearchParams(10));
+            return;
+        }
+
+        std::vector<std::pair<double, PointId>> all;
+        all.reserve(k * m_segTrees.size());
+        PointIdList segIds(k);
+        std::vector<double> segDists(k);
+        for (std::size_t s = 0; s < m_segTrees.size(); ++s)
+        {
+            point_count_t kk =
+                (std::min)((point_count_t)m_segments[s]->m_count, k);
+            if (!kk)
+                continue;
+            nanoflann::KNNResultSet<double, PointId, point_count_t>
+                resultSet(kk);
+            resultSet.init(segIds.data(), segDists.data());
+            m_segTrees[s]->findNeighbors(resultSet, pt,
+                nanoflann::SearchParams(10));
+            for (point_count_t i = 0; i < kk; ++i)
+                all.push_back(
+                    std::make_pair(segDists[i],
+                        segIds[i] + m_segments[s]->m_start));
+        }
+        point_count_t found = (std::min)((point_count_t)all.size(), k);
+        std::partial_sort(all.begin(), all.begin() + found, all.end());
+        for (point_count_t i = 0; i < found; ++i)
+        {
+            dists[i] = all[i].first;
+            ids[i] = all[i].second;
+        }
+    }
+
+    /// Find all points within squared radius r2 of pt, sorted by distance.
+    std::size_t radiusQuery(const double *pt, double r2,
+        std::vector<std::pair<std::size_t, double>>& matches) const
+    {
+        PDAL_TRACE_SCOPE("kdindex:radius");
+        nanoflann::SearchParams params;
+        params.sorted = true;
+
+        if (m_index)
+            return m_index->radiusSearch(pt, r2, matches, params);
+
+        matches.clear();
+        std::vector<std::pair<std::size_t, double>> segMatches;
+        for (std::size_t s = 0; s < m_segTrees.size(); ++s)
+        {
+            m_segTrees[s]->radiusSearch(pt, r2, segMatches, params);
+            for (auto& m : segMatches)
+                matches.push_back(std::make_pair(
+                    m.first + m_segments[s]->m_start, m.second));
+        }
+        std::sort(matches.begin(), matches.end(),
+            [](const std::pair<std::size_t, double>& a,
+               const std::pair<std::size_t, double>& b)
+            { return a.second < b.second; });
+        return matches.size();
+    }
 
 private:
     KDIndex(const KDIndex&);
@@ -125,14 +398,11 @@ public:
         k = (std::min)(m_buf.size(), k);
         PointIdList output(k);
         std::vector<double> out_dist_sqr(k);
-        nanoflann::KNNResultSet<double, PointId, point_count_t> resultSet(k);
-
-        resultSet.init(&output[0], &out_dist_sqr[0]);
 
         std::vector<double> pt;
         pt.push_back(x);
         pt.push_back(y);
-        m_index->findNeighbors(resultSet, &pt[0], nanoflann::SearchParams(10));
+        knnQuery(&pt[0], k, &output[0], &out_dist_sqr[0]);
         return output;
     }
 
@@ -156,14 +426,11 @@ public:
         PointIdList *indices, std::vector<double> *sqr_dists) const
     {
         k = (std::min)(m_buf.size(), k);
-        nanoflann::KNNResultSet<double, PointId, point_count_t> resultSet(k);
-
-        resultSet.init(&indices->front(), &sqr_dists->front());
 
         std::vector<double> pt;
         pt.push_back(x);
         pt.push_back(y);
-        m_index->findNeighbors(resultSet, &pt[0], nanoflann::SearchParams(10));
+        knnQuery(&pt[0], k, &indices->front(), &sqr_dists->front());
     }
 
     void knnSearch(PointId idx, point_count_t k, PointIdList *indices,
@@ -189,8 +456,6 @@ public:
     {
         PointIdList output;
         std::vector<std::pair<std::size_t, double>> ret_matches;
-        nanoflann::SearchParams params;
-        params.sorted = true;
 
         std::vector<double> pt;
         pt.push_back(x);
@@ -199,7 +464,7 @@ public:
         // Our distance metric is square distance, so we use the square of
         // the radius.
         const std::size_t count =
-            m_index->radiusSearch(&pt[0], r * r, ret_matches, params);
+            radiusQuery(&pt[0], r * r, ret_matches);
 
         for (std::size_t i = 0; i < count; ++i)
             output.push_back(ret_matches[i].first);
@@ -275,9 +540,7 @@ public:
 
         // Extract k*stride neighbors, then return only k, selecting every nth
         // neighbor at the given stride.
-        nanoflann::KNNResultSet<double, PointId, point_count_t> resultSet(k2);
-        resultSet.init(&output[0], &out_dist_sqr[0]);
-        m_index->findNeighbors(resultSet, &pt[0], nanoflann::SearchParams());
+        knnQuery(&pt[0], k2, &output[0], &out_dist_sqr[0]);
 
         // Perform the downsampling if a stride is provided.
         if (stride > 1)
@@ -312,15 +575,12 @@ public:
         PointIdList *indices, std::vector<double> *sqr_dists) const
     {
         k = (std::min)(m_buf.size(), k);
-        nanoflann::KNNResultSet<double, PointId, point_count_t> resultSet(k);
-
-        resultSet.init(&indices->front(), &sqr_dists->front());
 
         std::vector<double> pt;
         pt.push_back(x);
         pt.push_back(y);
         pt.push_back(z);
-        m_index->findNeighbors(resultSet, &pt[0], nanoflann::SearchParams(10));
+        knnQuery(&pt[0], k, &indices->front(), &sqr_dists->front());
     }
 
     void knnSearch(PointId idx, point_count_t k, PointIdList *indices,
@@ -347,8 +607,6 @@ public:
     {
         PointIdList output;
         std::vector<std::pair<std::size_t, double>> ret_matches;
-        nanoflann::SearchParams params;
-        params.sorted = true;
 
         std::vector<double> pt;
         pt.push_back(x);
@@ -358,7 +616,7 @@ public:
         // Our distance metric is square distance, so we use the square of
         // the radius.
         const std::size_t count =
-            m_index->radiusSearch(&pt[0], r * r, ret_matches, params);
+            radiusQuery(&pt[0], r * r, ret_matches);
 
         for (std::size_t i = 0; i < count; ++i)
             output.push_back(ret_matches[i].first);
@@ -382,6 +640,182 @@ public:
 
         return radius(x, y, z, r);
     }
+
+    /// Batch form of neighbors(): find the k nearest neighbors of each
+    /// of the packed x/y/z query points (pts holds three doubles per
+    /// query).  The queries run in Morton order, so successive queries
+    /// visit largely the same tree nodes, and divide across threads
+    /// (0 = choose automatically).  The neighbors of query q land in
+    /// ids[q * k] through ids[q * k + k - 1], nearest first; k is
+    /// clamped to the view size.  Returns the clamped k.  When sqrDists
+    /// is given it is filled with the matching squared distances.
+    point_count_t neighborsBatch(const std::vector<double>& pts,
+        point_count_t k, PointIdList& ids,
+        std::vector<double> *sqrDists = nullptr, size_t threads = 0) const
+    {
+        point_count_t nq = (point_count_t)(pts.size() / 3);
+        k = (std::min)(m_buf.size(), k);
+        ids.resize((size_t)(nq * k));
+        if (sqrDists)
+            sqrDists->resize((size_t)(nq * k));
+        if (!nq || !k)
+            return k;
+
+        std::vector<PointId> order = batchOrder(pts);
+        batchRun(nq, batchThreads(threads, nq),
+            [&](point_count_t begin, point_count_t end)
+        {
+            std::vector<double> dists(k);
+            for (point_count_t i = begin; i < end; ++i)
+            {
+                PointId q = order[i];
+                double *d = sqrDists ? &(*sqrDists)[q * k] : dists.data();
+                knnQuery(&pts[3 * q], k, &ids[q * k], d);
+            }
+        });
+        return k;
+    }
+
+    /// Batch k-nearest-neighbors of points of the indexed view.
+    point_count_t neighborsBatch(const PointIdList& queries, point_count_t k,
+        PointIdList& ids, std::vector<double> *sqrDists = nullptr,
+        size_t threads = 0) const
+    {
+        return neighborsBatch(gather(queries), k, ids, sqrDists, threads);
+    }
+
+    /// Batch form of radius(): find all points within r of each of the
+    /// packed x/y/z query points.  Queries run in Morton order across
+    /// threads, as with neighborsBatch().  Results are CSR-packed: the
+    /// neighbors of query q, sorted by distance, are ids[offsets[q]]
+    /// through ids[offsets[q + 1] - 1]; offsets holds one more entry
+    /// than there are queries.
+    void radiusBatch(const std::vector<double>& pts, double r,
+        std::vector<point_count_t>& offsets, PointIdList& ids,
+        size_t threads = 0) const
+    {
+        point_count_t nq = (point_count_t)(pts.size() / 3);
+        std::vector<PointIdList> results(nq);
+
+        std::vector<PointId> order = batchOrder(pts);
+        batchRun(nq, batchThreads(threads, nq),
+            [&](point_count_t begin, point_count_t end)
+        {
+            std::vector<std::pair<std::size_t, double>> matches;
+            for (point_count_t i = begin; i < end; ++i)
+            {
+                PointId q = order[i];
+                std::size_t count = radiusQuery(&pts[3 * q], r * r, matches);
+                PointIdList& out = results[q];
+                out.resize(count);
+                for (std::size_t j = 0; j < count; ++j)
+                    out[j] = matches[j].first;
+            }
+        });
+
+        offsets.resize(nq + 1);
+        offsets[0] = 0;
+        for (point_count_t q = 0; q < nq; ++q)
+            offsets[q + 1] = offsets[q] + results[q].size();
+        ids.resize(offsets[nq]);
+        for (point_count_t q = 0; q < nq; ++q)
+            std::copy(results[q].begin(), results[q].end(),
+                ids.begin() + offsets[q]);
+    }
+
+    /// Batch radius query of points of the indexed view.
+    void radiusBatch(const PointIdList& queries, double r,
+        std::vector<point_count_t>& offsets, PointIdList& ids,
+        size_t threads = 0) const
+    {
+        radiusBatch(gather(queries), r, offsets, ids, threads);
+    }
+
+private:
+    // Pack the coordinates of view points for the batch entry points.
+    std::vector<double> gather(const PointIdList& queries) const
+    {
+        std::vector<double> pts(queries.size() * 3);
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            pts[3 * i] = m_buf.getFieldAs<double>(Dimension::Id::X,
+                queries[i]);
+            pts[3 * i + 1] = m_buf.getFieldAs<double>(Dimension::Id::Y,
+                queries[i]);
+            pts[3 * i + 2] = m_buf.getFieldAs<double>(Dimension::Id::Z,
+                queries[i]);
+        }
+        return pts;
+    }
+
+    // Order in which to run batched queries: by Morton code of the
+    // quantized query position, so nearby queries - which visit largely
+    // the same tree nodes - run consecutively.
+    std::vector<PointId> batchOrder(const std::vector<double>& pts) const
+    {
+        point_count_t nq = (point_count_t)(pts.size() / 3);
+
+        double lo[3];
+        double hi[3];
+        for (int d = 0; d < 3; ++d)
+        {
+            lo[d] = (std::numeric_limits<double>::max)();
+            hi[d] = std::numeric_limits<double>::lowest();
+        }
+        for (point_count_t q = 0; q < nq; ++q)
+            for (int d = 0; d < 3; ++d)
+            {
+                lo[d] = (std::min)(lo[d], pts[3 * q + d]);
+                hi[d] = (std::max)(hi[d], pts[3 * q + d]);
+            }
+
+        // spread3() interleaves 21 bits per axis.
+        const double Cells = (double)((1 << 21) - 1);
+        double scale[3];
+        for (int d = 0; d < 3; ++d)
+            scale[d] = (hi[d] > lo[d]) ? Cells / (hi[d] - lo[d]) : 0;
+
+        std::vector<std::pair<uint64_t, PointId>> codes(nq);
+        for (point_count_t q = 0; q < nq; ++q)
+        {
+            uint32_t g[3];
+            for (int d = 0; d < 3; ++d)
+                g[d] = (uint32_t)((pts[3 * q + d] - lo[d]) * scale[d]);
+            codes[q] = { curve::mortonEncode(g[0], g[1], g[2]), q };
+        }
+        std::sort(codes.begin(), codes.end());
+
+        std::vector<PointId> order(nq);
+        for (point_count_t q = 0; q < nq; ++q)
+            order[q] = codes[q].second;
+        return order;
+    }
+
+    // Choose the thread count for a batch: one thread for small
+    // batches, otherwise the hardware concurrency.  Each query costs
+    // far more than a simple point scan, so the threshold is lower than
+    // the one the filters use for their own loops.
+    static size_t batchThreads(size_t threads, point_count_t nq)
+    {
+        return pdal::threadCount(threads, nq, 8192);
+    }
+
+    // Execute fn(begin, end) over [0, nq) split across threads.
+    template <typename F>
+    static void batchRun(point_count_t nq, size_t threads, F fn)
+    {
+        if (threads <= 1)
+        {
+            fn(0, nq);
+            return;
+        }
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t)
+            pool.emplace_back(fn, (point_count_t)(nq * t / threads),
+                (point_count_t)(nq * (t + 1) / threads));
+        for (auto& t : pool)
+            t.join();
+    }
 };
 
 class KDFlexIndex
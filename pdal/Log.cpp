@@ -45,6 +45,7 @@ Log::Log(std::string const& leaderString, std::string const& outputName,
         bool timing)
     : m_level(LogLevel::Warning)
     , m_deleteStreamOnCleanup(false)
+    , m_leader(leaderString)
     , m_timing(timing)
 {
     if (Utils::iequals(outputName, "stdlog"))
@@ -60,7 +61,6 @@ Log::Log(std::string const& leaderString, std::string const& outputName,
         m_log = Utils::createFile(outputName);
         m_deleteStreamOnCleanup = true;
     }
-    m_leaders.push(leaderString);
     if (m_timing)
         m_start = m_clock.now();
 }
@@ -69,10 +69,10 @@ Log::Log(std::string const& leaderString, std::string const& outputName,
 Log::Log(std::string const& leaderString, std::ostream* v, bool timing)
     : m_level(LogLevel::Error)
     , m_deleteStreamOnCleanup(false)
+    , m_leader(leaderString)
     , m_timing(timing)
 {
     m_log = v;
-    m_leaders.push(leaderString);
     if (m_timing)
         m_start = m_clock.now();
 }
@@ -35,9 +35,12 @@
 #pragma once
 
 #include <cassert>
+#include <map>
 #include <memory> // shared_ptr
+#include <mutex>
 #include <stack>
 #include <chrono>
+#include <thread>
 
 #include <pdal/pdal_internal.hpp>
 #include <pdal/util/NullOStream.hpp>
@@ -99,26 +102,47 @@ public:
         m_level = v;
     }
 
-    /// Set the leader string (deprecated).
+    /// Set the fallback leader string used by threads that have pushed
+    /// nothing (deprecated).
     /// \param[in]  leader  Leader string.
     void setLeader(const std::string& leader)
-        { pushLeader(leader); }
+    {
+        std::lock_guard<std::mutex> lock(m_leaderMutex);
+        m_leader = leader;
+    }
 
-    /// Push the leader string onto the stack.
+    /// Push a leader string onto the calling thread's stack.  Leader
+    /// stacks are per-thread so that concurrently executing stages (see
+    /// Stage::execute()) each tag their own messages.
     /// \param  leader  Leader string
     void pushLeader(const std::string& leader)
-        { m_leaders.push(leader); }
+    {
+        std::lock_guard<std::mutex> lock(m_leaderMutex);
+        m_leaders[std::this_thread::get_id()].push(leader);
+    }
 
     /// Get the leader string.
-    /// \return  The current leader string.
+    /// \return  The top of the calling thread's leader stack, or the
+    ///   construction-time leader when the thread has pushed nothing.
     std::string leader() const
-        { return m_leaders.empty() ? std::string() : m_leaders.top(); }
+    {
+        std::lock_guard<std::mutex> lock(m_leaderMutex);
+        auto it = m_leaders.find(std::this_thread::get_id());
+        return (it == m_leaders.end() || it->second.empty()) ?
+            m_leader : it->second.top();
+    }
 
-    /// Pop the current leader string.
+    /// Pop the calling thread's current leader string.
     void popLeader()
     {
-        if (!m_leaders.empty())
-            m_leaders.pop();
+        std::lock_guard<std::mutex> lock(m_leaderMutex);
+        auto it = m_leaders.find(std::this_thread::get_id());
+        if (it != m_leaders.end())
+        {
+            it->second.pop();
+            if (it->second.empty())
+                m_leaders.erase(it);
+        }
     }
 
     /// @return A string representing the LogLevel
@@ -155,7 +179,9 @@ private:
 
     LogLevel m_level;
     bool m_deleteStreamOnCleanup;
-    std::stack<std::string> m_leaders;
+    std::string m_leader;
+    std::map<std::thread::id, std::stack<std::string>> m_leaders;
+    mutable std::mutex m_leaderMutex;
     NullOStream m_nullStream;
     bool m_timing;
     std::chrono::steady_clock m_clock;
@@ -84,22 +84,34 @@ private:
         }
     }
 
+    // Once a list has been converted to an array, every node in it is
+    // marked, so later additions only need to mark themselves.  This
+    // keeps building a list of N siblings linear instead of quadratic.
+    void markArray(MetadataImplList& l, MetadataNodeImplPtr& node)
+    {
+        if (l.front()->m_kind != MetadataType::Array)
+            makeArray(l);
+        else
+            node->m_kind = MetadataType::Array;
+    }
+
     MetadataNodeImplPtr add(const std::string& name)
     {
         MetadataNodeImplPtr sub(new MetadataNodeImpl(name));
         MetadataImplList& l = m_subnodes[name];
         l.push_back(sub);
         if (l.size() > 1)
-            makeArray(l);
+            markArray(l, sub);
         return sub;
     }
 
     MetadataNodeImplPtr addList(const std::string& name)
     {
         MetadataNodeImplPtr sub(new MetadataNodeImpl(name));
+        sub->m_kind = MetadataType::Array;
         MetadataImplList& l = m_subnodes[name];
         l.push_back(sub);
-        makeArray(l);
+        markArray(l, sub);
         return sub;
     }
 
@@ -108,15 +120,16 @@ private:
         MetadataImplList& l = m_subnodes[node->m_name];
         l.push_back(node);
         if (l.size() > 1)
-            makeArray(l);
+            markArray(l, node);
         return node;
     }
 
     MetadataNodeImplPtr addList(MetadataNodeImplPtr node)
     {
+        node->m_kind = MetadataType::Array;
         MetadataImplList& l = m_subnodes[node->m_name];
         l.push_back(node);
-        makeArray(l);
+        markArray(l, node);
         return node;
     }
 
@@ -171,6 +184,12 @@ private:
     template <std::size_t N>
     inline void setValue(const char(& c)[N]);
 
+    void setValue(std::string&& s)
+    {
+        m_type = "string";
+        m_value = std::move(s);
+    }
+
     void setValue(const double& d, size_t precision);
 
     MetadataImplList& subnodes(const std::string &name)
@@ -476,6 +495,17 @@ public:
         return MetadataNode(impl);
     }
 
+    // Move overload - string values are frequently built in place
+    // (base64 blobs, formatted numbers) and don't need another copy.
+    MetadataNode add(const std::string& name, std::string&& value,
+        const std::string& descrip = std::string())
+    {
+        MetadataNodeImplPtr impl = m_impl->add(name);
+        impl->setValue(std::move(value));
+        impl->m_descrip = descrip;
+        return MetadataNode(impl);
+    }
+
     template<typename T>
     MetadataNode addList(const std::string& name, const T& value,
         const std::string& descrip = std::string())
@@ -486,6 +516,15 @@ public:
         return MetadataNode(impl);
     }
 
+    MetadataNode addList(const std::string& name, std::string&& value,
+        const std::string& descrip = std::string())
+    {
+        MetadataNodeImplPtr impl = m_impl->addList(name);
+        impl->setValue(std::move(value));
+        impl->m_descrip = descrip;
+        return MetadataNode(impl);
+    }
+
     MetadataNode addOrUpdate(const std::string& lname, const double& value,
         const std::string& descrip = std::string(), size_t precision = 10)
     {
@@ -600,6 +639,10 @@ public:
         MetadataNodeList outnodes;
 
         const MetadataSubnodes& nodes = m_impl->m_subnodes;
+        size_t count = 0;
+        for (auto si = nodes.begin(); si != nodes.end(); ++si)
+            count += si->second.size();
+        outnodes.reserve(count);
         for (auto si = nodes.begin(); si != nodes.end(); ++si)
         {
             const MetadataImplList& l = si->second;
@@ -617,6 +660,7 @@ public:
         if (si != m_impl->m_subnodes.end())
         {
             const MetadataImplList& l = si->second;
+            outnodes.reserve(l.size());
             for (auto li = l.begin(); li != l.end(); ++li)
                 outnodes.push_back(MetadataNode(*li));
         }
@@ -631,6 +675,7 @@ public:
         std::vector<std::string> names;
 
         MetadataSubnodes& nodes = m_impl->m_subnodes;
+        names.reserve(nodes.size());
         for (auto si = nodes.begin(); si != nodes.end(); ++si)
             names.push_back(si->first);
         return names;
@@ -85,6 +85,15 @@ void Options::add(const Option& option)
 }
 
 
+void Options::add(Option&& option)
+{
+    assert(Option::nameValid(option.getName(), true));
+    // Copy the key before moving from the option.
+    std::string name = option.getName();
+    m_options.insert(std::make_pair(std::move(name), std::move(option)));
+}
+
+
 void Options::add(const Options& o)
 {
     m_options.insert(o.m_options.begin(), o.m_options.end());
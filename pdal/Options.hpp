@@ -40,6 +40,7 @@
 
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace pdal
@@ -107,7 +108,7 @@ public:
     static bool nameValid(const std::string& name, bool reportError);
 
     /// @return the value of the Option.
-    std::string getValue() const
+    const std::string& getValue() const
         { return m_value; }
 
     bool empty() const;
@@ -133,6 +134,7 @@ public:
         { add(opt); }
 
     void add(const Option& option);
+    void add(Option&& option);
     void add(const Options& options);
     void addConditional(const Option& option);
     void addConditional(const Options& option);
@@ -146,6 +148,12 @@ public:
         add(option);
     }
 
+    void replace(Option&& option)
+    {
+        remove(option);
+        add(std::move(option));
+    }
+
     void toMetadata(MetadataNode& parent) const
     {
         for (std::string& k : getKeys())
@@ -170,38 +178,32 @@ public:
     // add an option (shortcut version, bypass need for an Option object)
     template<typename T> void add(const std::string& name, T value)
     {
-        Option opt(name, value);
-        add(opt);
+        add(Option(name, value));
     }
 
     void add(const std::string& name, const std::string& value)
     {
-        Option opt(name, value);
-        add(opt);
+        add(Option(name, value));
     }
 
     void add(const std::string& name, const bool& value)
     {
-        Option opt(name, value);
-        add(opt);
+        add(Option(name, value));
     }
 
     template<typename T> void replace(const std::string& name, T value)
     {
-        Option opt(name, value);
-        replace(opt);
+        replace(Option(name, value));
     }
 
     void replace(const std::string& name, const std::string& value)
     {
-        Option opt(name, value);
-        replace(opt);
+        replace(Option(name, value));
     }
 
     void replace(const std::string& name, const bool& value)
     {
-        Option opt(name, value);
-        replace(opt);
+        replace(Option(name, value));
     }
 
     StringList getValues(const std::string& name) const
@@ -226,6 +228,13 @@ public:
         return keys;
     }
 
+    // Allow iteration over the contained options without copying them.
+    // Entries are keyed by option name.
+    std::multimap<std::string, Option>::const_iterator begin() const
+        { return m_options.begin(); }
+    std::multimap<std::string, Option>::const_iterator end() const
+        { return m_options.end(); }
+
     std::vector<Option> getOptions(std::string const& name="") const;
     StringList toCommandLine() const;
     static Options fromFile(const std::string& filename,
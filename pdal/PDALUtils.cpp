@@ -41,6 +41,9 @@
 #include <pdal/PointView.hpp>
 #include <pdal/Options.hpp>
 #include <pdal/util/FileUtils.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+#include <algorithm>
 
 using namespace std;
 
@@ -212,7 +215,7 @@ public:
     virtual ~ArbiterOutStream()
     {
         close();
-        arbiter::Arbiter a;
+        arbiter::Arbiter& a = globalArbiter();
         a.put(m_remotePath, a.getBinary(m_localFile.filename()));
     }
 
@@ -227,7 +230,7 @@ public:
             std::ios::openmode mode) :
         m_localFile(localPath)
     {
-        arbiter::Arbiter a;
+        arbiter::Arbiter& a = globalArbiter();
         a.put(localPath, a.getBinary(remotePath));
         open(localPath, mode);
     }
@@ -250,8 +253,7 @@ std::ostream *createFile(const std::string& path, bool asBinary)
 
     if (isRemote(path))
     {
-        arbiter::Arbiter a;
-        if (!a.hasDriver(path))
+        if (!globalArbiter().hasDriver(path))
             return ofs;
         try
         {
@@ -292,20 +294,61 @@ bool isRemote(const std::string& path)
 }
 
 
+/**
+  Return the arbiter instance shared by all remote file access in the
+  process.  Reusing one instance keeps its HTTP connections (and TLS
+  sessions) alive across requests instead of reconnecting per call.
+*/
+arbiter::Arbiter& globalArbiter()
+{
+    static arbiter::Arbiter arbiter;
+    return arbiter;
+}
+
+
 std::string fetchRemote(const std::string& path)
 {
     std::string temp = tempFilename(path);
-    arbiter::Arbiter a;
+    arbiter::Arbiter& a = globalArbiter();
     a.put(temp, a.getBinary(path));
     return temp;
 }
 
+
+/**
+  Fetch several remote files concurrently, staging each to a local temp
+  file as fetchRemote() does.  Returns the local path for each input in
+  order; non-remote paths are passed through untouched.  Useful for
+  warming the inputs of a multi-file pipeline while latency, not
+  bandwidth, is the bottleneck.
+*/
+std::vector<std::string> prefetchRemote(const std::vector<std::string>& paths,
+    unsigned threads)
+{
+    std::vector<std::string> local(paths.size());
+
+    ThreadPool pool((std::max)(threads, 1u));
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        if (!isRemote(paths[i]))
+        {
+            local[i] = paths[i];
+            continue;
+        }
+        pool.add([&paths, &local, i]()
+            { local[i] = fetchRemote(paths[i]); });
+    }
+    pool.join();
+    if (pool.errors().size())
+        throw pdal_error("prefetchRemote: " + pool.errors().front());
+    return local;
+}
+
 std::istream *openFile(const std::string& path, bool asBinary)
 {
     if (isRemote(path))
     {
-        arbiter::Arbiter a;
-        if (!a.hasDriver(path))
+        if (!globalArbiter().hasDriver(path))
             return nullptr;
         try
         {
@@ -352,7 +395,7 @@ bool fileExists(const std::string& path)
 {
     if (isRemote(path))
     {
-        arbiter::Arbiter a;
+        arbiter::Arbiter& a = globalArbiter();
         return (a.hasDriver(path) && a.exists(path));
     }
 
@@ -360,6 +403,44 @@ bool fileExists(const std::string& path)
     return FileUtils::fileExists(path);
 }
 
+namespace
+{
+
+// Largest squared distance from any point of 'view' to its nearest
+// neighbor in 'index'.  The queries are read-only, so the view is
+// swept in slices across a pool; the max reduction is exact regardless
+// of the split.
+double maxNearestSqrDist(PointViewPtr view, KD3Index& index)
+{
+    point_count_t np = view->size();
+
+    size_t threads = threadCount(0, np);
+
+    std::vector<double> maxes(threads,
+        std::numeric_limits<double>::lowest());
+
+    ThreadPool pool(threads);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&view, &index, &maxes, t, threads, np]()
+        {
+            PointId start = np * t / threads;
+            PointId end = np * (t + 1) / threads;
+            PointIdList indices(1);
+            std::vector<double> sqr_dists(1);
+            for (PointId i = start; i < end; ++i)
+            {
+                PointRef point = view->point(i);
+                index.knnSearch(point, 1, &indices, &sqr_dists);
+                maxes[t] = (std::max)(maxes[t], sqr_dists[0]);
+            }
+        });
+    pool.join();
+
+    return *std::max_element(maxes.begin(), maxes.end());
+}
+
+} // unnamed namespace
+
 double computeHausdorff(PointViewPtr srcView, PointViewPtr candView)
 {
     using namespace Dimension;
@@ -370,30 +451,8 @@ double computeHausdorff(PointViewPtr srcView, PointViewPtr candView)
     KD3Index candIndex(*candView);
     candIndex.build();
 
-    double maxDistSrcToCand = std::numeric_limits<double>::lowest();
-    double maxDistCandToSrc = std::numeric_limits<double>::lowest();
-
-    for (PointId i = 0; i < srcView->size(); ++i)
-    {
-        PointIdList indices(1);
-        std::vector<double> sqr_dists(1);
-        PointRef srcPoint = srcView->point(i);
-        candIndex.knnSearch(srcPoint, 1, &indices, &sqr_dists);
-
-        if (sqr_dists[0] > maxDistSrcToCand)
-            maxDistSrcToCand = sqr_dists[0];
-    }
-
-    for (PointId i = 0; i < candView->size(); ++i)
-    {
-        PointIdList indices(1);
-        std::vector<double> sqr_dists(1);
-        PointRef candPoint = candView->point(i);
-        srcIndex.knnSearch(candPoint, 1, &indices, &sqr_dists);
-
-        if (sqr_dists[0] > maxDistCandToSrc)
-            maxDistCandToSrc = sqr_dists[0];
-    }
+    double maxDistSrcToCand = maxNearestSqrDist(srcView, candIndex);
+    double maxDistCandToSrc = maxNearestSqrDist(candView, srcIndex);
 
     maxDistSrcToCand = std::sqrt(maxDistSrcToCand);
     maxDistCandToSrc = std::sqrt(maxDistCandToSrc);
@@ -52,6 +52,11 @@ namespace pdal
 class Options;
 class PointView;
 
+namespace arbiter
+{
+    class Arbiter;
+}
+
 typedef std::shared_ptr<PointView> PointViewPtr;
 
 namespace Utils
@@ -269,7 +274,10 @@ std::ostream PDAL_DLL *createFile(const std::string& path,
 void PDAL_DLL closeFile(std::istream *in);
 void PDAL_DLL closeFile(std::ostream *out);
 std::string PDAL_DLL fetchRemote(const std::string& path);
+std::vector<std::string> PDAL_DLL prefetchRemote(
+    const std::vector<std::string>& paths, unsigned threads = 4);
 bool PDAL_DLL isRemote(const std::string& path);
+arbiter::Arbiter PDAL_DLL & globalArbiter();
 bool PDAL_DLL fileExists(const std::string& path);
 std::vector<std::string> PDAL_DLL maybeGlob(const std::string& path);
 double PDAL_DLL computeHausdorff(PointViewPtr srcView, PointViewPtr candView);
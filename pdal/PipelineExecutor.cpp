@@ -34,6 +34,7 @@
 
 #include <pdal/PipelineExecutor.hpp>
 #include <pdal/PDALUtils.hpp>
+#include <pdal/Stage.hpp>
 
 namespace pdal
 {
@@ -41,12 +42,48 @@ namespace pdal
 
 PipelineExecutor::PipelineExecutor(std::string const& json)
     : m_json(json)
+    , m_prepared(false)
     , m_executed(false)
     , m_logLevel(pdal::LogLevel::Error)
 {
 }
 
 
+void PipelineExecutor::prepare()
+{
+    if (m_prepared)
+        return;
+
+    std::stringstream strm;
+    strm << m_json;
+    m_manager.readPipeline(strm);
+    m_manager.prepare();
+    m_prepared = true;
+}
+
+
+void PipelineExecutor::setStageOption(std::string const& stage,
+    std::string const& name, std::string const& value)
+{
+    prepare();
+
+    Options ops;
+    ops.add(name, value);
+
+    bool found = false;
+    for (Stage *s : m_manager.stages())
+        if (s->tag() == stage || s->getName() == stage)
+        {
+            s->removeOptions(ops);
+            s->addOptions(ops);
+            found = true;
+        }
+    if (!found)
+        throw pdal_error("No stage with tag or name '" + stage +
+            "' in pipeline!");
+}
+
+
 std::string PipelineExecutor::getPipeline() const
 {
     if (!m_executed)
@@ -84,19 +121,25 @@ std::string PipelineExecutor::getSchema() const
 
 bool PipelineExecutor::validate()
 {
-    std::stringstream strm;
-    strm << m_json;
-    m_manager.readPipeline(strm);
-    m_manager.prepare();
+    prepare();
 
     return true;
 }
 
 int64_t PipelineExecutor::execute()
 {
-    std::stringstream strm;
-    strm << m_json;
-    m_manager.readPipeline(strm);
+    if (m_executed)
+    {
+        // Re-execution of a prepared pipeline: drop the previous run's
+        // point storage and re-prepare the existing stages so changed
+        // options (see setStageOption()) take effect.  JSON parsing and
+        // stage construction aren't repeated.
+        m_manager.reset();
+        m_manager.prepare();
+    }
+    else
+        prepare();
+
     point_count_t count = m_manager.execute();
 
     m_executed = true;
@@ -67,12 +67,39 @@ public:
     ~PipelineExecutor(){};
 
     /**
-      Execute the pipeline
+      Parse the pipeline JSON, construct the stages and prepare them.
+      Called implicitly by execute() and validate(); calling it again
+      is a no-op, so the parse and stage construction happen once no
+      matter how many times the pipeline runs.
+    */
+    void prepare();
+
+    /**
+      Execute the pipeline.  The first execution prepares the pipeline;
+      later ones re-execute the already-constructed stages against a
+      fresh point table, skipping JSON parsing, stage construction and
+      option parsing.  Use setStageOption() to substitute new inputs or
+      outputs between runs.
 
       \return total number of points produced by the pipeline.
     */
     int64_t execute();
 
+    /**
+      Replace an option on a prepared pipeline's stages before
+      re-execution - typically a reader or writer filename when the
+      same pipeline is run over many tiles.  The option is applied to
+      every stage whose tag or driver name matches \c stage and takes
+      effect at the next execute().
+
+      \param stage  Tag or driver name (e.g. "readers.las") of the
+        stage(s) to modify.
+      \param name  Option name.
+      \param value  Option value.
+    */
+    void setStageOption(std::string const& stage, std::string const& name,
+        std::string const& value);
+
     /**
       Validate the pipeline
 
@@ -135,6 +162,7 @@ private:
 
     std::string m_json;
     pdal::PipelineManager m_manager;
+    bool m_prepared;
     bool m_executed;
     std::stringstream m_logStream;
     pdal::LogLevel m_logLevel;
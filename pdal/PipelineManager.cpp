@@ -32,7 +32,10 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <fstream>
+
 #include <pdal/PipelineManager.hpp>
+#include <pdal/Reader.hpp>
 #include <pdal/StageFactory.hpp>
 #include <pdal/PipelineReaderJSON.hpp>
 #include <pdal/PDALUtils.hpp>
@@ -46,11 +49,16 @@ namespace pdal
 
 PipelineManager::PipelineManager(point_count_t streamLimit) :
     m_factory(new StageFactory),
-    m_tablePtr(new PointTable()), m_table(*m_tablePtr),
-    m_streamTablePtr(new FixedPointTable(streamLimit)),
+    m_tablePtr(new PointTable()),
+    m_streamTablePtr(new DoubleBufferedPointTable(streamLimit)),
     m_streamTable(*m_streamTablePtr),
+    m_memoryLimit(0), m_lastPrepTable(nullptr), m_lastPrepFingerprint(0),
     m_progressFd(-1), m_input(nullptr)
-{}
+{
+    std::string limit;
+    if (Utils::getenv("PDAL_MEMORY_LIMIT", limit) == 0 && limit.size())
+        Utils::fromString(limit, m_memoryLimit);
+}
 
 
 PipelineManager::~PipelineManager()
@@ -109,6 +117,15 @@ pdal_error stageError(const std::string& cls, const std::string& type)
     return pdal_error(ss.str());
 }
 
+// True if 'src' is among the transitive inputs of 'dst'.
+bool feeds(Stage *src, Stage *dst)
+{
+    for (Stage *s : dst->getInputs())
+        if (s == src || feeds(src, s))
+            return true;
+    return false;
+}
+
 }
 
 void PipelineManager::setLog(const LogPtr& log)
@@ -125,6 +142,8 @@ Stage& PipelineManager::addReader(const std::string& type)
     reader->setLog(m_log);
     reader->setProgressFd(m_progressFd);
     m_stages.push_back(reader);
+    // The pipeline changed - any previous preparation is stale.
+    m_lastPrepTable = nullptr;
     return *reader;
 }
 
@@ -137,6 +156,7 @@ Stage& PipelineManager::addFilter(const std::string& type)
     filter->setLog(m_log);
     filter->setProgressFd(m_progressFd);
     m_stages.push_back(filter);
+    m_lastPrepTable = nullptr;
     return *filter;
 }
 
@@ -149,6 +169,7 @@ Stage& PipelineManager::addWriter(const std::string& type)
     writer->setLog(m_log);
     writer->setProgressFd(m_progressFd);
     m_stages.push_back(writer);
+    m_lastPrepTable = nullptr;
     return *writer;
 }
 
@@ -199,12 +220,260 @@ QuickInfo PipelineManager::preview() const
 }
 
 
+// A selection filter drops points; a transform rewrites them.  When a
+// selection directly follows a transform and consults none of the
+// dimensions the transform rewrites, the two commute, and running the
+// selection first avoids transforming points that are about to be
+// discarded.  Both stages must process points independently for the
+// swap to be safe, which is what Stage::selectionDims() and
+// Stage::mutatedDims() assert.  Each swap moves a selection one stage
+// upstream, so the sweep repeats until nothing moves, hoisting
+// selections past chains of transforms.  Runs before prepare(), so
+// stages report from their options.
+void PipelineManager::applyFilterReorder() const
+{
+    auto sweep = [this]()
+    {
+        bool moved = false;
+        for (Stage *f : m_stages)
+        {
+            if (f->getInputs().size() != 1)
+                continue;
+            Stage *t = f->getInputs()[0];
+            if (t->getInputs().size() != 1)
+                continue;
+
+            // The transform's output can't go anywhere else.
+            bool sole = true;
+            for (Stage *d : m_stages)
+            {
+                if (d == f)
+                    continue;
+                const std::vector<Stage *>& inputs = d->getInputs();
+                if (std::find(inputs.begin(), inputs.end(), t) !=
+                        inputs.end())
+                    sole = false;
+            }
+            if (!sole)
+                continue;
+
+            StringList sel;
+            StringList mut;
+            if (!f->selectionDims(sel) || !t->mutatedDims(mut))
+                continue;
+            // Dimension names are case-insensitive and stages report
+            // the user's spelling, so compare canonicalized names.
+            for (std::string& dim : sel)
+                dim = Utils::toupper(dim);
+            for (std::string& dim : mut)
+                dim = Utils::toupper(dim);
+            bool disjoint = true;
+            for (const std::string& dim : sel)
+                if (std::find(mut.begin(), mut.end(), dim) != mut.end())
+                    disjoint = false;
+            if (!disjoint)
+                continue;
+
+            // Rewire upstream -> transform -> selection -> consumers
+            // into upstream -> selection -> transform -> consumers.
+            // Consumers are repointed first, while the graph still
+            // shows them feeding from the selection.
+            Stage *upstream = t->getInputs()[0];
+            for (Stage *d : m_stages)
+            {
+                if (d == t)
+                    continue;
+                std::vector<Stage *>& inputs = d->getInputs();
+                std::replace(inputs.begin(), inputs.end(), f, t);
+            }
+            t->getInputs()[0] = f;
+            f->getInputs()[0] = upstream;
+            moved = true;
+            if (m_log)
+                m_log->get(LogLevel::Debug) << "Moved " << f->getName() <<
+                    " ahead of " << t->getName() <<
+                    ": its selection doesn't depend on the transform.\n";
+        }
+        return moved;
+    };
+
+    while (sweep())
+        ;
+}
+
+
+// If every stage downstream of a reader can enumerate the dimensions it
+// uses, tell the reader so it can skip loading the rest.  Runs before
+// prepare(), so stages report from their options (see Stage::usedDims()).
+void PipelineManager::applyDimPushdown() const
+{
+    for (Stage *s : m_stages)
+    {
+        Reader *r = dynamic_cast<Reader *>(s);
+        if (!r || s->getInputs().size())
+            continue;
+
+        StringList used;
+        bool found = false;
+        bool known = true;
+        for (Stage *d : m_stages)
+        {
+            if (d == s || !feeds(s, d))
+                continue;
+            found = true;
+            if (!d->usedDims(used))
+            {
+                known = false;
+                break;
+            }
+        }
+        if (found && known)
+            r->pushdownDims(used);
+    }
+}
+
+
+// If every stage that directly consumes a reader's output crops to a
+// known region, tell the reader so it can skip data that can't
+// intersect it.  Only direct consumers count: a point outside all of
+// their bounds is discarded before it reaches anything else.  Runs
+// before prepare(), so stages report from their options (see
+// Stage::cropBounds()).
+void PipelineManager::applyBoundsPushdown() const
+{
+    for (Stage *s : m_stages)
+    {
+        Reader *r = dynamic_cast<Reader *>(s);
+        if (!r || s->getInputs().size())
+            continue;
+
+        std::vector<Bounds> bounds;
+        bool found = false;
+        bool known = true;
+        for (Stage *d : m_stages)
+        {
+            const std::vector<Stage *>& inputs = d->getInputs();
+            if (std::find(inputs.begin(), inputs.end(), s) == inputs.end())
+                continue;
+            found = true;
+            if (!d->cropBounds(bounds))
+            {
+                known = false;
+                break;
+            }
+        }
+        if (found && known)
+            r->pushdownBounds(bounds);
+    }
+}
+
+
+// If every stage that directly consumes a reader's output discards
+// points outside known per-dimension value intervals, tell the reader
+// so it can skip data whose statistics prove no point qualifies.  Runs
+// before prepare(), so stages report from their options (see
+// Stage::rangeBounds()).
+void PipelineManager::applyRangePushdown() const
+{
+    for (Stage *s : m_stages)
+    {
+        Reader *r = dynamic_cast<Reader *>(s);
+        if (!r || s->getInputs().size())
+            continue;
+
+        std::vector<DimInterval> merged;
+        bool found = false;
+        bool known = true;
+        for (Stage *d : m_stages)
+        {
+            const std::vector<Stage *>& inputs = d->getInputs();
+            if (std::find(inputs.begin(), inputs.end(), s) == inputs.end())
+                continue;
+
+            std::vector<DimInterval> ranges;
+            if (!d->rangeBounds(ranges))
+            {
+                known = false;
+                break;
+            }
+            if (!found)
+                merged = ranges;
+            else
+            {
+                // A point surviving any consumer matters, so keep only
+                // the dimensions every consumer constrains, widened to
+                // cover each consumer's interval.
+                std::vector<DimInterval> common;
+                for (const DimInterval& m : merged)
+                    for (const DimInterval& c : ranges)
+                        if (m.m_name == c.m_name)
+                        {
+                            common.push_back({ m.m_name,
+                                (std::min)(m.m_min, c.m_min),
+                                (std::max)(m.m_max, c.m_max) });
+                            break;
+                        }
+                merged = common;
+            }
+            found = true;
+        }
+        if (found && known && merged.size())
+            r->pushdownRanges(merged);
+    }
+}
+
+
 void PipelineManager::prepare() const
 {
     validateStageOptions();
+    applyFilterReorder();
+    applyDimPushdown();
+    applyBoundsPushdown();
+    applyRangePushdown();
     Stage *s = getStage();
     if (s)
-       s->prepare(m_table);
+    {
+        s->prepare(*m_tablePtr);
+        m_lastPrepTable = m_tablePtr.get();
+        m_lastPrepFingerprint = m_tablePtr->layout()->fingerprint();
+    }
+}
+
+
+// Prepare the graph rooted at s against the given table, skipping the work
+// when the same table was already prepared and its layout fingerprint is
+// unchanged.  prepare() followed by execute() otherwise prepares every
+// stage twice, and a merge-heavy pipeline pays for the full schema
+// negotiation each time.  An explicit prepare() call always re-prepares.
+void PipelineManager::prepareTable(Stage *s, PointTableRef table) const
+{
+    if (&table == m_lastPrepTable &&
+        table.layout()->fingerprint() == m_lastPrepFingerprint)
+        return;
+    s->prepare(table);
+    m_lastPrepTable = &table;
+    m_lastPrepFingerprint = table.layout()->fingerprint();
+}
+
+
+// Estimate the bytes needed to hold every point in memory, from reader
+// previews.  Dimension sizes aren't known until the layout is
+// finalized, so each dimension is costed at 8 bytes (nearly all are 8
+// or fewer).  Returns 0 when any root reader can't say.
+uintmax_t PipelineManager::estimatePointMemory() const
+{
+    uintmax_t total = 0;
+    for (Stage *s : m_stages)
+    {
+        Reader *r = dynamic_cast<Reader *>(s);
+        if (!r || s->getInputs().size())
+            continue;
+        QuickInfo qi = r->preview();
+        if (!qi.valid())
+            return 0;
+        total += (uintmax_t)qi.m_pointCount * qi.m_dimNames.size() * 8;
+    }
+    return total;
 }
 
 
@@ -213,10 +482,38 @@ PipelineManager::ExecResult PipelineManager::execute(ExecMode mode)
     ExecResult result;
 
     validateStageOptions();
+    applyFilterReorder();
+    applyDimPushdown();
+    applyBoundsPushdown();
+    applyRangePushdown();
     Stage *s = getStage();
     if (!s)
         return result;
-                
+
+    // With a memory budget set, a pipeline estimated not to fit runs
+    // chunked when it can stream, and against a disk-backed table when
+    // it can't.
+    if (m_memoryLimit && mode == ExecMode::Standard)
+    {
+        uintmax_t est = estimatePointMemory();
+        if (est > m_memoryLimit)
+        {
+            if (s->pipelineStreamable())
+                mode = ExecMode::PreferStream;
+            else
+            {
+                m_tablePtr.reset(new MmapPointTable());
+                m_lastPrepTable = nullptr;
+            }
+            if (m_log)
+                m_log->get(LogLevel::Debug) << "Estimated point storage (" <<
+                    est << " bytes) exceeds memory limit (" << m_memoryLimit <<
+                    " bytes); " << (mode == ExecMode::PreferStream ?
+                        "running in stream mode." :
+                        "spilling point storage to disk.") << "\n";
+        }
+    }
+
     if (mode == ExecMode::PreferStream)
     {
         // If a pipeline isn't streamable before being prepared, it's not
@@ -229,7 +526,7 @@ PipelineManager::ExecResult PipelineManager::execute(ExecMode mode)
 
         // After prepare a pipeline that was streamable might become
         // non-streamable due to some options.
-        s->prepare(m_streamTable);
+        prepareTable(s, m_streamTable);
         if (!s->pipelineStreamable())
         {
             // Note that in this case we've prepared the stream
@@ -239,7 +536,7 @@ PipelineManager::ExecResult PipelineManager::execute(ExecMode mode)
             goto next;
         }
         // We can stream.
-        s->execute(m_streamTable);
+        runStreamed(s, m_streamTable);
         result.m_mode = ExecMode::Stream;
         return result;
     }
@@ -249,21 +546,27 @@ PipelineManager::ExecResult PipelineManager::execute(ExecMode mode)
     {
         if (s->pipelineStreamable())
         {
-            s->prepare(m_streamTable);
-            s->execute(m_streamTable);
+            prepareTable(s, m_streamTable);
+            runStreamed(s, m_streamTable);
             result.m_mode = ExecMode::Stream;
         }
     }
     else if (mode == ExecMode::Standard)
     {
-        s->prepare(m_table);
-        m_viewSet = s->execute(m_table);
+        prepareTable(s, *m_tablePtr);
+        m_viewSet = s->execute(*m_tablePtr);
         point_count_t cnt = 0;
+        uintmax_t viewBytes = 0;
         for (auto pi = m_viewSet.begin(); pi != m_viewSet.end(); ++pi)
         {
             PointViewPtr view = *pi;
             cnt += view->size();
+            viewBytes += view->allocated();
         }
+        if (m_log)
+            m_log->get(LogLevel::Debug) << "Point storage: " <<
+                m_tablePtr->allocated() << " bytes; view indexes: " <<
+                viewBytes << " bytes.\n";
         result = { ExecMode::Standard, cnt };
     }
     return result;
@@ -279,12 +582,83 @@ point_count_t PipelineManager::execute()
 void PipelineManager::executeStream(StreamPointTable& table)
 {
     validateStageOptions();
+    applyFilterReorder();
+    applyDimPushdown();
+    applyBoundsPushdown();
+    applyRangePushdown();
     Stage *s = getStage();
     if (!s)
         return;
 
-    s->prepare(table);
-    s->execute(table);
+    prepareTable(s, table);
+    runStreamed(s, table);
+}
+
+
+// Execute a prepared, streamable pipeline, persisting and honoring a
+// checkpoint when one is configured (see setCheckpoint()).
+void PipelineManager::runStreamed(Stage *s, StreamPointTable& table)
+{
+    if (m_checkpointFile.empty())
+    {
+        s->execute(table);
+        return;
+    }
+
+    // Resume where an interrupted run stopped when the checkpoint
+    // records a position and the pipeline's single reader can seek
+    // to it.
+    point_count_t done = 0;
+    if (FileUtils::fileExists(m_checkpointFile))
+    {
+        point_count_t pos;
+        std::ifstream in(m_checkpointFile);
+
+        if (in >> pos)
+        {
+            const std::vector<Stage *> rlist = roots();
+            Reader *r = (rlist.size() == 1) ?
+                dynamic_cast<Reader *>(rlist[0]) : nullptr;
+            if (r && r->resumable())
+            {
+                r->resumeAt(pos);
+                done = pos;
+                if (m_log)
+                    m_log->get(LogLevel::Debug) << "Resuming " <<
+                        r->getName() << " at point " << pos <<
+                        " recorded in checkpoint '" << m_checkpointFile <<
+                        "'.\n";
+            }
+            else if (m_log)
+                m_log->get(LogLevel::Warning) << "Ignoring checkpoint '" <<
+                    m_checkpointFile << "': the pipeline's input can't "
+                    "resume mid-file.\n";
+        }
+    }
+
+    // After each chunk is consumed, rewrite the checkpoint with the
+    // number of points handled so far.  Write-then-rename so that a
+    // run killed mid-write can't leave a torn checkpoint behind.
+    std::string tmpname = m_checkpointFile + ".tmp";
+    table.setChunkCb([this, &done, &tmpname](point_count_t count)
+    {
+        done += count;
+        std::ofstream out(tmpname, std::ios::trunc);
+        out << done << "\n";
+        out.close();
+        FileUtils::renameFile(m_checkpointFile, tmpname);
+    });
+    try
+    {
+        s->execute(table);
+    }
+    catch (...)
+    {
+        table.setChunkCb(nullptr);
+        throw;
+    }
+    table.setChunkCb(nullptr);
+    FileUtils::deleteFile(m_checkpointFile);
 }
 
 
@@ -300,6 +674,30 @@ MetadataNode PipelineManager::getMetadata() const
 }
 
 
+MetadataNode PipelineManager::getMetrics() const
+{
+    MetadataNode output("metrics");
+
+    for (auto s : m_stages)
+    {
+        const Stage::Metrics& m = s->metrics();
+
+        MetadataNode node = output.addList("stage");
+        node.add("name", s->getName());
+        if (s->tag().size())
+            node.add("tag", s->tag());
+        node.add("wall_seconds", m.m_wallSecs);
+        node.add("points", m.m_points);
+        node.add("points_per_second", m.pointsPerSecond());
+        node.add("peak_rss", m.m_peakRss);
+        node.add("table_growth_bytes", m.m_tableGrowth);
+        node.add("table_growth_events", m.m_growthEvents);
+        node.add("peak_table_bytes", m.m_peakTableBytes);
+    }
+    return output;
+}
+
+
 Stage& PipelineManager::makeReader(const std::string& inputFile,
     std::string driver)
 {
@@ -501,6 +899,7 @@ std::vector<Stage *> PipelineManager::leaves() const
 void PipelineManager::replace(Stage *sOld, Stage *sNew)
 {
     Utils::remove(m_stages, sNew);
+    m_lastPrepTable = nullptr;
     for (Stage * & s : m_stages)
     {
         if (s == sOld)
@@ -74,7 +74,11 @@ public:
         point_count_t m_count;
     };
 
-    PipelineManager(point_count_t streamLimit = 10000);
+    /// \param streamLimit  Stream-mode chunk capacity in points.  The
+    ///   default of 0 sizes chunks automatically from the layout's point
+    ///   size once the pipeline is prepared, targeting cache-resident
+    ///   chunk buffers.
+    PipelineManager(point_count_t streamLimit = 0);
     ~PipelineManager();
 
     void setProgressFd(int fd)
@@ -122,6 +126,31 @@ public:
     // Set the log to be available to stages.
     void setLog(const LogPtr& log);
 
+    /// Set a cap, in bytes, on the memory the pipeline should use for
+    /// point storage.  A standard-mode run whose reader previews
+    /// estimate more than the cap is executed in stream mode when the
+    /// pipeline supports it, and against a disk-backed table (see
+    /// MmapPointTable) when it doesn't.  0 (the default) disables the
+    /// budget.  Initialized from the PDAL_MEMORY_LIMIT environment
+    /// variable when set.
+    void setMemoryLimit(uintmax_t bytes)
+        { m_memoryLimit = bytes; }
+    uintmax_t memoryLimit() const
+        { return m_memoryLimit; }
+
+    /// Enable checkpoint/resume for streamed execution.  While a
+    /// streamed run executes, the number of points consumed so far is
+    /// persisted to \a filename after each chunk.  If the file already
+    /// exists when execution starts and the pipeline's reader can seek
+    /// (see Reader::resumable()), reading resumes at the recorded
+    /// position instead of the beginning.  The file is removed when the
+    /// run completes, so an interrupted run leaves its position behind
+    /// for the next one.  A resumed run produces only the remaining
+    /// points - combining its output with that of the interrupted run
+    /// is up to the caller.  Standard-mode execution is unaffected.
+    void setCheckpoint(const std::string& filename)
+        { m_checkpointFile = filename; }
+
     QuickInfo preview() const;
     void prepare() const;
     ExecResult execute(ExecMode mode);
@@ -136,9 +165,10 @@ public:
 
     // Get the point table data.
     PointTableRef pointTable() const
-        { return m_table; }
+        { return *m_tablePtr; }
 
     MetadataNode getMetadata() const;
+    MetadataNode getMetrics() const;
     Options& commonOptions()
         { return m_commonOptions; }
     OptionsMap& stageOptions()
@@ -151,18 +181,41 @@ public:
         { return m_stages; }
     void destroyStage(Stage *s = nullptr);
 
+    /// Discard the point storage and views of a previous run so the
+    /// pipeline can be executed again with its existing stages (see
+    /// PipelineExecutor for prepared re-execution).
+    void reset()
+    {
+        m_viewSet.clear();
+        m_tablePtr.reset(new PointTable());
+        m_lastPrepTable = nullptr;
+    }
+
 private:
     void setOptions(Stage& stage, const Options& addOps);
     Options stageOptions(Stage& stage);
+    void applyFilterReorder() const;
+    void applyDimPushdown() const;
+    void applyBoundsPushdown() const;
+    void applyRangePushdown() const;
+    uintmax_t estimatePointMemory() const;
+    void prepareTable(Stage *s, PointTableRef table) const;
+    void runStreamed(Stage *s, StreamPointTable& table);
 
     std::unique_ptr<StageFactory> m_factory;
-    std::unique_ptr<PointTable> m_tablePtr;
-    PointTableRef m_table;
-    std::unique_ptr<FixedPointTable> m_streamTablePtr;
+    std::unique_ptr<BasePointTable> m_tablePtr;
+    std::unique_ptr<StreamPointTable> m_streamTablePtr;
     StreamPointTable& m_streamTable;
     Options m_commonOptions;
     OptionsMap m_stageOptions;
     PointViewSet m_viewSet;
+    uintmax_t m_memoryLimit;
+    std::string m_checkpointFile;
+    // Table last prepared and its layout fingerprint at that time, so
+    // execution can skip re-preparing an unchanged pipeline (see
+    // prepareTable()).  Mutable because prepare() is const.
+    mutable BasePointTable *m_lastPrepTable;
+    mutable uint64_t m_lastPrepFingerprint;
     std::vector<Stage*> m_stages; // stage observer, never owner
     int m_progressFd;
     std::istream *m_input;
@@ -36,12 +36,34 @@
 #include <pdal/util/FileUtils.hpp>
 #include <pdal/pdal_config.hpp>
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
 namespace pdal
 {
 
 namespace
 {
 
+const std::string manifestHeader("pdal plugin manifest 1");
+
+// Modification time as a sortable/comparable string.  Missing paths
+// stat to a zeroed tm, which compares consistently.
+std::string fileTimestamp(const std::string& path)
+{
+    struct tm mod;
+    std::memset(&mod, 0, sizeof(mod));
+    FileUtils::fileTimes(path, nullptr, &mod);
+
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%04d%02d%02d%02d%02d%02d",
+        mod.tm_year + 1900, mod.tm_mon + 1, mod.tm_mday, mod.tm_hour,
+        mod.tm_min, mod.tm_sec);
+    return buf;
+}
+
 StringList pluginSearchPaths()
 {
     StringList searchPaths;
@@ -116,7 +138,24 @@ std::string validPlugin(const std::string& path, const StringList& types)
 
 PluginDirectory::PluginDirectory()
 {
-    for (const auto& dir : pluginSearchPaths())
+    StringList dirs = pluginSearchPaths();
+
+    // Short-lived processes can skip the directory scans by pointing
+    // PDAL_PLUGIN_MANIFEST at a cache file.  The manifest records the
+    // modification time of each search directory, so a stale cache is
+    // detected with one stat per directory and rebuilt.
+    std::string manifest;
+    Utils::getenv("PDAL_PLUGIN_MANIFEST", manifest);
+    if (manifest.size())
+    {
+        if (loadManifest(manifest, dirs))
+            return;
+        // A partially-read stale manifest may have left entries behind.
+        m_kernels.clear();
+        m_drivers.clear();
+    }
+
+    for (const auto& dir : dirs)
     {
         StringList files = FileUtils::directoryList(dir);
         for (auto& file : files)
@@ -135,6 +174,76 @@ PluginDirectory::PluginDirectory()
                 m_drivers.insert(std::make_pair(plugin, file));
         }
     }
+
+    if (manifest.size())
+        saveManifest(manifest, dirs);
+}
+
+
+// Returns false - leaving the plugin maps empty - unless the manifest
+// matches the current search paths and their modification times exactly.
+bool PluginDirectory::loadManifest(const std::string& path,
+    const StringList& dirs)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != manifestHeader)
+        return false;
+
+    size_t dirCount = 0;
+    while (std::getline(in, line))
+    {
+        std::istringstream ss(line);
+        std::string tag, field;
+        if (!(ss >> tag >> field))
+            return false;
+
+        // The rest of the line is a path that may contain spaces.
+        std::string file;
+        std::getline(ss, file);
+        Utils::trim(file);
+        if (file.empty())
+            return false;
+
+        if (tag == "dir")
+        {
+            if (dirCount >= dirs.size() || file != dirs[dirCount] ||
+                field != fileTimestamp(dirs[dirCount]))
+                return false;
+            dirCount++;
+        }
+        else if (tag == "kernel")
+            m_kernels.insert(std::make_pair(field, file));
+        else if (tag == "driver")
+            m_drivers.insert(std::make_pair(field, file));
+        else
+            return false;
+    }
+    if (dirCount != dirs.size())
+        return false;
+    return true;
+}
+
+
+// Best effort - the cache is an optimization and a write failure just
+// means the next process scans again.
+void PluginDirectory::saveManifest(const std::string& path,
+    const StringList& dirs) const
+{
+    std::ofstream out(path);
+    if (!out)
+        return;
+
+    out << manifestHeader << "\n";
+    for (const std::string& dir : dirs)
+        out << "dir " << fileTimestamp(dir) << " " << dir << "\n";
+    for (const auto& ki : m_kernels)
+        out << "kernel " << ki.first << " " << ki.second << "\n";
+    for (const auto& di : m_drivers)
+        out << "driver " << di.first << " " << di.second << "\n";
 }
 
 StringList PluginDirectory::test_pluginSearchPaths()
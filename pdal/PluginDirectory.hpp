@@ -68,6 +68,9 @@ public:
     std::map<std::string, std::string> m_drivers;
 
 private:
+    bool loadManifest(const std::string& path, const StringList& dirs);
+    void saveManifest(const std::string& path, const StringList& dirs) const;
+
     static PluginDirectory *m_instance;
     PDAL_DLL static StringList test_pluginSearchPaths();
     PDAL_DLL static std::string test_validPlugin(const std::string& path,
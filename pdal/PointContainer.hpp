@@ -41,16 +41,43 @@
 namespace pdal
 {
 
+template <typename T>
+class TypedDimView;
+
 class PDAL_DLL PointContainer
 {
     friend class PointTable;
     friend class PointView;
     friend class PointRef;
+    template <typename T>
+    friend class TypedDimView;
 private:
     virtual void setFieldInternal(Dimension::Id dim, PointId idx,
         const void *val) = 0;
     virtual void getFieldInternal(Dimension::Id dim, PointId idx,
         void *val) const = 0;
+    /// Fetch the native values of a dimension for a contiguous range of
+    /// point IDs into a packed buffer with a single virtual call.
+    /// Containers with suitable storage override this to avoid the
+    /// per-point dispatch of the default implementation.
+    virtual void getFieldsInternal(Dimension::Id dim, PointId begin,
+        point_count_t count, void *buf) const
+    {
+        char *dst = reinterpret_cast<char *>(buf);
+        size_t size = layout()->dimSize(dim);
+        for (point_count_t i = 0; i < count; ++i, dst += size)
+            getFieldInternal(dim, begin + i, dst);
+    }
+    /// Store the native values of a dimension for a contiguous range of
+    /// point IDs from a packed buffer with a single virtual call.
+    virtual void setFieldsInternal(Dimension::Id dim, PointId begin,
+        point_count_t count, const void *buf)
+    {
+        const char *src = reinterpret_cast<const char *>(buf);
+        size_t size = layout()->dimSize(dim);
+        for (point_count_t i = 0; i < count; ++i, src += size)
+            setFieldInternal(dim, begin + i, src);
+    }
     virtual void swapItems(PointId id1, PointId id2)
         { throw pdal_error("Can't swap items in this container."); }
     virtual void setItem(PointId dst, PointId src)
@@ -92,6 +92,13 @@ void PointLayout::registerDim(Dimension::Id id, Dimension::Type type)
         type = Type::Double;
     else
         type = resolveType(type, dd.type());
+
+    // Re-registering a dimension at a type it already accommodates changes
+    // nothing, so skip the layout rebuild.  In a many-file merge every
+    // reader after the first re-registers an identical schema.
+    if (type == dd.type() && Utils::contains(m_used, id))
+        return;
+
     dd.setType(type);
     update(dd, Dimension::name(id));
 }
@@ -108,6 +115,12 @@ Dimension::Id PointLayout::assignDim(const std::string& name,
     if (di != m_propIds.end())
         id = di->second;
     Dimension::Detail dd = m_detail[Utils::toNative(id)];
+
+    // An existing assignment that already accommodates the requested type
+    // needs no layout rebuild.
+    if (di != m_propIds.end() && resolveType(type, dd.type()) == dd.type())
+        return id;
+
     dd.setType(resolveType(type, dd.type()));
     if (update(dd, name))
     {
@@ -184,39 +197,32 @@ std::string PointLayout::dimName(Dimension::Id id) const
 }
 
 
-bool PointLayout::hasDim(Dimension::Id id) const
-{
-    return m_detail[Utils::toNative(id)].type() != Dimension::Type::None;
-}
-
-
 const Dimension::IdList& PointLayout::dims() const
 {
     return m_used;
 }
 
 
-Dimension::Type PointLayout::dimType(Dimension::Id id) const
-{
-    return dimDetail(id)->type();
-}
-
-
-size_t PointLayout::dimSize(Dimension::Id id) const
+uint64_t PointLayout::fingerprint() const
 {
-    return dimDetail(id)->size();
-}
-
-
-size_t PointLayout::dimOffset(Dimension::Id id) const
-{
-    return dimDetail(id)->offset();
-}
-
-
-size_t PointLayout::pointSize() const
-{
-    return m_pointSize;
+    uint64_t hash = 0;
+    for (Dimension::Id id : m_used)
+    {
+        // FNV-1a over each dimension's name and type.  The per-dimension
+        // hashes are combined with addition so that the fingerprint is
+        // independent of registration order - the layout's memory
+        // arrangement is too (see update()).
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (char c : dimName(id))
+        {
+            h ^= (uint64_t)(unsigned char)c;
+            h *= 0x100000001b3ULL;
+        }
+        h ^= (uint64_t)dimType(id);
+        h *= 0x100000001b3ULL;
+        hash += h;
+    }
+    return hash;
 }
 
 
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -177,7 +178,8 @@ public:
       \param id  ID of the dimension to check.
       \return \c true if the layout uses the dimension, \c false otherwise.
     */
-    PDAL_DLL bool hasDim(Dimension::Id id) const;
+    PDAL_DLL bool hasDim(Dimension::Id id) const
+        { return dimDetail(id)->type() != Dimension::Type::None; }
 
     /**
       Get a reference to vector of the IDs of currently used dimensions.
@@ -192,7 +194,8 @@ public:
       \param id  ID of the dimension.
       \return  Type of the dimension.
     */
-    PDAL_DLL Dimension::Type dimType(Dimension::Id id) const;
+    PDAL_DLL Dimension::Type dimType(Dimension::Id id) const
+        { return dimDetail(id)->type(); }
 
     /**
       Get the current size in bytes of the dimension.
@@ -200,7 +203,8 @@ public:
       \param id  ID of the dimension.
       \return  Size of the dimension in bytes.
     */
-    PDAL_DLL size_t dimSize(Dimension::Id id) const;
+    PDAL_DLL size_t dimSize(Dimension::Id id) const
+        { return dimDetail(id)->size(); }
 
     /**
       Get the offset of the dimension in the layout.
@@ -208,7 +212,8 @@ public:
       \param id  ID of the dimension.
       \return  Offset of the dimension in bytes.
     */
-    PDAL_DLL size_t dimOffset(Dimension::Id id) const;
+    PDAL_DLL size_t dimOffset(Dimension::Id id) const
+        { return dimDetail(id)->offset(); }
 
     /**
       Get number of bytes that make up a point.  Returns the sum of the dimSize
@@ -216,7 +221,19 @@ public:
 
       \return  Size of a point in bytes.
     */
-    PDAL_DLL size_t pointSize() const;
+    PDAL_DLL size_t pointSize() const
+        { return m_pointSize; }
+
+    /**
+      Get a hash of the registered dimensions (names and types) that
+      identifies the schema.  Layouts built from identical schemas produce
+      the same fingerprint regardless of registration order, so a caller
+      can cheaply determine that registering a schema again would leave
+      the layout unchanged.
+
+      \return  Fingerprint of the registered dimensions.
+    */
+    PDAL_DLL uint64_t fingerprint() const;
 
     /**
       Get a pointer to a dimension's detail information.
@@ -271,6 +271,9 @@ public:
     }
 
 private:
+    template <typename T>
+    friend class TypedDimView;
+
     PointContainer *m_container;
     PointLayout *m_layout;
     PointId m_idx;
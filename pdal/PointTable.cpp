@@ -32,14 +32,18 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <fstream>
+#include <sstream>
+
 #include <pdal/ArtifactManager.hpp>
 #include <pdal/PointTable.hpp>
+#include <pdal/util/FileUtils.hpp>
 
 namespace pdal
 {
 
 BasePointTable::BasePointTable(PointLayout& layout) :
-    m_metadata(new Metadata()), m_layoutRef(layout)
+    m_metadata(new Metadata()), m_layoutRef(layout), m_allocCnt(0)
 {}
 
 
@@ -58,6 +62,13 @@ MetadataNode BasePointTable::privateMetadata(const std::string& name)
 
 
 void BasePointTable::addSpatialReference(const SpatialReference& spatialRef)
+{
+    std::lock_guard<std::mutex> lock(m_srsMutex);
+    addSpatialReferenceLocked(spatialRef);
+}
+
+
+void BasePointTable::addSpatialReferenceLocked(const SpatialReference& spatialRef)
 {
     auto it = std::find(m_spatialRefs.begin(), m_spatialRefs.end(), spatialRef);
 
@@ -99,20 +110,55 @@ void SimplePointTable::getFieldInternal(Dimension::Id id, PointId idx,
 }
 
 
+void SimplePointTable::getFieldsInternal(Dimension::Id id, PointId begin,
+    point_count_t count, void *buf) const
+{
+    const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+    char *dst = (char *)buf;
+    for (point_count_t i = 0; i < count; ++i, dst += d->size())
+    {
+        const char *src = getDimension(d, begin + i);
+        std::copy(src, src + d->size(), dst);
+    }
+}
+
+
+void SimplePointTable::setFieldsInternal(Dimension::Id id, PointId begin,
+    point_count_t count, const void *buf)
+{
+    const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+    const char *src = (const char *)buf;
+    for (point_count_t i = 0; i < count; ++i, src += d->size())
+    {
+        char *dst = getDimension(d, begin + i);
+        std::copy(src, src + d->size(), dst);
+    }
+}
+
+
 PointTable::~PointTable()
 {
-    for (auto vi = m_blocks.begin(); vi != m_blocks.end(); ++vi)
-        delete [] *vi;
+    for (auto& dir : m_blockDirs)
+        if (dir)
+            for (size_t i = 0; i < m_blocksPerDir; ++i)
+                delete [] dir[i];
 }
 
 PointId PointTable::addPoint()
 {
+    std::lock_guard<std::mutex> lock(m_addMutex);
+
     if (m_numPts % m_blockPtCnt == 0)
     {
+        size_t blockNo = m_numPts / m_blockPtCnt;
+        auto& dir = m_blockDirs[blockNo / m_blocksPerDir];
+        if (!dir)
+            dir.reset(new char *[m_blocksPerDir]());
         size_t size = pointsToBytes(m_blockPtCnt);
         char *buf = new char[size];
         memset(buf, 0, size);
-        m_blocks.push_back(buf);
+        dir[blockNo % m_blocksPerDir] = buf;
+        countAllocation();
     }
     return m_numPts++;
 }
@@ -120,7 +166,8 @@ PointId PointTable::addPoint()
 
 char *PointTable::getPoint(PointId idx)
 {
-    char *buf = m_blocks[idx / m_blockPtCnt];
+    size_t blockNo = idx / m_blockPtCnt;
+    char *buf = m_blockDirs[blockNo / m_blocksPerDir][blockNo % m_blocksPerDir];
     return buf + pointsToBytes(idx % m_blockPtCnt);
 }
 
@@ -131,7 +178,10 @@ ContiguousPointTable::~ContiguousPointTable()
 
 PointId ContiguousPointTable::addPoint()
 {
+    size_t cap = m_buf.capacity();
     m_buf.resize(pointsToBytes(m_numPts + 1));
+    if (m_buf.capacity() != cap)
+        countAllocation();
     return m_numPts++;
 }
 
@@ -142,6 +192,199 @@ char *ContiguousPointTable::getPoint(PointId idx)
 }
 
 
+void ContiguousPointTable::getFieldsInternal(Dimension::Id id, PointId begin,
+    point_count_t count, void *buf) const
+{
+    const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+    size_t stride = m_layoutRef.pointSize();
+    const char *src = m_buf.data() + pointsToBytes(begin) + d->offset();
+    char *dst = (char *)buf;
+    for (point_count_t i = 0; i < count; ++i, src += stride, dst += d->size())
+        std::copy(src, src + d->size(), dst);
+}
+
+
+void ContiguousPointTable::setFieldsInternal(Dimension::Id id, PointId begin,
+    point_count_t count, const void *buf)
+{
+    const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+    size_t stride = m_layoutRef.pointSize();
+    const char *src = (const char *)buf;
+    char *dst = m_buf.data() + pointsToBytes(begin) + d->offset();
+    for (point_count_t i = 0; i < count; ++i, src += d->size(), dst += stride)
+        std::copy(src, src + d->size(), dst);
+}
+
+
+ColumnPointTable::~ColumnPointTable()
+{}
+
+
+PointId ColumnPointTable::addPoint()
+{
+    // Columns are grown individually so that a dimension registered after
+    // points already exist picks up zero-filled entries for those points.
+    bool grew = false;
+    for (Dimension::Id id : m_layoutRef.dims())
+    {
+        const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+        std::vector<char>& col = m_columns[Utils::toNative(id)];
+        size_t cap = col.capacity();
+        col.resize((m_numPts + 1) * d->size());
+        grew |= (col.capacity() != cap);
+    }
+    if (grew)
+        countAllocation();
+    return m_numPts++;
+}
+
+
+char *ColumnPointTable::getPoint(PointId idx)
+{
+    throw pdal_error("ColumnPointTable doesn't support row-oriented "
+        "point access.");
+}
+
+
+char *ColumnPointTable::getDimension(const Dimension::Detail *d, PointId idx)
+{
+    return m_columns[Utils::toNative(d->id())].data() + (d->size() * idx);
+}
+
+
+const char *ColumnPointTable::getDimension(const Dimension::Detail *d,
+    PointId idx) const
+{
+    ColumnPointTable *ncThis = const_cast<ColumnPointTable *>(this);
+    return ncThis->getDimension(d, idx);
+}
+
+
+uintmax_t ColumnPointTable::allocated() const
+{
+    uintmax_t total = 0;
+    for (const std::vector<char>& col : m_columns)
+        total += col.capacity();
+    return total;
+}
+
+
+const char *ColumnPointTable::dimBuffer(Dimension::Id id) const
+{
+    if (!m_layoutRef.hasDim(id))
+        return nullptr;
+    return m_columns[Utils::toNative(id)].data();
+}
+
+
+void ColumnPointTable::setFieldInternal(Dimension::Id id, PointId idx,
+    const void *value)
+{
+    const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+    const char *src = (const char *)value;
+    char *dst = getDimension(d, idx);
+    std::copy(src, src + d->size(), dst);
+}
+
+
+void ColumnPointTable::getFieldInternal(Dimension::Id id, PointId idx,
+    void *value) const
+{
+    const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+    const char *src = getDimension(d, idx);
+    char *dst = (char *)value;
+    std::copy(src, src + d->size(), dst);
+}
+
+
+void ColumnPointTable::getFieldsInternal(Dimension::Id id, PointId begin,
+    point_count_t count, void *buf) const
+{
+    // Column storage makes a batch fetch a single contiguous copy.
+    const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+    const char *src = getDimension(d, begin);
+    std::copy(src, src + d->size() * count, (char *)buf);
+}
+
+
+void ColumnPointTable::setFieldsInternal(Dimension::Id id, PointId begin,
+    point_count_t count, const void *buf)
+{
+    const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+    const char *src = (const char *)buf;
+    std::copy(src, src + d->size() * count, getDimension(d, begin));
+}
+
+
+MmapPointTable::MmapPointTable(const std::string& filename) :
+    SimplePointTable(m_layout),
+    m_filename(filename.size() ? filename :
+        FileUtils::temporaryFilename("pdal_spill")),
+    m_numPts(0), m_blockBytes(0)
+{
+    std::ostream *out = FileUtils::createFile(m_filename);
+    if (!out)
+        throw pdal_error("Can't create point table backing file '" +
+            m_filename + "'.");
+    FileUtils::closeFile(out);
+}
+
+
+MmapPointTable::~MmapPointTable()
+{
+    for (auto& ctx : m_blocks)
+        FileUtils::unmapFile(ctx);
+    FileUtils::deleteFile(m_filename);
+}
+
+
+PointId MmapPointTable::addPoint()
+{
+    if (m_numPts % m_blockPtCnt == 0)
+    {
+        if (!m_blockBytes)
+        {
+            // Block size is fixed once the layout is known.  Mapped
+            // regions must start on an allocation-granularity boundary
+            // (64k on Windows), so round the block up.
+            const uintmax_t Granularity = 65536;
+            m_blockBytes = pointsToBytes(m_blockPtCnt);
+            m_blockBytes += (Granularity - m_blockBytes % Granularity) %
+                Granularity;
+        }
+
+        // Extend the backing file to cover the new block.  The new
+        // bytes read back as zeros, matching freshly allocated blocks
+        // in the other tables.
+        uintmax_t pos = (uintmax_t)m_blocks.size() * m_blockBytes;
+        std::fstream f(m_filename,
+            std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(pos + m_blockBytes - 1);
+        f.put('\0');
+        f.close();
+        if (!f)
+            throw pdal_error("Can't extend point table backing file '" +
+                m_filename + "'.");
+
+        FileUtils::MapContext ctx =
+            FileUtils::mapFile(m_filename, false, pos, m_blockBytes);
+        if (!ctx.addr())
+            throw pdal_error("Can't map point table backing file '" +
+                m_filename + "': " + ctx.what());
+        m_blocks.push_back(ctx);
+        countAllocation();
+    }
+    return m_numPts++;
+}
+
+
+char *MmapPointTable::getPoint(PointId idx)
+{
+    char *buf = (char *)m_blocks[idx / m_blockPtCnt].addr();
+    return buf + pointsToBytes(idx % m_blockPtCnt);
+}
+
+
 MetadataNode BasePointTable::toMetadata() const
 {
     return layout()->toMetadata();
@@ -35,7 +35,11 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "pdal/SpatialReference.hpp"
@@ -43,6 +47,8 @@
 #include "pdal/PointContainer.hpp"
 #include "pdal/PointLayout.hpp"
 #include "pdal/Metadata.hpp"
+#include "pdal/util/Arena.hpp"
+#include "pdal/util/FileUtils.hpp"
 
 namespace pdal
 {
@@ -71,26 +77,54 @@ public:
         { m_layoutRef.finalize(); }
     void setSpatialReference(const SpatialReference& srs)
     {
-        clearSpatialReferences();
-        addSpatialReference(srs);
+        std::lock_guard<std::mutex> lock(m_srsMutex);
+        m_spatialRefs.clear();
+        addSpatialReferenceLocked(srs);
     }
     void clearSpatialReferences()
-        { m_spatialRefs.clear(); }
+    {
+        std::lock_guard<std::mutex> lock(m_srsMutex);
+        m_spatialRefs.clear();
+    }
     void addSpatialReference(const SpatialReference& srs);
     bool spatialReferenceUnique() const
-        { return m_spatialRefs.size() <= 1; }
+    {
+        std::lock_guard<std::mutex> lock(m_srsMutex);
+        return m_spatialRefs.size() <= 1;
+    }
     SpatialReference spatialReference() const
     {
-        return spatialReferenceUnique() ? anySpatialReference() :
-            SpatialReference();
+        std::lock_guard<std::mutex> lock(m_srsMutex);
+        return m_spatialRefs.size() > 1 ? SpatialReference() :
+            anySpatialReferenceLocked();
     }
     SpatialReference anySpatialReference() const
     {
-        return m_spatialRefs.size() ?
-            *m_spatialRefs.begin() : SpatialReference();
+        std::lock_guard<std::mutex> lock(m_srsMutex);
+        return anySpatialReferenceLocked();
     }
     virtual bool supportsView() const
         { return false; }
+    /// Whether addPoint() may be called concurrently from multiple threads.
+    /// Tables that can't guarantee this are executed sequentially when a
+    /// pipeline could otherwise run independent stages in parallel.
+    virtual bool concurrentAddSafe() const
+        { return false; }
+    /// Whether getPoint() returns a pointer to a packed point record laid
+    /// out according to the table's layout.  Readers can use this to blit
+    /// data directly into point memory.
+    virtual bool packedPointAccess() const
+        { return false; }
+    /// Bytes of point storage the table currently holds, for memory
+    /// accounting (see PipelineManager::setMemoryLimit()).  Tables that
+    /// don't track their allocation report 0.
+    virtual uintmax_t allocated() const
+        { return 0; }
+    /// Number of times the table's point storage has grown.  Together
+    /// with allocated(), lets execution attribute storage growth to the
+    /// stage that caused it (see PipelineManager::getMetrics()).
+    uintmax_t allocations() const
+        { return m_allocCnt; }
     MetadataNode privateMetadata(const std::string& name);
     MetadataNode toMetadata() const;
     ArtifactManager& artifactManager();
@@ -99,20 +133,39 @@ private:
     // Point data operations.
     virtual PointId addPoint() = 0;
 
+    void addSpatialReferenceLocked(const SpatialReference& srs);
+    SpatialReference anySpatialReferenceLocked() const
+    {
+        return m_spatialRefs.size() ?
+            *m_spatialRefs.begin() : SpatialReference();
+    }
+
 protected:
     virtual char *getPoint(PointId idx) = 0;
+    /// Called by derived tables each time their point storage grows.
+    /// Growth happens under whatever serialization the table's addPoint()
+    /// provides, so the counter needs none of its own.
+    void countAllocation()
+        { m_allocCnt++; }
 
 protected:
     MetadataPtr m_metadata;
     std::list<SpatialReference> m_spatialRefs;
+    // Stages running concurrently in a pipeline share the table and adjust
+    // its spatial reference list as they go.
+    mutable std::mutex m_srsMutex;
     PointLayout& m_layoutRef;
     std::unique_ptr<ArtifactManager> m_artifactManager;
+    uintmax_t m_allocCnt;
 };
 typedef BasePointTable& PointTableRef;
 typedef BasePointTable const & ConstPointTableRef;
 
 class PDAL_DLL SimplePointTable : public BasePointTable
 {
+public:
+    virtual bool packedPointAccess() const
+        { return true; }
 
 protected:
     SimplePointTable(PointLayout& layout) : BasePointTable(layout)
@@ -127,6 +180,10 @@ private:
         const void *value);
     virtual void getFieldInternal(Dimension::Id id, PointId idx,
         void *value) const;
+    virtual void getFieldsInternal(Dimension::Id id, PointId begin,
+        point_count_t count, void *buf) const;
+    virtual void setFieldsInternal(Dimension::Id id, PointId begin,
+        point_count_t count, const void *buf);
 
     // The number of points in each memory block.
     char *getDimension(const Dimension::Detail *d, PointId idx)
@@ -144,17 +201,32 @@ private:
 class PDAL_DLL PointTable : public SimplePointTable
 {
 private:
-    // Point storage.
-    std::vector<char *> m_blocks;
-    point_count_t m_numPts;
+    // Point storage.  Block pointers live in a two-level directory with a
+    // fixed-size top level so that getPoint() can run without
+    // synchronization while addPoint() publishes new blocks under lock --
+    // nothing a reader may touch is ever reallocated.
     static const point_count_t m_blockPtCnt = 65536;
+    static const size_t m_dirCnt = 2048;
+    static const size_t m_blocksPerDir = 2048;
+
+    std::vector<std::unique_ptr<char *[]>> m_blockDirs;
+    point_count_t m_numPts;
+    std::mutex m_addMutex;
 
 public:
-    PointTable() : SimplePointTable(m_layout), m_numPts(0)
+    PointTable() : SimplePointTable(m_layout), m_blockDirs(m_dirCnt),
+        m_numPts(0)
         {}
     virtual ~PointTable();
     virtual bool supportsView() const
         { return true; }
+    virtual bool concurrentAddSafe() const
+        { return true; }
+    virtual uintmax_t allocated() const
+    {
+        size_t blocks = (m_numPts + m_blockPtCnt - 1) / m_blockPtCnt;
+        return (uintmax_t)blocks * pointsToBytes(m_blockPtCnt);
+    }
 
 protected:
     virtual char *getPoint(PointId idx);
@@ -178,16 +250,105 @@ public:
     virtual ~ContiguousPointTable();
     virtual bool supportsView() const
         { return true; }
+    virtual uintmax_t allocated() const
+        { return m_buf.capacity(); }
 
 protected:
     virtual char *getPoint(PointId idx);
 
 private:
     virtual PointId addPoint();
+    virtual void getFieldsInternal(Dimension::Id id, PointId begin,
+        point_count_t count, void *buf) const;
+    virtual void setFieldsInternal(Dimension::Id id, PointId begin,
+        point_count_t count, const void *buf);
 
     PointLayout m_layout;
 };
 
+/// A point table that stores each dimension in its own contiguous buffer
+/// (structure-of-arrays) rather than packing all dimensions into a single
+/// interleaved point record.  Single-dimension scans touch only the bytes
+/// of the dimension being read, which keeps them sequential and
+/// cache/SIMD-friendly.  Row-oriented access (getPoint()) isn't supported.
+class PDAL_DLL ColumnPointTable : public BasePointTable
+{
+public:
+    ColumnPointTable() : BasePointTable(m_layout),
+        m_columns(Dimension::COUNT), m_numPts(0)
+        {}
+    virtual ~ColumnPointTable();
+    virtual bool supportsView() const
+        { return true; }
+
+    /// Return a pointer to the start of the contiguous buffer for a
+    /// dimension, or NULL if the dimension isn't part of the layout.
+    const char *dimBuffer(Dimension::Id id) const;
+    virtual uintmax_t allocated() const;
+
+protected:
+    virtual char *getPoint(PointId idx);
+    char *getDimension(const Dimension::Detail *d, PointId idx);
+    const char *getDimension(const Dimension::Detail *d, PointId idx) const;
+
+private:
+    virtual PointId addPoint();
+    virtual void setFieldInternal(Dimension::Id id, PointId idx,
+        const void *value);
+    virtual void getFieldInternal(Dimension::Id id, PointId idx,
+        void *value) const;
+    virtual void getFieldsInternal(Dimension::Id id, PointId begin,
+        point_count_t count, void *buf) const;
+    virtual void setFieldsInternal(Dimension::Id id, PointId begin,
+        point_count_t count, const void *buf);
+
+    // One buffer per dimension, indexed by the dimension's position in
+    // the layout's detail list.
+    std::vector<std::vector<char>> m_columns;
+    point_count_t m_numPts;
+    PointLayout m_layout;
+};
+
+/// A point table whose storage is a memory-mapped temporary file, so that
+/// standard-mode pipelines holding more points than physical memory
+/// degrade to disk paging instead of failing to allocate.  Storage grows
+/// in fixed-size blocks, each a mapped region of the backing file; the
+/// kernel writes cold blocks back as memory tightens.  The backing file
+/// is removed when the table is destroyed.
+class PDAL_DLL MmapPointTable : public SimplePointTable
+{
+public:
+    /// \param filename  Backing file, created if it doesn't exist.  An
+    ///   empty name creates a unique file in the temporary directory.
+    MmapPointTable(const std::string& filename = "");
+    virtual ~MmapPointTable();
+    virtual bool supportsView() const
+        { return true; }
+
+    /// Name of the file backing the point storage.
+    const std::string& filename() const
+        { return m_filename; }
+    /// Mapped bytes; file-backed, so pageable rather than RAM-resident.
+    virtual uintmax_t allocated() const
+        { return (uintmax_t)m_blocks.size() * m_blockBytes; }
+
+protected:
+    virtual char *getPoint(PointId idx);
+
+private:
+    virtual PointId addPoint();
+
+    // The number of points in each mapped block.
+    static const point_count_t m_blockPtCnt = 65536;
+
+    std::string m_filename;
+    std::vector<FileUtils::MapContext> m_blocks;
+    point_count_t m_numPts;
+    // Bytes per block, rounded up to the mapping granularity.
+    uintmax_t m_blockBytes;
+    PointLayout m_layout;
+};
+
 /// A StreamPointTable must provide storage for point data up to its capacity.
 /// It must implement getPoint() which returns a pointer to a buffer of
 /// sufficient size to contain a point's data.  The minimum size required
@@ -196,13 +357,38 @@ private:
 class PDAL_DLL StreamPointTable : public SimplePointTable
 {
 protected:
+    /// A capacity of 0 means the table sizes itself from the layout when
+    /// finalized (see autoSizeCapacity()).
     StreamPointTable(PointLayout& layout, point_count_t capacity)
         : SimplePointTable(layout)
         , m_capacity(capacity)
         , m_numPoints(0)
-        , m_skips(m_capacity, false)
+        , m_skips(m_capacity, 0)
+        , m_groupStarts(m_capacity, 0)
+        , m_anySkips(false)
+        , m_anyGroupStarts(false)
     {}
 
+    /// Pick a capacity from the finalized layout when none was given:
+    /// target chunk bytes that stay resident in a mid-size outer cache,
+    /// so per-point dispatch amortizes without the chunk thrashing it.
+    /// Must run before the derived table sizes its buffers.
+    void autoSizeCapacity()
+    {
+        if (m_capacity)
+            return;
+
+        const size_t TargetChunkBytes = 1024 * 1024;
+        const point_count_t MinCapacity = 1024;
+        const point_count_t MaxCapacity = 65536;
+
+        size_t pointSize = (std::max)(layout()->pointSize(), (size_t)1);
+        m_capacity = (std::min)(MaxCapacity, (std::max)(MinCapacity,
+            (point_count_t)(TargetChunkBytes / pointSize)));
+        m_skips.assign(m_capacity, 0);
+        m_groupStarts.assign(m_capacity, 0);
+    }
+
 public:
     /// Called when a new point should be added.  Probably a no-op for
     /// streaming.
@@ -221,19 +407,68 @@ public:
 
         m_numPoints = count;
         reset();
-        std::fill(m_skips.begin(), m_skips.end(), false);
+        m_arena.reset();
+        // The common chunk has no skips or group marks, so the flags
+        // save the bulk clears as well as the per-point tests.
+        if (m_anySkips.load(std::memory_order_relaxed))
+        {
+            std::fill(m_skips.begin(), m_skips.end(), 0);
+            m_anySkips.store(false, std::memory_order_relaxed);
+        }
+        if (m_anyGroupStarts.load(std::memory_order_relaxed))
+        {
+            std::fill(m_groupStarts.begin(), m_groupStarts.end(), 0);
+            m_anyGroupStarts.store(false, std::memory_order_relaxed);
+        }
+        if (m_chunkCb)
+            m_chunkCb(count);
     }
 
+    /// Set a callback invoked after each chunk of points has been
+    /// consumed with the chunk's point count, skipped points included.
+    /// Used by PipelineManager to persist streaming progress (see
+    /// PipelineManager::setCheckpoint()).
+    void setChunkCb(std::function<void(point_count_t)> cb)
+        { m_chunkCb = cb; }
+
     /// Returns true if a point in the table was filtered out and should be
     /// considered omitted.
     bool skip(PointId n) const
-        { return m_skips[n]; }
+        { return m_skips[n] != 0; }
     void setSkip(PointId n)
-        { m_skips[n] = true; }
+    {
+        m_skips[n] = 1;
+        m_anySkips.store(true, std::memory_order_relaxed);
+    }
+    /// Returns false if no point in the chunk has been skipped, letting
+    /// dispatch loops over fully-kept chunks drop the per-point tests.
+    /// Skips set while such a loop runs can only be its own - a stage
+    /// never revisits a point it skipped - so checking once per pass is
+    /// safe.
+    bool anySkips() const
+        { return m_anySkips.load(std::memory_order_relaxed); }
+
+    /// Returns true if a splitting filter (see filters.groupby) marked
+    /// the point as the first of a new output group.  Writers with
+    /// template-based filenames rotate output at marked points.
+    bool groupStart(PointId n) const
+        { return m_groupStarts[n] != 0; }
+    void setGroupStart(PointId n)
+    {
+        m_groupStarts[n] = 1;
+        m_anyGroupStarts.store(true, std::memory_order_relaxed);
+    }
 
     point_count_t capacity() const
         { return m_capacity; }
 
+    /// Scratch arena for per-chunk temporaries.  Rewound after each chunk
+    /// is consumed, so allocations made while processing a chunk cost a
+    /// pointer bump once the arena has grown to its working size.  Only
+    /// valid for use from the thread driving the chunk.
+    Arena& arena()
+        { return m_arena; }
+
     /// During a given call to reset(), this indicates the number of points
     /// populated in the table.  This value will always be less then or equal
     /// to capacity(), and also includes skipped points.
@@ -249,7 +484,17 @@ protected:
 private:
     point_count_t m_capacity;
     point_count_t m_numPoints;
-    std::vector<bool> m_skips;
+    // One byte per point rather than vector<bool> so that pipelined
+    // streaming stages can set skips on disjoint points concurrently.
+    std::vector<char> m_skips;
+    // Group-break marks, stored like the skips.
+    std::vector<char> m_groupStarts;
+    // Whether any entry in the corresponding array is set for the
+    // current chunk.
+    std::atomic<bool> m_anySkips;
+    std::atomic<bool> m_anyGroupStarts;
+    std::function<void(point_count_t)> m_chunkCb;
+    Arena m_arena;
 };
 
 class PDAL_DLL FixedPointTable : public StreamPointTable
@@ -264,6 +509,7 @@ public:
         if (!m_layout.finalized())
         {
             BasePointTable::finalize();
+            autoSizeCapacity();
             m_buf.resize(pointsToBytes(capacity() + 1));
         }
     }
@@ -280,5 +526,93 @@ private:
     PointLayout m_layout;
 };
 
+/// A FixedPointTable variant holding two chunk buffers so that a producer
+/// (typically a reader running on a background thread) can fill the next
+/// chunk while downstream stages consume the current one.  The producer
+/// writes through fillTable(), which addresses the back buffer; flip()
+/// exchanges the buffers once the consumer is done with the front one.
+/// The caller is responsible for making sure the producer and consumer
+/// never touch the same buffer at the same time.
+class PDAL_DLL DoubleBufferedPointTable : public StreamPointTable
+{
+    /// Companion table addressing the back buffer.  It shares the owner's
+    /// layout, so dimension offsets match between the two sides.
+    class FillTable : public StreamPointTable
+    {
+    public:
+        FillTable(DoubleBufferedPointTable& owner) :
+            StreamPointTable(owner.m_layout, owner.capacity()),
+            m_owner(owner)
+        {}
+
+    protected:
+        virtual char *getPoint(PointId idx)
+        {
+            return m_owner.m_bufs[1 - m_owner.m_front].get() +
+                pointsToBytes(idx);
+        }
+
+    private:
+        DoubleBufferedPointTable& m_owner;
+    };
+
+public:
+    DoubleBufferedPointTable(point_count_t capacity)
+        : StreamPointTable(m_layout, capacity)
+        , m_bufSize(0)
+        , m_front(0)
+        , m_fillTable(*this)
+    {}
+
+    virtual void finalize()
+    {
+        if (!m_layout.finalized())
+        {
+            BasePointTable::finalize();
+            autoSizeCapacity();
+            // The buffers are allocated untouched; primeFill() zeroes
+            // each one from the producer thread before it's filled, so
+            // on NUMA systems first-touch places the pages on the node
+            // of the thread that works the buffer hardest.
+            m_bufSize = pointsToBytes(capacity() + 1);
+            m_bufs[0].reset(new char[m_bufSize]);
+            m_bufs[1].reset(new char[m_bufSize]);
+        }
+    }
+
+    /// Table through which the producer fills the back buffer.
+    StreamPointTable& fillTable()
+        { return m_fillTable; }
+
+    /// Zero the back buffer ahead of filling it.  Must be called by the
+    /// producer before each chunk - it replaces the consumer-side zeroing
+    /// other tables do in reset(), keeping every store to a buffer on the
+    /// producer's thread.
+    void primeFill()
+        { std::fill(m_bufs[1 - m_front].get(),
+            m_bufs[1 - m_front].get() + m_bufSize, 0); }
+
+    /// Make the chunk just filled current and expose the consumed chunk's
+    /// buffer for refill.
+    void flip()
+        { m_front = 1 - m_front; }
+
+protected:
+    // The producer zeroes the back buffer in primeFill(); nothing to do
+    // when a chunk is consumed.
+    virtual void reset()
+    {}
+
+    virtual char *getPoint(PointId idx)
+        { return m_bufs[m_front].get() + pointsToBytes(idx); }
+
+private:
+    std::unique_ptr<char[]> m_bufs[2];
+    size_t m_bufSize;
+    int m_front;
+    PointLayout m_layout;
+    FillTable m_fillTable;
+};
+
 } //namespace
 
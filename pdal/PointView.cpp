@@ -42,7 +42,7 @@
 namespace pdal
 {
 
-int PointView::m_lastId = 0;
+std::atomic<int> PointView::m_lastId(0);
 
 PointView::PointView(PointTableRef pointTable) : m_pointTable(pointTable),
 m_size(0), m_id(0)
@@ -188,6 +188,37 @@ KD2Index& PointView::build2dIndex()
 }
 
 
+void PointView::getPackedData(const DimTypeList& dims, PointId start,
+    point_count_t count, char *buf) const
+{
+    size_t recSize = 0;
+    for (const DimType& d : dims)
+        recSize += Dimension::size(d.m_type);
+
+    // Fetch and convert a column at a time into a staging buffer, then
+    // scatter the column into the packed records.  The staging buffer
+    // is uint64_t so any value type is aligned.
+    std::vector<uint64_t> store;
+    size_t offset = 0;
+    for (const DimType& d : dims)
+    {
+        size_t size = Dimension::size(d.m_type);
+        store.resize((count * size + 7) / 8);
+        char *col = reinterpret_cast<char *>(store.data());
+        getFieldBatch(d.m_id, d.m_type, start, count, col);
+
+        char *dst = buf + offset;
+        for (point_count_t i = 0; i < count; ++i)
+        {
+            std::copy(col, col + size, dst);
+            col += size;
+            dst += recSize;
+        }
+        offset += size;
+    }
+}
+
+
 void PointView::dump(std::ostream& ostr) const
 {
     using std::endl;
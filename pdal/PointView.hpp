@@ -42,10 +42,11 @@
 #include <pdal/PointTable.hpp>
 #include <pdal/PointRef.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <set>
-#include <deque>
 
 //#pragma warning(disable: 4244)  // conversion from 'type1' to 'type2', possible loss of data
 
@@ -67,12 +68,235 @@ class BOX3D;
 typedef std::shared_ptr<PointView> PointViewPtr;
 typedef std::set<PointViewPtr, PointViewLess> PointViewSet;
 
+/// Maps view positions to table point IDs.  Entries are stored in fixed-size
+/// contiguous chunks rather than a deque, so sequential walks stay in cache
+/// and don't pay the deque's segment-map indirection.  A view that's a dense
+/// 0..N-1 identity mapping over its table (the common case for a view filled
+/// by a single reader) stores nothing at all -- lookups just return the
+/// position -- and storage is materialized only when the mapping first
+/// diverges from the identity.
+///
+/// An index can also be a slice of another index.  Slicing copies nothing:
+/// the chunk storage is shared and the slice just applies an offset, so
+/// carving a view into thousands of tiles allocates no per-tile ID storage.
+/// The storage is copy-on-write -- the first mutation through any index
+/// sharing it detaches that index onto its own private copy of its range.
+class PDAL_DLL ChunkedPointIndex
+{
+private:
+    static const size_t chunkShift = 16;
+    static const size_t chunkCnt = (size_t)1 << chunkShift;
+    static const size_t chunkMask = chunkCnt - 1;
+
+    typedef std::vector<std::vector<PointId>> ChunkVec;
+
+public:
+    size_t size() const
+        { return m_cnt; }
+
+    bool identity() const
+        { return m_identity && m_offset == 0; }
+
+    /// True when view positions map to a dense run of table IDs starting
+    /// at offset() -- covers both the identity mapping and slices of it.
+    bool contiguous() const
+        { return m_identity; }
+
+    size_t offset() const
+        { return m_offset; }
+
+    PointId operator[](size_t pos) const
+    {
+        pos += m_offset;
+        return m_identity ? (PointId)pos :
+            (*m_chunks)[pos >> chunkShift][pos & chunkMask];
+    }
+
+    /// Return an index mapping positions 0..count-1 to this index's
+    /// entries at start..start+count-1.  Chunk storage is shared, not
+    /// copied.
+    ChunkedPointIndex slice(size_t start, size_t count) const
+    {
+        ChunkedPointIndex s(*this);
+        s.m_offset += start;
+        s.m_cnt = count;
+        return s;
+    }
+
+    void set(size_t pos, PointId id)
+    {
+        if (m_identity)
+        {
+            if (id == (PointId)(pos + m_offset))
+                return;
+            materialize();
+        }
+        else
+            detach();
+        (*m_chunks)[pos >> chunkShift][pos & chunkMask] = id;
+    }
+
+    void push_back(PointId id)
+    {
+        if (m_identity)
+        {
+            if (id == (PointId)(m_cnt + m_offset))
+            {
+                m_cnt++;
+                return;
+            }
+            materialize();
+        }
+        else
+            detach();
+        if ((m_cnt & chunkMask) == 0)
+            m_chunks->emplace_back();
+        m_chunks->back().push_back(id);
+        m_cnt++;
+    }
+
+    /// Append all of \c other's entries to this index.  Appending the
+    /// continuation of a dense run keeps the no-storage identity
+    /// representation, appending to an empty index just shares \c other's
+    /// storage copy-on-write, and everything else copies entries in
+    /// chunk-sized runs instead of one at a time.
+    void append(const ChunkedPointIndex& other)
+    {
+        size_t cnt = other.m_cnt;
+        if (cnt == 0)
+            return;
+        if (m_identity)
+        {
+            if (other.contiguous() && other.m_offset == m_offset + m_cnt)
+            {
+                m_cnt += cnt;
+                return;
+            }
+            if (m_cnt == 0)
+            {
+                *this = other;
+                return;
+            }
+            materialize();
+        }
+        else
+            detach();
+
+        m_chunks->reserve(((m_cnt + cnt) >> chunkShift) + 1);
+        size_t pos = 0;
+        while (pos < cnt)
+        {
+            if ((m_cnt & chunkMask) == 0)
+                m_chunks->emplace_back();
+            std::vector<PointId>& back = m_chunks->back();
+            size_t n = (std::min)(chunkCnt - (m_cnt & chunkMask), cnt - pos);
+            if (other.contiguous())
+            {
+                size_t first = other.m_offset + pos;
+                back.reserve(back.size() + n);
+                for (size_t i = 0; i < n; ++i)
+                    back.push_back((PointId)(first + i));
+            }
+            else
+            {
+                // Copy in runs that stay within one source chunk.
+                size_t copied = 0;
+                while (copied < n)
+                {
+                    size_t spos = other.m_offset + pos + copied;
+                    const std::vector<PointId>& src =
+                        (*other.m_chunks)[spos >> chunkShift];
+                    size_t m = (std::min)(n - copied,
+                        chunkCnt - (spos & chunkMask));
+                    back.insert(back.end(),
+                        src.begin() + (spos & chunkMask),
+                        src.begin() + (spos & chunkMask) + m);
+                    copied += m;
+                }
+            }
+            m_cnt += n;
+            pos += n;
+        }
+    }
+
+    /// Bytes of chunk storage behind this index, for memory accounting.
+    /// An identity mapping holds none; storage shared between slices is
+    /// reported by each index using it.
+    size_t allocated() const
+    {
+        if (m_identity || !m_chunks)
+            return 0;
+        size_t total = 0;
+        for (const std::vector<PointId>& chunk : *m_chunks)
+            total += chunk.capacity() * sizeof(PointId);
+        return total;
+    }
+
+    /// Drop the entry at position \c pos and everything above it.
+    void truncate(size_t pos)
+    {
+        if (pos >= m_cnt)
+            return;
+        m_cnt = pos;
+        if (m_identity)
+            return;
+        // Shared or offset storage is left alone -- reads are bounded by
+        // m_cnt and a later mutation detaches to an exact-sized copy.
+        if (m_chunks.use_count() == 1 && m_offset == 0)
+        {
+            m_chunks->resize((pos + chunkCnt - 1) >> chunkShift);
+            if (pos & chunkMask)
+                m_chunks->back().resize(pos & chunkMask);
+        }
+    }
+
+private:
+    // Replace shared or offset chunk storage with a private copy of just
+    // this index's range, leaving other indexes sharing the storage
+    // untouched.
+    void detach()
+    {
+        if (m_chunks.use_count() == 1 && m_offset == 0)
+            return;
+        std::shared_ptr<ChunkVec> chunks(new ChunkVec);
+        chunks->reserve((m_cnt >> chunkShift) + 1);
+        for (size_t pos = 0; pos < m_cnt; ++pos)
+        {
+            if ((pos & chunkMask) == 0)
+                chunks->emplace_back();
+            chunks->back().push_back((*this)[pos]);
+        }
+        m_chunks = chunks;
+        m_offset = 0;
+    }
+
+    void materialize()
+    {
+        m_chunks.reset(new ChunkVec);
+        m_chunks->reserve((m_cnt >> chunkShift) + 1);
+        for (size_t pos = 0; pos < m_cnt; ++pos)
+        {
+            if ((pos & chunkMask) == 0)
+                m_chunks->emplace_back();
+            m_chunks->back().push_back((PointId)(pos + m_offset));
+        }
+        m_identity = false;
+        m_offset = 0;
+    }
+
+    bool m_identity = true;
+    size_t m_cnt = 0;
+    size_t m_offset = 0;
+    std::shared_ptr<ChunkVec> m_chunks;
+};
+
 class PDAL_DLL PointView : public PointContainer
 {
     FRIEND_TEST(VoxelTest, center);
     friend class Stage;
     friend class plang::Invocation;
     friend class PointIdxRef;
+    friend class RandomizeFilter;
     friend struct PointViewLess;
 public:
     PointView(const PointView&) = delete;
@@ -93,19 +317,36 @@ public:
     bool empty() const
         { return m_size == 0; }
 
+    /// Bytes of point-ID index storage backing this view, for memory
+    /// accounting.  Point data itself belongs to the table (see
+    /// BasePointTable::allocated()).
+    uintmax_t allocated() const
+        { return m_index.allocated(); }
+
     inline void appendPoint(const PointView& buffer, PointId id);
     void append(const PointView& buf)
     {
         // We use size() instead of the index end because temp points
         // might have been placed at the end of the buffer.
         // We're essentially ditching temp points.
-        auto thisEnd = m_index.begin() + size();
-        auto bufEnd = buf.m_index.begin() + buf.size();
-        m_index.insert(thisEnd, buf.m_index.begin(), bufEnd);
+        m_index.truncate(size());
+        m_index.append(buf.m_index.slice(0, buf.size()));
         m_size += buf.size();
         clearTemps();
     }
 
+    /// Append \count points of \buf starting at position \start with a
+    /// single index operation rather than one appendPoint() per point.
+    void appendRange(const PointView& buf, PointId start, point_count_t count)
+    {
+        count = (std::min)(count,
+            buf.size() - (std::min)(start, buf.size()));
+        m_index.truncate(size());
+        m_index.append(buf.m_index.slice(start, count));
+        m_size += count;
+        clearTemps();
+    }
+
     /// Return a new point view with the same point table as this
     /// point buffer.
     PointViewPtr makeNew() const
@@ -113,6 +354,19 @@ public:
         return PointViewPtr(new PointView(m_pointTable, m_spatialReference));
     }
 
+    /// Return a view of \count points of this view starting at position
+    /// \start.  The point-ID mapping is shared copy-on-write with this
+    /// view: nothing is allocated or copied until whichever view is
+    /// modified first.
+    PointViewPtr slice(PointId start, point_count_t count) const
+    {
+        count = (std::min)(count, size() - (std::min)(start, size()));
+        PointViewPtr v = makeNew();
+        v->m_index = m_index.slice(start, count);
+        v->m_size = count;
+        return v;
+    }
+
     PointRef point(PointId id)
         { return PointRef(*this, id); }
 
@@ -128,6 +382,31 @@ public:
     inline void setField(Dimension::Id dim, Dimension::Type type,
         PointId idx, const void *val);
 
+    /// Fetch the value of a dimension for a contiguous range of points,
+    /// converted to type T.  A single virtual call services the whole
+    /// range, rather than one per point.
+    template <typename T>
+    void getFieldBatch(Dimension::Id dim, PointId start,
+        point_count_t count, T *buf) const;
+
+    /// Store the value of a dimension for a contiguous range of points,
+    /// converting each value from type T to the dimension's storage type.
+    template <typename T>
+    void setFieldBatch(Dimension::Id dim, PointId start,
+        point_count_t count, const T *buf);
+
+    /// Runtime-typed form of getFieldBatch() for callers that marshal
+    /// into language-neutral buffers: fill \c buf with \c count values
+    /// of \c dim beginning at \c start, converted to \c type.
+    inline void getFieldBatch(Dimension::Id dim, Dimension::Type type,
+        PointId start, point_count_t count, void *buf) const;
+
+    /// Runtime-typed form of setFieldBatch(): store \c count values of
+    /// \c dim beginning at \c start from \c buf, which holds values of
+    /// \c type.
+    inline void setFieldBatch(Dimension::Id dim, Dimension::Type type,
+        PointId start, point_count_t count, const void *buf);
+
     template <typename T>
     bool compare(Dimension::Id dim, PointId id1, PointId id2) const
     {
@@ -230,6 +509,18 @@ public:
         }
     }
 
+    /// Fill a buffer with packed records for a contiguous range of
+    /// points.  Equivalent to calling getPackedPoint() for each point of
+    /// the range, but the data moves a column at a time - one internal
+    /// fetch and one conversion dispatch per dimension rather than one
+    /// per field.
+    /// \param[in] dims   List of dimensions/types to retrieve.
+    /// \param[in] start  Index of the first point to get.
+    /// \param[in] count  Number of points to get.
+    /// \param[in] buf    Pointer to buffer to fill.
+    void getPackedData(const DimTypeList& dims, PointId start,
+        point_count_t count, char *buf) const;
+
     /// Load the point buffer from memory whose arrangement is specified
     /// by the dimension list.
     /// \param[in] dims  Dimension/types of data in packed order
@@ -260,7 +551,7 @@ public:
             assert(m_temps.empty());
         }
 
-        return m_pointTable.getPoint(m_index.at(id));
+        return m_pointTable.getPoint(m_index[id]);
     }
 
     // The standard idiom is swapping with a stack-created empty queue, but
@@ -297,7 +588,7 @@ public:
 
 protected:
     PointTableRef m_pointTable;
-    std::deque<PointId> m_index;
+    ChunkedPointIndex m_index;
     // The index might be larger than the size to support temporary point
     // references.
     point_count_t m_size;
@@ -309,25 +600,75 @@ protected:
     std::unique_ptr<KD2Index> m_index2;
 
 private:
-    static int m_lastId;
+    // Ids order views in a PointViewSet.  The counter is atomic because
+    // views may be created on concurrently executing stages and
+    // concurrent view runs (see Stage::execute()).
+    static std::atomic<int> m_lastId;
+
+    // Draw a fresh id, ordering this view after every existing view.
+    // Stage::execute() uses this to restore a deterministic order to
+    // views created during concurrent view runs, where the ids drawn at
+    // creation depend on thread timing.
+    void resequence()
+        { m_id = ++m_lastId; }
 
     template<typename T_IN, typename T_OUT>
     bool convertAndSet(Dimension::Id dim, PointId idx, T_IN in);
 
+    template <typename T_IN, typename T_OUT>
+    static bool castBatch(const T_IN *in, T_OUT *out, point_count_t count)
+    {
+        for (point_count_t i = 0; i < count; ++i)
+            if (!Utils::numericCast(in[i], out[i]))
+                return false;
+        return true;
+    }
+
     virtual void setFieldInternal(Dimension::Id dim, PointId idx,
         const void *buf);
     virtual void getFieldInternal(Dimension::Id dim, PointId idx,
             void *buf) const
         { m_pointTable.getFieldInternal(dim, m_index[idx], buf); }
+    virtual void getFieldsInternal(Dimension::Id dim, PointId idx,
+        point_count_t count, void *buf) const
+    {
+        // With a contiguous index view positions map to a dense run of
+        // table IDs, so the whole range can be handed to the table in
+        // one call.
+        if (m_index.contiguous())
+            m_pointTable.getFieldsInternal(dim, idx + m_index.offset(),
+                count, buf);
+        else
+        {
+            char *dst = (char *)buf;
+            size_t size = layout()->dimSize(dim);
+            for (point_count_t i = 0; i < count; ++i, dst += size)
+                m_pointTable.getFieldInternal(dim, m_index[idx + i], dst);
+        }
+    }
+    virtual void setFieldsInternal(Dimension::Id dim, PointId idx,
+        point_count_t count, const void *buf)
+    {
+        if (m_index.contiguous())
+            m_pointTable.setFieldsInternal(dim, idx + m_index.offset(),
+                count, buf);
+        else
+        {
+            const char *src = (const char *)buf;
+            size_t size = layout()->dimSize(dim);
+            for (point_count_t i = 0; i < count; ++i, src += size)
+                m_pointTable.setFieldInternal(dim, m_index[idx + i], src);
+        }
+    }
     virtual void swapItems(PointId id1, PointId id2)
     {
         PointId temp = m_index[id2];
-        m_index[id2] = m_index[id1];
-        m_index[id1] = temp;
+        m_index.set(id2, m_index[id1]);
+        m_index.set(id1, temp);
     }
     virtual void setItem(PointId dst, PointId src)
     {
-        m_index[dst] = m_index[src];
+        m_index.set(dst, m_index[src]);
     }
 
     template<class T>
@@ -401,6 +742,106 @@ inline void PointView::getField(char *pos, Dimension::Id d,
     memcpy(pos, &e, Dimension::size(type));
 }
 
+inline void PointView::getFieldBatch(Dimension::Id dim, Dimension::Type type,
+    PointId start, point_count_t count, void *buf) const
+{
+    assert(start + count <= m_size);
+
+    // When the requested type is the dimension's storage type, the
+    // internal fetch fills the caller's buffer directly.
+    if (type == layout()->dimDetail(dim)->type())
+    {
+        getFieldsInternal(dim, start, count, buf);
+        return;
+    }
+
+    switch (type)
+    {
+    case Dimension::Type::Float:
+        getFieldBatch(dim, start, count, (float *)buf);
+        break;
+    case Dimension::Type::Double:
+        getFieldBatch(dim, start, count, (double *)buf);
+        break;
+    case Dimension::Type::Signed8:
+        getFieldBatch(dim, start, count, (int8_t *)buf);
+        break;
+    case Dimension::Type::Signed16:
+        getFieldBatch(dim, start, count, (int16_t *)buf);
+        break;
+    case Dimension::Type::Signed32:
+        getFieldBatch(dim, start, count, (int32_t *)buf);
+        break;
+    case Dimension::Type::Signed64:
+        getFieldBatch(dim, start, count, (int64_t *)buf);
+        break;
+    case Dimension::Type::Unsigned8:
+        getFieldBatch(dim, start, count, (uint8_t *)buf);
+        break;
+    case Dimension::Type::Unsigned16:
+        getFieldBatch(dim, start, count, (uint16_t *)buf);
+        break;
+    case Dimension::Type::Unsigned32:
+        getFieldBatch(dim, start, count, (uint32_t *)buf);
+        break;
+    case Dimension::Type::Unsigned64:
+        getFieldBatch(dim, start, count, (uint64_t *)buf);
+        break;
+    case Dimension::Type::None:
+        break;
+    }
+}
+
+inline void PointView::setFieldBatch(Dimension::Id dim, Dimension::Type type,
+    PointId start, point_count_t count, const void *buf)
+{
+    assert(start + count <= m_size);
+
+    // When the source type is the dimension's storage type, the internal
+    // store reads the caller's buffer directly.
+    if (type == layout()->dimDetail(dim)->type())
+    {
+        setFieldsInternal(dim, start, count, buf);
+        return;
+    }
+
+    switch (type)
+    {
+    case Dimension::Type::Float:
+        setFieldBatch(dim, start, count, (const float *)buf);
+        break;
+    case Dimension::Type::Double:
+        setFieldBatch(dim, start, count, (const double *)buf);
+        break;
+    case Dimension::Type::Signed8:
+        setFieldBatch(dim, start, count, (const int8_t *)buf);
+        break;
+    case Dimension::Type::Signed16:
+        setFieldBatch(dim, start, count, (const int16_t *)buf);
+        break;
+    case Dimension::Type::Signed32:
+        setFieldBatch(dim, start, count, (const int32_t *)buf);
+        break;
+    case Dimension::Type::Signed64:
+        setFieldBatch(dim, start, count, (const int64_t *)buf);
+        break;
+    case Dimension::Type::Unsigned8:
+        setFieldBatch(dim, start, count, (const uint8_t *)buf);
+        break;
+    case Dimension::Type::Unsigned16:
+        setFieldBatch(dim, start, count, (const uint16_t *)buf);
+        break;
+    case Dimension::Type::Unsigned32:
+        setFieldBatch(dim, start, count, (const uint32_t *)buf);
+        break;
+    case Dimension::Type::Unsigned64:
+        setFieldBatch(dim, start, count, (const uint64_t *)buf);
+        break;
+    case Dimension::Type::None:
+        break;
+    }
+}
+
 inline void PointView::setField(Dimension::Id dim,
     Dimension::Type type, PointId idx, const void *val)
 {
@@ -518,6 +959,133 @@ inline T PointView::getFieldAs(Dimension::Id dim,
 }
 
 
+template <typename T>
+void PointView::getFieldBatch(Dimension::Id dim, PointId start,
+    point_count_t count, T *buf) const
+{
+    assert(start + count <= m_size);
+    const Dimension::Detail *dd = layout()->dimDetail(dim);
+
+    // Fetch the native values with a single call, then convert.  The
+    // staging buffer is uint64_t so any native type is aligned.
+    std::vector<uint64_t> store((count * dd->size() + 7) / 8);
+    const char *natives = reinterpret_cast<const char *>(store.data());
+    getFieldsInternal(dim, start, count, store.data());
+
+    bool ok = false;
+    switch (dd->type())
+    {
+    case Dimension::Type::Float:
+        ok = castBatch((const float *)natives, buf, count);
+        break;
+    case Dimension::Type::Double:
+        ok = castBatch((const double *)natives, buf, count);
+        break;
+    case Dimension::Type::Signed8:
+        ok = castBatch((const int8_t *)natives, buf, count);
+        break;
+    case Dimension::Type::Signed16:
+        ok = castBatch((const int16_t *)natives, buf, count);
+        break;
+    case Dimension::Type::Signed32:
+        ok = castBatch((const int32_t *)natives, buf, count);
+        break;
+    case Dimension::Type::Signed64:
+        ok = castBatch((const int64_t *)natives, buf, count);
+        break;
+    case Dimension::Type::Unsigned8:
+        ok = castBatch((const uint8_t *)natives, buf, count);
+        break;
+    case Dimension::Type::Unsigned16:
+        ok = castBatch((const uint16_t *)natives, buf, count);
+        break;
+    case Dimension::Type::Unsigned32:
+        ok = castBatch((const uint32_t *)natives, buf, count);
+        break;
+    case Dimension::Type::Unsigned64:
+        ok = castBatch((const uint64_t *)natives, buf, count);
+        break;
+    case Dimension::Type::None:
+    default:
+        // Match getFieldAs(), which reads a dimension of type None as 0.
+        std::fill(buf, buf + count, T(0));
+        ok = true;
+        break;
+    }
+
+    if (!ok)
+    {
+        std::ostringstream oss;
+        oss << "Unable to fetch data and convert as requested: ";
+        oss << Dimension::name(dim) << ":" <<
+            Dimension::interpretationName(dd->type()) << " -> " <<
+            Utils::typeidName<T>();
+        throw pdal_error(oss.str());
+    }
+}
+
+
+template <typename T>
+void PointView::setFieldBatch(Dimension::Id dim, PointId start,
+    point_count_t count, const T *buf)
+{
+    assert(start + count <= m_size);
+    const Dimension::Detail *dd = layout()->dimDetail(dim);
+
+    std::vector<uint64_t> store((count * dd->size() + 7) / 8);
+    char *natives = reinterpret_cast<char *>(store.data());
+
+    bool ok = false;
+    switch (dd->type())
+    {
+    case Dimension::Type::Float:
+        ok = castBatch(buf, (float *)natives, count);
+        break;
+    case Dimension::Type::Double:
+        ok = castBatch(buf, (double *)natives, count);
+        break;
+    case Dimension::Type::Signed8:
+        ok = castBatch(buf, (int8_t *)natives, count);
+        break;
+    case Dimension::Type::Signed16:
+        ok = castBatch(buf, (int16_t *)natives, count);
+        break;
+    case Dimension::Type::Signed32:
+        ok = castBatch(buf, (int32_t *)natives, count);
+        break;
+    case Dimension::Type::Signed64:
+        ok = castBatch(buf, (int64_t *)natives, count);
+        break;
+    case Dimension::Type::Unsigned8:
+        ok = castBatch(buf, (uint8_t *)natives, count);
+        break;
+    case Dimension::Type::Unsigned16:
+        ok = castBatch(buf, (uint16_t *)natives, count);
+        break;
+    case Dimension::Type::Unsigned32:
+        ok = castBatch(buf, (uint32_t *)natives, count);
+        break;
+    case Dimension::Type::Unsigned64:
+        ok = castBatch(buf, (uint64_t *)natives, count);
+        break;
+    case Dimension::Type::None:
+    default:
+        break;
+    }
+
+    if (!ok)
+    {
+        std::ostringstream oss;
+        oss << "Unable to set data and convert as requested: ";
+        oss << Dimension::name(dim) << ":" << Utils::typeidName<T>() <<
+            " -> " << Dimension::interpretationName(dd->type());
+        throw pdal_error(oss.str());
+    }
+
+    setFieldsInternal(dim, start, count, natives);
+}
+
+
 template<typename T_IN, typename T_OUT>
 bool PointView::convertAndSet(Dimension::Id dim, PointId idx, T_IN in)
 {
@@ -601,7 +1169,7 @@ inline PointId PointView::getTemp(PointId id)
     {
         newid = m_temps.front();
         m_temps.pop();
-        m_index[newid] = m_index[id];
+        m_index.set(newid, m_index[id]);
     }
     else
     {
@@ -279,6 +279,16 @@ bool Polygon::intersects(const Polygon& p) const
     return m_geom->Intersects(p.m_geom.get());
 }
 
+void Polygon::prepare() const
+{
+    if (m_pd->m_grids.empty())
+        for (const Polygon& p : polygons())
+            m_pd->m_grids.emplace_back(p.exteriorRing(), p.interiorRings());
+    for (auto& g : m_pd->m_grids)
+        g.prepare();
+}
+
+
 /// Determine whether this polygon contains a point.
 /// \param x  Point x coordinate.
 /// \param y  Point y coordinate.
@@ -289,12 +299,26 @@ bool Polygon::contains(double x, double y) const
         for (const Polygon& p : polygons())
             m_pd->m_grids.emplace_back(p.exteriorRing(), p.interiorRings());
     for (auto& g : m_pd->m_grids)
-        if (g.inside(x, y))
+    {
+        // The bounding box test is a cheap prefilter - points away from
+        // a part are resolved without touching its grid.
+        if (x >= g.xMin() && x <= g.xMax() && y >= g.yMin() &&
+            y <= g.yMax() && g.inside(x, y))
             return true;
+    }
     return false;
 }
 
 
+void Polygon::contains(const double *x, const double *y, bool *result,
+    size_t count) const
+{
+    prepare();
+    for (size_t i = 0; i < count; ++i)
+        result[i] = contains(x[i], y[i]);
+}
+
+
 bool Polygon::touches(const Polygon& p) const
 {
     throwNoGeos();
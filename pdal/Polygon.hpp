@@ -73,7 +73,30 @@ public:
     bool covers(const PointRef& ref) const;
     bool equal(const Polygon& p) const;
     bool overlaps(const Polygon& p) const;
+
+    /**
+      Build the point-in-polygon acceleration state now rather than
+      lazily on the first contains() call.  The state lives until the
+      geometry is modified; once prepared, contains() only reads and
+      may be called concurrently from multiple threads.
+    */
+    void prepare() const;
+
     bool contains(double x, double y) const;
+
+    /**
+      Batch counterpart of contains(): test \a count x/y pairs and write
+      one flag per point.  Callers holding coordinate arrays test an
+      entire block of points in one call against the prepared geometry.
+
+      \param x  Array of x coordinates.
+      \param y  Array of y coordinates.
+      \param result  Array to receive one flag per point.
+      \param count  Number of points to test.
+    */
+    void contains(const double *x, const double *y, bool *result,
+        size_t count) const;
+
     bool contains(const Polygon& p) const;
     bool intersects(const Polygon& p) const;
     bool disjoint(const Polygon& p) const;
@@ -50,8 +50,11 @@ public:
     point_count_t m_pointCount;
     StringList m_dimNames;
     bool m_valid;
+    // Whether the count and bounds are exact rather than estimated
+    // from partial data.
+    bool m_exact;
 
-    QuickInfo() : m_pointCount(0), m_valid(false)
+    QuickInfo() : m_pointCount(0), m_valid(false), m_exact(true)
         {}
 
     bool valid() const
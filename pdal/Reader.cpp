@@ -54,6 +54,63 @@ void Reader::readerAddArgs(ProgramArgs& args)
 }
 
 
+void Reader::pushdownDims(const StringList& dims)
+{
+    m_dimPushdown = true;
+    m_pushdownDims.clear();
+    for (const std::string& d : dims)
+        m_pushdownDims.insert(Utils::toupper(d));
+
+    // Position dimensions are always loaded.
+    m_pushdownDims.insert("X");
+    m_pushdownDims.insert("Y");
+    m_pushdownDims.insert("Z");
+}
+
+
+bool Reader::keepDim(const std::string& name) const
+{
+    return !m_dimPushdown ||
+        m_pushdownDims.count(Utils::toupper(name));
+}
+
+
+bool Reader::keepDim(Dimension::Id id) const
+{
+    return keepDim(Dimension::name(id));
+}
+
+
+void Reader::pushdownBounds(const std::vector<Bounds>& bounds)
+{
+    m_pushdownBounds = bounds;
+}
+
+
+void Reader::pushdownRanges(const std::vector<DimInterval>& ranges)
+{
+    m_pushdownRanges = ranges;
+}
+
+
+bool Reader::pushdownOverlaps(const BOX3D& box) const
+{
+    if (m_pushdownBounds.empty() || !box.valid())
+        return true;
+    for (const Bounds& b : m_pushdownBounds)
+    {
+        if (b.is3d())
+        {
+            if (b.to3d().overlaps(box))
+                return true;
+        }
+        else if (b.to2d().overlaps(box.to2d()))
+            return true;
+    }
+    return false;
+}
+
+
 void Reader::setSpatialReference(MetadataNode& m, const SpatialReference& srs)
 {
     if (srs.empty() && !m_defaultSrs.empty())
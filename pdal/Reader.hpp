@@ -38,6 +38,7 @@
 #include <pdal/Options.hpp>
 
 #include <functional>
+#include <set>
 
 namespace pdal
 {
@@ -57,6 +58,67 @@ public:
     point_count_t count() const
         { return m_count; }
 
+    /**
+      Restrict the reader to loading only the named dimensions.  X, Y
+      and Z are always loaded.  Readers that support pruning consult
+      keepDim() when registering and extracting dimensions; others
+      ignore the hint.  Called by PipelineManager before the pipeline
+      is prepared when every downstream stage can enumerate the
+      dimensions it uses (see Stage::usedDims()).
+
+      \param dims  Names of the dimensions used downstream.
+    */
+    void pushdownDims(const StringList& dims);
+
+    /**
+      Restrict the reader to the provided bounds.  A reader may use the
+      hint to skip data that can't intersect any of the bounds; it need
+      not filter exactly - points outside the bounds may still be
+      produced.  Called by PipelineManager before the pipeline is
+      prepared when every stage consuming the reader's output crops to
+      these bounds (see Stage::cropBounds()).
+
+      \param bounds  Bounds outside of which all points are discarded
+        downstream.
+    */
+    void pushdownBounds(const std::vector<Bounds>& bounds);
+
+    /**
+      Restrict the reader to points whose values fall inside the
+      provided intervals.  A reader may use the hint to skip data whose
+      statistics show no value inside an interval; it need not filter
+      exactly - points outside the intervals may still be produced.
+      Called by PipelineManager before the pipeline is prepared when
+      every stage consuming the reader's output discards points outside
+      these intervals (see Stage::rangeBounds()).
+
+      \param ranges  Intervals outside of which all points are
+        discarded downstream, at most one per dimension.
+    */
+    void pushdownRanges(const std::vector<DimInterval>& ranges);
+
+    /**
+      Whether the reader can cheaply resume production at an arbitrary
+      point index (see resumeAt()).  Consulted by PipelineManager when
+      a checkpoint file records the position at which an interrupted
+      streaming run stopped (see PipelineManager::setCheckpoint()).
+
+      \return  true when resumeAt() repositions without re-reading the
+        skipped points.
+    */
+    virtual bool resumable() const
+        { return false; }
+
+    /**
+      Resume production at the given point: points before \c start are
+      not produced.  Only meaningful for readers reporting resumable();
+      must be called before the reader is made ready.
+
+      \param start  Index of the first point to produce.
+    */
+    void resumeAt(point_count_t start)
+        { m_resumePoint = start; }
+
     using Stage::setSpatialReference;
 
 protected:
@@ -69,6 +131,52 @@ protected:
     SpatialReference m_overrideSrs;
     SpatialReference m_defaultSrs;
 
+    /**
+      Determine whether a dimension should be loaded.
+
+      \param name  Dimension name.
+      \return  false only when a pushdown set was provided and doesn't
+        contain the named dimension.
+    */
+    bool keepDim(const std::string& name) const;
+
+    /**
+      \copydoc keepDim(const std::string&) const
+      \param id  Dimension ID.
+    */
+    bool keepDim(Dimension::Id id) const;
+
+    /**
+      The bounds provided by bounds pushdown - empty when none were
+      pushed down.
+    */
+    const std::vector<Bounds>& pushdownBounds() const
+        { return m_pushdownBounds; }
+
+    /**
+      The intervals provided by range pushdown - empty when none were
+      pushed down.
+    */
+    const std::vector<DimInterval>& pushdownRanges() const
+        { return m_pushdownRanges; }
+
+    /**
+      The point index at which production should resume - 0 when no
+      resume was requested.
+    */
+    point_count_t resumePoint() const
+        { return m_resumePoint; }
+
+    /**
+      Determine whether data covering \c box may contribute points to
+      the pipeline's output.
+
+      \param box  Extent of some portion of the reader's data.
+      \return  false only when bounds were pushed down and none of them
+        overlaps \c box.
+    */
+    bool pushdownOverlaps(const BOX3D& box) const;
+
     virtual void setSpatialReference(MetadataNode& m,
             const SpatialReference& srs);
 
@@ -86,6 +194,12 @@ private:
     virtual void readerAddArgs(ProgramArgs& args);
     virtual point_count_t read(PointViewPtr /*view*/, point_count_t /*num*/)
         { return 0; }
+
+    bool m_dimPushdown = false;
+    std::set<std::string> m_pushdownDims; // Uppercased dimension names.
+    std::vector<Bounds> m_pushdownBounds;
+    std::vector<DimInterval> m_pushdownRanges;
+    point_count_t m_resumePoint = 0;
 };
 
 } // namespace pdal
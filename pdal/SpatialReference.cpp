@@ -32,7 +32,9 @@
  * OF SUCH DAMAGE.
  ****************************************************************************/
 
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include <pdal/Metadata.hpp>
 #include <pdal/PDALUtils.hpp>
@@ -71,6 +73,13 @@ OGRScopedSpatialReference ogrCreateSrs(std::string s = "")
             OSRNewSpatialReference(s.size() ? s.c_str() : nullptr)));
 }
 
+// Process-wide cache of user input -> WKT.  Resolving a definition like
+// "EPSG:2056" goes through the PROJ database, which is slow enough to
+// matter when many readers construct the same SRS.  Failed conversions
+// aren't cached, so each bad input still reports its own error.
+std::mutex srsCacheMutex;
+std::map<std::string, std::string> srsCache;
+
 }
 
 namespace pdal
@@ -154,6 +163,16 @@ void SpatialReference::set(std::string v)
         return;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(srsCacheMutex);
+        auto it = srsCache.find(v);
+        if (it != srsCache.end())
+        {
+            m_wkt = it->second;
+            return;
+        }
+    }
+
     OGRSpatialReference srs(NULL);
 
     CPLErrorReset();
@@ -174,6 +193,9 @@ void SpatialReference::set(std::string v)
     srs.exportToWkt(&poWKT);
     m_wkt = poWKT;
     CPLFree(poWKT);
+
+    std::lock_guard<std::mutex> lock(srsCacheMutex);
+    srsCache.insert(std::make_pair(v, m_wkt));
 }
 
 
@@ -36,20 +36,51 @@
 #include <pdal/PipelineManager.hpp>
 #include <pdal/Stage.hpp>
 #include <pdal/SpatialReference.hpp>
+#include <pdal/Trace.hpp>
 #include <pdal/PDALUtils.hpp>
 #include <pdal/util/Algorithm.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
 #include "private/StageRunner.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 namespace pdal
 {
 
+namespace
+{
+
+// Process peak resident set size in bytes, or 0 where unavailable.
+uint64_t peakRss()
+{
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+#ifdef __APPLE__
+        return (uint64_t)usage.ru_maxrss;
+#else
+        return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+    return 0;
+}
+
+} // unnamed namespace
+
 Stage::Stage() : m_progressFd(-1), m_verbose(0), m_pointCount(0),
-    m_faceCount(0)
+    m_faceCount(0), m_concurrent(false)
 {}
 
 
@@ -100,7 +131,16 @@ void Stage::addAllArgs(ProgramArgs& args)
 
 void Stage::handleOptions()
 {
-    addAllArgs(*m_args);
+    // Stages get prepared repeatedly.  Building the argument set is
+    // allocation-heavy, so build it once and reset bound values to their
+    // defaults on reuse.
+    if (!m_args)
+    {
+        m_args.reset(new ProgramArgs);
+        addAllArgs(*m_args);
+    }
+    else
+        m_args->reset();
 
     StringList files = m_options.getValues("option_file");
     for (std::string& file : files)
@@ -114,10 +154,13 @@ void Stage::handleOptions()
         m_options.addConditional(Options::fromFile(file, false));
     m_options.remove(Option("grid_option_file", 0));
 
-    StringList cmdline = m_options.toCommandLine();
+    // Feed options to their arguments directly rather than formatting
+    // command-line text and parsing it back apart.
     try
     {
-        m_args->parse(cmdline);
+        for (auto oi = m_options.begin(); oi != m_options.end(); ++oi)
+            m_args->parseOption(oi->first, oi->second.getValue());
+        m_args->checkPositionals();
     }
     catch (arg_error error)
     {
@@ -129,7 +172,6 @@ void Stage::handleOptions()
 
 QuickInfo Stage::preview()
 {
-    m_args.reset(new ProgramArgs);
     handleOptions();
     startLogging();
     QuickInfo qi = inspect();
@@ -138,9 +180,34 @@ QuickInfo Stage::preview()
 }
 
 
+QuickInfo Stage::estimate()
+{
+    if (m_inputs.empty())
+        return preview();
+
+    QuickInfo qi;
+    for (Stage *s : m_inputs)
+    {
+        QuickInfo sub = s->estimate();
+        if (!sub.valid())
+            return QuickInfo();
+        qi.m_pointCount += sub.m_pointCount;
+        qi.m_bounds.grow(sub.m_bounds);
+        if (qi.m_srs.empty())
+            qi.m_srs = sub.m_srs;
+        for (const std::string& name : sub.m_dimNames)
+            if (!Utils::contains(qi.m_dimNames, name))
+                qi.m_dimNames.push_back(name);
+        if (!sub.m_exact)
+            qi.m_exact = false;
+        qi.m_valid = true;
+    }
+    return qi;
+}
+
+
 void Stage::prepare(PointTableRef table)
 {
-    m_args.reset(new ProgramArgs);
     for (size_t i = 0; i < m_inputs.size(); ++i)
     {
         Stage *prev = m_inputs[i];
@@ -164,64 +231,167 @@ PointViewSet Stage::execute(PointTableRef table)
     // executed more than once.  A stage instance is created for each
     // execution of a stage in a pipeline.  This properly builds out
     // diamond-shaped pipelines.
-    int stageInstanceId = 1;
     struct StageInstance
     {
         Stage *m_stage;
-        int m_id;
-
-        StageInstance(Stage *s, int id) : m_stage(s), m_id(id)
-        {}
-        StageInstance() : m_stage(nullptr), m_id(0)
+        // Index of the instance consuming our output, or -1 for the
+        // terminal stage.
+        int m_child;
+        // Number of input instances that haven't completed yet.
+        int m_pending;
+        PointViewSet m_views;
+
+        StageInstance(Stage *s, int child) : m_stage(s), m_child(child),
+            m_pending(0)
         {}
-
-        bool operator<(const StageInstance& other) const
-        { return m_id < other.m_id; }
     };
 
-    std::stack<StageInstance> stages;
-    std::stack<StageInstance> pending;
-    std::map<StageInstance, StageInstance> children;
-
     m_log->get(LogLevel::Debug) << "Executing pipeline in standard mode." <<
         std::endl;
 
-    pending.push(StageInstance(this, stageInstanceId++));
+    // Build the instance DAG.  Each instance knows the instance that
+    // consumes its output and the number of producers it waits on.
+    std::vector<StageInstance> instances;
+    std::stack<int> pending;
 
-    // Linearize stage execution.
+    instances.emplace_back(this, -1);
+    pending.push(0);
     while (pending.size())
     {
-        StageInstance si = pending.top();
+        int idx = pending.top();
         pending.pop();
-        stages.push(si);
-        for (Stage *in : si.m_stage->m_inputs)
+        for (Stage *in : instances[idx].m_stage->m_inputs)
         {
-            StageInstance parent(in, stageInstanceId++);
-            pending.push(parent);
-            children[parent] = si;
+            instances.emplace_back(in, idx);
+            instances[idx].m_pending++;
+            pending.push((int)instances.size() - 1);
         }
     }
 
-    // Go through the stages in order, executing
+    // Instances with no pending producers (the readers) are ready to run.
+    // As each instance finishes, its output views are handed to its
+    // consumer, which becomes ready once all its producers are done.
+    // Independent instances run concurrently when the table supports
+    // concurrent point addition.
+    std::vector<int> ready;
+    for (size_t i = 0; i < instances.size(); ++i)
+        if (instances[i].m_pending == 0)
+            ready.push_back((int)i);
+
+    // A stage may appear as more than one instance (diamond pipelines).
+    // Instances sharing a stage can't run concurrently since a stage
+    // carries per-execution state, so a ready instance is runnable only
+    // when no other instance of its stage is active.
+    std::set<Stage *> running;
+    auto runnable = [&]() -> int
+    {
+        for (size_t i = 0; i < ready.size(); ++i)
+            if (running.find(instances[ready[i]].m_stage) == running.end())
+                return (int)i;
+        return -1;
+    };
+
+    size_t threadCnt = 1;
+    if (table.concurrentAddSafe())
+        threadCnt = (std::min)((size_t)std::thread::hardware_concurrency(),
+            instances.size());
+    threadCnt = (std::max)(threadCnt, (size_t)1);
+
     PointViewSet outViews;
-    std::map<StageInstance, PointViewSet> sets;
-    while (stages.size())
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t remaining = instances.size();
+    std::exception_ptr error;
+
+    auto work = [&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            int pos;
+            cv.wait(lock, [&]()
+                { return !remaining || error ||
+                    (pos = runnable()) != -1; });
+            if (!remaining || error)
+                return;
+            int idx = ready[pos];
+            ready.erase(ready.begin() + pos);
+            StageInstance& si = instances[idx];
+            running.insert(si.m_stage);
+
+            PointViewSet inViews = std::move(si.m_views);
+            si.m_views.clear();
+
+            lock.unlock();
+            PointViewSet views;
+            try
+            {
+                if (inViews.empty())
+                    inViews.insert(PointViewPtr(new PointView(table)));
+                PDAL_TRACE_SCOPE("stage:" + si.m_stage->getName());
+                views = si.m_stage->execute(table, inViews);
+            }
+            catch (...)
+            {
+                lock.lock();
+                if (!error)
+                    error = std::current_exception();
+                cv.notify_all();
+                return;
+            }
+            lock.lock();
+
+            running.erase(si.m_stage);
+            if (si.m_child >= 0)
+            {
+                StageInstance& child = instances[si.m_child];
+                // A consumer with a single producer - the common linear
+                // pipeline - takes the whole set by move; merging only
+                // happens at a join, where the refcount traffic of
+                // copying the pointers is unavoidable.
+                if (child.m_views.empty())
+                    child.m_views = std::move(views);
+                else
+                    child.m_views.insert(views.begin(), views.end());
+                if (--child.m_pending == 0)
+                    ready.push_back(si.m_child);
+            }
+            else
+                outViews = std::move(views);
+            remaining--;
+            cv.notify_all();
+        }
+    };
+
+    if (threadCnt > 1)
     {
-        StageInstance si = stages.top();
-        stages.pop();
-        PointViewSet& inViews = sets[si];
-        if (inViews.empty())
-            inViews.insert(PointViewPtr(new PointView(table)));
-        outViews = si.m_stage->execute(table, inViews);
-
-        StageInstance child = children[si];
-
-        // If a stage has no child it is the terminal stage.  We're done.
-        if (child.m_stage)
-            sets[child].insert(outViews.begin(), outViews.end());
-        // Allow previous point views to be freed.
-        sets.erase(si);
+        m_log->get(LogLevel::Debug) << "Running independent stages on " <<
+            threadCnt << " threads." << std::endl;
+
+        // Process-global state can't be set per-stage from the workers:
+        // point the GDAL error handler at our log once for the whole run
+        // and clear the table's SRS list here - the stages add their
+        // views' references without clearing (see execute(table, views)).
+        gdal::ErrorHandler::getGlobalErrorHandler().set(m_log, isDebug());
+        table.clearSpatialReferences();
+        for (StageInstance& si : instances)
+            si.m_stage->m_concurrent = true;
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threadCnt; ++i)
+            threads.emplace_back(work);
+        work();
+        for (auto& t : threads)
+            t.join();
+
+        for (StageInstance& si : instances)
+            si.m_stage->m_concurrent = false;
     }
+    else
+        work();
+
+    if (error)
+        std::rethrow_exception(error);
     return outViews;
 }
 
@@ -240,7 +410,11 @@ PointViewSet Stage::execute(PointTableRef table, PointViewSet& views)
     //   completed?  Wondering if that would break something where a
     //   writer wants to check a table's SRS.
     SpatialReference srs;
-    table.clearSpatialReferences();
+    // When stages run concurrently they share the table, so clearing
+    // would wipe the references of other running stages mid-run; the
+    // scheduler clears once up front and the lists merge.
+    if (!m_concurrent)
+        table.clearSpatialReferences();
     // Iterating backwards will ensure that the SRS for the first view is
     // first on the list for table.
     for (auto it = views.rbegin(); it != views.rend(); it++)
@@ -259,31 +433,111 @@ PointViewSet Stage::execute(PointTableRef table, PointViewSet& views)
     }
     // Do the ready operation and then start running all the views
     // through the stage.
+    auto startTime = std::chrono::steady_clock::now();
+    uintmax_t memBefore = table.allocated();
+    uintmax_t allocsBefore = table.allocations();
     ready(table);
     prerun(views);
     for (auto const& it : views)
+        runners.push_back(StageRunnerPtr(new StageRunner(this, it)));
+
+    // Stages declaring their view runs independent have the runs
+    // spread across threads when a pipeline carries multiple views
+    // (post-splitter, typically).
+    size_t threadCnt = 1;
+    if (concurrentViewSafe() && table.concurrentAddSafe())
+        threadCnt = (std::min)((size_t)std::thread::hardware_concurrency(),
+            runners.size());
+    threadCnt = (std::max)(threadCnt, (size_t)1);
+
+    if (threadCnt > 1)
     {
-        StageRunnerPtr runner(new StageRunner(this, it));
-        runners.push_back(runner);
-        runner->run();
+        m_log->get(LogLevel::Debug) << "Running " << runners.size() <<
+            " views on " << threadCnt << " threads." << std::endl;
+
+        std::atomic<size_t> next(0);
+        std::mutex mutex;
+        std::exception_ptr error;
+        auto work = [&]()
+        {
+            while (true)
+            {
+                size_t i = next.fetch_add(1);
+                if (i >= runners.size())
+                    return;
+                try
+                {
+                    runners[i]->run();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error)
+                        error = std::current_exception();
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threadCnt; ++i)
+            threads.emplace_back(work);
+        work();
+        for (auto& t : threads)
+            t.join();
+        if (error)
+            std::rethrow_exception(error);
     }
+    else
+        for (auto const& runner : runners)
+            runner->run();
 
-    // As the stages complete (synchronously at this time), propagate the
-    // spatial reference and merge the output views.
+    // As the stages complete, propagate the spatial reference and merge
+    // the output views.
     srs = getSpatialReference();
-    for (auto const& it : runners)
+    for (auto const& runner : runners)
     {
-        StageRunnerPtr runner(it);
         PointViewSet temp = runner->wait();
 
         // If our stage has a spatial reference, the view takes it on once
         // the stage has been run.
         if (!srs.empty())
-            for (PointViewPtr v : temp)
+            for (const PointViewPtr& v : temp)
                 v->setSpatialReference(srs);
-        outViews.insert(temp.begin(), temp.end());
+        // Ids drawn for views created on the worker threads depend on
+        // thread timing.  Redraw them here, in input-view order, so the
+        // output set orders the same way from run to run.  Within a
+        // runner the ids are drawn on one thread and so already order
+        // views by creation.
+        if (threadCnt > 1)
+        {
+            std::vector<PointViewPtr> ordered(temp.begin(), temp.end());
+            temp.clear();
+            for (PointViewPtr& v : ordered)
+            {
+                if (v != runner->view())
+                    v->resequence();
+                temp.insert(v);
+            }
+        }
+        // With a single runner - one input view, the common case - the
+        // output set moves through whole.
+        if (outViews.empty())
+            outViews = std::move(temp);
+        else
+            outViews.insert(temp.begin(), temp.end());
     }
     done(table);
+    std::chrono::duration<double> execTime =
+        std::chrono::steady_clock::now() - startTime;
+    // Count output points so that readers, which see no input, are
+    // credited with the points they produce.
+    point_count_t outPoints = 0;
+    for (auto const& v : outViews)
+        outPoints += v->size();
+    addMetrics(execTime.count(), outPoints);
+    addMemoryMetrics(memBefore, table.allocated(),
+        table.allocations() - allocsBefore);
     stopLogging();
     m_pointCount = 0;
     m_faceCount = 0;
@@ -291,6 +545,25 @@ PointViewSet Stage::execute(PointTableRef table, PointViewSet& views)
 }
 
 
+void Stage::addMetrics(double secs, point_count_t points)
+{
+    m_metrics.m_wallSecs += secs;
+    m_metrics.m_points += points;
+    m_metrics.m_peakRss = (std::max)(m_metrics.m_peakRss, peakRss());
+}
+
+
+void Stage::addMemoryMetrics(uintmax_t before, uintmax_t after,
+    uintmax_t growthEvents)
+{
+    if (after > before)
+        m_metrics.m_tableGrowth += after - before;
+    m_metrics.m_growthEvents += growthEvents;
+    m_metrics.m_peakTableBytes =
+        (std::max)(m_metrics.m_peakTableBytes, (uint64_t)after);
+}
+
+
 void Stage::l_addArgs(ProgramArgs& args)
 {
     args.add("user_data", "User JSON", m_userDataJSON);
@@ -397,7 +670,11 @@ void Stage::throwError(const std::string& s) const
 void Stage::startLogging() const
 {
     m_log->pushLeader(m_logLeader);
-    gdal::ErrorHandler::getGlobalErrorHandler().set(m_log, isDebug());
+    // The GDAL error handler is process-global; when stages run
+    // concurrently it's set once for the whole run instead (see
+    // execute()).
+    if (!m_concurrent)
+        gdal::ErrorHandler::getGlobalErrorHandler().set(m_log, isDebug());
 }
 
 
@@ -58,6 +58,18 @@ class StageRunner;
 class StageWrapper;
 class Streamable;
 
+/**
+  A closed interval of values for a named dimension.  Produced by stages
+  that filter on simple value ranges (see Stage::rangeBounds()) and
+  consumed by readers as a skip hint (see Reader::pushdownRanges()).
+*/
+struct DimInterval
+{
+    std::string m_name;     ///< Dimension name.
+    double m_min;           ///< Smallest value kept.
+    double m_max;           ///< Largest value kept.
+};
+
 /**
   A stage performs the actual processing in PDAL.  Stages may read data,
   modify or filter read data, create metadata or write processed data.
@@ -99,6 +111,17 @@ public:
     */
     QuickInfo preview();
 
+    /**
+      Get a cheap estimate of the point count and extent this stage will
+      produce, without reading point data.  Leaf stages report through
+      \ref preview; stages with inputs combine their inputs' estimates.
+      Useful for sizing buffers and partitioning work before \ref execute.
+
+      \return  Combined QuickInfo, invalid if any contributing stage
+        can't provide an estimate.
+    */
+    QuickInfo estimate();
+
     /**
       Prepare a stage for execution.  This function needs to be called on the
       terminal stage of a pipeline (linked set of stages) before \ref execute
@@ -120,6 +143,18 @@ public:
     */
     PointViewSet execute(PointTableRef table);
 
+    /**
+      Execute this stage alone, feeding it the provided input views.
+      Inputs of the stage are NOT executed - callers driving a set of
+      stages themselves (see TIndexReader) use this to run one stage
+      at a time.
+
+      \param table  PointTable
+      \param pvSet  Input PointViewSet
+      \return  Output PointViewSet
+    */
+    PointViewSet execute(PointTableRef table, PointViewSet& pvSet);
+
     virtual void execute(StreamPointTable& table)
     {
         throw pdal_error("Attempting to use stream mode with a non-streamable "
@@ -144,6 +179,98 @@ public:
     virtual const Stage *findNonstreamable() const
     { return this; }
 
+    /**
+      Append the names of the dimensions this stage reads or writes to
+      \c used.  Stages that can enumerate every dimension they touch
+      (a writer with an explicit dimension list, a filter that only
+      operates on position) override this so that readers feeding them
+      can skip loading dimensions nothing consumes.  Called before the
+      stage is prepared, so implementations may only consult options.
+
+      \param used  List to which dimension names are appended.
+      \return  true if \c used covers every dimension the stage touches,
+        false if the set can't be determined (the default).
+    */
+    virtual bool usedDims(StringList& used) const
+    { return false; }
+
+    /**
+      Append the bounds outside of which this stage discards every point
+      to \c bounds.  Stages that crop to a known region override this so
+      that readers feeding them can skip data that can't intersect it
+      (see Reader::pushdownBounds()).  Called before the stage is
+      prepared, so implementations may only consult options.
+
+      \param bounds  List to which bounds are appended.
+      \return  true if the stage keeps no point outside the appended
+        bounds, false if no such bounds can be determined (the default).
+    */
+    virtual bool cropBounds(std::vector<Bounds>& bounds) const
+    { return false; }
+
+    /**
+      Append closed value intervals outside of which this stage discards
+      every point to \c ranges.  Stages that filter on simple value
+      ranges override this so readers feeding them can skip data whose
+      statistics prove no point qualifies (see
+      Reader::pushdownRanges()).  Called before the stage is prepared,
+      so implementations may only consult options.
+
+      \param ranges  List to which intervals are appended, at most one
+        per dimension.
+      \return  true if every point the stage keeps falls inside each
+        appended interval, false if no such intervals can be determined
+        (the default).
+    */
+    virtual bool rangeBounds(std::vector<DimInterval>& ranges) const
+    { return false; }
+
+    /**
+      Append the names of the dimensions this stage consults when
+      deciding which points to keep to \c dims.  Stages that only drop
+      points - examining each point independently and never modifying,
+      adding or reordering any - override this so the pipeline manager
+      can run them earlier (see PipelineManager::applyFilterReorder()).
+      Called before the stage is prepared, so implementations may only
+      consult options.
+
+      \param dims  List to which dimension names are appended.
+      \return  true if the stage is a pure selection over the appended
+        dimensions, false otherwise (the default).
+    */
+    virtual bool selectionDims(StringList& dims) const
+    { return false; }
+
+    /**
+      Append the names of the dimensions this stage modifies to \c dims.
+      Stages that rewrite a known set of dimensions - examining each
+      point independently and never dropping, adding or reordering any -
+      override this so the pipeline manager can move selection filters
+      ahead of them (see PipelineManager::applyFilterReorder()).  Called
+      before the stage is prepared, so implementations may only consult
+      options.
+
+      \param dims  List to which dimension names are appended.
+      \return  true if the stage modifies only the appended dimensions,
+        false otherwise (the default).
+    */
+    virtual bool mutatedDims(StringList& dims) const
+    { return false; }
+
+    /**
+      Determine whether run() may be invoked concurrently on different
+      views.  Filters whose view runs share no mutable state - or guard
+      the little they share - override this so that the executor can
+      spread the views of a multi-view pipeline across threads.  The
+      point table must also support concurrent point addition (see
+      BasePointTable::concurrentAddSafe()).
+
+      \return  true if view runs are independent, false otherwise (the
+        default).
+    */
+    virtual bool concurrentViewSafe() const
+    { return false; }
+
     /**
       Set the spatial reference of a stage.
 
@@ -290,6 +417,38 @@ public:
     MetadataNode getMetadata() const
         { return m_metadata; }
 
+    /**
+      Execution metrics for a stage - wall-clock time spent running the
+      stage, the number of points it processed, the process's peak
+      resident set size (bytes) when the stage last finished a run, and
+      the point-table storage the stage's runs caused to be allocated:
+      bytes of growth, the number of growth events, and the table-size
+      high-water mark.  Accumulated by execute() in both standard and
+      stream mode; streaming tables are fixed-size, so their growth
+      numbers stay 0.  When independent stages run concurrently on a
+      shared table, growth attribution is approximate.
+    */
+    struct Metrics
+    {
+        double m_wallSecs = 0.0;
+        point_count_t m_points = 0;
+        uint64_t m_peakRss = 0;
+        uint64_t m_tableGrowth = 0;
+        uint64_t m_growthEvents = 0;
+        uint64_t m_peakTableBytes = 0;
+
+        double pointsPerSecond() const
+            { return m_wallSecs > 0.0 ? m_points / m_wallSecs : 0.0; }
+    };
+
+    /**
+      Get the stage's accumulated execution metrics.
+
+      \return  Stage's metrics.
+    */
+    const Metrics& metrics() const
+        { return m_metrics; }
+
     /**
       Serialize a stage by inserting apporpritate data into the provided
       MetadataNode.  Used to dump a pipeline specification in a portable
@@ -344,6 +503,23 @@ protected:
     */
     point_count_t faceCount() const
         { return m_faceCount; }
+    /**
+      Add a measured run to the stage's execution metrics.
+
+      \param secs    Wall-clock seconds spent in the stage.
+      \param points  Number of points processed during the run.
+    */
+    void addMetrics(double secs, point_count_t points);
+
+    /**
+      Add a run's point-table storage accounting to the stage's metrics.
+
+      \param before  Table bytes allocated when the run started.
+      \param after  Table bytes allocated when the run finished.
+      \param growthEvents  Times the table's storage grew during the run.
+    */
+    void addMemoryMetrics(uintmax_t before, uintmax_t after,
+        uintmax_t growthEvents);
 
 private:
     uint32_t m_verbose;
@@ -360,6 +536,12 @@ private:
     std::string m_userDataJSON;
     point_count_t m_pointCount;
     point_count_t m_faceCount;
+    Metrics m_metrics;
+    // Set while this stage runs under the concurrent scheduler, where
+    // process-global state (the GDAL error handler, the table's SRS
+    // list) must not be reset per-stage.  A stage never runs
+    // concurrently with itself (see execute()), so no locking is needed.
+    bool m_concurrent;
     // This is never used, but we want something to bind to the argument
     // we stick in ProgramArgs so that it shows up in help and an options list.
     std::string m_optionFile;
@@ -430,15 +612,6 @@ private:
     virtual void addDimensions(PointLayoutPtr /*layout*/)
         {}
 
-    /**
-      Execute a single stage.
-
-      \param table  PointTable
-      \param pvSet  Input PointViewSet
-      \return  Output PointViewSet
-    */
-    PointViewSet execute(PointTableRef table, PointViewSet& pvSet);
-
     /**
       Functions called after dimensions have been added.  Implement in
       subclass.
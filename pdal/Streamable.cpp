@@ -32,9 +32,17 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <atomic>
+#include <chrono>
 #include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
 
+#include <pdal/GDALUtils.hpp>
+#include <pdal/PointTable.hpp>
 #include <pdal/Streamable.hpp>
+#include <pdal/Trace.hpp>
 #include <pdal/Reader.hpp>
 
 namespace pdal
@@ -195,12 +203,31 @@ void Streamable::execute(StreamPointTable& table,
     begin++;
     std::copy(begin, stages.end(), std::back_inserter(filters));
 
+    // A double-buffered table lets the reader fill the next chunk on a
+    // background thread while the filter chain consumes the current one.
+    DoubleBufferedPointTable *dbl =
+        dynamic_cast<DoubleBufferedPointTable *>(&table);
+    if (dbl && std::thread::hardware_concurrency() > 1)
+    {
+        executeDoubleBuffered(*dbl, reader, filters, srsMap, count);
+        return;
+    }
+
     // Loop until we're finished.  We handle the number of points up to
     // the capacity of the StreamPointTable that we've been provided.
 
     bool finished = false;
     while (!finished)
     {
+        // A double-buffered table running serially still needs its chunk
+        // buffer zeroed before refill; the producer-side priming that
+        // normally handles it only runs in the double-buffered path.
+        if (dbl)
+        {
+            dbl->primeFill();
+            dbl->flip();
+        }
+
         // Clear the spatial reference when processing starts.
         table.clearSpatialReferences();
         PointId idx = 0;
@@ -214,6 +241,8 @@ void Streamable::execute(StreamPointTable& table,
         if (!pointLimit)
             finished = true;
 
+        auto readStart = std::chrono::steady_clock::now();
+        PDAL_TRACE_BEGIN("stream:read");
         for (PointId idx = 0; idx < pointLimit; idx++)
         {
             point.setPointId(idx);
@@ -221,6 +250,10 @@ void Streamable::execute(StreamPointTable& table,
             if (finished)
                 pointLimit = idx;
         }
+        PDAL_TRACE_END("stream:read");
+        std::chrono::duration<double> readTime =
+            std::chrono::steady_clock::now() - readStart;
+        reader->addMetrics(readTime.count(), pointLimit);
         count -= pointLimit;
 
         reader->stopLogging();
@@ -228,11 +261,50 @@ void Streamable::execute(StreamPointTable& table,
         if (!srs.empty())
             table.setSpatialReference(srs);
 
-        // When we get a false back from a filter, we're filtering out a
-        // point, so add it to the list of skips so that it doesn't get
-        // processed by subsequent filters.
-        for (Streamable *s : filters)
+        PDAL_TRACE_BEGIN("stream:chunk");
+        processChunk(table, filters, srsMap, srs, pointLimit);
+        PDAL_TRACE_END("stream:chunk");
+
+        table.clear(pointLimit);
+    }
+}
+
+
+// Run a chunk of points through the filter chain, pipelined across threads
+// when it pays off.  When we get a false back from a filter, we're filtering
+// out a point, so add it to the list of skips so that it doesn't get
+// processed by subsequent filters.
+//
+// Adjacent fusable stages (see Streamable::fusable()) run as one group
+// making a single pass over the chunk, applying each member back-to-back
+// per point.  A chain of simple per-point filters then traverses the
+// chunk - and pays the skip test and PointRef update - once instead of
+// once per stage.
+void Streamable::processChunk(StreamPointTable& table,
+    std::list<Streamable *>& filters, SrsMap& srsMap, SpatialReference& srs,
+    point_count_t pointLimit)
+{
+    std::vector<FilterGroup> groups;
+    for (Streamable *s : filters)
+    {
+        if (s->fusable() && groups.size() && groups.back().back()->fusable())
+            groups.back().push_back(s);
+        else
+            groups.push_back({s});
+    }
+
+    if (usePipelining(groups, pointLimit))
+    {
+        executePipelined(table, groups, srsMap, srs, pointLimit);
+        return;
+    }
+
+    PointRef point(table, 0);
+    for (FilterGroup& group : groups)
+    {
+        if (group.size() == 1)
         {
+            Streamable *s = group.front();
             auto si = srsMap.find(s);
             if (si == srsMap.end() || si->second != srs)
             {
@@ -240,14 +312,33 @@ void Streamable::execute(StreamPointTable& table,
                 srsMap[s] = srs;
             }
             s->startLogging();
-            for (PointId idx = 0; idx < pointLimit; idx++)
+            auto start = std::chrono::steady_clock::now();
+            point_count_t processed = 0;
+            if (!table.anySkips())
+            {
+                // Nothing in the chunk is skipped, so run without the
+                // per-point test.  Skips set here are this stage's own
+                // and never re-read in this pass.
+                for (PointId idx = 0; idx < pointLimit; idx++)
+                {
+                    point.setPointId(idx);
+                    if (!s->processOne(point))
+                        table.setSkip(idx);
+                }
+                processed = pointLimit;
+            }
+            else for (PointId idx = 0; idx < pointLimit; idx++)
             {
                 if (table.skip(idx))
                     continue;
+                processed++;
                 point.setPointId(idx);
                 if (!s->processOne(point))
                     table.setSkip(idx);
             }
+            std::chrono::duration<double> dur =
+                std::chrono::steady_clock::now() - start;
+            s->addMetrics(dur.count(), processed);
             const SpatialReference& tempSrs = s->getSpatialReference();
             if (!tempSrs.empty())
             {
@@ -255,10 +346,302 @@ void Streamable::execute(StreamPointTable& table,
                 table.setSpatialReference(srs);
             }
             s->stopLogging();
+            continue;
         }
 
-        table.clear(pointLimit);
+        // Fused group.  A fusable stage can't change the spatial
+        // reference mid-chunk, so the members' notifications are
+        // chained before the pass; and its processOne() doesn't log,
+        // so no log leader is pushed.
+        for (Streamable *s : group)
+        {
+            auto si = srsMap.find(s);
+            if (si == srsMap.end() || si->second != srs)
+            {
+                s->spatialReferenceChanged(srs);
+                srsMap[s] = srs;
+            }
+            const SpatialReference& tempSrs = s->getSpatialReference();
+            if (!tempSrs.empty())
+            {
+                srs = tempSrs;
+                table.setSpatialReference(srs);
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        // Per-chunk scratch comes from the table's arena - rewound when
+        // the chunk is consumed - rather than the heap.
+        point_count_t *processed =
+            table.arena().alloc<point_count_t>(group.size());
+        std::fill(processed, processed + group.size(), 0);
+        bool checkSkips = table.anySkips();
+        for (PointId idx = 0; idx < pointLimit; idx++)
+        {
+            if (checkSkips && table.skip(idx))
+                continue;
+            point.setPointId(idx);
+            for (size_t i = 0; i < group.size(); ++i)
+            {
+                processed[i]++;
+                if (!group[i]->processOne(point))
+                {
+                    table.setSkip(idx);
+                    break;
+                }
+            }
+        }
+        std::chrono::duration<double> dur =
+            std::chrono::steady_clock::now() - start;
+        // One timer covers the whole pass; split it evenly rather than
+        // paying for a clock read per stage per point.
+        for (size_t i = 0; i < group.size(); ++i)
+            group[i]->addMetrics(dur.count() / group.size(), processed[i]);
+    }
+}
+
+
+// Double-buffered streaming: the reader fills the table's back buffer on a
+// background thread while the filter chain consumes the front buffer, then
+// the buffers are flipped.  Chunks still reach the filters in read order,
+// and each buffer is only ever touched from one thread at a time, so the
+// stages themselves need no locking.
+void Streamable::executeDoubleBuffered(DoubleBufferedPointTable& table,
+    Streamable *reader, std::list<Streamable *>& filters, SrsMap& srsMap,
+    point_count_t count)
+{
+    SpatialReference srs;
+    SpatialReference readSrs;
+    bool finished = false;
+
+    // Fill the back buffer with up to limit points and report the number
+    // actually read.  Sets finished when the reader runs dry.  The reader's
+    // spatial reference is captured here so that the consumer side never
+    // touches the reader while it's busy on the producer thread.
+    auto readChunk = [&](point_count_t limit, point_count_t& numRead)
+    {
+        table.primeFill();
+        PointRef point(table.fillTable(), 0);
+
+        reader->startLogging();
+        numRead = limit;
+        auto readStart = std::chrono::steady_clock::now();
+        for (PointId idx = 0; idx < limit; idx++)
+        {
+            point.setPointId(idx);
+            if (!reader->processOne(point))
+            {
+                numRead = idx;
+                finished = true;
+                break;
+            }
+        }
+        std::chrono::duration<double> readTime =
+            std::chrono::steady_clock::now() - readStart;
+        reader->addMetrics(readTime.count(), numRead);
+        reader->stopLogging();
+        readSrs = reader->getSpatialReference();
+    };
+
+    // Read the first chunk on this thread.
+    point_count_t pointLimit = (std::min)(count, table.capacity());
+    point_count_t numRead = 0;
+    if (!pointLimit)
+        finished = true;
+    else
+        readChunk(pointLimit, numRead);
+    count -= numRead;
+    table.flip();
+
+    while (true)
+    {
+        point_count_t chunkPoints = numRead;
+        SpatialReference chunkSrs = readSrs;
+
+        // Kick off the read of the next chunk before processing this one.
+        std::thread producer;
+        std::exception_ptr readError;
+        pointLimit = (std::min)(count, table.capacity());
+        if (!finished && pointLimit)
+        {
+            producer = std::thread([&]()
+            {
+                try
+                {
+                    readChunk(pointLimit, numRead);
+                }
+                catch (...)
+                {
+                    readError = std::current_exception();
+                }
+            });
+        }
+        else
+        {
+            finished = true;
+            numRead = 0;
+        }
+
+        table.clearSpatialReferences();
+        srs = chunkSrs;
+        if (!srs.empty())
+            table.setSpatialReference(srs);
+
+        processChunk(table, filters, srsMap, srs, chunkPoints);
+        table.clear(chunkPoints);
+
+        if (producer.joinable())
+            producer.join();
+        if (readError)
+            std::rethrow_exception(readError);
+        count -= numRead;
+        table.flip();
+
+        if (finished && !numRead)
+            break;
+    }
+}
+
+
+bool Streamable::usePipelining(const std::vector<FilterGroup>& groups,
+    point_count_t pointLimit) const
+{
+    // Pipelining pays off only with at least two downstream groups and
+    // enough points per chunk to keep several segments in flight.  A
+    // fused group counts once: its members already share a pass.
+    return groups.size() > 1 &&
+        pointLimit >= 2 * PipelineSegmentSize &&
+        std::thread::hardware_concurrency() > 1;
+}
+
+
+// Run the filter chain software-pipelined: the chunk is cut into fixed-size
+// segments and each group runs on its own thread, processing segment N only
+// once the upstream group has finished it.  Each point still flows through
+// the stages in order and each stage remains single-threaded, so stages need
+// no internal locking.  A fused group applies its members back-to-back per
+// point on its thread, just as in the serial path.
+//
+// Spatial reference changes are chained through the stages before the
+// threads launch.  A stage that alters its SRS *during* this chunk's
+// processing reaches downstream stages one chunk late; no current streamable
+// stage does that (reprojection fixes its SRS in ready()).
+void Streamable::executePipelined(StreamPointTable& table,
+    std::vector<FilterGroup>& groups, SrsMap& srsMap, SpatialReference& srs,
+    point_count_t pointLimit)
+{
+    for (FilterGroup& group : groups)
+        for (Streamable *s : group)
+        {
+            auto si = srsMap.find(s);
+            if (si == srsMap.end() || si->second != srs)
+            {
+                s->spatialReferenceChanged(srs);
+                srsMap[s] = srs;
+            }
+            const SpatialReference& tempSrs = s->getSpatialReference();
+            if (!tempSrs.empty())
+                srs = tempSrs;
+        }
+    if (!srs.empty())
+        table.setSpatialReference(srs);
+
+    size_t segCnt = (pointLimit + PipelineSegmentSize - 1) /
+        PipelineSegmentSize;
+    std::vector<std::atomic<size_t>> doneSegs(groups.size());
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    // The group threads must not reset the process-global GDAL error
+    // handler (see Stage::startLogging()) - point it at our log once for
+    // the whole chunk instead.
+    gdal::ErrorHandler::getGlobalErrorHandler().set(log(), isDebug());
+    for (FilterGroup& group : groups)
+        for (Streamable *s : group)
+            s->m_concurrent = true;
+
+    std::vector<std::thread> threads;
+    size_t pos = 0;
+    for (FilterGroup& group : groups)
+    {
+        FilterGroup *g = &group;
+        threads.emplace_back([&, g, pos]()
+        {
+            // A log leader would stack up for a fused group; fusable
+            // stages don't log from processOne() anyway.
+            if (g->size() == 1)
+                g->front()->startLogging();
+            PointRef point(table, 0);
+            // Busy time only - the wait for upstream segments isn't
+            // chargeable to this group.
+            double busySecs = 0;
+            std::vector<point_count_t> processed(g->size(), 0);
+            try
+            {
+                for (size_t seg = 0; seg < segCnt; ++seg)
+                {
+                    // Wait for the upstream group to finish this segment.
+                    if (pos)
+                        while (doneSegs[pos - 1].load(
+                            std::memory_order_acquire) <= seg)
+                        {
+                            if (failed)
+                                break;
+                            std::this_thread::yield();
+                        }
+                    if (failed)
+                        break;
+
+                    PointId start = seg * PipelineSegmentSize;
+                    PointId end = (std::min)((PointId)pointLimit,
+                        start + PipelineSegmentSize);
+                    auto segStart = std::chrono::steady_clock::now();
+                    // Upstream groups have finished this segment (see
+                    // doneSegs above), so any skip set after this check
+                    // belongs to a later segment or to this group.
+                    bool checkSkips = table.anySkips();
+                    for (PointId idx = start; idx < end; idx++)
+                    {
+                        if (checkSkips && table.skip(idx))
+                            continue;
+                        point.setPointId(idx);
+                        for (size_t i = 0; i < g->size(); ++i)
+                        {
+                            processed[i]++;
+                            if (!(*g)[i]->processOne(point))
+                            {
+                                table.setSkip(idx);
+                                break;
+                            }
+                        }
+                    }
+                    busySecs += std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - segStart).count();
+                    doneSegs[pos].store(seg + 1, std::memory_order_release);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+                failed = true;
+            }
+            for (size_t i = 0; i < g->size(); ++i)
+                (*g)[i]->addMetrics(busySecs / g->size(), processed[i]);
+            if (g->size() == 1)
+                g->front()->stopLogging();
+        });
+        pos++;
     }
+    for (auto& t : threads)
+        t.join();
+    for (FilterGroup& group : groups)
+        for (Streamable *s : group)
+            s->m_concurrent = false;
+    if (error)
+        std::rethrow_exception(error);
 }
 
 } // namespace pdal
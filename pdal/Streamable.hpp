@@ -40,6 +40,7 @@
 namespace pdal
 {
 
+class DoubleBufferedPointTable;
 class StreamableWrapper;
 
 class PDAL_DLL Streamable : public virtual Stage
@@ -83,6 +84,25 @@ protected:
     void execute(StreamPointTable& table, std::list<Streamable *>& stages,
         SrsMap& srsMap);
 
+    // Number of points handed from stage to stage at a time when the
+    // filter chain runs pipelined across threads.
+    static const point_count_t PipelineSegmentSize = 1024;
+
+    // Adjacent fusable filters, run as a unit (see processChunk()).
+    using FilterGroup = std::vector<Streamable *>;
+
+    bool usePipelining(const std::vector<FilterGroup>& groups,
+        point_count_t pointLimit) const;
+    void processChunk(StreamPointTable& table,
+        std::list<Streamable *>& filters, SrsMap& srsMap,
+        SpatialReference& srs, point_count_t pointLimit);
+    void executePipelined(StreamPointTable& table,
+        std::vector<FilterGroup>& groups, SrsMap& srsMap,
+        SpatialReference& srs, point_count_t pointLimit);
+    void executeDoubleBuffered(DoubleBufferedPointTable& table,
+        Streamable *reader, std::list<Streamable *>& filters, SrsMap& srsMap,
+        point_count_t count);
+
     /**
       Process a single point (streaming mode).  Implement in subclass.
 
@@ -99,6 +119,20 @@ protected:
     }
     **/
 
+    /**
+      Whether \ref processOne touches only the point passed to it: it
+      examines no other point in the table, keeps no state that another
+      stage observes, never changes the stage's spatial reference and
+      doesn't log.  Adjacent fusable stages are run back-to-back per
+      point in a single pass over each chunk, saving a traversal of the
+      chunk per stage.
+
+      \return  true if the stage may be fused with its neighbors
+        (the default is false).
+    */
+    virtual bool fusable() const
+    { return false; }
+
     /**
       Notification that the points that will follow in processing are from
       a spatial reference different than the previous spatial reference.
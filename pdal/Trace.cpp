@@ -0,0 +1,143 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/Trace.hpp>
+
+#ifdef PDAL_TRACE
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace pdal
+{
+namespace trace
+{
+
+namespace
+{
+
+// Writes Chrome trace event JSON.  One writer per process, created on
+// first use; the file named by PDAL_TRACE is opened lazily and closed -
+// terminating the event array - at exit.
+class Writer
+{
+public:
+    Writer()
+    {
+        const char *path = std::getenv("PDAL_TRACE");
+        if (!path || !*path)
+            return;
+        m_out.open(path, std::ios::out | std::ios::trunc);
+        if (!m_out)
+            return;
+        m_out << "[\n";
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    ~Writer()
+    {
+        if (m_out.is_open())
+            m_out << "{}\n]\n";
+    }
+
+    bool active() const
+        { return m_out.is_open(); }
+
+    void event(const std::string& name, char phase)
+    {
+        auto now = std::chrono::steady_clock::now();
+        uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+            now - m_start).count();
+        size_t tid =
+            std::hash<std::thread::id>()(std::this_thread::get_id()) & 0xFFFF;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_out << "{\"name\":\"" << name << "\",\"ph\":\"" << phase <<
+            "\",\"ts\":" << us << ",\"pid\":1,\"tid\":" << tid;
+        if (phase == 'i')
+            m_out << ",\"s\":\"t\"";
+        m_out << "},\n";
+    }
+
+private:
+    std::ofstream m_out;
+    std::chrono::steady_clock::time_point m_start;
+    std::mutex m_mutex;
+};
+
+Writer& writer()
+{
+    static Writer w;
+    return w;
+}
+
+} // unnamed namespace
+
+bool enabled()
+{
+    return writer().active();
+}
+
+
+void begin(const std::string& name)
+{
+    Writer& w = writer();
+    if (w.active())
+        w.event(name, 'B');
+}
+
+
+void end(const std::string& name)
+{
+    Writer& w = writer();
+    if (w.active())
+        w.event(name, 'E');
+}
+
+
+void instant(const std::string& name)
+{
+    Writer& w = writer();
+    if (w.active())
+        w.event(name, 'i');
+}
+
+} // namespace trace
+} // namespace pdal
+
+#endif // PDAL_TRACE
@@ -0,0 +1,109 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <pdal/pdal_features.hpp>
+
+// Tracepoints around hot paths - chunk boundaries, stage transitions, index
+// queries, compression calls - for use with external profilers.  The macros
+// compile to nothing unless PDAL is configured with WITH_TRACING; a build
+// with tracing compiled in emits nothing until the PDAL_TRACE environment
+// variable names an output file.  Events are written in the Chrome trace
+// event format, loadable by chrome://tracing and Perfetto.
+//
+//     PDAL_TRACE_SCOPE("name");       // duration event for this scope
+//     PDAL_TRACE_BEGIN("name");       // explicit begin...
+//     PDAL_TRACE_END("name");         // ...and matching end
+//     PDAL_TRACE_INSTANT("name");     // point event
+
+#ifdef PDAL_TRACE
+
+#include <string>
+
+#include <pdal/util/pdal_util_export.hpp>
+
+namespace pdal
+{
+namespace trace
+{
+
+/// Whether the runtime switch (the PDAL_TRACE environment variable) is on.
+PDAL_DLL bool enabled();
+PDAL_DLL void begin(const std::string& name);
+PDAL_DLL void end(const std::string& name);
+PDAL_DLL void instant(const std::string& name);
+
+/// Emits a duration event covering the enclosing scope.
+class PDAL_DLL Scope
+{
+public:
+    Scope(const std::string& name) : m_live(enabled())
+    {
+        if (m_live)
+        {
+            m_name = name;
+            begin(m_name);
+        }
+    }
+    ~Scope()
+    {
+        if (m_live)
+            end(m_name);
+    }
+
+private:
+    bool m_live;
+    std::string m_name;
+};
+
+} // namespace trace
+} // namespace pdal
+
+#define PDAL_TRACE_PASTE2(a, b) a ## b
+#define PDAL_TRACE_PASTE(a, b) PDAL_TRACE_PASTE2(a, b)
+#define PDAL_TRACE_SCOPE(name) \
+    pdal::trace::Scope PDAL_TRACE_PASTE(pdal_trace_scope_, __LINE__)(name)
+#define PDAL_TRACE_BEGIN(name) pdal::trace::begin(name)
+#define PDAL_TRACE_END(name) pdal::trace::end(name)
+#define PDAL_TRACE_INSTANT(name) pdal::trace::instant(name)
+
+#else
+
+#define PDAL_TRACE_SCOPE(name) ((void)0)
+#define PDAL_TRACE_BEGIN(name) ((void)0)
+#define PDAL_TRACE_END(name) ((void)0)
+#define PDAL_TRACE_INSTANT(name) ((void)0)
+
+#endif // PDAL_TRACE
@@ -0,0 +1,182 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <type_traits>
+
+#include <pdal/DimDetail.hpp>
+#include <pdal/PointContainer.hpp>
+#include <pdal/PointLayout.hpp>
+#include <pdal/PointRef.hpp>
+#include <pdal/util/Utils.hpp>
+
+namespace pdal
+{
+
+/// Access to a single dimension as type T with the storage type resolved
+/// once, when a finalized layout is bound, rather than on every access.
+/// getFieldAs() and setField() switch on the dimension's storage type for
+/// each call; a bound TypedDimView dispatches through a function pointer
+/// chosen at bind time, and when the dimension is stored as T the access
+/// reduces to a copy from point memory.  Bind from prepared() or ready(),
+/// after the layout is finalized:
+/// \code
+///     m_x.bind(*table.layout(), Dimension::Id::X);
+///     ...
+///     double x = m_x.get(point);
+/// \endcode
+/// Conversion semantics (including the error on a failed narrowing) match
+/// getFieldAs()/setField().
+template <typename T>
+class TypedDimView
+{
+public:
+    TypedDimView() : m_id(Dimension::Id::Unknown), m_get(nullptr),
+        m_set(nullptr), m_direct(false)
+    {}
+    TypedDimView(const PointLayout& layout, Dimension::Id id) : TypedDimView()
+        { bind(layout, id); }
+
+    /// Resolve the dimension's storage type from a finalized layout.
+    void bind(const PointLayout& layout, Dimension::Id id)
+    {
+        m_id = id;
+        m_get = nullptr;
+        m_set = nullptr;
+        m_direct = false;
+        if (!layout.hasDim(id))
+            return;
+        switch (layout.dimDetail(id)->type())
+        {
+        case Dimension::Type::Signed8:
+            select<int8_t>();
+            break;
+        case Dimension::Type::Signed16:
+            select<int16_t>();
+            break;
+        case Dimension::Type::Signed32:
+            select<int32_t>();
+            break;
+        case Dimension::Type::Signed64:
+            select<int64_t>();
+            break;
+        case Dimension::Type::Unsigned8:
+            select<uint8_t>();
+            break;
+        case Dimension::Type::Unsigned16:
+            select<uint16_t>();
+            break;
+        case Dimension::Type::Unsigned32:
+            select<uint32_t>();
+            break;
+        case Dimension::Type::Unsigned64:
+            select<uint64_t>();
+            break;
+        case Dimension::Type::Float:
+            select<float>();
+            break;
+        case Dimension::Type::Double:
+            select<double>();
+            break;
+        case Dimension::Type::None:
+        default:
+            break;
+        }
+    }
+
+    /// Whether the bound dimension exists in the layout.
+    bool valid() const
+        { return m_get != nullptr; }
+    /// Whether the dimension is stored as T, making access a straight
+    /// copy with no conversion.
+    bool direct() const
+        { return m_direct; }
+    Dimension::Id id() const
+        { return m_id; }
+
+    T get(const PointRef& point) const
+        { return m_get(*point.m_container, point.m_idx, m_id); }
+    void set(PointRef& point, T val) const
+        { m_set(*point.m_container, point.m_idx, m_id, val); }
+    T get(const PointContainer& container, PointId idx) const
+        { return m_get(container, idx, m_id); }
+    void set(PointContainer& container, PointId idx, T val) const
+        { m_set(container, idx, m_id, val); }
+
+private:
+    typedef T (*GetFn)(const PointContainer&, PointId, Dimension::Id);
+    typedef void (*SetFn)(PointContainer&, PointId, Dimension::Id, T);
+
+    template <typename S>
+    void select()
+    {
+        m_direct = std::is_same<S, T>::value;
+        m_get = &TypedDimView::template getTyped<S>;
+        m_set = &TypedDimView::template setTyped<S>;
+    }
+
+    template <typename S>
+    static T getTyped(const PointContainer& container, PointId idx,
+        Dimension::Id dim)
+    {
+        S s;
+        container.getFieldInternal(dim, idx, &s);
+        T val;
+        if (!Utils::numericCast(s, val))
+            throw pdal_error("Unable to fetch data and convert as "
+                "requested: " + Dimension::name(dim) + " -> " +
+                Utils::typeidName<T>());
+        return val;
+    }
+
+    template <typename S>
+    static void setTyped(PointContainer& container, PointId idx,
+        Dimension::Id dim, T val)
+    {
+        S s;
+        if (!Utils::numericCast(val, s))
+            throw pdal_error("Unable to set data and convert as "
+                "requested: " + Utils::typeidName<T>() + " -> " +
+                Dimension::name(dim));
+        container.setFieldInternal(dim, idx, &s);
+    }
+
+    Dimension::Id m_id;
+    GetFn m_get;
+    SetFn m_set;
+    bool m_direct;
+};
+
+} // namespace pdal
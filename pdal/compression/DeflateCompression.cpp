@@ -34,6 +34,8 @@
 
 #include "DeflateCompression.hpp"
 
+#include <pdal/Trace.hpp>
+
 #include <zlib.h>
 
 namespace pdal
@@ -136,6 +138,7 @@ DeflateCompressor::~DeflateCompressor()
 
 void DeflateCompressor::compress(const char *buf, size_t bufsize)
 {
+    PDAL_TRACE_SCOPE("compress:deflate");
     m_impl->compress(buf, bufsize);
 }
 
@@ -241,6 +244,7 @@ DeflateDecompressor::~DeflateDecompressor()
 
 void DeflateDecompressor::decompress(const char *buf, size_t bufsize)
 {
+    PDAL_TRACE_SCOPE("decompress:deflate");
     m_impl->decompress(buf, bufsize);
 }
 
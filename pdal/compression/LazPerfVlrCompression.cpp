@@ -54,6 +54,15 @@
 #pragma pop_macro("max")
 #pragma pop_macro("min")
 
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <pdal/util/Charbuf.hpp>
+#include <pdal/util/IStream.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
 #include "LazPerfVlrCompression.hpp"
 
 namespace pdal
@@ -80,10 +89,13 @@ public:
     LazPerfVlrCompressorImpl(std::ostream& stream, const Schema& schema,
             uint32_t chunksize) :
         m_stream(stream), m_outputStream(stream), m_schema(schema),
-        m_chunksize(chunksize), m_chunkPointsWritten(0), m_chunkInfoPos(0),
-        m_chunkOffset(0)
+        m_chunksize(chunksize), m_chunkPointsWritten(0),
+        m_chunkInfoWritten(false), m_chunkInfoPos(0), m_chunkOffset(0)
     {}
 
+    uint32_t chunkSize() const
+        { return m_chunksize; }
+
     ~LazPerfVlrCompressorImpl()
     {
         if (m_encoder)
@@ -95,15 +107,10 @@ public:
     void compress(const char *inbuf)
     {
         // First time through.
+        if (!m_chunkInfoWritten)
+            writeChunkInfo();
         if (!m_encoder || !m_compressor)
-        {
-            // Get the position
-            m_chunkInfoPos = m_stream.tellp();
-            // Seek over the chunk info offset value
-            m_stream.seekp(sizeof(uint64_t), std::ios::cur);
-            m_chunkOffset = m_stream.tellp();
             resetCompressor();
-        }
         else if (m_chunkPointsWritten == m_chunksize)
         {
             resetCompressor();
@@ -113,13 +120,89 @@ public:
         m_chunkPointsWritten++;
     }
 
+    void compress(const char *inbuf, point_count_t count)
+    {
+        const size_t pointLen = (size_t)m_schema.size_in_bytes();
+
+        if (!m_chunkInfoWritten)
+            writeChunkInfo();
+
+        // Finish any chunk in progress point-by-point so that all chunks
+        // but the last hold exactly m_chunksize points.
+        while (count && m_encoder && m_chunkPointsWritten < m_chunksize)
+        {
+            compress(inbuf);
+            inbuf += pointLen;
+            count--;
+        }
+        if (m_encoder && m_chunkPointsWritten == m_chunksize)
+        {
+            m_encoder->done();
+            m_encoder.reset();
+            m_compressor.reset();
+            newChunk();
+        }
+
+        // Chunks are independent - the encoder is reset at each chunk
+        // boundary - so full chunks can be encoded into memory buffers
+        // concurrently and the results appended to the stream in order.
+        size_t fullChunks = count / m_chunksize;
+        if (fullChunks > 1 && std::thread::hardware_concurrency() > 1)
+        {
+            std::vector<std::vector<char>> chunkBufs(fullChunks);
+            ThreadPool pool((std::min)(
+                (size_t)std::thread::hardware_concurrency(), fullChunks),
+                fullChunks);
+            for (size_t i = 0; i < fullChunks; ++i)
+            {
+                const char *chunkIn = inbuf + i * m_chunksize * pointLen;
+                pool.add([this, chunkIn, &chunkBufs, i]()
+                    { compressChunk(chunkIn, m_chunksize, chunkBufs[i]); });
+            }
+            pool.join();
+            if (pool.errors().size())
+                throw pdal_error(pool.errors().front());
+            for (std::vector<char>& buf : chunkBufs)
+            {
+                m_stream.write(buf.data(), buf.size());
+                newChunk();
+            }
+            inbuf += fullChunks * m_chunksize * pointLen;
+            count -= fullChunks * m_chunksize;
+        }
+
+        // Remaining points (a trailing partial chunk, or everything when
+        // only one thread or chunk is available) use the sequential path.
+        while (count--)
+        {
+            compress(inbuf);
+            inbuf += pointLen;
+        }
+    }
+
+    // Pick up compression behind chunks that are already in the stream.
+    // The chunk table offset slot stays where the original writer put it
+    // and the retained chunks' table entries are replayed, so done() can
+    // finalize the stream exactly as if we had written those chunks.
+    void resume(std::streampos chunkInfoPos, std::vector<uint32_t> chunkTable)
+    {
+        m_chunkInfoPos = chunkInfoPos;
+        m_chunkInfoWritten = true;
+        m_chunkTable = std::move(chunkTable);
+        m_chunkOffset = m_stream.tellp();
+    }
+
     void done()
     {
-        // Close and clear the point encoder.
-        m_encoder->done();
-        m_encoder.reset();
+        // Close and clear the point encoder.  There's no open chunk if the
+        // last bulk write ended exactly on a chunk boundary.
+        if (m_encoder)
+        {
+            m_encoder->done();
+            m_encoder.reset();
 
-        newChunk();
+            newChunk();
+        }
 
         // Save our current position.  Go to the location where we need
         // to write the chunk table offset at the beginning of the point data.
@@ -152,6 +235,16 @@ public:
     }
 
 private:
+    void writeChunkInfo()
+    {
+        // Get the position
+        m_chunkInfoPos = m_stream.tellp();
+        // Seek over the chunk info offset value
+        m_stream.seekp(sizeof(uint64_t), std::ios::cur);
+        m_chunkOffset = m_stream.tellp();
+        m_chunkInfoWritten = true;
+    }
+
     void resetCompressor()
     {
         if (m_encoder)
@@ -160,6 +253,30 @@ private:
         m_compressor = laszip::factory::build_compressor(*m_encoder, m_schema);
     }
 
+    // Encode a full chunk of points from \c inbuf into \c outbuf.  Uses
+    // its own encoder over a memory stream, so chunks can be encoded on
+    // several threads at once.
+    void compressChunk(const char *inbuf, uint32_t numPts,
+        std::vector<char>& outbuf)
+    {
+        const size_t pointLen = (size_t)m_schema.size_in_bytes();
+
+        std::ostringstream oss(std::ios::out | std::ios::binary);
+        OutputStream outputStream(oss);
+        Encoder encoder(outputStream);
+        Compressor::ptr compressor =
+            laszip::factory::build_compressor(encoder, m_schema);
+        for (uint32_t i = 0; i < numPts; ++i)
+        {
+            compressor->compress(inbuf);
+            inbuf += pointLen;
+        }
+        encoder.done();
+
+        const std::string& s = oss.str();
+        outbuf.assign(s.begin(), s.end());
+    }
+
     void newChunk()
     {
         std::streampos offset = m_stream.tellp();
@@ -175,6 +292,7 @@ private:
     Schema m_schema;
     uint32_t m_chunksize;
     uint32_t m_chunkPointsWritten;
+    bool m_chunkInfoWritten;
     std::streampos m_chunkInfoPos;
     std::streampos m_chunkOffset;
     std::vector<uint32_t> m_chunkTable;
@@ -197,6 +315,25 @@ void LazPerfVlrCompressor::compress(const char *inbuf)
 }
 
 
+void LazPerfVlrCompressor::compress(const char *inbuf, point_count_t count)
+{
+    m_impl->compress(inbuf, count);
+}
+
+
+uint32_t LazPerfVlrCompressor::chunkSize() const
+{
+    return m_impl->chunkSize();
+}
+
+
+void LazPerfVlrCompressor::resume(std::streampos chunkInfoPos,
+    std::vector<uint32_t> chunkTable)
+{
+    m_impl->resume(chunkInfoPos, std::move(chunkTable));
+}
+
+
 void LazPerfVlrCompressor::done()
 {
     m_impl->done();
@@ -209,11 +346,12 @@ public:
     LazPerfVlrDecompressorImpl(std::istream& stream, const char *vlrData,
         std::streamoff pointOffset) :
         m_stream(stream), m_inputStream(stream), m_chunksize(0),
-        m_chunkPointsRead(0)
+        m_chunkPointsRead(0), m_pointOffset(pointOffset)
     {
         laszip::io::laz_vlr zipvlr(vlrData);
         m_chunksize = zipvlr.chunk_size;
         m_schema = laszip::io::laz_vlr::to_schema(zipvlr);
+        readChunkTable();
         m_stream.seekg(pointOffset + sizeof(int64_t));
     }
 
@@ -231,6 +369,72 @@ public:
         m_chunkPointsRead++;
     }
 
+    bool chunked() const
+        { return m_chunkOffsets.size() > 1; }
+
+    uint32_t chunkSize() const
+        { return m_chunksize; }
+
+    size_t chunkCount() const
+        { return chunked() ? m_chunkOffsets.size() - 1 : 0; }
+
+    std::streamoff chunkOffset(size_t chunk) const
+        { return m_chunkOffsets[chunk]; }
+
+    // Decompress the first \c count points of a chunk into \c outbuf.
+    // Safe to call from multiple threads concurrently -- the compressed
+    // bytes are pulled from the stream under lock and decoded from memory,
+    // without touching the sequential decompressor state.
+    void decompressChunk(size_t chunk, point_count_t count, char *outbuf)
+    {
+        std::vector<char> inbuf(
+            (size_t)(m_chunkOffsets[chunk + 1] - m_chunkOffsets[chunk]));
+        {
+            std::lock_guard<std::mutex> lock(m_streamMutex);
+            std::streampos restore = m_stream.tellg();
+            m_stream.clear();
+            m_stream.seekg(m_chunkOffsets[chunk]);
+            m_stream.read(inbuf.data(), inbuf.size());
+            m_stream.clear();
+            m_stream.seekg(restore);
+        }
+
+        Charbuf charbuf(inbuf);
+        std::istream in(&charbuf);
+        InputStream inputStream(in);
+        Decoder decoder(inputStream);
+        Decompressor::ptr decompressor =
+            laszip::factory::build_decompressor(decoder, m_schema);
+        size_t len = pointSize();
+        for (point_count_t i = 0; i < count; ++i)
+        {
+            decompressor->decompress(outbuf);
+            outbuf += len;
+        }
+    }
+
+    // Position sequential decompression at the given point.  With a chunk
+    // table available only the points preceding \c index within its chunk
+    // are decoded and discarded; otherwise everything before it is.
+    void seek(point_count_t index)
+    {
+        m_stream.clear();
+        if (chunked())
+        {
+            size_t chunk = index / m_chunksize;
+            m_stream.seekg(m_chunkOffsets[chunk]);
+            index %= m_chunksize;
+        }
+        else
+            m_stream.seekg(m_pointOffset + sizeof(int64_t));
+        resetDecompressor();
+        m_chunkPointsRead = 0;
+
+        std::vector<char> scratch(pointSize());
+        while (index--)
+            decompress(scratch.data());
+    }
+
 private:
     void resetDecompressor()
     {
@@ -239,6 +443,59 @@ private:
             laszip::factory::build_decompressor(*m_decoder, m_schema);
     }
 
+    // Read the chunk table written at the end of the point data (see the
+    // compressor above for the format).  On any failure the offset list is
+    // left empty and only sequential decompression is available.
+    void readChunkTable()
+    {
+        m_chunkOffsets.clear();
+
+        // A chunk size of 0 or ~0 indicates unchunked/variable data.
+        if (m_chunksize == 0 ||
+            m_chunksize == (std::numeric_limits<uint32_t>::max)())
+            return;
+
+        try
+        {
+            m_stream.clear();
+            m_stream.seekg(m_pointOffset);
+            ILeStream in(&m_stream);
+            uint64_t chunkTablePos;
+            in >> chunkTablePos;
+
+            m_stream.seekg((std::streamoff)chunkTablePos);
+            uint32_t version;
+            uint32_t numChunks;
+            in >> version;
+            in >> numChunks;
+            if (version != 0 || !m_stream.good())
+                return;
+
+            // Chunk table entries are delta-encoded chunk byte sizes.
+            InputStream inputStream(m_stream);
+            Decoder decoder(inputStream);
+            laszip::decompressors::integer decomp(32, 2);
+            decomp.init();
+
+            std::streamoff offset =
+                m_pointOffset + (std::streamoff)sizeof(uint64_t);
+            std::vector<std::streamoff> offsets;
+            offsets.push_back(offset);
+            uint32_t predictor = 0;
+            for (uint32_t i = 0; i < numChunks; ++i)
+            {
+                predictor = decomp.decompress(decoder, predictor, 1);
+                offset += le32toh(predictor);
+                offsets.push_back(offset);
+            }
+            if (m_stream.good())
+                m_chunkOffsets = std::move(offsets);
+        }
+        catch (...)
+        {}
+        m_stream.clear();
+    }
+
     typedef laszip::io::__ifstream_wrapper<std::istream> InputStream;
     typedef laszip::decoders::arithmetic<InputStream> Decoder;
     typedef laszip::formats::dynamic_decompressor Decompressor;
@@ -251,6 +508,11 @@ private:
     Schema m_schema;
     uint32_t m_chunksize;
     uint32_t m_chunkPointsRead;
+    std::streamoff m_pointOffset;
+    // Byte offset of the start of each chunk, plus one entry for the end
+    // of the last chunk.
+    std::vector<std::streamoff> m_chunkOffsets;
+    std::mutex m_streamMutex;
 };
 
 LazPerfVlrDecompressor::LazPerfVlrDecompressor(std::istream& stream,
@@ -274,5 +536,105 @@ void LazPerfVlrDecompressor::decompress(char *outbuf)
     m_impl->decompress(outbuf);
 }
 
+
+bool LazPerfVlrDecompressor::chunked() const
+{
+    return m_impl->chunked();
+}
+
+
+uint32_t LazPerfVlrDecompressor::chunkSize() const
+{
+    return m_impl->chunkSize();
+}
+
+
+size_t LazPerfVlrDecompressor::chunkCount() const
+{
+    return m_impl->chunkCount();
+}
+
+
+std::streamoff LazPerfVlrDecompressor::chunkOffset(size_t chunk) const
+{
+    return m_impl->chunkOffset(chunk);
+}
+
+
+void LazPerfVlrDecompressor::decompressChunk(size_t chunk,
+    point_count_t count, char *outbuf)
+{
+    m_impl->decompressChunk(chunk, count, outbuf);
+}
+
+
+void LazPerfVlrDecompressor::seek(point_count_t index)
+{
+    m_impl->seek(index);
+}
+
+
+class LazPerfChunkDecompressorImpl
+{
+public:
+    LazPerfChunkDecompressorImpl(const char *vlrData)
+    {
+        laszip::io::laz_vlr zipvlr(vlrData);
+        m_schema = laszip::io::laz_vlr::to_schema(zipvlr);
+    }
+
+    size_t pointSize() const
+        { return (size_t)m_schema.size_in_bytes(); }
+
+    // The chunk bytes are decoded entirely from memory with a decoder
+    // built per call, so there's no shared state to protect.
+    void decompress(std::vector<char>& inbuf, point_count_t count,
+        char *outbuf) const
+    {
+        Charbuf charbuf(inbuf);
+        std::istream in(&charbuf);
+        InputStream inputStream(in);
+        Decoder decoder(inputStream);
+        Decompressor::ptr decompressor =
+            laszip::factory::build_decompressor(decoder, m_schema);
+        size_t len = pointSize();
+        for (point_count_t i = 0; i < count; ++i)
+        {
+            decompressor->decompress(outbuf);
+            outbuf += len;
+        }
+    }
+
+private:
+    typedef laszip::io::__ifstream_wrapper<std::istream> InputStream;
+    typedef laszip::decoders::arithmetic<InputStream> Decoder;
+    typedef laszip::formats::dynamic_decompressor Decompressor;
+    typedef laszip::factory::record_schema Schema;
+
+    Schema m_schema;
+};
+
+
+LazPerfChunkDecompressor::LazPerfChunkDecompressor(const char *vlrData) :
+    m_impl(new LazPerfChunkDecompressorImpl(vlrData))
+{}
+
+
+LazPerfChunkDecompressor::~LazPerfChunkDecompressor()
+{}
+
+
+size_t LazPerfChunkDecompressor::pointSize() const
+{
+    return m_impl->pointSize();
+}
+
+
+void LazPerfChunkDecompressor::decompress(std::vector<char>& inbuf,
+    point_count_t count, char *outbuf) const
+{
+    m_impl->decompress(inbuf, count, outbuf);
+}
+
 } // namespace pdal
 
@@ -34,6 +34,7 @@
 #pragma once
 
 #include <memory>
+#include <pdal/pdal_types.hpp>
 #include <pdal/util/OStream.hpp>
 
 namespace laszip
@@ -68,6 +69,21 @@ public:
     PDAL_DLL ~LazPerfVlrCompressor();
 
     PDAL_DLL void compress(const char *inbuf);
+    /// Compress \c count consecutive points from \c inbuf.  When the
+    /// buffer spans more than one full chunk, the chunks are compressed
+    /// in parallel and written to the stream in order.
+    PDAL_DLL void compress(const char *inbuf, point_count_t count);
+    /// Number of points per chunk.
+    PDAL_DLL uint32_t chunkSize() const;
+    /// Continue compression onto a stream that already holds finished
+    /// chunks.  \c chunkInfoPos is the position of the chunk table offset
+    /// slot at the start of the point data, \c chunkTable holds the byte
+    /// sizes of the chunks to keep, and the stream write position must be
+    /// at the byte where the next chunk begins.  done() overwrites the old
+    /// chunk table and patches the offset slot as usual, so the existing
+    /// chunks are never read or re-encoded.
+    PDAL_DLL void resume(std::streampos chunkInfoPos,
+        std::vector<uint32_t> chunkTable);
     PDAL_DLL void done();
 
 private:
@@ -87,9 +103,56 @@ public:
     PDAL_DLL size_t pointSize() const;
     PDAL_DLL void decompress(char *outbuf);
 
+    /// Whether the point data is chunked and the chunk table was read,
+    /// making chunk-parallel decompression available.
+    PDAL_DLL bool chunked() const;
+    /// Number of points per chunk (the last chunk may hold fewer).
+    PDAL_DLL uint32_t chunkSize() const;
+    /// Number of chunks in the file.
+    PDAL_DLL size_t chunkCount() const;
+    /// Byte offset of the start of chunk \c chunk.  An index of
+    /// chunkCount() gives the end of the last chunk.
+    PDAL_DLL std::streamoff chunkOffset(size_t chunk) const;
+    /// Decompress the first \c count points of chunk \c chunk into
+    /// \c outbuf.  May be called concurrently from multiple threads and
+    /// doesn't disturb sequential decompression state.
+    PDAL_DLL void decompressChunk(size_t chunk, point_count_t count,
+        char *outbuf);
+    /// Position sequential decompression at point \c index.  When the
+    /// data is chunked, seeks directly to the containing chunk and
+    /// decodes only the points preceding \c index within it; otherwise
+    /// decodes from the beginning of the data.
+    PDAL_DLL void seek(point_count_t index);
+
 private:
     std::unique_ptr<LazPerfVlrDecompressorImpl> m_impl;
 };
 
+
+class LazPerfChunkDecompressorImpl;
+
+// Decodes standalone LAZ chunks held in memory.  Since each chunk begins
+// with fresh encoder state, decoding needs no stream position or carried
+// context -- callers that fetch chunks themselves (e.g. over HTTP ranges)
+// can decode them concurrently with a single instance of this class.
+class LazPerfChunkDecompressor
+{
+public:
+    /// Construct from the payload of the laszip VLR, which provides the
+    /// record schema.
+    PDAL_DLL LazPerfChunkDecompressor(const char *vlrData);
+    PDAL_DLL ~LazPerfChunkDecompressor();
+
+    /// Size in bytes of an uncompressed point record.
+    PDAL_DLL size_t pointSize() const;
+    /// Decode \c count points from the compressed chunk in \c inbuf into
+    /// \c outbuf.  May be called concurrently from multiple threads.
+    PDAL_DLL void decompress(std::vector<char>& inbuf, point_count_t count,
+        char *outbuf) const;
+
+private:
+    std::unique_ptr<LazPerfChunkDecompressorImpl> m_impl;
+};
+
 } // namespace pdal
 
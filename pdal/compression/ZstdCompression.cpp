@@ -47,10 +47,31 @@ public:
     char m_tmpbuf[CHUNKSIZE];
     BlockCb m_cb;
 
-    ZstdCompressorImpl(BlockCb cb, int compressionLevel) : m_cb(cb)
+    ZstdCompressorImpl(BlockCb cb, int compressionLevel, int numWorkers,
+        int windowLog) : m_cb(cb)
     {
         m_strm = ZSTD_createCStream();
+#if ZSTD_VERSION_NUMBER >= 10400
+        ZSTD_CCtx_setParameter(m_strm, ZSTD_c_compressionLevel,
+            compressionLevel);
+        // Setting the worker count fails harmlessly - leaving the
+        // context single-threaded - when libzstd was built without
+        // multithreading support.
+        if (numWorkers > 0)
+            ZSTD_CCtx_setParameter(m_strm, ZSTD_c_nbWorkers, numWorkers);
+        if (windowLog > 0)
+        {
+            ZSTD_CCtx_setParameter(m_strm,
+                ZSTD_c_enableLongDistanceMatching, 1);
+            ZSTD_CCtx_setParameter(m_strm, ZSTD_c_windowLog, windowLog);
+        }
+#else
+        // The advanced parameter API arrived in zstd 1.4 - older
+        // libraries compress single-threaded at the requested level.
+        (void)numWorkers;
+        (void)windowLog;
         ZSTD_initCStream(m_strm, compressionLevel);
+#endif
     }
 
     ~ZstdCompressorImpl()
@@ -67,7 +88,12 @@ public:
         {
             ZSTD_outBuffer outBuf
             { reinterpret_cast<void *>(m_tmpbuf), CHUNKSIZE, 0 };
+#if ZSTD_VERSION_NUMBER >= 10400
+            ret = ZSTD_compressStream2(m_strm, &outBuf, &m_inBuf,
+                ZSTD_e_continue);
+#else
             ret = ZSTD_compressStream(m_strm, &outBuf, &m_inBuf);
+#endif
             if (ZSTD_isError(ret))
                 break;
             if (outBuf.pos)
@@ -78,11 +104,19 @@ public:
     void done()
     {
         size_t ret;
+#if ZSTD_VERSION_NUMBER >= 10400
+        m_inBuf = { nullptr, 0, 0 };
+#endif
         do
         {
             ZSTD_outBuffer outBuf
                 { reinterpret_cast<void *>(m_tmpbuf), CHUNKSIZE, 0 };
+#if ZSTD_VERSION_NUMBER >= 10400
+            ret = ZSTD_compressStream2(m_strm, &outBuf, &m_inBuf,
+                ZSTD_e_end);
+#else
             ret = ZSTD_endStream(m_strm, &outBuf);
+#endif
             if (ZSTD_isError(ret))
                 break;
             if (outBuf.pos)
@@ -92,12 +126,19 @@ public:
 };
 
 ZstdCompressor::ZstdCompressor(BlockCb cb) :
-    m_impl(new ZstdCompressorImpl(cb, 15))
+    m_impl(new ZstdCompressorImpl(cb, 15, 0, 0))
 {}
 
 
 ZstdCompressor::ZstdCompressor(BlockCb cb, int compressionLevel) :
-    m_impl(new ZstdCompressorImpl(cb, compressionLevel))
+    m_impl(new ZstdCompressorImpl(cb, compressionLevel, 0, 0))
+{}
+
+
+ZstdCompressor::ZstdCompressor(BlockCb cb, int compressionLevel,
+    int numWorkers, int windowLog) :
+    m_impl(new ZstdCompressorImpl(cb, compressionLevel, numWorkers,
+        windowLog))
 {}
 
 
@@ -120,10 +161,17 @@ void ZstdCompressor::done()
 class ZstdDecompressorImpl
 {
 public:
-    ZstdDecompressorImpl(BlockCb cb) : m_cb(cb)
+    ZstdDecompressorImpl(BlockCb cb, int windowLogMax) : m_cb(cb)
     {
         m_strm = ZSTD_createDStream();
         ZSTD_initDStream(m_strm);
+#if ZSTD_VERSION_NUMBER >= 10400
+        if (windowLogMax > 0)
+            ZSTD_DCtx_setParameter(m_strm, ZSTD_d_windowLogMax,
+                windowLogMax);
+#else
+        (void)windowLogMax;
+#endif
     }
 
     ~ZstdDecompressorImpl()
@@ -159,7 +207,12 @@ private:
 };
 
 ZstdDecompressor::ZstdDecompressor(BlockCb cb) :
-    m_impl(new ZstdDecompressorImpl(cb))
+    m_impl(new ZstdDecompressorImpl(cb, 0))
+{}
+
+
+ZstdDecompressor::ZstdDecompressor(BlockCb cb, int windowLogMax) :
+    m_impl(new ZstdDecompressorImpl(cb, windowLogMax))
 {}
 
 
@@ -45,6 +45,21 @@ class ZstdCompressor : public Compressor
 public:
     PDAL_DLL ZstdCompressor(BlockCb cb);
     PDAL_DLL ZstdCompressor(BlockCb cb, int compressionLevel);
+    /**
+      Create a compressor using zstd's advanced parameters.
+
+      \param cb  Callback for compressed data blocks.
+      \param compressionLevel  Zstd compression level.
+      \param numWorkers  Worker threads for multithreaded compression.
+        0 compresses in the calling thread.  Silently single-threaded
+        when libzstd was built without multithreading or predates the
+        advanced API.
+      \param windowLog  Log2 of the match window.  A nonzero value
+        enables long-distance matching with a window of that size; 0
+        keeps the level's default window.
+    */
+    PDAL_DLL ZstdCompressor(BlockCb cb, int compressionLevel,
+        int numWorkers, int windowLog = 0);
     PDAL_DLL ~ZstdCompressor();
 
     PDAL_DLL void compress(const char *buf, size_t bufsize);
@@ -60,6 +75,15 @@ class ZstdDecompressor : public Decompressor
 {
 public:
     PDAL_DLL ZstdDecompressor(BlockCb cb);
+    /**
+      Create a decompressor that accepts frames compressed with a large
+      long-distance-matching window.
+
+      \param cb  Callback for decompressed data blocks.
+      \param windowLogMax  Log2 of the largest window to accept.  0
+        keeps zstd's default limit.
+    */
+    PDAL_DLL ZstdDecompressor(BlockCb cb, int windowLogMax);
     PDAL_DLL ~ZstdDecompressor();
 
     PDAL_DLL void decompress(const char *buf, size_t bufsize);
@@ -124,6 +124,29 @@ struct XForm
     double toScaled(double val) const
         { return (val - m_offset.m_val) / m_scale.m_val; }
 
+    double fromScaled(double val) const
+        { return val * m_scale.m_val + m_offset.m_val; }
+
+    /// Convert a batch of scaled int32 values to unscaled doubles.
+    /// Plain indexed loops over contiguous arrays so that optimizers can
+    /// vectorize the scale/offset arithmetic.
+    void fromScaled(const int32_t *src, double *dst, size_t count) const
+    {
+        const double scale = m_scale.m_val;
+        const double offset = m_offset.m_val;
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = src[i] * scale + offset;
+    }
+
+    /// Convert a batch of unscaled doubles to scaled values.
+    void toScaled(const double *src, double *dst, size_t count) const
+    {
+        const double scale = m_scale.m_val;
+        const double offset = m_offset.m_val;
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = (src[i] - offset) / scale;
+    }
+
     bool nonstandard() const
     {
         return m_scale.m_auto || m_offset.m_auto ||
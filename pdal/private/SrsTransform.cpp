@@ -109,4 +109,17 @@ bool SrsTransform::transform(std::vector<double>& x, std::vector<double>& y,
     return (err == OGRERR_NONE);
 }
 
+
+bool SrsTransform::transform(std::size_t count, double *x, double *y,
+    double *z, int *success)
+{
+    if (!m_transform)
+        return false;
+#if GDAL_VERSION_MAJOR >= 3
+    return m_transform->Transform((int)count, x, y, z, success);
+#else
+    return m_transform->TransformEx((int)count, x, y, z, success);
+#endif
+}
+
 } // namespace pdal
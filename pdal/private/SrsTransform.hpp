@@ -69,6 +69,18 @@ public:
     bool transform(std::vector<double>& x, std::vector<double>& y,
         std::vector<double>& z);
 
+    /// Transform a set of points in place with a single underlying call,
+    /// reporting success point-by-point.  Points that fail to transform
+    /// are left with unspecified coordinates.
+    /// \param count  Number of points
+    /// \param x  X coordinates
+    /// \param y  Y coordinates
+    /// \param z  Z coordinates
+    /// \param success  Per-point success flags (nonzero on success)
+    /// \return  True if every point transformed successfully
+    bool transform(std::size_t count, double *x, double *y, double *z,
+        int *success);
+
 private:
     std::unique_ptr<OGRCoordinateTransformation> m_transform;
 };
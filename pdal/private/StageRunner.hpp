@@ -45,15 +45,22 @@ class StageRunner
 {
 public:
     StageRunner(Stage *s, PointViewPtr view) :
-        m_stage(s), m_view(view)
+        m_stage(s), m_view(std::move(view))
     {}
 
-    // For now this is all synchronous
+    // May be called from a worker thread when the stage declares its
+    // view runs independent (see Stage::concurrentViewSafe()).
     void run()
         { m_viewSet = m_stage->run(m_view); }
 
+    // The view this runner was created with.
+    PointViewPtr view() const
+        { return m_view; }
+
+    // The result is surrendered to the caller - wait() can be called
+    // only once.
     PointViewSet wait()
-        { return m_viewSet; }
+        { return std::move(m_viewSet); }
 
 private:
     Stage *m_stage;
@@ -0,0 +1,162 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pdal
+{
+
+/**
+  Bump allocator for short-lived scratch memory.
+
+  Allocations are satisfied by advancing an offset in a chain of blocks;
+  reset() rewinds the offset and keeps the blocks, so a steady-state
+  consumer - such as a streaming stage allocating per-chunk temporaries -
+  touches the heap only while the arena grows to its working size.
+  Allocations are never freed individually and destructors are not run,
+  so only trivially destructible data should be placed in an arena.
+
+  An arena is not thread-safe.
+*/
+class Arena
+{
+public:
+    /**
+      Construct an arena.
+
+      \param blockSize  Size of each backing block.  Requests larger than
+        this get a dedicated block.
+    */
+    Arena(size_t blockSize = 65536) : m_blockSize(blockSize), m_block(0),
+        m_offset(0)
+    {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+      Allocate raw memory.
+
+      \param bytes  Number of bytes to allocate.
+      \param align  Alignment of the returned pointer.
+      \return  Pointer to uninitialized memory, valid until reset().
+    */
+    void *alloc(size_t bytes, size_t align = alignof(std::max_align_t))
+    {
+        while (m_block < m_blocks.size())
+        {
+            size_t offset = (m_offset + align - 1) & ~(align - 1);
+            if (offset + bytes <= m_blocks[m_block].size)
+            {
+                m_offset = offset + bytes;
+                return m_blocks[m_block].data.get() + offset;
+            }
+            m_block++;
+            m_offset = 0;
+        }
+        addBlock((std::max)(bytes + align, m_blockSize));
+        return alloc(bytes, align);
+    }
+
+    /**
+      Allocate uninitialized storage for an array of trivially
+      destructible T.
+
+      \param count  Number of elements.
+      \return  Pointer to the first element, valid until reset().
+    */
+    template <typename T>
+    T *alloc(size_t count)
+        { return static_cast<T *>(alloc(count * sizeof(T), alignof(T))); }
+
+    /**
+      Invalidate all outstanding allocations and make the arena's memory
+      available for reuse.  The backing blocks are retained.
+    */
+    void reset()
+    {
+        m_block = 0;
+        m_offset = 0;
+    }
+
+    /**
+      Release the backing blocks, returning the arena to its initial state.
+    */
+    void clear()
+    {
+        m_blocks.clear();
+        reset();
+    }
+
+    /**
+      Total capacity of the backing blocks.
+    */
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for (const Block& b : m_blocks)
+            total += b.size;
+        return total;
+    }
+
+private:
+    struct Block
+    {
+        Block(size_t size) : data(new char[size]), size(size)
+        {}
+
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    void addBlock(size_t size)
+    {
+        m_blocks.emplace_back(size);
+        m_block = m_blocks.size() - 1;
+        m_offset = 0;
+    }
+
+    size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    size_t m_block;
+    size_t m_offset;
+};
+
+} // namespace pdal
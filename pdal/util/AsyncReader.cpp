@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright (c) 2018, Hobu Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include "AsyncReader.hpp"
+
+#include <algorithm>
+
+#include "FileUtils.hpp"
+
+namespace pdal
+{
+
+AsyncReader::AsyncReader(const std::string& filename, size_t queueDepth,
+    size_t stripe) : m_stripe((std::max)(stripe, (size_t)1)), m_nextId(1),
+    m_done(false)
+{
+    queueDepth = (std::max)(queueDepth, (size_t)1);
+    for (size_t i = 0; i < queueDepth; ++i)
+    {
+        std::istream *in = FileUtils::openFile(filename);
+        if (!in)
+            break;
+        m_streams.push_back(in);
+    }
+    if (m_streams.size() != queueDepth)
+    {
+        // Couldn't open a stream per worker - run with none and let
+        // callers fall back to synchronous reads.
+        for (std::istream *in : m_streams)
+            FileUtils::closeFile(in);
+        m_streams.clear();
+        return;
+    }
+    for (std::istream *in : m_streams)
+        m_workers.emplace_back([this, in](){ run(in); });
+}
+
+
+AsyncReader::~AsyncReader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+        m_workCv.notify_all();
+    }
+    for (auto& worker : m_workers)
+        worker.join();
+    for (std::istream *in : m_streams)
+        FileUtils::closeFile(in);
+}
+
+
+AsyncReader::RequestId AsyncReader::submit(uint64_t offset, char *buf,
+    size_t count)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    RequestId id = m_nextId++;
+    Request& r = m_requests[id];
+    r.m_offset = offset;
+    r.m_buf = buf;
+    r.m_count = count;
+
+    size_t subs = count ? (count + m_stripe - 1) / m_stripe : 1;
+    r.m_outstanding = subs;
+    for (size_t s = 0; s < subs; ++s)
+        m_pending.push_back(SubRead{id, s * m_stripe});
+    m_workCv.notify_all();
+    return id;
+}
+
+
+int64_t AsyncReader::complete(RequestId id)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto it = m_requests.find(id);
+    if (it == m_requests.end())
+        return -1;
+    Request& r = it->second;
+    m_doneCv.wait(lock, [&r](){ return r.m_outstanding == 0; });
+
+    // Sum the contiguous prefix of sub-read results.  A short sub-read
+    // means end of file; anything past it didn't produce data.
+    int64_t total = 0;
+    for (auto& result : r.m_results)
+    {
+        size_t pos = result.first;
+        int64_t got = result.second;
+        if ((uint64_t)pos != (uint64_t)total)
+            break;
+        if (got < 0)
+        {
+            if (total == 0)
+                total = -1;
+            break;
+        }
+        total += got;
+        if ((size_t)got < (std::min)(m_stripe, r.m_count - pos))
+            break;
+    }
+    m_requests.erase(it);
+    return total;
+}
+
+
+void AsyncReader::run(std::istream *in)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_workCv.wait(lock, [this](){ return m_pending.size() || m_done; });
+        if (m_pending.empty())
+            return;
+        SubRead sub = m_pending.front();
+        m_pending.pop_front();
+
+        // The request can't be erased while it has outstanding
+        // sub-reads, so the reference stays valid across the read.
+        Request& r = m_requests[sub.m_id];
+        char *dst = r.m_buf + sub.m_pos;
+        uint64_t offset = r.m_offset + sub.m_pos;
+        size_t want = (std::min)(m_stripe, r.m_count - sub.m_pos);
+
+        lock.unlock();
+        in->clear();
+        in->seekg((std::streamoff)offset);
+        int64_t got = -1;
+        if (in->good())
+        {
+            in->read(dst, want);
+            got = in->gcount();
+        }
+        lock.lock();
+
+        r.m_results[sub.m_pos] = got;
+        r.m_outstanding--;
+        m_doneCv.notify_all();
+    }
+}
+
+} // namespace pdal
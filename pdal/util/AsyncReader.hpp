@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright (c) 2018, Hobu Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pdal_util_export.hpp"
+
+namespace pdal
+{
+
+/**
+  Asynchronous positional reads from a file.  submit() queues a read of
+  a byte range into a caller-owned buffer and returns at once;
+  complete() blocks until that read has finished and reports the bytes
+  transferred.  Large requests are striped into sub-reads serviced by a
+  pool of workers, each reading through its own stream, so a single
+  submitted block already presents the storage with the queue depth a
+  synchronous reader can't generate.  The submit/complete interface is
+  backend-agnostic: a kernel submission queue (io_uring and the like)
+  can stand in for the worker pool without touching callers.
+*/
+class PDAL_DLL AsyncReader
+{
+public:
+    /// Identifies an in-flight read.
+    typedef uint64_t RequestId;
+
+    /**
+      Open a file for asynchronous reads.
+
+      \param filename  File to read.
+      \param queueDepth  Number of sub-reads serviced concurrently.
+      \param stripe  Bytes per sub-read a request is striped into.
+    */
+    AsyncReader(const std::string& filename, size_t queueDepth = 4,
+        size_t stripe = 256 * 1024);
+    ~AsyncReader();
+
+    /**
+      \return  Whether the file could be opened.
+    */
+    bool good() const
+        { return !m_streams.empty(); }
+
+    /**
+      \return  Number of workers servicing sub-reads.
+    */
+    size_t queueDepth() const
+        { return m_streams.size(); }
+
+    /**
+      Queue a read of \c count bytes at \c offset into \c buf.  The
+      buffer must stay valid until the request is completed.
+
+      \param offset  Byte offset in the file.
+      \param buf  Destination buffer.
+      \param count  Number of bytes to read.
+      \return  Id to hand to complete().
+    */
+    RequestId submit(uint64_t offset, char *buf, size_t count);
+
+    /**
+      Wait for the identified read to finish.  Every submitted request
+      must be completed before the buffer it fills is released.
+
+      \param id  Id returned by submit().
+      \return  Bytes actually read - fewer than requested at end of
+        file - or -1 when the read failed outright.
+    */
+    int64_t complete(RequestId id);
+
+private:
+    struct Request
+    {
+        uint64_t m_offset;
+        char *m_buf;
+        size_t m_count;
+        /// Sub-reads not yet finished.
+        size_t m_outstanding;
+        /// Bytes read per sub-read, keyed by offset within the request.
+        std::map<size_t, int64_t> m_results;
+    };
+
+    /// A sub-read: a stripe of the identified request.
+    struct SubRead
+    {
+        RequestId m_id;
+        size_t m_pos;
+    };
+
+    void run(std::istream *in);
+
+    size_t m_stripe;
+    std::vector<std::istream *> m_streams;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_workCv;
+    std::condition_variable m_doneCv;
+    std::deque<SubRead> m_pending;
+    std::map<RequestId, Request> m_requests;
+    RequestId m_nextId;
+    bool m_done;
+};
+
+} // namespace pdal
@@ -32,6 +32,7 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
 #include <limits>
@@ -115,6 +116,64 @@ BOX3D& BOX3D::grow(double x, double y, double z)
     return *this;
 }
 
+
+namespace
+{
+
+// Reduce a coordinate array into a min/max pair.  Accumulating into
+// locals with no branches lets the compiler vectorize the comparisons.
+void minmax(const double *buf, size_t count, double& mn, double& mx)
+{
+    double lo = mn;
+    double hi = mx;
+    for (size_t i = 0; i < count; ++i)
+    {
+        lo = (std::min)(lo, buf[i]);
+        hi = (std::max)(hi, buf[i]);
+    }
+    mn = lo;
+    mx = hi;
+}
+
+} // unnamed namespace
+
+
+BOX2D& BOX2D::grow(const double *x, const double *y, size_t count)
+{
+    minmax(x, count, minx, maxx);
+    minmax(y, count, miny, maxy);
+    return *this;
+}
+
+
+BOX3D& BOX3D::grow(const double *x, const double *y, const double *z,
+    size_t count)
+{
+    BOX2D::grow(x, y, count);
+    minmax(z, count, minz, maxz);
+    return *this;
+}
+
+
+void BOX2D::contains(const double *x, const double *y, bool *result,
+    size_t count) const
+{
+    // The bitwise form keeps the per-point test branch free.
+    for (size_t i = 0; i < count; ++i)
+        result[i] = (minx <= x[i]) & (x[i] <= maxx) &
+            (miny <= y[i]) & (y[i] <= maxy);
+}
+
+
+void BOX3D::contains(const double *x, const double *y, const double *z,
+    bool *result, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i)
+        result[i] = (minx <= x[i]) & (x[i] <= maxx) &
+            (miny <= y[i]) & (y[i] <= maxy) &
+            (minz <= z[i]) & (z[i] <= maxz);
+}
+
 const BOX2D& BOX2D::getDefaultSpatialExtent()
 {
     static BOX2D v(LOWEST, LOWEST, HIGHEST, HIGHEST);
@@ -111,6 +111,18 @@ public:
     */
     BOX2D& grow(double dist);
 
+    /**
+      Expand the bounds of the box to include each point in the
+      provided coordinate arrays.  Batch counterpart of grow(x, y) -
+      dense arrays with a branch-free reduction let the compiler
+      vectorize the comparisons.
+
+      \param x  Array of X dimension values.
+      \param y  Array of Y dimension values.
+      \param count  Number of points.
+    */
+    BOX2D& grow(const double *x, const double *y, size_t count);
+
     /**
       Determine if a bounds box contains a point.
 
@@ -122,6 +134,18 @@ public:
     bool contains(double x, double y) const
         { return minx <= x && x <= maxx && miny <= y && y <= maxy; }
 
+    /**
+      Batch counterpart of contains(): test \a count points and write one
+      flag per point.
+
+      \param x  Array of X dimension values.
+      \param y  Array of Y dimension values.
+      \param result  Array to receive one flag per point.
+      \param count  Number of points.
+    */
+    void contains(const double *x, const double *y, bool *result,
+        size_t count) const;
+
     /**
       Determine if the bounds of this box are the same as that of another
       box.  Empty bounds boxes are always equal.
@@ -378,6 +402,18 @@ public:
     */
     BOX3D& grow(double x, double y, double z);
 
+    /**
+      Expand the bounds of the box to include each point in the
+      provided coordinate arrays.  Batch counterpart of grow(x, y, z).
+
+      \param x  Array of X dimension values.
+      \param y  Array of Y dimension values.
+      \param z  Array of Z dimension values.
+      \param count  Number of points.
+    */
+    BOX3D& grow(const double *x, const double *y, const double *z,
+        size_t count);
+
     /**
       Clear the bounds box to an empty state.
     */
@@ -398,6 +434,19 @@ public:
         return BOX2D::contains(x, y) && minz <= z && z <= maxz;
     }
 
+    /**
+      Batch counterpart of contains(): test \a count points and write one
+      flag per point.
+
+      \param x  Array of X dimension values.
+      \param y  Array of Y dimension values.
+      \param z  Array of Z dimension values.
+      \param result  Array to receive one flag per point.
+      \param count  Number of points.
+    */
+    void contains(const double *x, const double *y, const double *z,
+        bool *result, size_t count) const;
+
     /**
       Determine if another bounds box is contained in this bounds box.
       Equal limits are considered to be contained.
@@ -699,5 +699,54 @@ private:
     bool m_isLittleEndian;
 };
 
+/**
+  Extract a fixed sequence of values - a record - with a single call.
+  When \c E is a concrete extractor type the per-field extraction
+  expands inline at compile time, so no virtual call is made per field.
+
+  \param e  Extractor to read from.
+  \param v  First value to extract.
+  \return  The extractor.
+*/
+template <typename E, typename T>
+E& extractRecord(E& e, T& v)
+{
+    e >> v;
+    return e;
+}
+
+/**
+  Extract a fixed sequence of values - a record - with a single call.
+
+  \param e  Extractor to read from.
+  \param v  First value to extract.
+  \param vs  Remaining values, extracted in order.
+  \return  The extractor.
+*/
+template <typename E, typename T, typename... Ts>
+E& extractRecord(E& e, T& v, Ts&... vs)
+{
+    e >> v;
+    return extractRecord(e, vs...);
+}
+
+/**
+  Extract \c count consecutive values of one type - a slab.  The
+  conversion loop is instantiated for the concrete extractor type, so
+  tight loops over homogeneous data avoid per-value dispatch.
+
+  \param e  Extractor to read from.
+  \param buf  Buffer to receive the values.
+  \param count  Number of values to extract.
+  \return  The extractor.
+*/
+template <typename E, typename T>
+E& extractBatch(E& e, T *buf, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        e >> buf[i];
+    return e;
+}
+
 } // namespace pdal
 
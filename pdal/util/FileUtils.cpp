@@ -35,9 +35,13 @@
 #include <sys/stat.h>
 
 #include <iostream>
+#include <random>
 #include <sstream>
 #ifndef _WIN32
+#include <fcntl.h>
 #include <glob.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #else
 #include <codecvt>
 #include <Windows.h>
@@ -356,6 +360,26 @@ std::string stem(const std::string& path)
 }
 
 
+std::string temporaryFilename(const std::string& prefix)
+{
+    std::string dir;
+    for (const std::string& var : { "TMPDIR", "TEMP", "TMP" })
+        if (Utils::getenv(var, dir) == 0 && dir.size())
+            break;
+    if (dir.empty())
+#ifdef _WIN32
+        dir = ".";
+#else
+        dir = "/tmp";
+#endif
+
+    static std::mt19937_64 gen(std::random_device{}());
+    std::ostringstream name;
+    name << dir << "/" << prefix << "_" << std::hex << gen() << ".tmp";
+    return name.str();
+}
+
+
 // Determine if the path represents a directory.
 bool isDirectory(const std::string& path)
 {
@@ -444,6 +468,104 @@ std::vector<std::string> glob(std::string path)
     return filenames;
 }
 
+
+MapContext mapFile(const std::string& filename, bool readOnly,
+    uintmax_t pos, uintmax_t size)
+{
+    MapContext ctx;
+
+    if (size == 0)
+    {
+        if (!fileExists(filename))
+        {
+            ctx.m_error = "Mapped file doesn't exist.";
+            return ctx;
+        }
+        size = fileSize(filename);
+    }
+    ctx.m_size = size;
+
+#ifndef _WIN32
+    ctx.m_fd = ::open(toNative(filename).c_str(),
+        readOnly ? O_RDONLY : O_RDWR);
+    if (ctx.m_fd == -1)
+    {
+        ctx.m_error = "Mapped file couldn't be opened.";
+        return ctx;
+    }
+
+    ctx.m_addr = ::mmap(0, size,
+        readOnly ? PROT_READ : (PROT_READ | PROT_WRITE), MAP_SHARED,
+        ctx.m_fd, (off_t)pos);
+    if (ctx.m_addr == MAP_FAILED)
+    {
+        ::close(ctx.m_fd);
+        ctx.m_fd = -1;
+        ctx.m_addr = nullptr;
+        ctx.m_error = "Couldn't map file.";
+        return ctx;
+    }
+    // Hint the kernel for aggressive readahead - read-only mapped files
+    // are read front-to-back.  Failure just loses the hint.
+    if (readOnly)
+        ::madvise(ctx.m_addr, size, MADV_SEQUENTIAL);
+#else
+    HANDLE handle = CreateFileW(toNative(filename).data(),
+        readOnly ? GENERIC_READ : (GENERIC_READ | GENERIC_WRITE),
+        FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        ctx.m_error = "Mapped file couldn't be opened.";
+        return ctx;
+    }
+
+    ctx.m_handle = CreateFileMapping(handle, NULL,
+        readOnly ? PAGE_READONLY : PAGE_READWRITE, 0, 0, NULL);
+    CloseHandle(handle);
+    if (ctx.m_handle == NULL)
+    {
+        ctx.m_error = "Couldn't create file mapping.";
+        return ctx;
+    }
+
+    ctx.m_addr = MapViewOfFile(ctx.m_handle,
+        readOnly ? FILE_MAP_READ : FILE_MAP_WRITE,
+        (DWORD)(pos >> 32), (DWORD)(pos & 0xFFFFFFFF), (SIZE_T)size);
+    if (ctx.m_addr == nullptr)
+    {
+        CloseHandle((HANDLE)ctx.m_handle);
+        ctx.m_handle = nullptr;
+        ctx.m_error = "Couldn't map file.";
+    }
+#endif
+    return ctx;
+}
+
+
+MapContext unmapFile(MapContext ctx)
+{
+#ifndef _WIN32
+    if (ctx.m_addr && ::munmap(ctx.m_addr, ctx.m_size) == -1)
+        ctx.m_error = "Couldn't unmap file.";
+    else
+        ctx.m_error = "";
+    ctx.m_addr = nullptr;
+    if (ctx.m_fd != -1)
+        ::close(ctx.m_fd);
+    ctx.m_fd = -1;
+#else
+    if (ctx.m_addr && UnmapViewOfFile(ctx.m_addr) == 0)
+        ctx.m_error = "Couldn't unmap file.";
+    else
+        ctx.m_error = "";
+    ctx.m_addr = nullptr;
+    if (ctx.m_handle)
+        CloseHandle((HANDLE)ctx.m_handle);
+    ctx.m_handle = nullptr;
+#endif
+    return ctx;
+}
+
 } // namespace FileUtils
 
 } // namespace pdal
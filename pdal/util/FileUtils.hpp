@@ -251,6 +251,15 @@ namespace FileUtils
     */
     PDAL_DLL std::string stem(const std::string& path);
 
+    /**
+      Return a unique filename in the system temporary directory.  The
+      file itself is not created.
+
+      \param prefix  Leading portion of the filename.
+      \return  Path of a file that doesn't currently exist.
+    */
+    PDAL_DLL std::string temporaryFilename(const std::string& prefix);
+
     /**
       Expand a filespec to a list of files.
 
@@ -258,6 +267,62 @@ namespace FileUtils
       \return  List of files that correspond to provided file specification.
     */
     PDAL_DLL std::vector<std::string> glob(std::string filespec);
+
+    /**
+      Context for a memory-mapped file.  Returned by mapFile() and passed
+      back to unmapFile().
+    */
+    struct MapContext
+    {
+    public:
+        MapContext() : m_fd(-1), m_addr(nullptr), m_size(0)
+        {}
+
+        /**
+          \return  Pointer to the mapped data, or NULL if the mapping
+            failed.
+        */
+        PDAL_DLL void *addr() const
+            { return m_addr; }
+
+        /**
+          \return  Error message if the mapping failed.
+        */
+        PDAL_DLL std::string what() const
+            { return m_error; }
+
+        int m_fd;
+        void *m_addr;
+        uintmax_t m_size;
+        std::string m_error;
+#ifdef _WIN32
+        void *m_handle;
+#endif
+    };
+
+    /**
+      Map a file to memory.  Read-only mappings are advised for
+      sequential access.
+
+      \param filename  Name of file to map.
+      \param readOnly  If true, the mapping is read-only.  If false, the
+        file is opened for update and stores through the mapping are
+        written back to it.
+      \param pos  Starting position of file to map.
+      \param size  Number of bytes of file to map.  0 maps the whole file.
+      \return  MapContext.  addr() gives the mapped address on success;
+        what() the error otherwise.
+    */
+    PDAL_DLL MapContext mapFile(const std::string& filename,
+        bool readOnly = true, uintmax_t pos = 0, uintmax_t size = 0);
+
+    /**
+      Unmap a previously mapped file.
+
+      \param ctx  MapContext returned from mapFile().
+      \return  MapContext.  what() contains an error message on failure.
+    */
+    PDAL_DLL MapContext unmapFile(MapContext ctx);
 }
 
 } // namespace pdal
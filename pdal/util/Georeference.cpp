@@ -86,5 +86,46 @@ Xyz georeferenceWgs84(double range, double scanAngle,
     return Xyz(gpsPoint.X + pCurvilinear.X, gpsPoint.Y + pCurvilinear.Y,
                gpsPoint.Z + pCurvilinear.Z);
 }
+
+
+std::vector<Xyz> georeferenceWgs84(const double* ranges,
+                                   const double* scanAngles,
+                                   const RotationMatrix& boresightMatrix,
+                                   const RotationMatrix* imuMatrices,
+                                   const Xyz* gpsPoints, size_t count)
+{
+    // Trigonometry dominates the per-point cost, so evaluate it in
+    // straight-line array passes the compiler can vectorize before the
+    // branch-free rotation/conversion loop.  The arithmetic matches the
+    // scalar overload operation for operation.
+    std::vector<double> sinScan(count), cosScan(count);
+    std::vector<double> sinLat(count), cosLat(count);
+    for (size_t i = 0; i < count; ++i)
+        sinScan[i] = std::sin(scanAngles[i]);
+    for (size_t i = 0; i < count; ++i)
+        cosScan[i] = std::cos(scanAngles[i]);
+    for (size_t i = 0; i < count; ++i)
+        sinLat[i] = std::sin(gpsPoints[i].Y);
+    for (size_t i = 0; i < count; ++i)
+        cosLat[i] = std::cos(gpsPoints[i].Y);
+
+    std::vector<Xyz> output;
+    output.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Xyz pSocs = Xyz(ranges[i] * sinScan[i], 0, -ranges[i] * cosScan[i]);
+        Xyz pSocsAligned = rotate(pSocs, boresightMatrix);
+        Xyz pLocalLevel = rotate(pSocsAligned, imuMatrices[i]);
+
+        double w = std::sqrt(1 - e2 * sinLat[i] * sinLat[i]);
+        double n = a / w;
+        double m = a * (1 - e2) / (w * w * w);
+        output.push_back(
+            Xyz(gpsPoints[i].X + pLocalLevel.X / (n * cosLat[i]),
+                gpsPoints[i].Y + pLocalLevel.Y / m,
+                gpsPoints[i].Z + pLocalLevel.Z));
+    }
+    return output;
+}
 }
 }
@@ -34,6 +34,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
 #include "pdal_util_export.hpp"
 
 namespace pdal
@@ -87,6 +90,17 @@ PDAL_DLL Xyz georeferenceWgs84(double range, double scanAngle,
                       const RotationMatrix& boresightMatrix,
                       const RotationMatrix& imuMatrix, const Xyz& gpsPoint);
 
+// Batch form of georeferenceWgs84().  Element i of the result is
+// georeferenceWgs84(ranges[i], scanAngles[i], boresightMatrix,
+// imuMatrices[i], gpsPoints[i]).  The trigonometry is evaluated in
+// array passes, so converting a block of pulses is much cheaper than
+// looping over the scalar call.
+PDAL_DLL std::vector<Xyz> georeferenceWgs84(const double* ranges,
+                      const double* scanAngles,
+                      const RotationMatrix& boresightMatrix,
+                      const RotationMatrix* imuMatrices, const Xyz* gpsPoints,
+                      size_t count);
+
 } // namespace georeference
 } // namespace pdal
 
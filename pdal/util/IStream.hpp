@@ -44,6 +44,8 @@
 #include <vector>
 #include <cstring>
 
+#include "Charbuf.hpp"
+#include "FileUtils.hpp"
 #include "portable_endian.hpp"
 #include "pdal_util_export.hpp"
 
@@ -58,8 +60,6 @@ class IStreamMarker;
 class IStream
 {
 public:
-    //ABELL - Should prevent copy construction.
-    //ABELL - Should enable construction from rvalue ref.
     //ABELL - Should provide an operator << (..., string) that delegates
     //  to std::istream
     /**
@@ -77,6 +77,17 @@ public:
         m_stream(NULL), m_fstream(NULL)
     { open(filename); }
 
+    /**
+      Construct an IStream from a filename, optionally using the
+      mapped/readahead path (see two-argument open()).
+
+      \param filename  File from which to read.
+      \param readAhead  Use the mapped/readahead path when possible.
+    */
+    PDAL_DLL IStream(const std::string& filename, bool readAhead) :
+        m_stream(NULL), m_fstream(NULL)
+    { open(filename, readAhead); }
+
     /**
       Construct an IStream from an input stream pointer.
 
@@ -85,8 +96,35 @@ public:
     PDAL_DLL IStream(std::istream *stream) : m_stream(stream), m_fstream(NULL)
         {}
 
+    PDAL_DLL IStream(IStream&& src) :
+        m_stream(src.m_stream), m_fstream(src.m_fstream),
+        m_map(src.m_map), m_mapBuf(std::move(src.m_mapBuf)),
+        m_mapStream(std::move(src.m_mapStream)),
+        m_buf(std::move(src.m_buf)), m_streams(std::move(src.m_streams))
+    {
+        src.m_stream = NULL;
+        src.m_fstream = NULL;
+        src.m_map = FileUtils::MapContext();
+    }
+
+    PDAL_DLL IStream& operator=(IStream&& src)
+    {
+        close();
+        m_stream = src.m_stream;
+        m_fstream = src.m_fstream;
+        m_map = src.m_map;
+        m_mapBuf = std::move(src.m_mapBuf);
+        m_mapStream = std::move(src.m_mapStream);
+        m_buf = std::move(src.m_buf);
+        m_streams = std::move(src.m_streams);
+        src.m_stream = NULL;
+        src.m_fstream = NULL;
+        src.m_map = FileUtils::MapContext();
+        return *this;
+    }
+
     PDAL_DLL ~IStream()
-        { delete m_fstream; }
+        { close(); }
 
     /**
       Open a file to extract.
@@ -103,6 +141,43 @@ public:
         return 0;
     }
 
+    /**
+      Open a file to extract, optionally reading through a fast path.
+
+      When \c readAhead is true, the file is mapped into memory (the
+      mapping is advised for sequential access) and extraction is served
+      directly from the mapping.  If the file can't be mapped, it is
+      opened normally but with a large stream buffer so that data is
+      fetched from the file in large chunks.  Extraction code is
+      unaffected by the path chosen.  Use only for local files.
+
+      \param filename  Filename.
+      \param readAhead  Use the mapped/readahead path when possible.
+      \return  -1 if a stream is already assigned, 0 otherwise.
+    */
+    PDAL_DLL int open(const std::string& filename, bool readAhead)
+    {
+        if (!readAhead)
+            return open(filename);
+        if (m_stream)
+            return -1;
+        m_map = FileUtils::mapFile(filename);
+        if (m_map.addr())
+        {
+            m_mapBuf.reset(new Charbuf((char *)m_map.addr(),
+                (size_t)m_map.m_size));
+            m_mapStream.reset(new std::istream(m_mapBuf.get()));
+            m_stream = m_mapStream.get();
+            return 0;
+        }
+        m_buf.resize(1024 * 1024);
+        m_fstream = new std::ifstream;
+        m_fstream->rdbuf()->pubsetbuf(m_buf.data(), m_buf.size());
+        m_fstream->open(filename, std::ios_base::in | std::ios_base::binary);
+        m_stream = m_fstream;
+        return 0;
+    }
+
     /**
       Close the underlying stream.
     */
@@ -111,6 +186,10 @@ public:
         delete m_fstream;
         m_fstream = NULL;
         m_stream = NULL;
+        m_mapStream.reset();
+        m_mapBuf.reset();
+        if (m_map.addr())
+            m_map = FileUtils::unmapFile(m_map);
     }
 
     /**
@@ -262,6 +341,11 @@ protected:
     std::ifstream *m_fstream; // Dup of above to facilitate cleanup.
 
 private:
+    // State for the mapped/readahead path (see two-argument open()).
+    FileUtils::MapContext m_map;
+    std::unique_ptr<Charbuf> m_mapBuf;
+    std::unique_ptr<std::istream> m_mapStream;
+    std::vector<char> m_buf; // Large buffer when mapping isn't possible.
     std::stack<std::istream *> m_streams;
 };
 
@@ -286,6 +370,17 @@ public:
     PDAL_DLL ILeStream(const std::string& filename) : IStream(filename)
     {}
 
+    /**
+      Constructor that opens the file, optionally using the
+      mapped/readahead path (see IStream::open()).
+
+      \param filename  Filename.
+      \param readAhead  Use the mapped/readahead path when possible.
+    */
+    PDAL_DLL ILeStream(const std::string& filename, bool readAhead) :
+        IStream(filename, readAhead)
+    {}
+
     /**
       Constructor that maps to a provided stream.
 
@@ -299,4 +299,33 @@ public:
     }
 };
 
+/// Insert a fixed sequence of values - a record - with a single call.
+/// When \c I is a concrete inserter type the per-field insertion expands
+/// inline at compile time, so no virtual call is made per field.
+template <typename I, typename T>
+I& insertRecord(I& in, T v)
+{
+    in << v;
+    return in;
+}
+
+/// Insert a fixed sequence of values - a record - with a single call.
+template <typename I, typename T, typename... Ts>
+I& insertRecord(I& in, T v, Ts... vs)
+{
+    in << v;
+    return insertRecord(in, vs...);
+}
+
+/// Insert \c count consecutive values of one type - a slab.  The
+/// conversion loop is instantiated for the concrete inserter type, so
+/// tight loops over homogeneous data avoid per-value dispatch.
+template <typename I, typename T>
+I& insertBatch(I& in, const T *buf, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        in << buf[i];
+    return in;
+}
+
 } // namespace pdal
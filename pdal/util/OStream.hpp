@@ -38,10 +38,12 @@
 
 #include <fstream>
 #include <cstring>
+#include <memory>
 #include <stack>
 
 #include "portable_endian.hpp"
 #include "pdal_util_export.hpp"
+#include "WriteBehind.hpp"
 
 namespace pdal
 {
@@ -67,12 +69,47 @@ public:
             std::ios_base::out | std::ios_base::binary);
         return 0;
     }
+    /**
+      Open a file for output, optionally buffering writes through a ring
+      of large buffers flushed by a background thread (see
+      WriteBehindBuf).
+
+      \param filename  File to create.
+      \param writeBehind  Whether writes should be buffered and issued
+        by a background thread.
+      \return  0 on success, -1 on failure.
+    */
+    PDAL_DLL int open(const std::string& filename, bool writeBehind)
+    {
+        if (!writeBehind)
+            return open(filename);
+        if (m_stream)
+            return -1;
+        std::unique_ptr<WriteBehindBuf> buf(new WriteBehindBuf());
+        if (!buf->open(filename))
+            return -1;
+        m_wbBuf = std::move(buf);
+        m_stream = m_fstream = new std::ostream(m_wbBuf.get());
+        return 0;
+    }
     PDAL_DLL void close()
     {
         flush();
         delete m_fstream;
         m_fstream = NULL;
         m_stream = NULL;
+        m_wbBuf.reset();
+    }
+    /**
+      For a write-behind stream, control whether flushes also force data
+      to stable storage (fsync).  A no-op for ordinary streams.
+
+      \param sync  Whether flushes should fsync.
+    */
+    PDAL_DLL void setSyncOnFlush(bool sync)
+    {
+        if (m_wbBuf)
+            m_wbBuf->setSyncOnFlush(sync);
     }
     PDAL_DLL bool isOpen() const
         { return (bool)m_stream; }
@@ -118,6 +155,7 @@ protected:
 
 private:
     std::stack<std::ostream *> m_streams;
+    std::unique_ptr<WriteBehindBuf> m_wbBuf;
     OStream(const OStream&);
 };
 
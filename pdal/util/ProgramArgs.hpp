@@ -1158,6 +1158,43 @@ public:
         //  unconsumed arguments.
     }
 
+    /**
+      Assign a single named option value directly.  Equivalent to parsing
+      "--name=value" but without building command-line text and splitting
+      it back apart.  Callers feeding a set of options should finish with
+      \ref checkPositionals to get \ref parse's validation.
+
+      \param name  Argument longname.
+      \param value  Value to assign.
+    */
+    void parseOption(const std::string& name, const std::string& value)
+    {
+        Arg *arg = findLongArg(name);
+        if (!arg)
+            throw arg_error("Unexpected argument '" + name + "'.");
+        if (!arg->needsValue() && value != "true" && value != "false")
+        {
+            throw arg_error("Value '" + value + "' provided for argument '" +
+                name + "' when 'true' or 'false' is expected.");
+        }
+        arg->setValue(value);
+    }
+
+    /**
+      Finish a parse performed through \ref parseOption calls.  Verifies
+      positional-argument ordering and that every required positional
+      argument was assigned a value.
+    */
+    void checkPositionals()
+    {
+        validate();
+
+        std::vector<std::string> none;
+        ArgValList vals(none);
+        for (auto ai = m_args.begin(); ai != m_args.end(); ++ai)
+            (*ai)->assignPositional(vals);
+    }
+
     /**
       Add a synonym for an argument.
 
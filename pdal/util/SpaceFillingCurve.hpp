@@ -0,0 +1,167 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its contributors
+*       may be used to endorse or promote products derived from this
+*       software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// Space-filling curve keys shared by the stages that order or chunk
+// points spatially (filters.mortonorder, the spatially ordered LAS
+// chunk mode).  Single-value encoders are inline scalar kernels - with
+// BMI2 bit-deposit where the compiler offers it - and the array forms
+// are plain loops over them that compilers can keep in registers and
+// unroll.
+
+namespace pdal
+{
+namespace curve
+{
+
+/// Spread the low 32 bits of x over the even bits of a 64-bit word.
+inline uint64_t spread2(uint64_t x)
+{
+#if defined(__BMI2__)
+    return _pdep_u64(x, 0x5555555555555555ULL);
+#else
+    x &= 0x00000000ffffffffULL;
+    x = (x ^ (x << 16)) & 0x0000ffff0000ffffULL;
+    x = (x ^ (x <<  8)) & 0x00ff00ff00ff00ffULL;
+    x = (x ^ (x <<  4)) & 0x0f0f0f0f0f0f0f0fULL;
+    x = (x ^ (x <<  2)) & 0x3333333333333333ULL;
+    x = (x ^ (x <<  1)) & 0x5555555555555555ULL;
+    return x;
+#endif
+}
+
+/// Spread the low 21 bits of x over every third bit of a 64-bit word.
+inline uint64_t spread3(uint64_t x)
+{
+#if defined(__BMI2__)
+    return _pdep_u64(x, 0x1249249249249249ULL);
+#else
+    x &= 0x00000000001fffffULL;
+    x = (x ^ (x << 32)) & 0x001f00000000ffffULL;
+    x = (x ^ (x << 16)) & 0x001f0000ff0000ffULL;
+    x = (x ^ (x <<  8)) & 0x100f00f00f00f00fULL;
+    x = (x ^ (x <<  4)) & 0x10c30c30c30c30c3ULL;
+    x = (x ^ (x <<  2)) & 0x1249249249249249ULL;
+    return x;
+#endif
+}
+
+/// 2D Morton (z-order) code of a cell on a 2^32 x 2^32 grid.  X occupies
+/// the odd (higher) bits.
+inline uint64_t mortonEncode(uint32_t x, uint32_t y)
+{
+    return (spread2(x) << 1) | spread2(y);
+}
+
+/// 3D Morton code of a cell on a 2^21 grid per axis.
+inline uint64_t mortonEncode(uint32_t x, uint32_t y, uint32_t z)
+{
+    return (spread3(x) << 2) | (spread3(y) << 1) | spread3(z);
+}
+
+/// 2D Morton code of a cell on a 2^16 x 2^16 grid, packed in 32 bits.
+inline uint32_t mortonEncode16(uint32_t x, uint32_t y)
+{
+    return (uint32_t)((spread2(x & 0xffff) << 1) | spread2(y & 0xffff));
+}
+
+/// Reverse the bit order of a 32-bit word.  Reversing a Morton code
+/// orders cells by level-of-detail (coarse interleave bits last).
+inline uint32_t bitReverse(uint32_t v)
+{
+    v = ((v >> 1) & 0x55555555u) | ((v & 0x55555555u) << 1);
+    v = ((v >> 2) & 0x33333333u) | ((v & 0x33333333u) << 2);
+    v = ((v >> 4) & 0x0f0f0f0fu) | ((v & 0x0f0f0f0fu) << 4);
+    v = ((v >> 8) & 0x00ff00ffu) | ((v & 0x00ff00ffu) << 8);
+    v = ((v >> 16) & 0xffffu) | ((v & 0xffffu) << 16);
+    return v;
+}
+
+/// Index of a cell on a 2^16 x 2^16 grid along a Hilbert curve.  Unlike
+/// the Morton order, consecutive indices are always adjacent cells,
+/// which gives slightly tighter spatial runs at the cost of a
+/// data-dependent transform per level.
+inline uint64_t hilbertEncode(uint32_t x, uint32_t y)
+{
+    uint64_t d = 0;
+    for (uint32_t s = 1 << 15; s > 0; s /= 2)
+    {
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/// Array forms: encode 'count' coordinate pairs/triples into 'codes'.
+inline void mortonEncode(const uint32_t *x, const uint32_t *y,
+    size_t count, uint64_t *codes)
+{
+    for (size_t i = 0; i < count; ++i)
+        codes[i] = mortonEncode(x[i], y[i]);
+}
+
+inline void mortonEncode(const uint32_t *x, const uint32_t *y,
+    const uint32_t *z, size_t count, uint64_t *codes)
+{
+    for (size_t i = 0; i < count; ++i)
+        codes[i] = mortonEncode(x[i], y[i], z[i]);
+}
+
+inline void hilbertEncode(const uint32_t *x, const uint32_t *y,
+    size_t count, uint64_t *codes)
+{
+    for (size_t i = 0; i < count; ++i)
+        codes[i] = hilbertEncode(x[i], y[i]);
+}
+
+} // namespace curve
+} // namespace pdal
@@ -37,6 +37,7 @@
 #include <array>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <cctype>
 #include <memory>
 #include <random>
@@ -611,6 +612,109 @@ double Utils::normalizeLongitude(double longitude)
 }
 
 
+bool Utils::parseDouble(const char *start, const char *end, double& d)
+{
+    // The common case - at most 15 significant digits and a decimal
+    // exponent within +/-22 - is converted with integer accumulation and
+    // one exact power-of-ten scale, which rounds identically to the
+    // library conversion.  Anything else falls back to fromString().
+    static const double powers[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    if (end - start == 3 &&
+        (memcmp(start, "nan", 3) == 0 || memcmp(start, "NaN", 3) == 0))
+    {
+        d = std::numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+
+    const char *p = start;
+    while (p != end && std::isspace((unsigned char)*p))
+        ++p;
+
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-'))
+        negative = (*p++ == '-');
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool sawDigit = false;
+    bool extra = false;  // Digits beyond what we can accumulate exactly.
+
+    while (p != end && *p >= '0' && *p <= '9')
+    {
+        sawDigit = true;
+        if (digits < 18)
+        {
+            mantissa = (mantissa * 10) + uint64_t(*p - '0');
+            if (mantissa)
+                digits++;
+        }
+        else
+        {
+            exponent++;
+            extra = true;
+        }
+        ++p;
+    }
+    if (p != end && *p == '.')
+    {
+        ++p;
+        while (p != end && *p >= '0' && *p <= '9')
+        {
+            sawDigit = true;
+            if (digits < 18)
+            {
+                mantissa = (mantissa * 10) + uint64_t(*p - '0');
+                if (mantissa)
+                    digits++;
+                exponent--;
+            }
+            else
+                extra = true;
+            ++p;
+        }
+    }
+    if (!sawDigit)
+        return false;
+
+    if (p != end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        bool expNegative = false;
+        if (p != end && (*p == '+' || *p == '-'))
+            expNegative = (*p++ == '-');
+        // A bare exponent marker fails the stream conversion, so it
+        // fails here too.
+        if (p == end || *p < '0' || *p > '9')
+            return false;
+        int e = 0;
+        while (p != end && *p >= '0' && *p <= '9')
+        {
+            if (e < 10000)
+                e = (e * 10) + (*p - '0');
+            ++p;
+        }
+        exponent += expNegative ? -e : e;
+    }
+
+    if (extra || digits > 15 || exponent < -22 || exponent > 22)
+        return fromString(std::string(start, end), d);
+
+    double v = (double)mantissa;
+    if (exponent < 0)
+        v /= powers[-exponent];
+    else
+        v *= powers[exponent];
+    d = negative ? -v : v;
+    return true;
+}
+
+
 // Useful for debug on occasion.
 std::string Utils::hexDump(const char *buf, size_t count)
 {
@@ -451,6 +451,23 @@ namespace Utils
     */
     PDAL_DLL double normalizeLongitude(double longitude);
 
+    /**
+      Parse a double from the characters in [start, end), mirroring the
+      semantics of fromString<double>(): a field of exactly "nan" or "NaN"
+      yields NaN, leading whitespace is skipped, parsing stops at the first
+      character that can't continue a decimal number and any trailing
+      characters are ignored.  Values with at most 15 significant digits
+      and a small decimal exponent are converted without stream overhead
+      and round identically to the library conversion; anything else falls
+      back to fromString().
+
+      \param start  First character of the field.
+      \param end  One past the last character of the field.
+      \param d  Converted value.
+      \return  \c true if a number was found, \c false otherwise.
+    */
+    PDAL_DLL bool parseDouble(const char *start, const char *end, double& d);
+
     /**
       Convert an input buffer to a hexadecimal string representation similar
       to the output of the UNIX command 'od'.  This is mostly used as an
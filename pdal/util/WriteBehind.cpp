@@ -0,0 +1,237 @@
+/******************************************************************************
+* Copyright (c) 2020, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "WriteBehind.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace pdal
+{
+
+WriteBehindBuf::WriteBehindBuf(size_t bufSize, size_t bufCount) :
+    m_bufSize((std::max)(bufSize, (size_t)1)), m_file(nullptr),
+    m_syncOnFlush(false), m_pos(0), m_fill(0), m_done(false),
+    m_writing(false), m_error(false)
+{
+    m_cur.resize(m_bufSize);
+    for (size_t i = 1; i < (std::max)(bufCount, (size_t)2); ++i)
+        m_free.emplace_back(std::vector<char>(m_bufSize));
+}
+
+
+WriteBehindBuf::~WriteBehindBuf()
+{
+    close();
+}
+
+
+bool WriteBehindBuf::open(const std::string& filename)
+{
+    if (m_file)
+        return false;
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file)
+        return false;
+    m_pos = 0;
+    m_fill = 0;
+    m_done = false;
+    m_error = false;
+    m_writer = std::thread([this](){ run(); });
+    return true;
+}
+
+
+void WriteBehindBuf::close()
+{
+    if (!m_file)
+        return;
+    sync();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+        m_consumerCv.notify_all();
+    }
+    m_writer.join();
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+
+void WriteBehindBuf::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_consumerCv.wait(lock,
+            [this](){ return m_full.size() || m_done; });
+        if (m_full.empty())
+            return;
+        std::vector<char> buf = std::move(m_full.front());
+        m_full.pop_front();
+        m_writing = true;
+
+        lock.unlock();
+        if (!m_error && buf.size() &&
+            std::fwrite(buf.data(), 1, buf.size(), m_file) != buf.size())
+            m_error = true;
+        lock.lock();
+
+        m_writing = false;
+        m_free.push_back(std::move(buf));
+        m_producerCv.notify_all();
+    }
+}
+
+
+void WriteBehindBuf::enqueue()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_cur.resize(m_fill);
+    m_full.push_back(std::move(m_cur));
+    m_consumerCv.notify_one();
+
+    m_producerCv.wait(lock, [this](){ return m_free.size(); });
+    m_cur = std::move(m_free.front());
+    m_free.pop_front();
+    // The buffer's capacity was established at construction, so this
+    // never reallocates.
+    m_cur.resize(m_bufSize);
+    m_fill = 0;
+}
+
+
+void WriteBehindBuf::drain()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_producerCv.wait(lock,
+        [this](){ return m_full.empty() && !m_writing; });
+}
+
+
+WriteBehindBuf::int_type WriteBehindBuf::overflow(int_type c)
+{
+    if (c != traits_type::eof())
+    {
+        char ch = (char)c;
+        if (xsputn(&ch, 1) != 1)
+            return traits_type::eof();
+    }
+    return traits_type::not_eof(c);
+}
+
+
+std::streamsize WriteBehindBuf::xsputn(const char *s, std::streamsize count)
+{
+    if (!m_file || m_error)
+        return 0;
+
+    std::streamsize remain = count;
+    while (remain)
+    {
+        size_t amt = (std::min)((size_t)remain, m_bufSize - m_fill);
+        std::memcpy(m_cur.data() + m_fill, s, amt);
+        m_fill += amt;
+        s += amt;
+        remain -= amt;
+        if (m_fill == m_bufSize)
+            enqueue();
+    }
+    m_pos += count;
+    return count;
+}
+
+
+int WriteBehindBuf::sync()
+{
+    if (!m_file)
+        return -1;
+    if (m_fill)
+        enqueue();
+    drain();
+    if (std::fflush(m_file))
+        m_error = true;
+#ifdef _WIN32
+    if (m_syncOnFlush && _commit(_fileno(m_file)))
+        m_error = true;
+#else
+    if (m_syncOnFlush && ::fsync(fileno(m_file)))
+        m_error = true;
+#endif
+    return m_error ? -1 : 0;
+}
+
+
+WriteBehindBuf::pos_type WriteBehindBuf::seekoff(off_type off,
+    std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if (!m_file || !(which & std::ios_base::out))
+        return pos_type(off_type(-1));
+
+    // tellp() comes through here - answer from the logical position
+    // without stalling on a drain.
+    if (dir == std::ios_base::cur && off == 0)
+        return m_pos;
+
+    if (sync())
+        return pos_type(off_type(-1));
+    int whence = (dir == std::ios_base::beg) ? SEEK_SET :
+        (dir == std::ios_base::cur) ? SEEK_CUR : SEEK_END;
+#ifdef _WIN32
+    if (_fseeki64(m_file, (int64_t)off, whence))
+        return pos_type(off_type(-1));
+    m_pos = (off_type)_ftelli64(m_file);
+#else
+    if (::fseeko(m_file, (off_t)off, whence))
+        return pos_type(off_type(-1));
+    m_pos = (off_type)::ftello(m_file);
+#endif
+    return m_pos;
+}
+
+
+WriteBehindBuf::pos_type WriteBehindBuf::seekpos(pos_type pos,
+    std::ios_base::openmode which)
+{
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+} // namespace pdal
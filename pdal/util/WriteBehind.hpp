@@ -0,0 +1,142 @@
+/******************************************************************************
+* Copyright (c) 2020, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pdal_util_export.hpp"
+
+namespace pdal
+{
+
+/**
+  A write-behind streambuf.  Output fills one of a small ring of large
+  buffers while a background thread writes completed buffers to the file,
+  so the producing thread doesn't stall on the filesystem.  Flushing the
+  owning stream drains the ring (optionally forcing data to stable
+  storage), and seeks drain before repositioning, so the buffer behaves
+  like an ofstream for writers that rewind to patch headers.
+*/
+class PDAL_DLL WriteBehindBuf : public std::streambuf
+{
+public:
+    /**
+      Construct a write-behind buffer.
+
+      \param bufSize  Size of each ring buffer in bytes.
+      \param bufCount  Number of ring buffers.
+    */
+    WriteBehindBuf(size_t bufSize = 1024 * 1024, size_t bufCount = 4);
+    ~WriteBehindBuf();
+
+    /**
+      Open a file for output and start the writer thread.
+
+      \param filename  File to create.
+      \return  Whether the file could be opened.
+    */
+    bool open(const std::string& filename);
+
+    /**
+      Drain pending output, stop the writer thread and close the file.
+    */
+    void close();
+
+    /**
+      \return  Whether a file is open.
+    */
+    bool isOpen() const
+        { return m_file != nullptr; }
+
+    /**
+      When enabled, each stream flush also forces written data to stable
+      storage (fsync) after the ring drains.
+
+      \param syncOnFlush  Whether flushes should fsync.
+    */
+    void setSyncOnFlush(bool syncOnFlush)
+        { m_syncOnFlush = syncOnFlush; }
+
+protected:
+    virtual int_type overflow(int_type c);
+    virtual std::streamsize xsputn(const char *s, std::streamsize count);
+    virtual int sync();
+    virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+        std::ios_base::openmode which =
+            std::ios_base::in | std::ios_base::out);
+    virtual pos_type seekpos(pos_type pos,
+        std::ios_base::openmode which =
+            std::ios_base::in | std::ios_base::out);
+
+private:
+    size_t m_bufSize;
+    std::FILE *m_file;
+    bool m_syncOnFlush;
+    /// Logical write position, including bytes still in the ring.
+    pos_type m_pos;
+
+    std::vector<char> m_cur;    // Buffer being filled.
+    size_t m_fill;              // Bytes in the current buffer.
+
+    std::mutex m_mutex;
+    std::condition_variable m_producerCv;
+    std::condition_variable m_consumerCv;
+    std::deque<std::vector<char>> m_full;   // Buffers awaiting write.
+    std::deque<std::vector<char>> m_free;   // Buffers ready for reuse.
+    std::thread m_writer;
+    bool m_done;                // Writer should exit once the ring drains.
+    bool m_writing;             // Writer is in the middle of a write.
+    std::atomic<bool> m_error;  // A background write failed.
+
+    /// Hand the current buffer to the writer and grab a free one.
+    void enqueue();
+    /// Wait until all queued buffers have been written.
+    void drain();
+    /// Writer thread.
+    void run();
+
+    WriteBehindBuf(const WriteBehindBuf&);  // not implemented
+    WriteBehindBuf& operator=(const WriteBehindBuf&);  // not implemented
+};
+
+} // namespace pdal
@@ -0,0 +1,239 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "ArrowReader.hpp"
+
+namespace pdal
+{
+
+static PluginInfo const s_info
+{
+    "readers.arrow",
+    "Read data from Arrow record batches (IPC file or stream format).",
+    "http://pdal.io/stages/readers.arrow.html"
+};
+
+CREATE_SHARED_STAGE(ArrowReader, s_info)
+
+std::string ArrowReader::getName() const { return s_info.name; }
+
+namespace
+{
+
+Dimension::Type pdalType(const arrow::DataType& type)
+{
+    using Type = Dimension::Type;
+
+    switch (type.id())
+    {
+    case arrow::Type::INT8:
+        return Type::Signed8;
+    case arrow::Type::INT16:
+        return Type::Signed16;
+    case arrow::Type::INT32:
+        return Type::Signed32;
+    case arrow::Type::INT64:
+        return Type::Signed64;
+    case arrow::Type::UINT8:
+        return Type::Unsigned8;
+    case arrow::Type::UINT16:
+        return Type::Unsigned16;
+    case arrow::Type::UINT32:
+        return Type::Unsigned32;
+    case arrow::Type::UINT64:
+        return Type::Unsigned64;
+    case arrow::Type::FLOAT:
+        return Type::Float;
+    case arrow::Type::DOUBLE:
+        return Type::Double;
+    default:
+        break;
+    }
+    return Type::None;
+}
+
+} // unnamed namespace
+
+ArrowReader::ArrowReader() : m_batchNum(0), m_row(0)
+{}
+
+
+ArrowReader::~ArrowReader()
+{}
+
+
+void ArrowReader::check(const arrow::Status& status)
+{
+    if (!status.ok())
+        throwError(status.ToString());
+}
+
+
+void ArrowReader::initialize()
+{
+    check(arrow::io::ReadableFile::Open(m_filename, &m_file));
+
+    // The random-access (file/Feather) format has a footer, so try it
+    // first and fall back to the stream format.
+    arrow::Status status =
+        arrow::ipc::RecordBatchFileReader::Open(m_file, &m_fileReader);
+    if (status.ok())
+        m_schema = m_fileReader->schema();
+    else
+    {
+        check(m_file->Seek(0));
+        check(arrow::ipc::RecordBatchStreamReader::Open(m_file,
+            &m_streamReader));
+        m_schema = m_streamReader->schema();
+    }
+
+    m_columns.clear();
+    for (int i = 0; i < m_schema->num_fields(); ++i)
+    {
+        const std::shared_ptr<arrow::Field>& field = m_schema->field(i);
+        Dimension::Type type = pdalType(*field->type());
+        if (type == Dimension::Type::None)
+        {
+            log()->get(LogLevel::Warning) << getName() <<
+                ": Skipping column '" << field->name() <<
+                "' with unsupported type." << std::endl;
+            continue;
+        }
+        m_columns.emplace_back(field->name(), type, i);
+    }
+    if (m_columns.empty())
+        throwError("No columns found that map to point dimensions.");
+}
+
+
+void ArrowReader::addDimensions(PointLayoutPtr layout)
+{
+    for (DimColumn& col : m_columns)
+        col.m_id = layout->registerOrAssignDim(col.m_name, col.m_type);
+}
+
+
+void ArrowReader::ready(PointTableRef table)
+{
+    m_batchNum = 0;
+    m_batch.reset();
+    m_row = 0;
+}
+
+
+// Load the next record batch and cache raw pointers to its column
+// values.  The values sit in the batch's buffers - points are filled
+// straight from the mapped memory without further copies.
+bool ArrowReader::loadBatch()
+{
+    m_batch.reset();
+    if (m_fileReader)
+    {
+        if (m_batchNum >= m_fileReader->num_record_batches())
+            return false;
+        check(m_fileReader->ReadRecordBatch(m_batchNum++, &m_batch));
+    }
+    else
+        check(m_streamReader->ReadNext(&m_batch));
+    if (!m_batch || m_batch->num_rows() == 0)
+        return false;
+
+    m_rawValues.clear();
+    for (DimColumn& col : m_columns)
+    {
+        const arrow::PrimitiveArray& array =
+            static_cast<const arrow::PrimitiveArray&>(
+                *m_batch->column(col.m_index));
+        m_rawValues.push_back(array.values()->data() +
+            array.offset() * Dimension::size(col.m_type));
+    }
+    m_row = 0;
+    return true;
+}
+
+
+void ArrowReader::fillPoint(PointRef& point, int64_t row)
+{
+    for (size_t i = 0; i < m_columns.size(); ++i)
+    {
+        const DimColumn& col = m_columns[i];
+        point.setField(col.m_id, col.m_type,
+            m_rawValues[i] + row * Dimension::size(col.m_type));
+    }
+}
+
+
+point_count_t ArrowReader::read(PointViewPtr view, point_count_t count)
+{
+    point_count_t numRead = 0;
+    while (numRead < count)
+    {
+        if (!m_batch || m_row >= m_batch->num_rows())
+            if (!loadBatch())
+                break;
+        PointId nextId = view->size();
+        for (size_t i = 0; i < m_columns.size(); ++i)
+        {
+            const DimColumn& col = m_columns[i];
+            view->setField(col.m_id, col.m_type, nextId,
+                m_rawValues[i] + m_row * Dimension::size(col.m_type));
+        }
+        m_row++;
+        numRead++;
+    }
+    return numRead;
+}
+
+
+bool ArrowReader::processOne(PointRef& point)
+{
+    if (!m_batch || m_row >= m_batch->num_rows())
+        if (!loadBatch())
+            return false;
+    fillPoint(point, m_row++);
+    return true;
+}
+
+
+void ArrowReader::done(PointTableRef table)
+{
+    m_batch.reset();
+    m_fileReader.reset();
+    m_streamReader.reset();
+    if (m_file)
+        check(m_file->Close());
+    m_file.reset();
+}
+
+} // namespace pdal
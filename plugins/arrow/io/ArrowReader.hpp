@@ -0,0 +1,99 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <pdal/Reader.hpp>
+#include <pdal/Streamable.hpp>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+
+namespace pdal
+{
+
+class PDAL_DLL ArrowReader : public Reader, public Streamable
+{
+public:
+    ArrowReader();
+    ~ArrowReader();
+    std::string getName() const;
+
+private:
+    // Describes the mapping of an Arrow column to a point dimension.
+    struct DimColumn
+    {
+        std::string m_name;
+        Dimension::Id m_id;
+        Dimension::Type m_type;
+        int m_index;
+
+        DimColumn(const std::string& name, Dimension::Type type, int index) :
+            m_name(name), m_id(Dimension::Id::Unknown), m_type(type),
+            m_index(index)
+        {}
+    };
+
+    virtual void initialize();
+    virtual void addDimensions(PointLayoutPtr layout);
+    virtual void ready(PointTableRef table);
+    virtual point_count_t read(PointViewPtr view, point_count_t count);
+    virtual bool processOne(PointRef& point);
+    virtual void done(PointTableRef table);
+
+    void check(const arrow::Status& status);
+    bool loadBatch();
+    void fillPoint(PointRef& point, int64_t row);
+
+    std::vector<DimColumn> m_columns;
+    std::shared_ptr<arrow::Schema> m_schema;
+    std::shared_ptr<arrow::io::ReadableFile> m_file;
+    // One of the two readers is active, depending on the IPC format
+    // found in the file.
+    std::shared_ptr<arrow::ipc::RecordBatchFileReader> m_fileReader;
+    std::shared_ptr<arrow::ipc::RecordBatchReader> m_streamReader;
+
+    std::shared_ptr<arrow::RecordBatch> m_batch;
+    // Raw value pointers into the current batch's column buffers, so
+    // per-point access doesn't touch the Arrow API.
+    std::vector<const uint8_t *> m_rawValues;
+    int m_batchNum;
+    int64_t m_row;
+
+    ArrowReader(const ArrowReader&) = delete;
+    ArrowReader& operator=(const ArrowReader&) = delete;
+};
+
+} // namespace pdal
@@ -0,0 +1,258 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "ArrowWriter.hpp"
+
+#include <pdal/util/ProgramArgs.hpp>
+
+namespace pdal
+{
+
+static PluginInfo const s_info
+{
+    "writers.arrow",
+    "Write data as Arrow record batches (IPC file or stream format).",
+    "http://pdal.io/stages/writers.arrow.html"
+};
+
+CREATE_SHARED_STAGE(ArrowWriter, s_info)
+
+std::string ArrowWriter::getName() const { return s_info.name; }
+
+namespace
+{
+
+std::shared_ptr<arrow::DataType> arrowType(Dimension::Type type)
+{
+    using Type = Dimension::Type;
+
+    switch (type)
+    {
+    case Type::Signed8:
+        return arrow::int8();
+    case Type::Signed16:
+        return arrow::int16();
+    case Type::Signed32:
+        return arrow::int32();
+    case Type::Signed64:
+        return arrow::int64();
+    case Type::Unsigned8:
+        return arrow::uint8();
+    case Type::Unsigned16:
+        return arrow::uint16();
+    case Type::Unsigned32:
+        return arrow::uint32();
+    case Type::Unsigned64:
+        return arrow::uint64();
+    case Type::Float:
+        return arrow::float32();
+    case Type::Double:
+        return arrow::float64();
+    default:
+        break;
+    }
+    return nullptr;
+}
+
+} // unnamed namespace
+
+ArrowWriter::ArrowWriter() : m_numRows(0)
+{}
+
+
+ArrowWriter::~ArrowWriter()
+{}
+
+
+void ArrowWriter::addArgs(ProgramArgs& args)
+{
+    args.add("filename", "Output filename", m_filename).setPositional();
+    args.add("format", "Output format ('file'/'stream')", m_format,
+        "file");
+    args.add("batch_size", "Number of points in each record batch",
+        m_batchSize, (size_t)65536);
+}
+
+
+void ArrowWriter::check(const arrow::Status& status)
+{
+    if (!status.ok())
+        throwError(status.ToString());
+}
+
+
+void ArrowWriter::ready(PointTableRef table)
+{
+    PointLayoutPtr layout = table.layout();
+
+    m_columns.clear();
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    for (Dimension::Id id : layout->dims())
+    {
+        std::string name = layout->dimName(id);
+        Dimension::Type type = layout->dimType(id);
+
+        std::shared_ptr<arrow::DataType> dt = arrowType(type);
+        if (!dt)
+        {
+            log()->get(LogLevel::Warning) << getName() <<
+                ": Skipping dimension '" << name <<
+                "' with unsupported type." << std::endl;
+            continue;
+        }
+        m_columns.emplace_back(name, id, type);
+        check(arrow::MakeBuilder(arrow::default_memory_pool(), dt,
+            &m_columns.back().m_builder));
+        fields.push_back(arrow::field(name, dt, false));
+    }
+    m_schema = arrow::schema(fields);
+
+    check(arrow::io::FileOutputStream::Open(m_filename, &m_stream));
+    if (m_format == "stream")
+        check(arrow::ipc::RecordBatchStreamWriter::Open(m_stream.get(),
+            m_schema, &m_writer));
+    else if (m_format == "file")
+        check(arrow::ipc::RecordBatchFileWriter::Open(m_stream.get(),
+            m_schema, &m_writer));
+    else
+        throwError("Invalid 'format' option: '" + m_format + "'.");
+    m_numRows = 0;
+}
+
+
+bool ArrowWriter::processOne(PointRef& point)
+{
+    using Type = Dimension::Type;
+
+    for (DimColumn& col : m_columns)
+    {
+        arrow::ArrayBuilder *b = col.m_builder.get();
+        switch (col.m_type)
+        {
+        case Type::Signed8:
+            check(static_cast<arrow::Int8Builder *>(b)->Append(
+                point.getFieldAs<int8_t>(col.m_id)));
+            break;
+        case Type::Signed16:
+            check(static_cast<arrow::Int16Builder *>(b)->Append(
+                point.getFieldAs<int16_t>(col.m_id)));
+            break;
+        case Type::Signed32:
+            check(static_cast<arrow::Int32Builder *>(b)->Append(
+                point.getFieldAs<int32_t>(col.m_id)));
+            break;
+        case Type::Signed64:
+            check(static_cast<arrow::Int64Builder *>(b)->Append(
+                point.getFieldAs<int64_t>(col.m_id)));
+            break;
+        case Type::Unsigned8:
+            check(static_cast<arrow::UInt8Builder *>(b)->Append(
+                point.getFieldAs<uint8_t>(col.m_id)));
+            break;
+        case Type::Unsigned16:
+            check(static_cast<arrow::UInt16Builder *>(b)->Append(
+                point.getFieldAs<uint16_t>(col.m_id)));
+            break;
+        case Type::Unsigned32:
+            check(static_cast<arrow::UInt32Builder *>(b)->Append(
+                point.getFieldAs<uint32_t>(col.m_id)));
+            break;
+        case Type::Unsigned64:
+            check(static_cast<arrow::UInt64Builder *>(b)->Append(
+                point.getFieldAs<uint64_t>(col.m_id)));
+            break;
+        case Type::Float:
+            check(static_cast<arrow::FloatBuilder *>(b)->Append(
+                point.getFieldAs<float>(col.m_id)));
+            break;
+        case Type::Double:
+            check(static_cast<arrow::DoubleBuilder *>(b)->Append(
+                point.getFieldAs<double>(col.m_id)));
+            break;
+        default:
+            break;
+        }
+    }
+    if (++m_numRows == m_batchSize)
+        flushBatch();
+    return true;
+}
+
+
+// Finish the builders into arrays and emit them as a record batch.  The
+// builders are reusable afterwards - Finish() resets them.
+void ArrowWriter::flushBatch()
+{
+    if (m_numRows == 0)
+        return;
+
+    std::vector<std::shared_ptr<arrow::Array>> arrays;
+    for (DimColumn& col : m_columns)
+    {
+        std::shared_ptr<arrow::Array> array;
+        check(col.m_builder->Finish(&array));
+        arrays.push_back(array);
+    }
+
+    std::shared_ptr<arrow::RecordBatch> batch =
+        arrow::RecordBatch::Make(m_schema, m_numRows, arrays);
+    check(m_writer->WriteRecordBatch(*batch));
+    m_numRows = 0;
+}
+
+
+void ArrowWriter::write(const PointViewPtr view)
+{
+    PointRef point(*view, 0);
+    for (PointId idx = 0; idx < view->size(); ++idx)
+    {
+        point.setPointId(idx);
+        processOne(point);
+    }
+}
+
+
+void ArrowWriter::done(PointTableRef table)
+{
+    flushBatch();
+    if (m_writer)
+        check(m_writer->Close());
+    if (m_stream)
+        check(m_stream->Close());
+    m_writer.reset();
+    m_stream.reset();
+    m_columns.clear();
+}
+
+} // namespace pdal
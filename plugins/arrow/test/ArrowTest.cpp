@@ -0,0 +1,174 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <io/FauxReader.hpp>
+#include <pdal/StageFactory.hpp>
+#include <pdal/util/FileUtils.hpp>
+
+#include "Support.hpp"
+#include "../io/ArrowReader.hpp"
+#include "../io/ArrowWriter.hpp"
+
+namespace pdal
+{
+
+namespace
+{
+
+// Write 'count' ramp points with the given format, read them back and
+// verify the round trip.
+void roundtrip(const std::string& format, point_count_t count,
+    size_t batchSize)
+{
+    std::string outfile = Support::temppath("arrow_test." + format);
+    FileUtils::deleteFile(outfile);
+
+    Options readerOps;
+    readerOps.add("mode", "ramp");
+    readerOps.add("count", count);
+    readerOps.add("bounds", "([0,100],[0,100],[0,100])");
+
+    FauxReader reader;
+    reader.setOptions(readerOps);
+
+    Options writerOps;
+    writerOps.add("filename", outfile);
+    writerOps.add("format", format);
+    writerOps.add("batch_size", batchSize);
+
+    ArrowWriter writer;
+    writer.setOptions(writerOps);
+    writer.setInput(reader);
+
+    PointTable table;
+    writer.prepare(table);
+    writer.execute(table);
+
+    EXPECT_TRUE(FileUtils::fileExists(outfile));
+
+    Options backOps;
+    backOps.add("filename", outfile);
+
+    ArrowReader back;
+    back.setOptions(backOps);
+
+    PointTable table2;
+    back.prepare(table2);
+    PointViewSet viewSet = back.execute(table2);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr view = *viewSet.begin();
+    EXPECT_EQ(view->size(), count);
+
+    for (PointId i = 0; i < view->size(); i += 10)
+    {
+        double expected = 100.0 * i / (count - 1);
+        EXPECT_DOUBLE_EQ(expected,
+            view->getFieldAs<double>(Dimension::Id::X, i));
+        EXPECT_DOUBLE_EQ(expected,
+            view->getFieldAs<double>(Dimension::Id::Y, i));
+        EXPECT_DOUBLE_EQ(expected,
+            view->getFieldAs<double>(Dimension::Id::Z, i));
+    }
+    FileUtils::deleteFile(outfile);
+}
+
+} // unnamed namespace
+
+
+TEST(ArrowTest, findStage)
+{
+    StageFactory factory;
+    Stage* reader(factory.createStage("readers.arrow"));
+    EXPECT_TRUE(reader);
+    Stage* writer(factory.createStage("writers.arrow"));
+    EXPECT_TRUE(writer);
+    EXPECT_TRUE(writer->pipelineStreamable());
+}
+
+
+// Batch size smaller than the point count so multiple record batches
+// get written and read.
+TEST(ArrowTest, roundtripFile)
+{
+    roundtrip("file", 1001, 100);
+}
+
+
+TEST(ArrowTest, roundtripStream)
+{
+    roundtrip("stream", 1001, 100);
+}
+
+
+TEST(ArrowTest, streamMode)
+{
+    std::string outfile = Support::temppath("arrow_stream_test.file");
+    FileUtils::deleteFile(outfile);
+
+    Options readerOps;
+    readerOps.add("mode", "ramp");
+    readerOps.add("count", 1001);
+    readerOps.add("bounds", "([0,100],[0,100],[0,100])");
+
+    FauxReader reader;
+    reader.setOptions(readerOps);
+
+    Options writerOps;
+    writerOps.add("filename", outfile);
+
+    ArrowWriter writer;
+    writer.setOptions(writerOps);
+    writer.setInput(reader);
+
+    FixedPointTable table(50);
+    writer.prepare(table);
+    writer.execute(table);
+
+    Options backOps;
+    backOps.add("filename", outfile);
+
+    ArrowReader back;
+    back.setOptions(backOps);
+
+    PointTable table2;
+    back.prepare(table2);
+    PointViewSet viewSet = back.execute(table2);
+    PointViewPtr view = *viewSet.begin();
+    EXPECT_EQ(view->size(), 1001u);
+    FileUtils::deleteFile(outfile);
+}
+
+} // namespace pdal
@@ -36,6 +36,9 @@
 #include "Utils.hpp"
 #include "arbiter/arbiter.hpp"
 #include <pdal/util/Algorithm.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+#include <thread>
 
 namespace pdal
 {
@@ -63,6 +66,8 @@ void E57Reader::addArgs(ProgramArgs& args)
 {
     args.add("extra_dims", "Extra dimensions to read from E57 point cloud.",
              m_extraDimsSpec);
+    args.add("threads", "Number of worker threads used to read scans in "
+             "parallel.  0 means the hardware concurrency.", m_threads);
 }
 
 void E57Reader::initializeBuffers()
@@ -70,14 +75,22 @@ void E57Reader::initializeBuffers()
     m_doubleBuffers.clear();
     m_destBuffers.clear();
     m_e57PointPrototype.reset(new StructureNode(m_scan->getPointPrototype()));
+    buildBuffers(*m_imf, *m_e57PointPrototype, m_doubleBuffers, m_destBuffers);
+}
 
+/// Size read buffers for every supported and extra dimension present in
+/// the prototype and link them to libE57 destination buffers.
+void E57Reader::buildBuffers(e57::ImageFile& imf, e57::StructureNode& proto,
+    std::map<std::string, std::vector<double>>& doubleBuffers,
+    std::vector<e57::SourceDestBuffer>& destBuffers)
+{
     // Initialize for supported dimensions.
     auto supportedFields = e57plugin::supportedE57Types();
     for (auto& dimension : supportedFields)
     {
-        if (m_e57PointPrototype->isDefined(dimension))
+        if (proto.isDefined(dimension))
         {
-            m_doubleBuffers[dimension] =
+            doubleBuffers[dimension] =
                 std::vector<double>(m_defaultChunkSize, 0);
         }
     }
@@ -85,20 +98,20 @@ void E57Reader::initializeBuffers()
     // Initialize for extra dimensions.
     for (auto i = m_extraDims->begin(); i != m_extraDims->end(); ++i)
     {
-        if (m_e57PointPrototype->isDefined(i->m_name))
+        if (proto.isDefined(i->m_name))
         {
-            m_doubleBuffers[i->m_name] =
+            doubleBuffers[i->m_name] =
                 std::vector<double>(m_defaultChunkSize, 0);
         }
     }
 
     // Link to destination buffers.
-    for (auto& keyValue : m_doubleBuffers)
+    for (auto& keyValue : doubleBuffers)
     {
-        m_destBuffers.emplace_back(
-            *m_imf, keyValue.first, keyValue.second.data(), m_defaultChunkSize,
+        destBuffers.emplace_back(
+            imf, keyValue.first, keyValue.second.data(), m_defaultChunkSize,
             true,
-            (m_e57PointPrototype->get(keyValue.first).type() ==
+            (proto.get(keyValue.first).type() ==
              e57::E57_SCALED_INTEGER));
     }
 }
@@ -169,7 +182,8 @@ void E57Reader::initialize()
     {
         arbiter::Arbiter arb;
         arbiter::LocalHandle fileHandle = arb.getLocalHandle(m_filename);
-        m_imf.reset(new ImageFile(fileHandle.localPath(), "r"));
+        m_localPath = fileHandle.localPath();
+        m_imf.reset(new ImageFile(m_localPath, "r"));
         StructureNode root = m_imf->root();
 
         if (!root.isDefined("/data3D"))
@@ -204,7 +218,7 @@ void E57Reader::ready(PointTableRef& ref)
     
     m_currentIndex = 0;
     m_pointsInCurrentBatch = 0;
-    m_defaultChunkSize = 10000;
+    m_defaultChunkSize = 65536;
     m_currentScan = -1;
     
     // Initial reader setup.
@@ -299,41 +313,108 @@ bool E57Reader::fillPoint(PointRef& point)
         return false;
     }
 
-    for (auto& keyValue : m_doubleBuffers)
+    copyPoint(point, *m_scan, m_doubleBuffers, m_currentIndex);
+
+    ++m_currentIndex;
+    return true;
+}
+
+/// Copy one decoded point out of the read buffers, rescaling and applying
+/// the scan pose as needed.
+void E57Reader::copyPoint(PointRef& point, e57::Scan& scan,
+    const std::map<std::string, std::vector<double>>& buffers, size_t idx)
+{
+    for (auto& keyValue : buffers)
     {
         auto dim = e57plugin::e57ToPdal(keyValue.first);
 
         if (dim != Dimension::Id::Unknown)
         {
-            point.setField(dim, m_scan->rescale(dim, keyValue.second[m_currentIndex]));
+            point.setField(dim, scan.rescale(dim, keyValue.second[idx]));
         }
         else
         {
-            auto dim = m_extraDims->findDim(keyValue.first);
-            if (dim != m_extraDims->end())
+            auto extra = m_extraDims->findDim(keyValue.first);
+            if (extra != m_extraDims->end())
             {
-                point.setField(dim->m_id, keyValue.second[m_currentIndex]);
+                point.setField(extra->m_id, keyValue.second[idx]);
             }
         }
     }
 
-    if (m_scan->hasPose())
-        m_scan->transformPoint(point);
+    if (scan.hasPose())
+        scan.transformPoint(point);
+}
 
-    ++m_currentIndex;
-    return true;
+/// Read one Data3D scan into the view.  Each worker opens its own
+/// ImageFile so no libE57 state is shared across threads; the view lock
+/// covers only the copy out of the decoded batch.
+void E57Reader::readScan(int scanIndex, PointView& view)
+{
+    ImageFile imf(m_localPath, "r");
+
+    e57::ustring normalsExtension;
+    if (!imf.extensionsLookupPrefix("nor", normalsExtension))
+        imf.extensionsAdd("nor",
+            "http://www.libe57.org/E57_NOR_surface_normals.txt");
+
+    StructureNode root = imf.root();
+    VectorNode data3D(root.get("/data3D"));
+    Scan scan((StructureNode)data3D.get(scanIndex));
+    StructureNode proto(scan.getPointPrototype());
+
+    std::map<std::string, std::vector<double>> doubleBuffers;
+    std::vector<SourceDestBuffer> destBuffers;
+    buildBuffers(imf, proto, doubleBuffers, destBuffers);
+
+    CompressedVectorReader reader = scan.getPoints().reader(destBuffers);
+    while (point_count_t gotPoints = reader.read(destBuffers))
+    {
+        std::lock_guard<std::mutex> lock(m_viewMutex);
+        for (point_count_t i = 0; i < gotPoints; ++i)
+        {
+            PointRef point(view.point(view.size()));
+            copyPoint(point, scan, doubleBuffers, i);
+        }
+    }
+    reader.close();
+    imf.close();
 }
 
 point_count_t E57Reader::read(PointViewPtr view, point_count_t count)
 {
-    point_count_t numPoints = e57plugin::numPoints(*m_data3D);
-    for (PointId counter = 0, nextId = view->size(); counter < numPoints;
-            ++counter, ++nextId)
+    auto numScans = m_data3D->childCount();
+    std::size_t threads(m_threads ? m_threads :
+        std::thread::hardware_concurrency());
+    threads = (std::min)(threads, (std::size_t)numScans);
+
+    if (threads < 2)
     {
-        PointRef point(view->point(nextId));
-        fillPoint(point);
+        point_count_t numPoints = e57plugin::numPoints(*m_data3D);
+        for (PointId counter = 0, nextId = view->size(); counter < numPoints;
+                ++counter, ++nextId)
+        {
+            PointRef point(view->point(nextId));
+            fillPoint(point);
+        }
+
+        return view->size();
     }
 
+    // Decode each scan on its own worker.  Points land in the view
+    // batch-by-batch as scans complete, so their order can differ from a
+    // sequential read.
+    ThreadPool pool(threads);
+    for (int64_t i = 0; i < numScans; ++i)
+        pool.add([this, i, &view]()
+        {
+            readScan((int)i, *view);
+        });
+    pool.await();
+    pool.join();
+    if (pool.errors().size())
+        throwError(pool.errors().front());
+
     return view->size();
 }
 
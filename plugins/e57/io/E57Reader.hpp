@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
 #include "Scan.hpp"
@@ -63,6 +65,12 @@ private:
     point_count_t readNextBatch();
     void setupReader();
     void initializeBuffers();
+    void buildBuffers(e57::ImageFile& imf, e57::StructureNode& proto,
+        std::map<std::string, std::vector<double>>& doubleBuffers,
+        std::vector<e57::SourceDestBuffer>& destBuffers);
+    void copyPoint(PointRef& point, e57::Scan& scan,
+        const std::map<std::string, std::vector<double>>& buffers, size_t idx);
+    void readScan(int scanIndex, PointView& view);
 
     std::unique_ptr<e57::ImageFile> m_imf;
     std::unique_ptr<e57::VectorNode> m_data3D;
@@ -77,6 +85,9 @@ private:
     point_count_t m_pointsInCurrentBatch;
     point_count_t m_defaultChunkSize;
     signed int m_currentScan;
+    uint16_t m_threads;
+    std::string m_localPath;
+    std::mutex m_viewMutex;
 
     pdal::StringList m_extraDimsSpec;
     std::unique_ptr<e57plugin::ExtraDims> m_extraDims;
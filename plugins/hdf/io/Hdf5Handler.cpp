@@ -74,35 +74,130 @@ void Handler::initialize(
             throw pdal_error("All given datasets must have the same length");
         }
     }
+
+    // Points are pulled in blocks sized to a multiple of the largest
+    // dataset chunk, so block reads stay chunk-aligned.  A small floor
+    // keeps blocks worth prefetching even for tiny chunks.
+    hsize_t maxChunk = 1;
+    for( DimInfo& info : m_dimInfos)
+        maxChunk = std::max(maxChunk, info.getChunkSize());
+    const hsize_t minBlock = 65536;
+    m_blockSize = ((minBlock + maxChunk - 1) / maxChunk) * maxChunk;
+
+    for( DimInfo& info : m_dimInfos)
+        info.resizeBuffers(m_blockSize);
+    m_blockLower = 0;
+    m_blockUpper = 0;
+}
+
+
+Handler::~Handler()
+{
+    if (m_prefetch.joinable())
+        m_prefetch.join();
 }
 
 
 void Handler::close()
 {
+    if (m_prefetch.joinable())
+        m_prefetch.join();
     m_h5File->close();
 }
 
 
-uint8_t *DimInfo::getValue(pdal::point_count_t pointIndex) {
-    if(pointIndex < chunkLowerBound || pointIndex >= chunkUpperBound) {
-        // load new chunk
-        H5::DataSpace dspace = m_dset.getSpace();
+/// Read the block starting at lower into every dataset's back buffer.
+void Handler::loadBlock(hsize_t lower)
+{
+    hsize_t upper = std::min(lower + m_blockSize, m_numPoints);
+    for( DimInfo& info : m_dimInfos)
+        info.readBlock(lower, upper);
+}
 
-        chunkLowerBound = (pointIndex / m_chunkSize) * m_chunkSize;
-        chunkUpperBound = std::min(chunkLowerBound + m_chunkSize, m_numPoints);
 
-        hsize_t selectionSize = chunkUpperBound - chunkLowerBound;
+/// Make the block holding pointIndex current.  Sequential reads land on
+/// the block the prefetch thread loaded while the previous one was being
+/// assembled; anything else falls back to a synchronous load.  HDF5
+/// calls run on one thread at a time - the prefetch thread between
+/// spawn and join, this thread otherwise - so no library locking is
+/// assumed.
+void Handler::advanceBlock(pdal::point_count_t pointIndex)
+{
+    hsize_t lower = (pointIndex / m_blockSize) * m_blockSize;
+
+    if (m_prefetch.joinable())
+    {
+        m_prefetch.join();
+        if (m_prefetchError)
+            std::rethrow_exception(m_prefetchError);
+        if (m_nextLower != lower)
+            loadBlock(lower);
+    }
+    else
+        loadBlock(lower);
 
-        H5::DataSpace memspace(1, &selectionSize);
-        dspace.selectHyperslab(H5S_SELECT_SET, &selectionSize, &chunkLowerBound);
-        m_dset.read(m_buffer.data(),
-                    m_dset.getDataType(),
-                    memspace,
-                    dspace );
+    for( DimInfo& info : m_dimInfos)
+        info.swapBuffers();
+    m_blockLower = lower;
+    m_blockUpper = std::min(lower + m_blockSize, m_numPoints);
 
+    if (m_blockUpper < m_numPoints)
+    {
+        m_nextLower = m_blockUpper;
+        hsize_t next = m_nextLower;
+        m_prefetch = std::thread([this, next]()
+        {
+            try
+            {
+                loadBlock(next);
+            }
+            catch (...)
+            {
+                m_prefetchError = std::current_exception();
+            }
+        });
     }
-    hsize_t pointOffsetWithinChunk = pointIndex - chunkLowerBound;
-    return m_buffer.data() + pointOffsetWithinChunk * m_size;
+}
+
+
+uint8_t *Handler::getValue(DimInfo& dim, pdal::point_count_t pointIndex)
+{
+    if (pointIndex < m_blockLower || pointIndex >= m_blockUpper)
+        advanceBlock(pointIndex);
+    return dim.value(pointIndex - m_blockLower);
+}
+
+
+void DimInfo::resizeBuffers(hsize_t blockSize)
+{
+    m_buffer.resize(blockSize * m_size);
+    m_backBuffer.resize(blockSize * m_size);
+}
+
+
+void DimInfo::readBlock(hsize_t lower, hsize_t upper)
+{
+    H5::DataSpace dspace = m_dset.getSpace();
+    hsize_t selectionSize = upper - lower;
+
+    H5::DataSpace memspace(1, &selectionSize);
+    dspace.selectHyperslab(H5S_SELECT_SET, &selectionSize, &lower);
+    m_dset.read(m_backBuffer.data(),
+                m_dset.getDataType(),
+                memspace,
+                dspace );
+}
+
+
+void DimInfo::swapBuffers()
+{
+    m_buffer.swap(m_backBuffer);
+}
+
+
+uint8_t *DimInfo::value(hsize_t offsetInBlock)
+{
+    return m_buffer.data() + offsetInBlock * m_size;
 }
 
 
@@ -128,17 +223,6 @@ DimInfo::DimInfo(
                 "this should never happen, and it's probably a PDAL bug.");     
         m_numPoints = (hsize_t) dspace.getSelectNpoints();
 
-        // check if dataset is 'chunked'
-        H5::DSetCreatPropList plist = m_dset.getCreatePlist();
-        if(plist.getLayout() == H5D_CHUNKED) {
-            int dimensionality = plist.getChunk(1, &m_chunkSize); //modifies m_chunkSize
-            if(dimensionality != 1)
-                throw pdal_error("Only 1-dimensional arrays are supported.");
-        } else {
-            //if dataset is not chunked, use an arbitrary number for buffer size
-            m_chunkSize = 1024; // completely arbitrary number
-        }
-
         // populate fields base on HDF type
         H5T_class_t vague_type = m_dset.getDataType().getClass();
 
@@ -161,8 +245,25 @@ DimInfo::DimInfo(
                 "unsupported type. Only integer and float types are supported.");
         }
 
-        //allocate buffer for getValue() to write into
-        m_buffer.resize(m_chunkSize*m_size);
+        // check if dataset is 'chunked'
+        H5::DSetCreatPropList plist = m_dset.getCreatePlist();
+        if(plist.getLayout() == H5D_CHUNKED) {
+            int dimensionality = plist.getChunk(1, &m_chunkSize); //modifies m_chunkSize
+            if(dimensionality != 1)
+                throw pdal_error("Only 1-dimensional arrays are supported.");
+
+            // Reopen the dataset with a chunk cache that holds several
+            // whole chunks, so block reads that straddle a chunk edge
+            // don't force rereads.  w0 is 1 since a fully read chunk
+            // never pays to stay cached.
+            H5::DSetAccPropList dapl;
+            dapl.setChunkCache(521, m_chunkSize * m_size * 4, 1.0);
+            m_dset.close();
+            m_dset = file->openDataSet(datasetName, dapl);
+        } else {
+            //if dataset is not chunked, use an arbitrary number for buffer size
+            m_chunkSize = 1024; // completely arbitrary number
+        }
     }
 
 
@@ -195,5 +296,10 @@ hsize_t DimInfo::getNumPoints() {
     return m_numPoints;
 }
 
+
+hsize_t DimInfo::getChunkSize() {
+    return m_chunkSize;
+}
+
 } // namespace pdal
 
@@ -40,7 +40,9 @@
 #include "H5Cpp.h"
 #include <nlohmann/json.hpp>
 
+#include <exception>
 #include <memory>
+#include <thread>
 #include <vector>
 #include <string>
 #include <map>
@@ -59,7 +61,10 @@ public:
         const std::string& datasetName,
         H5::H5File *file);
 
-    uint8_t *getValue(pdal::point_count_t pointIndex);
+    void resizeBuffers(hsize_t blockSize);
+    void readBlock(hsize_t lower, hsize_t upper);
+    void swapBuffers();
+    uint8_t *value(hsize_t offsetInBlock);
     //setters
     void setId(Dimension::Id id);
     //getters
@@ -67,15 +72,17 @@ public:
     Dimension::Type getPdalType();
     std::string getName();
     hsize_t getNumPoints();
+    hsize_t getChunkSize();
 
 private:
+    // Double buffers: value() reads the front one while the prefetch
+    // thread fills the back one for the next block.
     std::vector<uint8_t> m_buffer;
+    std::vector<uint8_t> m_backBuffer;
     std::string m_name;
     Dimension::Type m_pdalType;
     Dimension::Id m_pdalId = Dimension::Id::Unknown;
-    hsize_t chunkUpperBound = 0,
-            chunkLowerBound = 0,
-            m_numPoints = 0,
+    hsize_t m_numPoints = 0,
             m_chunkSize;
     H5::DataSet m_dset;
     size_t m_size;
@@ -84,6 +91,8 @@ private:
 class Handler
 {
 public:
+    ~Handler();
+
     void initialize(
             const std::string& filename,
             const std::map<std::string,std::string>& map);
@@ -91,16 +100,28 @@ public:
 
     hsize_t getNumPoints() const;
     std::vector<pdal::hdf5::DimInfo>& getDimensions();
+    uint8_t *getValue(DimInfo& dim, pdal::point_count_t pointIndex);
 
     void setLog(pdal::LogPtr log);
 
 private:
+    void loadBlock(hsize_t lower);
+    void advanceBlock(pdal::point_count_t pointIndex);
+
     std::vector<pdal::hdf5::DimInfo> m_dimInfos;
 
     pdal::LogPtr m_logger;
 
     std::unique_ptr<H5::H5File> m_h5File;
     hsize_t m_numPoints = 0;
+
+    // Block cursor for the double-buffered reads; see advanceBlock().
+    hsize_t m_blockSize = 0;
+    hsize_t m_blockLower = 0;
+    hsize_t m_blockUpper = 0;
+    hsize_t m_nextLower = 0;
+    std::thread m_prefetch;
+    std::exception_ptr m_prefetchError;
 };
 
 } //namespace hdf5
@@ -89,7 +89,7 @@ point_count_t HdfReader::read(PointViewPtr view, point_count_t count)
 
     for(uint64_t pi = 0; pi < m_hdf5Handler->getNumPoints(); pi++) {
         for(hdf5::DimInfo& dim : m_hdf5Handler->getDimensions()) {
-            uint8_t *p = dim.getValue(pi);
+            uint8_t *p = m_hdf5Handler->getValue(dim, pi);
             view->setField(dim.getId(), dim.getPdalType(), nextId, (void*) p);
         }
         m_index++;
@@ -103,7 +103,7 @@ point_count_t HdfReader::read(PointViewPtr view, point_count_t count)
 bool HdfReader::processOne(PointRef& point)
 {
     for(hdf5::DimInfo& dim : m_hdf5Handler-> getDimensions()) {
-        uint8_t *p = dim.getValue(m_index);
+        uint8_t *p = m_hdf5Handler->getValue(dim, m_index);
         point.setField(dim.getId(), dim.getPdalType(), p);
     }
 
@@ -355,25 +355,33 @@ point_count_t EsriReader::read(PointViewPtr view, point_count_t count)
     log()->get(LogLevel::Debug) << "Traversing metadata" << std::endl;
     traverseTree(initJson, 0, nodes, 0, 0);
 
-    // Create view with overlapping nodes at desired depth
-    // Will create a thread pool on the createview class and iterate
-    // through the node list for the nodes to be pulled.
+    // Create view with overlapping nodes at desired depth.
+    // One pool keeps node fetches in flight while a second decodes the
+    // fetched binaries into the view.  The decode queue is bounded, so
+    // fetchers stall instead of piling up raw node data without limit.
     log()->get(LogLevel::Debug) << "Fetching binaries" << std::endl;
-    Pool p(m_args.threads);
+    std::size_t decodeThreads = std::thread::hardware_concurrency();
+    Pool fetchPool(m_args.threads);
+    Pool decodePool(decodeThreads, 2 * decodeThreads);
     for (std::size_t i = 0; i < nodes.size(); i++)
     {
         log()->get(LogLevel::Debug) << "\r" << i << "/" << nodes.size();
         std::string localUrl;
 
         localUrl = m_filename + "/nodes/" + std::to_string(nodes[i]);
-        int nodeIndex(nodes[i]);
 
-        p.add([localUrl, nodeIndex, this, &view]()
+        fetchPool.add([localUrl, this, &decodePool, &view]()
         {
-            createView(localUrl, nodeIndex, *view);
+            auto node = std::make_shared<NodeBundle>(fetchNode(localUrl));
+            decodePool.add([node, this, &view]()
+            {
+                processNode(*node, *view);
+            });
         });
     }
-    p.await();
+    // All decode tasks have been queued once the fetchers are done.
+    fetchPool.await();
+    decodePool.await();
     return view->size();
 }
 
@@ -499,16 +507,42 @@ BOX3D EsriReader::createCube(const NL::json& base)
 }
 
 
-void EsriReader::createView(std::string localUrl, int nodeIndex,
-    PointView& view)
+// Pull the geometry and attribute binaries for one node.  Runs on the
+// fetch pool; no decoding happens here.
+EsriReader::NodeBundle EsriReader::fetchNode(const std::string& localUrl) const
 {
+    NodeBundle node;
+
     // pull the geometries to start
     const std::string geomUrl = localUrl + "/geometries/";
-    auto xyzFetch = fetchBinary(geomUrl, "0", ".bin.pccxyz");
+    node.xyz = fetchBinary(geomUrl, "0", ".bin.pccxyz");
+
+    //the extensions seen in this part correspond with slpk
+    const std::string attrUrl = localUrl + "/attributes/";
+    for (const auto& dimEntry : m_dimMap)
+    {
+        const Dimension::Id dimId(dimEntry.first);
+        const std::string key(std::to_string(dimEntry.second.key));
+
+        if (dimId == Dimension::Id::Red)
+            node.attrs[dimId] = fetchBinary(attrUrl, key, ".bin.pccrgb");
+        else if (dimId == Dimension::Id::Intensity)
+            node.attrs[dimId] = fetchBinary(attrUrl, key, ".bin.pccint");
+        else
+            node.attrs[dimId] = fetchBinary(attrUrl, key, ".bin.gz");
+    }
+    return node;
+}
+
+
+// Decode a fetched node and write its points into the view.  Runs on the
+// decode pool.
+void EsriReader::processNode(NodeBundle& node, PointView& view)
+{
     std::vector<lepcc::Point3D> xyz;
     try
     {
-        xyz = EsriUtil::decompressXYZ(&xyzFetch);
+        xyz = EsriUtil::decompressXYZ(&node.xyz);
     }
     catch (const EsriUtil::decompression_error& e)
     {
@@ -540,20 +574,15 @@ void EsriReader::createView(std::string localUrl, int nodeIndex,
         }
     }
 
-    const std::string attrUrl = localUrl + "/attributes/";
-
-    //the extensions seen in this part correspond with slpk
     for (const auto& dimEntry : m_dimMap)
     {
         const Dimension::Id dimId(dimEntry.first);
         const Dimension::Type dimType(dimEntry.second.dimType);
-        const uint64_t key(dimEntry.second.key);
         const std::string name(dimEntry.second.name);
 
         if (dimId == Dimension::Id::Red)
         {
-            auto data = fetchBinary(
-                    attrUrl, std::to_string(key), ".bin.pccrgb");
+            std::vector<char>& data = node.attrs[dimId];
             std::vector<lepcc::RGB_t> rgbPoints;
             try
             {
@@ -584,8 +613,7 @@ void EsriReader::createView(std::string localUrl, int nodeIndex,
         }
         else if (dimId == Dimension::Id::Intensity)
         {
-            auto data = fetchBinary(attrUrl, std::to_string(key),
-                    ".bin.pccint");
+            std::vector<char>& data = node.attrs[dimId];
 
             std::vector<uint16_t> intensity;
             try
@@ -612,9 +640,7 @@ void EsriReader::createView(std::string localUrl, int nodeIndex,
         }
         else if (dimId == Dimension::Id::NumberOfReturns)
         {
-
-            const std::vector<char> data = fetchBinary(
-                    attrUrl, std::to_string(key), ".bin.gz");
+            const std::vector<char>& data = node.attrs[dimId];
 
             const uint8_t* returnData =
                 reinterpret_cast<const uint8_t*> (data.data());
@@ -640,8 +666,7 @@ void EsriReader::createView(std::string localUrl, int nodeIndex,
         }
         else
         {
-            const auto data = fetchBinary(
-                    attrUrl, std::to_string(key), ".bin.gz");
+            const std::vector<char>& data = node.attrs[dimId];
 
             std::size_t dimSize = Dimension::size(dimType);
 
@@ -166,6 +166,14 @@ protected:
         Dimension::Type dimType;
         std::string name;
     };
+
+    // Raw binaries for one node, fetched ahead of decode so HTTP round
+    // trips and lepcc decompression run on separate pools.
+    struct NodeBundle
+    {
+        std::vector<char> xyz;
+        std::map<Dimension::Id, std::vector<char>> attrs;
+    };
     std::map<Dimension::Id, dimData> m_dimMap;
     std::map<int, NL::json> m_nodepages;
 
@@ -175,7 +183,8 @@ protected:
     virtual void ready(PointTableRef table) override;
     virtual point_count_t read(PointViewPtr view, point_count_t count) override;
     virtual void done(PointTableRef table) override;
-    void createView(std::string localUrl, int nodeIndex,  PointView& view);
+    NodeBundle fetchNode(const std::string& localUrl) const;
+    void processNode(NodeBundle& node, PointView& view);
     BOX3D createCube(const NL::json& base);
     BOX3D parseBox(const NL::json& base);
     void traverseTree(NL::json page, int index, std::vector<int>& nodes,
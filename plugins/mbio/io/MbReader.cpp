@@ -61,7 +61,15 @@ MbReader::MbReader() : m_bath(nullptr), m_bathlon(nullptr),
 
 
 MbReader::~MbReader()
-{}
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_produceCv.notify_all();
+    if (m_producer.joinable())
+        m_producer.join();
+}
 
 
 void MbReader::addArgs(ProgramArgs& args)
@@ -130,6 +138,12 @@ void MbReader::ready(PointTableRef table)
         (void **)&m_sslon, &error);
     mb_register_array(verbose, m_ctx, 3, sizeof(double),
         (void **)&m_sslat, &error);
+
+    m_sharedCount = 0;
+    m_producerDone = false;
+    m_stop = false;
+    m_readError = nullptr;
+    m_producer = std::thread([this]() { produceLoop(); });
 }
 
 namespace
@@ -298,38 +312,112 @@ bool MbReader::extractSidescan(int numSs, double gpsTime)
 }
 
 
+/// Read and extract pings on the producer thread until the reader stops
+/// or input runs out, publishing each extracted batch for the pipeline
+/// thread.
+void MbReader::produceLoop()
+{
+    try
+    {
+        while (!m_stop && loadData())
+            publish();
+    }
+    catch (...)
+    {
+        m_readError = std::current_exception();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_producerDone = true;
+    }
+    m_consumeCv.notify_all();
+}
+
+
+/// Move the staged ping from the extraction queues into the shared
+/// batch, waiting while the consumer is more than a batch bound behind.
+void MbReader::publish()
+{
+    const size_t maxQueued = 262144;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_produceCv.wait(lock, [this, maxQueued]()
+        { return m_sharedCount < maxQueued || m_stop; });
+    if (m_stop)
+        return;
+    while (!m_bathQueue.empty())
+    {
+        m_bathShared.push_back(m_bathQueue.front());
+        m_bathQueue.pop();
+    }
+    while (!m_ssQueue.empty())
+    {
+        m_ssShared.push_back(m_ssQueue.front());
+        m_ssQueue.pop();
+    }
+    m_sharedCount = m_bathShared.size() + m_ssShared.size();
+    lock.unlock();
+    m_consumeCv.notify_one();
+}
+
+
+/// Swap published points into the consumer-side queues.  Returns false
+/// only at end of input; a producer error is rethrown here on the
+/// pipeline thread.
+bool MbReader::fetchBatch()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_consumeCv.wait(lock, [this]()
+        { return m_sharedCount || m_producerDone; });
+    m_bathLocal.swap(m_bathShared);
+    m_ssLocal.swap(m_ssShared);
+    bool got = m_sharedCount > 0;
+    m_sharedCount = 0;
+    lock.unlock();
+    m_produceCv.notify_one();
+
+    if (!got)
+    {
+        if (m_readError)
+            std::rethrow_exception(m_readError);
+        return false;
+    }
+    return true;
+}
+
+
 bool MbReader::processOne(PointRef& point)
 {
     if (m_dataType == DataType::Multibeam)
     {
-        if (m_bathQueue.empty())
-            if (!loadData())
+        if (m_bathLocal.empty())
+            if (!fetchBatch())
             {
                 return false;
             }
 
-        BathData& bd = m_bathQueue.front();
+        BathData& bd = m_bathLocal.front();
 
         point.setField(Dimension::Id::X, bd.m_bathlon);
         point.setField(Dimension::Id::Y, bd.m_bathlat);
         point.setField(Dimension::Id::Z, bd.m_bath);
         point.setField(Dimension::Id::GpsTime, bd.m_time);
         point.setField(Dimension::Id::Amplitude, bd.m_amp);
-        m_bathQueue.pop();
+        m_bathLocal.pop_front();
     }
     else // Sidescan
     {
-        if (m_ssQueue.empty())
-            if (!loadData())
+        if (m_ssLocal.empty())
+            if (!fetchBatch())
                 return false;
 
-        SidescanData& ss = m_ssQueue.front();
+        SidescanData& ss = m_ssLocal.front();
 
         point.setField(Dimension::Id::X, ss.m_sslon);
         point.setField(Dimension::Id::Y, ss.m_sslat);
         point.setField(Dimension::Id::GpsTime, ss.m_time);
         point.setField(Dimension::Id::Intensity, ss.m_ss);
-        m_ssQueue.pop();
+        m_ssLocal.pop_front();
     }
     return true;
 }
@@ -370,6 +458,14 @@ void MbReader::done(PointTableRef table)
 {
     int error;
 
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_produceCv.notify_all();
+    if (m_producer.joinable())
+        m_producer.join();
+
     mb_close(0, &m_ctx, &error);
     getMetadata().addList("filename", m_filename);
 }
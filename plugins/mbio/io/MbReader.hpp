@@ -34,7 +34,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
 #include <queue>
+#include <thread>
 
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
@@ -107,6 +113,9 @@ private:
     bool loadData();
     bool extractMultibeam(int numBath, int numAmp, double time);
     bool extractSidescan(int numSs, double time);
+    void produceLoop();
+    void publish();
+    bool fetchBatch();
 
     friend std::istream& operator>>(std::istream& in,
         MbReader::DataType& mode);
@@ -128,6 +137,23 @@ private:
     double m_timegap;
     double m_speedmin;
     DataType m_dataType;
+
+    // mb_read() runs on a producer thread that stages pings into
+    // m_bathQueue/m_ssQueue and publishes them in batches; the pipeline
+    // thread swaps published batches into the local queues.  The single
+    // producer keeps ping order.
+    std::thread m_producer;
+    std::mutex m_mutex;
+    std::condition_variable m_consumeCv;
+    std::condition_variable m_produceCv;
+    std::deque<BathData> m_bathShared;
+    std::deque<SidescanData> m_ssShared;
+    std::deque<BathData> m_bathLocal;
+    std::deque<SidescanData> m_ssLocal;
+    size_t m_sharedCount;
+    bool m_producerDone;
+    std::atomic<bool> m_stop;
+    std::exception_ptr m_readError;
 };
 
 } // namespace PDAL
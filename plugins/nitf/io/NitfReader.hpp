@@ -110,6 +110,7 @@ class PDAL_DLL NitfReader : public LasReader
         NitfStreamIf(const std::string& filename, ShiftStream::off_type off)
         {
             m_istream = new ShiftStream(filename, off);
+            m_fileOffset = off;
         }
 
         virtual ~NitfStreamIf()
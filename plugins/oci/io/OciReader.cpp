@@ -274,35 +274,56 @@ point_count_t OciReader::readDimMajor(PointView& view, BlockPtr block,
 {
     using namespace Dimension;
 
-    point_count_t numRemaining = block->numRemaining();
     PointId startId = view.size();
-    point_count_t blockRemaining = numRemaining;
-    point_count_t numRead = 0;
+    point_count_t numRead =
+        (std::min)(numPts, (point_count_t)block->numRemaining());
+
+    // The batched stores require their target range to exist.
+    for (point_count_t i = 0; i < numRead; ++i)
+        view.getOrAddPoint(startId + i);
 
+    bool sawPointSourceId = false;
+    std::vector<double> xyz(numRead);
     DimTypeList dims = dbDimTypes();
     for (auto di = dims.begin(); di != dims.end(); ++di)
     {
-        PointId nextId = startId;
         char *pos = seekDimMajor(*di, block);
-        blockRemaining = numRemaining;
-        numRead = 0;
-        while (numRead < numPts && blockRemaining > 0)
+
+        if (di->m_id == Id::X || di->m_id == Id::Y || di->m_id == Id::Z)
         {
-            writeField(view, pos, *di, nextId);
-            pos += Dimension::size(di->m_type);
+            size_t size = Dimension::size(di->m_type);
+            double scale = di->m_xform.m_scale.m_val;
+            double shift = di->m_xform.m_offset.m_val;
+            for (point_count_t i = 0; i < numRead; ++i)
+            {
+                Everything e;
+
+                memcpy(&e, pos, size);
+                xyz[i] = (Utils::toDouble(e, di->m_type) * scale) + shift;
+                pos += size;
+            }
+            view.setFieldBatch(di->m_id, startId, numRead, xyz.data());
+        }
+        else
+        {
+            // A dimension-major block holds each dimension as a
+            // contiguous column, which is exactly what the batched
+            // store consumes - no per-point swizzling needed.
+            view.setFieldBatch(di->m_id, di->m_type, startId, numRead, pos);
+            if (di->m_id == Id::PointSourceId)
+                sawPointSourceId = true;
+        }
+    }
 
-            if (di->m_id == Id::PointSourceId && m_updatePointSourceId)
-                view.setField(Id::PointSourceId, nextId, block->obj_id);
+    if (sawPointSourceId && m_updatePointSourceId)
+        for (point_count_t i = 0; i < numRead; ++i)
+            view.setField(Id::PointSourceId, startId + i, block->obj_id);
 
-            if (m_cb && di == dims.rbegin().base() - 1)
-                m_cb(view, nextId);
+    if (m_cb)
+        for (point_count_t i = 0; i < numRead; ++i)
+            m_cb(view, startId + i);
 
-            nextId++;
-            numRead++;
-            blockRemaining--;
-        }
-    }
-    block->setNumRemaining(blockRemaining);
+    block->setNumRemaining(block->numRemaining() - numRead);
     return numRead;
 }
 
@@ -336,18 +357,11 @@ point_count_t OciReader::readPointMajor(PointView& view,
     {
         char *pos = seekPointMajor(block);
 
-        size_t cnt = block->numRemaining();
-        while (numRead < numPts && cnt--)
-        {
-            writePoint(view, nextId, pos);
-
-            if (m_cb)
-                m_cb(view, nextId);
-
-            pos += packedPointSize();
-            nextId++;
-            numRead++;
-        }
+        numRead = (std::min)(numPts, (point_count_t)block->numRemaining());
+        writeBlock(view, nextId, pos, numRead);
+        if (m_cb)
+            for (point_count_t i = 0; i < numRead; ++i)
+                m_cb(view, nextId + i);
     }
     block->setNumRemaining(block->numRemaining() - numRead);
     return numRead;
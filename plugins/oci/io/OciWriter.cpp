@@ -772,14 +772,8 @@ void OciWriter::writePointMajor(PointViewPtr view, std::vector<char>& outbuf)
     }
     else
     {
-        size_t totalSize = 0;
-        char *pos = outbuf.data();
-        for (PointId idx = 0; idx < view->size(); ++idx)
-        {
-            size_t size = readPoint(*view.get(), idx, pos);
-            totalSize += size;
-            pos += size;
-        }
+        size_t totalSize =
+            readBlock(*view.get(), 0, view->size(), outbuf.data());
         outbuf.resize(totalSize);
     }
 }
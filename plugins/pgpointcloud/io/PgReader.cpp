@@ -279,22 +279,14 @@ void PgReader::CursorTeardown()
 
 point_count_t PgReader::readPgPatch(PointViewPtr view, point_count_t numPts)
 {
-    point_count_t numRemaining = m_patch.remaining;
     PointId nextId = view->size();
-    point_count_t numRead = 0;
 
     size_t offset = (m_patch.count - m_patch.remaining) * packedPointSize();
-    char *pos = (char *)(m_patch.binary.data() + offset);
+    const char *pos = (const char *)(m_patch.binary.data() + offset);
 
-    while (numRead < numPts && numRemaining > 0)
-    {
-        writePoint(*view.get(), nextId, pos);
-        pos += packedPointSize();
-        numRemaining--;
-        nextId++;
-        numRead++;
-    }
-    m_patch.remaining = numRemaining;
+    point_count_t numRead = (std::min)(numPts, m_patch.remaining);
+    writeBlock(*view.get(), nextId, pos, numRead);
+    m_patch.remaining -= numRead;
     return numRead;
 }
 
@@ -56,8 +56,6 @@ CREATE_SHARED_STAGE(PgWriter, s_info)
 std::string PgWriter::getName() const { return s_info.name; }
 
 // TO DO:
-// - change INSERT into COPY
-//
 // - PCID / Schema consistency. If a PCID is specified,
 // must it be consistent with the buffer schema? Or should
 // the writer shove the data into the database schema as best
@@ -74,11 +72,21 @@ PgWriter::PgWriter()
     , m_pcid(0)
     , m_overwrite(true)
     , m_schema_is_initialized(false)
+    , m_copyDone(false)
 {}
 
 
 PgWriter::~PgWriter()
 {
+    if (m_copyThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_copyDone = true;
+        }
+        m_cv.notify_all();
+        m_copyThread.join();
+    }
     if (m_session)
         PQfinish(m_session);
 }
@@ -150,12 +158,105 @@ void PgWriter::writeInit()
     }
 
     m_schema_is_initialized = true;
+
+    startCopy();
 }
 
 void PgWriter::write(const PointViewPtr view)
 {
     writeInit();
-    writeTile(view);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_copyError)
+        std::rethrow_exception(m_copyError);
+    m_pending.push_back(view);
+    m_cv.notify_one();
+}
+
+
+// Open a COPY on the patch column and hand the connection to the worker.
+// Each patch becomes one COPY row, so patches stream down a single
+// statement instead of costing an INSERT round trip apiece.
+void PgWriter::startCopy()
+{
+    std::ostringstream oss;
+    oss << "COPY ";
+    if (m_schema_name.size())
+        oss << pg_quote_identifier(m_schema_name) << ".";
+    oss << pg_quote_identifier(m_table_name) <<
+        " (" << pg_quote_identifier(m_column_name) << ") FROM STDIN";
+
+    PGresult *result = PQexec(m_session, oss.str().c_str());
+    if (!result || PQresultStatus(result) != PGRES_COPY_IN)
+    {
+        std::string errmsg = PQerrorMessage(m_session);
+        if (result)
+            PQclear(result);
+        throwError(errmsg);
+    }
+    PQclear(result);
+
+    m_copyDone = false;
+    m_copyThread = std::thread([this](){ copyLoop(); });
+}
+
+
+void PgWriter::copyLoop()
+{
+    for (;;)
+    {
+        PointViewPtr view;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock,
+                [this](){ return m_pending.size() || m_copyDone; });
+            if (m_pending.empty())
+                return;
+            view = m_pending.front();
+            m_pending.pop_front();
+        }
+        try
+        {
+            writeTile(view);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_copyError = std::current_exception();
+            return;
+        }
+    }
+}
+
+
+void PgWriter::endCopy()
+{
+    if (!m_copyThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_copyDone = true;
+    }
+    m_cv.notify_all();
+    m_copyThread.join();
+    if (m_copyError)
+        std::rethrow_exception(m_copyError);
+
+    if (PQputCopyEnd(m_session, NULL) != 1)
+        throwError(PQerrorMessage(m_session));
+
+    PGresult *result = PQgetResult(m_session);
+    if (!result || PQresultStatus(result) != PGRES_COMMAND_OK)
+    {
+        std::string errmsg = PQerrorMessage(m_session);
+        if (result)
+            PQclear(result);
+        throwError(errmsg);
+    }
+    PQclear(result);
+    while ((result = PQgetResult(m_session)))
+        PQclear(result);
 }
 
 
@@ -163,6 +264,8 @@ void PgWriter::done(PointTableRef /*table*/)
 {
     //CreateIndex(m_schema_name, m_table_name, m_column_name);
 
+    endCopy();
+
     if (m_post_sql.size())
     {
         std::string sql = FileUtils::readFileIntoString(m_post_sql);
@@ -412,45 +515,14 @@ void PgWriter::CreateIndex(std::string const& schema_name,
 }
 
 
+// Assemble the hex WKB for one patch and push it down the COPY as a
+// single row.  Runs on the copy thread; the row is pure hex digits, so
+// no COPY text escaping is needed.
 void PgWriter::writeTile(const PointViewPtr view)
 {
-    std::vector<char> storage(packedPointSize());
-    std::string hexrep;
-    size_t maxHexrepSize = packedPointSize() * view->size() * 2;
-    hexrep.reserve(maxHexrepSize);
-
-    m_insert.clear();
-    m_insert.reserve(maxHexrepSize + 3000);
-
-    for (PointId idx = 0; idx < view->size(); ++idx)
-    {
-        size_t size = readPoint(*view.get(), idx, storage.data());
-
-        /* We are always getting uncompressed bytes off the block_data */
-        /* so we always used compression type 0 (uncompressed) in writing */
-        /* our WKB */
-        static char syms[] = "0123456789ABCDEF";
-        for (size_t i = 0; i != size; i++)
-        {
-            hexrep.push_back(syms[((storage[i] >> 4) & 0xf)]);
-            hexrep.push_back(syms[storage[i] & 0xf]);
-        }
-    }
-
-    std::string insert_into("INSERT INTO ");
-    std::string values(" (" + pg_quote_identifier(m_column_name) +
-                       ") VALUES ('");
-
-    m_insert.append(insert_into);
-
-    if (m_schema_name.size())
-    {
-        m_insert.append(pg_quote_identifier(m_schema_name));
-        m_insert.append(".");
-    }
-
-    m_insert.append(pg_quote_identifier(m_table_name));
-    m_insert.append(values);
+    std::vector<char> storage(packedPointSize() * view->size());
+    std::string row;
+    row.reserve(packedPointSize() * view->size() * 2 + 30);
 
     std::ostringstream options;
 
@@ -474,11 +546,23 @@ void PgWriter::writeTile(const PointViewPtr view)
     // needs to be 4 bytes
     options << std::hex << std::setfill('0') << std::setw(8) << num_points;
 
-    m_insert.append(options.str());
-    m_insert.append(hexrep);
-    m_insert.append("')");
+    row.append(options.str());
+
+    size_t size = readBlock(*view.get(), 0, view->size(), storage.data());
+
+    /* We are always getting uncompressed bytes off the block_data */
+    /* so we always used compression type 0 (uncompressed) in writing */
+    /* our WKB */
+    static char syms[] = "0123456789ABCDEF";
+    for (size_t i = 0; i != size; i++)
+    {
+        row.push_back(syms[((storage[i] >> 4) & 0xf)]);
+        row.push_back(syms[storage[i] & 0xf]);
+    }
+    row.push_back('\n');
 
-    pg_execute(m_session, m_insert);
+    if (PQputCopyData(m_session, row.data(), (int)row.size()) != 1)
+        throwError(PQerrorMessage(m_session));
 }
 
 } // namespace pdal
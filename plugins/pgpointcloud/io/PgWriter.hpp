@@ -35,6 +35,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 #include <pdal/DbWriter.hpp>
 #include <pdal/StageFactory.hpp>
 #include "PgCommon.hpp"
@@ -60,6 +66,9 @@ private:
 
     void writeInit();
     void writeTile(const PointViewPtr view);
+    void startCopy();
+    void endCopy();
+    void copyLoop();
 
     bool CheckTableExists(std::string const& name);
     bool CheckPointCloudExists();
@@ -92,13 +101,23 @@ private:
     uint32_t m_srid;
     uint32_t m_pcid;
     bool m_overwrite;
-    std::string m_insert;
     Orientation m_orientation;
     std::string m_pre_sql;
     std::string m_post_sql;
 
     // lose this
     bool m_schema_is_initialized;
+
+    // Patches are assembled and streamed down the COPY by a worker thread
+    // so tiling the next view overlaps the database round trip.  The
+    // connection belongs to the worker from startCopy() until endCopy()
+    // joins it.
+    std::thread m_copyThread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<PointViewPtr> m_pending;
+    bool m_copyDone;
+    std::exception_ptr m_copyError;
 };
 
 } // namespace pdal
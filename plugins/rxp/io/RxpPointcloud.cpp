@@ -75,46 +75,62 @@ RxpPointcloud::RxpPointcloud(
     , m_rc(scanlib::basic_rconnection::create(uri))
     , m_dec(m_rc)
     , m_edge(false)
-{}
+    , m_ring(65536)
+    , m_stop(false)
+    , m_eof(false)
+{
+    m_decodeThread = std::thread([this]() { decodeLoop(); });
+}
 
 
 RxpPointcloud::~RxpPointcloud()
 {
+    m_stop = true;
+    m_ring.finish();
+    if (m_decodeThread.joinable())
+        m_decodeThread.join();
     m_rc->close();
 }
 
 
-bool RxpPointcloud::readOne(PointRef& point)
+/// Run the RiVLib decoder, dispatching packets so on_echo_transformed()
+/// produces points into the ring.  Runs on the decode thread; decoding
+/// continues while downstream stages consume, so a slow stage drains the
+/// ring instead of stalling the stream.
+void RxpPointcloud::decodeLoop()
 {
-    if (readSavedPoint(point)) {
-        return true;
+    try
+    {
+        for (m_dec.get(m_rxpbuf); !m_dec.eoi() && !m_stop;
+            m_dec.get(m_rxpbuf))
+        {
+            dispatch(m_rxpbuf.begin(), m_rxpbuf.end());
+        }
+    }
+    catch (...)
+    {
+        m_decodeError = std::current_exception();
     }
-    savePoints();
-    return readSavedPoint(point);
+    m_ring.finish();
 }
 
 
-bool RxpPointcloud::readSavedPoint(PointRef& point)
+bool RxpPointcloud::readOne(PointRef& point)
 {
-    if (!m_points.empty()) {
-        copyPoint(m_points.front(), point);
-        m_points.pop_front();
-        return true;
-    } else {
-        return false;
-    }
-};
-
-
-void RxpPointcloud::savePoints() {
-    if (endOfInput()) {
-        return;
-    }
-    for (m_dec.get(m_rxpbuf); !m_dec.eoi(); m_dec.get(m_rxpbuf))
+    if (m_points.empty())
     {
-        dispatch(m_rxpbuf.begin(), m_rxpbuf.end());
-        if (!m_points.empty()) return;
+        m_ring.pop(m_points, 4096);
+        if (m_points.empty())
+        {
+            if (m_decodeError)
+                std::rethrow_exception(m_decodeError);
+            m_eof = true;
+            return false;
+        }
     }
+    copyPoint(m_points.front(), point);
+    m_points.pop_front();
+    return true;
 }
 
 
@@ -151,7 +167,9 @@ void RxpPointcloud::copyPoint(const Point& from, PointRef& to) const {
 
 bool RxpPointcloud::endOfInput() const
 {
-    return m_dec.eoi();
+    // The decoder runs on its own thread, so end of input is the
+    // consumer's view: the ring ran dry after the decoder finished.
+    return m_eof;
 }
 
 
@@ -167,7 +185,13 @@ void RxpPointcloud::on_echo_transformed(echo_type echo)
     for (scanlib::pointcloud::target_count_type i = 0; i < target_count; ++i, ++returnNumber)
     {
         //Only first return is marked as edge of flight line
-        m_points.emplace_back(targets[i], returnNumber, target_count, m_edge);
+        if (!m_ring.push(Point(targets[i], returnNumber, target_count,
+            m_edge)))
+        {
+            // The consumer is gone; tell decodeLoop() to bail out.
+            m_stop = true;
+            return;
+        }
         if (m_edge)
             m_edge = false;
     }
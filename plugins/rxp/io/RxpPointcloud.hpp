@@ -41,6 +41,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <pdal/Dimension.hpp>
 #include <pdal/PointRef.hpp>
 #include <pdal/PointTable.hpp>
@@ -54,6 +62,7 @@ namespace pdal
 Dimension::Id getTimeDimensionId(bool syncToPps);
 
 struct Point {
+    Point() = default;
     Point(scanlib::target target, unsigned int returnNumber, unsigned int numberOfReturns, bool edgeOfFlightLine);
 
     scanlib::target target;
@@ -63,6 +72,90 @@ struct Point {
 };
 
 
+// Fixed-size single-producer/single-consumer ring carrying decoded points
+// from the RiVLib dispatch thread to the pipeline thread.  Head and tail
+// are atomics, so steady-state push/pop never takes the lock; the mutex
+// and condition variables only park a side that has run out of room or
+// data.
+class PointRing
+{
+public:
+    PointRing(size_t capacity)
+        : m_slots(capacity), m_head(0), m_tail(0), m_done(false)
+    {}
+
+    // Add a point, blocking while the ring is full.  Returns false once
+    // finish() has been called.
+    bool push(const Point& point)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t next = (head + 1) % m_slots.size();
+        if (next == m_tail.load(std::memory_order_acquire))
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notFull.wait(lock, [this, next]()
+            {
+                return next != m_tail.load(std::memory_order_acquire) ||
+                    m_done;
+            });
+            if (m_done)
+                return false;
+        }
+        m_slots[head] = point;
+        m_head.store(next, std::memory_order_release);
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Move up to max points into dst, blocking until points arrive or the
+    // producer finishes.  Returns 0 only at end of input.
+    size_t pop(std::deque<Point>& dst, size_t max)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notEmpty.wait(lock, [this, tail]()
+            {
+                return tail != m_head.load(std::memory_order_acquire) ||
+                    m_done;
+            });
+        }
+        size_t head = m_head.load(std::memory_order_acquire);
+        size_t count = 0;
+        while (tail != head && count < max)
+        {
+            dst.push_back(std::move(m_slots[tail]));
+            tail = (tail + 1) % m_slots.size();
+            ++count;
+        }
+        m_tail.store(tail, std::memory_order_release);
+        if (count)
+            m_notFull.notify_one();
+        return count;
+    }
+
+    // Called by the producer at end of input and by the consumer on
+    // abort; wakes anyone parked on the ring.
+    void finish()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+private:
+    std::vector<Point> m_slots;
+    std::atomic<size_t> m_head;  // Next slot to write.
+    std::atomic<size_t> m_tail;  // Next slot to read.
+    bool m_done;
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+};
+
+
 class PDAL_DLL RxpPointcloud : public scanlib::pointcloud
 {
 public:
@@ -89,9 +182,8 @@ protected:
     void on_line_start_dn(const scanlib::line_start_dn<iterator_type> & arg);
 
 private:
-    bool readSavedPoint(PointRef& point);
     void copyPoint(const Point& from, PointRef& to) const;
-    void savePoints();
+    void decodeLoop();
 
     bool m_syncToPps;
     bool m_edge;
@@ -101,8 +193,15 @@ private:
     std::shared_ptr<scanlib::basic_rconnection> m_rc;
     scanlib::decoder_rxpmarker m_dec;
     scanlib::buffer m_rxpbuf;
-    std::deque<Point> m_points;
 
+    // Decoded points flow through the ring from the decode thread;
+    // readOne() drains them in batches into m_points.
+    PointRing m_ring;
+    std::deque<Point> m_points;
+    std::thread m_decodeThread;
+    std::exception_ptr m_decodeError;
+    std::atomic<bool> m_stop;
+    bool m_eof;
 };
 
 
@@ -118,9 +118,10 @@ point_count_t RxpReader::read(PointViewPtr view, point_count_t num)
 {
     point_count_t numRead = 0;
     PointRef point(view->point(0));
-    while (numRead < num && !m_pointcloud->endOfInput()) {
+    while (numRead < num) {
         point.setPointId(numRead);
-        processOne(point);
+        if (!processOne(point))
+            break;
         ++numRead;
     }
     return numRead;
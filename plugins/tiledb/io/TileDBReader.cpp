@@ -181,44 +181,44 @@ void TileDBReader::addDimensions(PointLayoutPtr layout)
 }
 
 template <typename T>
-void TileDBReader::setQueryBuffer(const DimInfo& di)
+void TileDBReader::setQueryBuffer(const DimInfo& di, Buffer *buf)
 {
-    m_query->set_buffer(di.m_name, di.m_buffer->get<T>(), di.m_buffer->count());
+    m_query->set_buffer(di.m_name, buf->get<T>(), buf->count());
 }
 
-void TileDBReader::setQueryBuffer(const DimInfo& di)
+void TileDBReader::setQueryBuffer(const DimInfo& di, Buffer *buf)
 {
     switch(di.m_tileType)
     {
     case TILEDB_INT8:
-        setQueryBuffer<int8_t>(di);
+        setQueryBuffer<int8_t>(di, buf);
         break;
     case TILEDB_UINT8:
-        setQueryBuffer<uint8_t>(di);
+        setQueryBuffer<uint8_t>(di, buf);
         break;
     case TILEDB_INT16:
-        setQueryBuffer<int16_t>(di);
+        setQueryBuffer<int16_t>(di, buf);
         break;
     case TILEDB_UINT16:
-        setQueryBuffer<uint16_t>(di);
+        setQueryBuffer<uint16_t>(di, buf);
         break;
     case TILEDB_INT32:
-        setQueryBuffer<int32_t>(di);
+        setQueryBuffer<int32_t>(di, buf);
         break;
     case TILEDB_UINT32:
-        setQueryBuffer<uint32_t>(di);
+        setQueryBuffer<uint32_t>(di, buf);
         break;
     case TILEDB_INT64:
-        setQueryBuffer<int64_t>(di);
+        setQueryBuffer<int64_t>(di, buf);
         break;
     case TILEDB_UINT64:
-        setQueryBuffer<uint64_t>(di);
+        setQueryBuffer<uint64_t>(di, buf);
         break;
     case TILEDB_FLOAT32:
-        setQueryBuffer<float>(di);
+        setQueryBuffer<float>(di, buf);
         break;
     case TILEDB_FLOAT64:
-        setQueryBuffer<double>(di);
+        setQueryBuffer<double>(di, buf);
         break;
     default:
         throwError("TileDB dimension '" + di.m_name + "' can't be mapped "
@@ -245,27 +245,33 @@ void TileDBReader::localReady()
 
     m_query.reset(new tiledb::Query(*m_ctx, *m_array));
 
-    // Build the buffer for the dimensions.
+    // Find the dimension info to size the shared coordinates buffer.
     auto it = std::find_if(m_dims.begin(), m_dims.end(),
         [](DimInfo& di){ return di.m_dimCategory == DimCategory::Dimension; });
 
-    DimInfo& di = *it;
-    Buffer *dimBuf = new Buffer(di.m_tileType, m_chunkSize * numDims);
-    m_query->set_coordinates(dimBuf->get<double>(), dimBuf->count());
-    m_buffers.push_back(std::unique_ptr<Buffer>(dimBuf));
-
-    for (DimInfo& di : m_dims)
+    // Build two sets of result buffers so a worker thread can submit the
+    // next portion of the query into one while points are drained from
+    // the other.
+    for (Batch& batch : m_batch)
     {
-        // All dimensions use the same buffer.
-        if (di.m_dimCategory == DimCategory::Dimension)
-            di.m_buffer = dimBuf;
-        else
+        batch.m_buffers.clear();
+        batch.m_byDim.clear();
+
+        // All dimensions share one coordinates buffer.
+        Buffer *dimBuf = new Buffer(it->m_tileType, m_chunkSize * numDims);
+        batch.m_buffers.push_back(std::unique_ptr<Buffer>(dimBuf));
+
+        for (DimInfo& di : m_dims)
         {
-            std::unique_ptr<Buffer> dimBuf(
-                new Buffer(di.m_tileType, m_chunkSize));
-            di.m_buffer = dimBuf.get();
-            m_buffers.push_back(std::move(dimBuf));
-            setQueryBuffer(di);
+            if (di.m_dimCategory == DimCategory::Dimension)
+                batch.m_byDim.push_back(dimBuf);
+            else
+            {
+                std::unique_ptr<Buffer> attrBuf(
+                    new Buffer(di.m_tileType, m_chunkSize));
+                batch.m_byDim.push_back(attrBuf.get());
+                batch.m_buffers.push_back(std::move(attrBuf));
+            }
         }
     }
 
@@ -334,6 +340,99 @@ void TileDBReader::localReady()
     m_offset = 0;
     m_resultSize = 0;
     m_complete = false;
+    m_front = 0;
+    m_started = false;
+    m_prefetchError = nullptr;
+}
+
+
+// Bind the batch's buffers to the query, submit the next portion and
+// record the result count and completion status.  Runs either on the
+// main thread (first batch) or on the prefetch thread; only one of the
+// two ever touches the query at a time.
+void TileDBReader::fillBatch(Batch& batch)
+{
+    Buffer *dimBuf = nullptr;
+    for (size_t i = 0; i < m_dims.size(); ++i)
+    {
+        DimInfo& di = m_dims[i];
+        if (di.m_dimCategory == DimCategory::Dimension)
+            dimBuf = batch.m_byDim[i];
+        else
+            setQueryBuffer(di, batch.m_byDim[i]);
+    }
+    m_query->set_coordinates(dimBuf->get<double>(), dimBuf->count());
+
+    if (m_stats)
+        tiledb::Stats::enable();
+    m_query->submit();
+    if (m_stats)
+    {
+        tiledb::Stats::dump(stdout);
+        tiledb::Stats::disable();
+    }
+
+    tiledb::Query::Status status = m_query->query_status();
+
+    // The result buffer count represents the total number of items
+    // returned by the query for dimensions.  So if there are three
+    // dimensions, the number of points returned is the buffer count
+    // divided by the number of dimensions.
+    batch.m_resultSize =
+        (int)m_query->result_buffer_elements()[TILEDB_COORDS].second /
+        m_array->schema().domain().dimensions().size();
+    batch.m_complete = (status == tiledb::Query::Status::COMPLETE);
+
+    if (status == tiledb::Query::Status::INCOMPLETE &&
+            batch.m_resultSize == 0)
+        throwError("Need to increase chunk_size for reader.");
+}
+
+
+// Make the next batch current.  The first call fills the front batch
+// synchronously; afterwards the prefetch filling the back batch is
+// joined and the batches swap.  Unless the query completed, the next
+// prefetch is started immediately so it overlaps with draining.
+void TileDBReader::advanceBatch()
+{
+    if (!m_started)
+    {
+        fillBatch(m_batch[m_front]);
+        m_started = true;
+    }
+    else
+    {
+        m_prefetch.join();
+        if (m_prefetchError)
+        {
+            std::exception_ptr err = m_prefetchError;
+            m_prefetchError = nullptr;
+            std::rethrow_exception(err);
+        }
+        m_front = 1 - m_front;
+    }
+
+    Batch& batch = m_batch[m_front];
+    m_resultSize = batch.m_resultSize;
+    m_complete = batch.m_complete;
+    m_offset = 0;
+
+    // Point the dimension info at the buffers just filled.
+    for (size_t i = 0; i < m_dims.size(); ++i)
+        m_dims[i].m_buffer = batch.m_byDim[i];
+
+    if (!m_complete)
+        m_prefetch = std::thread([this]()
+        {
+            try
+            {
+                fillBatch(m_batch[1 - m_front]);
+            }
+            catch (...)
+            {
+                m_prefetchError = std::current_exception();
+            }
+        });
 }
 
 namespace
@@ -406,40 +505,8 @@ bool TileDBReader::processPoint(PointRef& point)
     if (m_offset == m_resultSize)
     {
         if (m_complete)
-        {
             return false;
-        }
-        else
-        {
-            tiledb::Query::Status status;
-            if (m_stats)
-                tiledb::Stats::enable();
-            m_query->submit();
-            if (m_stats)
-            {
-                tiledb::Stats::dump(stdout);
-                tiledb::Stats::disable();
-            }
-
-            status = m_query->query_status();
-
-            // The result buffer count represents the total number of items
-            // returned by the query for dimensions.  So if there are three
-            // dimensions, the number of points returned is the buffer count
-            // divided by the number of dimensions.
-            m_resultSize =
-                (int)m_query->result_buffer_elements()[TILEDB_COORDS].second /
-                m_array->schema().domain().dimensions().size();
-
-            if (status == tiledb::Query::Status::INCOMPLETE &&
-                    m_resultSize == 0)
-                throwError("Need to increase chunk_size for reader.");
-
-            if (status == tiledb::Query::Status::COMPLETE)
-                m_complete = true;
-
-            m_offset = 0;
-        }     
+        advanceBatch();
     }
 
     if (m_resultSize > 0)
@@ -472,6 +539,9 @@ point_count_t TileDBReader::read(PointViewPtr view, point_count_t count)
 
 void TileDBReader::done(pdal::BasePointTable &table)
 {
+    // A prefetch may still be in flight if reading stopped early.
+    if (m_prefetch.joinable())
+        m_prefetch.join();
     m_array->close();
 }
 
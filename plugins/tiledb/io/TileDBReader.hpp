@@ -36,7 +36,9 @@
 
 #define NOMINMAX
 
+#include <exception>
 #include <iostream>
+#include <thread>
 
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
@@ -83,8 +85,24 @@ public:
     };
 
     TileDBReader() = default;
+    ~TileDBReader()
+    {
+        if (m_prefetch.joinable())
+            m_prefetch.join();
+    }
     std::string getName() const;
 private:
+    // One set of query result buffers.  Two batches are kept so a worker
+    // thread can submit the next portion of the query into one while
+    // points are drained from the other.
+    struct Batch
+    {
+        std::vector<std::unique_ptr<Buffer>> m_buffers;
+        std::vector<Buffer *> m_byDim;  // Buffer for each entry of m_dims.
+        point_count_t m_resultSize;
+        bool m_complete;
+    };
+
     virtual void addArgs(ProgramArgs& args);
     virtual void initialize();
     virtual void addDimensions(PointLayoutPtr layout);
@@ -95,6 +113,8 @@ private:
     virtual void done(PointTableRef table);
     void localReady();
     bool processPoint(PointRef& point);
+    void fillBatch(Batch& batch);
+    void advanceBatch();
 
     std::string m_cfgFileName;
     point_count_t m_chunkSize;
@@ -103,7 +123,11 @@ private:
     bool m_complete;
     bool m_stats;
     BOX3D m_bbox;
-    std::vector<std::unique_ptr<Buffer>> m_buffers;
+    Batch m_batch[2];
+    int m_front;
+    bool m_started;
+    std::thread m_prefetch;
+    std::exception_ptr m_prefetchError;
     std::vector<DimInfo> m_dims;
 
     std::unique_ptr<tiledb::Context> m_ctx;
@@ -114,8 +138,8 @@ private:
     TileDBReader& operator=(const TileDBReader&) = delete;
 
     template<typename T>
-    void setQueryBuffer(const DimInfo& di);
-    void setQueryBuffer(const DimInfo& di);
+    void setQueryBuffer(const DimInfo& di, Buffer *buf);
+    void setQueryBuffer(const DimInfo& di, Buffer *buf);
 };
 
 } // namespace pdal
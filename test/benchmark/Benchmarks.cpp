@@ -0,0 +1,375 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+// Microbenchmarks for PDAL's hot paths.  These don't assert correctness -
+// the unit tests do that - they exist so that throughput regressions in
+// field access, layout registration, spatial indexing, scaling, the LAZ
+// codec and stream-mode dispatch show up as numbers instead of user
+// complaints.  Times are wall clock; run on a quiet machine.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <pdal/pdal_features.hpp>
+
+#include <pdal/KDIndex.hpp>
+#include <pdal/Options.hpp>
+#include <pdal/PointTable.hpp>
+#include <pdal/PointView.hpp>
+#include <pdal/pdal_types.hpp>
+#include <filters/StreamCallbackFilter.hpp>
+#include <io/FauxReader.hpp>
+#include <io/LasReader.hpp>
+
+#ifdef PDAL_HAVE_LAZPERF
+#include <pdal/compression/LazPerfCompression.hpp>
+#endif
+
+namespace pdal
+{
+
+namespace
+{
+
+// Fill a view with deterministic pseudo-random XYZ so runs are comparable.
+PointViewPtr makeRandomView(PointTableRef table, point_count_t count)
+{
+    std::mt19937 gen(31415);
+    std::uniform_real_distribution<double> dist(0, 1000);
+
+    PointViewPtr view(new PointView(table));
+    for (PointId i = 0; i < count; ++i)
+    {
+        view->setField(Dimension::Id::X, i, dist(gen));
+        view->setField(Dimension::Id::Y, i, dist(gen));
+        view->setField(Dimension::Id::Z, i, dist(gen));
+    }
+    return view;
+}
+
+} // unnamed namespace
+
+
+// PointView field access - the per-point virtual-dispatch path.
+
+static void BM_PointViewSetField(benchmark::State& state)
+{
+    const point_count_t count = (point_count_t)state.range(0);
+    PointTable table;
+    table.layout()->registerDims({ Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z });
+    table.finalize();
+    PointView view(table);
+
+    for (auto _ : state)
+        for (PointId i = 0; i < count; ++i)
+            view.setField(Dimension::Id::X, i, (double)i);
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_PointViewSetField)->Arg(100000);
+
+static void BM_PointViewGetField(benchmark::State& state)
+{
+    const point_count_t count = (point_count_t)state.range(0);
+    PointTable table;
+    table.layout()->registerDims({ Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z });
+    table.finalize();
+    PointViewPtr view = makeRandomView(table, count);
+
+    double total = 0;
+    for (auto _ : state)
+        for (PointId i = 0; i < count; ++i)
+            total += view->getFieldAs<double>(Dimension::Id::X, i);
+    benchmark::DoNotOptimize(total);
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_PointViewGetField)->Arg(100000);
+
+// The batched path - one virtual call per block instead of per point.
+static void BM_PointViewGetFieldBatch(benchmark::State& state)
+{
+    const point_count_t count = (point_count_t)state.range(0);
+    PointTable table;
+    table.layout()->registerDims({ Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z });
+    table.finalize();
+    PointViewPtr view = makeRandomView(table, count);
+    std::vector<double> vals(count);
+
+    for (auto _ : state)
+    {
+        view->getFieldBatch(Dimension::Id::X, 0, count, vals.data());
+        benchmark::DoNotOptimize(vals.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_PointViewGetFieldBatch)->Arg(100000);
+
+
+// PointLayout registration - exercised once per pipeline, but visible in
+// short jobs and in servers that build many tables.
+
+static void BM_LayoutRegistration(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        PointTable table;
+        PointLayoutPtr layout = table.layout();
+        for (int id = (int)Dimension::Id::X;
+                id <= (int)Dimension::Id::ClassFlags; ++id)
+            layout->registerDim((Dimension::Id)id);
+        for (int i = 0; i < 8; ++i)
+            layout->registerOrAssignDim("Custom" + std::to_string(i),
+                Dimension::Type::Double);
+        table.finalize();
+        benchmark::DoNotOptimize(layout->pointSize());
+    }
+}
+BENCHMARK(BM_LayoutRegistration);
+
+
+// KD3Index construction and queries.
+
+static void BM_KD3IndexBuild(benchmark::State& state)
+{
+    const point_count_t count = (point_count_t)state.range(0);
+    PointTable table;
+    table.layout()->registerDims({ Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z });
+    table.finalize();
+    PointViewPtr view = makeRandomView(table, count);
+
+    for (auto _ : state)
+    {
+        KD3Index index(*view);
+        index.build();
+        benchmark::DoNotOptimize(index);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_KD3IndexBuild)->Arg(100000);
+
+static void BM_KD3IndexNeighbors(benchmark::State& state)
+{
+    const point_count_t count = 100000;
+    const point_count_t queries = (point_count_t)state.range(0);
+    PointTable table;
+    table.layout()->registerDims({ Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z });
+    table.finalize();
+    PointViewPtr view = makeRandomView(table, count);
+    KD3Index index(*view);
+    index.build();
+
+    for (auto _ : state)
+        for (PointId i = 0; i < queries; ++i)
+            benchmark::DoNotOptimize(index.neighbors(i, 10));
+    state.SetItemsProcessed(state.iterations() * queries);
+}
+BENCHMARK(BM_KD3IndexNeighbors)->Arg(1000);
+
+static void BM_KD3IndexRadius(benchmark::State& state)
+{
+    const point_count_t count = 100000;
+    const point_count_t queries = (point_count_t)state.range(0);
+    PointTable table;
+    table.layout()->registerDims({ Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z });
+    table.finalize();
+    PointViewPtr view = makeRandomView(table, count);
+    KD3Index index(*view);
+    index.build();
+
+    for (auto _ : state)
+        for (PointId i = 0; i < queries; ++i)
+            benchmark::DoNotOptimize(index.radius(i, 25.0));
+    state.SetItemsProcessed(state.iterations() * queries);
+}
+BENCHMARK(BM_KD3IndexRadius)->Arg(1000);
+
+
+// Scaling conversions - scalar loop against the batch kernels.
+
+static void BM_XFormScalar(benchmark::State& state)
+{
+    const size_t count = (size_t)state.range(0);
+    XForm xform(.01, 123456.78);
+    std::vector<int32_t> raw(count);
+    std::vector<double> scaled(count);
+    for (size_t i = 0; i < count; ++i)
+        raw[i] = (int32_t)(i * 37);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+            scaled[i] = xform.fromScaled((double)raw[i]);
+        benchmark::DoNotOptimize(scaled.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_XFormScalar)->Arg(100000);
+
+static void BM_XFormBatch(benchmark::State& state)
+{
+    const size_t count = (size_t)state.range(0);
+    XForm xform(.01, 123456.78);
+    std::vector<int32_t> raw(count);
+    std::vector<double> scaled(count);
+    for (size_t i = 0; i < count; ++i)
+        raw[i] = (int32_t)(i * 37);
+
+    for (auto _ : state)
+    {
+        xform.fromScaled(raw.data(), scaled.data(), count);
+        benchmark::DoNotOptimize(scaled.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_XFormBatch)->Arg(100000);
+
+
+// LAZ point codec throughput.
+
+#ifdef PDAL_HAVE_LAZPERF
+static void BM_LazPerfCompress(benchmark::State& state)
+{
+    const point_count_t count = (point_count_t)state.range(0);
+    PointTable table;
+    table.layout()->registerDims({ Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z });
+    table.finalize();
+    PointViewPtr view = makeRandomView(table, count);
+
+    DimTypeList dims = table.layout()->dimTypes();
+    size_t pointSize = table.layout()->pointSize();
+    std::vector<char> buf(pointSize * count);
+    for (PointId i = 0; i < count; ++i)
+        view->getPackedPoint(dims, i, buf.data() + i * pointSize);
+
+    for (auto _ : state)
+    {
+        size_t outBytes = 0;
+        auto cb = [&outBytes](char *, size_t bufsize)
+            { outBytes += bufsize; };
+        LazPerfCompressor compressor(cb, dims);
+        compressor.compress(buf.data(), buf.size());
+        compressor.done();
+        benchmark::DoNotOptimize(outBytes);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_LazPerfCompress)->Arg(100000);
+#endif // PDAL_HAVE_LAZPERF
+
+
+// Stream-mode chunk dispatch - reader through a callback filter, single
+// and double-buffered tables.
+
+namespace
+{
+
+template <typename Table>
+void streamDispatch(benchmark::State& state)
+{
+    const point_count_t count = (point_count_t)state.range(0);
+
+    for (auto _ : state)
+    {
+        Options ops;
+        ops.add("bounds", BOX3D(0, 0, 0, 999, 999, 999));
+        ops.add("mode", "ramp");
+        ops.add("count", count);
+        FauxReader reader;
+        reader.setOptions(ops);
+
+        StreamCallbackFilter f;
+        point_count_t cnt = 0;
+        f.setCallback([&cnt](PointRef&)
+            { cnt++; return true; });
+        f.setInput(reader);
+
+        Table table(1000);
+        f.prepare(table);
+        f.execute(table);
+        benchmark::DoNotOptimize(cnt);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+} // unnamed namespace
+
+static void BM_StreamDispatch(benchmark::State& state)
+{
+    streamDispatch<FixedPointTable>(state);
+}
+BENCHMARK(BM_StreamDispatch)->Arg(100000);
+
+static void BM_StreamDispatchDoubleBuffered(benchmark::State& state)
+{
+    streamDispatch<DoubleBufferedPointTable>(state);
+}
+BENCHMARK(BM_StreamDispatchDoubleBuffered)->Arg(100000);
+
+
+// A pinned dataset through the LAS reader, end to end.
+
+static void BM_LasReaderRead(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        Options ops;
+        ops.add("filename",
+            std::string(BENCHMARK_DATA_DIR) + "/las/autzen_trim.las");
+        LasReader reader;
+        reader.setOptions(ops);
+
+        PointTable table;
+        reader.prepare(table);
+        PointViewSet views = reader.execute(table);
+        point_count_t cnt = 0;
+        for (const PointViewPtr& v : views)
+            cnt += v->size();
+        benchmark::DoNotOptimize(cnt);
+        state.SetItemsProcessed(state.iterations() * cnt);
+    }
+}
+BENCHMARK(BM_LasReaderRead);
+
+} // namespace pdal
+
+BENCHMARK_MAIN();
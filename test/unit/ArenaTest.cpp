@@ -0,0 +1,74 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <cstdint>
+
+#include <pdal/util/Arena.hpp>
+
+using namespace pdal;
+
+TEST(ArenaTest, basic)
+{
+    Arena arena(64);
+
+    // Distinct allocations, properly aligned.
+    double *d = arena.alloc<double>(4);
+    uint8_t *b = arena.alloc<uint8_t>(3);
+    EXPECT_EQ((uintptr_t)d % alignof(double), 0u);
+    EXPECT_NE((void *)d, (void *)b);
+    d[0] = 1.5;
+    b[0] = 7;
+    EXPECT_EQ(d[0], 1.5);
+    EXPECT_EQ(b[0], 7);
+
+    // A request larger than the block size still succeeds.
+    char *big = arena.alloc<char>(1000);
+    big[999] = 'x';
+    EXPECT_EQ(big[999], 'x');
+
+    // Once grown, resetting and re-allocating the same amounts reuses
+    // the existing blocks.
+    size_t cap = arena.capacity();
+    arena.reset();
+    arena.alloc<double>(4);
+    arena.alloc<uint8_t>(3);
+    arena.alloc<char>(1000);
+    EXPECT_EQ(arena.capacity(), cap);
+
+    // clear() releases the backing memory.
+    arena.clear();
+    EXPECT_EQ(arena.capacity(), 0u);
+}
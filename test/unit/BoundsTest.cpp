@@ -162,6 +162,36 @@ TEST(BoundsTest, test_grow)
 //ABELL - Need BOX3D example.
 }
 
+TEST(BoundsTest, test_batch)
+{
+    double x[] = { 1, 5, -2, 3 };
+    double y[] = { 2, 8, 4, -1 };
+    double z[] = { 0, 10, 5, 20 };
+
+    BOX2D b2;
+    b2.grow(x, y, 4);
+    EXPECT_TRUE(b2 == BOX2D(-2, -1, 5, 8));
+
+    BOX3D b3;
+    b3.grow(x, y, z, 4);
+    EXPECT_TRUE(b3 == BOX3D(-2, -1, 0, 5, 8, 20));
+
+    BOX2D box2(0, 0, 3, 4);
+    bool in[4];
+    box2.contains(x, y, in, 4);
+    EXPECT_TRUE(in[0]);
+    EXPECT_FALSE(in[1]);
+    EXPECT_FALSE(in[2]);
+    EXPECT_FALSE(in[3]);
+
+    BOX3D box3(0, 0, 0, 3, 4, 5);
+    box3.contains(x, y, z, in, 4);
+    EXPECT_TRUE(in[0]);
+    EXPECT_FALSE(in[1]);
+    EXPECT_FALSE(in[2]);
+    EXPECT_FALSE(in[3]);
+}
+
 TEST(BoundsTest, test_static)
 {
     BOX2D t(BOX2D::getDefaultSpatialExtent());
@@ -160,6 +160,11 @@ TEST(EigenTest, Morphological)
     EXPECT_EQ(0, Fv[16]);
     EXPECT_EQ(1, Fv[12]);
     EXPECT_EQ(0, Fv2[12]);
+
+    // The fused opening matches erosion followed by dilation.
+    std::vector<double> Gv = openDiamond(Ev, 5, 5, 1);
+    std::vector<double> Gv2 = dilateDiamond(erodeDiamond(Ev, 5, 5, 1), 5, 5, 1);
+    EXPECT_EQ(Gv, Gv2);
 }
 
 TEST(EigenTest, RoundtripString)
@@ -214,6 +219,11 @@ TEST(EigenTest, calcBounds)
     BOX3D box_b2;
     calculateBounds(*b2, box_b2);
     check_bounds(box_b2, 1.0, 3.0, 1.0, 3.0, 1.0, 3.0);
+
+    // Multi-view bounds, computed with per-view parallelism.
+    BOX3D box_par;
+    calculateBounds(std::vector<PointViewPtr>{b1, b2}, box_par, 2);
+    check_bounds(box_par, 0.0, 3.0, 0.0, 3.0, 0.0, 3.0);
 }
 
 TEST(EigenTest, demeanTest)
@@ -0,0 +1,204 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its contributors
+*       may be used to endorse or promote products derived from this
+*       software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <random>
+
+#include <pdal/GridIndex.hpp>
+#include <pdal/KDIndex.hpp>
+
+using namespace pdal;
+
+TEST(GridIndex, radius3D)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    layout->registerDim(Dimension::Id::Z);
+
+    const point_count_t count = 10000;
+    const double r = 4.0;
+
+    std::mt19937 gen(2718);
+    std::uniform_real_distribution<double> dis(0.0, 100.0);
+    for (PointId i = 0; i < count; ++i)
+    {
+        view.setField(Dimension::Id::X, i, dis(gen));
+        view.setField(Dimension::Id::Y, i, dis(gen));
+        view.setField(Dimension::Id::Z, i, dis(gen));
+    }
+
+    KD3Index kd(view);
+    kd.build();
+
+    Grid3Index grid(view, r);
+    grid.build();
+
+    // The grid must return exactly the distance-sorted ID list the KD-tree
+    // does, and within() must agree with its size.
+    for (PointId i = 0; i < 50; ++i)
+    {
+        PointIdList kdIds = kd.radius(i, r);
+        PointIdList gridIds = grid.radius(i, r);
+
+        EXPECT_EQ(kdIds, gridIds);
+        EXPECT_EQ(grid.within(i, r), gridIds.size());
+    }
+
+    // Querying with a radius other than the cell size is legal.
+    for (PointId i = 0; i < 20; ++i)
+        EXPECT_EQ(kd.radius(i, 2 * r), grid.radius(i, 2 * r));
+}
+
+TEST(GridIndex, validation)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+
+    EXPECT_THROW(Grid3Index(view, 1.0), pdal_error);
+
+    layout->registerDim(Dimension::Id::Z);
+    EXPECT_THROW(Grid3Index(view, 0.0), pdal_error);
+
+    // An empty view builds and answers queries.
+    Grid3Index grid(view, 1.0);
+    grid.build();
+    EXPECT_EQ(grid.within(0.0, 0.0, 0.0, 1.0), 0U);
+}
+
+// A threaded build must produce exactly the index a serial build does.
+TEST(GridIndex, parallelBuild)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    layout->registerDim(Dimension::Id::Z);
+
+    const point_count_t count = 20000;
+    const double r = 5.0;
+
+    std::mt19937 gen(31415);
+    std::uniform_real_distribution<double> dis(0.0, 100.0);
+    for (PointId i = 0; i < count; ++i)
+    {
+        view.setField(Dimension::Id::X, i, dis(gen));
+        view.setField(Dimension::Id::Y, i, dis(gen));
+        view.setField(Dimension::Id::Z, i, dis(gen));
+    }
+
+    Grid3Index single(view, r);
+    single.build(1);
+    Grid3Index parallel(view, r);
+    parallel.build(4);
+
+    for (PointId i = 0; i < 50; ++i)
+    {
+        EXPECT_EQ(single.radius(i, r), parallel.radius(i, r));
+        EXPECT_EQ(single.within(i, r), parallel.within(i, r));
+    }
+}
+
+// The occupancy artifact hands back the published index while the view
+// and radius match and rebuilds when either changes.
+TEST(GridIndex, occupancyArtifact)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    layout->registerDim(Dimension::Id::Z);
+
+    const point_count_t count = 1000;
+    const double r = 3.0;
+
+    std::mt19937 gen(1618);
+    std::uniform_real_distribution<double> dis(0.0, 50.0);
+    for (PointId i = 0; i < count; ++i)
+    {
+        view.setField(Dimension::Id::X, i, dis(gen));
+        view.setField(Dimension::Id::Y, i, dis(gen));
+        view.setField(Dimension::Id::Z, i, dis(gen));
+    }
+
+    // The same view and radius reuse the published index.
+    Grid3Index& first = OccupancyArtifact::obtain(view, r);
+    Grid3Index& again = OccupancyArtifact::obtain(view, r);
+    EXPECT_EQ(&first, &again);
+    EXPECT_TRUE(table.artifactManager().exists(OccupancyArtifact::name()));
+
+    // The published index answers exactly like a privately built one.
+    Grid3Index grid(view, r);
+    grid.build();
+    for (PointId i = 0; i < 20; ++i)
+        EXPECT_EQ(grid.radius(i, r), first.radius(i, r));
+
+    // A different radius republishes.
+    Grid3Index& wider = OccupancyArtifact::obtain(view, 2 * r);
+    for (PointId i = 0; i < 20; ++i)
+        EXPECT_EQ(grid.radius(i, 2 * r), wider.radius(i, 2 * r));
+
+    // Growing the view invalidates the match and the rebuilt index sees
+    // the new point.
+    view.setField(Dimension::Id::X, count, 200.0);
+    view.setField(Dimension::Id::Y, count, 200.0);
+    view.setField(Dimension::Id::Z, count, 200.0);
+    Grid3Index& rebuilt = OccupancyArtifact::obtain(view, r);
+    EXPECT_EQ(rebuilt.within(200.0, 200.0, 200.0, r), 1U);
+
+    // Rewriting coordinates in place (as reprojection does) keeps the
+    // view's ID and size but changes the content digest, so the artifact
+    // republishes instead of answering from the stale grid.
+    for (PointId i = 0; i <= count; ++i)
+    {
+        view.setField(Dimension::Id::X, i,
+            view.getFieldAs<double>(Dimension::Id::X, i) + 1000.0);
+        view.setField(Dimension::Id::Y, i,
+            view.getFieldAs<double>(Dimension::Id::Y, i) + 1000.0);
+    }
+    Grid3Index& shifted = OccupancyArtifact::obtain(view, r);
+    EXPECT_EQ(shifted.within(1200.0, 1200.0, 200.0, r), 1U);
+    EXPECT_EQ(shifted.within(200.0, 200.0, 200.0, r), 0U);
+}
@@ -33,8 +33,13 @@
 
 #include <pdal/pdal_test_main.hpp>
 
+#include <numeric>
+#include <random>
+
 #include <pdal/KDIndex.hpp>
 
+#include "Support.hpp"
+
 using namespace pdal;
 
 TEST(KDIndex, neighbors2D)
@@ -378,3 +383,165 @@ TEST(KDIndex, radius3D)
     EXPECT_EQ(ids[2], 2u);
 }
 
+
+// A parallel build must return exactly the same neighbors as a single
+// tree - the view is big enough here that the index really segments.
+TEST(KDIndex, parallelBuild3D)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    layout->registerDim(Dimension::Id::Z);
+
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> dist(0, 1000);
+    const point_count_t count = 250000;
+    for (PointId i = 0; i < count; ++i)
+    {
+        view.setField(Dimension::Id::X, i, dist(gen));
+        view.setField(Dimension::Id::Y, i, dist(gen));
+        view.setField(Dimension::Id::Z, i, dist(gen));
+    }
+
+    KD3Index single(view);
+    single.build();
+    KD3Index parallel(view);
+    parallel.build(4, 50);
+
+    for (PointId q = 0; q < 20; ++q)
+    {
+        PointId idx = q * 11317;
+        EXPECT_EQ(single.neighbors(idx, 10), parallel.neighbors(idx, 10));
+        EXPECT_EQ(single.radius(idx, 8.0), parallel.radius(idx, 8.0));
+    }
+}
+
+// Batch queries must return exactly what the per-point queries return,
+// at any thread count, even though the batch runs in Morton order.
+TEST(KDIndex, batch3D)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    layout->registerDim(Dimension::Id::Z);
+
+    std::mt19937 gen(54321);
+    std::uniform_real_distribution<double> dist(0, 100);
+    const point_count_t count = 5000;
+    for (PointId i = 0; i < count; ++i)
+    {
+        view.setField(Dimension::Id::X, i, dist(gen));
+        view.setField(Dimension::Id::Y, i, dist(gen));
+        view.setField(Dimension::Id::Z, i, dist(gen));
+    }
+
+    KD3Index index(view);
+    index.build();
+
+    PointIdList queries(count);
+    std::iota(queries.begin(), queries.end(), 0);
+
+    const point_count_t k = 10;
+    PointIdList ids;
+    std::vector<double> sqrDists;
+    EXPECT_EQ(index.neighborsBatch(queries, k, ids, &sqrDists, 4), k);
+    EXPECT_EQ(ids.size(), count * k);
+    EXPECT_EQ(sqrDists.size(), count * k);
+    for (PointId q = 0; q < count; q += 577)
+    {
+        PointIdList ref = index.neighbors(q, k);
+        PointIdList got(ids.begin() + q * k, ids.begin() + (q + 1) * k);
+        EXPECT_EQ(ref, got);
+        EXPECT_DOUBLE_EQ(sqrDists[q * k], 0.0);
+    }
+
+    // Single-threaded execution matches the threaded run.
+    PointIdList ids1;
+    EXPECT_EQ(index.neighborsBatch(queries, k, ids1, nullptr, 1), k);
+    EXPECT_EQ(ids, ids1);
+
+    // Coordinate overload - query points that aren't in the view.
+    std::vector<double> pts(count * 3);
+    for (PointId i = 0; i < count; ++i)
+    {
+        pts[3 * i] = view.getFieldAs<double>(Dimension::Id::X, i) + 0.01;
+        pts[3 * i + 1] = view.getFieldAs<double>(Dimension::Id::Y, i) + 0.01;
+        pts[3 * i + 2] = view.getFieldAs<double>(Dimension::Id::Z, i) + 0.01;
+    }
+    PointIdList nearest;
+    EXPECT_EQ(index.neighborsBatch(pts, 1, nearest, nullptr, 4), 1u);
+    EXPECT_EQ(nearest.size(), count);
+    for (PointId q = 0; q < count; q += 577)
+        EXPECT_EQ(nearest[q], q);
+
+    // Radius batch: CSR slices match the per-point radius queries.
+    const double r = 3.0;
+    std::vector<point_count_t> offsets;
+    PointIdList rids;
+    index.radiusBatch(queries, r, offsets, rids, 4);
+    EXPECT_EQ(offsets.size(), count + 1);
+    EXPECT_EQ(offsets.front(), 0u);
+    EXPECT_EQ(offsets.back(), rids.size());
+    for (PointId q = 0; q < count; q += 577)
+    {
+        PointIdList ref = index.radius(q, r);
+        PointIdList got(rids.begin() + offsets[q],
+            rids.begin() + offsets[q + 1]);
+        EXPECT_EQ(ref, got);
+    }
+}
+
+// Cache round trip: a warm-started index answers queries exactly like the
+// one that was built, and a cache for different data or a different key
+// is rejected.
+TEST(KDIndex, cache3D)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    layout->registerDim(Dimension::Id::Z);
+
+    std::mt19937 gen(54321);
+    std::uniform_real_distribution<double> dist(0, 1000);
+    const point_count_t count = 10000;
+    for (PointId i = 0; i < count; ++i)
+    {
+        view.setField(Dimension::Id::X, i, dist(gen));
+        view.setField(Dimension::Id::Y, i, dist(gen));
+        view.setField(Dimension::Id::Z, i, dist(gen));
+    }
+
+    std::string cache = Support::temppath("kdindex.cache");
+    std::string key = Support::datapath("las/autzen_trim.las");
+    FileUtils::deleteFile(cache);
+
+    KD3Index built(view);
+    built.build();
+    EXPECT_TRUE(built.save(cache, key));
+
+    KD3Index warm(view);
+    EXPECT_TRUE(warm.load(cache, key));
+    for (PointId q = 0; q < 10; ++q)
+    {
+        EXPECT_EQ(built.neighbors(q * 977, 8), warm.neighbors(q * 977, 8));
+        EXPECT_EQ(built.radius(q * 977, 25.0), warm.radius(q * 977, 25.0));
+    }
+
+    KD3Index wrongKey(view);
+    EXPECT_FALSE(wrongKey.load(cache, key + "x"));
+
+    view.setField(Dimension::Id::X, 0, -9999.0);
+    KD3Index stale(view);
+    EXPECT_FALSE(stale.load(cache, key));
+
+    FileUtils::deleteFile(cache);
+}
@@ -32,6 +32,8 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <fstream>
+
 #include <pdal/pdal_test_main.hpp>
 
 #include "Support.hpp"
@@ -65,6 +67,21 @@ TEST(PipelineManagerTest, basic)
     EXPECT_EQ(np, 1065U);
 
     EXPECT_TRUE(!std::ifstream(outfile).fail());
+
+    // Execution metrics should cover both stages and account for every
+    // point that flowed through them.
+    MetadataNode metrics = mgr.getMetrics();
+    EXPECT_EQ(metrics.children("stage").size(), 2U);
+    EXPECT_EQ(reader.metrics().m_points, 1065U);
+    EXPECT_EQ(writer.metrics().m_points, 1065U);
+
+    // The reader grew the table; the writer only consumed it.
+    EXPECT_GT(reader.metrics().m_tableGrowth, 0U);
+    EXPECT_GT(reader.metrics().m_growthEvents, 0U);
+    EXPECT_GE(reader.metrics().m_peakTableBytes,
+        reader.metrics().m_tableGrowth);
+    EXPECT_EQ(writer.metrics().m_tableGrowth, 0U);
+
     FileUtils::deleteFile(outfile);
 }
 
@@ -197,6 +214,308 @@ TEST(PipelineManagerTest, arrayPipeline)
     FileUtils::deleteFile(Support::temppath("array-pipeline.las"));
 }
 
+TEST(PipelineManagerTest, dimPushdown)
+{
+    // When every downstream stage enumerates the dimensions it uses,
+    // the reader skips loading the rest.
+    {
+        PipelineManager mgr;
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options cropOpts;
+        cropOpts.add("bounds", "([0,10000000],[0,10000000])");
+        mgr.makeFilter("filters.crop", reader, cropOpts);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, 1065U);
+
+        PointLayoutPtr layout = mgr.pointTable().layout();
+        EXPECT_TRUE(layout->hasDim(Dimension::Id::X));
+        EXPECT_TRUE(layout->hasDim(Dimension::Id::Y));
+        EXPECT_TRUE(layout->hasDim(Dimension::Id::Z));
+        EXPECT_FALSE(layout->hasDim(Dimension::Id::Intensity));
+        EXPECT_FALSE(layout->hasDim(Dimension::Id::Red));
+    }
+
+    // Dimensions named by downstream stages are kept.
+    {
+        PipelineManager mgr;
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options sortOpts;
+        sortOpts.add("dimension", "Intensity");
+        mgr.makeFilter("filters.sort", reader, sortOpts);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, 1065U);
+
+        PointLayoutPtr layout = mgr.pointTable().layout();
+        EXPECT_TRUE(layout->hasDim(Dimension::Id::Intensity));
+        EXPECT_FALSE(layout->hasDim(Dimension::Id::Red));
+    }
+
+    // A stage that can't enumerate its dimensions disables pruning.
+    {
+        PipelineManager mgr;
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        mgr.makeFilter("filters.stats", reader);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, 1065U);
+
+        PointLayoutPtr layout = mgr.pointTable().layout();
+        EXPECT_TRUE(layout->hasDim(Dimension::Id::Intensity));
+        EXPECT_TRUE(layout->hasDim(Dimension::Id::Red));
+    }
+}
+
+TEST(PipelineManagerTest, boundsPushdown)
+{
+    // A crop whose bounds are disjoint from the file extent lets the
+    // reader skip the file without decoding any points.
+    {
+        PipelineManager mgr;
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options cropOpts;
+        cropOpts.add("bounds", "([0,10],[0,10])");
+        mgr.makeFilter("filters.crop", reader, cropOpts);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, 0U);
+        EXPECT_EQ(reader.metrics().m_points, 0U);
+    }
+
+    // Overlapping bounds read normally.
+    {
+        PipelineManager mgr;
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options cropOpts;
+        cropOpts.add("bounds", "([0,10000000],[0,10000000])");
+        mgr.makeFilter("filters.crop", reader, cropOpts);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, 1065U);
+        EXPECT_EQ(reader.metrics().m_points, 1065U);
+    }
+
+    // Cropping to the outside of the bounds can't be pushed down.
+    {
+        PipelineManager mgr;
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options cropOpts;
+        cropOpts.add("bounds", "([0,10],[0,10])");
+        cropOpts.add("outside", true);
+        mgr.makeFilter("filters.crop", reader, cropOpts);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, 1065U);
+        EXPECT_EQ(reader.metrics().m_points, 1065U);
+    }
+}
+
+TEST(PipelineManagerTest, rangePushdown)
+{
+    // filters.range reports one enclosing interval per dimension from
+    // its raw limits.  Ranges of the same dimension are ORed, so they
+    // collapse to their envelope; a negated range admits values on both
+    // sides and leaves its dimension unconstrained.
+    PipelineManager mgr;
+
+    Stage& reader = mgr.makeReader(
+        Support::datapath("las/1.2-with-color.las"), "readers.las");
+    Options rangeOpts;
+    rangeOpts.add("limits",
+        "Z[400:500], Z[600:700], Classification![7:7], Intensity[10:]");
+    Stage& f = mgr.makeFilter("filters.range", reader, rangeOpts);
+
+    std::vector<DimInterval> ranges;
+    EXPECT_TRUE(f.rangeBounds(ranges));
+    ASSERT_EQ(ranges.size(), 2U);
+    EXPECT_EQ(ranges[0].m_name, "Intensity");
+    EXPECT_DOUBLE_EQ(ranges[0].m_min, 10.0);
+    EXPECT_EQ(ranges[1].m_name, "Z");
+    EXPECT_DOUBLE_EQ(ranges[1].m_min, 400.0);
+    EXPECT_DOUBLE_EQ(ranges[1].m_max, 700.0);
+
+    // Pushdown is only a hint - the filter still runs exactly.
+    point_count_t np = mgr.execute();
+    EXPECT_LE(np, 1065U);
+}
+
+TEST(PipelineManagerTest, filterReorder)
+{
+    // A range on a dimension reprojection doesn't touch commutes with
+    // it, so the selection is hoisted ahead of the transform.
+    {
+        PipelineManager mgr;
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options repOpts;
+        repOpts.add("out_srs", "EPSG:4326");
+        Stage& rep = mgr.makeFilter("filters.reprojection", reader, repOpts);
+        Options rangeOpts;
+        rangeOpts.add("limits", "Intensity[0:200]");
+        Stage& range = mgr.makeFilter("filters.range", rep, rangeOpts);
+
+        mgr.prepare();
+        EXPECT_EQ(range.getInputs()[0], &reader);
+        EXPECT_EQ(rep.getInputs()[0], &range);
+        EXPECT_EQ(mgr.getStage(), &rep);
+    }
+
+    // A range on position depends on the reprojection and stays put.
+    {
+        PipelineManager mgr;
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options repOpts;
+        repOpts.add("out_srs", "EPSG:4326");
+        Stage& rep = mgr.makeFilter("filters.reprojection", reader, repOpts);
+        Options rangeOpts;
+        rangeOpts.add("limits", "X[-180:180]");
+        Stage& range = mgr.makeFilter("filters.range", rep, rangeOpts);
+
+        mgr.prepare();
+        EXPECT_EQ(rep.getInputs()[0], &reader);
+        EXPECT_EQ(range.getInputs()[0], &rep);
+    }
+
+    // Dimension names are case-insensitive - a lowercase spelling of a
+    // mutated dimension still blocks the hoist.
+    {
+        PipelineManager mgr;
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options repOpts;
+        repOpts.add("out_srs", "EPSG:4326");
+        Stage& rep = mgr.makeFilter("filters.reprojection", reader, repOpts);
+        Options rangeOpts;
+        rangeOpts.add("limits", "z[0:100]");
+        Stage& range = mgr.makeFilter("filters.range", rep, rangeOpts);
+
+        mgr.prepare();
+        EXPECT_EQ(rep.getInputs()[0], &reader);
+        EXPECT_EQ(range.getInputs()[0], &rep);
+    }
+}
+
+TEST(PipelineManagerTest, memoryLimit)
+{
+    // A pipeline estimated over budget that can't stream runs against
+    // a disk-backed table.
+    {
+        PipelineManager mgr;
+        mgr.setMemoryLimit(1024);
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options sortOpts;
+        sortOpts.add("dimension", "X");
+        mgr.makeFilter("filters.sort", reader, sortOpts);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, 1065U);
+        EXPECT_TRUE(dynamic_cast<MmapPointTable *>(&mgr.pointTable()));
+    }
+
+    // One that can stream falls back to stream mode.
+    {
+        PipelineManager mgr;
+        mgr.setMemoryLimit(1024);
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options cropOpts;
+        cropOpts.add("bounds", "([0,10000000],[0,10000000])");
+        mgr.makeFilter("filters.crop", reader, cropOpts);
+
+        PipelineManager::ExecResult res = mgr.execute(ExecMode::Standard);
+        EXPECT_EQ(res.m_mode, ExecMode::Stream);
+    }
+
+    // Under budget, execution is unchanged.
+    {
+        PipelineManager mgr;
+        mgr.setMemoryLimit(100 * 1024 * 1024);
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        Options sortOpts;
+        sortOpts.add("dimension", "X");
+        mgr.makeFilter("filters.sort", reader, sortOpts);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, 1065U);
+        EXPECT_TRUE(dynamic_cast<PointTable *>(&mgr.pointTable()));
+    }
+}
+
+TEST(PipelineManagerTest, checkpoint)
+{
+    std::string ckp = Support::temppath("stream.ckp");
+    std::string out = Support::temppath("checkpoint_out.txt");
+
+    auto lineCount = [](const std::string& filename)
+    {
+        std::ifstream in(filename);
+        std::string line;
+        size_t count = 0;
+        while (std::getline(in, line))
+            count++;
+        return count;
+    };
+
+    // An existing checkpoint resumes the reader mid-file and is removed
+    // when the run completes.
+    {
+        std::ofstream chk(ckp);
+        chk << 1000 << "\n";
+    }
+    {
+        PipelineManager mgr;
+        mgr.setCheckpoint(ckp);
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        mgr.makeWriter(out, "writers.text", reader);
+
+        PipelineManager::ExecResult res = mgr.execute(ExecMode::PreferStream);
+        EXPECT_EQ(res.m_mode, ExecMode::Stream);
+    }
+    // Header line plus the 65 points past the resume position.
+    EXPECT_EQ(lineCount(out), 66U);
+    EXPECT_FALSE(FileUtils::fileExists(ckp));
+
+    // Without an existing checkpoint the whole file streams, and a
+    // completed run leaves no checkpoint behind.
+    {
+        PipelineManager mgr;
+        mgr.setCheckpoint(ckp);
+
+        Stage& reader = mgr.makeReader(
+            Support::datapath("las/1.2-with-color.las"), "readers.las");
+        mgr.makeWriter(out, "writers.text", reader);
+
+        PipelineManager::ExecResult res = mgr.execute(ExecMode::PreferStream);
+        EXPECT_EQ(res.m_mode, ExecMode::Stream);
+    }
+    EXPECT_EQ(lineCount(out), 1066U);
+    EXPECT_FALSE(FileUtils::fileExists(ckp));
+}
+
 TEST(PipelineManagerTest, replace)
 {
     PipelineManager mgr;
@@ -105,6 +105,41 @@ TEST(PointTable, resolveType)
     EXPECT_EQ(layout->dimType(Id::Red), Type::Double);
 }
 
+TEST(PointTable, fingerprint)
+{
+    using namespace Dimension;
+
+    PointTable t1;
+    PointLayoutPtr l1(t1.layout());
+    PointTable t2;
+    PointLayoutPtr l2(t2.layout());
+
+    // Identical schemas fingerprint the same regardless of the order in
+    // which the dimensions were registered.
+    l1->registerDim(Id::X);
+    l1->registerDim(Id::Intensity, Type::Unsigned16);
+    l1->registerOrAssignDim("Foo", Type::Double);
+
+    l2->registerOrAssignDim("Foo", Type::Double);
+    l2->registerDim(Id::Intensity, Type::Unsigned16);
+    l2->registerDim(Id::X);
+
+    EXPECT_EQ(l1->fingerprint(), l2->fingerprint());
+
+    // Re-registering the same schema changes nothing.
+    uint64_t fp = l1->fingerprint();
+    l1->registerDim(Id::X);
+    l1->registerDim(Id::Intensity, Type::Unsigned16);
+    EXPECT_EQ(l1->registerOrAssignDim("Foo", Type::Double),
+        l1->findDim("Foo"));
+    EXPECT_EQ(l1->fingerprint(), fp);
+
+    // Widening a dimension's type does.
+    l1->registerDim(Id::Intensity, Type::Double);
+    EXPECT_NE(l1->fingerprint(), fp);
+    EXPECT_NE(l1->fingerprint(), l2->fingerprint());
+}
+
 TEST(PointTable, userView)
 {
     class UserTable : public PointTable
@@ -255,6 +290,61 @@ TEST(PointTable, simple)
 
     ContiguousPointTable t2;
     simpleTest(t2);
+
+    ColumnPointTable t3;
+    simpleTest(t3);
+}
+
+TEST(PointTable, mmap)
+{
+    std::string backing;
+    {
+        MmapPointTable table;
+        backing = table.filename();
+        EXPECT_TRUE(FileUtils::fileExists(backing));
+        simpleTest(table);
+    }
+    // The backing file goes away with the table.
+    EXPECT_FALSE(FileUtils::fileExists(backing));
+
+    // Write across a block boundary (blocks hold 65536 points).
+    MmapPointTable table;
+    table.layout()->registerDim(Dimension::Id::X);
+    table.finalize();
+
+    PointView v(table);
+    for (PointId id = 0; id < 70000; id++)
+        v.setField(Dimension::Id::X, id, id * 3);
+    for (PointId id = 0; id < 70000; id++)
+        EXPECT_EQ(id * 3, v.getFieldAs<PointId>(Dimension::Id::X, id));
+}
+
+TEST(PointTable, column)
+{
+    ColumnPointTable table;
+    PointLayoutPtr layout = table.layout();
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Intensity);
+    table.finalize();
+
+    PointView v(table);
+    for (PointId id = 0; id < 1000; id++)
+    {
+        v.setField(Dimension::Id::X, id, id * 10);
+        v.setField(Dimension::Id::Intensity, id, id);
+    }
+
+    // Each dimension is a contiguous stream.
+    const double *x = (const double *)table.dimBuffer(Dimension::Id::X);
+    const uint16_t *i =
+        (const uint16_t *)table.dimBuffer(Dimension::Id::Intensity);
+    for (PointId id = 0; id < 1000; id++)
+    {
+        EXPECT_DOUBLE_EQ(x[id], id * 10.0);
+        EXPECT_EQ(i[id], id);
+    }
+    EXPECT_EQ(table.dimBuffer(Dimension::Id::Blue), nullptr);
 }
 
 } // namespace
@@ -35,11 +35,13 @@
 #include <pdal/pdal_test_main.hpp>
 
 #include <array>
+#include <cstring>
 #include <random>
 
 #include <pdal/EigenUtils.hpp>
 #include <pdal/PointView.hpp>
 #include <pdal/PDALUtils.hpp>
+#include <pdal/TypedDimView.hpp>
 #include "Support.hpp"
 
 using namespace pdal;
@@ -94,6 +96,135 @@ TEST(PointViewTest, getSet)
     verifyTestView(*view.get(), 1);
 }
 
+TEST(PointViewTest, batchField)
+{
+    PointTable table;
+    PointViewPtr view = makeTestView(table);
+
+    // Fetch a range with conversion and compare against per-point access.
+    double vals[17];
+    view->getFieldBatch(Dimension::Id::X, 0, 17, vals);
+    for (PointId i = 0; i < 17; ++i)
+        EXPECT_DOUBLE_EQ(vals[i],
+            view->getFieldAs<double>(Dimension::Id::X, i));
+
+    // Partial range with a different conversion.
+    uint16_t shorts[5];
+    view->getFieldBatch(Dimension::Id::Classification, 10, 5, shorts);
+    for (PointId i = 0; i < 5; ++i)
+        EXPECT_EQ(shorts[i],
+            view->getFieldAs<uint16_t>(Dimension::Id::Classification, 10 + i));
+
+    // Store a batch and make sure it lands.
+    double newVals[17];
+    for (PointId i = 0; i < 17; ++i)
+        newVals[i] = i * 2.5;
+    view->setFieldBatch(Dimension::Id::Y, 0, 17, newVals);
+    for (PointId i = 0; i < 17; ++i)
+        EXPECT_DOUBLE_EQ(view->getFieldAs<double>(Dimension::Id::Y, i),
+            i * 2.5);
+
+    // Runtime-typed stores, both for the storage type and a converting
+    // store.
+    int32_t ints[5] = { 50, 51, 52, 53, 54 };
+    view->setFieldBatch(Dimension::Id::Y, Dimension::Type::Signed32,
+        10, 5, ints);
+    for (PointId i = 0; i < 5; ++i)
+        EXPECT_EQ(view->getFieldAs<int32_t>(Dimension::Id::Y, 10 + i),
+            (int32_t)(50 + i));
+
+    float floats[5] = { 1.5f, 2.5f, 3.5f, 4.5f, 5.5f };
+    view->setFieldBatch(Dimension::Id::Z, Dimension::Type::Float,
+        0, 5, floats);
+    for (PointId i = 0; i < 5; ++i)
+        EXPECT_DOUBLE_EQ(view->getFieldAs<double>(Dimension::Id::Z, i),
+            1.5 + i);
+}
+
+TEST(PointViewTest, packedData)
+{
+    PointTable table;
+    PointViewPtr view = makeTestView(table);
+
+    DimTypeList dims {
+        DimType(Dimension::Id::X, Dimension::Type::Signed32),
+        DimType(Dimension::Id::Y, Dimension::Type::Double),
+        DimType(Dimension::Id::Classification, Dimension::Type::Unsigned8)
+    };
+    size_t recSize = 4 + 8 + 1;
+
+    // A range extraction matches per-point packing.
+    std::vector<char> packed(recSize * 17);
+    view->getPackedData(dims, 0, 17, packed.data());
+    std::vector<char> single(recSize);
+    for (PointId i = 0; i < 17; ++i)
+    {
+        view->getPackedPoint(dims, i, single.data());
+        EXPECT_EQ(memcmp(single.data(), packed.data() + i * recSize,
+            recSize), 0);
+    }
+
+    // The runtime-typed column form matches per-point conversion, both
+    // for the storage type and a converting fetch.
+    int32_t ints[17];
+    view->getFieldBatch(Dimension::Id::X, Dimension::Type::Signed32,
+        0, 17, ints);
+    double doubles[7];
+    view->getFieldBatch(Dimension::Id::X, Dimension::Type::Double,
+        5, 7, doubles);
+    for (PointId i = 0; i < 17; ++i)
+        EXPECT_EQ(ints[i], view->getFieldAs<int32_t>(Dimension::Id::X, i));
+    for (PointId i = 0; i < 7; ++i)
+        EXPECT_DOUBLE_EQ(doubles[i],
+            view->getFieldAs<double>(Dimension::Id::X, 5 + i));
+}
+
+TEST(PointViewTest, slice)
+{
+    PointTable table;
+    PointLayoutPtr layout(table.layout());
+    layout->registerDim(Dimension::Id::X);
+
+    PointViewPtr view(new PointView(table));
+    for (PointId i = 0; i < 100; ++i)
+        view->setField(Dimension::Id::X, i, (double)i);
+
+    // A slice exposes the parent's points shifted by the start position.
+    PointViewPtr s = view->slice(20, 30);
+    EXPECT_EQ(s->size(), 30u);
+    for (PointId i = 0; i < s->size(); ++i)
+        EXPECT_DOUBLE_EQ(s->getFieldAs<double>(Dimension::Id::X, i),
+            (double)(20 + i));
+
+    // Batched access goes through the contiguous fast path.
+    double vals[30];
+    s->getFieldBatch(Dimension::Id::X, 0, 30, vals);
+    for (PointId i = 0; i < 30; ++i)
+        EXPECT_DOUBLE_EQ(vals[i], (double)(20 + i));
+
+    // A count beyond the parent is clamped.
+    EXPECT_EQ(view->slice(90, 30)->size(), 10u);
+
+    // Mutating the slice's ID mapping detaches it from the parent.
+    PointViewPtr reversed = view->makeNew();
+    for (PointId i = 100; i-- > 0;)
+        reversed->appendPoint(*view, i);
+    PointViewPtr r = reversed->slice(10, 10);
+    EXPECT_DOUBLE_EQ(r->getFieldAs<double>(Dimension::Id::X, 0), 89.0);
+    r->appendPoint(*view, 0);
+    EXPECT_EQ(r->size(), 11u);
+    EXPECT_EQ(reversed->size(), 100u);
+    EXPECT_DOUBLE_EQ(reversed->getFieldAs<double>(Dimension::Id::X, 10),
+        89.0);
+
+    // And mutating the parent's mapping doesn't disturb the slice.
+    PointViewPtr q = reversed->slice(0, 5);
+    reversed->appendPoint(*view, 50);
+    EXPECT_EQ(reversed->size(), 101u);
+    EXPECT_EQ(q->size(), 5u);
+    EXPECT_DOUBLE_EQ(q->getFieldAs<double>(Dimension::Id::X, 0), 99.0);
+}
+
 TEST(PointViewTest, getAsUint8)
 {
     PointTable table;
@@ -290,6 +421,39 @@ TEST(PointViewTest, getFloatNan)
     EXPECT_NO_THROW(view->getFieldAs<float>(Dimension::Id::ScanAngleRank, 0));
 }
 
+TEST(PointViewTest, typedDimView)
+{
+    PointTable table;
+    PointLayoutPtr layout(table.layout());
+    layout->registerDim(Dimension::Id::X, Dimension::Type::Double);
+    layout->registerDim(Dimension::Id::Intensity, Dimension::Type::Unsigned16);
+    table.finalize();
+
+    PointViewPtr view(new PointView(table));
+    view->setField(Dimension::Id::X, 0, 12.5);
+    view->setField(Dimension::Id::Intensity, 0, 1000);
+
+    TypedDimView<double> x(*layout, Dimension::Id::X);
+    EXPECT_TRUE(x.valid());
+    EXPECT_TRUE(x.direct());
+    EXPECT_DOUBLE_EQ(x.get(*view, 0), 12.5);
+    x.set(*view, 0, 13.5);
+    EXPECT_DOUBLE_EQ(view->getFieldAs<double>(Dimension::Id::X, 0), 13.5);
+
+    // Conversion path - storage is uint16_t, access is double.
+    TypedDimView<double> i(*layout, Dimension::Id::Intensity);
+    EXPECT_TRUE(i.valid());
+    EXPECT_FALSE(i.direct());
+    EXPECT_DOUBLE_EQ(i.get(*view, 0), 1000.0);
+    EXPECT_THROW(i.set(*view, 0, -1.0), pdal_error);
+
+    PointRef point(view->point(0));
+    EXPECT_DOUBLE_EQ(x.get(point), 13.5);
+
+    TypedDimView<double> missing(*layout, Dimension::Id::Red);
+    EXPECT_FALSE(missing.valid());
+}
+
 // Per discussions with @abellgithub (https://github.com/gadomski/PDAL/commit/c1d54e56e2de841d37f2a1b1c218ed723053f6a9#commitcomment-14415138)
 // we only do bounds checking on `PointView`s when in debug mode.
 #ifndef NDEBUG
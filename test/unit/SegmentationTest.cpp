@@ -184,3 +184,47 @@ TEST(SegmentationTest, SegmentReturns)
     EXPECT_EQ(3u, first->size());
     EXPECT_EQ(1u, second->size());
 }
+
+TEST(SegmentationTest, IgnoreDimRanges)
+{
+    using namespace Segmentation;
+
+    PointTable table;
+    PointLayoutPtr layout(table.layout());
+
+    layout->registerDim(Dimension::Id::Classification);
+    layout->registerDim(Dimension::Id::Intensity);
+
+    PointViewPtr src(new PointView(table));
+    for (PointId i = 0; i < 100; ++i)
+    {
+        src->setField(Dimension::Id::Classification, i, i % 5);
+        src->setField(Dimension::Id::Intensity, i, i);
+    }
+
+    // Two ranges on the same dimension OR together; a range on another
+    // dimension ANDs with them, matching DimRange::pointPasses().
+    DimRange cls2("Classification", 2, 2, true, true, false);
+    cls2.m_id = Dimension::Id::Classification;
+    DimRange cls4("Classification", 4, 4, true, true, false);
+    cls4.m_id = Dimension::Id::Classification;
+    DimRange inten("Intensity", 0, 49, true, true, false);
+    inten.m_id = Dimension::Id::Intensity;
+
+    std::vector<DimRange> ranges { cls2, cls4, inten };
+    PointViewPtr keep = src->makeNew();
+    PointViewPtr ignore = src->makeNew();
+    ignoreDimRanges(ranges, src, keep, ignore);
+
+    // Classification 2 or 4 with intensity below 50: 20 of 100 points.
+    EXPECT_EQ(20u, ignore->size());
+    EXPECT_EQ(80u, keep->size());
+
+    // Both outputs preserve input order.
+    for (PointId i = 1; i < ignore->size(); ++i)
+        EXPECT_LT(ignore->getFieldAs<uint16_t>(Dimension::Id::Intensity,
+            i - 1), ignore->getFieldAs<uint16_t>(Dimension::Id::Intensity, i));
+    for (PointId i = 1; i < keep->size(); ++i)
+        EXPECT_LT(keep->getFieldAs<uint16_t>(Dimension::Id::Intensity, i - 1),
+            keep->getFieldAs<uint16_t>(Dimension::Id::Intensity, i));
+}
@@ -0,0 +1,161 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its contributors
+*       may be used to endorse or promote products derived from this
+*       software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <map>
+
+#include <pdal/util/SpaceFillingCurve.hpp>
+
+using namespace pdal;
+
+namespace
+{
+
+// Bit-at-a-time reference interleave.
+uint64_t slowMorton2(uint32_t x, uint32_t y)
+{
+    uint64_t code = 0;
+    for (int b = 0; b < 32; ++b)
+    {
+        code |= (uint64_t)((y >> b) & 1) << (2 * b);
+        code |= (uint64_t)((x >> b) & 1) << (2 * b + 1);
+    }
+    return code;
+}
+
+uint64_t slowMorton3(uint32_t x, uint32_t y, uint32_t z)
+{
+    uint64_t code = 0;
+    for (int b = 0; b < 21; ++b)
+    {
+        code |= (uint64_t)((z >> b) & 1) << (3 * b);
+        code |= (uint64_t)((y >> b) & 1) << (3 * b + 1);
+        code |= (uint64_t)((x >> b) & 1) << (3 * b + 2);
+    }
+    return code;
+}
+
+}
+
+TEST(SpaceFillingCurveTest, morton2d)
+{
+    EXPECT_EQ(curve::mortonEncode(0u, 0u), 0u);
+    EXPECT_EQ(curve::mortonEncode(1u, 0u), 2u);
+    EXPECT_EQ(curve::mortonEncode(0u, 1u), 1u);
+    EXPECT_EQ(curve::mortonEncode(0xffffffffu, 0xffffffffu),
+        0xffffffffffffffffULL);
+
+    uint32_t vals[] = { 0, 1, 2, 3, 0x1234, 0xffff, 0xdeadbeef, 0xffffffff };
+    for (uint32_t x : vals)
+        for (uint32_t y : vals)
+            EXPECT_EQ(curve::mortonEncode(x, y), slowMorton2(x, y));
+}
+
+TEST(SpaceFillingCurveTest, morton3d)
+{
+    EXPECT_EQ(curve::mortonEncode(0u, 0u, 1u), 1u);
+    EXPECT_EQ(curve::mortonEncode(0u, 1u, 0u), 2u);
+    EXPECT_EQ(curve::mortonEncode(1u, 0u, 0u), 4u);
+
+    uint32_t vals[] = { 0, 1, 5, 0x1234, 0xffff, 0x1fffff };
+    for (uint32_t x : vals)
+        for (uint32_t y : vals)
+            for (uint32_t z : vals)
+                EXPECT_EQ(curve::mortonEncode(x, y, z),
+                    slowMorton3(x, y, z));
+}
+
+TEST(SpaceFillingCurveTest, morton16)
+{
+    uint32_t vals[] = { 0, 1, 0x1234, 0x8000, 0xffff };
+    for (uint32_t x : vals)
+        for (uint32_t y : vals)
+            EXPECT_EQ(curve::mortonEncode16(x, y),
+                (uint32_t)slowMorton2(x & 0xffff, y & 0xffff));
+}
+
+TEST(SpaceFillingCurveTest, bitReverse)
+{
+    EXPECT_EQ(curve::bitReverse(0u), 0u);
+    EXPECT_EQ(curve::bitReverse(1u), 0x80000000u);
+    EXPECT_EQ(curve::bitReverse(0x80000000u), 1u);
+    EXPECT_EQ(curve::bitReverse(0xffffffffu), 0xffffffffu);
+
+    uint32_t vals[] = { 0x12345678, 0xdeadbeef, 0x00ff00ff, 5 };
+    for (uint32_t v : vals)
+        EXPECT_EQ(curve::bitReverse(curve::bitReverse(v)), v);
+}
+
+TEST(SpaceFillingCurveTest, hilbert)
+{
+    EXPECT_EQ(curve::hilbertEncode(0, 0), 0u);
+
+    // The curve visits each cell of a 64x64 corner block before any
+    // other, since the block's cells occupy the lowest index range...
+    std::map<uint64_t, std::pair<uint32_t, uint32_t>> cells;
+    for (uint32_t x = 0; x < 64; ++x)
+        for (uint32_t y = 0; y < 64; ++y)
+            cells[curve::hilbertEncode(x, y)] = std::make_pair(x, y);
+    EXPECT_EQ(cells.size(), (size_t)(64 * 64));
+    EXPECT_EQ(cells.rbegin()->first, (uint64_t)(64 * 64 - 1));
+
+    // ...and consecutive indices are adjacent cells.
+    auto prev = cells.begin();
+    for (auto it = std::next(prev); it != cells.end(); prev = it++)
+    {
+        uint32_t dx = it->second.first - prev->second.first;
+        uint32_t dy = it->second.second - prev->second.second;
+        EXPECT_EQ((dx * dx) + (dy * dy), 1u);
+    }
+}
+
+TEST(SpaceFillingCurveTest, arrays)
+{
+    uint32_t x[] = { 0, 1, 0xffff, 0x1234 };
+    uint32_t y[] = { 1, 0, 0x8000, 0x4321 };
+    uint32_t z[] = { 2, 3, 0x0001, 0x1111 };
+    uint64_t codes[4];
+
+    curve::mortonEncode(x, y, 4, codes);
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_EQ(codes[i], curve::mortonEncode(x[i], y[i]));
+
+    curve::mortonEncode(x, y, z, 4, codes);
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_EQ(codes[i], curve::mortonEncode(x[i], y[i], z[i]));
+
+    curve::hilbertEncode(x, y, 4, codes);
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_EQ(codes[i], curve::hilbertEncode(x[i], y[i]));
+}
@@ -107,6 +107,58 @@ TEST(Streaming, filter)
     EXPECT_EQ(cnt, 400);
 }
 
+// Same result with a double-buffered table - the reader fills the next
+// chunk while the callback filter consumes the current one, but points
+// must still arrive in read order.
+// A table built with capacity 0 picks its own chunk size from the
+// layout's point size when finalized.
+TEST(Streaming, autoCapacity)
+{
+    FixedPointTable t(0);
+    t.layout()->registerDim(Dimension::Id::X);
+    t.layout()->registerDim(Dimension::Id::Y);
+    t.layout()->registerDim(Dimension::Id::Z);
+    EXPECT_EQ(t.capacity(), 0u);
+    t.finalize();
+    EXPECT_GE(t.capacity(), 1024u);
+    EXPECT_LE(t.capacity(), 65536u);
+
+    // An explicit capacity is left alone.
+    FixedPointTable t2(500);
+    t2.layout()->registerDim(Dimension::Id::X);
+    t2.finalize();
+    EXPECT_EQ(t2.capacity(), 500u);
+}
+
+TEST(Streaming, doubleBuffered)
+{
+    Options ro;
+    ro.add("bounds", BOX3D(0, 0, 0, 999, 999, 999));
+    ro.add("mode", "ramp");
+    ro.add("count", 1000);
+    FauxReader r;
+    r.setOptions(ro);
+
+    StreamCallbackFilter f;
+    int cnt = 0;
+    auto cb = [&cnt](PointRef& point)
+    {
+        EXPECT_EQ(point.getFieldAs<int>(Dimension::Id::X), cnt);
+        EXPECT_EQ(point.getFieldAs<int>(Dimension::Id::Y), cnt);
+        EXPECT_EQ(point.getFieldAs<int>(Dimension::Id::Z), cnt);
+        cnt++;
+        return true;
+    };
+    f.setCallback(cb);
+    f.setInput(r);
+
+    // A capacity that doesn't divide the count so the last chunk is partial.
+    DoubleBufferedPointTable t(30);
+    f.prepare(t);
+    f.execute(t);
+    EXPECT_EQ(cnt, 1000);
+}
+
 namespace
 {
 
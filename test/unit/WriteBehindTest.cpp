@@ -0,0 +1,124 @@
+/******************************************************************************
+* Copyright (c) 2020, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <pdal/util/FileUtils.hpp>
+#include <pdal/util/WriteBehind.hpp>
+
+#include "Support.hpp"
+
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace pdal;
+
+namespace
+{
+
+std::string readAll(const std::string& filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+} // unnamed namespace
+
+// Data written through a WriteBehindBuf should match what a plain
+// stream would produce, including writes larger than the internal
+// buffers.
+TEST(WriteBehindTest, roundtrip)
+{
+    std::string tmp(Support::temppath("writebehind.tmp"));
+    FileUtils::deleteFile(tmp);
+
+    std::string expected;
+    {
+        // Small buffers so the test wraps the ring many times.
+        WriteBehindBuf buf(1024, 3);
+        EXPECT_TRUE(buf.open(tmp));
+        std::ostream out(&buf);
+
+        std::mt19937 rng(314159);
+        for (int i = 0; i < 500; ++i)
+        {
+            std::vector<char> chunk(1 + (rng() % 5000));
+            for (char& c : chunk)
+                c = (char)rng();
+            out.write(chunk.data(), chunk.size());
+            expected.append(chunk.data(), chunk.size());
+        }
+        out.flush();
+        EXPECT_TRUE(out.good());
+        buf.close();
+    }
+    EXPECT_EQ(readAll(tmp), expected);
+    FileUtils::deleteFile(tmp);
+}
+
+// Writers rewind to patch headers after the points are written - seeks
+// and tellp must behave like an ordinary file stream.
+TEST(WriteBehindTest, seek)
+{
+    std::string tmp(Support::temppath("writebehind_seek.tmp"));
+    FileUtils::deleteFile(tmp);
+
+    {
+        WriteBehindBuf buf(1024, 3);
+        EXPECT_TRUE(buf.open(tmp));
+        std::ostream out(&buf);
+
+        std::string body(10000, 'x');
+        out.write(body.data(), body.size());
+        EXPECT_EQ(out.tellp(), (std::streampos)10000);
+
+        out.seekp(100);
+        out.write("HEADER", 6);
+        out.seekp(0, std::ios::end);
+        EXPECT_EQ(out.tellp(), (std::streampos)10000);
+        out.write("TAIL", 4);
+        EXPECT_TRUE(out.good());
+        buf.close();
+    }
+
+    std::string contents = readAll(tmp);
+    EXPECT_EQ(contents.size(), (size_t)10004);
+    EXPECT_EQ(contents.substr(100, 6), "HEADER");
+    EXPECT_EQ(contents.substr(10000, 4), "TAIL");
+    FileUtils::deleteFile(tmp);
+}
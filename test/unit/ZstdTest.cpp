@@ -81,3 +81,43 @@ TEST(Compression, zstd)
     decompressor.done();
 }
 
+TEST(Compression, zstdMt)
+{
+    std::default_random_engine generator;
+    std::uniform_int_distribution<int> dist((std::numeric_limits<int>::min)());
+
+    std::vector<int> orig(1000357);
+    int val = dist(generator);
+    for (size_t i = 0; i < orig.size(); ++i)
+    {
+        orig[i] = val++;
+        if (i % 100 == 0)
+            val = dist(generator);
+    }
+
+    std::vector<char> compressed;
+    auto cb = [&compressed](char *buf, size_t bufsize)
+    {
+        compressed.insert(compressed.end(), buf, buf + bufsize);
+    };
+
+    size_t s = orig.size() * sizeof(int);
+    char *sp = reinterpret_cast<char *>(orig.data());
+
+    // Multithreaded compression with long-distance matching - the output
+    // must decompress to the input like the single-threaded variant.
+    ZstdCompressor compressor(cb, 5, 3, 24);
+    compressor.compress(sp, s);
+    compressor.done();
+
+    auto verifier = [&sp](char *buf, size_t bufsize)
+    {
+        EXPECT_EQ(memcmp(buf, sp, bufsize), 0);
+        sp += bufsize;
+    };
+
+    ZstdDecompressor decompressor(verifier, 24);
+    decompressor.decompress(compressed.data(), compressed.size());
+    decompressor.done();
+}
+
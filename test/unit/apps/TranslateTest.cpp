@@ -235,6 +235,33 @@ TEST(TranslateTest, issue_2114)
     EXPECT_FALSE(FileUtils::fileExists(Support::temppath("out4.las")));
 }
 
+// A las-to-las translation with no filters or stage options copies the
+// file verbatim instead of decoding and re-encoding the points.
+TEST(TranslateTest, rawCopy)
+{
+    std::string output;
+    std::string in = Support::datapath("las/autzen_trim.las");
+    std::string out = Support::temppath("rawcopy.las");
+
+    FileUtils::deleteFile(out);
+    EXPECT_EQ(runTranslate(in + " " + out, output), 0);
+    EXPECT_TRUE(Support::compare_files(out, in));
+
+    // A filter in the chain disables the copy - the output is rewritten
+    // with writer defaults and differs from the source.
+    FileUtils::deleteFile(out);
+    EXPECT_EQ(runTranslate(in + " " + out + " -f filters.stats", output), 0);
+    EXPECT_FALSE(Support::compare_files(out, in));
+
+    // So does a stage option.
+    FileUtils::deleteFile(out);
+    EXPECT_EQ(runTranslate(in + " " + out +
+        " --writers.las.system_id=foo", output), 0);
+    EXPECT_FALSE(Support::compare_files(out, in));
+
+    FileUtils::deleteFile(out);
+}
+
 TEST(TranslateTest, issue2835)
 {
     FileUtils::deleteFile("devnull");
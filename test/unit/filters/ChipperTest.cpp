@@ -104,6 +104,45 @@ TEST(ChipperTest, test_construction)
 }
 
 
+// The partitioning should not depend on the number of threads used.
+TEST(ChipperTest, parallel)
+{
+    auto chip = [](size_t threads)
+    {
+        LasReader reader;
+        Options rOpts;
+        rOpts.add("filename", Support::datapath("las/autzen_trim.las"));
+        reader.setOptions(rOpts);
+
+        ChipperFilter chipper;
+        Options cOpts;
+        cOpts.add("capacity", 100);
+        cOpts.add("threads", threads);
+        chipper.setOptions(cOpts);
+        chipper.setInput(reader);
+
+        PointTable table;
+        chipper.prepare(table);
+        return chipper.execute(table);
+    };
+
+    PointViewSet serial = chip(1);
+    PointViewSet parallel = chip(4);
+    EXPECT_EQ(serial.size(), parallel.size());
+
+    // Gather each run's chips as sorted point counts and compare.
+    auto sizes = [](const PointViewSet& set)
+    {
+        std::vector<point_count_t> counts;
+        for (const PointViewPtr& v : set)
+            counts.push_back(v->size());
+        std::sort(counts.begin(), counts.end());
+        return counts;
+    };
+    EXPECT_EQ(sizes(serial), sizes(parallel));
+}
+
+
 // Test that the chipper runs with multiple inputs.
 TEST(ChipperTest, issue_2479)
 {
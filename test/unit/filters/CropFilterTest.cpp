@@ -214,6 +214,41 @@ TEST(CropFilterTest, test_crop_polygon)
     FileUtils::closeFile(wkt_stream);
 }
 
+// The crop shouldn't depend on the number of threads used.
+TEST(CropFilterTest, test_crop_polygon_parallel)
+{
+    Options ops1;
+    ops1.add("filename", Support::datapath("las/1.2-with-color.las"));
+    LasReader reader;
+    reader.setOptions(ops1);
+
+    std::istream* wkt_stream =
+        FileUtils::openFile(Support::datapath("autzen/autzen-selection.wkt"));
+
+    std::stringstream strbuf;
+    strbuf << wkt_stream->rdbuf();
+
+    std::string wkt(strbuf.str());
+
+    Options options;
+    options.add("polygon", wkt);
+    options.add("threads", 4);
+
+    CropFilter crop;
+    crop.setInput(reader);
+    crop.setOptions(options);
+
+    PointTable table;
+
+    crop.prepare(table);
+    PointViewSet viewSet = crop.execute(table);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr view = *viewSet.begin();
+    EXPECT_EQ(view->size(), 47u);
+
+    FileUtils::closeFile(wkt_stream);
+}
+
 TEST(CropFilterTest, test_crop_polygon_reprojection)
 {
     Options readOptions;
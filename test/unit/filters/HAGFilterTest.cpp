@@ -35,6 +35,7 @@
 #include <pdal/pdal_test_main.hpp>
 
 #include <pdal/StageFactory.hpp>
+#include <filters/StreamCallbackFilter.hpp>
 
 #include "Support.hpp"
 
@@ -191,6 +192,87 @@ TEST(HAGFilterTest, closest)
     }
 }
 
+// With a ground file covering all the ground points, the streamed result
+// should match the per-point triangulation of the 'delaunay' test above.
+TEST(HAGFilterTest, groundFileStream)
+{
+    Options ro;
+    ro.add("filename", Support::datapath("filters/hagtest.txt"));
+
+    StageFactory factory;
+    Stage& r = *(factory.createStage("readers.text"));
+    r.setOptions(ro);
+
+    Options fo;
+    fo.add("ground", Support::datapath("filters/hagtest.txt"));
+    Stage& f = *(factory.createStage("filters.hag_delaunay"));
+    f.setInput(r);
+    f.setOptions(fo);
+
+    auto cb = [](PointRef& point)
+    {
+        double x = point.getFieldAs<double>(Dimension::Id::X);
+        double hag =
+            point.getFieldAs<double>(Dimension::Id::HeightAboveGround);
+        uint8_t c = point.getFieldAs<uint8_t>(Dimension::Id::Classification);
+        if (c == ClassLabel::Ground)
+        {
+            EXPECT_EQ(hag, 0);
+            return true;
+        }
+        if (x == -2)
+            EXPECT_EQ(hag, 10);
+        else if (x == 2)
+            EXPECT_EQ(hag, 14);
+        else  // Two non-ground points at x == 4.
+            EXPECT_TRUE(hag == 11 || hag == 16);
+        return true;
+    };
+    StreamCallbackFilter scb;
+    scb.setCallback(cb);
+    scb.setInput(f);
+
+    FixedPointTable t(3);
+    scb.prepare(t);
+    scb.execute(t);
+}
+
+// The HAG values shouldn't depend on the number of threads used.
+TEST(HAGFilterTest, parallel)
+{
+    auto compute = [](const std::string& stage, int threads)
+    {
+        Options ro;
+        ro.add("filename", Support::datapath("filters/hagtest.txt"));
+
+        StageFactory factory;
+        Stage& r = *(factory.createStage("readers.text"));
+        r.setOptions(ro);
+
+        Options fo;
+        fo.add("count", 10);
+        fo.add("threads", threads);
+        Stage& f = *(factory.createStage(stage));
+        f.setInput(r);
+        f.setOptions(fo);
+
+        PointTable t1;
+        f.prepare(t1);
+        PointViewSet s = f.execute(t1);
+        PointViewPtr v = *s.begin();
+
+        std::vector<double> hag(v->size());
+        for (PointId i = 0; i < v->size(); ++i)
+            hag[i] = v->getFieldAs<double>(
+                Dimension::Id::HeightAboveGround, i);
+        return hag;
+    };
+
+    EXPECT_EQ(compute("filters.hag_nn", 1), compute("filters.hag_nn", 4));
+    EXPECT_EQ(compute("filters.hag_delaunay", 1),
+        compute("filters.hag_delaunay", 4));
+}
+
 // Should add tests for exact match in neighbors case and for
 // max_distance in neighbors case.
 
@@ -132,3 +132,36 @@ TEST(HexbinFilterTest, issue_2507)
     EXPECT_EQ(s, test);
 }
 
+// The parallel boundary trace must produce exactly the serial output.
+TEST(HexbinFilterTest, parallel_boundary)
+{
+    // Same arrangement as issue_2507 - two holes, two islands, one of
+    // the islands with a hole of its own.
+    std::vector<std::pair<int, int>> hexes {
+        {0, 3}, {0, 4}, {0,5}, {0, 6},
+        {1, 2}, {1, 6},
+        {2, 2}, {2, 4}, {2, 5}, {2, 7},
+        {3, 1}, {3, 3}, {3, 5}, {3, 7},
+        {4, 1}, {4, 2}, {4, 4}, {4, 5}, {4, 8},
+        {5, 0}, {5, 2}, {5, 6}, {5, 8},
+        {6, 1}, {6, 3}, {6, 4}, {6, 8},
+        {7, 1}, {7, 3}, {7, 4}, {7, 5}, {7, 7},
+        {8, 2}, {8, 3}, {8, 4}, {8, 5}, {8, 6}, {8, 7}
+    };
+
+    auto boundary = [&hexes](size_t threads)
+    {
+        hexer::HexGrid grid(1);
+        for (auto p : hexes)
+            grid.addDenseHexagon(p.first, p.second);
+        grid.findShapes(threads);
+        grid.findParentPaths();
+
+        std::ostringstream oss;
+        grid.toWKT(oss);
+        return oss.str();
+    };
+
+    EXPECT_EQ(boundary(1), boundary(4));
+}
+
@@ -35,6 +35,8 @@
 #include <pdal/pdal_test_main.hpp>
 
 #include <pdal/PipelineManager.hpp>
+#include <pdal/StageWrapper.hpp>
+#include <filters/MergeFilter.hpp>
 
 #include "Support.hpp"
 
@@ -94,3 +96,43 @@ TEST(MergeTest, test6)
     PointViewPtr view = *viewSet.begin();
     EXPECT_EQ(2130u, view->size());
 }
+
+TEST(MergeTest, keyedInterleave)
+{
+    using namespace pdal;
+
+    Options opts;
+    opts.add("key_dim", "GpsTime");
+
+    MergeFilter filter;
+    filter.setOptions(opts);
+
+    PointTable table;
+    table.layout()->registerDim(Dimension::Id::GpsTime);
+    table.finalize();
+
+    // Three time-ordered runs whose time ranges overlap.
+    std::vector<std::vector<double>> runs {
+        { 1.0, 4.0, 7.0, 10.0 },
+        { 2.0, 5.0, 8.0 },
+        { 3.0, 6.0, 9.0, 11.0, 12.0 } };
+
+    filter.prepare(table);
+    StageWrapper::ready(filter, table);
+    PointViewSet viewSet;
+    for (auto const& run : runs)
+    {
+        PointViewPtr view(new PointView(table));
+        for (size_t i = 0; i < run.size(); ++i)
+            view->setField(Dimension::Id::GpsTime, i, run[i]);
+        viewSet = StageWrapper::run(filter, view);
+    }
+    StageWrapper::done(filter, table);
+
+    EXPECT_EQ(1u, viewSet.size());
+    PointViewPtr view = *viewSet.begin();
+    ASSERT_EQ(12u, view->size());
+    for (PointId i = 0; i < view->size(); ++i)
+        EXPECT_DOUBLE_EQ((double)(i + 1),
+            view->getFieldAs<double>(Dimension::Id::GpsTime, i));
+}
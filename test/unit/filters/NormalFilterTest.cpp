@@ -81,6 +81,45 @@ TEST(NormalFilterTest, XYPlane)
     }
 }
 
+// The result shouldn't depend on the number of threads used.
+TEST(NormalFilterTest, parallel)
+{
+    using namespace Dimension;
+
+    PointTable table;
+    table.layout()->registerDims({Id::X, Id::Y, Id::Z});
+
+    FauxReader reader;
+    Options readerOps;
+    readerOps.add("mode", "grid");
+    readerOps.add("bounds", "([0, 10], [0, 10], [0, 0])");
+    readerOps.add("count", 100);
+    reader.setOptions(readerOps);
+    NormalFilter filter;
+    Options filterOps;
+    filterOps.add("knn", 3);
+    filterOps.add("threads", 4);
+    filter.setInput(reader);
+    filter.setOptions(filterOps);
+    filter.prepare(table);
+
+    PointViewSet viewSet = filter.execute(table);
+    PointViewPtr outView = *viewSet.begin();
+
+    Dimension::Id nx = table.layout()->findDim("NormalX");
+    Dimension::Id ny = table.layout()->findDim("NormalY");
+    Dimension::Id nz = table.layout()->findDim("NormalZ");
+    Dimension::Id c = table.layout()->findDim("Curvature");
+
+    for (auto const& p : *outView)
+    {
+        ASSERT_FLOAT_EQ(p.getFieldAs<float>(nx), 0.0);
+        ASSERT_FLOAT_EQ(p.getFieldAs<float>(ny), 0.0);
+        ASSERT_FLOAT_EQ(p.getFieldAs<float>(nz), 1.0);
+        ASSERT_FLOAT_EQ(p.getFieldAs<float>(c), 0.0);
+    }
+}
+
 TEST(NormalFilterTest, XZPlane)
 {
     using namespace Dimension;
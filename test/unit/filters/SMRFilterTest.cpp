@@ -64,6 +64,41 @@ TEST(SMRFilterTest, validReturns)
     EXPECT_NO_THROW(filter.prepare(table));
 }
 
+// The classifications shouldn't depend on the number of threads used.
+TEST(SMRFilterTest, parallel)
+{
+    auto classify = [](int threads)
+    {
+        StageFactory factory;
+
+        Stage *r = factory.createStage("readers.las");
+        Stage *f = factory.createStage("filters.smrf");
+
+        Options rOptions;
+        rOptions.add("filename", Support::datapath("las/autzen_trim.las"));
+        r->setOptions(rOptions);
+
+        Options fOptions;
+        fOptions.add("threads", threads);
+        f->setOptions(fOptions);
+        f->setInput(*r);
+
+        PointTable t;
+        f->prepare(t);
+        PointViewSet s = f->execute(t);
+        EXPECT_EQ(s.size(), 1U);
+        PointViewPtr v = *s.begin();
+
+        std::vector<uint8_t> classes(v->size());
+        for (PointId idx = 0; idx < v->size(); ++idx)
+            classes[idx] =
+                v->getFieldAs<uint8_t>(Dimension::Id::Classification, idx);
+        return classes;
+    };
+
+    EXPECT_EQ(classify(1), classify(4));
+}
+
 // Issue 2775.  Test that files without return counts are processed correctly.
 TEST(SMRFFilterTest, noreturns)
 {
@@ -0,0 +1,113 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its contributors
+*       may be used to endorse or promote products derived from this
+*       software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <filters/SampleFilter.hpp>
+#include <filters/StreamCallbackFilter.hpp>
+#include <io/LasReader.hpp>
+
+#include "Support.hpp"
+
+using namespace pdal;
+
+namespace
+{
+
+// Number of points filters.sample keeps from las/simple.las in batch
+// mode for the given radius.
+point_count_t batchCount(double radius)
+{
+    Options ro;
+    ro.add("filename", Support::datapath("las/simple.las"));
+    LasReader r;
+    r.setOptions(ro);
+
+    Options fo;
+    fo.add("radius", radius);
+    SampleFilter f;
+    f.setOptions(fo);
+    f.setInput(r);
+
+    PointTable table;
+    f.prepare(table);
+    PointViewSet s = f.execute(table);
+    EXPECT_EQ(s.size(), 1U);
+    return (*s.begin())->size();
+}
+
+point_count_t streamCount(double radius, point_count_t cacheSize)
+{
+    Options ro;
+    ro.add("filename", Support::datapath("las/simple.las"));
+    LasReader r;
+    r.setOptions(ro);
+
+    Options fo;
+    fo.add("radius", radius);
+    fo.add("cache_size", cacheSize);
+    SampleFilter f;
+    f.setOptions(fo);
+    f.setInput(r);
+
+    point_count_t count = 0;
+    StreamCallbackFilter c;
+    c.setCallback([&count](PointRef&)
+    {
+        count++;
+        return true;
+    });
+    c.setInput(f);
+
+    FixedPointTable table(100);
+    c.prepare(table);
+    c.execute(table);
+    return count;
+}
+
+} // unnamed namespace
+
+// Stream mode keeps the same points as batch mode - both greedily keep
+// the first point of each radius neighborhood in input order.
+TEST(SampleFilterTest, stream)
+{
+    for (double radius : { 2.0, 10.0 })
+        EXPECT_EQ(streamCount(radius, 0), batchCount(radius));
+}
+
+// A tiny cache forces occupancy tiles to spill and reload without
+// changing the selection.
+TEST(SampleFilterTest, streamSpill)
+{
+    EXPECT_EQ(streamCount(2.0, 50), streamCount(2.0, 0));
+}
@@ -49,13 +49,15 @@ namespace
 {
 
 void doSort(point_count_t count, Dimension::Id dim,
-    const std::string & order="")
+    const std::string & order="", size_t threads = 0)
 {
     Options opts;
 
     opts.add("dimension", Dimension::name(dim));
     if (!order.empty())
         opts.add("order", order);
+    if (threads)
+        opts.add("threads", threads);
 
     SortFilter filter;
     filter.setOptions(opts);
@@ -98,6 +100,14 @@ TEST(SortFilterTest, simple)
         doSort(count, Dimension::Id::X);
 }
 
+TEST(SortFilterTest, parallel)
+{
+    // Chunked sort and merge, including runs that don't divide evenly.
+    doSort(10000, Dimension::Id::X, "ASC", 4);
+    doSort(10001, Dimension::Id::X, "DESC", 3);
+    doSort(10, Dimension::Id::X, "ASC", 16);
+}
+
 TEST(SortFilterTest, testUnknownOptions)
 {
     EXPECT_THROW(doSort(1, Dimension::Id::X, "not an order"), std::exception);
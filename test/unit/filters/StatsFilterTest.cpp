@@ -208,9 +208,11 @@ TEST(Stats, advanced)
     EXPECT_EQ(statsY.count(), 1000u);
     EXPECT_EQ(statsZ.count(), 1000u);
 
-    EXPECT_NEAR(statsX.sampleSkewness(), -5.2235397e-16, 1e-23);
-    EXPECT_NEAR(statsY.sampleSkewness(), -5.7098153e-16, 1e-23);
-    EXPECT_NEAR(statsZ.sampleSkewness(), -5.5176534e-16, 1e-23);
+    // The skewness of a symmetric ramp is zero up to accumulation
+    // roundoff.
+    EXPECT_NEAR(statsX.sampleSkewness(), 0.0, 1e-14);
+    EXPECT_NEAR(statsY.sampleSkewness(), 0.0, 1e-14);
+    EXPECT_NEAR(statsZ.sampleSkewness(), 0.0, 1e-14);
 
     EXPECT_NEAR(statsX.sampleExcessKurtosis(), -1.2, .00001);
     EXPECT_NEAR(statsY.sampleExcessKurtosis(), -1.2, .00001);
@@ -218,6 +220,114 @@ TEST(Stats, advanced)
 }
 
 
+// The whole-view path accumulates moments in batches while the streaming
+// path inserts values one at a time.  Both should agree to roundoff.
+TEST(Stats, batched)
+{
+    BOX3D bounds(1.0, 2.0, 3.0, 101.0, 102.0, 103.0);
+    Options ops;
+    ops.add("bounds", bounds);
+    ops.add("count", 1000);
+    ops.add("mode", "ramp");
+
+    auto run = [&ops](PointTableRef table)
+    {
+        FauxReader reader;
+        reader.setOptions(ops);
+
+        StatsFilter filter;
+        Options filterOps;
+        filterOps.add("advanced", true);
+        filter.setInput(reader);
+        filter.setOptions(filterOps);
+
+        filter.prepare(table);
+        filter.execute(table);
+        return filter.getStats(Dimension::Id::X);
+    };
+
+    PointTable table;
+    FixedPointTable streamTable(100);
+    stats::Summary whole = run(table);
+    stats::Summary stream = run(streamTable);
+
+    EXPECT_EQ(whole.count(), stream.count());
+    EXPECT_DOUBLE_EQ(whole.minimum(), stream.minimum());
+    EXPECT_DOUBLE_EQ(whole.maximum(), stream.maximum());
+    EXPECT_NEAR(whole.average(), stream.average(), 1e-10);
+    EXPECT_NEAR(whole.sampleVariance(), stream.sampleVariance(), 1e-7);
+    EXPECT_NEAR(whole.sampleSkewness(), stream.sampleSkewness(), 1e-10);
+    EXPECT_NEAR(whole.sampleExcessKurtosis(), stream.sampleExcessKurtosis(),
+        1e-10);
+}
+
+
+// Merging independently accumulated partials should match a single
+// accumulator over the same values.
+TEST(Stats, merge)
+{
+    stats::Summary whole("test", stats::Summary::Global, true);
+    stats::Summary first("test", stats::Summary::Global, true);
+    stats::Summary second("test", stats::Summary::Global, true);
+
+    for (PointId i = 0; i < 1000; ++i)
+    {
+        double val = i * i * .1;
+        whole.insert(val);
+        if (i < 400)
+            first.insert(val);
+        else
+            second.insert(val);
+    }
+    first.merge(second);
+
+    EXPECT_EQ(whole.count(), first.count());
+    EXPECT_DOUBLE_EQ(whole.minimum(), first.minimum());
+    EXPECT_DOUBLE_EQ(whole.maximum(), first.maximum());
+    EXPECT_NEAR(whole.average(), first.average(), 1e-8);
+    EXPECT_NEAR(whole.sampleVariance(), first.sampleVariance(), 1e-3);
+    EXPECT_NEAR(whole.sampleSkewness(), first.sampleSkewness(), 1e-8);
+    EXPECT_NEAR(whole.sampleExcessKurtosis(),
+        first.sampleExcessKurtosis(), 1e-8);
+
+    whole.computeGlobalStats();
+    first.computeGlobalStats();
+    EXPECT_NEAR(whole.median(), first.median(),
+        .01 * (std::max)(1.0, std::fabs(whole.median())));
+}
+
+
+TEST(Stats, concurrentViews)
+{
+    PointTable table;
+    table.layout()->registerDim(Dimension::Id::X);
+
+    // Multiple input views make the executor spread the view runs
+    // across threads, since the filter declares them independent (see
+    // Stage::concurrentViewSafe()).
+    BufferReader r;
+    double val = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        PointViewPtr v(new PointView(table));
+        for (PointId idx = 0; idx < 1000; idx++)
+            v->setField(Dimension::Id::X, idx, val++);
+        r.addView(v);
+    }
+
+    StatsFilter f;
+    f.setInput(r);
+    f.prepare(table);
+    f.execute(table);
+
+    const stats::Summary& xstats = f.getStats(Dimension::Id::X);
+    EXPECT_EQ(xstats.count(), 16000u);
+    EXPECT_DOUBLE_EQ(xstats.minimum(), 0.0);
+    EXPECT_DOUBLE_EQ(xstats.maximum(), 15999.0);
+    EXPECT_NEAR(xstats.average(), 15999.0 / 2, 1e-8);
+}
+
+
 TEST(Stats, stream)
 {
     BOX3D bounds(1.0, 2.0, 3.0, 101.0, 102.0, 103.0);
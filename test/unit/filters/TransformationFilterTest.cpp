@@ -34,6 +34,7 @@
 
 #include <pdal/pdal_test_main.hpp>
 
+#include <pdal/BatchTransformBackend.hpp>
 #include <pdal/StageFactory.hpp>
 #include <io/FauxReader.hpp>
 #include <filters/TransformationFilter.hpp>
@@ -247,4 +248,69 @@ TEST(TransformationMatrix, init_file_multiline)
 }
 
 
+// A backend standing in for a device implementation: applies the matrix
+// like the CPU backend but counts the batches it was handed.
+class CountingBackend : public BatchTransformBackend
+{
+public:
+    virtual std::string name() const
+        { return "counting"; }
+
+    virtual point_count_t batchSize() const
+        { return 2; }
+
+    virtual void transform(const double *matrix, double *x, double *y,
+        double *z, point_count_t count)
+    {
+        m_batches++;
+        for (point_count_t i = 0; i < count; ++i)
+        {
+            double px = x[i];
+            double py = y[i];
+            double pz = z[i];
+
+            x[i] = px * matrix[0] + py * matrix[1] + pz * matrix[2] +
+                matrix[3];
+            y[i] = px * matrix[4] + py * matrix[5] + pz * matrix[6] +
+                matrix[7];
+            z[i] = px * matrix[8] + py * matrix[9] + pz * matrix[10] +
+                matrix[11];
+        }
+    }
+
+    static size_t m_batches;
+};
+
+size_t CountingBackend::m_batches = 0;
+
+
+TEST_F(TransformationFilterTest, Backend)
+{
+    EXPECT_EQ("cpu", BatchTransformBackend::get().name());
+    BatchTransformBackend::set(
+        std::unique_ptr<BatchTransformBackend>(new CountingBackend));
+
+    Options filterOpts;
+    filterOpts.add("matrix", "1 0 0 1\n0 1 0 2\n0 0 1 3\n0 0 0 1");
+    m_filter.setOptions(filterOpts);
+
+    PointTable table;
+    m_filter.prepare(table);
+    PointViewSet viewSet = m_filter.execute(table);
+    PointViewPtr view = *viewSet.begin();
+
+    BatchTransformBackend::set(nullptr);
+    EXPECT_EQ("cpu", BatchTransformBackend::get().name());
+
+    // Three points in two-point batches means the backend saw two.
+    EXPECT_EQ(2u, CountingBackend::m_batches);
+    for (point_count_t i = 0; i < view->size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(2, view->getFieldAs<double>(Dimension::Id::X, i));
+        EXPECT_DOUBLE_EQ(4, view->getFieldAs<double>(Dimension::Id::Y, i));
+        EXPECT_DOUBLE_EQ(6, view->getFieldAs<double>(Dimension::Id::Z, i));
+    }
+}
+
+
 }
@@ -57,6 +57,25 @@ TEST(BpfTestBase, test_byte_major)
         Support::datapath("bpf/autzen-utm-chipped-25-v3-segregated.bpf"));
 }
 
+TEST(BpfTestBase, mmap)
+{
+    PointTable table;
+
+    Options ops;
+    ops.add("filename",
+        Support::datapath("bpf/autzen-utm-chipped-25-v3.bpf"));
+    ops.add("count", 506);
+    ops.add("mmap", true);
+    BpfReader reader;
+    reader.setOptions(ops);
+
+    reader.prepare(table);
+    PointViewSet viewSet = reader.execute(table);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr view = *viewSet.begin();
+    EXPECT_EQ(view->size(), 506u);
+}
+
 TEST(BpfTestBase, roundtrip_byte)
 {
     Options ops;
@@ -78,6 +78,16 @@ TEST(BpfTestZlib, roundtrip_dimension_compression)
     test_roundtrip(ops);
 }
 
+TEST(BpfTestZlib, roundtrip_dimension_compression_threaded)
+{
+    Options ops;
+
+    ops.add("format", "DIMENSION");
+    ops.add("compression", true);
+    ops.add("threads", 4);
+    test_roundtrip(ops);
+}
+
 TEST(BpfTestZlib, roundtrip_point_compression)
 {
     Options ops;
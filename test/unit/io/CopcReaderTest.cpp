@@ -0,0 +1,367 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#pragma push_macro("min")
+#pragma push_macro("max")
+#ifdef min
+#undef min
+#endif
+#ifdef max
+#undef max
+#endif
+
+#include <laz-perf/common/common.hpp>
+#include <laz-perf/formats.hpp>
+#include <laz-perf/io.hpp>
+#include <laz-perf/las.hpp>
+
+#pragma pop_macro("max")
+#pragma pop_macro("min")
+
+#include <pdal/compression/LazPerfVlrCompression.hpp>
+#include <pdal/util/Extractor.hpp>
+#include <pdal/util/FileUtils.hpp>
+#include <pdal/util/Inserter.hpp>
+#include <pdal/util/OStream.hpp>
+#include <io/CopcReader.hpp>
+#include <io/LasVLR.hpp>
+
+#include "Support.hpp"
+
+namespace pdal
+{
+
+namespace
+{
+
+// There's no COPC writer, so the tests build a small fixture by hand: a
+// LAS 1.4 header, the COPC info and laszip VLRs, one LAZ chunk per octree
+// node and a root hierarchy page.  The octree is a root voxel with two of
+// its children populated.
+
+struct TestPoint
+{
+    double m_x;
+    double m_y;
+    double m_z;
+    uint16_t m_intensity;
+};
+
+struct NodeSpec
+{
+    int32_t m_level;
+    int32_t m_x;
+    int32_t m_y;
+    int32_t m_z;
+    std::vector<TestPoint> m_pts;
+};
+
+const size_t PointLen = 30;  // Point format 6.
+const double Scale = .01;
+
+// Compress a node's points into a standalone LAZ chunk.  The compressor
+// frames its output as [chunk table offset][chunks][chunk table]; with a
+// chunk size covering all the points there's a single chunk to extract.
+std::vector<char> compressNode(const laszip::factory::record_schema& schema,
+    const std::vector<TestPoint>& pts)
+{
+    std::ostringstream out;
+    LazPerfVlrCompressor compressor(out, schema, (uint32_t)pts.size());
+
+    char rec[PointLen];
+    for (const TestPoint& p : pts)
+    {
+        // Point format 6 layout, matching what CopcReader::loadPoint()
+        // parses.
+        LeInserter ins(rec, PointLen);
+        ins << (int32_t)std::lround(p.m_x / Scale);
+        ins << (int32_t)std::lround(p.m_y / Scale);
+        ins << (int32_t)std::lround(p.m_z / Scale);
+        ins << p.m_intensity;
+        ins << (uint8_t)0x11;            // Return 1 of 1.
+        ins << (uint8_t)0;               // Flags.
+        ins << (uint8_t)2;               // Classification.
+        ins << (uint8_t)0;               // User data.
+        ins << (int16_t)0;               // Scan angle.
+        ins << (uint16_t)1;              // Point source ID.
+        ins << (double)0;                // GPS time.
+        compressor.compress(rec);
+    }
+    compressor.done();
+
+    std::string s = out.str();
+    LeExtractor in(s.data(), s.size());
+    uint64_t tablePos;
+    in >> tablePos;
+    return std::vector<char>(s.begin() + sizeof(tablePos),
+        s.begin() + tablePos);
+}
+
+
+void buildCopc(const std::string& filename,
+    const std::vector<NodeSpec>& nodes, double center, double halfsize,
+    double spacing)
+{
+    // The laszip VLR schema fixes the compressed record layout.  Two
+    // filler bytes after POINT10 and GPSTIME make the record the 30
+    // bytes of point format 6; compression is lossless whatever the
+    // fields mean, so records laid out as format 6 round-trip exactly.
+    laszip::factory::record_schema schema;
+    schema.push(laszip::factory::record_item::POINT10);
+    schema.push(laszip::factory::record_item::GPSTIME);
+    schema.push(laszip::factory::record_item::eb(2));
+    laszip::io::laz_vlr zipvlr = laszip::io::laz_vlr::from_schema(schema);
+    std::vector<uint8_t> lazData(zipvlr.size());
+    zipvlr.extract((char *)lazData.data());
+
+    std::vector<std::vector<char>> chunks;
+    uint64_t totalPoints = 0;
+    BOX3D bounds;
+    for (const NodeSpec& n : nodes)
+    {
+        chunks.push_back(compressNode(schema, n.m_pts));
+        totalPoints += n.m_pts.size();
+        for (const TestPoint& p : n.m_pts)
+            bounds.grow(p.m_x, p.m_y, p.m_z);
+    }
+
+    const uint32_t pointOffset = 375 + (54 + 160) +
+        (uint32_t)(54 + lazData.size());
+    uint64_t hierOffset = pointOffset;
+    for (const std::vector<char>& chunk : chunks)
+        hierOffset += chunk.size();
+    const uint64_t HierarchyEntrySize = 32;
+    uint64_t hierSize = nodes.size() * HierarchyEntrySize;
+
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    OLeStream out(&stream);
+
+    // LAS 1.4 header (375 bytes).
+    out.put("LASF");
+    out << (uint16_t)0 << (uint16_t)0;          // Source ID, encoding.
+    out.put(std::string(16, '\0'));             // GUID.
+    out << (uint8_t)1 << (uint8_t)4;            // Version.
+    out.put(std::string(64, '\0'));             // System/software ID.
+    out << (uint16_t)1 << (uint16_t)2021;       // Creation day/year.
+    out << (uint16_t)375 << pointOffset << (uint32_t)2;
+    out << (uint8_t)(6 | 0x80) << (uint16_t)PointLen;
+    out << (uint32_t)0;                         // Legacy point count.
+    out.put(std::string(20, '\0'));             // Legacy by-return counts.
+    out << Scale << Scale << Scale;
+    out << 0.0 << 0.0 << 0.0;                   // Offset.
+    out << bounds.maxx << bounds.minx << bounds.maxy << bounds.miny <<
+        bounds.maxz << bounds.minz;
+    out << (uint64_t)0;                         // Waveform offset.
+    out << (uint64_t)0 << (uint32_t)0;          // EVLR offset/count.
+    out << totalPoints;
+    out.put(std::string(15 * 8, '\0'));         // By-return counts.
+
+    // COPC info VLR.
+    std::vector<uint8_t> info(160, 0);
+    LeInserter ins(info.data(), info.size());
+    ins << center << center << center << halfsize << spacing;
+    ins << hierOffset << hierSize;
+    LasVLR copcVlr("copc", 1, "COPC info", info);
+    out << copcVlr;
+
+    LasVLR lazVlr("laszip encoded", 22204, "laz vlr", lazData);
+    out << lazVlr;
+
+    for (const std::vector<char>& chunk : chunks)
+        out.put(chunk.data(), chunk.size());
+
+    // Root hierarchy page.
+    uint64_t offset = pointOffset;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        const NodeSpec& n = nodes[i];
+        out << n.m_level << n.m_x << n.m_y << n.m_z;
+        out << offset << (int32_t)chunks[i].size() <<
+            (int32_t)n.m_pts.size();
+        offset += chunks[i].size();
+    }
+}
+
+
+// A 2000-unit cube centered at (1000, 1000, 1000) with 100 points in the
+// root and 100 in each of two opposite child octants.  Intensity encodes
+// the source node.
+std::string makeTestFile()
+{
+    std::string filename = Support::temppath("copc_test.copc.laz");
+    FileUtils::deleteFile(filename);
+
+    std::vector<NodeSpec> nodes;
+
+    NodeSpec root { 0, 0, 0, 0, {} };
+    for (int i = 0; i < 100; ++i)
+        root.m_pts.push_back(
+            { i * 20.0, i * 20.0, i * 20.0, (uint16_t)i });
+    nodes.push_back(root);
+
+    NodeSpec low { 1, 0, 0, 0, {} };
+    for (int i = 0; i < 100; ++i)
+        low.m_pts.push_back(
+            { i * 10.0, i * 10.0, i * 10.0, (uint16_t)(1000 + i) });
+    nodes.push_back(low);
+
+    NodeSpec high { 1, 1, 1, 1, {} };
+    for (int i = 0; i < 100; ++i)
+        high.m_pts.push_back({ 1000.0 + i * 10, 1000.0 + i * 10,
+            1000.0 + i * 10, (uint16_t)(2000 + i) });
+    nodes.push_back(high);
+
+    buildCopc(filename, nodes, 1000.0, 1000.0, 10.0);
+    return filename;
+}
+
+
+PointViewPtr runReader(const Options& ops)
+{
+    CopcReader reader;
+    reader.setOptions(ops);
+
+    PointTable table;
+    reader.prepare(table);
+    PointViewSet viewSet = reader.execute(table);
+    EXPECT_EQ(viewSet.size(), 1u);
+    return *viewSet.begin();
+}
+
+} // unnamed namespace
+
+
+TEST(CopcReaderTest, fullRead)
+{
+    Options ops;
+    ops.add("filename", makeTestFile());
+
+    PointViewPtr view = runReader(ops);
+    ASSERT_EQ(view->size(), 300u);
+
+    // Nodes load in nondeterministic order - check aggregates.
+    double minX = (std::numeric_limits<double>::max)();
+    double maxX = (std::numeric_limits<double>::lowest)();
+    point_count_t fromHigh = 0;
+    for (PointId i = 0; i < view->size(); ++i)
+    {
+        double x = view->getFieldAs<double>(Dimension::Id::X, i);
+        minX = (std::min)(minX, x);
+        maxX = (std::max)(maxX, x);
+        if (view->getFieldAs<uint16_t>(Dimension::Id::Intensity, i) >= 2000)
+            fromHigh++;
+        EXPECT_EQ(view->getFieldAs<uint8_t>(
+            Dimension::Id::Classification, i), 2u);
+        EXPECT_EQ(view->getFieldAs<uint8_t>(
+            Dimension::Id::ReturnNumber, i), 1u);
+    }
+    EXPECT_NEAR(minX, 0.0, .001);
+    EXPECT_NEAR(maxX, 1990.0, .001);
+    EXPECT_EQ(fromHigh, 100u);
+}
+
+
+TEST(CopcReaderTest, bounds)
+{
+    Options ops;
+    ops.add("filename", makeTestFile());
+    ops.add("bounds", "([0, 500], [0, 500], [0, 500])");
+
+    // The high octant doesn't overlap the box and its node is never
+    // fetched; the rest is clipped exactly: 26 root points (every 20
+    // units) and 51 low-octant points (every 10 units).
+    PointViewPtr view = runReader(ops);
+    ASSERT_EQ(view->size(), 77u);
+    for (PointId i = 0; i < view->size(); ++i)
+    {
+        EXPECT_LE(view->getFieldAs<double>(Dimension::Id::X, i), 500.0);
+        EXPECT_LT(view->getFieldAs<uint16_t>(
+            Dimension::Id::Intensity, i), 2000u);
+    }
+}
+
+
+TEST(CopcReaderTest, resolution)
+{
+    Options ops;
+    ops.add("filename", makeTestFile());
+    ops.add("resolution", 10.0);
+
+    // The root spacing satisfies the resolution, so only the root node
+    // (intensity below 1000) is read.
+    PointViewPtr view = runReader(ops);
+    ASSERT_EQ(view->size(), 100u);
+    for (PointId i = 0; i < view->size(); ++i)
+        EXPECT_LT(view->getFieldAs<uint16_t>(
+            Dimension::Id::Intensity, i), 1000u);
+}
+
+
+TEST(CopcReaderTest, threads)
+{
+    // An explicit thread count - including one below the default of
+    // four - is honored; the result doesn't depend on the pool size.
+    for (size_t threads : { (size_t)1, (size_t)7 })
+    {
+        Options ops;
+        ops.add("filename", makeTestFile());
+        ops.add("threads", threads);
+
+        PointViewPtr view = runReader(ops);
+        EXPECT_EQ(view->size(), 300u);
+    }
+}
+
+
+TEST(CopcReaderTest, preview)
+{
+    Options ops;
+    ops.add("filename", makeTestFile());
+
+    CopcReader reader;
+    reader.setOptions(ops);
+    QuickInfo qi = reader.preview();
+    EXPECT_TRUE(qi.valid());
+    EXPECT_EQ(qi.m_pointCount, 300u);
+    EXPECT_NEAR(qi.m_bounds.minx, 0.0, .001);
+    EXPECT_NEAR(qi.m_bounds.maxx, 1990.0, .001);
+}
+
+} // namespace pdal
@@ -39,9 +39,11 @@
 #include <pdal/pdal_test_main.hpp>
 
 #include <io/EptReader.hpp>
+#include <io/private/EptSupport.hpp>
 #include <io/LasReader.hpp>
 #include <filters/CropFilter.hpp>
 #include <filters/ReprojectionFilter.hpp>
+#include <pdal/PipelineManager.hpp>
 #include <pdal/SrsBounds.hpp>
 #include <pdal/util/FileUtils.hpp>
 #include "Support.hpp"
@@ -83,6 +85,46 @@ namespace
             -8242446, 4966706, 50);
 }
 
+TEST(EptReaderTest, cache)
+{
+    EptCache cache;
+    cache.setMaxSize(100);
+
+    int fetches = 0;
+    auto fetcher = [&fetches](size_t size)
+    {
+        return [&fetches, size]()
+        {
+            fetches++;
+            return std::vector<char>(size, 'x');
+        };
+    };
+
+    // A miss fetches; a hit doesn't.
+    EXPECT_EQ(cache.fetch("a", fetcher(40))->size(), 40u);
+    EXPECT_EQ(cache.fetch("a", fetcher(40))->size(), 40u);
+    EXPECT_EQ(fetches, 1);
+    EXPECT_EQ(cache.size(), 40u);
+
+    // Exceeding the capacity evicts the least recently used entry.
+    cache.fetch("b", fetcher(40));
+    cache.fetch("a", fetcher(40));      // Refresh "a".
+    cache.fetch("c", fetcher(40));      // Evicts "b".
+    EXPECT_EQ(fetches, 3);
+    cache.fetch("a", fetcher(40));
+    EXPECT_EQ(fetches, 3);
+    cache.fetch("b", fetcher(40));
+    EXPECT_EQ(fetches, 4);
+
+    // Oversized data is returned but not cached.
+    EXPECT_EQ(cache.fetch("big", fetcher(500))->size(), 500u);
+    EXPECT_LE(cache.size(), 100u);
+
+    // Zero capacity disables and drops everything.
+    cache.setMaxSize(0);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
 TEST(EptReaderTest, inspect)
 {
     Options options;
@@ -212,6 +254,37 @@ TEST(EptReaderTest, fullReadZstandard)
 #endif
 }
 
+TEST(EptReaderTest, rangePushdown)
+{
+    // A downstream range filter's Z interval tightens the query bounds,
+    // so a query disjoint in Z prunes every node before download.
+    {
+        PipelineManager mgr;
+        Stage& reader = mgr.makeReader(ellipsoidEptBinaryPath,
+            "readers.ept");
+        Options rangeOpts;
+        rangeOpts.add("limits", "Z[1000:2000]");
+        mgr.makeFilter("filters.range", reader, rangeOpts);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, 0U);
+        EXPECT_EQ(reader.metrics().m_points, 0U);
+    }
+
+    // An interval covering the data reads normally.
+    {
+        PipelineManager mgr;
+        Stage& reader = mgr.makeReader(ellipsoidEptBinaryPath,
+            "readers.ept");
+        Options rangeOpts;
+        rangeOpts.add("limits", "Z[-100:100]");
+        mgr.makeFilter("filters.range", reader, rangeOpts);
+
+        point_count_t np = mgr.execute();
+        EXPECT_EQ(np, ellipsoidNumPoints);
+    }
+}
+
 TEST(EptReaderTest, resolutionLimit)
 {
     Options options;
@@ -44,6 +44,7 @@
 #include <io/private/GDALGrid.hpp>
 #include "Support.hpp"
 
+#include <cmath>
 #include <iostream>
 #include <sstream>
 
@@ -359,6 +360,31 @@ TEST(GDALWriterTest, meanWindow)
     runGdalWriter(wo, infile, outfile, output);
 }
 
+// With multiple accumulation threads the output should match the
+// single-threaded result.
+TEST(GDALWriterTest, meanThreads)
+{
+    std::string infile = Support::datapath("gdal/grid.txt");
+    std::string outfile = Support::temppath("tmp.tif");
+
+    Options wo;
+    wo.add("gdaldriver", "GTiff");
+    wo.add("output_type", "mean");
+    wo.add("resolution", 1);
+    wo.add("radius", .7071);
+    wo.add("filename", outfile);
+    wo.add("threads", 3);
+
+    const std::string output =
+        "5.000 -9999.000     7.000     8.000     8.967 "
+        "4.000 -9999.000     6.000     7.000     8.000 "
+        "3.000     4.000     5.000     5.700     6.700 "
+        "2.000     3.000     4.200     4.920     5.800 "
+        "1.000     2.000     3.000     4.200     5.200 ";
+
+    runGdalWriter(wo, infile, outfile, output);
+}
+
 TEST(GDALWriterTest, idw)
 {
     std::string infile = Support::datapath("gdal/grid.txt");
@@ -750,6 +776,59 @@ TEST(GDALWriterTest, issue_2095)
     EXPECT_EQ(grid.verticalIndex(4.5), 0);
 }
 
+// Grids accumulated from disjoint halves of a point set and merged should
+// finalize to the same values as one grid fed all the points.
+TEST(GDALWriterTest, gridMerge)
+{
+    int types = GDALGrid::statCount | GDALGrid::statMin | GDALGrid::statMax |
+        GDALGrid::statMean | GDALGrid::statStdDev | GDALGrid::statIdw;
+
+    GDALGrid whole(5, 5, 1, .7071, types, 0, 1.0);
+    GDALGrid part1(5, 5, 1, .7071, types, 0, 1.0);
+    GDALGrid part2(5, 5, 1, .7071, types, 0, 1.0);
+
+    uint32_t seed = 12345;
+    auto next = [&seed]()
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed % 1000) / 200.0;  // [0, 5)
+    };
+
+    for (size_t i = 0; i < 500; ++i)
+    {
+        double x = next();
+        double y = next();
+        double z = next() * 10;
+
+        whole.addPoint(x, y, z);
+        (i % 2 ? part1 : part2).addPoint(x, y, z);
+    }
+    // Make sure the exact-hit IDW case merges - a point at a cell center
+    // pins the cell's IDW value (see GDALGrid::update()).
+    whole.addPoint(2.5, 2.5, 42);
+    part2.addPoint(2.5, 2.5, 42);
+
+    part1.merge(part2);
+    whole.finalize();
+    part1.finalize();
+
+    for (std::string name : { "count", "min", "max", "mean", "stdev", "idw" })
+    {
+        double *expected = whole.data(name);
+        double *actual = part1.data(name);
+        for (size_t i = 0; i < 25; ++i)
+        {
+            // Empty cells hold the NaN nodata marker in both grids.
+            if (std::isnan(expected[i]))
+                EXPECT_TRUE(std::isnan(actual[i])) << "Band = " << name <<
+                    ", cell = " << i;
+            else
+                EXPECT_NEAR(expected[i], actual[i], 1e-9) << "Band = " <<
+                    name << ", cell = " << i;
+        }
+    }
+}
+
 // If the radius is sufficiently large, make sure the grid is filled.
 TEST(GDALWriterTest, issue_2545)
 {
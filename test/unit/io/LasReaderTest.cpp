@@ -147,6 +147,69 @@ TEST(LasReaderTest, test_sequential)
 }
 
 
+TEST(LasReaderTest, mmap)
+{
+    PointTable table;
+
+    Options ops1;
+    ops1.add("filename", Support::datapath("las/1.2-with-color.las"));
+    ops1.add("count", 103);
+    ops1.add("mmap", true);
+    LasReader reader;
+    reader.setOptions(ops1);
+
+    reader.prepare(table);
+    PointViewSet viewSet = reader.execute(table);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr view = *viewSet.begin();
+    Support::check_p0_p1_p2(*view);
+    PointViewPtr view2 = view->makeNew();
+    view2->appendPoint(*view, 100);
+    view2->appendPoint(*view, 101);
+    view2->appendPoint(*view, 102);
+    Support::check_p100_p101_p102(*view2);
+}
+
+
+// The bulk loader takes pointers into point storage a block at a time.
+// A ContiguousPointTable reallocates its storage as points are added, so
+// all of a block's points must be added before any pointer is fetched or
+// the earlier pointers dangle.  Verify the data matches a read through a
+// standard (block-allocated) table.
+TEST(LasReaderTest, contiguousTable)
+{
+    auto read = [](PointTableRef table)
+    {
+        Options ops;
+        ops.add("filename", Support::datapath("las/simple.las"));
+        LasReader reader;
+        reader.setOptions(ops);
+        reader.prepare(table);
+        PointViewSet viewSet = reader.execute(table);
+        EXPECT_EQ(viewSet.size(), 1u);
+        return *viewSet.begin();
+    };
+
+    PointTable blockTable;
+    ContiguousPointTable contigTable;
+    PointViewPtr v1 = read(blockTable);
+    PointViewPtr v2 = read(contigTable);
+
+    ASSERT_EQ(v1->size(), v2->size());
+    for (PointId i = 0; i < v1->size(); ++i)
+    {
+        EXPECT_EQ(v1->getFieldAs<double>(Dimension::Id::X, i),
+            v2->getFieldAs<double>(Dimension::Id::X, i));
+        EXPECT_EQ(v1->getFieldAs<double>(Dimension::Id::Y, i),
+            v2->getFieldAs<double>(Dimension::Id::Y, i));
+        EXPECT_EQ(v1->getFieldAs<double>(Dimension::Id::Z, i),
+            v2->getFieldAs<double>(Dimension::Id::Z, i));
+        EXPECT_EQ(v1->getFieldAs<uint16_t>(Dimension::Id::Intensity, i),
+            v2->getFieldAs<uint16_t>(Dimension::Id::Intensity, i));
+    }
+}
+
+
 static void test_a_format(const std::string& file, uint8_t majorVersion,
     uint8_t minorVersion, int pointFormat,
     double xref, double yref, double zref, double tref,
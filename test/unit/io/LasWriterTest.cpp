@@ -35,9 +35,12 @@
 #include <pdal/pdal_test_main.hpp>
 
 #include <stdlib.h>
+#include <thread>
 
 #include <pdal/pdal_features.hpp>
+#include <pdal/Filter.hpp>
 #include <pdal/PointView.hpp>
+#include <pdal/Streamable.hpp>
 #include <pdal/StageFactory.hpp>
 #include <pdal/StageWrapper.hpp>
 #include <pdal/util/FileUtils.hpp>
@@ -658,6 +661,77 @@ TEST(LasWriterTest, flex2)
     EXPECT_EQ(r.preview().m_pointCount, 1065u);
 }
 
+// Test that a template-based filename works in stream mode, with
+// filters.groupby marking the group breaks at which output rotates.
+TEST(LasWriterTest, stream_flex)
+{
+    // Assigns each third of the input to a different classification so
+    // that the groups are contiguous.
+    class ClassSetter : public Filter, public Streamable
+    {
+    public:
+        ClassSetter() : m_cnt(0)
+            {}
+        std::string getName() const
+            { return "classsetter"; }
+    private:
+        point_count_t m_cnt;
+
+        virtual bool processOne(PointRef& point)
+        {
+            point.setField(Dimension::Id::Classification, m_cnt++ / 355);
+            return true;
+        }
+    };
+
+    std::array<std::string, 3> outname =
+        {{ "stream_flex_1.las", "stream_flex_2.las", "stream_flex_3.las" }};
+
+    for (size_t i = 0; i < outname.size(); ++i)
+        FileUtils::deleteFile(Support::temppath(outname[i]));
+
+    Options readerOps;
+    readerOps.add("filename", Support::datapath("las/simple.las"));
+
+    LasReader reader;
+    reader.setOptions(readerOps);
+
+    ClassSetter setter;
+    setter.setInput(reader);
+
+    Options groupOps;
+    groupOps.add("dimension", "Classification");
+
+    StageFactory factory;
+    Stage& groupby = *(factory.createStage("filters.groupby"));
+    groupby.setOptions(groupOps);
+    groupby.setInput(setter);
+
+    Options writerOps;
+    writerOps.add("filename", Support::temppath("stream_flex_#.las"));
+
+    LasWriter writer;
+    writer.setOptions(writerOps);
+    writer.setInput(groupby);
+
+    FixedPointTable table(100);
+    writer.prepare(table);
+    writer.execute(table);
+
+    for (size_t i = 0; i < outname.size(); ++i)
+    {
+        std::string filename = Support::temppath(outname[i]);
+        EXPECT_TRUE(FileUtils::fileExists(filename));
+
+        Options ops;
+        ops.add("filename", filename);
+
+        LasReader r;
+        r.setOptions(ops);
+        EXPECT_EQ(r.preview().m_pointCount, 355u);
+    }
+}
+
 #if defined(PDAL_HAVE_LAZPERF) && defined(PDAL_HAVE_LASZIP)
 // LAZ files are normally written in chunks of 50,000, so a file of size
 // 110,000 ensures we read some whole chunks and a partial.
@@ -1328,6 +1402,317 @@ TEST(LasWriterTest, evlroffset)
     }
 }
 
+// Append mode: write a file, then add points to it with a second writer.
+// The appended points must adopt the file's scale/offset and the header
+// count and bounds must cover both batches.
+TEST(LasWriterTest, append)
+{
+    using namespace Dimension;
+
+    std::string outfile(Support::temppath("append.las"));
+    FileUtils::deleteFile(outfile);
+
+    {
+        PointTable table;
+        table.layout()->registerDims({Id::X, Id::Y, Id::Z});
+        PointViewPtr view(new PointView(table));
+        for (PointId i = 0; i < 3; ++i)
+        {
+            view->setField(Id::X, i, 1000.5 + i);
+            view->setField(Id::Y, i, 2000.25 + i);
+            view->setField(Id::Z, i, 10.75 + i);
+        }
+        BufferReader reader;
+        reader.addView(view);
+
+        Options ops;
+        ops.add("filename", outfile);
+        ops.add("offset_x", 1000.0);
+        LasWriter writer;
+        writer.setOptions(ops);
+        writer.setInput(reader);
+        writer.prepare(table);
+        writer.execute(table);
+    }
+
+    {
+        PointTable table;
+        table.layout()->registerDims({Id::X, Id::Y, Id::Z});
+        PointViewPtr view(new PointView(table));
+        for (PointId i = 0; i < 2; ++i)
+        {
+            view->setField(Id::X, i, 1005.5 + i);
+            view->setField(Id::Y, i, 2005.25 + i);
+            view->setField(Id::Z, i, 15.75 + i);
+        }
+        BufferReader reader;
+        reader.addView(view);
+
+        // No offset option - the file's offset must be adopted or the
+        // appended X values won't survive the round trip.
+        Options ops;
+        ops.add("filename", outfile);
+        ops.add("append", true);
+        LasWriter writer;
+        writer.setOptions(ops);
+        writer.setInput(reader);
+        writer.prepare(table);
+        writer.execute(table);
+    }
+
+    Options readerOps;
+    readerOps.add("filename", outfile);
+    LasReader reader;
+    reader.setOptions(readerOps);
+
+    PointTable readTable;
+    reader.prepare(readTable);
+    EXPECT_EQ(reader.header().pointCount(), 5u);
+    EXPECT_DOUBLE_EQ(reader.header().offsetX(), 1000.0);
+    EXPECT_DOUBLE_EQ(reader.header().minX(), 1000.5);
+    EXPECT_DOUBLE_EQ(reader.header().maxX(), 1006.5);
+
+    PointViewSet viewSet = reader.execute(readTable);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr view = *viewSet.begin();
+    EXPECT_EQ(view->size(), 5u);
+    EXPECT_NEAR(1002.5, view->getFieldAs<double>(Id::X, 2), .001);
+    EXPECT_NEAR(1005.5, view->getFieldAs<double>(Id::X, 3), .001);
+    EXPECT_NEAR(2006.25, view->getFieldAs<double>(Id::Y, 4), .001);
+    EXPECT_NEAR(16.75, view->getFieldAs<double>(Id::Z, 4), .001);
+
+    FileUtils::deleteFile(outfile);
+}
+
+// Appending to a 1.4 file must carry its EVLRs across the new points.
+TEST(LasWriterTest, append_evlr)
+{
+    using namespace Dimension;
+
+    std::string outfile(Support::temppath("append_evlr.las"));
+    FileUtils::deleteFile(outfile);
+
+    auto writeBatch = [&outfile](double base, bool append)
+    {
+        PointTable table;
+        table.layout()->registerDims({Id::X, Id::Y, Id::Z});
+        PointViewPtr view(new PointView(table));
+        for (PointId i = 0; i < 2; ++i)
+        {
+            view->setField(Id::X, i, base + i);
+            view->setField(Id::Y, i, base + i);
+            view->setField(Id::Z, i, base + i);
+        }
+        BufferReader reader;
+        reader.addView(view);
+
+        Options ops;
+        ops.add("filename", outfile);
+        if (append)
+            ops.add("append", true);
+        else
+        {
+            std::vector<uint8_t> largeVlr(66000);
+            std::string vlr =
+                " { \"description\": \"A description under 32 bytes\", "
+                "\"record_id\": 42, \"user_id\": \"hobu\", \"data\": \"" +
+                Utils::base64_encode(largeVlr) + "\" }";
+            ops.add("vlrs", vlr);
+            ops.add("minor_version", 4);
+        }
+        LasWriter writer;
+        writer.setOptions(ops);
+        writer.setInput(reader);
+        writer.prepare(table);
+        writer.execute(table);
+    };
+
+    writeBatch(10.0, false);
+    writeBatch(20.0, true);
+
+    Options readerOps;
+    readerOps.add("filename", outfile);
+    LasReader reader;
+    reader.setOptions(readerOps);
+
+    PointTable readTable;
+    reader.prepare(readTable);
+    EXPECT_EQ(reader.header().pointCount(), 4u);
+    EXPECT_EQ(reader.header().eVlrCount(), 1u);
+    const LasVLR *vlr = reader.header().findVlr("hobu", 42);
+    ASSERT_TRUE(vlr != nullptr);
+    EXPECT_EQ(vlr->dataLen(), 66000u);
+
+    FileUtils::deleteFile(outfile);
+}
+
+#if defined(PDAL_HAVE_LAZPERF)
+// Appending to LAZ keeps the existing full chunks untouched and
+// re-encodes only a trailing partial chunk, so every batch here lands in
+// the same (partial) chunk and the chunk table is patched each time.
+TEST(LasWriterTest, append_laz)
+{
+    using namespace Dimension;
+
+    std::string outfile(Support::temppath("append.laz"));
+    FileUtils::deleteFile(outfile);
+
+    auto writeBatch = [&outfile](double base, point_count_t count,
+        bool append)
+    {
+        PointTable table;
+        table.layout()->registerDims({Id::X, Id::Y, Id::Z});
+        PointViewPtr view(new PointView(table));
+        for (PointId i = 0; i < count; ++i)
+        {
+            view->setField(Id::X, i, base + i);
+            view->setField(Id::Y, i, base + i + .25);
+            view->setField(Id::Z, i, base + i + .5);
+        }
+        BufferReader reader;
+        reader.addView(view);
+
+        Options ops;
+        ops.add("filename", outfile);
+        ops.add("compression", "lazperf");
+        if (append)
+            ops.add("append", true);
+        LasWriter writer;
+        writer.setOptions(ops);
+        writer.setInput(reader);
+        writer.prepare(table);
+        writer.execute(table);
+    };
+
+    writeBatch(0.0, 100, false);
+    writeBatch(1000.0, 50, true);
+    writeBatch(2000.0, 25, true);
+
+    Options readerOps;
+    readerOps.add("filename", outfile);
+    LasReader reader;
+    reader.setOptions(readerOps);
+
+    PointTable readTable;
+    reader.prepare(readTable);
+    EXPECT_EQ(reader.header().pointCount(), 175u);
+
+    PointViewSet viewSet = reader.execute(readTable);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr view = *viewSet.begin();
+    ASSERT_EQ(view->size(), 175u);
+    EXPECT_NEAR(99.0, view->getFieldAs<double>(Id::X, 99), .001);
+    EXPECT_NEAR(1000.0, view->getFieldAs<double>(Id::X, 100), .001);
+    EXPECT_NEAR(1049.25, view->getFieldAs<double>(Id::Y, 149), .001);
+    EXPECT_NEAR(2024.5, view->getFieldAs<double>(Id::Z, 174), .001);
+
+    FileUtils::deleteFile(outfile);
+}
+
+// Chunk extents recorded with spatial_order must line up with the
+// compressor's chunks even when points arrive in several views, and the
+// reader must skip chunks that miss pushed-down bounds.
+TEST(LasWriterTest, spatial_order_multiview)
+{
+    using namespace Dimension;
+
+    std::string outfile(Support::temppath("spatial_order.laz"));
+    FileUtils::deleteFile(outfile);
+
+    // Two well-separated clusters of 60000 points each, one per view.
+    // With 50000-point chunks the second chunk straddles the views, so
+    // per-view extent tracking would record four rows for three chunks.
+    PointTable table;
+    table.layout()->registerDims({Id::X, Id::Y, Id::Z});
+
+    auto makeView = [&table](double base)
+    {
+        PointViewPtr view(new PointView(table));
+        for (PointId i = 0; i < 60000; ++i)
+        {
+            view->setField(Id::X, i, base + (i % 100));
+            view->setField(Id::Y, i, base + (i / 100));
+            view->setField(Id::Z, i, (double)(i % 50));
+        }
+        return view;
+    };
+
+    BufferReader reader;
+    reader.addView(makeView(0.0));
+    reader.addView(makeView(10000.0));
+
+    Options writerOps;
+    writerOps.add("filename", outfile);
+    writerOps.add("compression", "lazperf");
+    writerOps.add("minor_version", 4);
+    writerOps.add("spatial_order", true);
+    LasWriter writer;
+    writer.setOptions(writerOps);
+    writer.setInput(reader);
+    writer.prepare(table);
+    writer.execute(table);
+
+    // 120000 points in 50000-point chunks -> a three-row table.
+    {
+        PointTable t;
+        Options ops;
+        ops.add("filename", outfile);
+        LasReader r;
+        r.setOptions(ops);
+        r.prepare(t);
+        const LasVLR *vlr = r.header().findVlr(PDAL_USER_ID,
+            PDAL_CHUNK_BOUNDS_RECORD_ID);
+        ASSERT_TRUE(vlr != nullptr);
+        EXPECT_EQ(vlr->dataLen(), 2 * sizeof(uint32_t) +
+            3 * 6 * sizeof(double));
+    }
+
+    // Push down bounds around the first cluster.  The chunk holding only
+    // second-cluster points can be skipped; the straddling chunk can't,
+    // so every first-cluster point must survive.
+    {
+        PointTable t;
+        Options ops;
+        ops.add("filename", outfile);
+        ops.add("compression", "lazperf");
+        LasReader r;
+        r.setOptions(ops);
+        r.pushdownBounds({Bounds(BOX3D(-1, -1, -1, 1000, 1000, 1000))});
+        r.prepare(t);
+        PointViewSet s = r.execute(t);
+        ASSERT_EQ(s.size(), 1u);
+        PointViewPtr v = *s.begin();
+
+        point_count_t firstCluster = 0;
+        for (PointId i = 0; i < v->size(); ++i)
+            if (v->getFieldAs<double>(Id::X, i) < 5000)
+                firstCluster++;
+        EXPECT_EQ(firstCluster, 60000u);
+        // Chunk skipping runs only on the parallel chunked path.
+        if (std::thread::hardware_concurrency() > 1)
+            EXPECT_EQ(v->size(), 100000u);
+        else
+            EXPECT_EQ(v->size(), 120000u);
+    }
+
+    // Without pushdown everything is read back.
+    {
+        PointTable t;
+        Options ops;
+        ops.add("filename", outfile);
+        ops.add("compression", "lazperf");
+        LasReader r;
+        r.setOptions(ops);
+        r.prepare(t);
+        PointViewSet s = r.execute(t);
+        ASSERT_EQ(s.size(), 1u);
+        EXPECT_EQ((*s.begin())->size(), 120000u);
+    }
+
+    FileUtils::deleteFile(outfile);
+}
+#endif
+
 // Make sure that we can forward the LAS_Spec/3 VLR
 TEST(LasWriterTest, forward_spec_3)
 {
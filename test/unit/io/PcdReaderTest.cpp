@@ -34,6 +34,8 @@
 
 #include <pdal/pdal_test_main.hpp>
 
+#include <fstream>
+
 #include "Support.hpp"
 
 #include <io/LasReader.hpp>
@@ -188,6 +190,79 @@ TEST(PcdReaderTest, compareTabSeparatedStreaming)
                            Support::datapath("las/utm17.las"));
 }
 
+TEST(PcdReaderTest, binaryCompressed)
+{
+    std::string outfile(Support::temppath("compressed-test.pcd"));
+    FileUtils::deleteFile(outfile);
+
+    // Compressed bodies are column-major: all x values, then y, z and
+    // intensity.
+    float xs[] = { 1.25f, 2.5f, 3.75f };
+    float ys[] = { -1.5f, 0.0f, 10.125f };
+    float zs[] = { 100.0f, 200.5f, 300.25f };
+    uint16_t is[] = { 11, 222, 3333 };
+
+    std::vector<char> body;
+    auto append = [&body](const void *p, size_t size)
+    {
+        const char *c = (const char *)p;
+        body.insert(body.end(), c, c + size);
+    };
+    append(xs, sizeof(xs));
+    append(ys, sizeof(ys));
+    append(zs, sizeof(zs));
+    append(is, sizeof(is));
+
+    // Literal runs of up to 32 bytes, each preceded by a control byte
+    // holding the run length minus one, form a valid LZF stream.
+    std::vector<char> compressed;
+    for (size_t pos = 0; pos < body.size(); pos += 32)
+    {
+        size_t run = (std::min)((size_t)32, body.size() - pos);
+        compressed.push_back((char)(run - 1));
+        compressed.insert(compressed.end(), body.begin() + pos,
+            body.begin() + pos + run);
+    }
+
+    std::ofstream out(outfile, std::ios::binary);
+    out << "VERSION .7\n"
+        "FIELDS x y z intensity\n"
+        "SIZE 4 4 4 2\n"
+        "TYPE F F F U\n"
+        "COUNT 1 1 1 1\n"
+        "WIDTH 3\n"
+        "HEIGHT 1\n"
+        "VIEWPOINT 0 0 0 1 0 0 0\n"
+        "POINTS 3\n"
+        "DATA binary_compressed\n";
+    uint32_t sizes[2] =
+        { (uint32_t)compressed.size(), (uint32_t)body.size() };
+    out.write((const char *)sizes, sizeof(sizes));
+    out.write(compressed.data(), compressed.size());
+    out.close();
+
+    PcdReader r;
+    Options ro;
+    ro.add("filename", outfile);
+    r.setOptions(ro);
+
+    PointTable t;
+    r.prepare(t);
+    PointViewSet s = r.execute(t);
+    EXPECT_EQ(s.size(), 1U);
+    PointViewPtr v = *s.begin();
+    EXPECT_EQ(v->size(), 3U);
+
+    for (PointId i = 0; i < v->size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::X, i), xs[i]);
+        EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::Y, i), ys[i]);
+        EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::Z, i), zs[i]);
+        EXPECT_EQ(v->getFieldAs<uint16_t>(Dimension::Id::Intensity, i),
+            is[i]);
+    }
+}
+
 TEST(PcdReaderTest, throwMissingHeader)
 {
     PcdReader t;
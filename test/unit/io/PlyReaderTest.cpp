@@ -188,6 +188,20 @@ TEST(PlyReader, ReadBinaryStream)
 }
 
 
+TEST(PlyReader, Inspect)
+{
+    PlyReader reader;
+    Options options;
+    options.add("filename", Support::datapath("ply/simple_text.ply"));
+    reader.setOptions(options);
+
+    QuickInfo qi = reader.preview();
+    EXPECT_TRUE(qi.valid());
+    EXPECT_TRUE(qi.m_exact);
+    EXPECT_EQ(qi.m_pointCount, 3u);
+}
+
+
 TEST(PlyReader, NoVertex)
 {
     PlyReader reader;
@@ -178,3 +178,27 @@ TEST(SbetReaderTest, testReadAsRadians)
                8.379685112283802e-04, 7.372886784718076e-03,
                7.179027672314571e-02);
 }
+
+TEST(SbetReaderTest, testTrajectoryTimeIndex)
+{
+    sbet::Trajectory traj;
+    std::string error;
+    ASSERT_TRUE(traj.open(Support::datapath("sbet/2-points.sbet"), error));
+
+    EXPECT_EQ(traj.size(), 2u);
+    double t0 = 1.516310028360710e+05;
+    double t1 = 1.516310078318641e+05;
+    EXPECT_NEAR(traj.time(0), t0, .0001);
+    EXPECT_NEAR(traj.time(1), t1, .0001);
+    // Altitude is the fourth value of the record, stored as written
+    // (no angle conversion).
+    EXPECT_NEAR(traj.record(1)[3], 1.077151424357507e+02, .0001);
+
+    EXPECT_EQ(traj.lowerBound(t0 - 1), 0u);
+    EXPECT_EQ(traj.lowerBound(t1), 1u);
+    EXPECT_EQ(traj.lowerBound(t1 + 1), 2u);
+
+    std::pair<PointId, PointId> range = traj.timeRange(t0, t1);
+    EXPECT_EQ(range.first, 0u);
+    EXPECT_EQ(range.second, 2u);
+}
@@ -0,0 +1,152 @@
+/******************************************************************************
+* Copyright (c) 2019, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <pdal/util/FileUtils.hpp>
+#include <io/LasReader.hpp>
+#include <io/ShmReader.hpp>
+#include <io/ShmWriter.hpp>
+
+#include "Support.hpp"
+
+namespace pdal
+{
+
+namespace
+{
+
+// Write simple.las through the shm writer and read it back, comparing
+// the round-tripped points against the original.
+void roundtrip(bool stream)
+{
+    std::string outfile(Support::temppath("shm_test.shm"));
+    FileUtils::deleteFile(outfile);
+
+    Options readerOps;
+    readerOps.add("filename", Support::datapath("las/simple.las"));
+
+    LasReader reader;
+    reader.setOptions(readerOps);
+
+    Options writerOps;
+    writerOps.add("filename", outfile);
+
+    ShmWriter writer;
+    writer.setOptions(writerOps);
+    writer.setInput(reader);
+
+    if (stream)
+    {
+        FixedPointTable table(100);
+        writer.prepare(table);
+        writer.execute(table);
+    }
+    else
+    {
+        PointTable table;
+        writer.prepare(table);
+        writer.execute(table);
+    }
+
+    Options backOps;
+    backOps.add("filename", outfile);
+
+    ShmReader back;
+    back.setOptions(backOps);
+
+    QuickInfo qi = back.preview();
+    EXPECT_TRUE(qi.valid());
+    EXPECT_EQ(qi.m_pointCount, 1065u);
+
+    PointTable table2;
+    back.prepare(table2);
+    PointViewSet viewSet = back.execute(table2);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr view = *viewSet.begin();
+    EXPECT_EQ(view->size(), 1065u);
+
+    Options origOps;
+    origOps.add("filename", Support::datapath("las/simple.las"));
+
+    LasReader orig;
+    orig.setOptions(origOps);
+
+    PointTable table3;
+    orig.prepare(table3);
+    PointViewSet origSet = orig.execute(table3);
+    PointViewPtr origView = *origSet.begin();
+
+    for (PointId i = 0; i < view->size(); i += 100)
+    {
+        EXPECT_DOUBLE_EQ(origView->getFieldAs<double>(Dimension::Id::X, i),
+            view->getFieldAs<double>(Dimension::Id::X, i));
+        EXPECT_DOUBLE_EQ(origView->getFieldAs<double>(Dimension::Id::Y, i),
+            view->getFieldAs<double>(Dimension::Id::Y, i));
+        EXPECT_DOUBLE_EQ(origView->getFieldAs<double>(Dimension::Id::Z, i),
+            view->getFieldAs<double>(Dimension::Id::Z, i));
+        EXPECT_EQ(origView->getFieldAs<uint16_t>(Dimension::Id::Intensity, i),
+            view->getFieldAs<uint16_t>(Dimension::Id::Intensity, i));
+    }
+    FileUtils::deleteFile(outfile);
+}
+
+} // unnamed namespace
+
+
+TEST(ShmTest, roundtrip)
+{
+    roundtrip(false);
+}
+
+
+TEST(ShmTest, roundtripStream)
+{
+    roundtrip(true);
+}
+
+
+TEST(ShmTest, badFile)
+{
+    Options ops;
+    ops.add("filename", Support::datapath("las/simple.las"));
+
+    ShmReader reader;
+    reader.setOptions(ops);
+
+    PointTable table;
+    EXPECT_THROW(reader.prepare(table), pdal_error);
+}
+
+} // namespace pdal
@@ -41,6 +41,9 @@
 #include <io/TextReader.hpp>
 #include <pdal/util/FileUtils.hpp>
 
+#include <cmath>
+#include <fstream>
+
 using namespace pdal;
 
 void compareTextLas(const std::string& textFilename,
@@ -232,6 +235,51 @@ TEST(TextReaderTest, issue1939)
     }
 }
 
+// The bulk parsing path should convert fields exactly as the old
+// stream-based conversion did, including scientific notation, full-precision
+// values, NaN and unconvertible fields.
+TEST(TextReaderTest, parseValues)
+{
+    std::string infile = Support::temppath("parse_values.txt");
+
+    FileUtils::deleteFile(infile);
+    {
+        std::ofstream out(infile);
+        out << "X,Y,Z\n";
+        out << "476543.1234567,3212987.999999999,1.5e2\n";
+        out << "-1.7976931348623157e308,4.9e-324,nan\n";
+        out << "1.00000000000000011,junk,-0.125\n";
+    }
+
+    TextReader reader;
+    Options options;
+    options.add("filename", infile);
+    reader.setOptions(options);
+
+    PointTable table;
+    reader.prepare(table);
+    PointViewSet s = reader.execute(table);
+    PointViewPtr v = *s.begin();
+
+    EXPECT_EQ(v->size(), 3U);
+    EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::X, 0),
+        476543.1234567);
+    EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::Y, 0),
+        3212987.999999999);
+    EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::Z, 0), 1.5e2);
+    EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::X, 1),
+        -1.7976931348623157e308);
+    EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::Y, 1), 4.9e-324);
+    EXPECT_TRUE(std::isnan(v->getFieldAs<double>(Dimension::Id::Z, 1)));
+    EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::X, 2),
+        1.00000000000000011);
+    // Unconvertible fields are set to 0, as before.
+    EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::Y, 2), 0);
+    EXPECT_DOUBLE_EQ(v->getFieldAs<double>(Dimension::Id::Z, 2), -0.125);
+
+    FileUtils::deleteFile(infile);
+}
+
 TEST(TextReaderTest, warnMissingHeader)
 {
     std::string infile = Support::datapath("text/missingheader.txt");
@@ -334,3 +382,18 @@ TEST(TextReaderTest, quotedHeader)
         EXPECT_THROW(testme(opts), pdal_error);
     }
 }
+
+TEST(TextReaderTest, inspect)
+{
+    TextReader reader;
+    Options options;
+    options.add("filename", Support::datapath("text/file1.txt"));
+    reader.setOptions(options);
+
+    QuickInfo qi = reader.preview();
+    EXPECT_TRUE(qi.valid());
+    // The file fits in the sample, so the results are exact.
+    EXPECT_TRUE(qi.m_exact);
+    EXPECT_EQ(qi.m_pointCount, 9u);
+    EXPECT_EQ(qi.m_bounds, BOX3D(0, 1, 2, 29, 25, 2));
+}